@@ -21,9 +21,9 @@ __global__ void cudaCalculateTMzEzStep (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexEz1 = i * sy_Ez + j;
-  grid_coord indexEz2 = (i - 1) * sy_Ez + j;
-  grid_coord indexEz3 = i * sy_Ez + j - 1;
+  grid_iter indexEz1 = (grid_iter) i * sy_Ez + j;
+  grid_iter indexEz2 = (grid_iter) (i - 1) * sy_Ez + j;
+  grid_iter indexEz3 = (grid_iter) i * sy_Ez + j - 1;
 
   Ez[indexEz1] = calculateEz_3D (Ez_prev[indexEz1],
                                  Hy_prev[indexEz1],
@@ -57,7 +57,7 @@ __global__ void cudaCalculateTMzEzSource (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexEz1 = i * sy_Ez + j;
+  grid_iter indexEz1 = (grid_iter) i * sy_Ez + j;
 
   if (processId == 0)
   {
@@ -97,12 +97,12 @@ __global__ void cudaCalculateTMzHxStep (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexHx1 = i * sy_Hx + j;
+  grid_iter indexHx1 = (grid_iter) i * sy_Hx + j;
 
   /*
    * FIXME: is this correct ?
    */
-  grid_coord indexHx2 = i * sy_Hx + j + 1;
+  grid_iter indexHx2 = (grid_iter) i * sy_Hx + j + 1;
 
   Hx[indexHx1] = calculateHx_2D_TMz (Hx_prev[indexHx1],
                                      Ez_prev[indexHx2],
@@ -136,8 +136,8 @@ __global__ void cudaCalculateTMzHyStep (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexHy1 = i * sy_Hy + j;
-  grid_coord indexHy2 = (i + 1) * sy_Hy + j;
+  grid_iter indexHy1 = (grid_iter) i * sy_Hy + j;
+  grid_iter indexHy2 = (grid_iter) (i + 1) * sy_Hy + j;
 
   Hy[indexHy1] = calculateHy_2D_TMz (Hy_prev[indexHy1],
                                      Ez_prev[indexHy2],
@@ -213,10 +213,10 @@ __global__ void cudaCalculate3DExStep (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexEx1 = i * sy_Ex * sz_Ex + j * sz_Ex + k;
+  grid_iter indexEx1 = (grid_iter) i * sy_Ex * sz_Ex + j * sz_Ex + k;
 
-  grid_coord indexEx2 = i * sy_Ex * sz_Ex + (j - 1) * sz_Ex + k;
-  grid_coord indexEx3 = i * sy_Ex * sz_Ex + j * sz_Ex + k - 1;
+  grid_iter indexEx2 = (grid_iter) i * sy_Ex * sz_Ex + (j - 1) * sz_Ex + k;
+  grid_iter indexEx3 = (grid_iter) i * sy_Ex * sz_Ex + j * sz_Ex + k - 1;
 
   Ex[indexEx1] = calculateEx_3D (Ex_prev[indexEx1],
                                  Hz_prev[indexEx1],
@@ -254,10 +254,10 @@ __global__ void cudaCalculate3DEyStep (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexEy1 = i * sy_Ey * sz_Ey + j * sz_Ey + k;
+  grid_iter indexEy1 = (grid_iter) i * sy_Ey * sz_Ey + j * sz_Ey + k;
 
-  grid_coord indexEy2 = (i - 1) * sy_Ey * sz_Ey + j * sz_Ey + k;
-  grid_coord indexEy3 = i * sy_Ey * sz_Ey + j * sz_Ey + k - 1;
+  grid_iter indexEy2 = (grid_iter) (i - 1) * sy_Ey * sz_Ey + j * sz_Ey + k;
+  grid_iter indexEy3 = (grid_iter) i * sy_Ey * sz_Ey + j * sz_Ey + k - 1;
 
   Ey[indexEy1] = calculateEy_3D (Ey_prev[indexEy1],
                                  Hx_prev[indexEy1],
@@ -295,10 +295,10 @@ __global__ void cudaCalculate3DEzStep (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexEz1 = i * sy_Ez * sz_Ez + j * sz_Ez + k;
+  grid_iter indexEz1 = (grid_iter) i * sy_Ez * sz_Ez + j * sz_Ez + k;
 
-  grid_coord indexEz2 = (i - 1) * sy_Ez * sz_Ez + j * sz_Ez + k;
-  grid_coord indexEz3 = i * sy_Ez * sz_Ez + (j - 1) * sz_Ez + k;
+  grid_iter indexEz2 = (grid_iter) (i - 1) * sy_Ez * sz_Ez + j * sz_Ez + k;
+  grid_iter indexEz3 = (grid_iter) i * sy_Ez * sz_Ez + (j - 1) * sz_Ez + k;
 
   Ez[indexEz1] = calculateEz_3D (Ez_prev[indexEz1],
                                  Hy_prev[indexEz1],
@@ -336,10 +336,10 @@ __global__ void cudaCalculate3DHxStep (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexHx1 = i * sy_Hx * sz_Hx + j * sz_Hx + k;
+  grid_iter indexHx1 = (grid_iter) i * sy_Hx * sz_Hx + j * sz_Hx + k;
 
-  grid_coord indexHx2 = i * sy_Hx * sz_Hx + (j + 1) * sz_Hx + k;
-  grid_coord indexHx3 = i * sy_Hx * sz_Hx + j * sz_Hx + k + 1;
+  grid_iter indexHx2 = (grid_iter) i * sy_Hx * sz_Hx + (j + 1) * sz_Hx + k;
+  grid_iter indexHx3 = (grid_iter) i * sy_Hx * sz_Hx + j * sz_Hx + k + 1;
 
   Hx[indexHx1] = calculateHx_3D (Hx_prev[indexHx1],
                                  Ey_prev[indexHx3],
@@ -377,10 +377,10 @@ __global__ void cudaCalculate3DHyStep (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexHy1 = i * sy_Hy * sz_Hy + j * sz_Hy + k;
+  grid_iter indexHy1 = (grid_iter) i * sy_Hy * sz_Hy + j * sz_Hy + k;
 
-  grid_coord indexHy2 = (i + 1) * sy_Hy * sz_Hy + j * sz_Hy + k;
-  grid_coord indexHy3 = i * sy_Hy * sz_Hy + j * sz_Hy + k + 1;
+  grid_iter indexHy2 = (grid_iter) (i + 1) * sy_Hy * sz_Hy + j * sz_Hy + k;
+  grid_iter indexHy3 = (grid_iter) i * sy_Hy * sz_Hy + j * sz_Hy + k + 1;
 
   Hy[indexHy1] = calculateHy_3D (Hy_prev[indexHy1],
                                  Ez_prev[indexHy2],
@@ -418,10 +418,10 @@ __global__ void cudaCalculate3DHzStep (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexHz1 = i * sy_Hz * sz_Hz + j * sz_Hz + k;
+  grid_iter indexHz1 = (grid_iter) i * sy_Hz * sz_Hz + j * sz_Hz + k;
 
-  grid_coord indexHz2 = (i + 1) * sy_Hz * sz_Hz + j * sz_Hz + k;
-  grid_coord indexHz3 = i * sy_Hz * sz_Hz + (j + 1) * sz_Hz + k;
+  grid_iter indexHz2 = (grid_iter) (i + 1) * sy_Hz * sz_Hz + j * sz_Hz + k;
+  grid_iter indexHz3 = (grid_iter) i * sy_Hz * sz_Hz + (j + 1) * sz_Hz + k;
 
   Hz[indexHz1] = calculateHz_3D (Hz_prev[indexHz1],
                                  Ex_prev[indexHz3],
@@ -457,7 +457,7 @@ __global__ void cudaCalculate3DExSource (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexEx1 = i * sy_Ex * sz_Ex + j * sz_Ex + k;
+  grid_iter indexEx1 = (grid_iter) i * sy_Ex * sz_Ex + j * sz_Ex + k;
 
   *retval = CUDA_OK;
   return;
@@ -482,7 +482,7 @@ __global__ void cudaCalculate3DEySource (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexEy1 = i * sy_Ey * sz_Ey + j * sz_Ey + k;
+  grid_iter indexEy1 = (grid_iter) i * sy_Ey * sz_Ey + j * sz_Ey + k;
 
   *retval = CUDA_OK;
   return;
@@ -507,7 +507,7 @@ __global__ void cudaCalculate3DEzSource (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexEz1 = i * sy_Ez * sz_Ez + j * sz_Ez + k;
+  grid_iter indexEz1 = (grid_iter) i * sy_Ez * sz_Ez + j * sz_Ez + k;
 
   if (processId == 0)
   {
@@ -547,7 +547,7 @@ __global__ void cudaCalculate3DHxSource (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexHx1 = i * sy_Hx * sz_Hx + j * sz_Hx + k;
+  grid_iter indexHx1 = (grid_iter) i * sy_Hx * sz_Hx + j * sz_Hx + k;
 
   *retval = CUDA_OK;
   return;
@@ -572,7 +572,7 @@ __global__ void cudaCalculate3DHySource (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexHy1 = i * sy_Hy * sz_Hy + j * sz_Hy + k;
+  grid_iter indexHy1 = (grid_iter) i * sy_Hy * sz_Hy + j * sz_Hy + k;
 
   *retval = CUDA_OK;
   return;
@@ -597,7 +597,7 @@ __global__ void cudaCalculate3DHzSource (CudaExitStatus *retval,
     return;
   }
 
-  grid_coord indexHz1 = i * sy_Hz * sz_Hz + j * sz_Hz + k;
+  grid_iter indexHz1 = (grid_iter) i * sy_Hz * sz_Hz + j * sz_Hz + k;
 
   *retval = CUDA_OK;
   return;
@@ -116,35 +116,30 @@ void cudaExecute2DTMzSteps (CudaExitStatus *retval,
   {
     for (grid_iter i = 0; i < sizeEz; ++i)
     {
-      FieldPointValue* valEz = Ez.getFieldPointValue (i);
-      tmp_Ez[i] = valEz->getCurValue ();
-      tmp_Ez_prev[i] = valEz->getPrevValue ();
+      tmp_Ez[i] = *Ez.getFieldValue (i, 0);
+      tmp_Ez_prev[i] = *Ez.getFieldValue (i, 1);
     }
 
     for (grid_iter i = 0; i < sizeHx; ++i)
     {
-      FieldPointValue* valHx = Hx.getFieldPointValue (i);
-      tmp_Hx[i] = valHx->getCurValue ();
-      tmp_Hx_prev[i] = valHx->getPrevValue ();
+      tmp_Hx[i] = *Hx.getFieldValue (i, 0);
+      tmp_Hx_prev[i] = *Hx.getFieldValue (i, 1);
     }
 
     for (grid_iter i = 0; i < sizeHy; ++i)
     {
-      FieldPointValue* valHy = Hy.getFieldPointValue (i);
-      tmp_Hy[i] = valHy->getCurValue ();
-      tmp_Hy_prev[i] = valHy->getPrevValue ();
+      tmp_Hy[i] = *Hy.getFieldValue (i, 0);
+      tmp_Hy_prev[i] = *Hy.getFieldValue (i, 1);
     }
 
     for (grid_iter i = 0; i < sizeEps; ++i)
     {
-      FieldPointValue *valEps = Eps.getFieldPointValue (i);
-      tmp_eps[i] = valEps->getCurValue ();
+      tmp_eps[i] = *Eps.getFieldValue (i, 0);
     }
 
     for (grid_iter i = 0; i < sizeMu; ++i)
     {
-      FieldPointValue *valMu = Mu.getFieldPointValue (i);
-      tmp_mu[i] = valMu->getCurValue ();
+      tmp_mu[i] = *Mu.getFieldValue (i, 0);
     }
 
     cudaCheckErrorCmd (cudaMemcpy (Ez_cuda, tmp_Ez, sizeEzRaw, cudaMemcpyHostToDevice));
@@ -281,23 +276,20 @@ void cudaExecute2DTMzSteps (CudaExitStatus *retval,
 
     for (grid_iter i = 0; i < sizeEz; ++i)
     {
-      FieldPointValue* valEz = Ez.getFieldPointValue (i);
-      valEz->setCurValue (tmp_Ez[i]);
-      valEz->setPrevValue (tmp_Ez_prev[i]);
+      Ez.setFieldValue (tmp_Ez[i], i, 0);
+      Ez.setFieldValue (tmp_Ez_prev[i], i, 1);
     }
 
     for (grid_iter i = 0; i < sizeHx; ++i)
     {
-      FieldPointValue* valHx = Hx.getFieldPointValue (i);
-      valHx->setCurValue (tmp_Hx[i]);
-      valHx->setPrevValue (tmp_Hx_prev[i]);
+      Hx.setFieldValue (tmp_Hx[i], i, 0);
+      Hx.setFieldValue (tmp_Hx_prev[i], i, 1);
     }
 
     for (grid_iter i = 0; i < sizeHy; ++i)
     {
-      FieldPointValue* valHy = Hy.getFieldPointValue (i);
-      valHy->setCurValue (tmp_Hy[i]);
-      valHy->setPrevValue (tmp_Hy_prev[i]);
+      Hy.setFieldValue (tmp_Hy[i], i, 0);
+      Hy.setFieldValue (tmp_Hy_prev[i], i, 1);
     }
 
 #if defined (PARALLEL_GRID)
@@ -491,56 +483,48 @@ void cudaExecute3DSteps (CudaExitStatus *retval,
   {
     for (grid_iter i = 0; i < sizeEx; ++i)
     {
-      FieldPointValue* valEx = Ex.getFieldPointValue (i);
-      tmp_Ex[i] = valEx->getCurValue ();
-      tmp_Ex_prev[i] = valEx->getPrevValue ();
+      tmp_Ex[i] = *Ex.getFieldValue (i, 0);
+      tmp_Ex_prev[i] = *Ex.getFieldValue (i, 1);
     }
 
     for (grid_iter i = 0; i < sizeEy; ++i)
     {
-      FieldPointValue* valEy = Ey.getFieldPointValue (i);
-      tmp_Ey[i] = valEy->getCurValue ();
-      tmp_Ey_prev[i] = valEy->getPrevValue ();
+      tmp_Ey[i] = *Ey.getFieldValue (i, 0);
+      tmp_Ey_prev[i] = *Ey.getFieldValue (i, 1);
     }
 
     for (grid_iter i = 0; i < sizeEz; ++i)
     {
-      FieldPointValue* valEz = Ez.getFieldPointValue (i);
-      tmp_Ez[i] = valEz->getCurValue ();
-      tmp_Ez_prev[i] = valEz->getPrevValue ();
+      tmp_Ez[i] = *Ez.getFieldValue (i, 0);
+      tmp_Ez_prev[i] = *Ez.getFieldValue (i, 1);
     }
 
     for (grid_iter i = 0; i < sizeHx; ++i)
     {
-      FieldPointValue* valHx = Hx.getFieldPointValue (i);
-      tmp_Hx[i] = valHx->getCurValue ();
-      tmp_Hx_prev[i] = valHx->getPrevValue ();
+      tmp_Hx[i] = *Hx.getFieldValue (i, 0);
+      tmp_Hx_prev[i] = *Hx.getFieldValue (i, 1);
     }
 
     for (grid_iter i = 0; i < sizeHy; ++i)
     {
-      FieldPointValue* valHy = Hy.getFieldPointValue (i);
-      tmp_Hy[i] = valHy->getCurValue ();
-      tmp_Hy_prev[i] = valHy->getPrevValue ();
+      tmp_Hy[i] = *Hy.getFieldValue (i, 0);
+      tmp_Hy_prev[i] = *Hy.getFieldValue (i, 1);
     }
 
     for (grid_iter i = 0; i < sizeHz; ++i)
     {
-      FieldPointValue* valHz = Hz.getFieldPointValue (i);
-      tmp_Hz[i] = valHz->getCurValue ();
-      tmp_Hz_prev[i] = valHz->getPrevValue ();
+      tmp_Hz[i] = *Hz.getFieldValue (i, 0);
+      tmp_Hz_prev[i] = *Hz.getFieldValue (i, 1);
     }
 
     for (grid_iter i = 0; i < sizeEps; ++i)
     {
-      FieldPointValue *valEps = Eps.getFieldPointValue (i);
-      tmp_eps[i] = valEps->getCurValue ();
+      tmp_eps[i] = *Eps.getFieldValue (i, 0);
     }
 
     for (grid_iter i = 0; i < sizeMu; ++i)
     {
-      FieldPointValue *valMu = Mu.getFieldPointValue (i);
-      tmp_mu[i] = valMu->getCurValue ();
+      tmp_mu[i] = *Mu.getFieldValue (i, 0);
     }
 
     cudaCheckErrorCmd (cudaMemcpy (Ex_cuda, tmp_Ex, sizeExRaw, cudaMemcpyHostToDevice));
@@ -832,44 +816,38 @@ void cudaExecute3DSteps (CudaExitStatus *retval,
 
     for (grid_iter i = 0; i < sizeEx; ++i)
     {
-      FieldPointValue* valEx = Ex.getFieldPointValue (i);
-      valEx->setCurValue (tmp_Ex[i]);
-      valEx->setPrevValue (tmp_Ex_prev[i]);
+      Ex.setFieldValue (tmp_Ex[i], i, 0);
+      Ex.setFieldValue (tmp_Ex_prev[i], i, 1);
     }
 
     for (grid_iter i = 0; i < sizeEy; ++i)
     {
-      FieldPointValue* valEy = Ey.getFieldPointValue (i);
-      valEy->setCurValue (tmp_Ey[i]);
-      valEy->setPrevValue (tmp_Ey_prev[i]);
+      Ey.setFieldValue (tmp_Ey[i], i, 0);
+      Ey.setFieldValue (tmp_Ey_prev[i], i, 1);
     }
 
     for (grid_iter i = 0; i < sizeEz; ++i)
     {
-      FieldPointValue* valEz = Ez.getFieldPointValue (i);
-      valEz->setCurValue (tmp_Ez[i]);
-      valEz->setPrevValue (tmp_Ez_prev[i]);
+      Ez.setFieldValue (tmp_Ez[i], i, 0);
+      Ez.setFieldValue (tmp_Ez_prev[i], i, 1);
     }
 
     for (grid_iter i = 0; i < sizeHx; ++i)
     {
-      FieldPointValue* valHx = Hx.getFieldPointValue (i);
-      valHx->setCurValue (tmp_Hx[i]);
-      valHx->setPrevValue (tmp_Hx_prev[i]);
+      Hx.setFieldValue (tmp_Hx[i], i, 0);
+      Hx.setFieldValue (tmp_Hx_prev[i], i, 1);
     }
 
     for (grid_iter i = 0; i < sizeHy; ++i)
     {
-      FieldPointValue* valHy = Hy.getFieldPointValue (i);
-      valHy->setCurValue (tmp_Hy[i]);
-      valHy->setPrevValue (tmp_Hy_prev[i]);
+      Hy.setFieldValue (tmp_Hy[i], i, 0);
+      Hy.setFieldValue (tmp_Hy_prev[i], i, 1);
     }
 
     for (grid_iter i = 0; i < sizeHz; ++i)
     {
-      FieldPointValue* valHz = Hz.getFieldPointValue (i);
-      valHz->setCurValue (tmp_Hz[i]);
-      valHz->setPrevValue (tmp_Hz_prev[i]);
+      Hz.setFieldValue (tmp_Hz[i], i, 0);
+      Hz.setFieldValue (tmp_Hz_prev[i], i, 1);
     }
 
 #if defined (PARALLEL_GRID)
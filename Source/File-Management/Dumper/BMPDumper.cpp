@@ -103,9 +103,6 @@ BMPDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
   imageMod.SetBitDepth (24);
 #endif /* COMPLEX_FIELD_VALUES */
 
-  const FieldPointValue* value0 = grid.getFieldPointValue (startCoord);
-  ASSERT (value0);
-
   FPValue maxPosRe = 0;
   FPValue maxNegRe = 0;
 
@@ -122,12 +119,12 @@ BMPDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
     case CURRENT:
     {
 #ifdef COMPLEX_FIELD_VALUES
-      maxNegRe = maxPosRe = value0->getCurValue ().real ();
-      maxNegIm = maxPosIm = value0->getCurValue ().imag ();
+      maxNegRe = maxPosRe = grid.getFieldValue (startCoord, 0)->real ();
+      maxNegIm = maxPosIm = grid.getFieldValue (startCoord, 0)->imag ();
 
       maxNegMod = maxPosMod = sqrt (maxNegRe * maxNegRe + maxNegIm * maxNegIm);
 #else /* COMPLEX_FIELD_VALUES */
-      maxNegRe = maxPosRe = value0->getCurValue ();
+      maxNegRe = maxPosRe = *grid.getFieldValue (startCoord, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
       break;
@@ -136,12 +133,12 @@ BMPDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
     case PREVIOUS:
     {
 #ifdef COMPLEX_FIELD_VALUES
-      maxNegRe = maxPosRe = value0->getPrevValue ().real ();
-      maxNegIm = maxPosIm = value0->getPrevValue ().imag ();
+      maxNegRe = maxPosRe = grid.getFieldValue (startCoord, 1)->real ();
+      maxNegIm = maxPosIm = grid.getFieldValue (startCoord, 1)->imag ();
 
       maxNegMod = maxPosMod = sqrt (maxNegRe * maxNegRe + maxNegIm * maxNegIm);
 #else /* COMPLEX_FIELD_VALUES */
-      maxNegRe = maxPosRe = value0->getPrevValue ();
+      maxNegRe = maxPosRe = *grid.getFieldValue (startCoord, 1);
 #endif /* !COMPLEX_FIELD_VALUES */
 
       break;
@@ -150,12 +147,12 @@ BMPDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
     case PREVIOUS2:
     {
 #ifdef COMPLEX_FIELD_VALUES
-      maxNegRe = maxPosRe = value0->getPrevPrevValue ().real ();
-      maxNegIm = maxPosIm = value0->getPrevPrevValue ().imag ();
+      maxNegRe = maxPosRe = grid.getFieldValue (startCoord, 2)->real ();
+      maxNegIm = maxPosIm = grid.getFieldValue (startCoord, 2)->imag ();
 
       maxNegMod = maxPosMod = sqrt (maxNegRe * maxNegRe + maxNegIm * maxNegIm);
 #else /* COMPLEX_FIELD_VALUES */
-      maxNegRe = maxPosRe = value0->getPrevPrevValue ();
+      maxNegRe = maxPosRe = *grid.getFieldValue (startCoord, 2);
 #endif /* !COMPLEX_FIELD_VALUES */
 
       break;
@@ -171,10 +168,6 @@ BMPDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
   // Go through all values and calculate max/min.
   for (grid_coord i = startCoord.getX (); i < endCoord.getX (); ++i)
   {
-    const FieldPointValue* current = grid.getFieldPointValue (GridCoordinate1D (i));
-
-    ASSERT (current);
-
     FPValue valueRe = 0;
 
 #ifdef COMPLEX_FIELD_VALUES
@@ -188,12 +181,12 @@ BMPDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
       case CURRENT:
       {
 #ifdef COMPLEX_FIELD_VALUES
-        valueRe = current->getCurValue ().real ();
-        valueIm = current->getCurValue ().imag ();
+        valueRe = grid.getFieldValue (GridCoordinate1D (i), 0)->real ();
+        valueIm = grid.getFieldValue (GridCoordinate1D (i), 0)->imag ();
 
         valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-        valueRe = current->getCurValue ();
+        valueRe = *grid.getFieldValue (GridCoordinate1D (i), 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
         break;
@@ -202,12 +195,12 @@ BMPDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
       case PREVIOUS:
       {
 #ifdef COMPLEX_FIELD_VALUES
-        valueRe = current->getPrevValue ().real ();
-        valueIm = current->getPrevValue ().imag ();
+        valueRe = grid.getFieldValue (GridCoordinate1D (i), 1)->real ();
+        valueIm = grid.getFieldValue (GridCoordinate1D (i), 1)->imag ();
 
         valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-        valueRe = current->getPrevValue ();
+        valueRe = *grid.getFieldValue (GridCoordinate1D (i), 1);
 #endif /* !COMPLEX_FIELD_VALUES */
 
         break;
@@ -216,12 +209,12 @@ BMPDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
       case PREVIOUS2:
       {
 #ifdef COMPLEX_FIELD_VALUES
-        valueRe = current->getPrevPrevValue ().real ();
-        valueIm = current->getPrevPrevValue ().imag ();
+        valueRe = grid.getFieldValue (GridCoordinate1D (i), 2)->real ();
+        valueIm = grid.getFieldValue (GridCoordinate1D (i), 2)->imag ();
 
         valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-        valueRe = current->getPrevPrevValue ();
+        valueRe = *grid.getFieldValue (GridCoordinate1D (i), 2);
 #endif /* !COMPLEX_FIELD_VALUES */
 
         break;
@@ -286,8 +279,6 @@ BMPDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
   {
     // Get current point value.
     GridCoordinate1D coord (i);
-    const FieldPointValue* current = grid.getFieldPointValue (coord);
-    ASSERT (current);
 
     // Pixel coordinate.
     grid_iter px = coord.getX ();
@@ -307,12 +298,12 @@ BMPDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
       case CURRENT:
       {
 #ifdef COMPLEX_FIELD_VALUES
-        valueRe = current->getCurValue ().real ();
-        valueIm = current->getCurValue ().imag ();
+        valueRe = grid.getFieldValue (coord, 0)->real ();
+        valueIm = grid.getFieldValue (coord, 0)->imag ();
 
         valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-        valueRe = current->getCurValue ();
+        valueRe = *grid.getFieldValue (coord, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
         break;
@@ -321,12 +312,12 @@ BMPDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
       case PREVIOUS:
       {
 #ifdef COMPLEX_FIELD_VALUES
-        valueRe = current->getPrevValue ().real ();
-        valueIm = current->getPrevValue ().imag ();
+        valueRe = grid.getFieldValue (coord, 1)->real ();
+        valueIm = grid.getFieldValue (coord, 1)->imag ();
 
         valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-        valueRe = current->getPrevValue ();
+        valueRe = *grid.getFieldValue (coord, 1);
 #endif /* !COMPLEX_FIELD_VALUES */
 
         break;
@@ -335,12 +326,12 @@ BMPDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
       case PREVIOUS2:
       {
 #ifdef COMPLEX_FIELD_VALUES
-        valueRe = current->getPrevPrevValue ().real ();
-        valueIm = current->getPrevPrevValue ().imag ();
+        valueRe = grid.getFieldValue (coord, 2)->real ();
+        valueIm = grid.getFieldValue (coord, 2)->imag ();
 
         valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-        valueRe = current->getPrevPrevValue ();
+        valueRe = *grid.getFieldValue (coord, 2);
 #endif /* !COMPLEX_FIELD_VALUES */
 
         break;
@@ -456,9 +447,6 @@ BMPDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
   imageMod.SetBitDepth (24);
 #endif /* COMPLEX_FIELD_VALUES */
 
-  const FieldPointValue* value0 = grid.getFieldPointValue (startCoord);
-  ASSERT (value0);
-
   FPValue maxPosRe = 0;
   FPValue maxNegRe = 0;
 
@@ -475,12 +463,12 @@ BMPDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
     case CURRENT:
     {
 #ifdef COMPLEX_FIELD_VALUES
-      maxNegRe = maxPosRe = value0->getCurValue ().real ();
-      maxNegIm = maxPosIm = value0->getCurValue ().imag ();
+      maxNegRe = maxPosRe = grid.getFieldValue (startCoord, 0)->real ();
+      maxNegIm = maxPosIm = grid.getFieldValue (startCoord, 0)->imag ();
 
       maxNegMod = maxPosMod = sqrt (maxNegRe * maxNegRe + maxNegIm * maxNegIm);
 #else /* COMPLEX_FIELD_VALUES */
-      maxNegRe = maxPosRe = value0->getCurValue ();
+      maxNegRe = maxPosRe = *grid.getFieldValue (startCoord, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
       break;
@@ -489,12 +477,12 @@ BMPDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
     case PREVIOUS:
     {
 #ifdef COMPLEX_FIELD_VALUES
-      maxNegRe = maxPosRe = value0->getPrevValue ().real ();
-      maxNegIm = maxPosIm = value0->getPrevValue ().imag ();
+      maxNegRe = maxPosRe = grid.getFieldValue (startCoord, 1)->real ();
+      maxNegIm = maxPosIm = grid.getFieldValue (startCoord, 1)->imag ();
 
       maxNegMod = maxPosMod = sqrt (maxNegRe * maxNegRe + maxNegIm * maxNegIm);
 #else /* COMPLEX_FIELD_VALUES */
-      maxNegRe = maxPosRe = value0->getPrevValue ();
+      maxNegRe = maxPosRe = *grid.getFieldValue (startCoord, 1);
 #endif /* !COMPLEX_FIELD_VALUES */
 
       break;
@@ -503,12 +491,12 @@ BMPDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
     case PREVIOUS2:
     {
 #ifdef COMPLEX_FIELD_VALUES
-      maxNegRe = maxPosRe = value0->getPrevPrevValue ().real ();
-      maxNegIm = maxPosIm = value0->getPrevPrevValue ().imag ();
+      maxNegRe = maxPosRe = grid.getFieldValue (startCoord, 2)->real ();
+      maxNegIm = maxPosIm = grid.getFieldValue (startCoord, 2)->imag ();
 
       maxNegMod = maxPosMod = sqrt (maxNegRe * maxNegRe + maxNegIm * maxNegIm);
 #else /* COMPLEX_FIELD_VALUES */
-      maxNegRe = maxPosRe = value0->getPrevPrevValue ();
+      maxNegRe = maxPosRe = *grid.getFieldValue (startCoord, 2);
 #endif /* !COMPLEX_FIELD_VALUES */
 
       break;
@@ -522,14 +510,18 @@ BMPDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
   }
 
   // Go through all values and calculate max/min.
+#ifdef OPENMP_ENABLED
+#ifdef COMPLEX_FIELD_VALUES
+  #pragma omp parallel for collapse (2) reduction (max: maxPosRe, maxPosIm, maxPosMod) \
+                                        reduction (min: maxNegRe, maxNegIm, maxNegMod)
+#else /* COMPLEX_FIELD_VALUES */
+  #pragma omp parallel for collapse (2) reduction (max: maxPosRe) reduction (min: maxNegRe)
+#endif /* !COMPLEX_FIELD_VALUES */
+#endif /* OPENMP_ENABLED */
   for (grid_coord i = startCoord.getX (); i < endCoord.getX (); ++i)
   {
     for (grid_coord j = startCoord.getY (); j < endCoord.getY (); ++j)
     {
-      const FieldPointValue* current = grid.getFieldPointValue (GridCoordinate2D (i, j));
-
-      ASSERT (current);
-
       FPValue valueRe = 0;
 
 #ifdef COMPLEX_FIELD_VALUES
@@ -543,12 +535,12 @@ BMPDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
         case CURRENT:
         {
 #ifdef COMPLEX_FIELD_VALUES
-          valueRe = current->getCurValue ().real ();
-          valueIm = current->getCurValue ().imag ();
+          valueRe = grid.getFieldValue (GridCoordinate2D (i, j), 0)->real ();
+          valueIm = grid.getFieldValue (GridCoordinate2D (i, j), 0)->imag ();
 
           valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-          valueRe = current->getCurValue ();
+          valueRe = *grid.getFieldValue (GridCoordinate2D (i, j), 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
           break;
@@ -557,12 +549,12 @@ BMPDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
         case PREVIOUS:
         {
 #ifdef COMPLEX_FIELD_VALUES
-          valueRe = current->getPrevValue ().real ();
-          valueIm = current->getPrevValue ().imag ();
+          valueRe = grid.getFieldValue (GridCoordinate2D (i, j), 1)->real ();
+          valueIm = grid.getFieldValue (GridCoordinate2D (i, j), 1)->imag ();
 
           valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-          valueRe = current->getPrevValue ();
+          valueRe = *grid.getFieldValue (GridCoordinate2D (i, j), 1);
 #endif /* !COMPLEX_FIELD_VALUES */
 
           break;
@@ -571,12 +563,12 @@ BMPDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
         case PREVIOUS2:
         {
 #ifdef COMPLEX_FIELD_VALUES
-          valueRe = current->getPrevPrevValue ().real ();
-          valueIm = current->getPrevPrevValue ().imag ();
+          valueRe = grid.getFieldValue (GridCoordinate2D (i, j), 2)->real ();
+          valueIm = grid.getFieldValue (GridCoordinate2D (i, j), 2)->imag ();
 
           valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-          valueRe = current->getPrevPrevValue ();
+          valueRe = *grid.getFieldValue (GridCoordinate2D (i, j), 2);
 #endif /* !COMPLEX_FIELD_VALUES */
 
           break;
@@ -638,16 +630,15 @@ BMPDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
 #endif /* COMPLEX_FIELD_VALUES */
 
   // Go through all values and set pixels.
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (grid_coord i = startCoord.getX (); i < endCoord.getX (); ++i)
   {
     for (grid_coord j = startCoord.getY (); j < endCoord.getY (); ++j)
     {
       GridCoordinate2D coord (i, j);
 
-      // Get current point value.
-      const FieldPointValue* current = grid.getFieldPointValue (coord);
-      ASSERT (current);
-
       // Pixel coordinate.
       grid_iter px = coord.getX ();
       grid_iter py = coord.getY ();;
@@ -666,12 +657,12 @@ BMPDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
         case CURRENT:
         {
 #ifdef COMPLEX_FIELD_VALUES
-          valueRe = current->getCurValue ().real ();
-          valueIm = current->getCurValue ().imag ();
+          valueRe = grid.getFieldValue (coord, 0)->real ();
+          valueIm = grid.getFieldValue (coord, 0)->imag ();
 
           valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-          valueRe = current->getCurValue ();
+          valueRe = *grid.getFieldValue (coord, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
           break;
@@ -680,12 +671,12 @@ BMPDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
         case PREVIOUS:
         {
 #ifdef COMPLEX_FIELD_VALUES
-          valueRe = current->getPrevValue ().real ();
-          valueIm = current->getPrevValue ().imag ();
+          valueRe = grid.getFieldValue (coord, 1)->real ();
+          valueIm = grid.getFieldValue (coord, 1)->imag ();
 
           valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-          valueRe = current->getPrevValue ();
+          valueRe = *grid.getFieldValue (coord, 1);
 #endif /* !COMPLEX_FIELD_VALUES */
 
           break;
@@ -694,12 +685,12 @@ BMPDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
         case PREVIOUS2:
         {
 #ifdef COMPLEX_FIELD_VALUES
-          valueRe = current->getPrevPrevValue ().real ();
-          valueIm = current->getPrevPrevValue ().imag ();
+          valueRe = grid.getFieldValue (coord, 2)->real ();
+          valueIm = grid.getFieldValue (coord, 2)->imag ();
 
           valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-          valueRe = current->getPrevPrevValue ();
+          valueRe = *grid.getFieldValue (coord, 2);
 #endif /* !COMPLEX_FIELD_VALUES */
 
           break;
@@ -804,9 +795,6 @@ BMPDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
   grid_coord sy = size.getY ();
   grid_coord sz = size.getZ ();
 
-  const FieldPointValue* value0 = grid.getFieldPointValue (startCoord);
-  ASSERT (value0);
-
   FPValue maxPosRe = 0;
   FPValue maxNegRe = 0;
 
@@ -823,12 +811,12 @@ BMPDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
     case CURRENT:
     {
 #ifdef COMPLEX_FIELD_VALUES
-      maxNegRe = maxPosRe = value0->getCurValue ().real ();
-      maxNegIm = maxPosIm = value0->getCurValue ().imag ();
+      maxNegRe = maxPosRe = grid.getFieldValue (startCoord, 0)->real ();
+      maxNegIm = maxPosIm = grid.getFieldValue (startCoord, 0)->imag ();
 
       maxNegMod = maxPosMod = sqrt (maxNegRe * maxNegRe + maxNegIm * maxNegIm);
 #else /* COMPLEX_FIELD_VALUES */
-      maxNegRe = maxPosRe = value0->getCurValue ();
+      maxNegRe = maxPosRe = *grid.getFieldValue (startCoord, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
       break;
@@ -837,12 +825,12 @@ BMPDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
     case PREVIOUS:
     {
 #ifdef COMPLEX_FIELD_VALUES
-      maxNegRe = maxPosRe = value0->getPrevValue ().real ();
-      maxNegIm = maxPosIm = value0->getPrevValue ().imag ();
+      maxNegRe = maxPosRe = grid.getFieldValue (startCoord, 1)->real ();
+      maxNegIm = maxPosIm = grid.getFieldValue (startCoord, 1)->imag ();
 
       maxNegMod = maxPosMod = sqrt (maxNegRe * maxNegRe + maxNegIm * maxNegIm);
 #else /* COMPLEX_FIELD_VALUES */
-      maxNegRe = maxPosRe = value0->getPrevValue ();
+      maxNegRe = maxPosRe = *grid.getFieldValue (startCoord, 1);
 #endif /* !COMPLEX_FIELD_VALUES */
 
       break;
@@ -851,12 +839,12 @@ BMPDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
     case PREVIOUS2:
     {
 #ifdef COMPLEX_FIELD_VALUES
-      maxNegRe = maxPosRe = value0->getPrevPrevValue ().real ();
-      maxNegIm = maxPosIm = value0->getPrevPrevValue ().imag ();
+      maxNegRe = maxPosRe = grid.getFieldValue (startCoord, 2)->real ();
+      maxNegIm = maxPosIm = grid.getFieldValue (startCoord, 2)->imag ();
 
       maxNegMod = maxPosMod = sqrt (maxNegRe * maxNegRe + maxNegIm * maxNegIm);
 #else /* COMPLEX_FIELD_VALUES */
-      maxNegRe = maxPosRe = value0->getPrevPrevValue ();
+      maxNegRe = maxPosRe = *grid.getFieldValue (startCoord, 2);
 #endif /* !COMPLEX_FIELD_VALUES */
 
       break;
@@ -870,16 +858,20 @@ BMPDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
   }
 
   // Go through all values and calculate max/min.
+#ifdef OPENMP_ENABLED
+#ifdef COMPLEX_FIELD_VALUES
+  #pragma omp parallel for collapse (2) reduction (max: maxPosRe, maxPosIm, maxPosMod) \
+                                        reduction (min: maxNegRe, maxNegIm, maxNegMod)
+#else /* COMPLEX_FIELD_VALUES */
+  #pragma omp parallel for collapse (2) reduction (max: maxPosRe) reduction (min: maxNegRe)
+#endif /* !COMPLEX_FIELD_VALUES */
+#endif /* OPENMP_ENABLED */
   for (grid_coord i = startCoord.getX (); i < endCoord.getX (); ++i)
   {
     for (grid_coord j = startCoord.getY (); j < endCoord.getY (); ++j)
     {
       for (grid_coord k = startCoord.getZ (); k < endCoord.getZ (); ++k)
       {
-        const FieldPointValue* current = grid.getFieldPointValue (GridCoordinate3D (i, j, k));
-
-        ASSERT (current);
-
         FPValue valueRe = 0;
 
 #ifdef COMPLEX_FIELD_VALUES
@@ -893,12 +885,12 @@ BMPDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
           case CURRENT:
           {
 #ifdef COMPLEX_FIELD_VALUES
-            valueRe = current->getCurValue ().real ();
-            valueIm = current->getCurValue ().imag ();
+            valueRe = grid.getFieldValue (GridCoordinate3D (i, j, k), 0)->real ();
+            valueIm = grid.getFieldValue (GridCoordinate3D (i, j, k), 0)->imag ();
 
             valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-            valueRe = current->getCurValue ();
+            valueRe = *grid.getFieldValue (GridCoordinate3D (i, j, k), 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
             break;
@@ -907,12 +899,12 @@ BMPDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
           case PREVIOUS:
           {
 #ifdef COMPLEX_FIELD_VALUES
-            valueRe = current->getPrevValue ().real ();
-            valueIm = current->getPrevValue ().imag ();
+            valueRe = grid.getFieldValue (GridCoordinate3D (i, j, k), 1)->real ();
+            valueIm = grid.getFieldValue (GridCoordinate3D (i, j, k), 1)->imag ();
 
             valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-            valueRe = current->getPrevValue ();
+            valueRe = *grid.getFieldValue (GridCoordinate3D (i, j, k), 1);
 #endif /* !COMPLEX_FIELD_VALUES */
 
             break;
@@ -921,12 +913,12 @@ BMPDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
           case PREVIOUS2:
           {
 #ifdef COMPLEX_FIELD_VALUES
-            valueRe = current->getPrevPrevValue ().real ();
-            valueIm = current->getPrevPrevValue ().imag ();
+            valueRe = grid.getFieldValue (GridCoordinate3D (i, j, k), 2)->real ();
+            valueIm = grid.getFieldValue (GridCoordinate3D (i, j, k), 2)->imag ();
 
             valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-            valueRe = current->getPrevPrevValue ();
+            valueRe = *grid.getFieldValue (GridCoordinate3D (i, j, k), 2);
 #endif /* !COMPLEX_FIELD_VALUES */
 
             break;
@@ -1056,6 +1048,9 @@ BMPDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
     imageMod.SetBitDepth (24);
 #endif /* COMPLEX_FIELD_VALUES */
 
+#ifdef OPENMP_ENABLED
+    #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
     for (grid_iter coord2 = coordStart2; coord2 < coordEnd2; ++coord2)
     {
       for (grid_iter coord3 = coordStart3; coord3 < coordEnd3; ++coord3)
@@ -1075,10 +1070,6 @@ BMPDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
           pos = GridCoordinate3D (coord2, coord3, coord1);
         }
 
-        // Get current point value.
-        const FieldPointValue* current = grid.getFieldPointValue (pos);
-        ASSERT (current);
-
         // Get pixel for image.
         FPValue valueRe = 0;
 
@@ -1093,12 +1084,12 @@ BMPDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
           case CURRENT:
           {
 #ifdef COMPLEX_FIELD_VALUES
-            valueRe = current->getCurValue ().real ();
-            valueIm = current->getCurValue ().imag ();
+            valueRe = grid.getFieldValue (pos, 0)->real ();
+            valueIm = grid.getFieldValue (pos, 0)->imag ();
 
             valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-            valueRe = current->getCurValue ();
+            valueRe = *grid.getFieldValue (pos, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
             break;
@@ -1107,12 +1098,12 @@ BMPDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
           case PREVIOUS:
           {
 #ifdef COMPLEX_FIELD_VALUES
-            valueRe = current->getPrevValue ().real ();
-            valueIm = current->getPrevValue ().imag ();
+            valueRe = grid.getFieldValue (pos, 1)->real ();
+            valueIm = grid.getFieldValue (pos, 1)->imag ();
 
             valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-            valueRe = current->getPrevValue ();
+            valueRe = *grid.getFieldValue (pos, 1);
 #endif /* !COMPLEX_FIELD_VALUES */
 
             break;
@@ -1121,12 +1112,12 @@ BMPDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
           case PREVIOUS2:
           {
 #ifdef COMPLEX_FIELD_VALUES
-            valueRe = current->getPrevPrevValue ().real ();
-            valueIm = current->getPrevPrevValue ().imag ();
+            valueRe = grid.getFieldValue (pos, 2)->real ();
+            valueIm = grid.getFieldValue (pos, 2)->imag ();
 
             valueMod = sqrt (valueRe * valueRe + valueIm * valueIm);
 #else /* COMPLEX_FIELD_VALUES */
-            valueRe = current->getPrevPrevValue ();
+            valueRe = *grid.getFieldValue (pos, 2);
 #endif /* !COMPLEX_FIELD_VALUES */
 
             break;
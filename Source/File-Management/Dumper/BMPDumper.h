@@ -47,18 +47,18 @@ BMPDumper<TCoord>::writeToFile (Grid<TCoord> &grid, TCoord startCoord, TCoord en
   writeToFile (grid, CURRENT, startCoord, endCoord);
 #if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
 #ifdef CXX11_ENABLED
-  if (GridFileManager::type == ALL)
+  if (GridFileManager::type == ALL && grid.getCountTimeLayers () > 1)
 #else
-  if (this->GridFileManager::type == ALL)
+  if (this->GridFileManager::type == ALL && grid.getCountTimeLayers () > 1)
 #endif
   {
     writeToFile (grid, PREVIOUS, startCoord, endCoord);
   }
 #if defined (TWO_TIME_STEPS)
 #ifdef CXX11_ENABLED
-  if (GridFileManager::type == ALL)
+  if (GridFileManager::type == ALL && grid.getCountTimeLayers () > 2)
 #else
-  if (this->GridFileManager::type == ALL)
+  if (this->GridFileManager::type == ALL && grid.getCountTimeLayers () > 2)
 #endif
   {
     writeToFile (grid, PREVIOUS2, startCoord, endCoord);
@@ -37,6 +37,8 @@ DATDumper<TCoord>::writeToFile (Grid<TCoord> &grid, GridFileType type, TCoord st
    * FIXME: use startCoord and endCoord
    */
   std::ofstream file;
+  int time_step_back = 0;
+
   switch (type)
   {
     case CURRENT:
@@ -47,6 +49,7 @@ DATDumper<TCoord>::writeToFile (Grid<TCoord> &grid, GridFileType type, TCoord st
       std::string cur_dat = this->GridFileManager::cur + std::string (".dat");
 #endif
       file.open (cur_dat.c_str (), std::ios::out | std::ios::binary);
+      time_step_back = 0;
       break;
     }
 #if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
@@ -58,6 +61,7 @@ DATDumper<TCoord>::writeToFile (Grid<TCoord> &grid, GridFileType type, TCoord st
       std::string prev_dat = this->GridFileManager::prev + std::string (".dat");
 #endif
       file.open (prev_dat.c_str (), std::ios::out | std::ios::binary);
+      time_step_back = 1;
       break;
     }
 #if defined (TWO_TIME_STEPS)
@@ -69,6 +73,7 @@ DATDumper<TCoord>::writeToFile (Grid<TCoord> &grid, GridFileType type, TCoord st
       std::string prevPrev_dat = this->GridFileManager::prevPrev + std::string (".dat");
 #endif
       file.open (prevPrev_dat.c_str (), std::ios::out | std::ios::binary);
+      time_step_back = 2;
       break;
     }
 #endif /* TWO_TIME_STEPS */
@@ -81,41 +86,22 @@ DATDumper<TCoord>::writeToFile (Grid<TCoord> &grid, GridFileType type, TCoord st
 
   ASSERT (file.is_open());
 
-  // Go through all values and write to file.
-  grid_iter end = grid.getSize().calculateTotalCoord ();
+#if defined (BLOCK_GRID_LAYOUT) || defined (SPLIT_COMPLEX_FIELD_VALUES)
+  // Go through all values of the time layer in order of indexes and write them to file.
+  grid_iter end = grid.getSize ().calculateTotalCoord ();
   for (grid_iter iter = 0; iter < end; ++iter)
   {
-    // Get current point value.
-    const FieldPointValue* current = grid.getFieldPointValue (iter);
-    ASSERT (current);
-
-    switch (type)
-    {
-      case CURRENT:
-      {
-        file.write ((char*) &(current->getCurValue ()), sizeof (FieldValue));
-        break;
-      }
-#if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
-      case PREVIOUS:
-      {
-        file.write ((char*) &(current->getPrevValue ()), sizeof (FieldValue));
-        break;
-      }
-#if defined (TWO_TIME_STEPS)
-      case PREVIOUS2:
-      {
-        file.write ((char*) &(current->getPrevPrevValue ()), sizeof (FieldValue));
-        break;
-      }
-#endif /* TWO_TIME_STEPS */
-#endif /* ONE_TIME_STEP || TWO_TIME_STEPS */
-      default:
-      {
-        UNREACHABLE;
-      }
-    }
+    FieldValue value = *grid.getFieldValue (iter, time_step_back);
+    file.write ((char*) &value, sizeof (FieldValue));
+  }
+#else /* BLOCK_GRID_LAYOUT || SPLIT_COMPLEX_FIELD_VALUES */
+  // Go through all rows of the time layer and write them to file.
+  GridView<TCoord> view = grid.getView (time_step_back);
+  for (grid_iter row = 0; row < view.getRowCount (); ++row)
+  {
+    file.write ((char*) view.getRow (row), view.getRowSize () * sizeof (FieldValue));
   }
+#endif /* !BLOCK_GRID_LAYOUT && !SPLIT_COMPLEX_FIELD_VALUES */
 
   file.close();
 }
@@ -136,18 +122,18 @@ DATDumper<TCoord>::dumpGrid (Grid<TCoord> &grid, TCoord startCoord, TCoord endCo
   writeToFile (grid, CURRENT, startCoord, endCoord);
 #if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
 #ifdef CXX11_ENABLED
-  if (GridFileManager::type == ALL)
+  if (GridFileManager::type == ALL && grid.getCountTimeLayers () > 1)
 #else
-  if (this->GridFileManager::type == ALL)
+  if (this->GridFileManager::type == ALL && grid.getCountTimeLayers () > 1)
 #endif
   {
     writeToFile (grid, PREVIOUS, startCoord, endCoord);
   }
 #if defined (TWO_TIME_STEPS)
 #ifdef CXX11_ENABLED
-  if (GridFileManager::type == ALL)
+  if (GridFileManager::type == ALL && grid.getCountTimeLayers () > 2)
 #else
-  if (this->GridFileManager::type == ALL)
+  if (this->GridFileManager::type == ALL && grid.getCountTimeLayers () > 2)
 #endif
   {
     writeToFile (grid, PREVIOUS2, startCoord, endCoord);
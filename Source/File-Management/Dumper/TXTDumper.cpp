@@ -60,10 +60,6 @@ TXTDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
   {
     GridCoordinate1D pos (i);
 
-    // Get current point value.
-    const FieldPointValue* current = grid.getFieldPointValue (i);
-    ASSERT (current);
-
     file << pos.getX () << " ";
 
     switch (type)
@@ -71,9 +67,9 @@ TXTDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
       case CURRENT:
       {
 #ifdef COMPLEX_FIELD_VALUES
-        file << current->getCurValue ().real () << std::endl;
+        file << grid.getFieldValue (i, 0)->real () << std::endl;
 #else /* COMPLEX_FIELD_VALUES */
-        file << current->getCurValue () << std::endl;
+        file << *grid.getFieldValue (i, 0) << std::endl;
 #endif /* !COMPLEX_FIELD_VALUES */
         break;
       }
@@ -81,9 +77,9 @@ TXTDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
       case PREVIOUS:
       {
 #ifdef COMPLEX_FIELD_VALUES
-        file << current->getPrevValue ().real () << std::endl;
+        file << grid.getFieldValue (i, 1)->real () << std::endl;
 #else /* COMPLEX_FIELD_VALUES */
-        file << current->getPrevValue () << std::endl;
+        file << *grid.getFieldValue (i, 1) << std::endl;
 #endif /* !COMPLEX_FIELD_VALUES */
         break;
       }
@@ -91,9 +87,9 @@ TXTDumper<GridCoordinate1D>::writeToFile (Grid<GridCoordinate1D> &grid, GridFile
       case PREVIOUS2:
       {
 #ifdef COMPLEX_FIELD_VALUES
-        file << current->getPrevPrevValue ().real () << std::endl;
+        file << grid.getFieldValue (i, 2)->real () << std::endl;
 #else /* COMPLEX_FIELD_VALUES */
-        file << current->getPrevPrevValue () << std::endl;
+        file << *grid.getFieldValue (i, 2) << std::endl;
 #endif /* !COMPLEX_FIELD_VALUES */
         break;
       }
@@ -170,10 +166,6 @@ TXTDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
     {
       GridCoordinate2D pos (i, j);
 
-      // Get current point value.
-      const FieldPointValue* current = grid.getFieldPointValue (pos);
-      ASSERT (current);
-
       file << pos.getX () << " " << pos.getY () << " ";
 
       switch (type)
@@ -181,9 +173,9 @@ TXTDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
         case CURRENT:
         {
 #ifdef COMPLEX_FIELD_VALUES
-          file << current->getCurValue ().real () << std::endl;
+          file << grid.getFieldValue (pos, 0)->real () << std::endl;
 #else /* COMPLEX_FIELD_VALUES */
-          file << current->getCurValue () << std::endl;
+          file << *grid.getFieldValue (pos, 0) << std::endl;
 #endif /* !COMPLEX_FIELD_VALUES */
           break;
         }
@@ -191,9 +183,9 @@ TXTDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
         case PREVIOUS:
         {
 #ifdef COMPLEX_FIELD_VALUES
-          file << current->getPrevValue ().real () << std::endl;
+          file << grid.getFieldValue (pos, 1)->real () << std::endl;
 #else /* COMPLEX_FIELD_VALUES */
-          file << current->getPrevValue () << std::endl;
+          file << *grid.getFieldValue (pos, 1) << std::endl;
 #endif /* !COMPLEX_FIELD_VALUES */
           break;
         }
@@ -201,9 +193,9 @@ TXTDumper<GridCoordinate2D>::writeToFile (Grid<GridCoordinate2D> &grid, GridFile
         case PREVIOUS2:
         {
 #ifdef COMPLEX_FIELD_VALUES
-          file << current->getPrevPrevValue ().real () << std::endl;
+          file << grid.getFieldValue (pos, 2)->real () << std::endl;
 #else /* COMPLEX_FIELD_VALUES */
-          file << current->getPrevPrevValue () << std::endl;
+          file << *grid.getFieldValue (pos, 2) << std::endl;
 #endif /* !COMPLEX_FIELD_VALUES */
           break;
         }
@@ -283,10 +275,6 @@ TXTDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
       {
         GridCoordinate3D pos (i, j, k);
 
-        // Get current point value.
-        const FieldPointValue* current = grid.getFieldPointValue (pos);
-        ASSERT (current);
-
         file << pos.getX () << " " << pos.getY () << " " << pos.getZ () << " ";
 
         switch (type)
@@ -294,9 +282,9 @@ TXTDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
           case CURRENT:
           {
 #ifdef COMPLEX_FIELD_VALUES
-            file << current->getCurValue ().real () << std::endl;
+            file << grid.getFieldValue (pos, 0)->real () << std::endl;
 #else /* COMPLEX_FIELD_VALUES */
-            file << current->getCurValue () << std::endl;
+            file << *grid.getFieldValue (pos, 0) << std::endl;
 #endif /* !COMPLEX_FIELD_VALUES */
             break;
           }
@@ -304,9 +292,9 @@ TXTDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
           case PREVIOUS:
           {
 #ifdef COMPLEX_FIELD_VALUES
-            file << current->getPrevValue ().real () << std::endl;
+            file << grid.getFieldValue (pos, 1)->real () << std::endl;
 #else /* COMPLEX_FIELD_VALUES */
-            file << current->getPrevValue () << std::endl;
+            file << *grid.getFieldValue (pos, 1) << std::endl;
 #endif /* !COMPLEX_FIELD_VALUES */
             break;
           }
@@ -314,9 +302,9 @@ TXTDumper<GridCoordinate3D>::writeToFile (Grid<GridCoordinate3D> &grid, GridFile
           case PREVIOUS2:
           {
 #ifdef COMPLEX_FIELD_VALUES
-            file << current->getPrevPrevValue ().real () << std::endl;
+            file << grid.getFieldValue (pos, 2)->real () << std::endl;
 #else /* COMPLEX_FIELD_VALUES */
-            file << current->getPrevPrevValue () << std::endl;
+            file << *grid.getFieldValue (pos, 2) << std::endl;
 #endif /* !COMPLEX_FIELD_VALUES */
             break;
           }
@@ -90,20 +90,20 @@ BMPLoader<GridCoordinate1D>::loadFromFile (Grid<GridCoordinate1D> &grid, GridFil
     case CURRENT:
     {
 #ifdef COMPLEX_FIELD_VALUES
-      maxRe = maxValuePos.getCurValue ().real () - maxValueNeg.getCurValue ().real ();
-      maxNegRe = maxValueNeg.getCurValue ().real ();
+      maxRe = maxValuePos[0].real () - maxValueNeg[0].real ();
+      maxNegRe = maxValueNeg[0].real ();
 
       std::string cur_bmp_re = cur + std::string ("-Re") + std::string (".bmp");
       imageRe.ReadFromFile (cur_bmp_re.c_str());
 
-      maxIm = maxValuePos.getCurValue ().imag () - maxValueNeg.getCurValue ().imag ();
-      maxNegIm = maxValueNeg.getCurValue ().imag ();
+      maxIm = maxValuePos[0].imag () - maxValueNeg[0].imag ();
+      maxNegIm = maxValueNeg[0].imag ();
 
       std::string cur_bmp_im = cur + std::string ("-Im") + std::string (".bmp");
       imageIm.ReadFromFile (cur_bmp_im.c_str());
 #else /* COMPLEX_FIELD_VALUES */
-      maxRe = maxValuePos.getCurValue () - maxValueNeg.getCurValue ();
-      maxNegRe = maxValueNeg.getCurValue ();
+      maxRe = maxValuePos[0] - maxValueNeg[0];
+      maxNegRe = maxValueNeg[0];
 
       std::string cur_bmp_re = cur + std::string ("-Re") + std::string (".bmp");
       imageRe.ReadFromFile (cur_bmp_re.c_str());
@@ -115,20 +115,20 @@ BMPLoader<GridCoordinate1D>::loadFromFile (Grid<GridCoordinate1D> &grid, GridFil
     case PREVIOUS:
     {
 #ifdef COMPLEX_FIELD_VALUES
-      maxRe = maxValuePos.getPrevValue ().real () - maxValueNeg.getPrevValue ().real ();
-      maxNegRe = maxValueNeg.getPrevValue ().real ();
+      maxRe = maxValuePos[1].real () - maxValueNeg[1].real ();
+      maxNegRe = maxValueNeg[1].real ();
 
       std::string cur_bmp_re = cur + std::string ("-Re") + std::string (".bmp");
       imageRe.ReadFromFile (cur_bmp_re.c_str());
 
-      maxIm = maxValuePos.getPrevValue ().imag () - maxValueNeg.getPrevValue ().imag ();
-      maxNegIm = maxValueNeg.getPrevValue ().imag ();
+      maxIm = maxValuePos[1].imag () - maxValueNeg[1].imag ();
+      maxNegIm = maxValueNeg[1].imag ();
 
       std::string cur_bmp_im = cur + std::string ("-Im") + std::string (".bmp");
       imageIm.ReadFromFile (cur_bmp_im.c_str());
 #else /* COMPLEX_FIELD_VALUES */
-      maxRe = maxValuePos.getPrevValue () - maxValueNeg.getPrevValue ();
-      maxNegRe = maxValueNeg.getPrevValue ();
+      maxRe = maxValuePos[1] - maxValueNeg[1];
+      maxNegRe = maxValueNeg[1];
 
       std::string cur_bmp_re = cur + std::string ("-Re") + std::string (".bmp");
       imageRe.ReadFromFile (cur_bmp_re.c_str());
@@ -140,20 +140,20 @@ BMPLoader<GridCoordinate1D>::loadFromFile (Grid<GridCoordinate1D> &grid, GridFil
     case PREVIOUS2:
     {
 #ifdef COMPLEX_FIELD_VALUES
-      maxRe = maxValuePos.getPrevPrevValue ().real () - maxValueNeg.getPrevPrevValue ().real ();
-      maxNegRe = maxValueNeg.getPrevPrevValue ().real ();
+      maxRe = maxValuePos[2].real () - maxValueNeg[2].real ();
+      maxNegRe = maxValueNeg[2].real ();
 
       std::string cur_bmp_re = cur + std::string ("-Re") + std::string (".bmp");
       imageRe.ReadFromFile (cur_bmp_re.c_str());
 
-      maxIm = maxValuePos.getPrevPrevValue ().imag () - maxValueNeg.getPrevPrevValue ().imag ();
-      maxNegIm = maxValueNeg.getPrevPrevValue ().imag ();
+      maxIm = maxValuePos[2].imag () - maxValueNeg[2].imag ();
+      maxNegIm = maxValueNeg[2].imag ();
 
       std::string cur_bmp_im = cur + std::string ("-Im") + std::string (".bmp");
       imageIm.ReadFromFile (cur_bmp_im.c_str());
 #else /* COMPLEX_FIELD_VALUES */
-      maxRe = maxValuePos.getPrevPrevValue () - maxValueNeg.getPrevPrevValue ();
-      maxNegRe = maxValueNeg.getPrevPrevValue ();
+      maxRe = maxValuePos[2] - maxValueNeg[2];
+      maxNegRe = maxValueNeg[2];
 
       std::string cur_bmp_re = cur + std::string ("-Re") + std::string (".bmp");
       imageRe.ReadFromFile (cur_bmp_re.c_str());
@@ -173,10 +173,6 @@ BMPLoader<GridCoordinate1D>::loadFromFile (Grid<GridCoordinate1D> &grid, GridFil
   grid_iter end = grid.getSize().calculateTotalCoord ();
   for (grid_iter iter = 0; iter < end; ++iter)
   {
-    // Get current point value.
-    FieldPointValue* current = grid.getFieldPointValue (iter);
-    ASSERT (current);
-
     // Calculate its position from index in array.
     GridCoordinate1D coord = grid.calculatePositionFromIndex (iter);
 
@@ -200,9 +196,9 @@ BMPLoader<GridCoordinate1D>::loadFromFile (Grid<GridCoordinate1D> &grid, GridFil
       case CURRENT:
       {
 #ifdef COMPLEX_FIELD_VALUES
-        current->setCurValue (FieldValue (currentValRe, currentValIm));
+        grid.setFieldValue (FieldValue (currentValRe, currentValIm), iter, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        current->setCurValue (currentValRe);
+        grid.setFieldValue (currentValRe, iter, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
         break;
@@ -211,9 +207,9 @@ BMPLoader<GridCoordinate1D>::loadFromFile (Grid<GridCoordinate1D> &grid, GridFil
       case PREVIOUS:
       {
 #ifdef COMPLEX_FIELD_VALUES
-        current->setPrevValue (FieldValue (currentValRe, currentValIm));
+        grid.setFieldValue (FieldValue (currentValRe, currentValIm), iter, 1);
 #else /* COMPLEX_FIELD_VALUES */
-        current->setPrevValue (currentValRe);
+        grid.setFieldValue (currentValRe, iter, 1);
 #endif /* !COMPLEX_FIELD_VALUES */
 
         break;
@@ -222,9 +218,9 @@ BMPLoader<GridCoordinate1D>::loadFromFile (Grid<GridCoordinate1D> &grid, GridFil
       case PREVIOUS2:
       {
 #ifdef COMPLEX_FIELD_VALUES
-        current->setPrevPrevValue (FieldValue (currentValRe, currentValIm));
+        grid.setFieldValue (FieldValue (currentValRe, currentValIm), iter, 2);
 #else /* COMPLEX_FIELD_VALUES */
-        current->setPrevPrevValue (currentValRe);
+        grid.setFieldValue (currentValRe, iter, 2);
 #endif /* !COMPLEX_FIELD_VALUES */
 
         break;
@@ -274,20 +270,20 @@ BMPLoader<GridCoordinate2D>::loadFromFile (Grid<GridCoordinate2D> &grid, GridFil
     case CURRENT:
     {
 #ifdef COMPLEX_FIELD_VALUES
-      maxRe = maxValuePos.getCurValue ().real () - maxValueNeg.getCurValue ().real ();
-      maxNegRe = maxValueNeg.getCurValue ().real ();
+      maxRe = maxValuePos[0].real () - maxValueNeg[0].real ();
+      maxNegRe = maxValueNeg[0].real ();
 
       std::string cur_bmp_re = cur + std::string ("-Re") + std::string (".bmp");
       imageRe.ReadFromFile (cur_bmp_re.c_str());
 
-      maxIm = maxValuePos.getCurValue ().imag () - maxValueNeg.getCurValue ().imag ();
-      maxNegIm = maxValueNeg.getCurValue ().imag ();
+      maxIm = maxValuePos[0].imag () - maxValueNeg[0].imag ();
+      maxNegIm = maxValueNeg[0].imag ();
 
       std::string cur_bmp_im = cur + std::string ("-Im") + std::string (".bmp");
       imageIm.ReadFromFile (cur_bmp_im.c_str());
 #else /* COMPLEX_FIELD_VALUES */
-      maxRe = maxValuePos.getCurValue () - maxValueNeg.getCurValue ();
-      maxNegRe = maxValueNeg.getCurValue ();
+      maxRe = maxValuePos[0] - maxValueNeg[0];
+      maxNegRe = maxValueNeg[0];
 
       std::string cur_bmp_re = cur + std::string ("-Re") + std::string (".bmp");
       imageRe.ReadFromFile (cur_bmp_re.c_str());
@@ -299,20 +295,20 @@ BMPLoader<GridCoordinate2D>::loadFromFile (Grid<GridCoordinate2D> &grid, GridFil
     case PREVIOUS:
     {
 #ifdef COMPLEX_FIELD_VALUES
-      maxRe = maxValuePos.getPrevValue ().real () - maxValueNeg.getPrevValue ().real ();
-      maxNegRe = maxValueNeg.getPrevValue ().real ();
+      maxRe = maxValuePos[1].real () - maxValueNeg[1].real ();
+      maxNegRe = maxValueNeg[1].real ();
 
       std::string cur_bmp_re = cur + std::string ("-Re") + std::string (".bmp");
       imageRe.ReadFromFile (cur_bmp_re.c_str());
 
-      maxIm = maxValuePos.getPrevValue ().imag () - maxValueNeg.getPrevValue ().imag ();
-      maxNegIm = maxValueNeg.getPrevValue ().imag ();
+      maxIm = maxValuePos[1].imag () - maxValueNeg[1].imag ();
+      maxNegIm = maxValueNeg[1].imag ();
 
       std::string cur_bmp_im = cur + std::string ("-Im") + std::string (".bmp");
       imageIm.ReadFromFile (cur_bmp_im.c_str());
 #else /* COMPLEX_FIELD_VALUES */
-      maxRe = maxValuePos.getPrevValue () - maxValueNeg.getPrevValue ();
-      maxNegRe = maxValueNeg.getPrevValue ();
+      maxRe = maxValuePos[1] - maxValueNeg[1];
+      maxNegRe = maxValueNeg[1];
 
       std::string cur_bmp_re = cur + std::string ("-Re") + std::string (".bmp");
       imageRe.ReadFromFile (cur_bmp_re.c_str());
@@ -324,20 +320,20 @@ BMPLoader<GridCoordinate2D>::loadFromFile (Grid<GridCoordinate2D> &grid, GridFil
     case PREVIOUS2:
     {
 #ifdef COMPLEX_FIELD_VALUES
-      maxRe = maxValuePos.getPrevPrevValue ().real () - maxValueNeg.getPrevPrevValue ().real ();
-      maxNegRe = maxValueNeg.getPrevPrevValue ().real ();
+      maxRe = maxValuePos[2].real () - maxValueNeg[2].real ();
+      maxNegRe = maxValueNeg[2].real ();
 
       std::string cur_bmp_re = cur + std::string ("-Re") + std::string (".bmp");
       imageRe.ReadFromFile (cur_bmp_re.c_str());
 
-      maxIm = maxValuePos.getPrevPrevValue ().imag () - maxValueNeg.getPrevPrevValue ().imag ();
-      maxNegIm = maxValueNeg.getPrevPrevValue ().imag ();
+      maxIm = maxValuePos[2].imag () - maxValueNeg[2].imag ();
+      maxNegIm = maxValueNeg[2].imag ();
 
       std::string cur_bmp_im = cur + std::string ("-Im") + std::string (".bmp");
       imageIm.ReadFromFile (cur_bmp_im.c_str());
 #else /* COMPLEX_FIELD_VALUES */
-      maxRe = maxValuePos.getPrevPrevValue () - maxValueNeg.getPrevPrevValue ();
-      maxNegRe = maxValueNeg.getPrevPrevValue ();
+      maxRe = maxValuePos[2] - maxValueNeg[2];
+      maxNegRe = maxValueNeg[2];
 
       std::string cur_bmp_re = cur + std::string ("-Re") + std::string (".bmp");
       imageRe.ReadFromFile (cur_bmp_re.c_str());
@@ -357,10 +353,6 @@ BMPLoader<GridCoordinate2D>::loadFromFile (Grid<GridCoordinate2D> &grid, GridFil
   grid_iter end = grid.getSize().calculateTotalCoord ();
   for (grid_iter iter = 0; iter < end; ++iter)
   {
-    // Get current point value.
-    FieldPointValue* current = grid.getFieldPointValue (iter);
-    ASSERT (current);
-
     // Calculate its position from index in array.
     GridCoordinate2D coord = grid.calculatePositionFromIndex (iter);
 
@@ -384,9 +376,9 @@ BMPLoader<GridCoordinate2D>::loadFromFile (Grid<GridCoordinate2D> &grid, GridFil
       case CURRENT:
       {
 #ifdef COMPLEX_FIELD_VALUES
-        current->setCurValue (FieldValue (currentValRe, currentValIm));
+        grid.setFieldValue (FieldValue (currentValRe, currentValIm), iter, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        current->setCurValue (currentValRe);
+        grid.setFieldValue (currentValRe, iter, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
         break;
@@ -395,9 +387,9 @@ BMPLoader<GridCoordinate2D>::loadFromFile (Grid<GridCoordinate2D> &grid, GridFil
       case PREVIOUS:
       {
 #ifdef COMPLEX_FIELD_VALUES
-        current->setPrevValue (FieldValue (currentValRe, currentValIm));
+        grid.setFieldValue (FieldValue (currentValRe, currentValIm), iter, 1);
 #else /* COMPLEX_FIELD_VALUES */
-        current->setPrevValue (currentValRe);
+        grid.setFieldValue (currentValRe, iter, 1);
 #endif /* !COMPLEX_FIELD_VALUES */
 
         break;
@@ -406,9 +398,9 @@ BMPLoader<GridCoordinate2D>::loadFromFile (Grid<GridCoordinate2D> &grid, GridFil
       case PREVIOUS2:
       {
 #ifdef COMPLEX_FIELD_VALUES
-        current->setPrevPrevValue (FieldValue (currentValRe, currentValIm));
+        grid.setFieldValue (FieldValue (currentValRe, currentValIm), iter, 2);
 #else /* COMPLEX_FIELD_VALUES */
-        current->setPrevPrevValue (currentValRe);
+        grid.setFieldValue (currentValRe, iter, 2);
 #endif /* !COMPLEX_FIELD_VALUES */
 
         break;
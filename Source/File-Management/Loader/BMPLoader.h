@@ -11,11 +11,11 @@
 template <class TCoord>
 class BMPLoader: public Loader<TCoord>
 {
-  // Maximum positive value in grid.
-  FieldPointValue maxValuePos;
+  // Maximum positive value in grid for each time layer.
+  FieldValue maxValuePos[TIME_LAYERS_COUNT];
 
-  // Maximum negative value in grid.
-  FieldPointValue maxValueNeg;
+  // Maximum negative value in grid for each time layer.
+  FieldValue maxValueNeg[TIME_LAYERS_COUNT];
 
   // Helper class for usage with BMP files.
   static BMPHelper BMPhelper;
@@ -35,24 +35,24 @@ public:
   // Virtual method for grid loading.
   virtual void loadGrid (Grid<TCoord> &grid) const CXX11_OVERRIDE;
 
-  // Setter and getter for maximum positive value.
-  void setMaxValuePos (FieldPointValue& value)
+  // Setter and getter for maximum positive value of time layer.
+  void setMaxValuePos (const FieldValue& value, int time_step_back)
   {
-    maxValuePos = value;
+    maxValuePos[time_step_back] = value;
   }
-  const FieldPointValue& getMaxValuePos () const
+  const FieldValue& getMaxValuePos (int time_step_back) const
   {
-    return maxValuePos;
+    return maxValuePos[time_step_back];
   }
 
-  // Setter and getter for maximum negative value.
-  void setMaxValueNeg (FieldPointValue& value)
+  // Setter and getter for maximum negative value of time layer.
+  void setMaxValueNeg (const FieldValue& value, int time_step_back)
   {
-    maxValueNeg = value;
+    maxValueNeg[time_step_back] = value;
   }
-  const FieldPointValue& getMaxValueNeg () const
+  const FieldValue& getMaxValueNeg (int time_step_back) const
   {
-    return maxValueNeg;
+    return maxValueNeg[time_step_back];
   }
 };
 
@@ -70,18 +70,18 @@ BMPLoader<TCoord>::loadFromFile (Grid<TCoord> &grid) const
   loadFromFile (grid, CURRENT);
 #if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
 #ifdef CXX11_ENABLED
-  if (GridFileManager::type == ALL)
+  if (GridFileManager::type == ALL && grid.getCountTimeLayers () > 1)
 #else
-  if (this->GridFileManager::type == ALL)
+  if (this->GridFileManager::type == ALL && grid.getCountTimeLayers () > 1)
 #endif
   {
     loadFromFile (grid, PREVIOUS);
   }
 #if defined (TWO_TIME_STEPS)
 #ifdef CXX11_ENABLED
-  if (GridFileManager::type == ALL)
+  if (GridFileManager::type == ALL && grid.getCountTimeLayers () > 2)
 #else
-  if (this->GridFileManager::type == ALL)
+  if (this->GridFileManager::type == ALL && grid.getCountTimeLayers () > 2)
 #endif
   {
     loadFromFile (grid, PREVIOUS2);
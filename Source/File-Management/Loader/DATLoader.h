@@ -34,6 +34,8 @@ void
 DATLoader<TCoord>::loadFromFile (Grid<TCoord> &grid, GridFileType type) const
 {
   std::ifstream file;
+  int time_step_back = 0;
+
   switch (type)
   {
     case CURRENT:
@@ -44,6 +46,7 @@ DATLoader<TCoord>::loadFromFile (Grid<TCoord> &grid, GridFileType type) const
       std::string cur_dat = this->GridFileManager::cur + std::string (".dat");
 #endif
       file.open (cur_dat.c_str (), std::ios::in | std::ios::binary);
+      time_step_back = 0;
       break;
     }
 #if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
@@ -55,6 +58,7 @@ DATLoader<TCoord>::loadFromFile (Grid<TCoord> &grid, GridFileType type) const
       std::string prev_dat = this->GridFileManager::prev + std::string (".dat");
 #endif
       file.open (prev_dat.c_str (), std::ios::in | std::ios::binary);
+      time_step_back = 1;
       break;
     }
 #if defined (TWO_TIME_STEPS)
@@ -66,6 +70,7 @@ DATLoader<TCoord>::loadFromFile (Grid<TCoord> &grid, GridFileType type) const
       std::string prevPrev_dat = this->GridFileManager::prevPrev + std::string (".dat");
 #endif
       file.open (prevPrev_dat.c_str (), std::ios::in | std::ios::binary);
+      time_step_back = 2;
       break;
     }
 #endif /* TWO_TIME_STEPS */
@@ -78,48 +83,23 @@ DATLoader<TCoord>::loadFromFile (Grid<TCoord> &grid, GridFileType type) const
 
   ASSERT (file.is_open());
 
-  char* memblock = new char [sizeof (FieldValue)];
-
-  // Go through all values and write to file.
-  grid_iter end = grid.getSize().calculateTotalCoord ();
+#if defined (BLOCK_GRID_LAYOUT) || defined (SPLIT_COMPLEX_FIELD_VALUES)
+  // Go through all values of the time layer in order of indexes and read them from file.
+  grid_iter end = grid.getSize ().calculateTotalCoord ();
   for (grid_iter iter = 0; iter < end; ++iter)
   {
-    // Get current point value.
-    FieldPointValue* current = grid.getFieldPointValue (iter);
-    ASSERT (current);
-
-    switch (type)
-    {
-      case CURRENT:
-      {
-        file.read (memblock, sizeof (FieldValue));
-        current->setCurValue (*((FieldValue*) memblock));
-        break;
-      }
-#if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
-      case PREVIOUS:
-      {
-        file.read (memblock, sizeof (FieldValue));
-        current->setPrevValue (*((FieldValue*) memblock));
-        break;
-      }
-#if defined (TWO_TIME_STEPS)
-      case PREVIOUS2:
-      {
-        file.read (memblock, sizeof (FieldValue));
-        current->setPrevPrevValue (*((FieldValue*) memblock));
-        break;
-      }
-#endif /* TWO_TIME_STEPS */
-#endif /* ONE_TIME_STEP || TWO_TIME_STEPS */
-      default:
-      {
-        UNREACHABLE;
-      }
-    }
+    FieldValue value;
+    file.read ((char*) &value, sizeof (FieldValue));
+    grid.setFieldValue (value, iter, time_step_back);
   }
-
-  delete[] memblock;
+#else /* BLOCK_GRID_LAYOUT || SPLIT_COMPLEX_FIELD_VALUES */
+  // Go through all rows of the time layer and read them from file.
+  GridView<TCoord> view = grid.getView (time_step_back);
+  for (grid_iter row = 0; row < view.getRowCount (); ++row)
+  {
+    file.read ((char*) view.getRow (row), view.getRowSize () * sizeof (FieldValue));
+  }
+#endif /* !BLOCK_GRID_LAYOUT && !SPLIT_COMPLEX_FIELD_VALUES */
 
   file.close();
 }
@@ -137,18 +117,18 @@ DATLoader<TCoord>::loadGrid (Grid<TCoord> &grid) const
   loadFromFile (grid, CURRENT);
 #if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
 #ifdef CXX11_ENABLED
-  if (GridFileManager::type == ALL)
+  if (GridFileManager::type == ALL && grid.getCountTimeLayers () > 1)
 #else
-  if (this->GridFileManager::type == ALL)
+  if (this->GridFileManager::type == ALL && grid.getCountTimeLayers () > 1)
 #endif
   {
     loadFromFile (grid, PREVIOUS);
   }
 #if defined (TWO_TIME_STEPS)
 #ifdef CXX11_ENABLED
-  if (GridFileManager::type == ALL)
+  if (GridFileManager::type == ALL && grid.getCountTimeLayers () > 2)
 #else
-  if (this->GridFileManager::type == ALL)
+  if (this->GridFileManager::type == ALL && grid.getCountTimeLayers () > 2)
 #endif
   {
     loadFromFile (grid, PREVIOUS2);
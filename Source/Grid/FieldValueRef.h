@@ -0,0 +1,157 @@
+#ifndef FIELD_VALUE_REF_H
+#define FIELD_VALUE_REF_H
+
+#include "FieldValue.h"
+
+#ifdef SPLIT_COMPLEX_FIELD_VALUES
+
+/**
+ * Number of planes of storage of time layer of grid. When SPLIT_COMPLEX_FIELD_VALUES is defined, real parts of all
+ * complex values of time layer are stored in the first plane and imaginary parts in the second one, so that row
+ * kernels update each of them as stream of real values.
+ */
+#define GRID_PLANES_COUNT (2)
+
+/**
+ * Type of values in planes of storage of time layer
+ */
+typedef FPValue GridStorageValue;
+
+/**
+ * Reference to complex field value, real and imaginary parts of which are stored in different planes. Value is
+ * assembled on read and both parts are written on assignment, so reference is used in place of FieldValue &.
+ */
+class FieldValueRef
+{
+  FPValue *re;
+  FPValue *im;
+
+public:
+
+  FieldValueRef (FPValue *realPart, /**< pointer to real part */
+                 FPValue *imagPart) /**< pointer to imaginary part */
+    : re (realPart)
+    , im (imagPart)
+  {
+  } /* FieldValueRef */
+
+  operator FieldValue () const
+  {
+    return FieldValue (*re, *im);
+  } /* operator FieldValue */
+
+  FieldValueRef &operator= (const FieldValue &value) /**< value to assign */
+  {
+    *re = value.real ();
+    *im = value.imag ();
+    return *this;
+  } /* operator= */
+
+  /**
+   * Assign value, to which other reference refers, i.e. reference is not rebound
+   */
+  FieldValueRef &operator= (const FieldValueRef &ref) /**< reference to value to assign */
+  {
+    return *this = FieldValue (ref);
+  } /* operator= */
+
+  FieldValueRef &operator+= (const FieldValue &value) /**< value to add */
+  {
+    return *this = FieldValue (*this) + value;
+  } /* operator+= */
+
+  FieldValueRef &operator-= (const FieldValue &value) /**< value to subtract */
+  {
+    return *this = FieldValue (*this) - value;
+  } /* operator-= */
+
+  FPValue real () const
+  {
+    return *re;
+  } /* real */
+
+  FPValue imag () const
+  {
+    return *im;
+  } /* imag */
+}; /* FieldValueRef */
+
+/**
+ * Pointer to complex field value, real and imaginary parts of which are stored in different planes, which is used in
+ * place of FieldValue *
+ */
+class FieldValuePointer
+{
+  FieldValueRef ref;
+
+public:
+
+  FieldValuePointer (FPValue *realPart, /**< pointer to real part */
+                     FPValue *imagPart) /**< pointer to imaginary part */
+    : ref (realPart, imagPart)
+  {
+  } /* FieldValuePointer */
+
+  FieldValueRef operator* () const
+  {
+    return ref;
+  } /* operator* */
+
+  const FieldValueRef *operator-> () const
+  {
+    return &ref;
+  } /* operator-> */
+}; /* FieldValuePointer */
+
+/*
+ * Arithmetic operators of std::complex are templates, which do not accept references, so values are assembled first
+ */
+#define FIELD_VALUE_REF_OPERATOR(op) \
+  inline FieldValue operator op (const FieldValueRef &a, const FieldValueRef &b) \
+  { \
+    return FieldValue (a) op FieldValue (b); \
+  } \
+  inline FieldValue operator op (const FieldValueRef &a, const FieldValue &b) \
+  { \
+    return FieldValue (a) op b; \
+  } \
+  inline FieldValue operator op (const FieldValue &a, const FieldValueRef &b) \
+  { \
+    return a op FieldValue (b); \
+  } \
+  inline FieldValue operator op (const FieldValueRef &a, FPValue b) \
+  { \
+    return FieldValue (a) op b; \
+  } \
+  inline FieldValue operator op (FPValue a, const FieldValueRef &b) \
+  { \
+    return a op FieldValue (b); \
+  }
+
+FIELD_VALUE_REF_OPERATOR (+)
+FIELD_VALUE_REF_OPERATOR (-)
+FIELD_VALUE_REF_OPERATOR (*)
+FIELD_VALUE_REF_OPERATOR (/)
+
+#undef FIELD_VALUE_REF_OPERATOR
+
+inline FieldValue
+operator- (const FieldValueRef &a)
+{
+  return -FieldValue (a);
+} /* operator- */
+
+#else /* SPLIT_COMPLEX_FIELD_VALUES */
+
+/**
+ * Field values are stored one after another in single plane of storage of time layer
+ */
+#define GRID_PLANES_COUNT (1)
+
+typedef FieldValue GridStorageValue;
+typedef FieldValue &FieldValueRef;
+typedef FieldValue *FieldValuePointer;
+
+#endif /* !SPLIT_COMPLEX_FIELD_VALUES */
+
+#endif /* FIELD_VALUE_REF_H */
@@ -10,8 +10,8 @@ bool
 Grid<GridCoordinate1D>::isLegitIndex (const GridCoordinate1D &position, /**< coordinate in grid */
                                       const GridCoordinate1D &sizeCoord) /**< size of grid */
 {
-  const grid_coord& px = position.getX ();
-  const grid_coord& sx = sizeCoord.getX ();
+  const grid_iter& px = position.getX ();
+  const grid_iter& sx = sizeCoord.getX ();
 
   if (px < 0 || px >= sx)
   {
@@ -31,7 +31,7 @@ grid_iter
 Grid<GridCoordinate1D>::calculateIndexFromPosition (const GridCoordinate1D &position, /**< coordinate in grid */
                                                     const GridCoordinate1D &sizeCoord) /**< size of grid */
 {
-  const grid_coord& px = position.getX ();
+  const grid_iter& px = position.getX ();
 
   return px;
 } /* Grid<GridCoordinate1D>::calculateIndexFromPosition */
@@ -46,11 +46,11 @@ bool
 Grid<GridCoordinate2D>::isLegitIndex (const GridCoordinate2D &position, /**< coordinate in grid */
                                       const GridCoordinate2D &sizeCoord) /**< size of grid */
 {
-  const grid_coord& px = position.getX ();
-  const grid_coord& sx = sizeCoord.getX ();
+  const grid_iter& px = position.getX ();
+  const grid_iter& sx = sizeCoord.getX ();
 
-  const grid_coord& py = position.getY ();
-  const grid_coord& sy = sizeCoord.getY ();
+  const grid_iter& py = position.getY ();
+  const grid_iter& sy = sizeCoord.getY ();
 
   if (px < 0 || px >= sx)
   {
@@ -74,10 +74,10 @@ grid_iter
 Grid<GridCoordinate2D>::calculateIndexFromPosition (const GridCoordinate2D &position, /**< coordinate in grid */
                                                     const GridCoordinate2D &sizeCoord) /**< size of grid */
 {
-  const grid_coord& px = position.getX ();
+  const grid_iter& px = position.getX ();
 
-  const grid_coord& py = position.getY ();
-  const grid_coord& sy = sizeCoord.getY ();
+  const grid_iter& py = position.getY ();
+  const grid_iter& sy = sizeCoord.getY ();
 
   return px * sy + py;
 } /* Grid<GridCoordinate2D>::calculateIndexFromPosition */
@@ -92,14 +92,14 @@ bool
 Grid<GridCoordinate3D>::isLegitIndex (const GridCoordinate3D &position, /**< coordinate in grid */
                                       const GridCoordinate3D &sizeCoord) /**< size of grid */
 {
-  const grid_coord& px = position.getX ();
-  const grid_coord& sx = sizeCoord.getX ();
+  const grid_iter& px = position.getX ();
+  const grid_iter& sx = sizeCoord.getX ();
 
-  const grid_coord& py = position.getY ();
-  const grid_coord& sy = sizeCoord.getY ();
+  const grid_iter& py = position.getY ();
+  const grid_iter& sy = sizeCoord.getY ();
 
-  const grid_coord& pz = position.getZ ();
-  const grid_coord& sz = sizeCoord.getZ ();
+  const grid_iter& pz = position.getZ ();
+  const grid_iter& sz = sizeCoord.getZ ();
 
   if (px < 0 || px >= sx)
   {
@@ -127,13 +127,13 @@ grid_iter
 Grid<GridCoordinate3D>::calculateIndexFromPosition (const GridCoordinate3D& position, /**< coordinate in grid */
                                                     const GridCoordinate3D& sizeCoord) /**< size of grid */
 {
-  const grid_coord& px = position.getX ();
+  const grid_iter& px = position.getX ();
 
-  const grid_coord& py = position.getY ();
-  const grid_coord& sy = sizeCoord.getY ();
+  const grid_iter& py = position.getY ();
+  const grid_iter& sy = sizeCoord.getY ();
 
-  const grid_coord& pz = position.getZ ();
-  const grid_coord& sz = sizeCoord.getZ ();
+  const grid_iter& pz = position.getZ ();
+  const grid_iter& sz = sizeCoord.getZ ();
 
   return px * sy * sz + py * sz + pz;
 } /* Grid<GridCoordinate3D>::calculateIndexFromPosition */
@@ -155,12 +155,12 @@ template <>
 GridCoordinate2D
 Grid<GridCoordinate2D>::calculatePositionFromIndex (grid_iter index) const /**< index in grid */
 {
-  const grid_coord& sx = size.getX ();
-  const grid_coord& sy = size.getY ();
+  const grid_iter& sx = size.getX ();
+  const grid_iter& sy = size.getY ();
 
-  grid_coord x = index / sy;
+  grid_iter x = index / sy;
   index %= sy;
-  grid_coord y = index;
+  grid_iter y = index;
 
   return GridCoordinate2D (x, y);
 } /* Grid<GridCoordinate2D>::calculatePositionFromIndex */
@@ -172,15 +172,198 @@ template <>
 GridCoordinate3D
 Grid<GridCoordinate3D>::calculatePositionFromIndex (grid_iter index) const /**< index in grid */
 {
-  const grid_coord& sy = size.getY ();
-  const grid_coord& sz = size.getZ ();
+  const grid_iter& sy = size.getY ();
+  const grid_iter& sz = size.getZ ();
 
-  grid_coord tmp = sy * sz;
-  grid_coord x = index / tmp;
+  grid_iter tmp = sy * sz;
+  grid_iter x = index / tmp;
   index %= tmp;
-  grid_coord y = index / sz;
+  grid_iter y = index / sz;
   index %= sz;
-  grid_coord z = index;
+  grid_iter z = index;
 
   return GridCoordinate3D (x, y, z);
 } /* Grid<GridCoordinate3D>::calculatePositionFromIndex */
+
+/**
+ * Calculate size of innermost dimension of one-dimensional grid
+ *
+ * @return size of row
+ */
+template <>
+grid_iter
+Grid<GridCoordinate1D>::calculateRowSize (const GridCoordinate1D &sizeCoord) /**< size of grid */
+{
+  return sizeCoord.getX ();
+} /* Grid<GridCoordinate1D>::calculateRowSize */
+
+/**
+ * Calculate size of innermost dimension of two-dimensional grid
+ *
+ * @return size of row
+ */
+template <>
+grid_iter
+Grid<GridCoordinate2D>::calculateRowSize (const GridCoordinate2D &sizeCoord) /**< size of grid */
+{
+  return sizeCoord.getY ();
+} /* Grid<GridCoordinate2D>::calculateRowSize */
+
+/**
+ * Calculate size of innermost dimension of three-dimensional grid
+ *
+ * @return size of row
+ */
+template <>
+grid_iter
+Grid<GridCoordinate3D>::calculateRowSize (const GridCoordinate3D &sizeCoord) /**< size of grid */
+{
+  return sizeCoord.getZ ();
+} /* Grid<GridCoordinate3D>::calculateRowSize */
+
+#ifdef BLOCK_GRID_LAYOUT
+
+/**
+ * Calculate size of one-dimensional grid, which is stored in blocks. One-dimensional grids are not split in blocks
+ *
+ * @return size of storage
+ */
+template <>
+GridCoordinate1D
+Grid<GridCoordinate1D>::calculateBlockedSize (const GridCoordinate1D &sizeCoord) /**< size of grid */
+{
+  return sizeCoord;
+} /* Grid<GridCoordinate1D>::calculateBlockedSize */
+
+/**
+ * Calculate size of two-dimensional grid, which is stored in blocks, i.e. size rounded up to whole blocks
+ *
+ * @return size of storage
+ */
+template <>
+GridCoordinate2D
+Grid<GridCoordinate2D>::calculateBlockedSize (const GridCoordinate2D &sizeCoord) /**< size of grid */
+{
+  return GridCoordinate2D ((sizeCoord.getX () + GRID_BLOCK_MASK) & ~((grid_iter) GRID_BLOCK_MASK),
+                           (sizeCoord.getY () + GRID_BLOCK_MASK) & ~((grid_iter) GRID_BLOCK_MASK));
+} /* Grid<GridCoordinate2D>::calculateBlockedSize */
+
+/**
+ * Calculate size of three-dimensional grid, which is stored in blocks, i.e. size rounded up to whole blocks
+ *
+ * @return size of storage
+ */
+template <>
+GridCoordinate3D
+Grid<GridCoordinate3D>::calculateBlockedSize (const GridCoordinate3D &sizeCoord) /**< size of grid */
+{
+  return GridCoordinate3D ((sizeCoord.getX () + GRID_BLOCK_MASK) & ~((grid_iter) GRID_BLOCK_MASK),
+                           (sizeCoord.getY () + GRID_BLOCK_MASK) & ~((grid_iter) GRID_BLOCK_MASK),
+                           (sizeCoord.getZ () + GRID_BLOCK_MASK) & ~((grid_iter) GRID_BLOCK_MASK));
+} /* Grid<GridCoordinate3D>::calculateBlockedSize */
+
+#endif /* BLOCK_GRID_LAYOUT */
+
+/**
+ * Calculate offset of value in storage of time layer from one-dimensional position
+ *
+ * @return offset of value in storage
+ */
+template <>
+grid_iter
+Grid<GridCoordinate1D>::calculateOffsetFromPosition (const GridCoordinate1D &position) const /**< coordinate in grid */
+{
+  return position.getX ();
+} /* Grid<GridCoordinate1D>::calculateOffsetFromPosition */
+
+/**
+ * Calculate offset of value in storage of time layer from two-dimensional position
+ *
+ * @return offset of value in storage
+ */
+template <>
+grid_iter
+Grid<GridCoordinate2D>::calculateOffsetFromPosition (const GridCoordinate2D &position) const /**< coordinate in grid */
+{
+#ifdef BLOCK_GRID_LAYOUT
+  GridCoordinate2D blockedSize = calculateBlockedSize (size);
+
+  return calculateBlockOffset (position.getX (), position.getY (), blockedSize.getY () * GRID_BLOCK_SIZE);
+#else /* BLOCK_GRID_LAYOUT */
+  return position.getX () * pitch + position.getY ();
+#endif /* !BLOCK_GRID_LAYOUT */
+} /* Grid<GridCoordinate2D>::calculateOffsetFromPosition */
+
+/**
+ * Calculate offset of value in storage of time layer from three-dimensional position
+ *
+ * @return offset of value in storage
+ */
+template <>
+grid_iter
+Grid<GridCoordinate3D>::calculateOffsetFromPosition (const GridCoordinate3D &position) const /**< coordinate in grid */
+{
+#ifdef BLOCK_GRID_LAYOUT
+  GridCoordinate3D blockedSize = calculateBlockedSize (size);
+
+  return calculateBlockOffset (position.getX (), position.getY (), position.getZ (),
+                               blockedSize.getY () * blockedSize.getZ () * GRID_BLOCK_SIZE,
+                               blockedSize.getZ () * GRID_BLOCK_SIZE * GRID_BLOCK_SIZE);
+#else /* BLOCK_GRID_LAYOUT */
+  return (position.getX () * size.getY () + position.getY ()) * pitch + position.getZ ();
+#endif /* !BLOCK_GRID_LAYOUT */
+} /* Grid<GridCoordinate3D>::calculateOffsetFromPosition */
+
+/**
+ * Get view of time layer of one-dimensional grid
+ *
+ * @return view of time layer
+ */
+template <>
+GridView<GridCoordinate1D>
+Grid<GridCoordinate1D>::getView (int time_step_back) /**< offset in time: 0 - current, 1 - previous, etc. */
+{
+  return GridView<GridCoordinate1D> (getRaw (time_step_back), countValues, size, 1, 0, rowSize, pitch);
+} /* Grid<GridCoordinate1D>::getView */
+
+/**
+ * Get view of time layer of two-dimensional grid
+ *
+ * @return view of time layer
+ */
+template <>
+GridView<GridCoordinate2D>
+Grid<GridCoordinate2D>::getView (int time_step_back) /**< offset in time: 0 - current, 1 - previous, etc. */
+{
+#ifdef BLOCK_GRID_LAYOUT
+  GridCoordinate2D blockedSize = calculateBlockedSize (size);
+
+  return GridView<GridCoordinate2D> (getRaw (time_step_back), countValues, size,
+                                     blockedSize.getY () * GRID_BLOCK_SIZE, 1,
+                                     rowSize, pitch);
+#else /* BLOCK_GRID_LAYOUT */
+  return GridView<GridCoordinate2D> (getRaw (time_step_back), countValues, size, pitch, 1, rowSize, pitch);
+#endif /* !BLOCK_GRID_LAYOUT */
+} /* Grid<GridCoordinate2D>::getView */
+
+/**
+ * Get view of time layer of three-dimensional grid
+ *
+ * @return view of time layer
+ */
+template <>
+GridView<GridCoordinate3D>
+Grid<GridCoordinate3D>::getView (int time_step_back) /**< offset in time: 0 - current, 1 - previous, etc. */
+{
+#ifdef BLOCK_GRID_LAYOUT
+  GridCoordinate3D blockedSize = calculateBlockedSize (size);
+
+  return GridView<GridCoordinate3D> (getRaw (time_step_back), countValues, size,
+                                     blockedSize.getY () * blockedSize.getZ () * GRID_BLOCK_SIZE,
+                                     blockedSize.getZ () * GRID_BLOCK_SIZE * GRID_BLOCK_SIZE,
+                                     rowSize, pitch);
+#else /* BLOCK_GRID_LAYOUT */
+  return GridView<GridCoordinate3D> (getRaw (time_step_back), countValues, size, size.getY () * pitch, pitch,
+                                     rowSize, pitch);
+#endif /* !BLOCK_GRID_LAYOUT */
+} /* Grid<GridCoordinate3D>::getView */
@@ -1,18 +1,21 @@
 #ifndef GRID_H
 #define GRID_H
 
+#include <algorithm>
 #include <cstdlib>
 #include <vector>
 #include <string>
 
 #include "Assert.h"
-#include "FieldPoint.h"
+#include "FieldValue.h"
+#include "GridAllocator.h"
+#include "GridView.h"
 #include "GridCoordinate3D.h"
 
 /**
- * Type of vector of points in grid.
+ * Type of vector of values of single time layer in grid. Storage is taken from grid arena.
  */
-typedef std::vector<FieldPointValue *> VectorFieldPointValues;
+typedef std::vector<FieldValue, GridAllocator<FieldValue> > VectorFieldValues;
 
 /**
  * Non-parallel grid class.
@@ -28,9 +31,36 @@ protected:
   TCoord size;
 
   /**
-   * Vector of points in grid. Owns this. Deletes all FieldPointValue* itself.
+   * Values of grid, each time layer is stored contiguously in its own block of grid arena.
+   * Layer 0 is current time step, 1 is previous, 2 is previous for previous.
+   * After switch to next time step values of the last computed time step are in layer 1.
+   * When SPLIT_COMPLEX_FIELD_VALUES is defined, block of time layer consists of plane of real parts of values followed
+   * by plane of imaginary parts, value and its parts are stored at the same offset in each plane.
    */
-  VectorFieldPointValues gridValues;
+  std::vector<GridStorageValue *> gridValues;
+
+  /**
+   * Number of values in each plane of storage of time layer, including padding of rows or blocks
+   */
+  grid_iter countValues;
+
+  /**
+   * Size of innermost dimension of grid (Ox for 1D, Oy for 2D, Oz for 3D), i.e. number of values in row
+   */
+  grid_iter rowSize;
+
+  /**
+   * Number of values between starts of consecutive rows in storage. When ALIGN_GRID_ROWS is defined, each row is
+   * padded to multiple of GRID_ARENA_ALIGNMENT bytes, so that all rows are aligned, otherwise it is equal to row size.
+   * Padding values are zero.
+   */
+  grid_iter pitch;
+
+  /**
+   * Number of time layers stored in grid. Only grids, which are computed from values at previous time steps,
+   * require more than one layer. Grid without time layers does not store values and only defines geometry.
+   */
+  int countTimeLayers;
 
   /**
    * Current time step.
@@ -50,28 +80,31 @@ protected:
 
   static bool isLegitIndex (const TCoord &, const TCoord &);
   static grid_iter calculateIndexFromPosition (const TCoord &, const TCoord &);
+  static grid_iter calculateRowSize (const TCoord &);
+  static grid_iter calculatePitch (grid_iter);
+#ifdef BLOCK_GRID_LAYOUT
+  static TCoord calculateBlockedSize (const TCoord &);
+#endif /* BLOCK_GRID_LAYOUT */
 
 private:
 
-  VectorFieldPointValues& getValues ();
-  void shiftInTime ();
+  Grid &operator= (const Grid &);
 
-  void deleteGrid ();
-  void copyGrid (const Grid &);
+  void shiftInTime ();
+  void zeroValues ();
 
 protected:
 
+  void allocateValues ();
   bool isLegitIndex (const TCoord &) const;
-  grid_iter calculateIndexFromPosition (const TCoord &) const;
+  FieldValuePointer getFieldValueByOffset (grid_iter, int) const;
 
 public:
 
-  Grid (const TCoord& s, time_step step, const char * = "unnamed");
-  Grid (time_step step, const char * = "unnamed");
-  Grid (const Grid &grid);
-  ~Grid ();
-
-  Grid<TCoord> & operator = (const Grid<TCoord> &grid);
+  Grid (const TCoord& s, time_step step, const char * = "unnamed", int = TIME_LAYERS_COUNT);
+  Grid (time_step step, const char * = "unnamed", int = TIME_LAYERS_COUNT);
+  Grid (const Grid &);
+  virtual ~Grid ();
 
   const TCoord &getSize () const;
   TCoord getTotalPosition (TCoord) const;
@@ -81,12 +114,23 @@ public:
   virtual TCoord getComputationStart (TCoord) const;
   virtual TCoord getComputationEnd (TCoord) const;
   TCoord calculatePositionFromIndex (grid_iter) const;
+  grid_iter calculateIndexFromPosition (const TCoord &) const;
+  grid_iter calculateOffsetFromPosition (const TCoord &) const;
+  grid_iter calculateOffsetFromIndex (grid_iter) const;
+
+  int getCountTimeLayers () const;
+  grid_iter getPitch () const;
+  GridStorageValue *getRaw (int);
+  GridView<TCoord> getView (int);
 
-  void setFieldPointValue (FieldPointValue *, const TCoord &);
-  virtual FieldPointValue *getFieldPointValue (const TCoord &);
-  virtual FieldPointValue *getFieldPointValue (grid_iter);
+  void setFieldValue (const FieldValue &, const TCoord &, int);
+  void setFieldValue (const FieldValue &, grid_iter, int);
+  FieldValuePointer getFieldValue (const TCoord &, int);
+  FieldValuePointer getFieldValue (grid_iter, int);
 
-  virtual FieldPointValue *getFieldPointValueByAbsolutePos (const TCoord &);
+  virtual FieldValuePointer getFieldValueByAbsolutePos (const TCoord &, int);
+
+  void initialize ();
 
   virtual void nextTimeStep ();
 
@@ -103,18 +147,21 @@ public:
 template <class TCoord>
 Grid<TCoord>::Grid (const TCoord &s, /**< size of grid */
                     time_step step, /**< default time step */
-                    const char *name) /**< name of grid */
+                    const char *name, /**< name of grid */
+                    int layers) /**< number of time layers to store */
   : size (s)
-  , gridValues (size.calculateTotalCoord ())
+  , countValues (0)
+  , rowSize (0)
+  , pitch (0)
+  , countTimeLayers (layers)
   , timeStep (step)
   , gridName (name)
 {
-  for (int i = 0; i < gridValues.size (); ++i)
-  {
-    gridValues[i] = NULLPTR;
-  }
+  ASSERT (countTimeLayers >= 0 && countTimeLayers <= TIME_LAYERS_COUNT);
 
-  DPRINTF ("New grid '%s' with raw size: %lu.\n", gridName.data (), gridValues.size ());
+  allocateValues ();
+
+  DPRINTF ("New grid '%s' with raw size: %lu.\n", gridName.data (), size.calculateTotalCoord ());
 } /* Grid<TCoord>::Grid */
 
 /**
@@ -122,115 +169,157 @@ Grid<TCoord>::Grid (const TCoord &s, /**< size of grid */
  */
 template <class TCoord>
 Grid<TCoord>::Grid (time_step step, /**< default time step */
-                    const char *name) /**< name of grid */
-  : timeStep (step)
+                    const char *name, /**< name of grid */
+                    int layers) /**< number of time layers to store */
+  : countValues (0)
+  , rowSize (0)
+  , pitch (0)
+  , countTimeLayers (layers)
+  , timeStep (step)
   , gridName (name)
 {
+  ASSERT (countTimeLayers >= 0 && countTimeLayers <= TIME_LAYERS_COUNT);
+
   DPRINTF ("New grid '%s' without size.\n", gridName.data ());
 } /* Grid<TCoord>::Grid */
 
 /**
- * Copy constructor
+ * Copy constructor of grid, values of all time layers are copied to new storage
  */
 template <class TCoord>
 Grid<TCoord>::Grid (const Grid<TCoord> &grid) /**< grid to copy */
+  : size (grid.size)
+  , countValues (grid.countValues)
+  , rowSize (grid.rowSize)
+  , pitch (grid.pitch)
+  , countTimeLayers (grid.countTimeLayers)
+  , timeStep (grid.timeStep)
+  , gridName (grid.gridName)
 {
-  copyGrid (grid);
+  gridValues.resize (countTimeLayers);
 
-  DPRINTF ("New copied grid '%s' with raw size: %lu.\n", gridName.data (), gridValues.size ());
+  for (int i = 0; i < countTimeLayers; ++i)
+  {
+    gridValues[i] = static_cast<GridStorageValue *> (GridArena::allocate (countValues * sizeof (FieldValue)));
+    std::copy (grid.gridValues[i], grid.gridValues[i] + countValues * GRID_PLANES_COUNT, gridValues[i]);
+  }
 } /* Grid<TCoord>::Grid */
 
 /**
- * Destructor of grid. Should free all field point values
+ * Destructor of grid
  */
 template <class TCoord>
 Grid<TCoord>::~Grid ()
 {
-  deleteGrid ();
+  for (typename std::vector<GridStorageValue *>::iterator it = gridValues.begin (); it != gridValues.end (); ++it)
+  {
+    GridArena::deallocate (*it);
+  }
 } /* Grid<TCoord>::~Grid */
 
 /**
- * Delete grid
+ * Allocate contiguous storage for all time layers of grid according to its size and pitch of rows. Storage is not
+ * touched by allocation, all values are set to zero by zeroValues
  */
 template <class TCoord>
 void
-Grid<TCoord>::deleteGrid ()
+Grid<TCoord>::allocateValues ()
 {
-  for (VectorFieldPointValues::iterator iter = gridValues.begin ();
-       iter != gridValues.end ();
-       ++iter)
+  ASSERT (gridValues.empty ());
+
+  rowSize = calculateRowSize (size);
+  pitch = calculatePitch (rowSize);
+
+#ifdef BLOCK_GRID_LAYOUT
+  countValues = calculateBlockedSize (size).calculateTotalCoord ();
+#else /* BLOCK_GRID_LAYOUT */
+  countValues = rowSize == 0 ? 0 : size.calculateTotalCoord () / rowSize * pitch;
+#endif /* !BLOCK_GRID_LAYOUT */
+
+  gridValues.resize (countTimeLayers);
+
+  for (int i = 0; i < countTimeLayers; ++i)
   {
-    delete (*iter);
+    gridValues[i] = static_cast<GridStorageValue *> (GridArena::allocate (countValues * sizeof (FieldValue)));
   }
-} /* Grid<TCoord>::deleteGrid */
+
+  zeroValues ();
+} /* Grid<TCoord>::allocateValues */
 
 /**
- * Copy one grid to another
+ * Set all values of all time layers to zero. This is the first touch of storage, so it is performed by the same
+ * parallel loop over rows along the innermost axis (i.e. over (x, y) for 3D grid), which updates of field components
+ * use (see Scheme3D::calculateStepRows), and each page of storage is placed on NUMA node of thread, which updates it.
+ * In block layout storage is split to the same number of parts as grid along Ox axis, which are touched in order of
+ * blocks of Ox axis. Parts of all planes of storage are touched by the same thread.
  */
 template <class TCoord>
 void
-Grid<TCoord>::copyGrid (const Grid<TCoord> &grid) /**< grid to copy */
+Grid<TCoord>::zeroValues ()
 {
-  size = grid.size;
-  gridValues.resize (grid.gridValues.size ());
-  timeStep = grid.timeStep;
-  gridName = grid.gridName;
-
-  for (VectorFieldPointValues::iterator iter = gridValues.begin ();
-       iter != gridValues.end ();
-       ++iter)
+#ifdef BLOCK_GRID_LAYOUT
+  grid_iter countParts = calculateBlockedSize (size).getX ();
+#else /* BLOCK_GRID_LAYOUT */
+  grid_iter countParts = pitch == 0 ? 0 : countValues / pitch;
+#endif /* !BLOCK_GRID_LAYOUT */
+
+  if (countParts == 0)
   {
-    delete (*iter);
+    return;
   }
-} /* Grid<TCoord>::copyGrid */
 
-/**
- * Operator =
- */
-template <class TCoord>
-Grid<TCoord> &
-Grid<TCoord>::operator = (const Grid<TCoord> &grid) /**< grid to assign */
-{
-  deleteGrid ();
-  copyGrid (grid);
-
-  DPRINTF ("Copied grid '%s' with raw size: %lu.\n", gridName.data (), gridValues.size ());
+  grid_iter partSize = countValues / countParts;
 
-  return *this;
-} /* Grid<TCoord>::operator= */
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for
+#endif /* OPENMP_ENABLED */
+  for (grid_iter part = 0; part < countParts; ++part)
+  {
+    for (int i = 0; i < countTimeLayers; ++i)
+    {
+      for (int plane = 0; plane < GRID_PLANES_COUNT; ++plane)
+      {
+        GridStorageValue *values = gridValues[i] + plane * countValues;
+
+        std::fill (values + part * partSize, values + (part + 1) * partSize, GridStorageValue (0));
+      }
+    }
+  }
+} /* Grid<TCoord>::zeroValues */
 
 /**
- * Get values of the grid
+ * Calculate number of values between starts of consecutive rows in storage
  *
- * @return values of the grid
+ * @return pitch of rows
  */
 template <class TCoord>
-VectorFieldPointValues&
-Grid<TCoord>::getValues ()
+grid_iter
+Grid<TCoord>::calculatePitch (grid_iter rowSizeCoord) /**< size of row */
 {
-  return gridValues;
-} /* Grid<TCoord>::getValues */
+#ifdef ALIGN_GRID_ROWS
+  ASSERT (GRID_ARENA_ALIGNMENT % sizeof (GridStorageValue) == 0);
+
+  grid_iter valuesPerAlignment = GRID_ARENA_ALIGNMENT / sizeof (GridStorageValue);
+
+  return (rowSizeCoord + valuesPerAlignment - 1) / valuesPerAlignment * valuesPerAlignment;
+#else /* ALIGN_GRID_ROWS */
+  return rowSizeCoord;
+#endif /* !ALIGN_GRID_ROWS */
+} /* Grid<TCoord>::calculatePitch */
 
 /**
- * Replace previous time layer with current and so on
+ * Replace previous time layer with current and so on. Time layers are rotated by swapping of their storage, so the
+ * oldest layer becomes current one and its values are to be overwritten at the next time step. Cost of this operation
+ * does not depend on size of the grid
  */
 template <class TCoord>
 void
 Grid<TCoord>::shiftInTime ()
 {
-#ifdef CXX11_ENABLED
-  for (FieldPointValue* i_p : getValues ())
+  for (int i = getCountTimeLayers () - 1; i > 0; --i)
   {
-    i_p->shiftInTime ();
+    std::swap (gridValues[i], gridValues[i - 1]);
   }
-#else /* CXX11_ENABLED */
-  for (VectorFieldPointValues::iterator iter = gridValues.begin ();
-       iter != gridValues.end ();
-       ++iter)
-  {
-    (*iter)->shiftInTime ();
-  }
-#endif /* !CXX11_ENABLED */
 } /* Grid<TCoord>::shiftInTime */
 
 /**
@@ -257,6 +346,28 @@ Grid<TCoord>::calculateIndexFromPosition (const TCoord& position) const /**< coo
   return calculateIndexFromPosition (position, size);
 } /* Grid<TCoord>::calculateIndexFromPosition */
 
+/**
+ * Calculate offset of value in storage of time layer from index in grid. Offset differs from index only when rows are
+ * padded or grid is stored in blocks
+ *
+ * @return offset of value in storage
+ */
+template <class TCoord>
+grid_iter
+Grid<TCoord>::calculateOffsetFromIndex (grid_iter index) const /**< index in grid */
+{
+#ifdef BLOCK_GRID_LAYOUT
+  return calculateOffsetFromPosition (calculatePositionFromIndex (index));
+#else /* BLOCK_GRID_LAYOUT */
+  if (pitch == rowSize)
+  {
+    return index;
+  }
+
+  return index / rowSize * pitch + index % rowSize;
+#endif /* !BLOCK_GRID_LAYOUT */
+} /* Grid<TCoord>::calculateOffsetFromIndex */
+
 /**
  * Get size of the grid
  *
@@ -294,68 +405,148 @@ Grid<TCoord>::getComputationEnd (TCoord diffPosEnd) const
 } /* Grid<TCoord>::getComputationEnd () */
 
 /**
- * Set field point value at coordinate in grid
+ * Get number of time layers stored in grid
+ *
+ * @return number of time layers
+ */
+template <class TCoord>
+int
+Grid<TCoord>::getCountTimeLayers () const
+{
+  return countTimeLayers;
+} /* Grid<TCoord>::getCountTimeLayers */
+
+/**
+ * Get number of values between starts of consecutive rows in raw storage of time layer. Value at position is stored
+ * at offset, which is returned by calculateOffsetFromPosition
+ *
+ * @return pitch of rows
+ */
+template <class TCoord>
+grid_iter
+Grid<TCoord>::getPitch () const
+{
+  return pitch;
+} /* Grid<TCoord>::getPitch */
+
+/**
+ * Get raw contiguous storage of time layer of grid. Rows of storage are getPitch () values apart, unless grid is
+ * stored in blocks. For split complex values storage consists of planes of real and imaginary parts (see gridValues)
+ *
+ * @return pointer to the first value of time layer
+ */
+template <class TCoord>
+GridStorageValue *
+Grid<TCoord>::getRaw (int time_step_back) /**< offset in time: 0 - current, 1 - previous, etc. */
+{
+  ASSERT (time_step_back >= 0 && time_step_back < getCountTimeLayers ());
+
+  return gridValues[time_step_back];
+} /* Grid<TCoord>::getRaw */
+
+/**
+ * Set field value at coordinate in grid
  */
 template <class TCoord>
 void
-Grid<TCoord>::setFieldPointValue (FieldPointValue *value, /**< field point value */
-                                  const TCoord &position) /**< coordinate in grid */
+Grid<TCoord>::setFieldValue (const FieldValue &value, /**< field value */
+                             const TCoord &position, /**< coordinate in grid */
+                             int time_step_back) /**< offset in time: 0 - current, 1 - previous, etc. */
 {
   ASSERT (isLegitIndex (position));
-  ASSERT (value);
+  ASSERT (time_step_back >= 0 && time_step_back < getCountTimeLayers ());
 
-  grid_iter coord = calculateIndexFromPosition (position);
+  *getFieldValueByOffset (calculateOffsetFromPosition (position), time_step_back) = value;
+} /* Grid<TCoord>::setFieldValue */
 
-  delete gridValues[coord];
+/**
+ * Set field value at index in grid
+ */
+template <class TCoord>
+void
+Grid<TCoord>::setFieldValue (const FieldValue &value, /**< field value */
+                             grid_iter coord, /**< index in grid */
+                             int time_step_back) /**< offset in time: 0 - current, 1 - previous, etc. */
+{
+  ASSERT (coord >= 0 && coord < size.calculateTotalCoord ());
+  ASSERT (time_step_back >= 0 && time_step_back < getCountTimeLayers ());
 
-  gridValues[coord] = value;
-} /* Grid<TCoord>::setFieldPointValue */
+  *getFieldValueByOffset (calculateOffsetFromIndex (coord), time_step_back) = value;
+} /* Grid<TCoord>::setFieldValue */
 
 /**
- * Get field point value at coordinate in grid
+ * Get field value at coordinate in grid
  *
- * @return field point value
+ * @return field value
  */
 template <class TCoord>
-FieldPointValue *
-Grid<TCoord>::getFieldPointValue (const TCoord &position) /**< coordinate in grid */
+FieldValuePointer
+Grid<TCoord>::getFieldValue (const TCoord &position, /**< coordinate in grid */
+                             int time_step_back) /**< offset in time: 0 - current, 1 - previous, etc. */
 {
   ASSERT (isLegitIndex (position));
+  ASSERT (time_step_back >= 0 && time_step_back < getCountTimeLayers ());
 
-  grid_iter coord = calculateIndexFromPosition (position);
-
-  return getFieldPointValue (coord);
-} /* Grid<TCoord>::getFieldPointValue */
+  return getFieldValueByOffset (calculateOffsetFromPosition (position), time_step_back);
+} /* Grid<TCoord>::getFieldValue */
 
 /**
- * Get field point value at coordinate in grid
+ * Get field value at index in grid
  *
- * @return field point value
+ * @return field value
  */
 template <class TCoord>
-FieldPointValue *
-Grid<TCoord>::getFieldPointValue (grid_iter coord) /**< index in grid */
+FieldValuePointer
+Grid<TCoord>::getFieldValue (grid_iter coord, /**< index in grid */
+                             int time_step_back) /**< offset in time: 0 - current, 1 - previous, etc. */
 {
   ASSERT (coord >= 0 && coord < size.calculateTotalCoord ());
+  ASSERT (time_step_back >= 0 && time_step_back < getCountTimeLayers ());
 
-  FieldPointValue* value = gridValues[coord];
+  return getFieldValueByOffset (calculateOffsetFromIndex (coord), time_step_back);
+} /* Grid<TCoord>::getFieldValue */
 
-  ASSERT (value);
+/**
+ * Get field value at offset in storage of time layer (see calculateOffsetFromPosition)
+ *
+ * @return field value
+ */
+template <class TCoord>
+FieldValuePointer
+Grid<TCoord>::getFieldValueByOffset (grid_iter offset, /**< offset in storage */
+                                     int time_step_back) const /**< offset in time: 0 - current, 1 - previous, etc. */
+{
+  ASSERT (offset < countValues);
 
-  return value;
-} /* Grid<TCoord>::getFieldPointValue */
+#ifdef SPLIT_COMPLEX_FIELD_VALUES
+  return FieldValuePointer (&gridValues[time_step_back][offset], &gridValues[time_step_back][countValues + offset]);
+#else /* SPLIT_COMPLEX_FIELD_VALUES */
+  return &gridValues[time_step_back][offset];
+#endif /* !SPLIT_COMPLEX_FIELD_VALUES */
+} /* Grid<TCoord>::getFieldValueByOffset */
 
 /**
- * Get field point value at relative coordinate in grid
+ * Get field value at absolute coordinate in grid
  *
- * @return field point value
+ * @return field value
  */
 template <class TCoord>
-FieldPointValue *
-Grid<TCoord>::getFieldPointValueByAbsolutePos (const TCoord &relPosition) /**< relative coordinate in grid */
+FieldValuePointer
+Grid<TCoord>::getFieldValueByAbsolutePos (const TCoord &absPosition, /**< absolute coordinate in grid */
+                                          int time_step_back) /**< offset in time: 0 - current, 1 - previous, etc. */
+{
+  return getFieldValue (absPosition, time_step_back);
+} /* Grid<TCoord>::getFieldValueByAbsolutePos */
+
+/**
+ * Set all values of all time layers of grid to zero
+ */
+template <class TCoord>
+void
+Grid<TCoord>::initialize ()
 {
-  return getFieldPointValue (relPosition);
-} /* Grid<TCoord>::getFieldPointValueByAbsolutePos */
+  zeroValues ();
+} /* Grid<TCoord>::initialize */
 
 /**
  * Switch to next time step
@@ -0,0 +1,259 @@
+#include "GridAllocator.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif /* __linux__ */
+
+/**
+ * Memory policy of mbind, which places pages strictly on specified nodes (see MPOL_BIND in numaif.h)
+ */
+#define GRID_ARENA_MPOL_BIND (2)
+
+bool GridArena::doUseHugePages = false;
+bool GridArena::doUseExplicitHugePages = false;
+int GridArena::numaNode = GRID_ARENA_NO_NUMA_NODE;
+std::map<void *, size_t> GridArena::mappings;
+
+/**
+ * Set up placement of large blocks. Should be called before any grid is allocated
+ */
+void
+GridArena::setup (bool useHugePages, /**< flag whether to use transparent huge pages */
+                  bool useExplicitHugePages, /**< flag whether to use explicit huge pages */
+                  int node, /**< NUMA node to place blocks on or GRID_ARENA_NO_NUMA_NODE */
+                  bool useLocalNumaNode) /**< flag whether to place blocks on NUMA node of current CPU */
+{
+  ASSERT (mappings.empty ());
+  ASSERT (node == GRID_ARENA_NO_NUMA_NODE || node >= 0);
+  ASSERT (!useLocalNumaNode || node == GRID_ARENA_NO_NUMA_NODE);
+
+  doUseHugePages = useHugePages;
+  doUseExplicitHugePages = useExplicitHugePages;
+  numaNode = node;
+
+#ifdef __linux__
+  if (useLocalNumaNode)
+  {
+    unsigned cpu;
+    unsigned localNode;
+
+    if (syscall (SYS_getcpu, &cpu, &localNode, NULLPTR) == 0)
+    {
+      numaNode = localNode;
+    }
+    else
+    {
+      printf ("Warning: NUMA node of current CPU is unknown, grids are placed by default policy.\n");
+    }
+  }
+#else /* __linux__ */
+  if (doUseHugePages || doUseExplicitHugePages || numaNode != GRID_ARENA_NO_NUMA_NODE || useLocalNumaNode)
+  {
+    printf ("Warning: huge pages and NUMA placement are supported only on Linux, grids are placed in heap.\n");
+  }
+#endif /* !__linux__ */
+} /* GridArena::setup */
+
+/**
+ * Check whether block should be mapped separately rather than taken from heap
+ *
+ * @return true if block should be mapped separately
+ */
+bool
+GridArena::isMappingRequired (size_t bytes) /**< size of block */
+{
+#ifdef __linux__
+  return bytes >= GRID_ARENA_HUGE_PAGE_SIZE
+         && (doUseHugePages || doUseExplicitHugePages || numaNode != GRID_ARENA_NO_NUMA_NODE);
+#else /* __linux__ */
+  return false;
+#endif /* !__linux__ */
+} /* GridArena::isMappingRequired */
+
+/**
+ * Map block, which is aligned to huge page size. Explicit huge pages are used if requested and available, otherwise
+ * regular pages are mapped (with advice to use transparent huge pages if requested)
+ *
+ * @return pointer to mapped block or NULLPTR if mapping failed
+ */
+void *
+GridArena::mapBlock (size_t bytes, /**< size of block */
+                     size_t &length) /**< out: length of mapping */
+{
+#ifdef __linux__
+  length = ((bytes + GRID_ARENA_HUGE_PAGE_SIZE - 1) / GRID_ARENA_HUGE_PAGE_SIZE) * GRID_ARENA_HUGE_PAGE_SIZE;
+
+#ifdef MAP_HUGETLB
+  if (doUseExplicitHugePages)
+  {
+    void *ptr = mmap (NULLPTR, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+    if (ptr != MAP_FAILED)
+    {
+      return ptr;
+    }
+
+    printf ("Warning: explicit huge pages are not available, regular pages are used.\n");
+    doUseExplicitHugePages = false;
+  }
+#endif /* MAP_HUGETLB */
+
+  /*
+   * Map one extra huge page to be able to align start of block to huge page boundary, which is required for
+   * transparent huge pages to be used for the whole block. Unaligned head and tail are unmapped.
+   */
+  size_t extendedLength = length + GRID_ARENA_HUGE_PAGE_SIZE;
+
+  void *ptr = mmap (NULLPTR, extendedLength, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+  if (ptr == MAP_FAILED)
+  {
+    return NULLPTR;
+  }
+
+  size_t start = (size_t) ptr;
+  size_t alignedStart = ((start + GRID_ARENA_HUGE_PAGE_SIZE - 1) / GRID_ARENA_HUGE_PAGE_SIZE) * GRID_ARENA_HUGE_PAGE_SIZE;
+
+  if (alignedStart != start)
+  {
+    munmap (ptr, alignedStart - start);
+  }
+
+  size_t tail = start + extendedLength - (alignedStart + length);
+
+  if (tail != 0)
+  {
+    munmap ((void *) (alignedStart + length), tail);
+  }
+
+  ptr = (void *) alignedStart;
+
+#ifdef MADV_HUGEPAGE
+  if (doUseHugePages)
+  {
+    madvise (ptr, length, MADV_HUGEPAGE);
+  }
+#endif /* MADV_HUGEPAGE */
+
+  return ptr;
+#else /* __linux__ */
+  UNREACHABLE;
+  return NULLPTR;
+#endif /* !__linux__ */
+} /* GridArena::mapBlock */
+
+/**
+ * Bind pages of block to NUMA node. Binding is performed before first touch, so pages are allocated on this node
+ * regardless of CPU, which initializes values
+ */
+void
+GridArena::bindBlock (void *ptr, /**< mapped block */
+                      size_t length) /**< length of mapping */
+{
+#ifdef __linux__
+  if (numaNode == GRID_ARENA_NO_NUMA_NODE)
+  {
+    return;
+  }
+
+  const size_t bitsInMask = 8 * sizeof (unsigned long);
+
+  std::vector<unsigned long> nodeMask (numaNode / bitsInMask + 1, 0);
+  nodeMask[numaNode / bitsInMask] = 1UL << (numaNode % bitsInMask);
+
+  if (syscall (SYS_mbind, ptr, length, GRID_ARENA_MPOL_BIND, nodeMask.data (), nodeMask.size () * bitsInMask + 1, 0) != 0)
+  {
+    printf ("Warning: failed to bind grid storage to NUMA node %d, default policy is used.\n", numaNode);
+    numaNode = GRID_ARENA_NO_NUMA_NODE;
+  }
+#endif /* __linux__ */
+} /* GridArena::bindBlock */
+
+/**
+ * Allocate block
+ *
+ * @return pointer to allocated block
+ */
+void *
+GridArena::allocate (size_t bytes) /**< size of block */
+{
+  if (isMappingRequired (bytes))
+  {
+    size_t length = 0;
+    void *ptr = NULLPTR;
+
+    /*
+     * Grids and buffers of parallel grid could be allocated and freed by several threads at once, so mappings (and
+     * flags, which are reset on failures) are changed by one thread at a time
+     */
+#ifdef OPENMP_ENABLED
+    #pragma omp critical (GridArena)
+#endif /* OPENMP_ENABLED */
+    {
+      ptr = mapBlock (bytes, length);
+
+      if (ptr != NULLPTR)
+      {
+        bindBlock (ptr, length);
+        mappings[ptr] = length;
+      }
+    }
+
+    if (ptr != NULLPTR)
+    {
+      DPRINTF ("Mapped %lu bytes of grid storage.\n", (unsigned long) length);
+
+      return ptr;
+    }
+
+    printf ("Warning: failed to map %lu bytes of grid storage, heap is used.\n", (unsigned long) bytes);
+  }
+
+  void *ptr = NULLPTR;
+
+  if (posix_memalign (&ptr, GRID_ARENA_ALIGNMENT, bytes) != 0)
+  {
+    throw std::bad_alloc ();
+  }
+
+  return ptr;
+} /* GridArena::allocate */
+
+/**
+ * Free block, which was allocated by arena
+ */
+void
+GridArena::deallocate (void *ptr) /**< block to free */
+{
+#ifdef __linux__
+  size_t length = 0;
+
+#ifdef OPENMP_ENABLED
+  #pragma omp critical (GridArena)
+#endif /* OPENMP_ENABLED */
+  {
+    std::map<void *, size_t>::iterator it = mappings.find (ptr);
+
+    if (it != mappings.end ())
+    {
+      length = it->second;
+      mappings.erase (it);
+    }
+  }
+
+  if (length != 0)
+  {
+    munmap (ptr, length);
+
+    return;
+  }
+#endif /* __linux__ */
+
+  free (ptr);
+} /* GridArena::deallocate */
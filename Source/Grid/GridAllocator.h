@@ -0,0 +1,155 @@
+#ifndef GRID_ALLOCATOR_H
+#define GRID_ALLOCATOR_H
+
+#include <cstddef>
+#include <map>
+#include <new>
+
+#include "Assert.h"
+#include "FieldValue.h"
+
+/**
+ * Alignment of all blocks of arena in bytes, which is size of cache line and of the widest vector register
+ */
+#define GRID_ARENA_ALIGNMENT (64)
+
+/**
+ * Size of huge page, to which storage of large blocks is aligned
+ */
+#define GRID_ARENA_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+/**
+ * Value of NUMA node, which means that no explicit placement is performed
+ */
+#define GRID_ARENA_NO_NUMA_NODE (-1)
+
+/**
+ * Arena of memory for storage of grids.
+ *
+ * Small blocks are taken from heap and are aligned to GRID_ARENA_ALIGNMENT. Large blocks (not smaller than huge page) are mapped separately with optional
+ * transparent or explicit huge pages and optionally bound to NUMA node before first touch of memory, so placement of
+ * pages does not depend on thread, which initializes grid. By default arena behaves as heap for all blocks.
+ *
+ * Arena should be set up before any grid is allocated.
+ */
+class GridArena
+{
+  /**
+   * Flag whether to advise kernel to use transparent huge pages for large blocks
+   */
+  static bool doUseHugePages;
+
+  /**
+   * Flag whether to map large blocks to explicitly reserved huge pages (hugetlbfs)
+   */
+  static bool doUseExplicitHugePages;
+
+  /**
+   * NUMA node, on which to place large blocks, or GRID_ARENA_NO_NUMA_NODE
+   */
+  static int numaNode;
+
+  /**
+   * Mapped large blocks and length of their mappings, which are changed only inside critical section GridArena
+   */
+  static std::map<void *, size_t> mappings;
+
+private:
+
+  static bool isMappingRequired (size_t);
+
+  static void *mapBlock (size_t, size_t &);
+  static void bindBlock (void *, size_t);
+
+public:
+
+  static void setup (bool, bool, int, bool);
+
+  static void *allocate (size_t);
+  static void deallocate (void *);
+}; /* GridArena */
+
+/**
+ * Allocator of values of grids and buffers of parallel grid, which takes memory from grid arena
+ */
+template <class T>
+class GridAllocator
+{
+public:
+
+  typedef T value_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  template <class U>
+  struct rebind
+  {
+    typedef GridAllocator<U> other;
+  };
+
+  GridAllocator ()
+  {
+  } /* GridAllocator */
+
+  GridAllocator (const GridAllocator &)
+  {
+  } /* GridAllocator */
+
+  template <class U>
+  GridAllocator (const GridAllocator<U> &)
+  {
+  } /* GridAllocator */
+
+  pointer address (reference x) const
+  {
+    return &x;
+  } /* address */
+
+  const_pointer address (const_reference x) const
+  {
+    return &x;
+  } /* address */
+
+  pointer allocate (size_type n, const void * = NULLPTR)
+  {
+    return static_cast<pointer> (GridArena::allocate (n * sizeof (T)));
+  } /* allocate */
+
+  void deallocate (pointer p, size_type)
+  {
+    GridArena::deallocate (p);
+  } /* deallocate */
+
+  size_type max_size () const
+  {
+    return size_type (-1) / sizeof (T);
+  } /* max_size */
+
+  void construct (pointer p, const T &val)
+  {
+    new (p) T (val);
+  } /* construct */
+
+  void destroy (pointer p)
+  {
+    p->~T ();
+  } /* destroy */
+}; /* GridAllocator */
+
+template <class T, class U>
+bool operator== (const GridAllocator<T> &, const GridAllocator<U> &)
+{
+  return true;
+} /* operator== */
+
+template <class T, class U>
+bool operator!= (const GridAllocator<T> &, const GridAllocator<U> &)
+{
+  return false;
+} /* operator!= */
+
+#endif /* GRID_ALLOCATOR_H */
@@ -0,0 +1,352 @@
+#ifndef GRID_VIEW_H
+#define GRID_VIEW_H
+
+#include "Assert.h"
+#include "FieldValue.h"
+#include "FieldValueRef.h"
+#include "GridCoordinate3D.h"
+
+/**
+ * Binary logarithm of size of block by each axis, when values of grids are stored in blocks (see BLOCK_GRID_LAYOUT)
+ */
+#define GRID_BLOCK_SIZE_LOG (3)
+
+/**
+ * Size of block by each axis
+ */
+#define GRID_BLOCK_SIZE (1 << GRID_BLOCK_SIZE_LOG)
+
+/**
+ * Mask of position inside block
+ */
+#define GRID_BLOCK_MASK (GRID_BLOCK_SIZE - 1)
+
+/**
+ * Calculate offset of value of two-dimensional grid, which is stored in blocks. Blocks are stored in row-major order,
+ * values inside each block are also stored in row-major order.
+ *
+ * @return offset of value in storage
+ */
+inline grid_iter
+calculateBlockOffset (grid_iter x, /**< Ox coordinate */
+                      grid_iter y, /**< Oy coordinate */
+                      grid_iter strideX) /**< stride between blocks by Ox axis */
+{
+  return (x >> GRID_BLOCK_SIZE_LOG) * strideX
+         + ((y >> GRID_BLOCK_SIZE_LOG) << (2 * GRID_BLOCK_SIZE_LOG))
+         + ((x & GRID_BLOCK_MASK) << GRID_BLOCK_SIZE_LOG)
+         + (y & GRID_BLOCK_MASK);
+} /* calculateBlockOffset */
+
+/**
+ * Calculate offset of value of three-dimensional grid, which is stored in blocks. Blocks are stored in row-major order,
+ * values inside each block are also stored in row-major order.
+ *
+ * @return offset of value in storage
+ */
+inline grid_iter
+calculateBlockOffset (grid_iter x, /**< Ox coordinate */
+                      grid_iter y, /**< Oy coordinate */
+                      grid_iter z, /**< Oz coordinate */
+                      grid_iter strideX, /**< stride between blocks by Ox axis */
+                      grid_iter strideY) /**< stride between blocks by Oy axis */
+{
+  return (x >> GRID_BLOCK_SIZE_LOG) * strideX
+         + (y >> GRID_BLOCK_SIZE_LOG) * strideY
+         + ((z >> GRID_BLOCK_SIZE_LOG) << (3 * GRID_BLOCK_SIZE_LOG))
+         + ((x & GRID_BLOCK_MASK) << (2 * GRID_BLOCK_SIZE_LOG))
+         + ((y & GRID_BLOCK_MASK) << GRID_BLOCK_SIZE_LOG)
+         + (z & GRID_BLOCK_MASK);
+} /* calculateBlockOffset */
+
+/**
+ * Access policy of grid view, which checks all positions and indices
+ */
+class GridViewChecked
+{
+public:
+
+  static void check (bool isCorrect) /**< result of check */
+  {
+    ASSERT (isCorrect);
+  } /* check */
+}; /* GridViewChecked */
+
+/**
+ * Access policy of grid view, which performs no checks
+ */
+class GridViewUnchecked
+{
+public:
+
+  static void check (bool) /**< result of check */
+  {
+  } /* check */
+}; /* GridViewUnchecked */
+
+/**
+ * Default access policy of grid view. Checks are removed only from release builds
+ */
+#ifdef NDEBUG
+typedef GridViewUnchecked GridViewDefaultAccess;
+#else /* NDEBUG */
+typedef GridViewChecked GridViewDefaultAccess;
+#endif /* !NDEBUG */
+
+/**
+ * Lightweight non-virtual view of single time layer of grid, which is used in hot loops. View should be obtained once
+ * per sweep over grid (see Grid::getView) and is valid until grid switches to next time step or is destroyed.
+ *
+ * Values are addressed by relative position in grid. Each innermost row (Ox for 1D, Oy for 2D, Oz for 3D) is
+ * contiguous, rows are stored one after another with stride equal to pitch of grid. When BLOCK_GRID_LAYOUT is defined,
+ * two- and three-dimensional grids are stored in blocks (see calculateBlockOffset) and rows are not available, only
+ * parts of rows inside blocks are contiguous (see getContiguousCount). When SPLIT_COMPLEX_FIELD_VALUES is defined,
+ * real and imaginary parts of values are stored at the same offsets in two planes of storage (see getPlaneValues) and
+ * values are accessed through FieldValueRef.
+ *
+ * Checks of positions are defined by TAccess policy (GridViewChecked or GridViewUnchecked) at compile time.
+ */
+template <class TCoord, class TAccess = GridViewDefaultAccess>
+class GridView
+{
+  /**
+   * Pointer to the value at zero position in the first plane of storage
+   */
+  GridStorageValue *base;
+
+  /**
+   * Number of values in each plane of storage
+   */
+  grid_iter planeSize;
+
+  /**
+   * Size of grid
+   */
+  TCoord size;
+
+  /**
+   * Stride of Ox axis (in values). For block layout - stride between blocks
+   */
+  grid_iter strideX;
+
+  /**
+   * Stride of Oy axis (in values). For block layout - stride between blocks
+   */
+  grid_iter strideY;
+
+  /**
+   * Number of values in each innermost row
+   */
+  grid_iter rowSize;
+
+  /**
+   * Number of values between starts of consecutive rows
+   */
+  grid_iter pitch;
+
+private:
+
+  grid_iter calculateOffset (const GridCoordinate1D &pos) const
+  {
+    TAccess::check (pos.getX () < size.getX ());
+
+    return pos.getX ();
+  } /* calculateOffset */
+
+  grid_iter calculateOffset (const GridCoordinate2D &pos) const
+  {
+    TAccess::check (pos.getX () < size.getX () && pos.getY () < size.getY ());
+
+#ifdef BLOCK_GRID_LAYOUT
+    return calculateBlockOffset (pos.getX (), pos.getY (), strideX);
+#else /* BLOCK_GRID_LAYOUT */
+    return pos.getX () * strideX + pos.getY ();
+#endif /* !BLOCK_GRID_LAYOUT */
+  } /* calculateOffset */
+
+  grid_iter calculateOffset (const GridCoordinate3D &pos) const
+  {
+    TAccess::check (pos.getX () < size.getX () && pos.getY () < size.getY () && pos.getZ () < size.getZ ());
+
+#ifdef BLOCK_GRID_LAYOUT
+    return calculateBlockOffset (pos.getX (), pos.getY (), pos.getZ (), strideX, strideY);
+#else /* BLOCK_GRID_LAYOUT */
+    return pos.getX () * strideX + pos.getY () * strideY + pos.getZ ();
+#endif /* !BLOCK_GRID_LAYOUT */
+  } /* calculateOffset */
+
+public:
+
+  GridView (GridStorageValue *ptr, /**< pointer to the value at zero position */
+            grid_iter pSize, /**< number of values in each plane of storage */
+            const TCoord &s, /**< size of grid */
+            grid_iter sX, /**< stride of Ox axis */
+            grid_iter sY, /**< stride of Oy axis */
+            grid_iter rSize, /**< size of row */
+            grid_iter p) /**< pitch of rows */
+    : base (ptr)
+    , planeSize (pSize)
+    , size (s)
+    , strideX (sX)
+    , strideY (sY)
+    , rowSize (rSize)
+    , pitch (p)
+  {
+  } /* GridView */
+
+  /**
+   * Construct view from view with another access policy
+   */
+  template <class TOtherAccess>
+  GridView (const GridView<TCoord, TOtherAccess> &view) /**< view */
+    : base (view.getBase ())
+    , planeSize (view.getPlaneSize ())
+    , size (view.getSize ())
+    , strideX (view.getStrideX ())
+    , strideY (view.getStrideY ())
+    , rowSize (view.getRowSize ())
+    , pitch (view.getPitch ())
+  {
+  } /* GridView */
+
+  /**
+   * Get value at relative position in grid
+   *
+   * @return value
+   */
+  FieldValueRef operator[] (const TCoord &pos) const /**< relative position in grid */
+  {
+#ifdef SPLIT_COMPLEX_FIELD_VALUES
+    grid_iter offset = calculateOffset (pos);
+
+    return FieldValueRef (base + offset, base + planeSize + offset);
+#else /* SPLIT_COMPLEX_FIELD_VALUES */
+    return base[calculateOffset (pos)];
+#endif /* !SPLIT_COMPLEX_FIELD_VALUES */
+  } /* operator[] */
+
+  /**
+   * Get value of one-dimensional grid
+   *
+   * @return value
+   */
+  FieldValueRef get (grid_iter x) const /**< Ox coordinate */
+  {
+    return (*this)[TCoord (x)];
+  } /* get */
+
+  /**
+   * Get value of two-dimensional grid
+   *
+   * @return value
+   */
+  FieldValueRef get (grid_iter x, grid_iter y) const /**< Ox and Oy coordinates */
+  {
+    return (*this)[TCoord (x, y)];
+  } /* get */
+
+  /**
+   * Get value of three-dimensional grid
+   *
+   * @return value
+   */
+  FieldValueRef get (grid_iter x, grid_iter y, grid_iter z) const /**< Ox, Oy and Oz coordinates */
+  {
+    return (*this)[TCoord (x, y, z)];
+  } /* get */
+
+  /**
+   * Get number of values of innermost row of three-dimensional grid, which are stored contiguously starting from
+   * position, i.e. the rest of row or, for block layout, the rest of row inside block
+   *
+   * @return number of values
+   */
+  grid_iter getContiguousCount (const GridCoordinate3D &pos) const /**< relative position in grid */
+  {
+    TAccess::check (pos.getZ () < size.getZ ());
+
+    grid_iter count = size.getZ () - pos.getZ ();
+
+#ifdef BLOCK_GRID_LAYOUT
+    grid_iter countInBlock = GRID_BLOCK_SIZE - (pos.getZ () & GRID_BLOCK_MASK);
+
+    if (countInBlock < count)
+    {
+      count = countInBlock;
+    }
+#endif /* BLOCK_GRID_LAYOUT */
+
+    return count;
+  } /* getContiguousCount */
+
+  /**
+   * Get floating point values of plane of storage starting at position, i.e. real (plane 0) or imaginary (plane 1)
+   * parts of values for split complex values (see SPLIT_COMPLEX_FIELD_VALUES), otherwise values themselves (plane 0).
+   * Values are contiguous for getContiguousCount values
+   *
+   * @return pointer to the first floating point value
+   */
+  FPValue *getPlaneValues (const TCoord &pos, /**< relative position in grid */
+                           grid_iter plane) const /**< number of plane */
+  {
+    TAccess::check (plane < GRID_PLANES_COUNT);
+
+    return reinterpret_cast<FPValue *> (base + plane * planeSize + calculateOffset (pos));
+  } /* getPlaneValues */
+
+#if !defined (BLOCK_GRID_LAYOUT) && !defined (SPLIT_COMPLEX_FIELD_VALUES)
+  /**
+   * Get innermost row of view. Rows are numbered in the same order, in which they are stored
+   *
+   * @return pointer to the first value of row
+   */
+  FieldValue *getRow (grid_iter row) const /**< number of row */
+  {
+    TAccess::check (row < getRowCount ());
+
+    return base + row * pitch;
+  } /* getRow */
+
+  grid_iter getRowCount () const
+  {
+    return rowSize == 0 ? 0 : size.calculateTotalCoord () / rowSize;
+  } /* getRowCount */
+#endif /* !BLOCK_GRID_LAYOUT && !SPLIT_COMPLEX_FIELD_VALUES */
+
+  GridStorageValue *getBase () const
+  {
+    return base;
+  } /* getBase */
+
+  grid_iter getPlaneSize () const
+  {
+    return planeSize;
+  } /* getPlaneSize */
+
+  const TCoord &getSize () const
+  {
+    return size;
+  } /* getSize */
+
+  grid_iter getStrideX () const
+  {
+    return strideX;
+  } /* getStrideX */
+
+  grid_iter getStrideY () const
+  {
+    return strideY;
+  } /* getStrideY */
+
+  grid_iter getRowSize () const
+  {
+    return rowSize;
+  } /* getRowSize */
+
+  grid_iter getPitch () const
+  {
+    return pitch;
+  } /* getPitch */
+}; /* GridView */
+
+#endif /* GRID_VIEW_H */
@@ -198,9 +198,9 @@ ParallelGridCore::initOptimal (grid_coord size1, /**< grid size by first axis */
    * This heavily depends on the parallel grid sharing scheme
    */
 #define func(triple) \
-  ((size1)*(size2) / (triple.n * triple.m) + \
-   (size2)*(size3) / (triple.m * triple.k) + \
-   (size1)*(size3) / (triple.n * triple.k) + \
+  ((grid_iter) (size1)*(size2) / (triple.n * triple.m) + \
+   (grid_iter) (size2)*(size3) / (triple.m * triple.k) + \
+   (grid_iter) (size1)*(size3) / (triple.n * triple.k) + \
    4*((size1) / triple.n + (size2) / triple.n + (size3) / triple.k))
 
     Triple min_cur;
@@ -2,6 +2,10 @@
 
 #ifdef PARALLEL_GRID
 
+#ifdef OPENMP_ENABLED
+#include <omp.h>
+#endif /* OPENMP_ENABLED */
+
 #if PRINT_MESSAGE
 /**
  * Names of buffers of parallel grid for debug purposes.
@@ -47,8 +51,9 @@ ParallelGrid::ParallelGrid (const ParallelGridCoordinate &totSize, /**< total si
                                                                  *   (coreSizePerNode == sizeForCurNode for all nodes
                                                                  *   except theone at the right border) (is received
                                                                  *   from layout) */
-                            const char * name) /**< name of grid */
-  : ParallelGridBase (step, name)
+                            const char * name, /**< name of grid */
+                            int layers) /**< number of time layers to store */
+  : ParallelGridBase (step, name, layers)
   , totalSize (totSize)
   , shareStep (0)
   , bufferSize (ParallelGridCoordinate (0))
@@ -126,14 +131,14 @@ ParallelGrid::ParallelGrid (const ParallelGridCoordinate &totSize, /**< total si
    */
   ParallelGridConstructor ();
 
-  gridValues.resize (size.calculateTotalCoord ());
+  allocateValues ();
 
 #if PRINT_MESSAGE
   printf ("New grid '%s' for proc: %d (of %d) with raw size: %lu.\n",
           gridName.data (),
           parallelGridCore->getProcessId (),
           parallelGridCore->getTotalProcCount (),
-          gridValues.size ());
+          size.calculateTotalCoord ());
 #endif /* PRINT_MESSAGE */
 
   initializeStartPosition ();
@@ -1422,75 +1427,13 @@ ParallelGrid::SendReceiveCoordinatesInit3D_XYZ ()
 #endif /* PARALLEL_BUFFER_DIMENSION_3D_XYZ */
 
 /**
- * Send raw buffer with data
- */
-void
-ParallelGrid::SendRawBuffer (BufferPosition buffer, /**< buffer's position to send (direction) */
-                             int processTo) /**< id of computational node to send data to */
-{
-#if PRINT_MESSAGE
-  printf ("\tSend RAW. PID=#%d. Direction TO=%s, size=%lu.\n",
-          parallelGridCore->getProcessId (),
-          BufferPositionNames[buffer],
-          buffersSend[buffer].size ());
-#endif /* PRINT_MESSAGE */
-
-  FieldValue* rawBuffer = buffersSend[buffer].data ();
-
-  MPI_Datatype datatype;
-
-#ifdef FLOAT_VALUES
-#ifdef COMPLEX_FIELD_VALUES
-  datatype = MPI_COMPLEX;
-#else /* COMPLEX_FIELD_VALUES */
-  datatype = MPI_FLOAT;
-#endif /* !COMPLEX_FIELD_VALUES */
-#endif /* FLOAT_VALUES */
-
-#ifdef DOUBLE_VALUES
-#ifdef COMPLEX_FIELD_VALUES
-  datatype = MPI_DOUBLE_COMPLEX;
-#else /* COMPLEX_FIELD_VALUES */
-  datatype = MPI_DOUBLE;
-#endif /* !COMPLEX_FIELD_VALUES */
-#endif /* DOUBLE_VALUES */
-
-#ifdef LONG_DOUBLE_VALUES
-#ifdef COMPLEX_FIELD_VALUES
-  datatype = MPI_LONG_DOUBLE_COMPLEX;
-#else /* COMPLEX_FIELD_VALUES */
-  datatype = MPI_LONG_DOUBLE;
-#endif /* !COMPLEX_FIELD_VALUES */
-#endif /* LONG_DOUBLE_VALUES */
-
-  int retCode = MPI_Send (rawBuffer,
-                          buffersSend[buffer].size (),
-                          datatype,
-                          processTo,
-                          parallelGridCore->getProcessId (),
-                          MPI_COMM_WORLD);
-
-  ASSERT (retCode == MPI_SUCCESS);
-} /* ParallelGrid::SendRawBuffer */
-
-/**
- * Receive raw buffer with data
+ * Get MPI datatype of field values
+ *
+ * @return MPI datatype of field values
  */
-void
-ParallelGrid::ReceiveRawBuffer (BufferPosition buffer, /**< buffer's position to receive (direction) */
-                                int processFrom) /**< id of computational node to receive data from */
+MPI_Datatype
+ParallelGrid::getDatatype ()
 {
-#if PRINT_MESSAGE
-  printf ("\t\tReceive RAW. PID=#%d. Direction FROM=%s, size=%lu.\n",
-          parallelGridCore->getProcessId (),
-          BufferPositionNames[buffer],
-          buffersReceive[buffer].size ());
-#endif /* PRINT_MESSAGE */
-
-  MPI_Status status;
-
-  FieldValue* rawBuffer = buffersReceive[buffer].data ();
-
   MPI_Datatype datatype;
 
 #ifdef FLOAT_VALUES
@@ -1517,299 +1460,301 @@ ParallelGrid::ReceiveRawBuffer (BufferPosition buffer, /**< buffer's position to
 #endif /* !COMPLEX_FIELD_VALUES */
 #endif /* LONG_DOUBLE_VALUES */
 
-  int retCode = MPI_Recv (rawBuffer,
-                          buffersReceive[buffer].size (),
-                          datatype,
-                          processFrom,
-                          processFrom,
-                          MPI_COMM_WORLD,
-                          &status);
-
-  ASSERT (retCode == MPI_SUCCESS);
-} /* ParallelGrid::ReceiveRawBuffer */
+  return datatype;
+} /* ParallelGrid::getDatatype */
 
 /**
- * Send and receive raw buffers with data
- */
-void
-ParallelGrid::SendReceiveRawBuffer (BufferPosition bufferSend, /**< buffer's position to send (direction) */
-                                    int processTo, /**< id of computational node to send data to */
-                                    BufferPosition bufferReceive, /**< buffer's position to receive (direction) */
-                                    int processFrom) /**< id of computational node to receive data from */
-{
-#if PRINT_MESSAGE
-  printf ("\t\tSend/Receive RAW. PID=#%d. Directions TO=%s FROM=%s. Size TO=%lu FROM=%lu.\n",
-          parallelGridCore->getProcessId (),
-          BufferPositionNames[bufferSend],
-          BufferPositionNames[bufferReceive],
-          buffersSend[bufferSend].size (),
-          buffersReceive[bufferReceive].size ());
-#endif /* PRINT_MESSAGE */
-
-  MPI_Status status;
-
-  FieldValue* rawBufferSend = buffersSend[bufferSend].data ();
-  FieldValue* rawBufferReceive = buffersReceive[bufferReceive].data ();
-
-  MPI_Datatype datatype;
-
-#ifdef FLOAT_VALUES
-#ifdef COMPLEX_FIELD_VALUES
-  datatype = MPI_COMPLEX;
-#else /* COMPLEX_FIELD_VALUES */
-  datatype = MPI_FLOAT;
-#endif /* !COMPLEX_FIELD_VALUES */
-#endif /* FLOAT_VALUES */
-
-#ifdef DOUBLE_VALUES
-#ifdef COMPLEX_FIELD_VALUES
-  datatype = MPI_DOUBLE_COMPLEX;
-#else /* COMPLEX_FIELD_VALUES */
-  datatype = MPI_DOUBLE;
-#endif /* !COMPLEX_FIELD_VALUES */
-#endif /* DOUBLE_VALUES */
-
-#ifdef LONG_DOUBLE_VALUES
-#ifdef COMPLEX_FIELD_VALUES
-  datatype = MPI_LONG_DOUBLE_COMPLEX;
-#else /* COMPLEX_FIELD_VALUES */
-  datatype = MPI_LONG_DOUBLE;
-#endif /* !COMPLEX_FIELD_VALUES */
-#endif /* LONG_DOUBLE_VALUES */
-
-  int retCode = MPI_Sendrecv (rawBufferSend,
-                              buffersSend[bufferSend].size (),
-                              datatype,
-                              processTo,
-                              parallelGridCore->getProcessId (),
-                              rawBufferReceive,
-                              buffersReceive[bufferReceive].size (),
-                              datatype,
-                              processFrom,
-                              processFrom,
-                              MPI_COMM_WORLD,
-                              &status);
-
-  ASSERT (retCode == MPI_SUCCESS);
-} /* ParallelGrid::SendReceiveRawBuffer */
-
-/**
- * Send buffer in specified direction and receive buffer from the opposite direction
+ * Check whether current node takes part in share operations
+ *
+ * @return true if node is used
  */
-void
-ParallelGrid::SendReceiveBuffer (BufferPosition bufferDirection) /**< buffer direction to send data to and receive data
-                                                                  *   from the opposite direction */
+bool
+ParallelGrid::isNodeUsed () const
 {
-  /*
-   * Return if node not used.
-   */
 #ifdef PARALLEL_BUFFER_DIMENSION_3D_XYZ
   if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeXYZ ())
   {
-    return;
+    return false;
   }
 #endif /* PARALLEL_BUFFER_DIMENSION_3D_XYZ */
 
 #ifdef PARALLEL_BUFFER_DIMENSION_2D_XY
   if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeXY ())
   {
-    return;
+    return false;
   }
 #endif /* PARALLEL_BUFFER_DIMENSION_2D_XY */
 
 #ifdef PARALLEL_BUFFER_DIMENSION_2D_YZ
   if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeYZ ())
   {
-    return;
+    return false;
   }
 #endif /* PARALLEL_BUFFER_DIMENSION_2D_YZ */
 
 #ifdef PARALLEL_BUFFER_DIMENSION_2D_XZ
   if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeXZ ())
   {
-    return;
+    return false;
   }
 #endif /* PARALLEL_BUFFER_DIMENSION_2D_XZ */
 
-  bool doSend = parallelGridCore->getDoShare ()[bufferDirection].first;
-  bool doReceive = parallelGridCore->getDoShare ()[bufferDirection].second;
-
-  /*
-   * Copy to send buffer
-   */
-  if (doSend)
-  {
-    grid_iter index = 0;
-
-#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
-    for (grid_coord i = sendStart[bufferDirection].getX ();
-         i < sendEnd[bufferDirection].getX ();
-         ++i)
-    {
-#endif /* GRID_1D || GRID_2D || GRID_3D */
-#if defined (GRID_2D) || defined (GRID_3D)
-      for (grid_coord j = sendStart[bufferDirection].getY ();
-           j < sendEnd[bufferDirection].getY ();
-           ++j)
-      {
-#endif /* GRID_2D || GRID_3D */
-#if defined (GRID_3D)
-        for (grid_coord k = sendStart[bufferDirection].getZ ();
-             k < sendEnd[bufferDirection].getZ ();
-             ++k)
-        {
-#endif /* GRID_3D */
+  return true;
+} /* ParallelGrid::isNodeUsed */
 
+/**
+ * Calculate position in area of buffer from index of value in buffer
+ *
+ * @return position relative to start of area of buffer
+ */
+ParallelGridCoordinate
+ParallelGrid::calculateBufferPosition (const ParallelGridCoordinate &areaSize, /**< size of area of buffer */
+                                       grid_iter index) /**< index of value in buffer (without time layers) */
+{
 #if defined (GRID_1D)
-          ParallelGridCoordinate pos (i);
+  return ParallelGridCoordinate (index);
 #endif /* GRID_1D */
+
 #if defined (GRID_2D)
-          ParallelGridCoordinate pos (i, j);
+  grid_iter x = index / areaSize.getY ();
+  grid_iter y = index % areaSize.getY ();
+
+  return ParallelGridCoordinate (x, y);
 #endif /* GRID_2D */
+
 #if defined (GRID_3D)
-          ParallelGridCoordinate pos (i, j, k);
+  grid_iter tmp = areaSize.getY () * areaSize.getZ ();
+  grid_iter x = index / tmp;
+  index %= tmp;
+  grid_iter y = index / areaSize.getZ ();
+  grid_iter z = index % areaSize.getZ ();
+
+  return ParallelGridCoordinate (x, y, z);
 #endif /* GRID_3D */
+} /* ParallelGrid::calculateBufferPosition */
 
-          FieldPointValue* val = getFieldPointValue (pos);
+/**
+ * Copy values of grid to send buffer
+ *
+ * Values are copied in order of positions (the last coordinate changes first), all time layers of each position are
+ * placed together. When called inside parallel region, values are distributed between threads of region.
+ */
+void
+ParallelGrid::CopyToSendBuffer (BufferPosition bufferDirection) /**< buffer direction */
+{
+  ParallelGridCoordinate start = sendStart[bufferDirection];
+  ParallelGridCoordinate areaSize = sendEnd[bufferDirection] - start;
 
-          buffersSend[bufferDirection][index++] = val->getCurValue ();
-#if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
-          buffersSend[bufferDirection][index++] = val->getPrevValue ();
-#if defined (TWO_TIME_STEPS)
-          buffersSend[bufferDirection][index++] = val->getPrevPrevValue ();
-#endif /* TWO_TIME_STEPS */
-#endif /* ONE_TIME_STEP || TWO_TIME_STEPS */
+  grid_iter count = areaSize.calculateTotalCoord ();
+  int layers = getCountTimeLayers ();
 
-#if defined (GRID_3D)
-        }
-#endif /* GRID_3D */
+  FieldValue *buffer = buffersSend[bufferDirection].data ();
 
-#if defined (GRID_2D) || defined (GRID_3D)
-      }
-#endif /* GRID_2D || GRID_3D */
+#ifdef OPENMP_ENABLED
+  #pragma omp for
+#endif /* OPENMP_ENABLED */
+  for (grid_iter index = 0; index < count; ++index)
+  {
+    grid_iter coord = calculateOffsetFromPosition (start + calculateBufferPosition (areaSize, index));
 
-#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
+    for (int t = 0; t < layers; ++t)
+    {
+      buffer[index * layers + t] = *getFieldValueByOffset (coord, t);
     }
-#endif /* GRID_1D || GRID_2D || GRID_3D */
   }
+} /* ParallelGrid::CopyToSendBuffer */
 
+/**
+ * Copy values from receive buffer to grid
+ *
+ * Layout of values is the same as in CopyToSendBuffer. When called inside parallel region, values are distributed
+ * between threads of region. Areas of receive buffers of different directions do not intersect, so threads do not
+ * wait for each other after each direction.
+ */
+void
+ParallelGrid::CopyFromReceiveBuffer (BufferPosition bufferDirection) /**< buffer direction, from the opposite of which
+                                                                      *   values are received */
+{
   BufferPosition opposite = parallelGridCore->getOppositeDirections ()[bufferDirection];
 
-  int processTo = parallelGridCore->getDirections ()[bufferDirection];
-  int processFrom = parallelGridCore->getDirections ()[opposite];
+  ParallelGridCoordinate start = recvStart[bufferDirection];
+  ParallelGridCoordinate areaSize = recvEnd[bufferDirection] - start;
 
-#if PRINT_MESSAGE
-  printf ("\tSHARE RAW. PID=#%d. Directions TO(%d)=%s=#%d, FROM(%d)=%s=#%d.\n",
-          parallelGridCore->getProcessId (),
-          doSend,
-          BufferPositionNames[bufferDirection],
-          processTo,
-          doReceive,
-          BufferPositionNames[opposite],
-          processFrom);
-#endif /* PRINT_MESSAGE */
+  grid_iter count = areaSize.calculateTotalCoord ();
+  int layers = getCountTimeLayers ();
 
-  if (doSend && !doReceive)
-  {
-    SendRawBuffer (bufferDirection, processTo);
-  }
-  else if (!doSend && doReceive)
-  {
-    ReceiveRawBuffer (opposite, processFrom);
-  }
-  else if (doSend && doReceive)
+  const FieldValue *buffer = buffersReceive[opposite].data ();
+
+#ifdef OPENMP_ENABLED
+  #pragma omp for nowait
+#endif /* OPENMP_ENABLED */
+  for (grid_iter index = 0; index < count; ++index)
   {
-    SendReceiveRawBuffer (bufferDirection, processTo, opposite, processFrom);
+    grid_iter coord = calculateOffsetFromPosition (start + calculateBufferPosition (areaSize, index));
+
+    for (int t = 0; t < layers; ++t)
+    {
+      *getFieldValueByOffset (coord, t) = buffer[index * layers + t];
+    }
   }
-  else
+} /* ParallelGrid::CopyFromReceiveBuffer */
+
+/**
+ * Start share operations for grid: post receives of buffers from all directions, fill send buffers and post sends of
+ * them to all directions
+ *
+ * Send buffers are filled by all threads of node. MPI is called only by the calling thread, which should be master
+ * thread (so MPI_THREAD_FUNNELED is enough). Share operations are completed by finishShare.
+ */
+void
+ParallelGrid::startShare ()
+{
+  ASSERT (requestsSend.empty () && requestsReceive.empty ());
+
+  if (!isNodeUsed ())
   {
-    /*
-     * Do nothing
-     */
+    return;
   }
 
+#if PRINT_MESSAGE
+  printf ("Start share PID=%d\n", parallelGridCore->getProcessId ());
+#endif /* PRINT_MESSAGE */
+
+  MPI_Datatype datatype = getDatatype ();
+
   /*
-   * Copy from receive buffer
+   * Receives are posted first, so that buffers could be received to their place as soon as they are sent
    */
-  if (doReceive)
+  for (int buf = 0; buf < BUFFER_COUNT; ++buf)
   {
-#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
-    for (grid_iter index = 0, i = recvStart[bufferDirection].getX ();
-         i < recvEnd[bufferDirection].getX (); ++i)
+    BufferPosition bufferDirection = (BufferPosition) buf;
+
+    if (!parallelGridCore->getDoShare ()[bufferDirection].second)
     {
-#endif /* GRID_1D || GRID_2D || GRID_3D */
+      continue;
+    }
 
-#if defined (GRID_2D) || defined (GRID_3D)
-      for (grid_coord j = recvStart[bufferDirection].getY ();
-           j < recvEnd[bufferDirection].getY (); ++j)
+    BufferPosition opposite = parallelGridCore->getOppositeDirections ()[bufferDirection];
+    int processFrom = parallelGridCore->getDirections ()[opposite];
+
+    ASSERT (buffersReceive[opposite].size () <= PARALLEL_GRID_MPI_MAX_COUNT);
+
+    MPI_Request request;
+    int retCode = MPI_Irecv (buffersReceive[opposite].data (),
+                             buffersReceive[opposite].size (),
+                             datatype,
+                             processFrom,
+                             processFrom,
+                             MPI_COMM_WORLD,
+                             &request);
+    ASSERT (retCode == MPI_SUCCESS);
+
+    requestsReceive.push_back (request);
+  }
+
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel
+#endif /* OPENMP_ENABLED */
+  {
+    for (int buf = 0; buf < BUFFER_COUNT; ++buf)
+    {
+      if (parallelGridCore->getDoShare ()[buf].first)
       {
-#endif /* GRID_2D || GRID_3D */
+        CopyToSendBuffer ((BufferPosition) buf);
+      }
+    }
+  }
 
-#if defined (GRID_3D)
-        for (grid_coord k = recvStart[bufferDirection].getZ ();
-             k < recvEnd[bufferDirection].getZ (); ++k)
-        {
-#endif /* GRID_3D */
+  for (int buf = 0; buf < BUFFER_COUNT; ++buf)
+  {
+    BufferPosition bufferDirection = (BufferPosition) buf;
 
-#if defined (TWO_TIME_STEPS)
-          FieldPointValue* val = new FieldPointValue (buffersReceive[opposite][index++],
-                                                      buffersReceive[opposite][index++],
-                                                      buffersReceive[opposite][index++]);
-#else /* TWO_TIME_STEPS */
-#if defined (ONE_TIME_STEP)
-          FieldPointValue* val = new FieldPointValue (buffersReceive[opposite][index++],
-                                                      buffersReceive[opposite][index++]);
-#else /* ONE_TIME_STEP */
-          FieldPointValue* val = new FieldPointValue (buffersReceive[opposite][index++]);
-#endif /* !ONE_TIME_STEP */
-#endif /* !TWO_TIME_STEPS */
+    if (!parallelGridCore->getDoShare ()[bufferDirection].first)
+    {
+      continue;
+    }
 
-#if defined (GRID_1D)
-          ParallelGridCoordinate pos (i);
-#endif /* GRID_1D */
+    int processTo = parallelGridCore->getDirections ()[bufferDirection];
 
-#if defined (GRID_2D)
-          ParallelGridCoordinate pos (i, j);
-#endif /* GRID_2D */
+    ASSERT (buffersSend[bufferDirection].size () <= PARALLEL_GRID_MPI_MAX_COUNT);
 
-#if defined (GRID_3D)
-          ParallelGridCoordinate pos (i, j, k);
-#endif /* GRID_3D */
+    MPI_Request request;
+    int retCode = MPI_Isend (buffersSend[bufferDirection].data (),
+                             buffersSend[bufferDirection].size (),
+                             datatype,
+                             processTo,
+                             parallelGridCore->getProcessId (),
+                             MPI_COMM_WORLD,
+                             &request);
+    ASSERT (retCode == MPI_SUCCESS);
 
-          setFieldPointValue (val, ParallelGridCoordinate (pos));
+    requestsSend.push_back (request);
+  }
+} /* ParallelGrid::startShare */
 
-#if defined (GRID_3D)
-        }
-#endif /* GRID_3D */
+/**
+ * Progress share operations, which are started by startShare. Should be called by the thread, which started them.
+ *
+ * @return true if all sends and receives are completed
+ */
+bool
+ParallelGrid::testShare ()
+{
+  int isReceived = 1;
+  int isSent = 1;
 
-#if defined (GRID_2D) || defined (GRID_3D)
-      }
-#endif /* GRID_2D || GRID_3D */
+  if (!requestsReceive.empty ())
+  {
+    int retCode = MPI_Testall (requestsReceive.size (), requestsReceive.data (), &isReceived, MPI_STATUSES_IGNORE);
+    ASSERT (retCode == MPI_SUCCESS);
+  }
 
-#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
-    }
-#endif /* GRID_1D || GRID_2D || GRID_3D */
+  if (!requestsSend.empty ())
+  {
+    int retCode = MPI_Testall (requestsSend.size (), requestsSend.data (), &isSent, MPI_STATUSES_IGNORE);
+    ASSERT (retCode == MPI_SUCCESS);
   }
-} /* ParallelGrid::SendReceiveBuffer */
+
+  return isReceived && isSent;
+} /* ParallelGrid::testShare */
 
 /**
- * Send/receive method to be called for all grid types.
+ * Finish share operations, which are started by startShare: wait for all receives and then copy received buffers to
+ * grid by all threads of node. Should be called by the thread, which started share operations.
+ *
+ * Values of grid, which are copied to send buffers, are not changed here, so sends are waited for at the end.
  */
 void
-ParallelGrid::SendReceive ()
+ParallelGrid::finishShare ()
 {
-#if PRINT_MESSAGE
-  printf ("Send/Receive PID=%d\n", parallelGridCore->getProcessId ());
-#endif /* PRINT_MESSAGE */
+  if (!requestsReceive.empty ())
+  {
+    int retCode = MPI_Waitall (requestsReceive.size (), requestsReceive.data (), MPI_STATUSES_IGNORE);
+    ASSERT (retCode == MPI_SUCCESS);
 
-  /*
-   * Go through all directions and send/receive.
-   */
-  for (int buf = 0; buf < BUFFER_COUNT; ++buf)
+#ifdef OPENMP_ENABLED
+    #pragma omp parallel
+#endif /* OPENMP_ENABLED */
+    {
+      for (int buf = 0; buf < BUFFER_COUNT; ++buf)
+      {
+        if (parallelGridCore->getDoShare ()[buf].second)
+        {
+          CopyFromReceiveBuffer ((BufferPosition) buf);
+        }
+      }
+    }
+  }
+
+  if (!requestsSend.empty ())
   {
-    SendReceiveBuffer ((BufferPosition) buf);
+    int retCode = MPI_Waitall (requestsSend.size (), requestsSend.data (), MPI_STATUSES_IGNORE);
+    ASSERT (retCode == MPI_SUCCESS);
   }
-} /* ParallelGrid::SendReceive */
+
+  requestsReceive.clear ();
+  requestsSend.clear ();
+} /* ParallelGrid::finishShare */
 
 /**
  * Perform share operations for grid
@@ -1817,11 +1762,76 @@ ParallelGrid::SendReceive ()
 void
 ParallelGrid::share ()
 {
-  SendReceive ();
-
-  MPI_Barrier (MPI_COMM_WORLD);
+  startShare ();
+  finishShare ();
 } /* ParallelGrid::share */
 
+/**
+ * Perform share operations for grid, while threads of node perform computation, which does not read receive buffers
+ *
+ * When node runs several threads, master thread is reserved to progress share operations with testShare, while other
+ * threads take parts of computation. Master thread takes parts too, when all sends and receives are completed. With
+ * single thread, share operations are progressed between parts. Received buffers are copied to grid only after all
+ * parts are finished.
+ */
+void
+ParallelGrid::shareOverlapped (ShareOverlapTask &task) /**< computation to perform during share operations */
+{
+  startShare ();
+
+  grid_iter numParts = task.getNumParts ();
+  grid_iter nextPart = 0;
+  bool isShared = false;
+
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel
+#endif /* OPENMP_ENABLED */
+  {
+#ifdef OPENMP_ENABLED
+    bool isReserved = omp_get_num_threads () > 1;
+#else /* OPENMP_ENABLED */
+    bool isReserved = false;
+#endif /* !OPENMP_ENABLED */
+
+    while (true)
+    {
+      bool isPolling = false;
+
+#ifdef OPENMP_ENABLED
+      #pragma omp master
+#endif /* OPENMP_ENABLED */
+      {
+        if (!isShared)
+        {
+          isShared = testShare ();
+          isPolling = !isShared && isReserved;
+        }
+      }
+
+      if (isPolling)
+      {
+        continue;
+      }
+
+      grid_iter part;
+
+#ifdef OPENMP_ENABLED
+      #pragma omp atomic capture
+#endif /* OPENMP_ENABLED */
+      part = nextPart++;
+
+      if (part >= numParts)
+      {
+        break;
+      }
+
+      task.run (part);
+    }
+  }
+
+  finishShare ();
+} /* ParallelGrid::shareOverlapped */
+
 /**
  * Init parallel buffers
  */
@@ -1860,14 +1870,9 @@ ParallelGrid::InitBuffers ()
 #endif /* PARALLEL_BUFFER_DIMENSION_2D_XZ */
 
   /*
-   * Number of time steps in build used to initialize parallel grid
+   * Number of time layers of this grid, which are sent to neighbours
    */
-#if defined (ONE_TIME_STEP)
-  const grid_iter numTimeStepsInBuild = 2;
-#endif /* ONE_TIME_STEP */
-#if defined (TWO_TIME_STEPS)
-  const grid_iter numTimeStepsInBuild = 3;
-#endif /* TWO_TIME_STEPS */
+  const grid_iter numTimeStepsInBuild = getCountTimeLayers ();
 
   buffersSend.resize (BUFFER_COUNT);
   buffersReceive.resize (BUFFER_COUNT);
@@ -1876,7 +1881,7 @@ ParallelGrid::InitBuffers ()
     defined (PARALLEL_BUFFER_DIMENSION_2D_XZ) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
   if (parallelGridCore->getHasL ())
   {
-    int buf_size = bufferSize.getX () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getX () * numTimeStepsInBuild;
 #if defined (GRID_2D) || defined (GRID_3D)
     buf_size *= currentSize.getY ();
 #endif /* GRID_2D || GRID_3D */
@@ -1888,7 +1893,7 @@ ParallelGrid::InitBuffers ()
   }
   if (parallelGridCore->getHasR ())
   {
-    int buf_size = bufferSize.getX () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getX () * numTimeStepsInBuild;
 #if defined (GRID_2D) || defined (GRID_3D)
     buf_size *= currentSize.getY ();
 #endif /* GRID_2D || GRID_3D */
@@ -1905,7 +1910,7 @@ ParallelGrid::InitBuffers ()
     defined (PARALLEL_BUFFER_DIMENSION_2D_YZ) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
   if (parallelGridCore->getHasD ())
   {
-    int buf_size = bufferSize.getY () * currentSize.getX () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getY () * currentSize.getX () * numTimeStepsInBuild;
 #if defined (GRID_3D)
     buf_size *= currentSize.getZ ();
 #endif /* GRID_3D */
@@ -1914,7 +1919,7 @@ ParallelGrid::InitBuffers ()
   }
   if (parallelGridCore->getHasU ())
   {
-    int buf_size = bufferSize.getY () * currentSize.getX () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getY () * currentSize.getX () * numTimeStepsInBuild;
 #if defined (GRID_3D)
     buf_size *= currentSize.getZ ();
 #endif /* GRID_3D */
@@ -1928,13 +1933,13 @@ ParallelGrid::InitBuffers ()
     defined (PARALLEL_BUFFER_DIMENSION_2D_XZ) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
   if (parallelGridCore->getHasB ())
   {
-    int buf_size = bufferSize.getZ () * currentSize.getY () * currentSize.getX () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getZ () * currentSize.getY () * currentSize.getX () * numTimeStepsInBuild;
     buffersSend[BACK].resize (buf_size);
     buffersReceive[BACK].resize (buf_size);
   }
   if (parallelGridCore->getHasF ())
   {
-    int buf_size = bufferSize.getZ () * currentSize.getY () * currentSize.getX () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getZ () * currentSize.getY () * currentSize.getX () * numTimeStepsInBuild;
     buffersSend[FRONT].resize (buf_size);
     buffersReceive[FRONT].resize (buf_size);
   }
@@ -1944,7 +1949,7 @@ ParallelGrid::InitBuffers ()
 #if defined (PARALLEL_BUFFER_DIMENSION_2D_XY) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
   if (parallelGridCore->getHasL () && parallelGridCore->getHasD ())
   {
-    int buf_size = bufferSize.getX () * bufferSize.getY () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getX () * bufferSize.getY () * numTimeStepsInBuild;
 #if defined (GRID_3D)
     buf_size *= currentSize.getZ ();
 #endif /* GRID_3D */
@@ -1953,7 +1958,7 @@ ParallelGrid::InitBuffers ()
   }
   if (parallelGridCore->getHasL () && parallelGridCore->getHasU ())
   {
-    int buf_size = bufferSize.getX () * bufferSize.getY () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getX () * bufferSize.getY () * numTimeStepsInBuild;
 #if defined (GRID_3D)
     buf_size *= currentSize.getZ ();
 #endif /* GRID_3D */
@@ -1962,7 +1967,7 @@ ParallelGrid::InitBuffers ()
   }
   if (parallelGridCore->getHasR () && parallelGridCore->getHasD ())
   {
-    int buf_size = bufferSize.getX () * bufferSize.getY () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getX () * bufferSize.getY () * numTimeStepsInBuild;
 #if defined (GRID_3D)
     buf_size *= currentSize.getZ ();
 #endif /* GRID_3D */
@@ -1971,7 +1976,7 @@ ParallelGrid::InitBuffers ()
   }
   if (parallelGridCore->getHasR () && parallelGridCore->getHasU ())
   {
-    int buf_size = bufferSize.getX () * bufferSize.getY () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getX () * bufferSize.getY () * numTimeStepsInBuild;
 #if defined (GRID_3D)
     buf_size *= currentSize.getZ ();
 #endif /* GRID_3D */
@@ -1983,25 +1988,25 @@ ParallelGrid::InitBuffers ()
 #if defined (PARALLEL_BUFFER_DIMENSION_2D_YZ) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
   if (parallelGridCore->getHasD () && parallelGridCore->getHasB ())
   {
-    int buf_size = bufferSize.getY () * bufferSize.getZ () * currentSize.getX () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getY () * bufferSize.getZ () * currentSize.getX () * numTimeStepsInBuild;
     buffersSend[DOWN_BACK].resize (buf_size);
     buffersReceive[DOWN_BACK].resize (buf_size);
   }
   if (parallelGridCore->getHasD () && parallelGridCore->getHasF ())
   {
-    int buf_size = bufferSize.getY () * bufferSize.getZ () * currentSize.getX () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getY () * bufferSize.getZ () * currentSize.getX () * numTimeStepsInBuild;
     buffersSend[DOWN_FRONT].resize (buf_size);
     buffersReceive[DOWN_FRONT].resize (buf_size);
   }
   if (parallelGridCore->getHasU () && parallelGridCore->getHasB ())
   {
-    int buf_size = bufferSize.getY () * bufferSize.getZ () * currentSize.getX () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getY () * bufferSize.getZ () * currentSize.getX () * numTimeStepsInBuild;
     buffersSend[UP_BACK].resize (buf_size);
     buffersReceive[UP_BACK].resize (buf_size);
   }
   if (parallelGridCore->getHasU () && parallelGridCore->getHasF ())
   {
-    int buf_size = bufferSize.getY () * bufferSize.getZ () * currentSize.getX () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getY () * bufferSize.getZ () * currentSize.getX () * numTimeStepsInBuild;
     buffersSend[UP_FRONT].resize (buf_size);
     buffersReceive[UP_FRONT].resize (buf_size);
   }
@@ -2010,32 +2015,32 @@ ParallelGrid::InitBuffers ()
 #if defined (PARALLEL_BUFFER_DIMENSION_2D_XZ) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
   if (parallelGridCore->getHasL () && parallelGridCore->getHasB ())
   {
-    int buf_size = bufferSize.getX () * bufferSize.getZ () * currentSize.getY () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getX () * bufferSize.getZ () * currentSize.getY () * numTimeStepsInBuild;
     buffersSend[LEFT_BACK].resize (buf_size);
     buffersReceive[LEFT_BACK].resize (buf_size);
   }
   if (parallelGridCore->getHasL () && parallelGridCore->getHasF ())
   {
-    int buf_size = bufferSize.getX () * bufferSize.getZ () * currentSize.getY () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getX () * bufferSize.getZ () * currentSize.getY () * numTimeStepsInBuild;
     buffersSend[LEFT_FRONT].resize (buf_size);
     buffersReceive[LEFT_FRONT].resize (buf_size);
   }
   if (parallelGridCore->getHasR () && parallelGridCore->getHasB ())
   {
-    int buf_size = bufferSize.getX () * bufferSize.getZ () * currentSize.getY () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getX () * bufferSize.getZ () * currentSize.getY () * numTimeStepsInBuild;
     buffersSend[RIGHT_BACK].resize (buf_size);
     buffersReceive[RIGHT_BACK].resize (buf_size);
   }
   if (parallelGridCore->getHasR () && parallelGridCore->getHasF ())
   {
-    int buf_size = bufferSize.getX () * bufferSize.getZ () * currentSize.getY () * numTimeStepsInBuild;
+    grid_iter buf_size = bufferSize.getX () * bufferSize.getZ () * currentSize.getY () * numTimeStepsInBuild;
     buffersSend[RIGHT_FRONT].resize (buf_size);
     buffersReceive[RIGHT_FRONT].resize (buf_size);
   }
 #endif /* PARALLEL_BUFFER_DIMENSION_2D_XZ || PARALLEL_BUFFER_DIMENSION_3D_XYZ */
 
 #if defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
-  int buf_size = bufferSize.getX () * bufferSize.getY () * bufferSize.getZ () * numTimeStepsInBuild;
+  grid_iter buf_size = bufferSize.getX () * bufferSize.getY () * bufferSize.getZ () * numTimeStepsInBuild;
   if (parallelGridCore->getHasL ()
       && parallelGridCore->getHasD ()
       && parallelGridCore->getHasB ())
@@ -2155,15 +2160,13 @@ ParallelGrid::ParallelGridConstructor ()
 } /* ParallelGrid::ParallelGridConstructor */
 
 /**
- * Switch to next time step
+ * Check whether share operations should be performed at current share step
+ *
+ * @return true if share operations should be performed
  */
-void
-ParallelGrid::nextTimeStep ()
+bool
+ParallelGrid::isShareTime () const
 {
-  ParallelGridBase::nextTimeStep ();
-
-  nextShareStep ();
-
 #if defined (PARALLEL_BUFFER_DIMENSION_1D_X) || defined (PARALLEL_BUFFER_DIMENSION_2D_XY) || \
     defined (PARALLEL_BUFFER_DIMENSION_2D_XZ) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
   ASSERT (shareStep <= bufferSize.getX ());
@@ -2186,13 +2189,56 @@ ParallelGrid::nextTimeStep ()
 #endif /* PARALLEL_BUFFER_DIMENSION_1D_Z || PARALLEL_BUFFER_DIMENSION_2D_YZ ||
           PARALLEL_BUFFER_DIMENSION_2D_XZ || PARALLEL_BUFFER_DIMENSION_3D_XYZ */
 
-  if (is_share_time)
+  return is_share_time;
+} /* ParallelGrid::isShareTime */
+
+/**
+ * Switch to next time step
+ */
+void
+ParallelGrid::nextTimeStep ()
+{
+  ParallelGridBase::nextTimeStep ();
+
+  nextShareStep ();
+
+  if (isShareTime ())
   {
     share ();
     zeroShareStep ();
   }
 } /* ParallelGrid::nextTimeStep */
 
+/**
+ * Switch to next time step and perform computation, which does not read receive buffers of grid. When share
+ * operations are performed at this step, computation is overlapped with them (see shareOverlapped).
+ */
+void
+ParallelGrid::nextTimeStep (ShareOverlapTask &task) /**< computation to perform */
+{
+  ParallelGridBase::nextTimeStep ();
+
+  nextShareStep ();
+
+  if (isShareTime ())
+  {
+    shareOverlapped (task);
+    zeroShareStep ();
+  }
+  else
+  {
+    grid_iter numParts = task.getNumParts ();
+
+#ifdef OPENMP_ENABLED
+    #pragma omp parallel for schedule (dynamic)
+#endif /* OPENMP_ENABLED */
+    for (grid_iter part = 0; part < numParts; ++part)
+    {
+      task.run (part);
+    }
+  }
+} /* ParallelGrid::nextTimeStep */
+
 /**
  * Increase share step
  */
@@ -2324,23 +2370,27 @@ ParallelGrid::getRelativePosition (ParallelGridCoordinate pos) /**< total positi
 } /* ParallelGrid::getRelativePosition */
 
 /**
- * Get field point value at absolute coordinate in grid
+ * Get field value at absolute coordinate in grid
  *
- * @return field point value
+ * @return field value
  */
-FieldPointValue *
-ParallelGrid::getFieldPointValueByAbsolutePos (const ParallelGridCoordinate &absPosition) /**< absolute coordinate in grid */
+FieldValuePointer
+ParallelGrid::getFieldValueByAbsolutePos (const ParallelGridCoordinate &absPosition, /**< absolute coordinate in grid */
+                                          int time_step_back) /**< offset in time: 0 - current, 1 - previous, etc. */
 {
-  return getFieldPointValue (getRelativePosition (absPosition));
-} /* ParallelGrid::getFieldPointValueByAbsolutePos */
+  return getFieldValue (getRelativePosition (absPosition), time_step_back);
+} /* ParallelGrid::getFieldValueByAbsolutePos */
 
+#ifndef SPLIT_COMPLEX_FIELD_VALUES
 /**
- * Get field point value at absolute coordinate in grid. If current node does not contain this coordinate, return NULLPTR
+ * Get field value at absolute coordinate in grid. If current node does not contain this coordinate, return NULLPTR.
+ * Is used only by 2D schemes, so is not available for split complex values (see SPLIT_COMPLEX_FIELD_VALUES)
  *
- * @return field point value or NULLPTR
+ * @return field value or NULLPTR
  */
-FieldPointValue *
-ParallelGrid::getFieldPointValueOrNullByAbsolutePos (const ParallelGridCoordinate &absPosition) /**< absolute coordinate in grid */
+FieldValue *
+ParallelGrid::getFieldValueOrNullByAbsolutePos (const ParallelGridCoordinate &absPosition, /**< absolute coordinate in grid */
+                                                int time_step_back) /**< offset in time: 0 - current, 1 - previous, etc. */
 {
   ParallelGridCoordinate posStart = getStartPosition ();
   ParallelGridCoordinate posEnd = posStart + getSize ();
@@ -2353,8 +2403,9 @@ ParallelGrid::getFieldPointValueOrNullByAbsolutePos (const ParallelGridCoordinat
 
   ParallelGridCoordinate relPosition = getRelativePosition (absPosition);
 
-  return getFieldPointValue (relPosition);
-} /* ParallelGrid::getFieldPointValueOrNullByAbsolutePos */
+  return getFieldValue (relPosition, time_step_back);
+} /* ParallelGrid::getFieldValueOrNullByAbsolutePos */
+#endif /* !SPLIT_COMPLEX_FIELD_VALUES */
 
 /**
  * Get first coordinate from which to perform computations at current step
@@ -2599,17 +2650,7 @@ ParallelGrid::initBufferOffsets (grid_coord &left_coord, /**< out: left buffer s
 ParallelGridBase
 ParallelGrid::gatherFullGrid () const
 {
-  ParallelGridBase grid (totalSize, ParallelGridBase::timeStep);
-
-  /*
-   * Fill new grid with values
-   */
-  for (grid_iter iter = 0; iter < grid.getSize ().calculateTotalCoord (); ++iter)
-  {
-    FieldPointValue *val = new FieldPointValue ();
-
-    grid.setFieldPointValue (val, grid.calculatePositionFromIndex (iter));
-  }
+  ParallelGridBase grid (totalSize, ParallelGridBase::timeStep, gridName.c_str (), getCountTimeLayers ());
 
   /*
    * Each computational node broadcasts to all others its data
@@ -2679,15 +2720,7 @@ ParallelGrid::gatherFullGrid () const
      * Fill vectors with data for current computational node
      */
     grid_iter size = sizeCoord.calculateTotalCoord ();
-    std::vector<FieldValue> current (size);
-
-#if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
-    std::vector<FieldValue> previous (size);
-#endif /* ONE_TIME_STEP || TWO_TIME_STEPS */
-
-#if defined (TWO_TIME_STEPS)
-    std::vector<FieldValue> previousPrev (size);
-#endif /* TWO_TIME_STEPS */
+    std::vector<VectorFieldValues> values (getCountTimeLayers (), VectorFieldValues (size));
 
     if (process == ParallelGrid::getParallelCore ()->getProcessId ())
     {
@@ -2722,17 +2755,12 @@ ParallelGrid::gatherFullGrid () const
             ParallelGridCoordinate pos (i, j, k);
 #endif /* GRID_3D */
 
-            grid_iter coord = calculateIndexFromPosition (pos);
-
-            FieldPointValue *val = gridValues[coord];
+            grid_iter coord = calculateOffsetFromPosition (pos);
 
-            current[index] = val->getCurValue ();
-#if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
-            previous[index] = val->getPrevValue ();
-#endif /* ONE_TIME_STEP || TWO_TIME_STEPS */
-#if defined (TWO_TIME_STEPS)
-            previousPrev[index] = val->getPrevPrevValue ();
-#endif /* TWO_TIME_STEPS */
+            for (int t = 0; t < getCountTimeLayers (); ++t)
+            {
+              values[t][index] = *getFieldValueByOffset (coord, t);
+            }
 
             ++index;
 
@@ -2774,18 +2802,24 @@ ParallelGrid::gatherFullGrid () const
 #endif /* LONG_DOUBLE_VALUES */
 
     /*
-     * Broadcast data
+     * Broadcast data. Chunk of node could have more values than fit in count of single MPI call, so it is broadcasted
+     * by parts.
      */
 
-    MPI_Bcast (current.data (), current.size (), datatype, process, MPI_COMM_WORLD);
+    for (int t = 0; t < getCountTimeLayers (); ++t)
+    {
+      for (grid_iter offset = 0; offset < values[t].size (); offset += PARALLEL_GRID_MPI_MAX_COUNT)
+      {
+        grid_iter count = values[t].size () - offset;
 
-#if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
-    MPI_Bcast (previous.data (), previous.size (), datatype, process, MPI_COMM_WORLD);
-#endif /* ONE_TIME_STEP || TWO_TIME_STEPS */
+        if (count > PARALLEL_GRID_MPI_MAX_COUNT)
+        {
+          count = PARALLEL_GRID_MPI_MAX_COUNT;
+        }
 
-#if defined (TWO_TIME_STEPS)
-    MPI_Bcast (previousPrev.data (), previousPrev.size (), datatype, process, MPI_COMM_WORLD);
-#endif /* TWO_TIME_STEPS */
+        MPI_Bcast (values[t].data () + offset, (int) count, datatype, process, MPI_COMM_WORLD);
+      }
+    }
 
     grid_iter index = 0;
 
@@ -2816,15 +2850,10 @@ ParallelGrid::gatherFullGrid () const
           ParallelGridCoordinate pos (i, j, k);
 #endif /* GRID_3D */
 
-          FieldPointValue *val = grid.getFieldPointValue (pos);
-
-          val->setCurValue (current[index]);
-#if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
-          val->setPrevValue (previous[index]);
-#endif /* ONE_TIME_STEP || TWO_TIME_STEPS */
-#if defined (TWO_TIME_STEPS)
-          val->setPrevPrevValue (previousPrev[index]);
-#endif /* TWO_TIME_STEPS */
+          for (int t = 0; t < getCountTimeLayers (); ++t)
+          {
+            grid.setFieldValue (values[t][index], pos, t);
+          }
 
           ++index;
 
@@ -6,11 +6,17 @@
 #ifdef PARALLEL_GRID
 
 #include <mpi.h>
+#include <climits>
 
 /**
- * Type of buffer of values
+ * Maximum number of values, which could be passed to single MPI call (counts of MPI calls are int)
  */
-typedef std::vector<FieldValue> VectorBufferValues;
+#define PARALLEL_GRID_MPI_MAX_COUNT ((grid_iter) INT_MAX)
+
+/**
+ * Type of buffer of values. Storage is taken from grid arena.
+ */
+typedef std::vector<FieldValue, GridAllocator<FieldValue> > VectorBufferValues;
 
 /**
  * Type of vector of buffers
@@ -22,6 +28,20 @@ typedef std::vector<VectorBufferValues> VectorBuffers;
  */
 typedef std::vector<MPI_Request> VectorRequests;
 
+/**
+ * Computation, which does not read receive buffers of parallel grid, so it is performed while share operations are in
+ * progress (see ParallelGrid::shareOverlapped). It consists of independent parts, e.g. rows of interior of grid.
+ */
+class ShareOverlapTask
+{
+public:
+
+  virtual ~ShareOverlapTask () {}
+
+  virtual grid_iter getNumParts () const = 0;
+  virtual void run (grid_iter) = 0;
+}; /* ShareOverlapTask */
+
 /**
  * Parallel grid class
  *
@@ -286,6 +306,16 @@ private:
    */
   VectorBuffers buffersReceive;
 
+  /**
+   * Requests of sends of share operations, which are in progress
+   */
+  VectorRequests requestsSend;
+
+  /**
+   * Requests of receives of share operations, which are in progress
+   */
+  VectorRequests requestsReceive;
+
   /**
    * Step at which to perform share operations for synchronization of computational nodes
    */
@@ -293,11 +323,13 @@ private:
 
 private:
 
-  void SendRawBuffer (BufferPosition, int);
-  void ReceiveRawBuffer (BufferPosition, int);
-  void SendReceiveRawBuffer (BufferPosition, int, BufferPosition, int);
-  void SendReceiveBuffer (BufferPosition);
-  void SendReceive ();
+  void CopyToSendBuffer (BufferPosition);
+  void CopyFromReceiveBuffer (BufferPosition);
+
+  bool isNodeUsed () const;
+
+  static MPI_Datatype getDatatype ();
+  static ParallelGridCoordinate calculateBufferPosition (const ParallelGridCoordinate &, grid_iter);
 
   void ParallelGridConstructor ();
 
@@ -362,13 +394,21 @@ public:
                 time_step,
                 ParallelGridCoordinate,
                 ParallelGridCoordinate,
-                const char * = "unnamed");
+                const char * = "unnamed",
+                int = TIME_LAYERS_COUNT);
 
   virtual void nextTimeStep () CXX11_OVERRIDE;
+  void nextTimeStep (ShareOverlapTask &);
 
+  bool isShareTime () const;
   void nextShareStep ();
   void zeroShareStep ();
   void share ();
+  void shareOverlapped (ShareOverlapTask &);
+
+  void startShare ();
+  bool testShare ();
+  void finishShare ();
 
   virtual ParallelGridCoordinate getComputationEnd (ParallelGridCoordinate) const CXX11_OVERRIDE;
   virtual ParallelGridCoordinate getComputationStart (ParallelGridCoordinate) const CXX11_OVERRIDE;
@@ -378,8 +418,10 @@ public:
   ParallelGridCoordinate getTotalPosition (ParallelGridCoordinate);
   ParallelGridCoordinate getRelativePosition (ParallelGridCoordinate);
 
-  FieldPointValue *getFieldPointValueByAbsolutePos (const ParallelGridCoordinate &);
-  FieldPointValue *getFieldPointValueOrNullByAbsolutePos (const ParallelGridCoordinate &);
+  virtual FieldValuePointer getFieldValueByAbsolutePos (const ParallelGridCoordinate &, int) CXX11_OVERRIDE;
+#ifndef SPLIT_COMPLEX_FIELD_VALUES
+  FieldValue *getFieldValueOrNullByAbsolutePos (const ParallelGridCoordinate &, int);
+#endif /* !SPLIT_COMPLEX_FIELD_VALUES */
 
   /**
    * Getter for total size of grid
@@ -0,0 +1,404 @@
+#include "Assert.h"
+#include "TaskGraph.h"
+
+#ifdef OPENMP_ENABLED
+#include <algorithm>
+#include <deque>
+#include <omp.h>
+
+#ifdef __linux__
+#include <sched.h>
+#endif /* __linux__ */
+
+/**
+ * Weight of the last duration of task in its cost
+ */
+#define TASK_GRAPH_COST_WEIGHT (0.5)
+
+/**
+ * Number of failed attempts to find task, after which idle thread yields its CPU instead of spinning
+ */
+#define TASK_GRAPH_SPIN_ATTEMPTS (6)
+
+/**
+ * Ready tasks of thread
+ */
+struct TaskGraph::Deque
+{
+  std::deque<int> tasks;
+
+  /**
+   * Sum of costs of tasks, which are distributed to deque before run
+   */
+  double load;
+
+  omp_lock_t lock;
+};
+
+/**
+ * Order of tasks by decreasing cost, tasks with equal costs are ordered by their indexes
+ */
+struct TaskCostGreater
+{
+  const std::vector<double> &costs;
+
+  TaskCostGreater (const std::vector<double> &taskCosts)
+    : costs (taskCosts)
+  {
+  }
+
+  bool operator() (int task1, int task2) const
+  {
+    return costs[task1] > costs[task2] || (costs[task1] == costs[task2] && task1 < task2);
+  }
+};
+
+/**
+ * Back off after failed attempt to find task. First attempts are followed by short spins, which grow exponentially,
+ * then CPU is yielded to other threads, so idle threads neither contend for locks of deques nor take CPUs from
+ * threads, which perform tasks, when CPUs are oversubscribed.
+ */
+static void
+backOff (int attempt) /**< number of failed attempts in a row */
+{
+  if (attempt < TASK_GRAPH_SPIN_ATTEMPTS)
+  {
+    for (int i = 0; i < (1 << attempt); ++i)
+    {
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+      __builtin_ia32_pause ();
+#else /* __GNUC__ && (__x86_64__ || __i386__) */
+      #pragma omp flush
+#endif /* !__GNUC__ || (!__x86_64__ && !__i386__) */
+    }
+  }
+  else
+  {
+#ifdef __linux__
+    sched_yield ();
+#endif /* __linux__ */
+  }
+} /* backOff */
+#endif /* OPENMP_ENABLED */
+
+TaskGraph::~TaskGraph ()
+{
+  clear ();
+} /* TaskGraph::~TaskGraph */
+
+/**
+ * Remove all tasks from graph
+ */
+void
+TaskGraph::clear ()
+{
+  for (std::vector<Node>::iterator it = nodes.begin (); it != nodes.end (); ++it)
+  {
+    delete it->task;
+  }
+
+  nodes.clear ();
+} /* TaskGraph::clear */
+
+/**
+ * Add task to graph, graph takes ownership of task
+ *
+ * @return index of task
+ */
+int
+TaskGraph::addTask (TaskGraphTask *task) /**< task */
+{
+  ASSERT (task != NULL);
+
+  Node node;
+  node.task = task;
+  node.numDependencies = 0;
+  node.numRemaining = 0;
+  node.cost = 0;
+
+  nodes.push_back (node);
+
+  return nodes.size () - 1;
+} /* TaskGraph::addTask */
+
+/**
+ * Add dependency between tasks, i.e. the second task is started only after the first one is finished
+ */
+void
+TaskGraph::addDependency (int before, /**< index of task, which is performed first */
+                          int after) /**< index of task, which depends on the first one */
+{
+  ASSERT (before >= 0 && before < getNumTasks ());
+  ASSERT (after >= 0 && after < getNumTasks ());
+  ASSERT (before != after);
+
+  nodes[before].successors.push_back (after);
+  nodes[after].numDependencies++;
+} /* TaskGraph::addDependency */
+
+#ifdef OPENMP_ENABLED
+/**
+ * Distribute tasks without dependencies between deques of threads. Tasks are taken by decreasing cost and each one
+ * is added to deque with the least load, so that sums of costs of deques are close. Tasks, which have not been run yet,
+ * have zero cost and are distributed evenly.
+ */
+void
+TaskGraph::initDeques (std::vector<Deque> &deques) /**< out: deques of threads */
+{
+  std::vector<int> roots;
+  std::vector<double> costs (nodes.size ());
+
+  for (int i = 0; i < getNumTasks (); ++i)
+  {
+    costs[i] = nodes[i].cost;
+
+    if (nodes[i].numDependencies == 0)
+    {
+      roots.push_back (i);
+    }
+  }
+
+  std::sort (roots.begin (), roots.end (), TaskCostGreater (costs));
+
+  for (std::vector<Deque>::iterator it = deques.begin (); it != deques.end (); ++it)
+  {
+    it->load = 0;
+  }
+
+  for (std::vector<int>::const_iterator it = roots.begin (); it != roots.end (); ++it)
+  {
+    std::vector<Deque>::size_type least = 0;
+
+    for (std::vector<Deque>::size_type i = 1; i < deques.size (); ++i)
+    {
+      if (deques[i].load < deques[least].load
+          || (deques[i].load == deques[least].load && deques[i].tasks.size () < deques[least].tasks.size ()))
+      {
+        least = i;
+      }
+    }
+
+    /*
+     * Owner performs the most costly of its tasks first, others steal the least costly ones
+     */
+    deques[least].tasks.push_front (*it);
+    deques[least].load += costs[*it];
+  }
+} /* TaskGraph::initDeques */
+
+/**
+ * Take task from the back of deque of thread
+ *
+ * @return true if deque is not empty
+ */
+bool
+TaskGraph::popTask (std::vector<Deque> &deques, /**< deques of threads */
+                    int thread, /**< number of thread */
+                    int &index) /**< out: index of task */
+{
+  Deque &deque = deques[thread];
+  bool isFound = false;
+
+  omp_set_lock (&deque.lock);
+  if (!deque.tasks.empty ())
+  {
+    index = deque.tasks.back ();
+    deque.tasks.pop_back ();
+    isFound = true;
+  }
+  omp_unset_lock (&deque.lock);
+
+  return isFound;
+} /* TaskGraph::popTask */
+
+/**
+ * Take task from the front of deque of other thread, deques are checked starting with the next thread
+ *
+ * @return true if task is stolen
+ */
+bool
+TaskGraph::stealTask (std::vector<Deque> &deques, /**< deques of threads */
+                      int thread, /**< number of thread, which steals */
+                      int &index) /**< out: index of task */
+{
+  for (std::vector<Deque>::size_type i = 1; i < deques.size (); ++i)
+  {
+    Deque &deque = deques[(thread + i) % deques.size ()];
+    bool isFound = false;
+
+    /*
+     * Deque, which is locked by its owner or by other thief, is skipped
+     */
+    if (!omp_test_lock (&deque.lock))
+    {
+      continue;
+    }
+
+    if (!deque.tasks.empty ())
+    {
+      index = deque.tasks.front ();
+      deque.tasks.pop_front ();
+      isFound = true;
+    }
+    omp_unset_lock (&deque.lock);
+
+    if (isFound)
+    {
+      return true;
+    }
+  }
+
+  return false;
+} /* TaskGraph::stealTask */
+
+/**
+ * Perform task, update its cost and push tasks, all dependencies of which are finished after it, to deque of thread
+ */
+void
+TaskGraph::runNode (std::vector<Deque> &deques, /**< deques of threads */
+                    int thread, /**< number of thread */
+                    int index) /**< index of task */
+{
+  Node &node = nodes[index];
+
+  double startTime = omp_get_wtime ();
+  node.task->run ();
+  double duration = omp_get_wtime () - startTime;
+
+  node.cost = node.cost == 0 ? duration : (1 - TASK_GRAPH_COST_WEIGHT) * node.cost + TASK_GRAPH_COST_WEIGHT * duration;
+
+  /*
+   * Updates of task become visible to threads, which perform its successors
+   */
+  #pragma omp flush
+
+  for (std::vector<int>::const_iterator it = node.successors.begin (); it != node.successors.end (); ++it)
+  {
+    int successor = *it;
+    int remaining;
+
+    #pragma omp atomic capture
+    remaining = --nodes[successor].numRemaining;
+
+    /*
+     * Only the last of finished dependencies pushes task
+     */
+    if (remaining == 0)
+    {
+      omp_set_lock (&deques[thread].lock);
+      deques[thread].tasks.push_back (successor);
+      omp_unset_lock (&deques[thread].lock);
+    }
+  }
+
+  /*
+   * Task is counted as finished only after its successors are pushed, so threads do not leave while they are pushed
+   */
+  #pragma omp atomic
+  numFinished++;
+} /* TaskGraph::runNode */
+#endif /* OPENMP_ENABLED */
+
+/**
+ * Perform all tasks of graph, return when all of them are finished
+ */
+void
+TaskGraph::run ()
+{
+  for (std::vector<Node>::iterator it = nodes.begin (); it != nodes.end (); ++it)
+  {
+    it->numRemaining = it->numDependencies;
+  }
+
+#ifdef OPENMP_ENABLED
+  /*
+   * Team of parallel region may be smaller than maximum number of threads, so all deques are checked by stealing.
+   * Parallel loops inside tasks are nested in this region and thus are performed by thread of task.
+   */
+  std::vector<Deque> deques (omp_get_max_threads ());
+
+  for (std::vector<Deque>::iterator it = deques.begin (); it != deques.end (); ++it)
+  {
+    omp_init_lock (&it->lock);
+  }
+
+  initDeques (deques);
+
+  numFinished = 0;
+
+  #pragma omp parallel
+  {
+    int thread = omp_get_thread_num ();
+    int attempt = 0;
+
+    while (true)
+    {
+      int index;
+
+      if (popTask (deques, thread, index)
+          || stealTask (deques, thread, index))
+      {
+        runNode (deques, thread, index);
+        attempt = 0;
+        continue;
+      }
+
+      int finished;
+
+      #pragma omp atomic read
+      finished = numFinished;
+
+      if (finished == getNumTasks ())
+      {
+        break;
+      }
+
+      /*
+       * Graph is narrow at the moment (e.g. only shifts of time layers are ready), so thread waits for tasks
+       */
+      backOff (attempt);
+
+      if (attempt < TASK_GRAPH_SPIN_ATTEMPTS)
+      {
+        ++attempt;
+      }
+    }
+  }
+
+  for (std::vector<Deque>::iterator it = deques.begin (); it != deques.end (); ++it)
+  {
+    omp_destroy_lock (&it->lock);
+  }
+#else /* OPENMP_ENABLED */
+  std::vector<int> ready;
+  ready.reserve (nodes.size ());
+
+  for (int i = 0; i < getNumTasks (); ++i)
+  {
+    if (nodes[i].numDependencies == 0)
+    {
+      ready.push_back (i);
+    }
+  }
+
+  for (std::vector<int>::size_type next = 0; next < ready.size (); ++next)
+  {
+    Node &node = nodes[ready[next]];
+
+    node.task->run ();
+
+    for (std::vector<int>::const_iterator it = node.successors.begin (); it != node.successors.end (); ++it)
+    {
+      if (--nodes[*it].numRemaining == 0)
+      {
+        ready.push_back (*it);
+      }
+    }
+  }
+
+  /*
+   * Tasks, which are left unfinished, depend on each other
+   */
+  ASSERT (ready.size () == nodes.size ());
+#endif /* !OPENMP_ENABLED */
+} /* TaskGraph::run */
@@ -0,0 +1,105 @@
+#ifndef TASK_GRAPH_H
+#define TASK_GRAPH_H
+
+#include <vector>
+
+/**
+ * Task, which is performed by task graph
+ */
+class TaskGraphTask
+{
+public:
+
+  virtual ~TaskGraphTask () {}
+
+  virtual void run () = 0;
+}; /* TaskGraphTask */
+
+/**
+ * Directed acyclic graph of tasks. Task is started as soon as all tasks it depends on are finished, so independent
+ * tasks are performed concurrently by threads of OpenMP, when build is configured with OPENMP_ENABLED. Otherwise tasks
+ * are performed by single thread in order of their dependencies.
+ *
+ * Each thread has its own deque of ready tasks. Thread performs tasks from the back of its deque and pushes there
+ * tasks, which become ready after them. Thread with empty deque steals tasks from the front of deques of other
+ * threads, it backs off and then yields its CPU, while no task is found. Duration of each task is measured on each
+ * run, so that tasks without dependencies are distributed between deques by their costs on the next run.
+ *
+ * Graph owns its tasks and can be run multiple times.
+ */
+class TaskGraph
+{
+  /**
+   * Task with its dependencies
+   */
+  struct Node
+  {
+    TaskGraphTask *task;
+
+    /**
+     * Indexes of tasks, which depend on this task
+     */
+    std::vector<int> successors;
+
+    /**
+     * Number of tasks, which this task depends on
+     */
+    int numDependencies;
+
+    /**
+     * Number of tasks, which this task depends on and which are not finished yet in current run
+     */
+    int numRemaining;
+
+    /**
+     * Exponential moving average of duration of task in seconds, 0 if task has not been run yet
+     */
+    double cost;
+  };
+
+  std::vector<Node> nodes;
+
+#ifdef OPENMP_ENABLED
+  struct Deque;
+
+  /**
+   * Number of tasks, which are finished in current run
+   */
+  int numFinished;
+#endif /* OPENMP_ENABLED */
+
+private:
+
+  TaskGraph (const TaskGraph &);
+  TaskGraph &operator= (const TaskGraph &);
+
+#ifdef OPENMP_ENABLED
+  void initDeques (std::vector<Deque> &);
+  bool popTask (std::vector<Deque> &, int, int &);
+  bool stealTask (std::vector<Deque> &, int, int &);
+  void runNode (std::vector<Deque> &, int, int);
+#endif /* OPENMP_ENABLED */
+
+public:
+
+  TaskGraph () {}
+  ~TaskGraph ();
+
+  int addTask (TaskGraphTask *);
+  void addDependency (int, int);
+  void clear ();
+
+  void run ();
+
+  double getCost (int index) const
+  {
+    return nodes[index].cost;
+  } /* getCost */
+
+  int getNumTasks () const
+  {
+    return nodes.size ();
+  } /* getNumTasks */
+}; /* TaskGraph */
+
+#endif /* TASK_GRAPH_H */
@@ -0,0 +1,51 @@
+#include "Assert.h"
+#include "Threads.h"
+
+#ifdef OPENMP_ENABLED
+#include <omp.h>
+#endif /* OPENMP_ENABLED */
+
+/**
+ * Set number of threads, which are used by parallel loops (0 means number of CPUs)
+ *
+ * @return true if number of threads is correct
+ */
+bool
+Threads::setup (int numThreads) /**< number of threads */
+{
+  if (numThreads < 0)
+  {
+    return false;
+  }
+
+#ifdef OPENMP_ENABLED
+  if (numThreads > 0)
+  {
+    omp_set_num_threads (numThreads);
+  }
+#else /* OPENMP_ENABLED */
+  if (numThreads > 1)
+  {
+    printf ("Warning: build is configured without OpenMP, single thread is used.\n");
+  }
+#endif /* !OPENMP_ENABLED */
+
+  DPRINTF ("Number of threads: %d.\n", getNumThreads ());
+
+  return true;
+} /* Threads::setup */
+
+/**
+ * Get number of threads, which are used by parallel loops
+ *
+ * @return number of threads
+ */
+int
+Threads::getNumThreads ()
+{
+#ifdef OPENMP_ENABLED
+  return omp_get_max_threads ();
+#else /* OPENMP_ENABLED */
+  return 1;
+#endif /* !OPENMP_ENABLED */
+} /* Threads::getNumThreads */
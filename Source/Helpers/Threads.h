@@ -0,0 +1,19 @@
+#ifndef THREADS_H
+#define THREADS_H
+
+/**
+ * Threads of shared memory parallelism. Loops over grids are parallelized with OpenMP, when build is configured with
+ * OPENMP_ENABLED, otherwise all computations are performed by single thread.
+ *
+ * Each parallel loop updates distinct values of grids and reductions are order-independent (min and max), so results
+ * do not depend on number of threads.
+ */
+class Threads
+{
+public:
+
+  static bool setup (int);
+  static int getNumThreads ();
+}; /* Threads */
+
+#endif /* THREADS_H */
@@ -63,6 +63,17 @@ typedef uint64_t grid_iter;
  */
 typedef uint32_t time_step;
 
+/**
+ * Number of time layers stored for each grid: current, previous and previous for previous
+ */
+#if defined (TWO_TIME_STEPS)
+#define TIME_LAYERS_COUNT 3
+#elif defined (ONE_TIME_STEP)
+#define TIME_LAYERS_COUNT 2
+#else /* TWO_TIME_STEPS || ONE_TIME_STEP */
+#define TIME_LAYERS_COUNT 1
+#endif /* !TWO_TIME_STEPS && !ONE_TIME_STEP */
+
 /**
  * Macro for square
  */
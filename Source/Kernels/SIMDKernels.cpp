@@ -0,0 +1,284 @@
+#include "Kernels.h"
+#include "SIMDKernels.h"
+
+/*
+ * Scalar kernels, which are used if no vector instruction set is available
+ */
+static void
+calculateCurlScalar (FPValue *result, /**< out: new values */
+                     const FPValue *old, /**< old values */
+                     const FPValue *a1, /**< values of the first difference with higher coordinate */
+                     const FPValue *a2, /**< values of the first difference with lower coordinate */
+                     const FPValue *b1, /**< values of the second difference with higher coordinate */
+                     const FPValue *b2, /**< values of the second difference with lower coordinate */
+                     const FPValue *Ca, /**< coefficients of old values */
+                     const FPValue *Cb, /**< coefficients of curl */
+                     grid_iter count) /**< number of field values */
+{
+  for (grid_iter j = 0; j < count * FPVALUES_PER_FIELD_VALUE; ++j)
+  {
+    grid_iter i = j / FPVALUES_PER_FIELD_VALUE;
+    result[j] = calculateEx_3D_Precalc (old[j], a1[j], a2[j], b1[j], b2[j], Ca[i], Cb[i]);
+  }
+} /* calculateCurlScalar */
+
+static void
+calculateCurlLosslessScalar (FPValue *result, /**< out: new values */
+                             const FPValue *old, /**< old values */
+                             const FPValue *a1, /**< values of the first difference with higher coordinate */
+                             const FPValue *a2, /**< values of the first difference with lower coordinate */
+                             const FPValue *b1, /**< values of the second difference with higher coordinate */
+                             const FPValue *b2, /**< values of the second difference with lower coordinate */
+                             const FPValue *Cb, /**< coefficients of curl */
+                             grid_iter count) /**< number of field values */
+{
+  for (grid_iter j = 0; j < count * FPVALUES_PER_FIELD_VALUE; ++j)
+  {
+    grid_iter i = j / FPVALUES_PER_FIELD_VALUE;
+    result[j] = calculateEx_3D_Precalc (old[j], a1[j], a2[j], b1[j], b2[j], 1.0, Cb[i]);
+  }
+} /* calculateCurlLosslessScalar */
+
+static void
+calculateFromDScalar (FPValue *result, /**< out: new values */
+                      const FPValue *old, /**< old values */
+                      const FPValue *d1, /**< current values of D or B */
+                      const FPValue *d2, /**< previous values of D or B */
+                      const FPValue *Ca, /**< coefficients of old values */
+                      const FPValue *Cb, /**< coefficients of current values of D or B */
+                      const FPValue *Cc, /**< coefficients of previous values of D or B */
+                      grid_iter count) /**< number of field values */
+{
+  for (grid_iter j = 0; j < count * FPVALUES_PER_FIELD_VALUE; ++j)
+  {
+    grid_iter i = j / FPVALUES_PER_FIELD_VALUE;
+    result[j] = calculateEx_from_Dx_Precalc (old[j], d1[j], d2[j], Ca[i], Cb[i], Cc[i]);
+  }
+} /* calculateFromDScalar */
+
+static void
+calculateDrudeScalar (FPValue *result, /**< out: new values of D1 or B1 */
+                      const FPValue *nextD, /**< new values of D or B */
+                      const FPValue *curD, /**< current values of D or B */
+                      const FPValue *prevD, /**< previous values of D or B */
+                      const FPValue *curE, /**< current values of D1 or B1 */
+                      const FPValue *prevE, /**< previous values of D1 or B1 */
+                      const FPValue *b0, /**< coefficients of Drude model */
+                      const FPValue *b1,
+                      const FPValue *b2,
+                      const FPValue *a1,
+                      const FPValue *a2,
+                      grid_iter count) /**< number of field values */
+{
+  for (grid_iter j = 0; j < count * FPVALUES_PER_FIELD_VALUE; ++j)
+  {
+    grid_iter i = j / FPVALUES_PER_FIELD_VALUE;
+    result[j] = calculateDrudeE (nextD[j], curD[j], prevD[j], curE[j], prevE[j], b0[i], b1[i], b2[i], a1[i], a2[i]);
+  }
+} /* calculateDrudeScalar */
+
+static const SIMDKernelTable scalarKernelTable =
+{
+  calculateCurlScalar,
+  calculateCurlLosslessScalar,
+  calculateFromDScalar,
+  calculateDrudeScalar
+};
+
+SIMDInstructionSet SIMDKernels::instructionSet = SIMDInstructionSet::NONE;
+const SIMDKernelTable *SIMDKernels::kernels = &scalarKernelTable;
+
+/**
+ * Get kernels of instruction set, which are compiled in this build
+ *
+ * @return kernels or NULLPTR if they are not available
+ */
+const SIMDKernelTable *
+SIMDKernels::getKernelTable (SIMDInstructionSet set) /**< instruction set */
+{
+  switch (set)
+  {
+    case SIMDInstructionSet::NONE:
+    {
+      return &scalarKernelTable;
+    }
+    case SIMDInstructionSet::SSE42:
+    {
+      return getSIMDKernelTableSSE42 ();
+    }
+    case SIMDInstructionSet::AVX2:
+    {
+      return getSIMDKernelTableAVX2 ();
+    }
+    case SIMDInstructionSet::AVX512:
+    {
+      return getSIMDKernelTableAVX512 ();
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
+
+  return NULLPTR;
+} /* SIMDKernels::getKernelTable */
+
+/**
+ * Check whether kernels of instruction set are compiled in this build and are supported by CPU
+ *
+ * @return true if kernels can be used
+ */
+bool
+SIMDKernels::isSupported (SIMDInstructionSet set) /**< instruction set */
+{
+  if (getKernelTable (set) == NULLPTR)
+  {
+    return false;
+  }
+
+#if defined (__GNUC__) && defined (__x86_64__)
+  __builtin_cpu_init ();
+
+  switch (set)
+  {
+    case SIMDInstructionSet::NONE:
+    {
+      return true;
+    }
+    case SIMDInstructionSet::SSE42:
+    {
+      return __builtin_cpu_supports ("sse4.2");
+    }
+    case SIMDInstructionSet::AVX2:
+    {
+      return __builtin_cpu_supports ("avx2");
+    }
+    case SIMDInstructionSet::AVX512:
+    {
+      return __builtin_cpu_supports ("avx512f");
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
+
+  return false;
+#else /* __GNUC__ && __x86_64__ */
+  return set == SIMDInstructionSet::NONE;
+#endif /* !__GNUC__ || !__x86_64__ */
+} /* SIMDKernels::isSupported */
+
+/**
+ * Get the widest instruction set, which can be used
+ *
+ * @return instruction set
+ */
+SIMDInstructionSet
+SIMDKernels::getBestInstructionSet ()
+{
+  if (isSupported (SIMDInstructionSet::AVX512))
+  {
+    return SIMDInstructionSet::AVX512;
+  }
+  if (isSupported (SIMDInstructionSet::AVX2))
+  {
+    return SIMDInstructionSet::AVX2;
+  }
+  if (isSupported (SIMDInstructionSet::SSE42))
+  {
+    return SIMDInstructionSet::SSE42;
+  }
+
+  return SIMDInstructionSet::NONE;
+} /* SIMDKernels::getBestInstructionSet */
+
+/**
+ * Parse name of instruction set ("auto" means the widest supported one)
+ *
+ * @return true if name is correct
+ */
+bool
+SIMDKernels::parseInstructionSet (const std::string &name, /**< name of instruction set */
+                                  SIMDInstructionSet &set) /**< out: instruction set */
+{
+  if (name == "auto")
+  {
+    set = getBestInstructionSet ();
+  }
+  else if (name == "none")
+  {
+    set = SIMDInstructionSet::NONE;
+  }
+  else if (name == "sse4.2")
+  {
+    set = SIMDInstructionSet::SSE42;
+  }
+  else if (name == "avx2")
+  {
+    set = SIMDInstructionSet::AVX2;
+  }
+  else if (name == "avx512")
+  {
+    set = SIMDInstructionSet::AVX512;
+  }
+  else
+  {
+    return false;
+  }
+
+  return true;
+} /* SIMDKernels::parseInstructionSet */
+
+/**
+ * Get name of instruction set
+ *
+ * @return name
+ */
+const char *
+SIMDKernels::getInstructionSetName (SIMDInstructionSet set) /**< instruction set */
+{
+  switch (set)
+  {
+    case SIMDInstructionSet::NONE:
+    {
+      return "none";
+    }
+    case SIMDInstructionSet::SSE42:
+    {
+      return "sse4.2";
+    }
+    case SIMDInstructionSet::AVX2:
+    {
+      return "avx2";
+    }
+    case SIMDInstructionSet::AVX512:
+    {
+      return "avx512";
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
+
+  return NULLPTR;
+} /* SIMDKernels::getInstructionSetName */
+
+/**
+ * Select instruction set of kernels. Scalar kernels are used if instruction set is not supported
+ */
+void
+SIMDKernels::setup (SIMDInstructionSet set) /**< instruction set */
+{
+  if (!isSupported (set))
+  {
+    printf ("Warning: instruction set %s is not supported, scalar kernels are used.\n", getInstructionSetName (set));
+    set = SIMDInstructionSet::NONE;
+  }
+
+  instructionSet = set;
+  kernels = getKernelTable (set);
+
+  DPRINTF ("Instruction set of kernels: %s.\n", getInstructionSetName (set));
+} /* SIMDKernels::setup */
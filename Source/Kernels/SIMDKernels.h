@@ -0,0 +1,116 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <string>
+
+#include "Assert.h"
+#include "FieldValue.h"
+
+/**
+ * Number of floating point values in each field value in arrays of values of kernels below (2 for interleaved complex
+ * field values). Kernels process real and imaginary parts of interleaved complex values as two streams of floating
+ * point values, which share coefficients. When SPLIT_COMPLEX_FIELD_VALUES is defined, real and imaginary parts are
+ * stored in separate planes and kernels are called for each plane as for real values.
+ */
+#ifdef SPLIT_COMPLEX_FIELD_VALUES
+#define FPVALUES_PER_FIELD_VALUE (1)
+#else /* SPLIT_COMPLEX_FIELD_VALUES */
+#define FPVALUES_PER_FIELD_VALUE (sizeof (FieldValue) / sizeof (FPValue))
+#endif /* !SPLIT_COMPLEX_FIELD_VALUES */
+
+/**
+ * Instruction sets, for which kernels are implemented
+ */
+ENUM_CLASS (SIMDInstructionSet, uint8_t,
+  NONE, /**< scalar kernels */
+  SSE42,
+  AVX2,
+  AVX512
+);
+
+/**
+ * Kernels of Yee updates over contiguous rows of count field values. Arrays of values contain
+ * count * FPVALUES_PER_FIELD_VALUE floating point values (real and imaginary parts are interleaved for complex
+ * values, unless they are split), arrays of coefficients contain single real coefficient for each field value. Each
+ * kernel calculates exactly the same expression as corresponding macro of Kernels.h, so results of all instruction
+ * sets are equal bit-for-bit.
+ */
+struct SIMDKernelTable
+{
+  /**
+   * Update of field from curl (see calculateEx_3D_Precalc):
+   *   result = Ca * old + Cb * (a1 - a2 - b1 + b2)
+   */
+  void (*calculateCurl) (FPValue *result, const FPValue *old, const FPValue *a1, const FPValue *a2,
+                         const FPValue *b1, const FPValue *b2, const FPValue *Ca, const FPValue *Cb, grid_iter count);
+
+  /**
+   * Update of field from curl without losses, i.e. with Ca equal to 1 (see calculateEx_3D):
+   *   result = old + Cb * (a1 - a2 - b1 + b2)
+   */
+  void (*calculateCurlLossless) (FPValue *result, const FPValue *old, const FPValue *a1, const FPValue *a2,
+                                 const FPValue *b1, const FPValue *b2, const FPValue *Cb, grid_iter count);
+
+  /**
+   * Update of field from D or B (see calculateEx_from_Dx_Precalc):
+   *   result = Ca * old + Cb * d1 - Cc * d2
+   */
+  void (*calculateFromD) (FPValue *result, const FPValue *old, const FPValue *d1, const FPValue *d2,
+                          const FPValue *Ca, const FPValue *Cb, const FPValue *Cc, grid_iter count);
+
+  /**
+   * Update of D1 or B1 of Drude model (see calculateDrudeE):
+   *   result = b0 * nextD + b1 * curD + b2 * prevD - a1 * curE - a2 * prevE
+   */
+  void (*calculateDrude) (FPValue *result, const FPValue *nextD, const FPValue *curD, const FPValue *prevD,
+                          const FPValue *curE, const FPValue *prevE, const FPValue *b0, const FPValue *b1,
+                          const FPValue *b2, const FPValue *a1, const FPValue *a2, grid_iter count);
+};
+
+/**
+ * Kernels for each instruction set, which are compiled in separate translation units with corresponding compiler
+ * flags. NULLPTR is returned if kernels for instruction set are not available in this build.
+ */
+const SIMDKernelTable *getSIMDKernelTableSSE42 ();
+const SIMDKernelTable *getSIMDKernelTableAVX2 ();
+const SIMDKernelTable *getSIMDKernelTableAVX512 ();
+
+/**
+ * Runtime dispatch of row kernels. By default the widest instruction set, which is supported by both build and CPU,
+ * is used.
+ */
+class SIMDKernels
+{
+  /**
+   * Selected instruction set
+   */
+  static SIMDInstructionSet instructionSet;
+
+  /**
+   * Kernels of selected instruction set
+   */
+  static const SIMDKernelTable *kernels;
+
+public:
+
+  static const SIMDKernelTable *getKernelTable (SIMDInstructionSet);
+  static bool isSupported (SIMDInstructionSet);
+  static SIMDInstructionSet getBestInstructionSet ();
+
+  static bool parseInstructionSet (const std::string &, SIMDInstructionSet &);
+  static const char *getInstructionSetName (SIMDInstructionSet);
+
+  static void setup (SIMDInstructionSet);
+
+  static SIMDInstructionSet getInstructionSet ()
+  {
+    return instructionSet;
+  } /* getInstructionSet */
+
+  static const SIMDKernelTable &get ()
+  {
+    return *kernels;
+  } /* get */
+}; /* SIMDKernels */
+
+#endif /* SIMD_KERNELS_H */
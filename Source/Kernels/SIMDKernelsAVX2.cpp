@@ -0,0 +1,50 @@
+/*
+ * Row kernels with AVX2 instructions. This file is compiled with flags of instruction set only for x86-64, and
+ * kernels are called only if instruction set is supported by CPU (see SIMDKernels::isSupported).
+ */
+
+#include "SIMDKernels.h"
+
+#if defined (__AVX2__) && !defined (LONG_DOUBLE_VALUES)
+
+#include <immintrin.h>
+
+#ifdef FLOAT_VALUES
+#define SIMD_VECTOR __m256
+#define SIMD_WIDTH 8
+#define SIMD_LOAD(ptr) _mm256_loadu_ps (ptr)
+#define SIMD_STORE(ptr, vec) _mm256_storeu_ps ((ptr), (vec))
+#define SIMD_ADD(a, b) _mm256_add_ps ((a), (b))
+#define SIMD_SUB(a, b) _mm256_sub_ps ((a), (b))
+#define SIMD_MUL(a, b) _mm256_mul_ps ((a), (b))
+#define SIMD_DUPLICATE_LOW(vec) _mm256_permutevar8x32_ps ((vec), _mm256_setr_epi32 (0, 0, 1, 1, 2, 2, 3, 3))
+#define SIMD_DUPLICATE_HIGH(vec) _mm256_permutevar8x32_ps ((vec), _mm256_setr_epi32 (4, 4, 5, 5, 6, 6, 7, 7))
+#else /* FLOAT_VALUES */
+#define SIMD_VECTOR __m256d
+#define SIMD_WIDTH 4
+#define SIMD_LOAD(ptr) _mm256_loadu_pd (ptr)
+#define SIMD_STORE(ptr, vec) _mm256_storeu_pd ((ptr), (vec))
+#define SIMD_ADD(a, b) _mm256_add_pd ((a), (b))
+#define SIMD_SUB(a, b) _mm256_sub_pd ((a), (b))
+#define SIMD_MUL(a, b) _mm256_mul_pd ((a), (b))
+#define SIMD_DUPLICATE_LOW(vec) _mm256_permute4x64_pd ((vec), 0x50)
+#define SIMD_DUPLICATE_HIGH(vec) _mm256_permute4x64_pd ((vec), 0xFA)
+#endif /* !FLOAT_VALUES */
+
+#include "SIMDKernelsImpl.h"
+
+const SIMDKernelTable *
+getSIMDKernelTableAVX2 ()
+{
+  return &simdKernelTable;
+} /* getSIMDKernelTableAVX2 */
+
+#else /* __AVX2__ && !LONG_DOUBLE_VALUES */
+
+const SIMDKernelTable *
+getSIMDKernelTableAVX2 ()
+{
+  return NULLPTR;
+} /* getSIMDKernelTableAVX2 */
+
+#endif /* !__AVX2__ || LONG_DOUBLE_VALUES */
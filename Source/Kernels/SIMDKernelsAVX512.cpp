@@ -0,0 +1,52 @@
+/*
+ * Row kernels with AVX-512 instructions. This file is compiled with flags of instruction set only for x86-64, and
+ * kernels are called only if instruction set is supported by CPU (see SIMDKernels::isSupported).
+ */
+
+#include "SIMDKernels.h"
+
+#if defined (__AVX512F__) && !defined (LONG_DOUBLE_VALUES)
+
+#include <immintrin.h>
+
+#ifdef FLOAT_VALUES
+#define SIMD_VECTOR __m512
+#define SIMD_WIDTH 16
+#define SIMD_LOAD(ptr) _mm512_loadu_ps (ptr)
+#define SIMD_STORE(ptr, vec) _mm512_storeu_ps ((ptr), (vec))
+#define SIMD_ADD(a, b) _mm512_add_ps ((a), (b))
+#define SIMD_SUB(a, b) _mm512_sub_ps ((a), (b))
+#define SIMD_MUL(a, b) _mm512_mul_ps ((a), (b))
+#define SIMD_DUPLICATE_LOW(vec) \
+  _mm512_permutexvar_ps (_mm512_set_epi32 (7, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 0), (vec))
+#define SIMD_DUPLICATE_HIGH(vec) \
+  _mm512_permutexvar_ps (_mm512_set_epi32 (15, 15, 14, 14, 13, 13, 12, 12, 11, 11, 10, 10, 9, 9, 8, 8), (vec))
+#else /* FLOAT_VALUES */
+#define SIMD_VECTOR __m512d
+#define SIMD_WIDTH 8
+#define SIMD_LOAD(ptr) _mm512_loadu_pd (ptr)
+#define SIMD_STORE(ptr, vec) _mm512_storeu_pd ((ptr), (vec))
+#define SIMD_ADD(a, b) _mm512_add_pd ((a), (b))
+#define SIMD_SUB(a, b) _mm512_sub_pd ((a), (b))
+#define SIMD_MUL(a, b) _mm512_mul_pd ((a), (b))
+#define SIMD_DUPLICATE_LOW(vec) _mm512_permutexvar_pd (_mm512_set_epi64 (3, 3, 2, 2, 1, 1, 0, 0), (vec))
+#define SIMD_DUPLICATE_HIGH(vec) _mm512_permutexvar_pd (_mm512_set_epi64 (7, 7, 6, 6, 5, 5, 4, 4), (vec))
+#endif /* !FLOAT_VALUES */
+
+#include "SIMDKernelsImpl.h"
+
+const SIMDKernelTable *
+getSIMDKernelTableAVX512 ()
+{
+  return &simdKernelTable;
+} /* getSIMDKernelTableAVX512 */
+
+#else /* __AVX512F__ && !LONG_DOUBLE_VALUES */
+
+const SIMDKernelTable *
+getSIMDKernelTableAVX512 ()
+{
+  return NULLPTR;
+} /* getSIMDKernelTableAVX512 */
+
+#endif /* !__AVX512F__ || LONG_DOUBLE_VALUES */
@@ -0,0 +1,276 @@
+#ifndef SIMD_KERNELS_IMPL_H
+#define SIMD_KERNELS_IMPL_H
+
+/*
+ * Implementation of row kernels with vector instructions, which is included in translation unit of each instruction
+ * set. Following macros should be defined before inclusion:
+ *
+ *  - SIMD_VECTOR: type of vector of floating point values
+ *  - SIMD_WIDTH: number of floating point values in vector
+ *  - SIMD_LOAD (ptr), SIMD_STORE (ptr, vec): unaligned load and store of vector
+ *  - SIMD_ADD (a, b), SIMD_SUB (a, b), SIMD_MUL (a, b): arithmetic operations on vectors
+ *  - SIMD_DUPLICATE_LOW (vec), SIMD_DUPLICATE_HIGH (vec): vectors, in which each value of the lower (higher) half of
+ *    vector is repeated twice, i.e. {v0, v0, v1, v1, ...} ({vN, vN, vN+1, vN+1, ...} for N = SIMD_WIDTH / 2)
+ *
+ * Operations are performed in the same order as in macros of Kernels.h, values at the end of rows, which do not fill
+ * the whole vector, are calculated with these macros. Translation units should be compiled without contraction of
+ * multiplications and additions to FMA, so that results are equal to scalar kernels bit-for-bit.
+ *
+ * For interleaved complex field values vector of coefficients is loaded once for SIMD_WIDTH field values and is
+ * expanded in registers to two vectors, which match interleaved real and imaginary parts of these values. Split complex
+ * field values (see SPLIT_COMPLEX_FIELD_VALUES) are processed as real values, without expansion.
+ */
+
+#include "Kernels.h"
+#include "SIMDKernels.h"
+
+/**
+ * Calculate single vector of curl update
+ */
+static inline void
+calculateCurlVector (FPValue *result, /**< out: new values */
+                     const FPValue *old, /**< old values */
+                     const FPValue *a1, /**< values of the first difference with higher coordinate */
+                     const FPValue *a2, /**< values of the first difference with lower coordinate */
+                     const FPValue *b1, /**< values of the second difference with higher coordinate */
+                     const FPValue *b2, /**< values of the second difference with lower coordinate */
+                     SIMD_VECTOR Ca, /**< coefficients of old values */
+                     SIMD_VECTOR Cb) /**< coefficients of curl */
+{
+  SIMD_VECTOR curl = SIMD_ADD (SIMD_SUB (SIMD_SUB (SIMD_LOAD (a1), SIMD_LOAD (a2)), SIMD_LOAD (b1)), SIMD_LOAD (b2));
+
+  SIMD_STORE (result, SIMD_ADD (SIMD_MUL (Ca, SIMD_LOAD (old)), SIMD_MUL (Cb, curl)));
+} /* calculateCurlVector */
+
+static void
+calculateCurl (FPValue *result, /**< out: new values */
+               const FPValue *old, /**< old values */
+               const FPValue *a1, /**< values of the first difference with higher coordinate */
+               const FPValue *a2, /**< values of the first difference with lower coordinate */
+               const FPValue *b1, /**< values of the second difference with higher coordinate */
+               const FPValue *b2, /**< values of the second difference with lower coordinate */
+               const FPValue *Ca, /**< coefficients of old values */
+               const FPValue *Cb, /**< coefficients of curl */
+               grid_iter count) /**< number of field values */
+{
+  grid_iter i = 0;
+
+  for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+  {
+    grid_iter j = i * FPVALUES_PER_FIELD_VALUE;
+
+    SIMD_VECTOR CaVec = SIMD_LOAD (Ca + i);
+    SIMD_VECTOR CbVec = SIMD_LOAD (Cb + i);
+
+#if defined (COMPLEX_FIELD_VALUES) && !defined (SPLIT_COMPLEX_FIELD_VALUES)
+    calculateCurlVector (result + j, old + j, a1 + j, a2 + j, b1 + j, b2 + j,
+                         SIMD_DUPLICATE_LOW (CaVec), SIMD_DUPLICATE_LOW (CbVec));
+
+    j += SIMD_WIDTH;
+
+    calculateCurlVector (result + j, old + j, a1 + j, a2 + j, b1 + j, b2 + j,
+                         SIMD_DUPLICATE_HIGH (CaVec), SIMD_DUPLICATE_HIGH (CbVec));
+#else /* COMPLEX_FIELD_VALUES && !SPLIT_COMPLEX_FIELD_VALUES */
+    calculateCurlVector (result + j, old + j, a1 + j, a2 + j, b1 + j, b2 + j, CaVec, CbVec);
+#endif /* !COMPLEX_FIELD_VALUES || SPLIT_COMPLEX_FIELD_VALUES */
+  }
+
+  for (grid_iter j = i * FPVALUES_PER_FIELD_VALUE; j < count * FPVALUES_PER_FIELD_VALUE; ++j)
+  {
+    i = j / FPVALUES_PER_FIELD_VALUE;
+    result[j] = calculateEx_3D_Precalc (old[j], a1[j], a2[j], b1[j], b2[j], Ca[i], Cb[i]);
+  }
+} /* calculateCurl */
+
+/**
+ * Calculate single vector of curl update without losses
+ */
+static inline void
+calculateCurlLosslessVector (FPValue *result, /**< out: new values */
+                             const FPValue *old, /**< old values */
+                             const FPValue *a1, /**< values of the first difference with higher coordinate */
+                             const FPValue *a2, /**< values of the first difference with lower coordinate */
+                             const FPValue *b1, /**< values of the second difference with higher coordinate */
+                             const FPValue *b2, /**< values of the second difference with lower coordinate */
+                             SIMD_VECTOR Cb) /**< coefficients of curl */
+{
+  SIMD_VECTOR curl = SIMD_ADD (SIMD_SUB (SIMD_SUB (SIMD_LOAD (a1), SIMD_LOAD (a2)), SIMD_LOAD (b1)), SIMD_LOAD (b2));
+
+  SIMD_STORE (result, SIMD_ADD (SIMD_LOAD (old), SIMD_MUL (Cb, curl)));
+} /* calculateCurlLosslessVector */
+
+static void
+calculateCurlLossless (FPValue *result, /**< out: new values */
+                       const FPValue *old, /**< old values */
+                       const FPValue *a1, /**< values of the first difference with higher coordinate */
+                       const FPValue *a2, /**< values of the first difference with lower coordinate */
+                       const FPValue *b1, /**< values of the second difference with higher coordinate */
+                       const FPValue *b2, /**< values of the second difference with lower coordinate */
+                       const FPValue *Cb, /**< coefficients of curl */
+                       grid_iter count) /**< number of field values */
+{
+  grid_iter i = 0;
+
+  for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+  {
+    grid_iter j = i * FPVALUES_PER_FIELD_VALUE;
+
+    SIMD_VECTOR CbVec = SIMD_LOAD (Cb + i);
+
+#if defined (COMPLEX_FIELD_VALUES) && !defined (SPLIT_COMPLEX_FIELD_VALUES)
+    calculateCurlLosslessVector (result + j, old + j, a1 + j, a2 + j, b1 + j, b2 + j, SIMD_DUPLICATE_LOW (CbVec));
+
+    j += SIMD_WIDTH;
+
+    calculateCurlLosslessVector (result + j, old + j, a1 + j, a2 + j, b1 + j, b2 + j, SIMD_DUPLICATE_HIGH (CbVec));
+#else /* COMPLEX_FIELD_VALUES && !SPLIT_COMPLEX_FIELD_VALUES */
+    calculateCurlLosslessVector (result + j, old + j, a1 + j, a2 + j, b1 + j, b2 + j, CbVec);
+#endif /* !COMPLEX_FIELD_VALUES || SPLIT_COMPLEX_FIELD_VALUES */
+  }
+
+  for (grid_iter j = i * FPVALUES_PER_FIELD_VALUE; j < count * FPVALUES_PER_FIELD_VALUE; ++j)
+  {
+    i = j / FPVALUES_PER_FIELD_VALUE;
+    result[j] = calculateEx_3D_Precalc (old[j], a1[j], a2[j], b1[j], b2[j], 1.0, Cb[i]);
+  }
+} /* calculateCurlLossless */
+
+/**
+ * Calculate single vector of update from D or B
+ */
+static inline void
+calculateFromDVector (FPValue *result, /**< out: new values */
+                      const FPValue *old, /**< old values */
+                      const FPValue *d1, /**< current values of D or B */
+                      const FPValue *d2, /**< previous values of D or B */
+                      SIMD_VECTOR Ca, /**< coefficients of old values */
+                      SIMD_VECTOR Cb, /**< coefficients of current values of D or B */
+                      SIMD_VECTOR Cc) /**< coefficients of previous values of D or B */
+{
+  SIMD_VECTOR val = SIMD_ADD (SIMD_MUL (Ca, SIMD_LOAD (old)), SIMD_MUL (Cb, SIMD_LOAD (d1)));
+
+  SIMD_STORE (result, SIMD_SUB (val, SIMD_MUL (Cc, SIMD_LOAD (d2))));
+} /* calculateFromDVector */
+
+static void
+calculateFromD (FPValue *result, /**< out: new values */
+                const FPValue *old, /**< old values */
+                const FPValue *d1, /**< current values of D or B */
+                const FPValue *d2, /**< previous values of D or B */
+                const FPValue *Ca, /**< coefficients of old values */
+                const FPValue *Cb, /**< coefficients of current values of D or B */
+                const FPValue *Cc, /**< coefficients of previous values of D or B */
+                grid_iter count) /**< number of field values */
+{
+  grid_iter i = 0;
+
+  for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+  {
+    grid_iter j = i * FPVALUES_PER_FIELD_VALUE;
+
+    SIMD_VECTOR CaVec = SIMD_LOAD (Ca + i);
+    SIMD_VECTOR CbVec = SIMD_LOAD (Cb + i);
+    SIMD_VECTOR CcVec = SIMD_LOAD (Cc + i);
+
+#if defined (COMPLEX_FIELD_VALUES) && !defined (SPLIT_COMPLEX_FIELD_VALUES)
+    calculateFromDVector (result + j, old + j, d1 + j, d2 + j,
+                          SIMD_DUPLICATE_LOW (CaVec), SIMD_DUPLICATE_LOW (CbVec), SIMD_DUPLICATE_LOW (CcVec));
+
+    j += SIMD_WIDTH;
+
+    calculateFromDVector (result + j, old + j, d1 + j, d2 + j,
+                          SIMD_DUPLICATE_HIGH (CaVec), SIMD_DUPLICATE_HIGH (CbVec), SIMD_DUPLICATE_HIGH (CcVec));
+#else /* COMPLEX_FIELD_VALUES && !SPLIT_COMPLEX_FIELD_VALUES */
+    calculateFromDVector (result + j, old + j, d1 + j, d2 + j, CaVec, CbVec, CcVec);
+#endif /* !COMPLEX_FIELD_VALUES || SPLIT_COMPLEX_FIELD_VALUES */
+  }
+
+  for (grid_iter j = i * FPVALUES_PER_FIELD_VALUE; j < count * FPVALUES_PER_FIELD_VALUE; ++j)
+  {
+    i = j / FPVALUES_PER_FIELD_VALUE;
+    result[j] = calculateEx_from_Dx_Precalc (old[j], d1[j], d2[j], Ca[i], Cb[i], Cc[i]);
+  }
+} /* calculateFromD */
+
+/**
+ * Calculate single vector of update of Drude model
+ */
+static inline void
+calculateDrudeVector (FPValue *result, /**< out: new values of D1 or B1 */
+                      const FPValue *nextD, /**< new values of D or B */
+                      const FPValue *curD, /**< current values of D or B */
+                      const FPValue *prevD, /**< previous values of D or B */
+                      const FPValue *curE, /**< current values of D1 or B1 */
+                      const FPValue *prevE, /**< previous values of D1 or B1 */
+                      SIMD_VECTOR b0, /**< coefficients of Drude model */
+                      SIMD_VECTOR b1,
+                      SIMD_VECTOR b2,
+                      SIMD_VECTOR a1,
+                      SIMD_VECTOR a2)
+{
+  SIMD_VECTOR val = SIMD_ADD (SIMD_MUL (b0, SIMD_LOAD (nextD)), SIMD_MUL (b1, SIMD_LOAD (curD)));
+  val = SIMD_ADD (val, SIMD_MUL (b2, SIMD_LOAD (prevD)));
+  val = SIMD_SUB (val, SIMD_MUL (a1, SIMD_LOAD (curE)));
+  val = SIMD_SUB (val, SIMD_MUL (a2, SIMD_LOAD (prevE)));
+
+  SIMD_STORE (result, val);
+} /* calculateDrudeVector */
+
+static void
+calculateDrude (FPValue *result, /**< out: new values of D1 or B1 */
+                const FPValue *nextD, /**< new values of D or B */
+                const FPValue *curD, /**< current values of D or B */
+                const FPValue *prevD, /**< previous values of D or B */
+                const FPValue *curE, /**< current values of D1 or B1 */
+                const FPValue *prevE, /**< previous values of D1 or B1 */
+                const FPValue *b0, /**< coefficients of Drude model */
+                const FPValue *b1,
+                const FPValue *b2,
+                const FPValue *a1,
+                const FPValue *a2,
+                grid_iter count) /**< number of field values */
+{
+  grid_iter i = 0;
+
+  for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+  {
+    grid_iter j = i * FPVALUES_PER_FIELD_VALUE;
+
+    SIMD_VECTOR b0Vec = SIMD_LOAD (b0 + i);
+    SIMD_VECTOR b1Vec = SIMD_LOAD (b1 + i);
+    SIMD_VECTOR b2Vec = SIMD_LOAD (b2 + i);
+    SIMD_VECTOR a1Vec = SIMD_LOAD (a1 + i);
+    SIMD_VECTOR a2Vec = SIMD_LOAD (a2 + i);
+
+#if defined (COMPLEX_FIELD_VALUES) && !defined (SPLIT_COMPLEX_FIELD_VALUES)
+    calculateDrudeVector (result + j, nextD + j, curD + j, prevD + j, curE + j, prevE + j,
+                          SIMD_DUPLICATE_LOW (b0Vec), SIMD_DUPLICATE_LOW (b1Vec), SIMD_DUPLICATE_LOW (b2Vec),
+                          SIMD_DUPLICATE_LOW (a1Vec), SIMD_DUPLICATE_LOW (a2Vec));
+
+    j += SIMD_WIDTH;
+
+    calculateDrudeVector (result + j, nextD + j, curD + j, prevD + j, curE + j, prevE + j,
+                          SIMD_DUPLICATE_HIGH (b0Vec), SIMD_DUPLICATE_HIGH (b1Vec), SIMD_DUPLICATE_HIGH (b2Vec),
+                          SIMD_DUPLICATE_HIGH (a1Vec), SIMD_DUPLICATE_HIGH (a2Vec));
+#else /* COMPLEX_FIELD_VALUES && !SPLIT_COMPLEX_FIELD_VALUES */
+    calculateDrudeVector (result + j, nextD + j, curD + j, prevD + j, curE + j, prevE + j,
+                          b0Vec, b1Vec, b2Vec, a1Vec, a2Vec);
+#endif /* !COMPLEX_FIELD_VALUES || SPLIT_COMPLEX_FIELD_VALUES */
+  }
+
+  for (grid_iter j = i * FPVALUES_PER_FIELD_VALUE; j < count * FPVALUES_PER_FIELD_VALUE; ++j)
+  {
+    i = j / FPVALUES_PER_FIELD_VALUE;
+    result[j] = calculateDrudeE (nextD[j], curD[j], prevD[j], curE[j], prevE[j], b0[i], b1[i], b2[i], a1[i], a2[i]);
+  }
+} /* calculateDrude */
+
+static const SIMDKernelTable simdKernelTable =
+{
+  calculateCurl,
+  calculateCurlLossless,
+  calculateFromD,
+  calculateDrude
+};
+
+#endif /* SIMD_KERNELS_IMPL_H */
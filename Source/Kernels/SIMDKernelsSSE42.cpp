@@ -0,0 +1,50 @@
+/*
+ * Row kernels with SSE4.2 instructions. This file is compiled with flags of instruction set only for x86-64, and
+ * kernels are called only if instruction set is supported by CPU (see SIMDKernels::isSupported).
+ */
+
+#include "SIMDKernels.h"
+
+#if defined (__SSE4_2__) && !defined (LONG_DOUBLE_VALUES)
+
+#include <nmmintrin.h>
+
+#ifdef FLOAT_VALUES
+#define SIMD_VECTOR __m128
+#define SIMD_WIDTH 4
+#define SIMD_LOAD(ptr) _mm_loadu_ps (ptr)
+#define SIMD_STORE(ptr, vec) _mm_storeu_ps ((ptr), (vec))
+#define SIMD_ADD(a, b) _mm_add_ps ((a), (b))
+#define SIMD_SUB(a, b) _mm_sub_ps ((a), (b))
+#define SIMD_MUL(a, b) _mm_mul_ps ((a), (b))
+#define SIMD_DUPLICATE_LOW(vec) _mm_unpacklo_ps ((vec), (vec))
+#define SIMD_DUPLICATE_HIGH(vec) _mm_unpackhi_ps ((vec), (vec))
+#else /* FLOAT_VALUES */
+#define SIMD_VECTOR __m128d
+#define SIMD_WIDTH 2
+#define SIMD_LOAD(ptr) _mm_loadu_pd (ptr)
+#define SIMD_STORE(ptr, vec) _mm_storeu_pd ((ptr), (vec))
+#define SIMD_ADD(a, b) _mm_add_pd ((a), (b))
+#define SIMD_SUB(a, b) _mm_sub_pd ((a), (b))
+#define SIMD_MUL(a, b) _mm_mul_pd ((a), (b))
+#define SIMD_DUPLICATE_LOW(vec) _mm_unpacklo_pd ((vec), (vec))
+#define SIMD_DUPLICATE_HIGH(vec) _mm_unpackhi_pd ((vec), (vec))
+#endif /* !FLOAT_VALUES */
+
+#include "SIMDKernelsImpl.h"
+
+const SIMDKernelTable *
+getSIMDKernelTableSSE42 ()
+{
+  return &simdKernelTable;
+} /* getSIMDKernelTableSSE42 */
+
+#else /* __SSE4_2__ && !LONG_DOUBLE_VALUES */
+
+const SIMDKernelTable *
+getSIMDKernelTableSSE42 ()
+{
+  return NULLPTR;
+} /* getSIMDKernelTableSSE42 */
+
+#endif /* !__SSE4_2__ || LONG_DOUBLE_VALUES */
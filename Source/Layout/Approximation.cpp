@@ -217,15 +217,21 @@ Approximation::approximateDrudeModel (FPValue &omega,
 }
 
 FPValue
-Approximation::getMaterial (const FieldPointValue *val)
+Approximation::getMaterial (const FieldValue *val)
 {
 #ifdef COMPLEX_FIELD_VALUES
-  return val->getCurValue ().real ();
+  return val->real ();
 #else /* COMPLEX_FIELD_VALUES */
-  return val->getCurValue ();
+  return *val;
 #endif /* !COMPLEX_FIELD_VALUES */
 }
 
+FPValue
+Approximation::getMaterial (const Material &material, GridType typeOfMaterial)
+{
+  return material.getProperty (typeOfMaterial);
+}
+
 FPValue
 Approximation::phaseVelocityIncidentWave3D (FPValue delta,
                                             FPValue freeSpaceWaveLentgh,
@@ -1,8 +1,9 @@
 #ifndef APPROXIMATION_H
 #define APPROXIMATION_H
 
-#include "FieldPoint.h"
+#include "FieldValue.h"
 #include "GridCoordinate3D.h"
+#include "MaterialGrid.h"
 
 class Approximation
 {
@@ -23,7 +24,8 @@ public:
                                      FPValue, FPValue, FPValue, FPValue, FPValue, FPValue, FPValue, FPValue, FPValue,
                                      FPValue, FPValue, FPValue, FPValue, FPValue, FPValue, FPValue, FPValue, FPValue);
 
-  static FPValue getMaterial (const FieldPointValue *);
+  static FPValue getMaterial (const FieldValue *);
+  static FPValue getMaterial (const Material &, GridType);
 
   static FPValue phaseVelocityIncidentWave3D (FPValue, FPValue, FPValue, FPValue, FPValue, FPValue);
   static FPValue phaseVelocityIncidentWave2D (FPValue, FPValue, FPValue, FPValue, FPValue);
@@ -62,6 +62,17 @@ public:
   virtual GridCoordinate3D getHyCircuitElement (GridCoordinate3D, LayoutDirection) const = 0;
   virtual GridCoordinate3D getHzCircuitElement (GridCoordinate3D, LayoutDirection) const = 0;
 
+  /*
+   * Get difference between coordinate of circut field component and coordinate of field component, which is the same
+   * for all coordinates
+   */
+  virtual GridCoordinate3D getExCircuitElementDiff (LayoutDirection) const = 0;
+  virtual GridCoordinate3D getEyCircuitElementDiff (LayoutDirection) const = 0;
+  virtual GridCoordinate3D getEzCircuitElementDiff (LayoutDirection) const = 0;
+  virtual GridCoordinate3D getHxCircuitElementDiff (LayoutDirection) const = 0;
+  virtual GridCoordinate3D getHyCircuitElementDiff (LayoutDirection) const = 0;
+  virtual GridCoordinate3D getHzCircuitElementDiff (LayoutDirection) const = 0;
+
   /*
    * Get size of field component grid
    */
@@ -183,6 +194,16 @@ public:
   virtual FieldValue getHxFromIncidentH (FieldValue) const = 0;
   virtual FieldValue getHyFromIncidentH (FieldValue) const = 0;
   virtual FieldValue getHzFromIncidentH (FieldValue) const = 0;
+
+  /*
+   * Projections of incident wave on field components, i.e. values of field components per unit of incident wave
+   */
+  virtual FPValue getExFromIncidentEFactor () const = 0;
+  virtual FPValue getEyFromIncidentEFactor () const = 0;
+  virtual FPValue getEzFromIncidentEFactor () const = 0;
+  virtual FPValue getHxFromIncidentHFactor () const = 0;
+  virtual FPValue getHyFromIncidentHFactor () const = 0;
+  virtual FPValue getHzFromIncidentHFactor () const = 0;
 }; /* GridLayout */
 
 #endif /* GRID_LAYOUT_H */
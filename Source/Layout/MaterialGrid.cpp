@@ -0,0 +1,134 @@
+#include "MaterialGrid.h"
+
+#include <algorithm>
+
+/**
+ * Get property of material
+ *
+ * @return value of property
+ */
+FPValue
+Material::getProperty (GridType typeOfMaterial) const /**< property of material */
+{
+  switch (typeOfMaterial)
+  {
+    case GridType::EPS:
+    {
+      return eps;
+    }
+    case GridType::MU:
+    {
+      return mu;
+    }
+    case GridType::SIGMAX:
+    {
+      return sigmaX;
+    }
+    case GridType::SIGMAY:
+    {
+      return sigmaY;
+    }
+    case GridType::SIGMAZ:
+    {
+      return sigmaZ;
+    }
+    case GridType::OMEGAPE:
+    {
+      return omegaPE;
+    }
+    case GridType::GAMMAE:
+    {
+      return gammaE;
+    }
+    case GridType::OMEGAPM:
+    {
+      return omegaPM;
+    }
+    case GridType::GAMMAM:
+    {
+      return gammaM;
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
+
+  return 0;
+} /* Material::getProperty */
+
+/**
+ * Set property of material
+ */
+void
+Material::setProperty (GridType typeOfMaterial, /**< property of material */
+                       FPValue value) /**< value of property */
+{
+  switch (typeOfMaterial)
+  {
+    case GridType::EPS:
+    {
+      eps = value;
+      break;
+    }
+    case GridType::MU:
+    {
+      mu = value;
+      break;
+    }
+    case GridType::SIGMAX:
+    {
+      sigmaX = value;
+      break;
+    }
+    case GridType::SIGMAY:
+    {
+      sigmaY = value;
+      break;
+    }
+    case GridType::SIGMAZ:
+    {
+      sigmaZ = value;
+      break;
+    }
+    case GridType::OMEGAPE:
+    {
+      omegaPE = value;
+      break;
+    }
+    case GridType::GAMMAE:
+    {
+      gammaE = value;
+      break;
+    }
+    case GridType::OMEGAPM:
+    {
+      omegaPM = value;
+      break;
+    }
+    case GridType::GAMMAM:
+    {
+      gammaM = value;
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
+} /* Material::setProperty */
+
+/**
+ * Compare materials property by property, which is required to store them in ordered map
+ *
+ * @return true if this material precedes rhs
+ */
+bool
+Material::operator< (const Material &rhs) const /**< material to compare with */
+{
+  const FPValue lhsValues[] = {eps, mu, sigmaX, sigmaY, sigmaZ, omegaPE, gammaE, omegaPM, gammaM};
+  const FPValue rhsValues[] = {rhs.eps, rhs.mu, rhs.sigmaX, rhs.sigmaY, rhs.sigmaZ,
+                               rhs.omegaPE, rhs.gammaE, rhs.omegaPM, rhs.gammaM};
+
+  return std::lexicographical_compare (lhsValues, lhsValues + 9, rhsValues, rhsValues + 9);
+} /* Material::operator< */
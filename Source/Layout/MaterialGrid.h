@@ -0,0 +1,249 @@
+#ifndef MATERIAL_GRID_H
+#define MATERIAL_GRID_H
+
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#include "Assert.h"
+#include "Grid.h"
+#include "GridLayout.h"
+
+/**
+ * Type of identifier of material in grid of materials. Limits number of distinct materials in grid.
+ */
+typedef uint16_t material_id;
+
+/**
+ * Maximum number of distinct materials in grid of materials
+ */
+#define MATERIAL_COUNT_MAX (65536)
+
+/**
+ * Properties of single material
+ */
+class Material
+{
+  FPValue eps; /**< relative permittivity */
+  FPValue mu; /**< relative permeability */
+
+  FPValue sigmaX; /**< conductivity of PML by Ox */
+  FPValue sigmaY; /**< conductivity of PML by Oy */
+  FPValue sigmaZ; /**< conductivity of PML by Oz */
+
+  FPValue omegaPE; /**< electric plasma frequency of Drude model */
+  FPValue gammaE; /**< electric collision frequency of Drude model */
+
+  FPValue omegaPM; /**< magnetic plasma frequency of Drude model */
+  FPValue gammaM; /**< magnetic collision frequency of Drude model */
+
+public:
+
+  /**
+   * Constructor of material, which is vacuum by default
+   */
+  Material ()
+    : eps (1)
+    , mu (1)
+    , sigmaX (0)
+    , sigmaY (0)
+    , sigmaZ (0)
+    , omegaPE (0)
+    , gammaE (0)
+    , omegaPM (0)
+    , gammaM (0)
+  {
+  } /* Material */
+
+  FPValue getProperty (GridType) const;
+  void setProperty (GridType, FPValue);
+
+  bool operator< (const Material &) const;
+}; /* Material */
+
+/**
+ * Grid of materials. Each point of grid stores only identifier of material, while properties of all materials are
+ * stored once in table of materials. Geometry of grid (size, position of chunk for current computational node, etc.)
+ * is defined by TGrid, which is constructed without time layers and does not store any values.
+ */
+template <class TCoord, class TGrid>
+class MaterialGrid
+{
+  /**
+   * Grid without values, which defines geometry of grid of materials
+   */
+  TGrid geometry;
+
+  /**
+   * Identifiers of materials for all points of grid
+   */
+  std::vector<material_id> materialIds;
+
+  /**
+   * Table of materials
+   */
+  std::vector<Material> materials;
+
+  /**
+   * Map from material to its identifier, used to find existing materials when grid is initialized
+   */
+  std::map<Material, material_id> materialsMap;
+
+private:
+
+  material_id addMaterial (const Material &);
+
+public:
+
+  MaterialGrid (const TCoord &, const char * = "unnamed");
+  MaterialGrid (const TCoord &, const TCoord &, TCoord, TCoord, const char * = "unnamed");
+
+  const TCoord &getSize () const
+  {
+    return geometry.getSize ();
+  } /* getSize */
+
+  TCoord getTotalSize () const
+  {
+    return geometry.getTotalSize ();
+  } /* getTotalSize */
+
+  TCoord getTotalPosition (TCoord pos)
+  {
+    return geometry.getTotalPosition (pos);
+  } /* getTotalPosition */
+
+  grid_iter getCountMaterials () const
+  {
+    return materials.size ();
+  } /* getCountMaterials */
+
+  const Material &getMaterial (const TCoord &);
+  const Material &getMaterialByAbsolutePos (const TCoord &);
+
+  void setMaterial (const Material &, const TCoord &);
+
+  void fillGrid (Grid<TCoord> &, GridType);
+}; /* MaterialGrid */
+
+/*
+ * Templates definition
+ */
+
+/**
+ * Constructor of non-parallel grid of materials. All points of grid are set to vacuum
+ */
+template <class TCoord, class TGrid>
+MaterialGrid<TCoord, TGrid>::MaterialGrid (const TCoord &s, /**< size of grid */
+                                           const char *name) /**< name of grid */
+  : geometry (s, 0, name, 0)
+{
+  materialIds.assign (geometry.getSize ().calculateTotalCoord (), addMaterial (Material ()));
+} /* MaterialGrid<TCoord, TGrid>::MaterialGrid */
+
+/**
+ * Constructor of parallel grid of materials. All points of grid are set to vacuum
+ */
+template <class TCoord, class TGrid>
+MaterialGrid<TCoord, TGrid>::MaterialGrid (const TCoord &totSize, /**< total size of grid */
+                                           const TCoord &bufSize, /**< buffer size */
+                                           TCoord curSize, /**< size of grid for current node */
+                                           TCoord coreCurSize, /**< size of grid per node */
+                                           const char *name) /**< name of grid */
+  : geometry (totSize, bufSize, 0, curSize, coreCurSize, name, 0)
+{
+  materialIds.assign (geometry.getSize ().calculateTotalCoord (), addMaterial (Material ()));
+} /* MaterialGrid<TCoord, TGrid>::MaterialGrid */
+
+/**
+ * Find material in table of materials or add it to the table
+ *
+ * @return identifier of material
+ */
+template <class TCoord, class TGrid>
+material_id
+MaterialGrid<TCoord, TGrid>::addMaterial (const Material &material) /**< material */
+{
+  std::map<Material, material_id>::iterator it = materialsMap.find (material);
+
+  if (it != materialsMap.end ())
+  {
+    return it->second;
+  }
+
+  if (materials.size () >= MATERIAL_COUNT_MAX)
+  {
+    printf ("Number of distinct materials exceeds %d, which is supported by grid of materials.\n",
+            MATERIAL_COUNT_MAX);
+    exit (EXIT_ERROR);
+  }
+
+  material_id id = materials.size ();
+
+  materials.push_back (material);
+  materialsMap[material] = id;
+
+  return id;
+} /* MaterialGrid<TCoord, TGrid>::addMaterial */
+
+/**
+ * Get material at position in grid
+ *
+ * @return material
+ */
+template <class TCoord, class TGrid>
+const Material &
+MaterialGrid<TCoord, TGrid>::getMaterial (const TCoord &position) /**< coordinate in grid */
+{
+  grid_iter coord = geometry.calculateIndexFromPosition (position);
+
+  ASSERT (coord < materialIds.size ());
+
+  return materials[materialIds[coord]];
+} /* MaterialGrid<TCoord, TGrid>::getMaterial */
+
+/**
+ * Get material at absolute position in grid
+ *
+ * @return material
+ */
+template <class TCoord, class TGrid>
+const Material &
+MaterialGrid<TCoord, TGrid>::getMaterialByAbsolutePos (const TCoord &absPosition) /**< absolute coordinate in grid */
+{
+  return getMaterial (geometry.getRelativePosition (absPosition));
+} /* MaterialGrid<TCoord, TGrid>::getMaterialByAbsolutePos */
+
+/**
+ * Set material at position in grid. Material is added to table of materials, so all properties of material should be
+ * set beforehand, otherwise intermediate materials would fill table.
+ */
+template <class TCoord, class TGrid>
+void
+MaterialGrid<TCoord, TGrid>::setMaterial (const Material &material, /**< material */
+                                          const TCoord &position) /**< coordinate in grid */
+{
+  grid_iter coord = geometry.calculateIndexFromPosition (position);
+
+  ASSERT (coord < materialIds.size ());
+
+  materialIds[coord] = addMaterial (material);
+} /* MaterialGrid<TCoord, TGrid>::setMaterial */
+
+/**
+ * Fill grid of values of the same size with single property of materials, e.g. to dump it
+ */
+template <class TCoord, class TGrid>
+void
+MaterialGrid<TCoord, TGrid>::fillGrid (Grid<TCoord> &grid, /**< grid to fill */
+                                       GridType typeOfMaterial) /**< property of material */
+{
+  ASSERT (grid.getSize () == getSize ());
+
+  for (grid_iter i = 0; i < materialIds.size (); ++i)
+  {
+    grid.setFieldValue (FieldValue (materials[materialIds[i]].getProperty (typeOfMaterial)), i, 0);
+  }
+} /* MaterialGrid<TCoord, TGrid>::fillGrid */
+
+#endif /* MATERIAL_GRID_H */
@@ -252,6 +252,57 @@ YeeGridLayout::getHzCircuitElement (GridCoordinate3D coord, LayoutDirection dir)
   return convertCoord (coordFP);
 }
 
+GridCoordinate3D
+YeeGridLayout::getExCircuitElementDiff (LayoutDirection dir) const
+{
+  /*
+   * Circuit elements are shifted by at most one cell, so coordinate (1, 1, 1) has all of them inside grid
+   */
+  GridCoordinate3D coord (1, 1, 1);
+
+  return getExCircuitElement (coord, dir) - coord;
+}
+
+GridCoordinate3D
+YeeGridLayout::getEyCircuitElementDiff (LayoutDirection dir) const
+{
+  GridCoordinate3D coord (1, 1, 1);
+
+  return getEyCircuitElement (coord, dir) - coord;
+}
+
+GridCoordinate3D
+YeeGridLayout::getEzCircuitElementDiff (LayoutDirection dir) const
+{
+  GridCoordinate3D coord (1, 1, 1);
+
+  return getEzCircuitElement (coord, dir) - coord;
+}
+
+GridCoordinate3D
+YeeGridLayout::getHxCircuitElementDiff (LayoutDirection dir) const
+{
+  GridCoordinate3D coord (1, 1, 1);
+
+  return getHxCircuitElement (coord, dir) - coord;
+}
+
+GridCoordinate3D
+YeeGridLayout::getHyCircuitElementDiff (LayoutDirection dir) const
+{
+  GridCoordinate3D coord (1, 1, 1);
+
+  return getHyCircuitElement (coord, dir) - coord;
+}
+
+GridCoordinate3D
+YeeGridLayout::getHzCircuitElementDiff (LayoutDirection dir) const
+{
+  GridCoordinate3D coord (1, 1, 1);
+
+  return getHzCircuitElement (coord, dir) - coord;
+}
+
 bool
 YeeGridLayout::isInPML (GridCoordinateFP3D realCoordFP) const
 {
@@ -811,35 +862,71 @@ YeeGridLayout::doNeedTFSFUpdateHzBorder (GridCoordinate3D coord, LayoutDirection
 FieldValue
 YeeGridLayout::getExFromIncidentE (FieldValue valE) const
 {
-  return valE * (FPValue) (cos (incidentWaveAngle3) * sin (incidentWaveAngle2) - sin (incidentWaveAngle3) * cos (incidentWaveAngle1) * cos (incidentWaveAngle2));
+  return valE * getExFromIncidentEFactor ();
+}
+
+FPValue
+YeeGridLayout::getExFromIncidentEFactor () const
+{
+  return (FPValue) (cos (incidentWaveAngle3) * sin (incidentWaveAngle2) - sin (incidentWaveAngle3) * cos (incidentWaveAngle1) * cos (incidentWaveAngle2));
 }
 
 FieldValue
 YeeGridLayout::getEyFromIncidentE (FieldValue valE) const
 {
-  return valE * (FPValue) ( - cos (incidentWaveAngle3) * cos (incidentWaveAngle2) - sin (incidentWaveAngle3) * cos (incidentWaveAngle1) * sin (incidentWaveAngle2));
+  return valE * getEyFromIncidentEFactor ();
+}
+
+FPValue
+YeeGridLayout::getEyFromIncidentEFactor () const
+{
+  return (FPValue) ( - cos (incidentWaveAngle3) * cos (incidentWaveAngle2) - sin (incidentWaveAngle3) * cos (incidentWaveAngle1) * sin (incidentWaveAngle2));
 }
 
 FieldValue
 YeeGridLayout::getEzFromIncidentE (FieldValue valE) const
 {
-  return valE * (FPValue) (sin (incidentWaveAngle3) * sin (incidentWaveAngle1));
+  return valE * getEzFromIncidentEFactor ();
+}
+
+FPValue
+YeeGridLayout::getEzFromIncidentEFactor () const
+{
+  return (FPValue) (sin (incidentWaveAngle3) * sin (incidentWaveAngle1));
 }
 
 FieldValue
 YeeGridLayout::getHxFromIncidentH (FieldValue valH) const
 {
-  return valH * (FPValue) (sin (incidentWaveAngle3) * sin (incidentWaveAngle2) + cos (incidentWaveAngle3) * cos (incidentWaveAngle1) * cos (incidentWaveAngle2));
+  return valH * getHxFromIncidentHFactor ();
+}
+
+FPValue
+YeeGridLayout::getHxFromIncidentHFactor () const
+{
+  return (FPValue) (sin (incidentWaveAngle3) * sin (incidentWaveAngle2) + cos (incidentWaveAngle3) * cos (incidentWaveAngle1) * cos (incidentWaveAngle2));
 }
 
 FieldValue
 YeeGridLayout::getHyFromIncidentH (FieldValue valH) const
 {
-  return valH * (FPValue) (- sin (incidentWaveAngle3) * cos (incidentWaveAngle2) + cos (incidentWaveAngle3) * cos (incidentWaveAngle1) * sin (incidentWaveAngle2));
+  return valH * getHyFromIncidentHFactor ();
+}
+
+FPValue
+YeeGridLayout::getHyFromIncidentHFactor () const
+{
+  return (FPValue) (- sin (incidentWaveAngle3) * cos (incidentWaveAngle2) + cos (incidentWaveAngle3) * cos (incidentWaveAngle1) * sin (incidentWaveAngle2));
 }
 
 FieldValue
 YeeGridLayout::getHzFromIncidentH (FieldValue valH) const
 {
-  return - valH * (FPValue) (cos (incidentWaveAngle3) * sin (incidentWaveAngle1));
+  return valH * getHzFromIncidentHFactor ();
+}
+
+FPValue
+YeeGridLayout::getHzFromIncidentHFactor () const
+{
+  return (FPValue) (- cos (incidentWaveAngle3) * sin (incidentWaveAngle1));
 }
@@ -5,6 +5,7 @@
 #include "Assert.h"
 #include "Grid.h"
 #include "GridLayout.h"
+#include "MaterialGrid.h"
 #include "PhysicsConst.h"
 
 #include <cmath>
@@ -80,6 +81,17 @@ public:
   virtual GridCoordinate3D getHyCircuitElement (GridCoordinate3D, LayoutDirection) const CXX11_OVERRIDE_FINAL;
   virtual GridCoordinate3D getHzCircuitElement (GridCoordinate3D, LayoutDirection) const CXX11_OVERRIDE_FINAL;
 
+  /*
+   * Get difference between coordinate of circut field component and coordinate of field component. Components of
+   * difference, which correspond to negative shifts, are wrapped around (i.e. pos + diff is still correct)
+   */
+  virtual GridCoordinate3D getExCircuitElementDiff (LayoutDirection) const CXX11_OVERRIDE_FINAL;
+  virtual GridCoordinate3D getEyCircuitElementDiff (LayoutDirection) const CXX11_OVERRIDE_FINAL;
+  virtual GridCoordinate3D getEzCircuitElementDiff (LayoutDirection) const CXX11_OVERRIDE_FINAL;
+  virtual GridCoordinate3D getHxCircuitElementDiff (LayoutDirection) const CXX11_OVERRIDE_FINAL;
+  virtual GridCoordinate3D getHyCircuitElementDiff (LayoutDirection) const CXX11_OVERRIDE_FINAL;
+  virtual GridCoordinate3D getHzCircuitElementDiff (LayoutDirection) const CXX11_OVERRIDE_FINAL;
+
   /*
    * Get size of field component grid
    */
@@ -394,6 +406,13 @@ public:
   virtual FieldValue getHyFromIncidentH (FieldValue) const CXX11_OVERRIDE_FINAL;
   virtual FieldValue getHzFromIncidentH (FieldValue) const CXX11_OVERRIDE_FINAL;
 
+  virtual FPValue getExFromIncidentEFactor () const CXX11_OVERRIDE_FINAL;
+  virtual FPValue getEyFromIncidentEFactor () const CXX11_OVERRIDE_FINAL;
+  virtual FPValue getEzFromIncidentEFactor () const CXX11_OVERRIDE_FINAL;
+  virtual FPValue getHxFromIncidentHFactor () const CXX11_OVERRIDE_FINAL;
+  virtual FPValue getHyFromIncidentHFactor () const CXX11_OVERRIDE_FINAL;
+  virtual FPValue getHzFromIncidentHFactor () const CXX11_OVERRIDE_FINAL;
+
   /**
    * Constructor of Yee grid
    */
@@ -480,29 +499,31 @@ public:
   {
   } /* ~YeeGridLayout */
 
-  template <class TCoord>
-  FPValue getApproximateMaterial (Grid<TCoord> &, GridCoordinate3D, GridCoordinate3D);
-  template <class TCoord>
-  FPValue getApproximateMaterial (Grid<TCoord> &, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D);
-  template <class TCoord>
-  FPValue getApproximateMaterial (Grid<TCoord> &, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D,
-                                  GridCoordinate3D, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D);
-  template <class TCoord>
-  FPValue getApproximateMetaMaterial (Grid<TCoord> &, Grid<TCoord> &, Grid<TCoord> &, GridCoordinate3D, GridCoordinate3D,
-                                      FPValue &, FPValue &);
-  template <class TCoord>
-  FPValue getApproximateMetaMaterial (Grid<TCoord> &, Grid<TCoord> &, Grid<TCoord> &, GridCoordinate3D, GridCoordinate3D,
-                                      GridCoordinate3D, GridCoordinate3D, FPValue &, FPValue &);
-  template <class TCoord>
-  FPValue getApproximateMetaMaterial (Grid<TCoord> &, Grid<TCoord> &, Grid<TCoord> &, GridCoordinate3D, GridCoordinate3D,
+  template <class TMaterialGrid>
+  FPValue getApproximateMaterial (TMaterialGrid &, GridType, GridCoordinate3D, GridCoordinate3D);
+  template <class TMaterialGrid>
+  FPValue getApproximateMaterial (TMaterialGrid &, GridType, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D,
+                                  GridCoordinate3D);
+  template <class TMaterialGrid>
+  FPValue getApproximateMaterial (TMaterialGrid &, GridType, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D,
+                                  GridCoordinate3D, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D,
+                                  GridCoordinate3D);
+  template <class TMaterialGrid>
+  FPValue getApproximateMetaMaterial (TMaterialGrid &, GridType, GridType, GridType, GridCoordinate3D,
+                                      GridCoordinate3D, FPValue &, FPValue &);
+  template <class TMaterialGrid>
+  FPValue getApproximateMetaMaterial (TMaterialGrid &, GridType, GridType, GridType, GridCoordinate3D,
+                                      GridCoordinate3D, GridCoordinate3D, GridCoordinate3D, FPValue &, FPValue &);
+  template <class TMaterialGrid>
+  FPValue getApproximateMetaMaterial (TMaterialGrid &, GridType, GridType, GridType, GridCoordinate3D,
                                       GridCoordinate3D, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D,
-                                      GridCoordinate3D, GridCoordinate3D, FPValue &, FPValue &);
+                                      GridCoordinate3D, GridCoordinate3D, GridCoordinate3D, FPValue &, FPValue &);
 
-  template <class TCoord>
-  FPValue getMetaMaterial (GridCoordinate3D &, GridType, Grid<TCoord> &, GridType, Grid<TCoord> &, GridType, Grid<TCoord> &,
-                           GridType, FPValue &, FPValue &);
-  template <class TCoord>
-  FPValue getMaterial (GridCoordinate3D &, GridType, Grid<TCoord> &, GridType);
+  template <class TMaterialGrid>
+  FPValue getMetaMaterial (GridCoordinate3D &, GridType, TMaterialGrid &, GridType, GridType, GridType,
+                           FPValue &, FPValue &);
+  template <class TMaterialGrid>
+  FPValue getMaterial (GridCoordinate3D &, GridType, TMaterialGrid &, GridType);
 
   bool getIsDoubleMaterialPrecision () const
   {
@@ -510,41 +531,44 @@ public:
   }
 }; /* YeeGridLayout */
 
-template <class TCoord>
+template <class TMaterialGrid>
 FPValue
-YeeGridLayout::getApproximateMaterial (Grid<TCoord> &gridMaterial,
+YeeGridLayout::getApproximateMaterial (TMaterialGrid &gridMaterial,
+                                       GridType typeOfMaterial,
                                        GridCoordinate3D coord1,
                                        GridCoordinate3D coord2)
 {
-  FieldPointValue* val1 = gridMaterial.getFieldPointValueByAbsolutePos (coord1);
-  FieldPointValue* val2 = gridMaterial.getFieldPointValueByAbsolutePos (coord2);
+  const Material &material1 = gridMaterial.getMaterialByAbsolutePos (coord1);
+  const Material &material2 = gridMaterial.getMaterialByAbsolutePos (coord2);
 
-  return Approximation::approximateMaterial (Approximation::getMaterial (val1),
-                                             Approximation::getMaterial (val2));
+  return Approximation::approximateMaterial (Approximation::getMaterial (material1, typeOfMaterial),
+                                             Approximation::getMaterial (material2, typeOfMaterial));
 }
 
-template <class TCoord>
+template <class TMaterialGrid>
 FPValue
-YeeGridLayout::getApproximateMaterial (Grid<TCoord> &gridMaterial,
+YeeGridLayout::getApproximateMaterial (TMaterialGrid &gridMaterial,
+                                       GridType typeOfMaterial,
                                        GridCoordinate3D coord1,
                                        GridCoordinate3D coord2,
                                        GridCoordinate3D coord3,
                                        GridCoordinate3D coord4)
 {
-  FieldPointValue* val1 = gridMaterial.getFieldPointValueByAbsolutePos (coord1);
-  FieldPointValue* val2 = gridMaterial.getFieldPointValueByAbsolutePos (coord2);
-  FieldPointValue* val3 = gridMaterial.getFieldPointValueByAbsolutePos (coord3);
-  FieldPointValue* val4 = gridMaterial.getFieldPointValueByAbsolutePos (coord4);
-
-  return Approximation::approximateMaterial (Approximation::getMaterial (val1),
-                                             Approximation::getMaterial (val2),
-                                             Approximation::getMaterial (val3),
-                                             Approximation::getMaterial (val4));
+  const Material &material1 = gridMaterial.getMaterialByAbsolutePos (coord1);
+  const Material &material2 = gridMaterial.getMaterialByAbsolutePos (coord2);
+  const Material &material3 = gridMaterial.getMaterialByAbsolutePos (coord3);
+  const Material &material4 = gridMaterial.getMaterialByAbsolutePos (coord4);
+
+  return Approximation::approximateMaterial (Approximation::getMaterial (material1, typeOfMaterial),
+                                             Approximation::getMaterial (material2, typeOfMaterial),
+                                             Approximation::getMaterial (material3, typeOfMaterial),
+                                             Approximation::getMaterial (material4, typeOfMaterial));
 }
 
-template <class TCoord>
+template <class TMaterialGrid>
 FPValue
-YeeGridLayout::getApproximateMaterial (Grid<TCoord> &gridMaterial,
+YeeGridLayout::getApproximateMaterial (TMaterialGrid &gridMaterial,
+                                       GridType typeOfMaterial,
                                        GridCoordinate3D coord1,
                                        GridCoordinate3D coord2,
                                        GridCoordinate3D coord3,
@@ -554,64 +578,60 @@ YeeGridLayout::getApproximateMaterial (Grid<TCoord> &gridMaterial,
                                        GridCoordinate3D coord7,
                                        GridCoordinate3D coord8)
 {
-  FieldPointValue* val1 = gridMaterial.getFieldPointValueByAbsolutePos (coord1);
-  FieldPointValue* val2 = gridMaterial.getFieldPointValueByAbsolutePos (coord2);
-  FieldPointValue* val3 = gridMaterial.getFieldPointValueByAbsolutePos (coord3);
-  FieldPointValue* val4 = gridMaterial.getFieldPointValueByAbsolutePos (coord4);
-  FieldPointValue* val5 = gridMaterial.getFieldPointValueByAbsolutePos (coord5);
-  FieldPointValue* val6 = gridMaterial.getFieldPointValueByAbsolutePos (coord6);
-  FieldPointValue* val7 = gridMaterial.getFieldPointValueByAbsolutePos (coord7);
-  FieldPointValue* val8 = gridMaterial.getFieldPointValueByAbsolutePos (coord8);
-
-  return Approximation::approximateMaterial (Approximation::getMaterial (val1),
-                                             Approximation::getMaterial (val2),
-                                             Approximation::getMaterial (val3),
-                                             Approximation::getMaterial (val4),
-                                             Approximation::getMaterial (val5),
-                                             Approximation::getMaterial (val6),
-                                             Approximation::getMaterial (val7),
-                                             Approximation::getMaterial (val8));
+  const Material &material1 = gridMaterial.getMaterialByAbsolutePos (coord1);
+  const Material &material2 = gridMaterial.getMaterialByAbsolutePos (coord2);
+  const Material &material3 = gridMaterial.getMaterialByAbsolutePos (coord3);
+  const Material &material4 = gridMaterial.getMaterialByAbsolutePos (coord4);
+  const Material &material5 = gridMaterial.getMaterialByAbsolutePos (coord5);
+  const Material &material6 = gridMaterial.getMaterialByAbsolutePos (coord6);
+  const Material &material7 = gridMaterial.getMaterialByAbsolutePos (coord7);
+  const Material &material8 = gridMaterial.getMaterialByAbsolutePos (coord8);
+
+  return Approximation::approximateMaterial (Approximation::getMaterial (material1, typeOfMaterial),
+                                             Approximation::getMaterial (material2, typeOfMaterial),
+                                             Approximation::getMaterial (material3, typeOfMaterial),
+                                             Approximation::getMaterial (material4, typeOfMaterial),
+                                             Approximation::getMaterial (material5, typeOfMaterial),
+                                             Approximation::getMaterial (material6, typeOfMaterial),
+                                             Approximation::getMaterial (material7, typeOfMaterial),
+                                             Approximation::getMaterial (material8, typeOfMaterial));
 }
 
-template <class TCoord>
+template <class TMaterialGrid>
 FPValue
-YeeGridLayout::getApproximateMetaMaterial (Grid<TCoord> &gridMaterial,
-                                           Grid<TCoord> &gridMaterialOmega,
-                                           Grid<TCoord> &gridMaterialGamma,
+YeeGridLayout::getApproximateMetaMaterial (TMaterialGrid &gridMaterial,
+                                           GridType typeOfMaterial,
+                                           GridType typeOfMaterialOmega,
+                                           GridType typeOfMaterialGamma,
                                            GridCoordinate3D coord1,
                                            GridCoordinate3D coord2,
                                            FPValue &omega,
                                            FPValue &gamma)
 {
-  FieldPointValue* val1 = gridMaterial.getFieldPointValueByAbsolutePos (coord1);
-  FieldPointValue* val2 = gridMaterial.getFieldPointValueByAbsolutePos (coord2);
+  const Material &material1 = gridMaterial.getMaterialByAbsolutePos (coord1);
+  const Material &material2 = gridMaterial.getMaterialByAbsolutePos (coord2);
 
-  FPValue material = Approximation::approximateMaterial (Approximation::getMaterial (val1),
-                                                         Approximation::getMaterial (val2));
-
-  FieldPointValue *val3 = gridMaterialOmega.getFieldPointValueByAbsolutePos (coord1);
-  FieldPointValue *val4 = gridMaterialOmega.getFieldPointValueByAbsolutePos (coord2);
-
-  FieldPointValue *val5 = gridMaterialGamma.getFieldPointValueByAbsolutePos (coord1);
-  FieldPointValue *val6 = gridMaterialGamma.getFieldPointValueByAbsolutePos (coord2);
+  FPValue material = Approximation::approximateMaterial (Approximation::getMaterial (material1, typeOfMaterial),
+                                                         Approximation::getMaterial (material2, typeOfMaterial));
 
   Approximation::approximateDrudeModel (omega,
                                         gamma,
-                                        Approximation::getMaterial (val1),
-                                        Approximation::getMaterial (val2),
-                                        Approximation::getMaterial (val3),
-                                        Approximation::getMaterial (val4),
-                                        Approximation::getMaterial (val5),
-                                        Approximation::getMaterial (val6));
+                                        Approximation::getMaterial (material1, typeOfMaterial),
+                                        Approximation::getMaterial (material2, typeOfMaterial),
+                                        Approximation::getMaterial (material1, typeOfMaterialOmega),
+                                        Approximation::getMaterial (material2, typeOfMaterialOmega),
+                                        Approximation::getMaterial (material1, typeOfMaterialGamma),
+                                        Approximation::getMaterial (material2, typeOfMaterialGamma));
 
   return material;
 }
 
-template <class TCoord>
+template <class TMaterialGrid>
 FPValue
-YeeGridLayout::getApproximateMetaMaterial (Grid<TCoord> &gridMaterial,
-                                           Grid<TCoord> &gridMaterialOmega,
-                                           Grid<TCoord> &gridMaterialGamma,
+YeeGridLayout::getApproximateMetaMaterial (TMaterialGrid &gridMaterial,
+                                           GridType typeOfMaterial,
+                                           GridType typeOfMaterialOmega,
+                                           GridType typeOfMaterialGamma,
                                            GridCoordinate3D coord1,
                                            GridCoordinate3D coord2,
                                            GridCoordinate3D coord3,
@@ -619,49 +639,40 @@ YeeGridLayout::getApproximateMetaMaterial (Grid<TCoord> &gridMaterial,
                                            FPValue &omega,
                                            FPValue &gamma)
 {
-  FieldPointValue* val1 = gridMaterial.getFieldPointValueByAbsolutePos (coord1);
-  FieldPointValue* val2 = gridMaterial.getFieldPointValueByAbsolutePos (coord2);
-  FieldPointValue* val3 = gridMaterial.getFieldPointValueByAbsolutePos (coord3);
-  FieldPointValue* val4 = gridMaterial.getFieldPointValueByAbsolutePos (coord4);
-
-  FPValue material = Approximation::approximateMaterial (Approximation::getMaterial (val1),
-                                                         Approximation::getMaterial (val2),
-                                                         Approximation::getMaterial (val3),
-                                                         Approximation::getMaterial (val4));
-
-  FieldPointValue *val5 = gridMaterialOmega.getFieldPointValueByAbsolutePos (coord1);
-  FieldPointValue *val6 = gridMaterialOmega.getFieldPointValueByAbsolutePos (coord2);
-  FieldPointValue *val7 = gridMaterialOmega.getFieldPointValueByAbsolutePos (coord3);
-  FieldPointValue *val8 = gridMaterialOmega.getFieldPointValueByAbsolutePos (coord4);
-
-  FieldPointValue *val9 = gridMaterialGamma.getFieldPointValueByAbsolutePos (coord1);
-  FieldPointValue *val10 = gridMaterialGamma.getFieldPointValueByAbsolutePos (coord2);
-  FieldPointValue *val11 = gridMaterialGamma.getFieldPointValueByAbsolutePos (coord3);
-  FieldPointValue *val12 = gridMaterialGamma.getFieldPointValueByAbsolutePos (coord4);
+  const Material &material1 = gridMaterial.getMaterialByAbsolutePos (coord1);
+  const Material &material2 = gridMaterial.getMaterialByAbsolutePos (coord2);
+  const Material &material3 = gridMaterial.getMaterialByAbsolutePos (coord3);
+  const Material &material4 = gridMaterial.getMaterialByAbsolutePos (coord4);
+
+  FPValue material = Approximation::approximateMaterial (Approximation::getMaterial (material1, typeOfMaterial),
+                                                         Approximation::getMaterial (material2, typeOfMaterial),
+                                                         Approximation::getMaterial (material3, typeOfMaterial),
+                                                         Approximation::getMaterial (material4, typeOfMaterial));
 
   Approximation::approximateDrudeModel (omega,
                                         gamma,
-                                        Approximation::getMaterial (val1),
-                                        Approximation::getMaterial (val2),
-                                        Approximation::getMaterial (val3),
-                                        Approximation::getMaterial (val4),
-                                        Approximation::getMaterial (val5),
-                                        Approximation::getMaterial (val6),
-                                        Approximation::getMaterial (val7),
-                                        Approximation::getMaterial (val8),
-                                        Approximation::getMaterial (val9),
-                                        Approximation::getMaterial (val10),
-                                        Approximation::getMaterial (val11),
-                                        Approximation::getMaterial (val12));
+                                        Approximation::getMaterial (material1, typeOfMaterial),
+                                        Approximation::getMaterial (material2, typeOfMaterial),
+                                        Approximation::getMaterial (material3, typeOfMaterial),
+                                        Approximation::getMaterial (material4, typeOfMaterial),
+                                        Approximation::getMaterial (material1, typeOfMaterialOmega),
+                                        Approximation::getMaterial (material2, typeOfMaterialOmega),
+                                        Approximation::getMaterial (material3, typeOfMaterialOmega),
+                                        Approximation::getMaterial (material4, typeOfMaterialOmega),
+                                        Approximation::getMaterial (material1, typeOfMaterialGamma),
+                                        Approximation::getMaterial (material2, typeOfMaterialGamma),
+                                        Approximation::getMaterial (material3, typeOfMaterialGamma),
+                                        Approximation::getMaterial (material4, typeOfMaterialGamma));
 
   return material;
 }
 
-template <class TCoord>
+template <class TMaterialGrid>
 FPValue
-YeeGridLayout::getApproximateMetaMaterial (Grid<TCoord> &gridMaterial,
-                                           Grid<TCoord> &gridMaterialOmega,
-                                           Grid<TCoord> &gridMaterialGamma,
+YeeGridLayout::getApproximateMetaMaterial (TMaterialGrid &gridMaterial,
+                                           GridType typeOfMaterial,
+                                           GridType typeOfMaterialOmega,
+                                           GridType typeOfMaterialGamma,
                                            GridCoordinate3D coord1,
                                            GridCoordinate3D coord2,
                                            GridCoordinate3D coord3,
@@ -673,81 +684,61 @@ YeeGridLayout::getApproximateMetaMaterial (Grid<TCoord> &gridMaterial,
                                            FPValue &omega,
                                            FPValue &gamma)
 {
-  FieldPointValue* val1 = gridMaterial.getFieldPointValueByAbsolutePos (coord1);
-  FieldPointValue* val2 = gridMaterial.getFieldPointValueByAbsolutePos (coord2);
-  FieldPointValue* val3 = gridMaterial.getFieldPointValueByAbsolutePos (coord3);
-  FieldPointValue* val4 = gridMaterial.getFieldPointValueByAbsolutePos (coord4);
-  FieldPointValue* val5 = gridMaterial.getFieldPointValueByAbsolutePos (coord5);
-  FieldPointValue* val6 = gridMaterial.getFieldPointValueByAbsolutePos (coord6);
-  FieldPointValue* val7 = gridMaterial.getFieldPointValueByAbsolutePos (coord7);
-  FieldPointValue* val8 = gridMaterial.getFieldPointValueByAbsolutePos (coord8);
-
-  FPValue material = Approximation::approximateMaterial (Approximation::getMaterial (val1),
-                                                         Approximation::getMaterial (val2),
-                                                         Approximation::getMaterial (val3),
-                                                         Approximation::getMaterial (val4),
-                                                         Approximation::getMaterial (val5),
-                                                         Approximation::getMaterial (val6),
-                                                         Approximation::getMaterial (val7),
-                                                         Approximation::getMaterial (val8));
-
-  FieldPointValue *val9 = gridMaterialOmega.getFieldPointValueByAbsolutePos (coord1);
-  FieldPointValue *val10 = gridMaterialOmega.getFieldPointValueByAbsolutePos (coord2);
-  FieldPointValue *val11 = gridMaterialOmega.getFieldPointValueByAbsolutePos (coord3);
-  FieldPointValue *val12 = gridMaterialOmega.getFieldPointValueByAbsolutePos (coord4);
-  FieldPointValue *val13 = gridMaterialOmega.getFieldPointValueByAbsolutePos (coord5);
-  FieldPointValue *val14 = gridMaterialOmega.getFieldPointValueByAbsolutePos (coord6);
-  FieldPointValue *val15 = gridMaterialOmega.getFieldPointValueByAbsolutePos (coord7);
-  FieldPointValue *val16 = gridMaterialOmega.getFieldPointValueByAbsolutePos (coord8);
-
-  FieldPointValue *val17 = gridMaterialGamma.getFieldPointValueByAbsolutePos (coord1);
-  FieldPointValue *val18 = gridMaterialGamma.getFieldPointValueByAbsolutePos (coord2);
-  FieldPointValue *val19 = gridMaterialGamma.getFieldPointValueByAbsolutePos (coord3);
-  FieldPointValue *val20 = gridMaterialGamma.getFieldPointValueByAbsolutePos (coord4);
-  FieldPointValue *val21 = gridMaterialGamma.getFieldPointValueByAbsolutePos (coord5);
-  FieldPointValue *val22 = gridMaterialGamma.getFieldPointValueByAbsolutePos (coord6);
-  FieldPointValue *val23 = gridMaterialGamma.getFieldPointValueByAbsolutePos (coord7);
-  FieldPointValue *val24 = gridMaterialGamma.getFieldPointValueByAbsolutePos (coord8);
+  const Material &material1 = gridMaterial.getMaterialByAbsolutePos (coord1);
+  const Material &material2 = gridMaterial.getMaterialByAbsolutePos (coord2);
+  const Material &material3 = gridMaterial.getMaterialByAbsolutePos (coord3);
+  const Material &material4 = gridMaterial.getMaterialByAbsolutePos (coord4);
+  const Material &material5 = gridMaterial.getMaterialByAbsolutePos (coord5);
+  const Material &material6 = gridMaterial.getMaterialByAbsolutePos (coord6);
+  const Material &material7 = gridMaterial.getMaterialByAbsolutePos (coord7);
+  const Material &material8 = gridMaterial.getMaterialByAbsolutePos (coord8);
+
+  FPValue material = Approximation::approximateMaterial (Approximation::getMaterial (material1, typeOfMaterial),
+                                                         Approximation::getMaterial (material2, typeOfMaterial),
+                                                         Approximation::getMaterial (material3, typeOfMaterial),
+                                                         Approximation::getMaterial (material4, typeOfMaterial),
+                                                         Approximation::getMaterial (material5, typeOfMaterial),
+                                                         Approximation::getMaterial (material6, typeOfMaterial),
+                                                         Approximation::getMaterial (material7, typeOfMaterial),
+                                                         Approximation::getMaterial (material8, typeOfMaterial));
 
   Approximation::approximateDrudeModel (omega,
                                         gamma,
-                                        Approximation::getMaterial (val1),
-                                        Approximation::getMaterial (val2),
-                                        Approximation::getMaterial (val3),
-                                        Approximation::getMaterial (val4),
-                                        Approximation::getMaterial (val5),
-                                        Approximation::getMaterial (val6),
-                                        Approximation::getMaterial (val7),
-                                        Approximation::getMaterial (val8),
-                                        Approximation::getMaterial (val9),
-                                        Approximation::getMaterial (val10),
-                                        Approximation::getMaterial (val11),
-                                        Approximation::getMaterial (val12),
-                                        Approximation::getMaterial (val13),
-                                        Approximation::getMaterial (val14),
-                                        Approximation::getMaterial (val15),
-                                        Approximation::getMaterial (val16),
-                                        Approximation::getMaterial (val17),
-                                        Approximation::getMaterial (val18),
-                                        Approximation::getMaterial (val19),
-                                        Approximation::getMaterial (val20),
-                                        Approximation::getMaterial (val21),
-                                        Approximation::getMaterial (val22),
-                                        Approximation::getMaterial (val23),
-                                        Approximation::getMaterial (val24));
+                                        Approximation::getMaterial (material1, typeOfMaterial),
+                                        Approximation::getMaterial (material2, typeOfMaterial),
+                                        Approximation::getMaterial (material3, typeOfMaterial),
+                                        Approximation::getMaterial (material4, typeOfMaterial),
+                                        Approximation::getMaterial (material5, typeOfMaterial),
+                                        Approximation::getMaterial (material6, typeOfMaterial),
+                                        Approximation::getMaterial (material7, typeOfMaterial),
+                                        Approximation::getMaterial (material8, typeOfMaterial),
+                                        Approximation::getMaterial (material1, typeOfMaterialOmega),
+                                        Approximation::getMaterial (material2, typeOfMaterialOmega),
+                                        Approximation::getMaterial (material3, typeOfMaterialOmega),
+                                        Approximation::getMaterial (material4, typeOfMaterialOmega),
+                                        Approximation::getMaterial (material5, typeOfMaterialOmega),
+                                        Approximation::getMaterial (material6, typeOfMaterialOmega),
+                                        Approximation::getMaterial (material7, typeOfMaterialOmega),
+                                        Approximation::getMaterial (material8, typeOfMaterialOmega),
+                                        Approximation::getMaterial (material1, typeOfMaterialGamma),
+                                        Approximation::getMaterial (material2, typeOfMaterialGamma),
+                                        Approximation::getMaterial (material3, typeOfMaterialGamma),
+                                        Approximation::getMaterial (material4, typeOfMaterialGamma),
+                                        Approximation::getMaterial (material5, typeOfMaterialGamma),
+                                        Approximation::getMaterial (material6, typeOfMaterialGamma),
+                                        Approximation::getMaterial (material7, typeOfMaterialGamma),
+                                        Approximation::getMaterial (material8, typeOfMaterialGamma));
 
   return material;
 }
 
-template <class TCoord>
+template <class TMaterialGrid>
 FPValue
 YeeGridLayout::getMetaMaterial (GridCoordinate3D &posAbs,
                                 GridType typeOfField,
-                                Grid<TCoord> &gridMaterial,
+                                TMaterialGrid &gridMaterial,
                                 GridType typeOfMaterial,
-                                Grid<TCoord> &gridMaterialOmega,
                                 GridType typeOfMaterialOmega,
-                                Grid<TCoord> &gridMaterialGamma,
                                 GridType typeOfMaterialGamma,
                                 FPValue &omega,
                                 FPValue &gamma)
@@ -964,7 +955,7 @@ YeeGridLayout::getMetaMaterial (GridCoordinate3D &posAbs,
       case GridType::EZ:
       case GridType::DZ:
       {
-        return getApproximateMetaMaterial (gridMaterial, gridMaterialOmega, gridMaterialGamma, absPos11, absPos12, absPos21, absPos22, absPos31, absPos32, absPos41, absPos42, omega, gamma);
+        return getApproximateMetaMaterial (gridMaterial, typeOfMaterial, typeOfMaterialOmega, typeOfMaterialGamma, absPos11, absPos12, absPos21, absPos22, absPos31, absPos32, absPos41, absPos42, omega, gamma);
       }
       default:
       {
@@ -983,7 +974,7 @@ YeeGridLayout::getMetaMaterial (GridCoordinate3D &posAbs,
       case GridType::EZ:
       case GridType::DZ:
       {
-        return getApproximateMetaMaterial (gridMaterial, gridMaterialOmega, gridMaterialGamma, absPos11, absPos12, omega, gamma);
+        return getApproximateMetaMaterial (gridMaterial, typeOfMaterial, typeOfMaterialOmega, typeOfMaterialGamma, absPos11, absPos12, omega, gamma);
       }
       case GridType::HX:
       case GridType::BX:
@@ -992,7 +983,7 @@ YeeGridLayout::getMetaMaterial (GridCoordinate3D &posAbs,
       case GridType::HZ:
       case GridType::BZ:
       {
-        return getApproximateMetaMaterial (gridMaterial, gridMaterialOmega, gridMaterialGamma, absPos11, absPos12, absPos21, absPos22, omega, gamma);
+        return getApproximateMetaMaterial (gridMaterial, typeOfMaterial, typeOfMaterialOmega, typeOfMaterialGamma, absPos11, absPos12, absPos21, absPos22, omega, gamma);
       }
       default:
       {
@@ -1002,11 +993,11 @@ YeeGridLayout::getMetaMaterial (GridCoordinate3D &posAbs,
   }
 }
 
-template <class TCoord>
+template <class TMaterialGrid>
 FPValue
 YeeGridLayout::getMaterial (GridCoordinate3D &posAbs,
                             GridType typeOfField,
-                            Grid<TCoord> &gridMaterial,
+                            TMaterialGrid &gridMaterial,
                             GridType typeOfMaterial)
 {
   GridCoordinate3D absPos11;
@@ -1224,7 +1215,7 @@ YeeGridLayout::getMaterial (GridCoordinate3D &posAbs,
       case GridType::EZ:
       case GridType::DZ:
       {
-        return getApproximateMaterial (gridMaterial, absPos11, absPos12, absPos21, absPos22, absPos31, absPos32, absPos41, absPos42);
+        return getApproximateMaterial (gridMaterial, typeOfMaterial, absPos11, absPos12, absPos21, absPos22, absPos31, absPos32, absPos41, absPos42);
       }
       default:
       {
@@ -1243,7 +1234,7 @@ YeeGridLayout::getMaterial (GridCoordinate3D &posAbs,
       case GridType::EZ:
       case GridType::DZ:
       {
-        return getApproximateMaterial (gridMaterial, absPos11, absPos12);
+        return getApproximateMaterial (gridMaterial, typeOfMaterial, absPos11, absPos12);
       }
       case GridType::HX:
       case GridType::BX:
@@ -1252,7 +1243,7 @@ YeeGridLayout::getMaterial (GridCoordinate3D &posAbs,
       case GridType::HZ:
       case GridType::BZ:
       {
-        return getApproximateMaterial (gridMaterial, absPos11, absPos12, absPos21, absPos22);
+        return getApproximateMaterial (gridMaterial, typeOfMaterial, absPos11, absPos12, absPos21, absPos22);
       }
       default:
       {
@@ -4,6 +4,7 @@
 #include "DATLoader.h"
 #include "TXTDumper.h"
 #include "Kernels.h"
+#include "SIMDKernels.h"
 #include "Scheme3D.h"
 #include "Approximation.h"
 
@@ -11,6 +12,7 @@
 #include <mpi.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
 
 #if defined (CUDA_ENABLED)
@@ -21,6 +23,26 @@
 
 #define DO_USE_3D_MODE (true)
 
+/**
+ * Number of time steps, during which costs of tiles are measured before tiles are balanced
+ */
+#define TILE_BALANCE_STEPS (2)
+
+/**
+ * Number of times tiles are balanced, each next balance refines borders of tiles of the previous one
+ */
+#define TILE_BALANCE_ROUNDS (3)
+
+/**
+ * Order of polynomial grading of conductivity of CPML
+ */
+#define CPML_GRADING_ORDER (3)
+
+/**
+ * Theoretical reflection of CPML at normal incidence, which defines maximum conductivity of CPML
+ */
+#define CPML_REFLECTION (1e-3)
+
 void
 Scheme3D::performPlaneWaveESteps (time_step t)
 {
@@ -28,27 +50,21 @@ Scheme3D::performPlaneWaveESteps (time_step t)
   {
     GridCoordinate1D pos (i);
 
-    FieldPointValue *valE = EInc.getFieldPointValue (pos);
-
     GridCoordinate1D posLeft (i - 1);
     GridCoordinate1D posRight (i);
 
-    FieldPointValue *valH1 = HInc.getFieldPointValue (posLeft);
-    FieldPointValue *valH2 = HInc.getFieldPointValue (posRight);
-
-    FieldValue val = valE->getPrevValue () + (gridTimeStep / (relPhaseVelocity * PhysicsConst::Eps0 * gridStep)) * (valH1->getPrevValue () - valH2->getPrevValue ());
+    FieldValue val = *EInc.getFieldValue (pos, 1) + (gridTimeStep / (relPhaseVelocity * PhysicsConst::Eps0 * gridStep)) * (*HInc.getFieldValue (posLeft, 1) - *HInc.getFieldValue (posRight, 1));
 
-    valE->setCurValue (val);
+    EInc.setFieldValue (val, pos, 0);
   }
 
   GridCoordinate1D pos (0);
-  FieldPointValue *valE = EInc.getFieldPointValue (pos);
 
 #ifdef COMPLEX_FIELD_VALUES
-  valE->setCurValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
-                                 cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)));
+  EInc.setFieldValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
+                                  cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)), pos, 0);
 #else /* COMPLEX_FIELD_VALUES */
-  valE->setCurValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency));
+  EInc.setFieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency), pos, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
   /*
@@ -65,22 +81,117 @@ Scheme3D::performPlaneWaveHSteps (time_step t)
   {
     GridCoordinate1D pos (i);
 
-    FieldPointValue *valH = HInc.getFieldPointValue (pos);
-
     GridCoordinate1D posLeft (i);
     GridCoordinate1D posRight (i + 1);
 
-    FieldPointValue *valE1 = EInc.getFieldPointValue (posLeft);
-    FieldPointValue *valE2 = EInc.getFieldPointValue (posRight);
-
-    FieldValue val = valH->getPrevValue () + (gridTimeStep / (relPhaseVelocity * PhysicsConst::Mu0 * gridStep)) * (valE1->getPrevValue () - valE2->getPrevValue ());
+    FieldValue val = *HInc.getFieldValue (pos, 1) + (gridTimeStep / (relPhaseVelocity * PhysicsConst::Mu0 * gridStep)) * (*EInc.getFieldValue (posLeft, 1) - *EInc.getFieldValue (posRight, 1));
 
-    valH->setCurValue (val);
+    HInc.setFieldValue (val, pos, 0);
   }
 
   HInc.nextTimeStep ();
 }
 
+/**
+ * Number of parts of range, which is split by box (see splitRange)
+ */
+#define RANGE_PARTS (7)
+
+/**
+ * Split range to box, which is clipped by range, and six slabs around it. Slabs by Ox axis cover the whole range by Oy
+ * and Oz axes, slabs by Oy axis cover the whole range by Oz axis. Slabs are stored first and box is the last part,
+ * parts may be empty. Each part of subrange is contained in the same part of range, so ranges of tiles and chunks of
+ * parallel grid are split consistently with the whole range of computations.
+ */
+static void
+splitRange (GridCoordinate3D start, /**< start of range */
+            GridCoordinate3D end, /**< end of range */
+            GridCoordinate3D boxStart, /**< start of box */
+            GridCoordinate3D boxEnd, /**< end of box */
+            GridCoordinate3D *partStarts, /**< out: starts of RANGE_PARTS parts */
+            GridCoordinate3D *partEnds) /**< out: ends of RANGE_PARTS parts */
+{
+  GridCoordinate3D clippedStart (std::min (std::max (boxStart.getX (), start.getX ()), end.getX ()),
+                                 std::min (std::max (boxStart.getY (), start.getY ()), end.getY ()),
+                                 std::min (std::max (boxStart.getZ (), start.getZ ()), end.getZ ()));
+  GridCoordinate3D clippedEnd (std::max (std::min (boxEnd.getX (), end.getX ()), clippedStart.getX ()),
+                               std::max (std::min (boxEnd.getY (), end.getY ()), clippedStart.getY ()),
+                               std::max (std::min (boxEnd.getZ (), end.getZ ()), clippedStart.getZ ()));
+
+  partStarts[0] = start;
+  partEnds[0] = GridCoordinate3D (clippedStart.getX (), end.getY (), end.getZ ());
+  partStarts[1] = GridCoordinate3D (clippedEnd.getX (), start.getY (), start.getZ ());
+  partEnds[1] = end;
+
+  partStarts[2] = GridCoordinate3D (clippedStart.getX (), start.getY (), start.getZ ());
+  partEnds[2] = GridCoordinate3D (clippedEnd.getX (), clippedStart.getY (), end.getZ ());
+  partStarts[3] = GridCoordinate3D (clippedStart.getX (), clippedEnd.getY (), start.getZ ());
+  partEnds[3] = GridCoordinate3D (clippedEnd.getX (), end.getY (), end.getZ ());
+
+  partStarts[4] = GridCoordinate3D (clippedStart.getX (), clippedStart.getY (), start.getZ ());
+  partEnds[4] = GridCoordinate3D (clippedEnd.getX (), clippedEnd.getY (), clippedStart.getZ ());
+  partStarts[5] = GridCoordinate3D (clippedStart.getX (), clippedStart.getY (), clippedEnd.getZ ());
+  partEnds[5] = GridCoordinate3D (clippedEnd.getX (), clippedEnd.getY (), end.getZ ());
+
+  partStarts[6] = clippedStart;
+  partEnds[6] = clippedEnd;
+} /* splitRange */
+
+/**
+ * Check whether range is empty
+ *
+ * @return true if range contains no positions
+ */
+static bool
+isEmptyRange (GridCoordinate3D start, /**< start of range */
+              GridCoordinate3D end) /**< end of range */
+{
+  return start.getX () >= end.getX () || start.getY () >= end.getY () || start.getZ () >= end.getZ ();
+} /* isEmptyRange */
+
+/**
+ * Update field component in range, which is split to box and six slabs around it (see splitRange). Box and slabs are
+ * updated by different updates, e.g. box of zero conductivity of PML is updated by plain update and slabs are updated
+ * by PML (or CPML) update. For zero conductivity both updates are equivalent (up to rounding), but plain update
+ * performs neither the second phase of PML update nor recursive convolutions of CPML.
+ */
+void
+Scheme3D::performSplitSteps (time_step t, /**< time step */
+                             GridCoordinate3D start, /**< start of range */
+                             GridCoordinate3D end, /**< end of range */
+                             GridCoordinate3D boxStart, /**< start of box */
+                             GridCoordinate3D boxEnd, /**< end of box */
+                             StepFunction step, /**< update of box */
+                             StepFunction stepSlabs) /**< update of slabs */
+{
+  GridCoordinate3D partStarts[RANGE_PARTS];
+  GridCoordinate3D partEnds[RANGE_PARTS];
+
+  splitRange (start, end, boxStart, boxEnd, partStarts, partEnds);
+
+  for (int i = 0; i < RANGE_PARTS; ++i)
+  {
+    if (isEmptyRange (partStarts[i], partEnds[i]))
+    {
+      continue;
+    }
+
+    (this->*(i == RANGE_PARTS - 1 ? step : stepSlabs)) (t, partStarts[i], partEnds[i]);
+  }
+} /* Scheme3D::performSplitSteps */
+
+/**
+ * Update Ex in box of zero conductivity of PML. Drude model is applied only by PML update, so it is used in box of
+ * cells of Drude model and plain update is used around it.
+ */
+void
+Scheme3D::performExDrudeSteps (time_step t, GridCoordinate3D ExStart, GridCoordinate3D ExEnd)
+{
+  performSplitSteps (t, ExStart, ExEnd, DxBoxes.drudeStart, DxBoxes.drudeEnd,
+                     &Scheme3D::calculateExStepPML,
+                     &Scheme3D::calculateExStep);
+} /* Scheme3D::performExDrudeSteps */
+
 void
 Scheme3D::performExSteps (time_step t, GridCoordinate3D ExStart, GridCoordinate3D ExEnd)
 {
@@ -89,37 +200,57 @@ Scheme3D::performExSteps (time_step t, GridCoordinate3D ExStart, GridCoordinate3
    */
   if (usePML)
   {
-    calculateExStepPML (t, ExStart, ExEnd);
+    performSplitSteps (t, ExStart, ExEnd,
+                       GridCoordinate3D (ExProfileX.interiorStart, ExProfileY.interiorStart, ExProfileZ.interiorStart),
+                       GridCoordinate3D (ExProfileX.interiorEnd, ExProfileY.interiorEnd, ExProfileZ.interiorEnd),
+                       useMetamaterials ? &Scheme3D::performExDrudeSteps : &Scheme3D::calculateExStep,
+                       useCPML ? &Scheme3D::calculateExStepCPML : &Scheme3D::calculateExStepPML);
   }
   else
   {
     calculateExStep (t, ExStart, ExEnd);
   }
+
+  /*
+   * Updates above do not take TF/SF into account, corrections are applied only to cells on border of TF/SF area
+   */
+  if (useTFSF)
+  {
+    calculateExTFSF (ExStart, ExEnd);
+  }
 }
 
-FieldValue
-Scheme3D::approximateIncidentWave (GridCoordinateFP3D realCoord, FPValue dDiff, Grid<GridCoordinate1D> &FieldInc)
+/**
+ * Find two neighbouring values of incident wave and their weights for linear interpolation at real coordinate
+ *
+ * @return interpolation of incident wave
+ */
+IncidentWaveInterpolation
+Scheme3D::initIncidentWaveInterpolation (GridCoordinateFP3D realCoord, /**< real coordinate */
+                                         FPValue dDiff) /**< shift of incident wave along its direction */
 {
   GridCoordinateFP3D zeroCoordFP = yeeLayout->getZeroIncCoordFP ();
 
   FPValue x = realCoord.getX () - zeroCoordFP.getX ();
   FPValue y = realCoord.getY () - zeroCoordFP.getY ();
   FPValue z = realCoord.getZ () - zeroCoordFP.getZ ();
-  FPValue d = x * sin (yeeLayout->getIncidentWaveAngle1 ()) * cos (yeeLayout->getIncidentWaveAngle2 ())
-              + y * sin (yeeLayout->getIncidentWaveAngle1 ()) * sin (yeeLayout->getIncidentWaveAngle2 ())
-              + z * cos (yeeLayout->getIncidentWaveAngle1 ()) - dDiff;
+  FPValue d = x * incidentWaveSin1 * incidentWaveCos2
+              + y * incidentWaveSin1 * incidentWaveSin2
+              + z * incidentWaveCos1 - dDiff;
   FPValue coordD1 = (FPValue) ((grid_iter) d);
-  FPValue coordD2 = coordD1 + 1;
-  FPValue proportionD2 = d - coordD1;
-  FPValue proportionD1 = 1 - proportionD2;
 
-  GridCoordinate1D pos1 (coordD1);
-  GridCoordinate1D pos2 (coordD2);
+  IncidentWaveInterpolation interpolation;
+  interpolation.index = (grid_coord) coordD1;
+  interpolation.weight2 = d - coordD1;
+  interpolation.weight1 = 1 - interpolation.weight2;
 
-  FieldPointValue *val1 = FieldInc.getFieldPointValue (pos1);
-  FieldPointValue *val2 = FieldInc.getFieldPointValue (pos2);
+  return interpolation;
+} /* Scheme3D::initIncidentWaveInterpolation */
 
-  return proportionD1 * val1->getPrevValue () + proportionD2 * val2->getPrevValue ();
+FieldValue
+Scheme3D::approximateIncidentWave (GridCoordinateFP3D realCoord, FPValue dDiff, Grid<GridCoordinate1D> &FieldInc)
+{
+  return initIncidentWaveInterpolation (realCoord, dDiff).approximate (FieldInc.getView (1));
 }
 
 FieldValue
@@ -134,235 +265,558 @@ Scheme3D::approximateIncidentWaveH (GridCoordinateFP3D realCoord)
   return approximateIncidentWave (realCoord, 0.5, HInc);
 }
 
-void
-Scheme3D::calculateExTFSF (GridCoordinate3D posAbs,
-                           FieldValue &valHz1,
-                           FieldValue &valHz2,
-                           FieldValue &valHy1,
-                           FieldValue &valHy2,
-                           GridCoordinate3D posDown,
-                           GridCoordinate3D posUp,
-                           GridCoordinate3D posBack,
-                           GridCoordinate3D posFront)
+/**
+ * Check that cell on border of TF/SF area is placed before x coordinate
+ *
+ * @return true if x coordinate of cell is less than x coordinate
+ */
+static bool
+isTFSFCellBefore (const TFSFCell &cell, /**< cell on border of TF/SF area */
+                  grid_coord x) /**< x coordinate */
+{
+  return cell.pos.getX () < x;
+} /* isTFSFCellBefore */
+
+/**
+ * Find the first cell on border of TF/SF area, x coordinate of which is not less than x coordinate. Cells are added
+ * by rows along Oz axis (see Scheme3D::initTFSFBorder), so they are ordered by x coordinate and cells of slab of range
+ * by Ox axis are placed contiguously.
+ *
+ * @return iterator of the first cell of slab
+ */
+static std::vector<TFSFCell>::const_iterator
+findTFSFCell (const std::vector<TFSFCell> &cells, /**< cells on border of TF/SF area */
+              grid_coord x) /**< x coordinate of start of slab */
 {
-  bool do_need_update_down = yeeLayout->doNeedTFSFUpdateExBorder (posAbs, LayoutDirection::DOWN, DO_USE_3D_MODE);
-  bool do_need_update_up = yeeLayout->doNeedTFSFUpdateExBorder (posAbs, LayoutDirection::UP, DO_USE_3D_MODE);
+  return std::lower_bound (cells.begin (), cells.end (), x, isTFSFCellBefore);
+} /* findTFSFCell */
 
-  bool do_need_update_back = yeeLayout->doNeedTFSFUpdateExBorder (posAbs, LayoutDirection::BACK, DO_USE_3D_MODE);
-  bool do_need_update_front = yeeLayout->doNeedTFSFUpdateExBorder (posAbs, LayoutDirection::FRONT, DO_USE_3D_MODE);
+void
+Scheme3D::calculateExTFSF (GridCoordinate3D ExStart, GridCoordinate3D ExEnd)
+{
+  GridView<GridCoordinate3D> ExCur = Ex.getView (0);
 
-  GridCoordinate3D auxPosY;
-  GridCoordinate3D auxPosZ;
-  FieldValue diffY;
-  FieldValue diffZ;
+  GridView<GridCoordinate1D> HIncPrev = HInc.getView (1);
 
-  if (do_need_update_down)
-  {
-    auxPosY = posUp;
-  }
-  else if (do_need_update_up)
+  for (std::vector<TFSFCell>::const_iterator it = findTFSFCell (ExTFSFCells, ExStart.getX ());
+       it != ExTFSFCells.end () && it->pos.getX () < ExEnd.getX ();
+       ++it)
   {
-    auxPosY = posDown;
-  }
+    GridCoordinate3D pos = it->pos;
 
-  if (do_need_update_back)
-  {
-    auxPosZ = posFront;
-  }
-  else if (do_need_update_front)
-  {
-    auxPosZ = posBack;
-  }
+    if (!(pos >= ExStart && pos < ExEnd))
+    {
+      continue;
+    }
 
-  if (do_need_update_down || do_need_update_up)
-  {
-    GridCoordinateFP3D realCoord = yeeLayout->getHzCoordFP (Hz.getTotalPosition (auxPosY));
+    grid_coord i = pos.getX ();
+    grid_coord j = pos.getY ();
+    grid_coord k = pos.getZ ();
 
-    diffY = yeeLayout->getHzFromIncidentH (approximateIncidentWaveH (realCoord));
-  }
+    FieldValue diffHz (0);
+    FieldValue diffHy (0);
 
-  if (do_need_update_back || do_need_update_front)
-  {
-    GridCoordinateFP3D realCoord = yeeLayout->getHyCoordFP (Hy.getTotalPosition (auxPosZ));
+    if (it->factor1 != 0)
+    {
+      diffHz = it->factor1 * it->incident1.approximate (HIncPrev);
+    }
 
-    diffZ = yeeLayout->getHyFromIncidentH (approximateIncidentWaveH (realCoord));
-  }
+    if (it->factor2 != 0)
+    {
+      diffHy = it->factor2 * it->incident2.approximate (HIncPrev);
+    }
 
-  if (do_need_update_down)
-  {
-    valHz1 -= diffY;
+    /*
+     * Cell is updated by calculateExStepPML if it is in box of Dx
+     */
+    const PMLBox *box = DxBoxes.find (pos, pos + GridCoordinate3D (1, 1, 1));
+
+    if (box != NULLPTR)
+    {
+      GridCoordinate3D posD = pos - box->origin;
+
+      FieldValue valDx = ExProfileY.Cb[j] * (diffHz - diffHy);
+
+      *box->D->getFieldValue (posD, 0) += valDx;
+
+      FPValue modifier = 1;
+      if (useMetamaterials)
+      {
+        valDx = ExDrude.get (pos).b0 * valDx;
+
+        *box->D1->getFieldValue (posD, 0) += valDx;
+      }
+      else
+      {
+        modifier = ExMaterial.get (pos);
+      }
+
+      ExCur[pos] += ExProfileX.sum[i] * ExProfileZ.inverseSum[k] / modifier * valDx;
+    }
+    else
+    {
+      if (useCPML)
+      {
+        FieldValue *psiY = ExPsiY.getValue (pos);
+        if (psiY != NULLPTR)
+        {
+          FieldValue valPsi = ExProfileY.c[j] * diffHz;
+
+          *psiY += valPsi;
+          diffHz += valPsi;
+        }
+
+        FieldValue *psiZ = ExPsiZ.getValue (pos);
+        if (psiZ != NULLPTR)
+        {
+          FieldValue valPsi = ExProfileZ.c[k] * diffHy;
+
+          *psiZ += valPsi;
+          diffHy += valPsi;
+        }
+      }
+
+      ExCur[pos] += gridTimeStep / (ExMaterial.get (pos) * gridStep) * (diffHz - diffHy);
+    }
   }
-  else if (do_need_update_up)
+}
+
+/**
+ * Get floating point values of row along Oz axis in plane of storage, which starts at position (see
+ * GridView::getPlaneValues)
+ *
+ * @return pointer to the first floating point value
+ */
+static FPValue *
+getRowValues (const GridView<GridCoordinate3D> &view, /**< view of grid */
+              const GridCoordinate3D &pos, /**< relative position of the first value of row */
+              int plane) /**< number of plane */
+{
+  return view.getPlaneValues (pos, plane);
+} /* getRowValues */
+
+/**
+ * Get floating point values of part of row along Oz axis, which are only read by row kernel. Values are taken from grid
+ * if they are stored contiguously, otherwise (in block layout, when part of row crosses border of blocks because of
+ * offset of difference along Oz axis) they are copied to buffer
+ *
+ * @return pointer to the first floating point value
+ */
+static const FPValue *
+getRowValuesForRead (const GridView<GridCoordinate3D> &view, /**< view of grid */
+                     const GridCoordinate3D &pos, /**< relative position of the first value of part of row */
+                     grid_iter count, /**< number of values */
+                     int plane, /**< number of plane */
+                     std::vector<FPValue> &buffer) /**< buffer for copy of values */
+{
+  if (view.getContiguousCount (pos) >= count)
   {
-    valHz2 -= diffY;
+    return getRowValues (view, pos, plane);
   }
 
-  if (do_need_update_back)
+  if (buffer.size () < count * FPVALUES_PER_FIELD_VALUE)
   {
-    valHy1 -= diffZ;
+    buffer.resize (count * FPVALUES_PER_FIELD_VALUE);
   }
-  else if (do_need_update_front)
+
+  /*
+   * Values are copied by contiguous parts, i.e. by parts inside blocks
+   */
+  grid_iter copied = 0;
+
+  while (copied < count)
   {
-    valHy2 -= diffZ;
+    GridCoordinate3D partPos = pos + GridCoordinate3D (0, 0, copied);
+    grid_iter partCount = std::min (count - copied, view.getContiguousCount (partPos));
+    const FPValue *values = getRowValues (view, partPos, plane);
+
+    std::copy (values, values + partCount * FPVALUES_PER_FIELD_VALUE, &buffer[copied * FPVALUES_PER_FIELD_VALUE]);
+
+    copied += partCount;
   }
-}
 
+  return &buffer[0];
+} /* getRowValuesForRead */
+
+/**
+ * Update field component without PML by rows along Oz axis. Each row is updated by parts, which are stored
+ * contiguously (see GridView::getContiguousCount), i.e. by whole rows in row-major layout and by parts of rows inside
+ * blocks in block layout. Coefficients of curl are gathered for each part and part is updated by row kernel (see
+ * SIMDKernels.h). Planes of real and imaginary parts of split complex values (see SPLIT_COMPLEX_FIELD_VALUES) are
+ * updated by row kernel one after another as two streams of real values.
+ */
 void
-Scheme3D::calculateExStep (time_step t, GridCoordinate3D ExStart, GridCoordinate3D ExEnd)
+Scheme3D::calculateStepRows (FieldGrid &field, /**< grid of field component */
+                             FieldGrid &grid1, /**< grid of the first difference */
+                             GridCoordinate3D diff11, /**< offset of the first difference with higher coordinate */
+                             GridCoordinate3D diff12, /**< offset of the first difference with lower coordinate */
+                             FieldGrid &grid2, /**< grid of the second difference */
+                             GridCoordinate3D diff21, /**< offset of the second difference with higher coordinate */
+                             GridCoordinate3D diff22, /**< offset of the second difference with lower coordinate */
+                             const MaterialTable<FPValue> &material, /**< effective material of field component */
+                             const std::vector<FPValue> &curlCoefficients, /**< coefficients of curl */
+                             GridCoordinate3D start, /**< start of computations */
+                             GridCoordinate3D end) /**< end of computations */
 {
-  FPValue eps0 = PhysicsConst::Eps0;
-
-  for (int i = ExStart.getX (); i < ExEnd.getX (); ++i)
+  if (end.getZ () <= start.getZ ())
   {
-    for (int j = ExStart.getY (); j < ExEnd.getY (); ++j)
-    {
-      for (int k = ExStart.getZ (); k < ExEnd.getZ (); ++k)
-      {
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Ex.getTotalPosition (pos);
-
-        FieldPointValue* valEx = Ex.getFieldPointValue (pos);
-
-        FPValue eps = yeeLayout->getMaterial (posAbs, GridType::EX, Eps, GridType::EPS);
+    return;
+  }
 
-        GridCoordinate3D posDown = yeeLayout->getExCircuitElement (pos, LayoutDirection::DOWN);
-        GridCoordinate3D posUp = yeeLayout->getExCircuitElement (pos, LayoutDirection::UP);
-        GridCoordinate3D posBack = yeeLayout->getExCircuitElement (pos, LayoutDirection::BACK);
-        GridCoordinate3D posFront = yeeLayout->getExCircuitElement (pos, LayoutDirection::FRONT);
+  GridView<GridCoordinate3D> cur = field.getView (0);
+  GridView<GridCoordinate3D> prev = field.getView (1);
+  GridView<GridCoordinate3D> prev1 = grid1.getView (1);
+  GridView<GridCoordinate3D> prev2 = grid2.getView (1);
 
-        FieldPointValue* valHz1 = Hz.getFieldPointValue (posUp);
-        FieldPointValue* valHz2 = Hz.getFieldPointValue (posDown);
+  const SIMDKernelTable &kernels = SIMDKernels::get ();
 
-        FieldPointValue* valHy1 = Hy.getFieldPointValue (posFront);
-        FieldPointValue* valHy2 = Hy.getFieldPointValue (posBack);
+  grid_iter rowSize = end.getZ () - start.getZ ();
 
-        FieldValue prevHz1 = valHz1->getPrevValue ();
-        FieldValue prevHz2 = valHz2->getPrevValue ();
+  /*
+   * Rows are distributed between threads, each thread gathers coefficients of its rows in its own buffers
+   */
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel
+#endif /* OPENMP_ENABLED */
+  {
+    std::vector<FPValue> Cb (rowSize);
+    std::vector<FPValue> buffers[4];
 
-        FieldValue prevHy1 = valHy1->getPrevValue ();
-        FieldValue prevHy2 = valHy2->getPrevValue ();
+#ifdef OPENMP_ENABLED
+    #pragma omp for collapse (2)
+#endif /* OPENMP_ENABLED */
+    for (grid_coord i = start.getX (); i < end.getX (); ++i)
+    {
+      for (grid_coord j = start.getY (); j < end.getY (); ++j)
+      {
+        grid_coord k = start.getZ ();
 
-        if (useTFSF)
+        while (k < end.getZ ())
         {
-          calculateExTFSF (posAbs, prevHz1, prevHz2, prevHy1, prevHy2, posDown, posUp, posBack, posFront);
-        }
+          GridCoordinate3D pos (i, j, k);
+          grid_iter count = std::min ((grid_iter) (end.getZ () - k), cur.getContiguousCount (pos));
 
-        FieldValue val = calculateEx_3D (valEx->getPrevValue (),
-                                         prevHz1,
-                                         prevHz2,
-                                         prevHy1,
-                                         prevHy2,
-                                         gridTimeStep,
-                                         gridStep,
-                                         eps * eps0);
+          material.gather (curlCoefficients, pos, count, &Cb[0]);
+
+          for (int plane = 0; plane < GRID_PLANES_COUNT; ++plane)
+          {
+            kernels.calculateCurlLossless (getRowValues (cur, pos, plane),
+                                           getRowValues (prev, pos, plane),
+                                           getRowValuesForRead (prev1, pos + diff11, count, plane, buffers[0]),
+                                           getRowValuesForRead (prev1, pos + diff12, count, plane, buffers[1]),
+                                           getRowValuesForRead (prev2, pos + diff21, count, plane, buffers[2]),
+                                           getRowValuesForRead (prev2, pos + diff22, count, plane, buffers[3]),
+                                           &Cb[0],
+                                           count);
+          }
 
-        valEx->setCurValue (val);
+          k += count;
+        }
       }
     }
   }
-}
+} /* Scheme3D::calculateStepRows */
 
+/**
+ * Update field component with PML by rows along Oz axis, which are updated by parts as in calculateStepRows. D (B),
+ * D1 (B1) and field component are updated one after another for each part of row, while it is in cache, and for each
+ * plane of split complex values.
+ */
 void
-Scheme3D::calculateExStepPML (time_step t, GridCoordinate3D ExStart, GridCoordinate3D ExEnd)
+Scheme3D::calculateStepPMLRows (GridType typeOfField, /**< type of field component (EX, ..., HZ) */
+                                FieldGrid &field, /**< grid of field component */
+                                const PMLBoxes &boxes, /**< D and D1 (B and B1) of field component */
+                                FieldGrid &grid1, /**< grid of the first difference */
+                                GridCoordinate3D diff11, /**< offset of the first difference with higher coordinate */
+                                GridCoordinate3D diff12, /**< offset of the first difference with lower coordinate */
+                                FieldGrid &grid2, /**< grid of the second difference */
+                                GridCoordinate3D diff21, /**< offset of the second difference with higher coordinate */
+                                GridCoordinate3D diff22, /**< offset of the second difference with lower coordinate */
+                                GridCoordinate3D start, /**< start of computations */
+                                GridCoordinate3D end) /**< end of computations */
 {
-  FPValue eps0 = PhysicsConst::Eps0;
-
-  for (int i = ExStart.getX (); i < ExEnd.getX (); ++i)
+  if (end.getZ () <= start.getZ ())
   {
-    for (int j = ExStart.getY (); j < ExEnd.getY (); ++j)
-    {
-      for (int k = ExStart.getZ (); k < ExEnd.getZ (); ++k)
-      {
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Dx.getTotalPosition (pos);
-
-        FieldPointValue* valDx = Dx.getFieldPointValue (pos);
+    return;
+  }
 
-        FPValue sigmaY = yeeLayout->getMaterial (posAbs, GridType::DX, SigmaY, GridType::SIGMAY);
+  const MaterialTable<FPValue> *material = NULLPTR;
+  const MaterialTable<DrudeCoefficients> *drude = NULLPTR;
+  const PMLProfile *profiles[3] = {NULLPTR, NULLPTR, NULLPTR};
 
-        GridCoordinate3D posDown = yeeLayout->getExCircuitElement (pos, LayoutDirection::DOWN);
-        GridCoordinate3D posUp = yeeLayout->getExCircuitElement (pos, LayoutDirection::UP);
-        GridCoordinate3D posBack = yeeLayout->getExCircuitElement (pos, LayoutDirection::BACK);
-        GridCoordinate3D posFront = yeeLayout->getExCircuitElement (pos, LayoutDirection::FRONT);
+  /*
+   * Axis of field component, 0 for Ox, 1 for Oy and 2 for Oz
+   */
+  int axis = 0;
 
-        FieldPointValue* valHz1 = Hz.getFieldPointValue (posUp);
-        FieldPointValue* valHz2 = Hz.getFieldPointValue (posDown);
+  switch (typeOfField)
+  {
+    case GridType::EX:
+    {
+      material = &ExMaterial;
+      drude = &ExDrude;
+      profiles[0] = &ExProfileX;
+      profiles[1] = &ExProfileY;
+      profiles[2] = &ExProfileZ;
+      axis = 0;
+      break;
+    }
+    case GridType::EY:
+    {
+      material = &EyMaterial;
+      drude = &EyDrude;
+      profiles[0] = &EyProfileX;
+      profiles[1] = &EyProfileY;
+      profiles[2] = &EyProfileZ;
+      axis = 1;
+      break;
+    }
+    case GridType::EZ:
+    {
+      material = &EzMaterial;
+      drude = &EzDrude;
+      profiles[0] = &EzProfileX;
+      profiles[1] = &EzProfileY;
+      profiles[2] = &EzProfileZ;
+      axis = 2;
+      break;
+    }
+    case GridType::HX:
+    {
+      material = &HxMaterial;
+      drude = &HxDrude;
+      profiles[0] = &HxProfileX;
+      profiles[1] = &HxProfileY;
+      profiles[2] = &HxProfileZ;
+      axis = 0;
+      break;
+    }
+    case GridType::HY:
+    {
+      material = &HyMaterial;
+      drude = &HyDrude;
+      profiles[0] = &HyProfileX;
+      profiles[1] = &HyProfileY;
+      profiles[2] = &HyProfileZ;
+      axis = 1;
+      break;
+    }
+    case GridType::HZ:
+    {
+      material = &HzMaterial;
+      drude = &HzDrude;
+      profiles[0] = &HzProfileX;
+      profiles[1] = &HzProfileY;
+      profiles[2] = &HzProfileZ;
+      axis = 2;
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
 
-        FieldPointValue* valHy1 = Hy.getFieldPointValue (posFront);
-        FieldPointValue* valHy2 = Hy.getFieldPointValue (posBack);
+  /*
+   * D is updated with PML along the next axis after axis of component, component is calculated from D with PML along
+   * its axis and the axis after next (e.g. Dx with PML along Oy, Ex with PML along Ox and Oz)
+   */
+  int axisD = (axis + 1) % 3;
+  int axisInverse = (axis + 2) % 3;
 
-        FieldValue prevHz1 = valHz1->getPrevValue ();
-        FieldValue prevHz2 = valHz2->getPrevValue ();
+  const PMLProfile &profileD = *profiles[axisD];
+  const PMLProfile &profileSum = *profiles[axis];
+  const PMLProfile &profileInverse = *profiles[axisInverse];
 
-        FieldValue prevHy1 = valHy1->getPrevValue ();
-        FieldValue prevHy2 = valHy2->getPrevValue ();
+  /*
+   * Range is contained in single box of D (see Scheme3D::performSplitSteps)
+   */
+  const PMLBox *box = boxes.find (start, end);
+  ASSERT (box != NULLPTR);
 
-        if (useTFSF)
-        {
-          calculateExTFSF (posAbs, prevHz1, prevHz2, prevHy1, prevHy2, posDown, posUp, posBack, posFront);
-        }
+  Grid<GridCoordinate3D> &D = *box->D;
+  Grid<GridCoordinate3D> &D1 = *box->D1;
 
-        /*
-         * FIXME: precalculate coefficients
-         */
-        FPValue k_y = 1;
+  GridView<GridCoordinate3D> cur = field.getView (0);
+  GridView<GridCoordinate3D> prev = field.getView (1);
+  GridView<GridCoordinate3D> DCur = D.getView (0);
+  GridView<GridCoordinate3D> DPrev = D.getView (1);
+  GridView<GridCoordinate3D> prev1 = grid1.getView (1);
+  GridView<GridCoordinate3D> prev2 = grid2.getView (1);
 
-        FPValue Ca = (2 * eps0 * k_y - sigmaY * gridTimeStep) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
-        FPValue Cb = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
+  /*
+   * D1 and the third time layer of D exist only for metamaterials, otherwise views of D are taken in their place
+   * and field component is calculated directly from D
+   */
+  GridView<GridCoordinate3D> DPrevPrev = useMetamaterials ? D.getView (2) : DPrev;
+  GridView<GridCoordinate3D> D1Cur = useMetamaterials ? D1.getView (0) : DCur;
+  GridView<GridCoordinate3D> D1Prev = useMetamaterials ? D1.getView (1) : DPrev;
+  GridView<GridCoordinate3D> D1PrevPrev = useMetamaterials ? D1.getView (2) : DPrev;
 
-        FieldValue val = calculateEx_3D_Precalc (valDx->getPrevValue (),
-                                                 prevHz1,
-                                                 prevHz2,
-                                                 prevHy1,
-                                                 prevHy2,
-                                                 Ca,
-                                                 Cb);
+  const SIMDKernelTable &kernels = SIMDKernels::get ();
 
-        valDx->setCurValue (val);
-      }
-    }
-  }
+  grid_iter rowSize = end.getZ () - start.getZ ();
 
-  if (useMetamaterials)
-  {
-    for (int i = ExStart.getX (); i < ExEnd.getX (); ++i)
+  /*
+   * Rows are distributed between threads, each thread gathers coefficients of its rows in its own buffers
+   */
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel
+#endif /* OPENMP_ENABLED */
+  {
+    std::vector<FPValue> CaD (rowSize);
+    std::vector<FPValue> CbD (rowSize);
+    std::vector<FPValue> Ca (rowSize);
+    std::vector<FPValue> Cb (rowSize);
+    std::vector<FPValue> Cc (rowSize);
+
+    std::vector<FPValue> b0 (useMetamaterials ? rowSize : 0);
+    std::vector<FPValue> b1 (useMetamaterials ? rowSize : 0);
+    std::vector<FPValue> b2 (useMetamaterials ? rowSize : 0);
+    std::vector<FPValue> a1 (useMetamaterials ? rowSize : 0);
+    std::vector<FPValue> a2 (useMetamaterials ? rowSize : 0);
+
+    std::vector<FPValue> buffers[4];
+
+#ifdef OPENMP_ENABLED
+    #pragma omp for collapse (2)
+#endif /* OPENMP_ENABLED */
+    for (grid_coord i = start.getX (); i < end.getX (); ++i)
     {
-      for (int j = ExStart.getY (); j < ExEnd.getY (); ++j)
+      for (grid_coord j = start.getY (); j < end.getY (); ++j)
       {
-        for (int k = ExStart.getZ (); k < ExEnd.getZ (); ++k)
+        grid_coord k = start.getZ ();
+
+        while (k < end.getZ ())
         {
           GridCoordinate3D pos (i, j, k);
-          GridCoordinate3D posAbs = Dx.getTotalPosition (pos);
-
-          FieldPointValue* valD1x = D1x.getFieldPointValue (pos);
-          FieldPointValue* valDx = Dx.getFieldPointValue (pos);
-
-          FPValue omegaPE;
-          FPValue gammaE;
-          FPValue eps = yeeLayout->getMetaMaterial (posAbs, GridType::DX, Eps, GridType::EPS, OmegaPE, GridType::OMEGAPE, GammaE, GridType::GAMMAE, omegaPE, gammaE);
+          GridCoordinate3D posD = pos - box->origin;
+          grid_iter count = std::min ((grid_iter) (end.getZ () - k), cur.getContiguousCount (pos));
 
           /*
-           * FIXME: precalculate coefficients
+           * Origin of box is aligned to blocks, so D is stored contiguously wherever field component is
            */
-          FPValue A = 4*eps0*eps + 2*gridTimeStep*eps0*eps*gammaE + eps0*gridTimeStep*gridTimeStep*omegaPE*omegaPE;
-
-          FieldValue val = calculateDrudeE (valDx->getCurValue (),
-                                            valDx->getPrevValue (),
-                                            valDx->getPrevPrevValue (),
-                                            valD1x->getPrevValue (),
-                                            valD1x->getPrevPrevValue (),
-                                            (4 + 2*gridTimeStep*gammaE) / A,
-                                            -8 / A,
-                                            (4 - 2*gridTimeStep*gammaE) / A,
-                                            (2*eps0*gridTimeStep*gridTimeStep*omegaPE*omegaPE - 8*eps0*eps) / A,
-                                            (4*eps0*eps - 2*gridTimeStep*eps0*eps*gammaE + eps0*gridTimeStep*gridTimeStep*omegaPE*omegaPE) / A);
-
-          valD1x->setCurValue (val);
+          ASSERT (DCur.getContiguousCount (posD) >= count);
+
+          grid_coord coord[3] = {i, j, k};
+
+          for (grid_iter index = 0; index < count; ++index, ++coord[2])
+          {
+            CaD[index] = profileD.Ca[coord[axisD]];
+            CbD[index] = profileD.Cb[coord[axisD]];
+
+            FPValue modifier = 1;
+            if (useMetamaterials)
+            {
+              const DrudeCoefficients &coefficients = drude->get (GridCoordinate3D (i, j, coord[2]));
+
+              b0[index] = coefficients.b0;
+              b1[index] = coefficients.b1;
+              b2[index] = coefficients.b2;
+              a1[index] = coefficients.a1;
+              a2[index] = coefficients.a2;
+            }
+            else
+            {
+              modifier = material->get (GridCoordinate3D (i, j, coord[2]));
+            }
+
+            Ca[index] = profileInverse.Ca[coord[axisInverse]];
+            Cb[index] = profileSum.sum[coord[axis]] * profileInverse.inverseSum[coord[axisInverse]] / modifier;
+            Cc[index] = profileSum.diff[coord[axis]] * profileInverse.inverseSum[coord[axisInverse]] / modifier;
+          }
+
+          for (int plane = 0; plane < GRID_PLANES_COUNT; ++plane)
+          {
+            kernels.calculateCurl (getRowValues (DCur, posD, plane),
+                                   getRowValues (DPrev, posD, plane),
+                                   getRowValuesForRead (prev1, pos + diff11, count, plane, buffers[0]),
+                                   getRowValuesForRead (prev1, pos + diff12, count, plane, buffers[1]),
+                                   getRowValuesForRead (prev2, pos + diff21, count, plane, buffers[2]),
+                                   getRowValuesForRead (prev2, pos + diff22, count, plane, buffers[3]),
+                                   &CaD[0],
+                                   &CbD[0],
+                                   count);
+
+            const FPValue *valD = getRowValues (DCur, posD, plane);
+            const FPValue *prevValD = getRowValues (DPrev, posD, plane);
+
+            if (useMetamaterials)
+            {
+              kernels.calculateDrude (getRowValues (D1Cur, posD, plane),
+                                      getRowValues (DCur, posD, plane),
+                                      getRowValues (DPrev, posD, plane),
+                                      getRowValues (DPrevPrev, posD, plane),
+                                      getRowValues (D1Prev, posD, plane),
+                                      getRowValues (D1PrevPrev, posD, plane),
+                                      &b0[0],
+                                      &b1[0],
+                                      &b2[0],
+                                      &a1[0],
+                                      &a2[0],
+                                      count);
+
+              valD = getRowValues (D1Cur, posD, plane);
+              prevValD = getRowValues (D1Prev, posD, plane);
+            }
+
+            kernels.calculateFromD (getRowValues (cur, pos, plane),
+                                    getRowValues (prev, pos, plane),
+                                    valD,
+                                    prevValD,
+                                    &Ca[0],
+                                    &Cb[0],
+                                    &Cc[0],
+                                    count);
+          }
+
+          k += count;
         }
       }
     }
   }
+} /* Scheme3D::calculateStepPMLRows */
+
+void
+Scheme3D::calculateExStep (time_step t, GridCoordinate3D ExStart, GridCoordinate3D ExEnd)
+{
+  GridCoordinate3D diffDown = yeeLayout->getExCircuitElementDiff (LayoutDirection::DOWN);
+  GridCoordinate3D diffUp = yeeLayout->getExCircuitElementDiff (LayoutDirection::UP);
+  GridCoordinate3D diffBack = yeeLayout->getExCircuitElementDiff (LayoutDirection::BACK);
+  GridCoordinate3D diffFront = yeeLayout->getExCircuitElementDiff (LayoutDirection::FRONT);
+
+  calculateStepRows (Ex, Hz, diffUp, diffDown, Hy, diffFront, diffBack, ExMaterial, ExCurlCoefficients,
+                     ExStart, ExEnd);
+}
 
+void
+Scheme3D::calculateExStepPML (time_step t, GridCoordinate3D ExStart, GridCoordinate3D ExEnd)
+{
+  GridCoordinate3D diffDown = yeeLayout->getExCircuitElementDiff (LayoutDirection::DOWN);
+  GridCoordinate3D diffUp = yeeLayout->getExCircuitElementDiff (LayoutDirection::UP);
+  GridCoordinate3D diffBack = yeeLayout->getExCircuitElementDiff (LayoutDirection::BACK);
+  GridCoordinate3D diffFront = yeeLayout->getExCircuitElementDiff (LayoutDirection::FRONT);
+
+  calculateStepPMLRows (GridType::EX, Ex, DxBoxes, Hz, diffUp, diffDown, Hy, diffFront, diffBack,
+                        ExStart, ExEnd);
+}
+
+void
+Scheme3D::calculateExStepCPML (time_step t, GridCoordinate3D ExStart, GridCoordinate3D ExEnd)
+{
+  GridView<GridCoordinate3D> ExCur = Ex.getView (0);
+  GridView<GridCoordinate3D> ExPrev = Ex.getView (1);
+  GridView<GridCoordinate3D> HzPrev = Hz.getView (1);
+  GridView<GridCoordinate3D> HyPrev = Hy.getView (1);
+
+  GridCoordinate3D diffDown = yeeLayout->getExCircuitElementDiff (LayoutDirection::DOWN);
+  GridCoordinate3D diffUp = yeeLayout->getExCircuitElementDiff (LayoutDirection::UP);
+  GridCoordinate3D diffBack = yeeLayout->getExCircuitElementDiff (LayoutDirection::BACK);
+  GridCoordinate3D diffFront = yeeLayout->getExCircuitElementDiff (LayoutDirection::FRONT);
+
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (int i = ExStart.getX (); i < ExEnd.getX (); ++i)
   {
     for (int j = ExStart.getY (); j < ExEnd.getY (); ++j)
@@ -370,51 +824,62 @@ Scheme3D::calculateExStepPML (time_step t, GridCoordinate3D ExStart, GridCoordin
       for (int k = ExStart.getZ (); k < ExEnd.getZ (); ++k)
       {
         GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Ex.getTotalPosition (pos);
 
-        FieldPointValue* valEx = Ex.getFieldPointValue (pos);
+        GridCoordinate3D posDown = pos + diffDown;
+        GridCoordinate3D posUp = pos + diffUp;
+        GridCoordinate3D posBack = pos + diffBack;
+        GridCoordinate3D posFront = pos + diffFront;
 
-        FieldPointValue* valDx;
+        FieldValue prevHz1 = HzPrev[posUp];
+        FieldValue prevHz2 = HzPrev[posDown];
 
-        if (useMetamaterials)
-        {
-          valDx = D1x.getFieldPointValue (pos);
-        }
-        else
+        FieldValue prevHy1 = HyPrev[posFront];
+        FieldValue prevHy2 = HyPrev[posBack];
+
+        /*
+         * Recursive convolutions of derivatives are added to values with higher coordinates
+         */
+        FieldValue *psiY = ExPsiY.getValue (pos);
+        if (psiY != NULLPTR)
         {
-          valDx = Dx.getFieldPointValue (pos);
+          *psiY = ExProfileY.b[j] * *psiY + ExProfileY.c[j] * (prevHz1 - prevHz2);
+          prevHz1 += *psiY;
         }
 
-        FPValue eps = yeeLayout->getMaterial (posAbs, GridType::DX, Eps, GridType::EPS);
-        FPValue sigmaX = yeeLayout->getMaterial (posAbs, GridType::DX, SigmaX, GridType::SIGMAX);
-        FPValue sigmaZ = yeeLayout->getMaterial (posAbs, GridType::DX, SigmaZ, GridType::SIGMAZ);
-
-        FPValue modifier = eps * eps0;
-        if (useMetamaterials)
+        FieldValue *psiZ = ExPsiZ.getValue (pos);
+        if (psiZ != NULLPTR)
         {
-          modifier = 1;
+          *psiZ = ExProfileZ.b[k] * *psiZ + ExProfileZ.c[k] * (prevHy1 - prevHy2);
+          prevHy1 += *psiZ;
         }
 
-        FPValue k_x = 1;
-        FPValue k_z = 1;
-
-        FPValue Ca = (2 * eps0 * k_z - sigmaZ * gridTimeStep) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
-        FPValue Cb = ((2 * eps0 * k_x + sigmaX * gridTimeStep) / (modifier)) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
-        FPValue Cc = ((2 * eps0 * k_x - sigmaX * gridTimeStep) / (modifier)) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
-
-        FieldValue val = calculateEx_from_Dx_Precalc (valEx->getPrevValue (),
-                                                      valDx->getCurValue (),
-                                                      valDx->getPrevValue (),
-                                                      Ca,
-                                                      Cb,
-                                                      Cc);
+        FieldValue val = calculateEx_3D (ExPrev[pos],
+                                         prevHz1,
+                                         prevHz2,
+                                         prevHy1,
+                                         prevHy2,
+                                         gridTimeStep,
+                                         gridStep,
+                                         ExMaterial.get (pos));
 
-        valEx->setCurValue (val);
+        ExCur[pos] = val;
       }
     }
   }
 }
 
+/**
+ * Update Ey in box of zero conductivity of PML. Drude model is applied only by PML update, so it is used in box of
+ * cells of Drude model and plain update is used around it.
+ */
+void
+Scheme3D::performEyDrudeSteps (time_step t, GridCoordinate3D EyStart, GridCoordinate3D EyEnd)
+{
+  performSplitSteps (t, EyStart, EyEnd, DyBoxes.drudeStart, DyBoxes.drudeEnd,
+                     &Scheme3D::calculateEyStepPML,
+                     &Scheme3D::calculateEyStep);
+} /* Scheme3D::performEyDrudeSteps */
+
 void
 Scheme3D::performEySteps (time_step t, GridCoordinate3D EyStart, GridCoordinate3D EyEnd)
 {
@@ -423,1132 +888,818 @@ Scheme3D::performEySteps (time_step t, GridCoordinate3D EyStart, GridCoordinate3
    */
   if (usePML)
   {
-    calculateEyStepPML (t, EyStart, EyEnd);
+    performSplitSteps (t, EyStart, EyEnd,
+                       GridCoordinate3D (EyProfileX.interiorStart, EyProfileY.interiorStart, EyProfileZ.interiorStart),
+                       GridCoordinate3D (EyProfileX.interiorEnd, EyProfileY.interiorEnd, EyProfileZ.interiorEnd),
+                       useMetamaterials ? &Scheme3D::performEyDrudeSteps : &Scheme3D::calculateEyStep,
+                       useCPML ? &Scheme3D::calculateEyStepCPML : &Scheme3D::calculateEyStepPML);
   }
   else
   {
     calculateEyStep (t, EyStart, EyEnd);
   }
+
+  /*
+   * Updates above do not take TF/SF into account, corrections are applied only to cells on border of TF/SF area
+   */
+  if (useTFSF)
+  {
+    calculateEyTFSF (EyStart, EyEnd);
+  }
 }
 
 void
-Scheme3D::calculateEyTFSF (GridCoordinate3D posAbs,
-                           FieldValue &valHz1,
-                           FieldValue &valHz2,
-                           FieldValue &valHx1,
-                           FieldValue &valHx2,
-                           GridCoordinate3D posLeft,
-                           GridCoordinate3D posRight,
-                           GridCoordinate3D posBack,
-                           GridCoordinate3D posFront)
+Scheme3D::calculateEyTFSF (GridCoordinate3D EyStart, GridCoordinate3D EyEnd)
 {
-  bool do_need_update_left = yeeLayout->doNeedTFSFUpdateEyBorder (posAbs, LayoutDirection::LEFT, DO_USE_3D_MODE);
-  bool do_need_update_right = yeeLayout->doNeedTFSFUpdateEyBorder (posAbs, LayoutDirection::RIGHT, DO_USE_3D_MODE);
+  GridView<GridCoordinate3D> EyCur = Ey.getView (0);
 
-  bool do_need_update_back = yeeLayout->doNeedTFSFUpdateEyBorder (posAbs, LayoutDirection::BACK, DO_USE_3D_MODE);
-  bool do_need_update_front = yeeLayout->doNeedTFSFUpdateEyBorder (posAbs, LayoutDirection::FRONT, DO_USE_3D_MODE);
+  GridView<GridCoordinate1D> HIncPrev = HInc.getView (1);
 
-  GridCoordinate3D auxPosX;
-  GridCoordinate3D auxPosZ;
-  FieldValue diffX;
-  FieldValue diffZ;
-
-  if (do_need_update_left)
-  {
-    auxPosX = posRight;
-  }
-  else if (do_need_update_right)
+  for (std::vector<TFSFCell>::const_iterator it = findTFSFCell (EyTFSFCells, EyStart.getX ());
+       it != EyTFSFCells.end () && it->pos.getX () < EyEnd.getX ();
+       ++it)
   {
-    auxPosX = posLeft;
-  }
+    GridCoordinate3D pos = it->pos;
 
-  if (do_need_update_back)
-  {
-    auxPosZ = posFront;
-  }
-  else if (do_need_update_front)
-  {
-    auxPosZ = posBack;
-  }
+    if (!(pos >= EyStart && pos < EyEnd))
+    {
+      continue;
+    }
 
-  if (do_need_update_left || do_need_update_right)
-  {
-    GridCoordinateFP3D realCoord = yeeLayout->getHzCoordFP (Hz.getTotalPosition (auxPosX));
+    grid_coord i = pos.getX ();
+    grid_coord j = pos.getY ();
+    grid_coord k = pos.getZ ();
 
-    diffX = yeeLayout->getHzFromIncidentH (approximateIncidentWaveH (realCoord));
-  }
+    FieldValue diffHx (0);
+    FieldValue diffHz (0);
 
-  if (do_need_update_back || do_need_update_front)
-  {
-    GridCoordinateFP3D realCoord = yeeLayout->getHxCoordFP (Hx.getTotalPosition (auxPosZ));
+    if (it->factor1 != 0)
+    {
+      diffHx = it->factor1 * it->incident1.approximate (HIncPrev);
+    }
 
-    diffZ = yeeLayout->getHxFromIncidentH (approximateIncidentWaveH (realCoord));
-  }
+    if (it->factor2 != 0)
+    {
+      diffHz = it->factor2 * it->incident2.approximate (HIncPrev);
+    }
 
-  if (do_need_update_left)
-  {
-    valHz1 -= diffX;
-  }
-  else if (do_need_update_right)
-  {
-    valHz2 -= diffX;
-  }
-
-  if (do_need_update_back)
-  {
-    valHx1 -= diffZ;
-  }
-  else if (do_need_update_front)
-  {
-    valHx2 -= diffZ;
-  }
-}
-
-void
-Scheme3D::calculateEyStep (time_step t, GridCoordinate3D EyStart, GridCoordinate3D EyEnd)
-{
-  FPValue eps0 = PhysicsConst::Eps0;
+    /*
+     * Cell is updated by calculateEyStepPML if it is in box of Dy
+     */
+    const PMLBox *box = DyBoxes.find (pos, pos + GridCoordinate3D (1, 1, 1));
 
-  for (int i = EyStart.getX (); i < EyEnd.getX (); ++i)
-  {
-    for (int j = EyStart.getY (); j < EyEnd.getY (); ++j)
+    if (box != NULLPTR)
     {
-      for (int k = EyStart.getZ (); k < EyEnd.getZ (); ++k)
-      {
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Ey.getTotalPosition (pos);
-
-        FieldPointValue* valEy = Ey.getFieldPointValue (pos);
+      GridCoordinate3D posD = pos - box->origin;
 
-        FPValue eps = yeeLayout->getMaterial (posAbs, GridType::EY, Eps, GridType::EPS);
+      FieldValue valDy = EyProfileZ.Cb[k] * (diffHx - diffHz);
 
-        GridCoordinate3D posLeft = yeeLayout->getEyCircuitElement (pos, LayoutDirection::LEFT);
-        GridCoordinate3D posRight = yeeLayout->getEyCircuitElement (pos, LayoutDirection::RIGHT);
-        GridCoordinate3D posBack = yeeLayout->getEyCircuitElement (pos, LayoutDirection::BACK);
-        GridCoordinate3D posFront = yeeLayout->getEyCircuitElement (pos, LayoutDirection::FRONT);
+      *box->D->getFieldValue (posD, 0) += valDy;
 
-        FieldPointValue* valHz1 = Hz.getFieldPointValue (posRight);
-        FieldPointValue* valHz2 = Hz.getFieldPointValue (posLeft);
-
-        FieldPointValue* valHx1 = Hx.getFieldPointValue (posFront);
-        FieldPointValue* valHx2 = Hx.getFieldPointValue (posBack);
-
-        FieldValue prevHz1 = valHz1->getPrevValue ();
-        FieldValue prevHz2 = valHz2->getPrevValue ();
-
-        FieldValue prevHx1 = valHx1->getPrevValue ();
-        FieldValue prevHx2 = valHx2->getPrevValue ();
-
-        if (useTFSF)
-        {
-          calculateEyTFSF (posAbs, prevHz1, prevHz2, prevHx1, prevHx2, posLeft, posRight, posBack, posFront);
-        }
-
-        FieldValue val = calculateEy_3D (valEy->getPrevValue (),
-                                         prevHx1,
-                                         prevHx2,
-                                         prevHz1,
-                                         prevHz2,
-                                         gridTimeStep,
-                                         gridStep,
-                                         eps * eps0);
+      FPValue modifier = 1;
+      if (useMetamaterials)
+      {
+        valDy = EyDrude.get (pos).b0 * valDy;
 
-        valEy->setCurValue (val);
+        *box->D1->getFieldValue (posD, 0) += valDy;
       }
-    }
-  }
-}
-
-void
-Scheme3D::calculateEyStepPML (time_step t, GridCoordinate3D EyStart, GridCoordinate3D EyEnd)
-{
-  FPValue eps0 = PhysicsConst::Eps0;
-
-  for (int i = EyStart.getX (); i < EyEnd.getX (); ++i)
-  {
-    for (int j = EyStart.getY (); j < EyEnd.getY (); ++j)
-    {
-      for (int k = EyStart.getZ (); k < EyEnd.getZ (); ++k)
+      else
       {
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Dy.getTotalPosition (pos);
-
-        FieldPointValue* valDy = Dy.getFieldPointValue (pos);
-
-        FPValue sigmaZ = yeeLayout->getMaterial (posAbs, GridType::DY, SigmaZ, GridType::SIGMAZ);
-
-        GridCoordinate3D posLeft = yeeLayout->getEyCircuitElement (pos, LayoutDirection::LEFT);
-        GridCoordinate3D posRight = yeeLayout->getEyCircuitElement (pos, LayoutDirection::RIGHT);
-        GridCoordinate3D posBack = yeeLayout->getEyCircuitElement (pos, LayoutDirection::BACK);
-        GridCoordinate3D posFront = yeeLayout->getEyCircuitElement (pos, LayoutDirection::FRONT);
-
-        FieldPointValue* valHz1 = Hz.getFieldPointValue (posRight);
-        FieldPointValue* valHz2 = Hz.getFieldPointValue (posLeft);
-
-        FieldPointValue* valHx1 = Hx.getFieldPointValue (posFront);
-        FieldPointValue* valHx2 = Hx.getFieldPointValue (posBack);
-
-        FieldValue prevHz1 = valHz1->getPrevValue ();
-        FieldValue prevHz2 = valHz2->getPrevValue ();
-
-        FieldValue prevHx1 = valHx1->getPrevValue ();
-        FieldValue prevHx2 = valHx2->getPrevValue ();
-
-        if (useTFSF)
-        {
-          calculateEyTFSF (posAbs, prevHz1, prevHz2, prevHx1, prevHx2, posLeft, posRight, posBack, posFront);
-        }
-
-        /*
-         * FIXME: precalculate coefficients
-         */
-        FPValue k_z = 1;
-
-        FPValue Ca = (2 * eps0 * k_z - sigmaZ * gridTimeStep) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
-        FPValue Cb = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
-
-        FieldValue val = calculateEy_3D_Precalc (valDy->getPrevValue (),
-                                                 prevHx1,
-                                                 prevHx2,
-                                                 prevHz1,
-                                                 prevHz2,
-                                                 Ca,
-                                                 Cb);
-
-        valDy->setCurValue (val);
+        modifier = EyMaterial.get (pos);
       }
-    }
-  }
 
-  if (useMetamaterials)
-  {
-    for (int i = EyStart.getX (); i < EyEnd.getX (); ++i)
+      EyCur[pos] += EyProfileY.sum[j] * EyProfileX.inverseSum[i] / modifier * valDy;
+    }
+    else
     {
-      for (int j = EyStart.getY (); j < EyEnd.getY (); ++j)
+      if (useCPML)
       {
-        for (int k = EyStart.getZ (); k < EyEnd.getZ (); ++k)
+        FieldValue *psiZ = EyPsiZ.getValue (pos);
+        if (psiZ != NULLPTR)
         {
-          GridCoordinate3D pos (i, j, k);
-          GridCoordinate3D posAbs = Dy.getTotalPosition (pos);
-
-          FieldPointValue* valD1y = D1y.getFieldPointValue (pos);
-          FieldPointValue* valDy = Dy.getFieldPointValue (pos);
+          FieldValue valPsi = EyProfileZ.c[k] * diffHx;
 
-          FPValue omegaPE;
-          FPValue gammaE;
-          FPValue eps = yeeLayout->getMetaMaterial (posAbs, GridType::DY, Eps, GridType::EPS, OmegaPE, GridType::OMEGAPE, GammaE, GridType::GAMMAE, omegaPE, gammaE);
-
-          /*
-           * FIXME: precalculate coefficients
-           */
-          FPValue A = 4*eps0*eps + 2*gridTimeStep*eps0*eps*gammaE + eps0*gridTimeStep*gridTimeStep*omegaPE*omegaPE;
-
-          FieldValue val = calculateDrudeE (valDy->getCurValue (),
-                                            valDy->getPrevValue (),
-                                            valDy->getPrevPrevValue (),
-                                            valD1y->getPrevValue (),
-                                            valD1y->getPrevPrevValue (),
-                                            (4 + 2*gridTimeStep*gammaE) / A,
-                                            -8 / A,
-                                            (4 - 2*gridTimeStep*gammaE) / A,
-                                            (2*eps0*gridTimeStep*gridTimeStep*omegaPE*omegaPE - 8*eps0*eps) / A,
-                                            (4*eps0*eps - 2*gridTimeStep*eps0*eps*gammaE + eps0*gridTimeStep*gridTimeStep*omegaPE*omegaPE) / A);
-
-          valD1y->setCurValue (val);
+          *psiZ += valPsi;
+          diffHx += valPsi;
         }
-      }
-    }
-  }
-
-  for (int i = EyStart.getX (); i < EyEnd.getX (); ++i)
-  {
-    for (int j = EyStart.getY (); j < EyEnd.getY (); ++j)
-    {
-      for (int k = EyStart.getZ (); k < EyEnd.getZ (); ++k)
-      {
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Ey.getTotalPosition (pos);
-
-        FieldPointValue* valEy = Ey.getFieldPointValue (pos);
 
-        FieldPointValue* valDy;
-
-        if (useMetamaterials)
-        {
-          valDy = D1y.getFieldPointValue (pos);
-        }
-        else
+        FieldValue *psiX = EyPsiX.getValue (pos);
+        if (psiX != NULLPTR)
         {
-          valDy = Dy.getFieldPointValue (pos);
-        }
-
-        FPValue eps = yeeLayout->getMaterial (posAbs, GridType::DY, Eps, GridType::EPS);
-        FPValue sigmaX = yeeLayout->getMaterial (posAbs, GridType::DY, SigmaX, GridType::SIGMAX);
-        FPValue sigmaY = yeeLayout->getMaterial (posAbs, GridType::DY, SigmaY, GridType::SIGMAY);
+          FieldValue valPsi = EyProfileX.c[i] * diffHz;
 
-        FPValue modifier = eps * eps0;
-        if (useMetamaterials)
-        {
-          modifier = 1;
+          *psiX += valPsi;
+          diffHz += valPsi;
         }
-
-        FPValue k_x = 1;
-        FPValue k_y = 1;
-
-        FPValue Ca = (2 * eps0 * k_x - sigmaX * gridTimeStep) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
-        FPValue Cb = ((2 * eps0 * k_y + sigmaY * gridTimeStep) / (modifier)) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
-        FPValue Cc = ((2 * eps0 * k_y - sigmaY * gridTimeStep) / (modifier)) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
-
-        FieldValue val = calculateEy_from_Dy_Precalc (valEy->getPrevValue (),
-                                                      valDy->getCurValue (),
-                                                      valDy->getPrevValue (),
-                                                      Ca,
-                                                      Cb,
-                                                      Cc);
-
-        valEy->setCurValue (val);
       }
+
+      EyCur[pos] += gridTimeStep / (EyMaterial.get (pos) * gridStep) * (diffHx - diffHz);
     }
   }
 }
 
 void
-Scheme3D::performEzSteps (time_step t, GridCoordinate3D EzStart, GridCoordinate3D EzEnd)
+Scheme3D::calculateEyStep (time_step t, GridCoordinate3D EyStart, GridCoordinate3D EyEnd)
 {
-  /*
-   * FIXME: check performed on each iteration
-   */
-  if (usePML)
-  {
-    calculateEzStepPML (t, EzStart, EzEnd);
-  }
-  else
-  {
-    calculateEzStep (t, EzStart, EzEnd);
-  }
+  GridCoordinate3D diffLeft = yeeLayout->getEyCircuitElementDiff (LayoutDirection::LEFT);
+  GridCoordinate3D diffRight = yeeLayout->getEyCircuitElementDiff (LayoutDirection::RIGHT);
+  GridCoordinate3D diffBack = yeeLayout->getEyCircuitElementDiff (LayoutDirection::BACK);
+  GridCoordinate3D diffFront = yeeLayout->getEyCircuitElementDiff (LayoutDirection::FRONT);
+
+  calculateStepRows (Ey, Hx, diffFront, diffBack, Hz, diffRight, diffLeft, EyMaterial, EyCurlCoefficients,
+                     EyStart, EyEnd);
 }
 
 void
-Scheme3D::calculateEzTFSF (GridCoordinate3D posAbs,
-                           FieldValue &valHy1,
-                           FieldValue &valHy2,
-                           FieldValue &valHx1,
-                           FieldValue &valHx2,
-                           GridCoordinate3D posLeft,
-                           GridCoordinate3D posRight,
-                           GridCoordinate3D posDown,
-                           GridCoordinate3D posUp)
+Scheme3D::calculateEyStepPML (time_step t, GridCoordinate3D EyStart, GridCoordinate3D EyEnd)
 {
-  bool do_need_update_left = yeeLayout->doNeedTFSFUpdateEzBorder (posAbs, LayoutDirection::LEFT, DO_USE_3D_MODE);
-  bool do_need_update_right = yeeLayout->doNeedTFSFUpdateEzBorder (posAbs, LayoutDirection::RIGHT, DO_USE_3D_MODE);
-
-  bool do_need_update_down = yeeLayout->doNeedTFSFUpdateEzBorder (posAbs, LayoutDirection::DOWN, DO_USE_3D_MODE);
-  bool do_need_update_up = yeeLayout->doNeedTFSFUpdateEzBorder (posAbs, LayoutDirection::UP, DO_USE_3D_MODE);
-
-  GridCoordinate3D auxPosX;
-  GridCoordinate3D auxPosY;
-  FieldValue diffX;
-  FieldValue diffY;
+  GridCoordinate3D diffLeft = yeeLayout->getEyCircuitElementDiff (LayoutDirection::LEFT);
+  GridCoordinate3D diffRight = yeeLayout->getEyCircuitElementDiff (LayoutDirection::RIGHT);
+  GridCoordinate3D diffBack = yeeLayout->getEyCircuitElementDiff (LayoutDirection::BACK);
+  GridCoordinate3D diffFront = yeeLayout->getEyCircuitElementDiff (LayoutDirection::FRONT);
 
-  if (do_need_update_left)
-  {
-    auxPosX = posRight;
-  }
-  else if (do_need_update_right)
-  {
-    auxPosX = posLeft;
-  }
-
-  if (do_need_update_down)
-  {
-    auxPosY = posUp;
-  }
-  else if (do_need_update_up)
-  {
-    auxPosY = posDown;
-  }
-
-  if (do_need_update_left || do_need_update_right)
-  {
-    GridCoordinateFP3D realCoord = yeeLayout->getHyCoordFP (Hy.getTotalPosition (auxPosX));
-
-    diffX = yeeLayout->getHyFromIncidentH (approximateIncidentWaveH (realCoord));
-  }
-
-  if (do_need_update_down || do_need_update_up)
-  {
-    GridCoordinateFP3D realCoord = yeeLayout->getHxCoordFP (Hx.getTotalPosition (auxPosY));
-
-    diffY = yeeLayout->getHxFromIncidentH (approximateIncidentWaveH (realCoord));
-  }
-
-  if (do_need_update_left)
-  {
-    valHy1 -= diffX;
-  }
-  else if (do_need_update_right)
-  {
-    valHy2 -= diffX;
-  }
-
-  if (do_need_update_down)
-  {
-    valHx1 -= diffY;
-  }
-  else if (do_need_update_up)
-  {
-    valHx2 -= diffY;
-  }
+  calculateStepPMLRows (GridType::EY, Ey, DyBoxes, Hx, diffFront, diffBack, Hz, diffRight, diffLeft,
+                        EyStart, EyEnd);
 }
 
 void
-Scheme3D::calculateEzStep (time_step t, GridCoordinate3D EzStart, GridCoordinate3D EzEnd)
+Scheme3D::calculateEyStepCPML (time_step t, GridCoordinate3D EyStart, GridCoordinate3D EyEnd)
 {
-  FPValue eps0 = PhysicsConst::Eps0;
-
-  for (int i = EzStart.getX (); i < EzEnd.getX (); ++i)
+  GridView<GridCoordinate3D> EyCur = Ey.getView (0);
+  GridView<GridCoordinate3D> EyPrev = Ey.getView (1);
+  GridView<GridCoordinate3D> HzPrev = Hz.getView (1);
+  GridView<GridCoordinate3D> HxPrev = Hx.getView (1);
+
+  GridCoordinate3D diffLeft = yeeLayout->getEyCircuitElementDiff (LayoutDirection::LEFT);
+  GridCoordinate3D diffRight = yeeLayout->getEyCircuitElementDiff (LayoutDirection::RIGHT);
+  GridCoordinate3D diffBack = yeeLayout->getEyCircuitElementDiff (LayoutDirection::BACK);
+  GridCoordinate3D diffFront = yeeLayout->getEyCircuitElementDiff (LayoutDirection::FRONT);
+
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
+  for (int i = EyStart.getX (); i < EyEnd.getX (); ++i)
   {
-    for (int j = EzStart.getY (); j < EzEnd.getY (); ++j)
+    for (int j = EyStart.getY (); j < EyEnd.getY (); ++j)
     {
-      for (int k = EzStart.getZ (); k < EzEnd.getZ (); ++k)
+      for (int k = EyStart.getZ (); k < EyEnd.getZ (); ++k)
       {
         GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Ez.getTotalPosition (pos);
-
-        FieldPointValue* valEz = Ez.getFieldPointValue (pos);
-
-        FPValue eps = yeeLayout->getMaterial (posAbs, GridType::EZ, Eps, GridType::EPS);
 
-        GridCoordinate3D posLeft = yeeLayout->getEzCircuitElement (pos, LayoutDirection::LEFT);
-        GridCoordinate3D posRight = yeeLayout->getEzCircuitElement (pos, LayoutDirection::RIGHT);
-        GridCoordinate3D posDown = yeeLayout->getEzCircuitElement (pos, LayoutDirection::DOWN);
-        GridCoordinate3D posUp = yeeLayout->getEzCircuitElement (pos, LayoutDirection::UP);
+        GridCoordinate3D posLeft = pos + diffLeft;
+        GridCoordinate3D posRight = pos + diffRight;
+        GridCoordinate3D posBack = pos + diffBack;
+        GridCoordinate3D posFront = pos + diffFront;
 
-        FieldPointValue* valHy1 = Hy.getFieldPointValue (posRight);
-        FieldPointValue* valHy2 = Hy.getFieldPointValue (posLeft);
+        FieldValue prevHz1 = HzPrev[posRight];
+        FieldValue prevHz2 = HzPrev[posLeft];
 
-        FieldPointValue* valHx1 = Hx.getFieldPointValue (posUp);
-        FieldPointValue* valHx2 = Hx.getFieldPointValue (posDown);
+        FieldValue prevHx1 = HxPrev[posFront];
+        FieldValue prevHx2 = HxPrev[posBack];
 
-        FieldValue prevHx1 = valHx1->getPrevValue ();
-        FieldValue prevHx2 = valHx2->getPrevValue ();
-        FieldValue prevHy1 = valHy1->getPrevValue ();
-        FieldValue prevHy2 = valHy2->getPrevValue ();
+        /*
+         * Recursive convolutions of derivatives are added to values with higher coordinates
+         */
+        FieldValue *psiZ = EyPsiZ.getValue (pos);
+        if (psiZ != NULLPTR)
+        {
+          *psiZ = EyProfileZ.b[k] * *psiZ + EyProfileZ.c[k] * (prevHx1 - prevHx2);
+          prevHx1 += *psiZ;
+        }
 
-        if (useTFSF)
+        FieldValue *psiX = EyPsiX.getValue (pos);
+        if (psiX != NULLPTR)
         {
-          calculateEzTFSF (posAbs, prevHy1, prevHy2, prevHx1, prevHx2, posLeft, posRight, posDown, posUp);
+          *psiX = EyProfileX.b[i] * *psiX + EyProfileX.c[i] * (prevHz1 - prevHz2);
+          prevHz1 += *psiX;
         }
 
-        FieldValue val = calculateEz_3D (valEz->getPrevValue (),
-                                         prevHy1,
-                                         prevHy2,
+        FieldValue val = calculateEy_3D (EyPrev[pos],
                                          prevHx1,
                                          prevHx2,
+                                         prevHz1,
+                                         prevHz2,
                                          gridTimeStep,
                                          gridStep,
-                                         eps * eps0);
+                                         EyMaterial.get (pos));
 
-        valEz->setCurValue (val);
+        EyCur[pos] = val;
       }
     }
   }
 }
 
+/**
+ * Update Ez in box of zero conductivity of PML. Drude model is applied only by PML update, so it is used in box of
+ * cells of Drude model and plain update is used around it.
+ */
 void
-Scheme3D::calculateEzStepPML (time_step t, GridCoordinate3D EzStart, GridCoordinate3D EzEnd)
+Scheme3D::performEzDrudeSteps (time_step t, GridCoordinate3D EzStart, GridCoordinate3D EzEnd)
 {
-  FPValue eps0 = PhysicsConst::Eps0;
-
-  for (int i = EzStart.getX (); i < EzEnd.getX (); ++i)
-  {
-    for (int j = EzStart.getY (); j < EzEnd.getY (); ++j)
-    {
-      for (int k = EzStart.getZ (); k < EzEnd.getZ (); ++k)
-      {
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Ez.getTotalPosition (pos);
-
-        FieldPointValue* valDz = Dz.getFieldPointValue (pos);
-
-        FPValue sigmaX = yeeLayout->getMaterial (posAbs, GridType::DZ, SigmaX, GridType::SIGMAX);
-
-        GridCoordinate3D posLeft = yeeLayout->getEzCircuitElement (pos, LayoutDirection::LEFT);
-        GridCoordinate3D posRight = yeeLayout->getEzCircuitElement (pos, LayoutDirection::RIGHT);
-        GridCoordinate3D posDown = yeeLayout->getEzCircuitElement (pos, LayoutDirection::DOWN);
-        GridCoordinate3D posUp = yeeLayout->getEzCircuitElement (pos, LayoutDirection::UP);
-
-        FieldPointValue* valHy1 = Hy.getFieldPointValue (posRight);
-        FieldPointValue* valHy2 = Hy.getFieldPointValue (posLeft);
-
-        FieldPointValue* valHx1 = Hx.getFieldPointValue (posUp);
-        FieldPointValue* valHx2 = Hx.getFieldPointValue (posDown);
-
-        FieldValue prevHx1 = valHx1->getPrevValue ();
-        FieldValue prevHx2 = valHx2->getPrevValue ();
-        FieldValue prevHy1 = valHy1->getPrevValue ();
-        FieldValue prevHy2 = valHy2->getPrevValue ();
-
-        if (useTFSF)
-        {
-          calculateEzTFSF (posAbs, prevHy1, prevHy2, prevHx1, prevHx2, posLeft, posRight, posDown, posUp);
-        }
-
-        /*
-         * FIXME: precalculate coefficients
-         */
-        FPValue k_x = 1;
-
-        FPValue Ca = (2 * eps0 * k_x - sigmaX * gridTimeStep) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
-        FPValue Cb = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
-
-        FieldValue val = calculateEz_3D_Precalc (valDz->getPrevValue (),
-                                                 prevHy1,
-                                                 prevHy2,
-                                                 prevHx1,
-                                                 prevHx2,
-                                                 Ca,
-                                                 Cb);
-
-        valDz->setCurValue (val);
-      }
-    }
-  }
-
-  if (useMetamaterials)
-  {
-    for (int i = EzStart.getX (); i < EzEnd.getX (); ++i)
-    {
-      for (int j = EzStart.getY (); j < EzEnd.getY (); ++j)
-      {
-        for (int k = EzStart.getZ (); k < EzEnd.getZ (); ++k)
-        {
-          GridCoordinate3D pos (i, j, k);
-          GridCoordinate3D posAbs = Ez.getTotalPosition (pos);
-
-          FieldPointValue* valD1z = D1z.getFieldPointValue (pos);
-          FieldPointValue* valDz = Dz.getFieldPointValue (pos);
-
-          FPValue omegaPE;
-          FPValue gammaE;
-          FPValue eps = yeeLayout->getMetaMaterial (posAbs, GridType::DZ, Eps, GridType::EPS, OmegaPE, GridType::OMEGAPE, GammaE, GridType::GAMMAE, omegaPE, gammaE);
-
-          /*
-           * FIXME: precalculate coefficients
-           */
-          FPValue A = 4*eps0*eps + 2*gridTimeStep*eps0*eps*gammaE + eps0*gridTimeStep*gridTimeStep*omegaPE*omegaPE;
-
-          FieldValue val = calculateDrudeE (valDz->getCurValue (),
-                                            valDz->getPrevValue (),
-                                            valDz->getPrevPrevValue (),
-                                            valD1z->getPrevValue (),
-                                            valD1z->getPrevPrevValue (),
-                                            (4 + 2*gridTimeStep*gammaE) / A,
-                                            -8 / A,
-                                            (4 - 2*gridTimeStep*gammaE) / A,
-                                            (2*eps0*gridTimeStep*gridTimeStep*omegaPE*omegaPE - 8*eps0*eps) / A,
-                                            (4*eps0*eps - 2*gridTimeStep*eps0*eps*gammaE + eps0*gridTimeStep*gridTimeStep*omegaPE*omegaPE) / A);
-
-          valD1z->setCurValue (val);
-        }
-      }
-    }
-  }
-
-  for (int i = EzStart.getX (); i < EzEnd.getX (); ++i)
-  {
-    for (int j = EzStart.getY (); j < EzEnd.getY (); ++j)
-    {
-      for (int k = EzStart.getZ (); k < EzEnd.getZ (); ++k)
-      {
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Ez.getTotalPosition (pos);
-
-        FieldPointValue* valEz = Ez.getFieldPointValue (pos);
-        FieldPointValue* valDz;
-
-        if (useMetamaterials)
-        {
-          valDz = D1z.getFieldPointValue (pos);
-        }
-        else
-        {
-          valDz = Dz.getFieldPointValue (pos);
-        }
-
-        FPValue eps = yeeLayout->getMaterial (posAbs, GridType::DZ, Eps, GridType::EPS);
-        FPValue sigmaY = yeeLayout->getMaterial (posAbs, GridType::DZ, SigmaY, GridType::SIGMAY);
-        FPValue sigmaZ = yeeLayout->getMaterial (posAbs, GridType::DZ, SigmaZ, GridType::SIGMAZ);
-
-        FPValue modifier = eps * eps0;
-        if (useMetamaterials)
-        {
-          modifier = 1;
-        }
-
-        /*
-         * FIXME: precalculate coefficients
-         */
-        FPValue k_y = 1;
-        FPValue k_z = 1;
-
-        FPValue Ca = (2 * eps0 * k_y - sigmaY * gridTimeStep) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
-        FPValue Cb = ((2 * eps0 * k_z + sigmaZ * gridTimeStep) / (modifier)) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
-        FPValue Cc = ((2 * eps0 * k_z - sigmaZ * gridTimeStep) / (modifier)) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
-
-        FieldValue val = calculateEz_from_Dz_Precalc (valEz->getPrevValue (),
-                                                      valDz->getCurValue (),
-                                                      valDz->getPrevValue (),
-                                                      Ca,
-                                                      Cb,
-                                                      Cc);
-
-        valEz->setCurValue (val);
-      }
-    }
-  }
-}
+  performSplitSteps (t, EzStart, EzEnd, DzBoxes.drudeStart, DzBoxes.drudeEnd,
+                     &Scheme3D::calculateEzStepPML,
+                     &Scheme3D::calculateEzStep);
+} /* Scheme3D::performEzDrudeSteps */
 
 void
-Scheme3D::performHxSteps (time_step t, GridCoordinate3D HxStart, GridCoordinate3D HxEnd)
+Scheme3D::performEzSteps (time_step t, GridCoordinate3D EzStart, GridCoordinate3D EzEnd)
 {
   /*
    * FIXME: check performed on each iteration
    */
   if (usePML)
   {
-    calculateHxStepPML (t, HxStart, HxEnd);
+    performSplitSteps (t, EzStart, EzEnd,
+                       GridCoordinate3D (EzProfileX.interiorStart, EzProfileY.interiorStart, EzProfileZ.interiorStart),
+                       GridCoordinate3D (EzProfileX.interiorEnd, EzProfileY.interiorEnd, EzProfileZ.interiorEnd),
+                       useMetamaterials ? &Scheme3D::performEzDrudeSteps : &Scheme3D::calculateEzStep,
+                       useCPML ? &Scheme3D::calculateEzStepCPML : &Scheme3D::calculateEzStepPML);
   }
   else
   {
-    calculateHxStep (t, HxStart, HxEnd);
-  }
-}
-
-void
-Scheme3D::calculateHxTFSF (GridCoordinate3D posAbs,
-                           FieldValue &valEz1,
-                           FieldValue &valEz2,
-                           FieldValue &valEy1,
-                           FieldValue &valEy2,
-                           GridCoordinate3D posDown,
-                           GridCoordinate3D posUp,
-                           GridCoordinate3D posBack,
-                           GridCoordinate3D posFront)
-{
-  bool do_need_update_down = yeeLayout->doNeedTFSFUpdateHxBorder (posAbs, LayoutDirection::DOWN, DO_USE_3D_MODE);
-  bool do_need_update_up = yeeLayout->doNeedTFSFUpdateHxBorder (posAbs, LayoutDirection::UP, DO_USE_3D_MODE);
-
-  bool do_need_update_back = yeeLayout->doNeedTFSFUpdateHxBorder (posAbs, LayoutDirection::BACK, DO_USE_3D_MODE);
-  bool do_need_update_front = yeeLayout->doNeedTFSFUpdateHxBorder (posAbs, LayoutDirection::FRONT, DO_USE_3D_MODE);
-
-  GridCoordinate3D auxPosY;
-  GridCoordinate3D auxPosZ;
-  FieldValue diffY;
-  FieldValue diffZ;
-
-  if (do_need_update_down)
-  {
-    auxPosY = posDown;
-  }
-  else if (do_need_update_up)
-  {
-    auxPosY = posUp;
-  }
-
-  if (do_need_update_back)
-  {
-    auxPosZ = posBack;
-  }
-  else if (do_need_update_front)
-  {
-    auxPosZ = posFront;
-  }
-
-  if (do_need_update_down || do_need_update_up)
-  {
-    GridCoordinateFP3D realCoord = yeeLayout->getEzCoordFP (Ez.getTotalPosition (auxPosY));
-
-    diffY = yeeLayout->getEzFromIncidentE (approximateIncidentWaveE (realCoord));
-  }
-
-  if (do_need_update_back || do_need_update_front)
-  {
-    GridCoordinateFP3D realCoord = yeeLayout->getEyCoordFP (Ey.getTotalPosition (auxPosZ));
-
-    diffZ = yeeLayout->getEyFromIncidentE (approximateIncidentWaveE (realCoord));
-  }
-
-  if (do_need_update_down)
-  {
-    valEz2 += diffY;
-  }
-  else if (do_need_update_up)
-  {
-    valEz1 += diffY;
+    calculateEzStep (t, EzStart, EzEnd);
   }
 
-  if (do_need_update_back)
-  {
-    valEy2 += diffZ;
-  }
-  else if (do_need_update_front)
+  /*
+   * Updates above do not take TF/SF into account, corrections are applied only to cells on border of TF/SF area
+   */
+  if (useTFSF)
   {
-    valEy1 += diffZ;
+    calculateEzTFSF (EzStart, EzEnd);
   }
 }
 
 void
-Scheme3D::calculateHxStep (time_step t, GridCoordinate3D HxStart, GridCoordinate3D HxEnd)
+Scheme3D::calculateEzTFSF (GridCoordinate3D EzStart, GridCoordinate3D EzEnd)
 {
-  FPValue eps0 = PhysicsConst::Eps0;
-  FPValue mu0 = PhysicsConst::Mu0;
-
-  for (int i = HxStart.getX (); i < HxEnd.getX (); ++i)
-  {
-    for (int j = HxStart.getY (); j < HxEnd.getY (); ++j)
-    {
-      for (int k = HxStart.getZ (); k < HxEnd.getZ (); ++k)
-      {
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Hx.getTotalPosition (pos);
-
-        FieldPointValue* valHx = Hx.getFieldPointValue (pos);
-
-        FPValue mu = yeeLayout->getMaterial (posAbs, GridType::HX, Mu, GridType::MU);
-
-        GridCoordinate3D posDown = yeeLayout->getHxCircuitElement (pos, LayoutDirection::DOWN);
-        GridCoordinate3D posUp = yeeLayout->getHxCircuitElement (pos, LayoutDirection::UP);
-        GridCoordinate3D posBack = yeeLayout->getHxCircuitElement (pos, LayoutDirection::BACK);
-        GridCoordinate3D posFront = yeeLayout->getHxCircuitElement (pos, LayoutDirection::FRONT);
-
-        FieldPointValue* valEz1 = Ez.getFieldPointValue (posUp);
-        FieldPointValue* valEz2 = Ez.getFieldPointValue (posDown);
-
-        FieldPointValue* valEy1 = Ey.getFieldPointValue (posFront);
-        FieldPointValue* valEy2 = Ey.getFieldPointValue (posBack);
-
-        FieldValue prevEz1 = valEz1->getPrevValue ();
-        FieldValue prevEz2 = valEz2->getPrevValue ();
-
-        FieldValue prevEy1 = valEy1->getPrevValue ();
-        FieldValue prevEy2 = valEy2->getPrevValue ();
+  GridView<GridCoordinate3D> EzCur = Ez.getView (0);
 
-        if (useTFSF)
-        {
-          calculateHxTFSF (posAbs, prevEz1, prevEz2, prevEy1, prevEy2, posDown, posUp, posBack, posFront);
-        }
-
-        FieldValue val = calculateHx_3D (valHx->getPrevValue (),
-                                         prevEy1,
-                                         prevEy2,
-                                         prevEz1,
-                                         prevEz2,
-                                         gridTimeStep,
-                                         gridStep,
-                                         mu * mu0);
-
-        valHx->setCurValue (val);
-      }
-    }
-  }
-}
-
-void
-Scheme3D::calculateHxStepPML (time_step t, GridCoordinate3D HxStart, GridCoordinate3D HxEnd)
-{
-  FPValue eps0 = PhysicsConst::Eps0;
-  FPValue mu0 = PhysicsConst::Mu0;
+  GridView<GridCoordinate1D> HIncPrev = HInc.getView (1);
 
-  for (int i = HxStart.getX (); i < HxEnd.getX (); ++i)
+  for (std::vector<TFSFCell>::const_iterator it = findTFSFCell (EzTFSFCells, EzStart.getX ());
+       it != EzTFSFCells.end () && it->pos.getX () < EzEnd.getX ();
+       ++it)
   {
-    for (int j = HxStart.getY (); j < HxEnd.getY (); ++j)
-    {
-      for (int k = HxStart.getZ (); k < HxEnd.getZ (); ++k)
-      {
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Hx.getTotalPosition (pos);
+    GridCoordinate3D pos = it->pos;
 
-        FieldPointValue* valBx = Bx.getFieldPointValue (pos);
-
-        FPValue sigmaY = yeeLayout->getMaterial (posAbs, GridType::BX, SigmaY, GridType::SIGMAY);
+    if (!(pos >= EzStart && pos < EzEnd))
+    {
+      continue;
+    }
 
-        GridCoordinate3D posDown = yeeLayout->getHxCircuitElement (pos, LayoutDirection::DOWN);
-        GridCoordinate3D posUp = yeeLayout->getHxCircuitElement (pos, LayoutDirection::UP);
-        GridCoordinate3D posBack = yeeLayout->getHxCircuitElement (pos, LayoutDirection::BACK);
-        GridCoordinate3D posFront = yeeLayout->getHxCircuitElement (pos, LayoutDirection::FRONT);
+    grid_coord i = pos.getX ();
+    grid_coord j = pos.getY ();
+    grid_coord k = pos.getZ ();
 
-        FieldPointValue* valEz1 = Ez.getFieldPointValue (posUp);
-        FieldPointValue* valEz2 = Ez.getFieldPointValue (posDown);
+    FieldValue diffHy (0);
+    FieldValue diffHx (0);
 
-        FieldPointValue* valEy1 = Ey.getFieldPointValue (posFront);
-        FieldPointValue* valEy2 = Ey.getFieldPointValue (posBack);
+    if (it->factor1 != 0)
+    {
+      diffHy = it->factor1 * it->incident1.approximate (HIncPrev);
+    }
 
-        FieldValue prevEz1 = valEz1->getPrevValue ();
-        FieldValue prevEz2 = valEz2->getPrevValue ();
+    if (it->factor2 != 0)
+    {
+      diffHx = it->factor2 * it->incident2.approximate (HIncPrev);
+    }
 
-        FieldValue prevEy1 = valEy1->getPrevValue ();
-        FieldValue prevEy2 = valEy2->getPrevValue ();
+    /*
+     * Cell is updated by calculateEzStepPML if it is in box of Dz
+     */
+    const PMLBox *box = DzBoxes.find (pos, pos + GridCoordinate3D (1, 1, 1));
 
-        if (useTFSF)
-        {
-          calculateHxTFSF (posAbs, prevEz1, prevEz2, prevEy1, prevEy2, posDown, posUp, posBack, posFront);
-        }
+    if (box != NULLPTR)
+    {
+      GridCoordinate3D posD = pos - box->origin;
 
-        FPValue k_y = 1;
+      FieldValue valDz = EzProfileX.Cb[i] * (diffHy - diffHx);
 
-        FPValue Ca = (2 * eps0 * k_y - sigmaY * gridTimeStep) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
-        FPValue Cb = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
+      *box->D->getFieldValue (posD, 0) += valDz;
 
-        FieldValue val = calculateHx_3D_Precalc (valBx->getPrevValue (),
-                                                 prevEy1,
-                                                 prevEy2,
-                                                 prevEz1,
-                                                 prevEz2,
-                                                 Ca,
-                                                 Cb);
+      FPValue modifier = 1;
+      if (useMetamaterials)
+      {
+        valDz = EzDrude.get (pos).b0 * valDz;
 
-        valBx->setCurValue (val);
+        *box->D1->getFieldValue (posD, 0) += valDz;
+      }
+      else
+      {
+        modifier = EzMaterial.get (pos);
       }
-    }
-  }
 
-  if (useMetamaterials)
-  {
-    for (int i = HxStart.getX (); i < HxEnd.getX (); ++i)
+      EzCur[pos] += EzProfileZ.sum[k] * EzProfileY.inverseSum[j] / modifier * valDz;
+    }
+    else
     {
-      for (int j = HxStart.getY (); j < HxEnd.getY (); ++j)
+      if (useCPML)
       {
-        for (int k = HxStart.getZ (); k < HxEnd.getZ (); ++k)
+        FieldValue *psiX = EzPsiX.getValue (pos);
+        if (psiX != NULLPTR)
         {
-          GridCoordinate3D pos (i, j, k);
-          GridCoordinate3D posAbs = Hx.getTotalPosition (pos);
+          FieldValue valPsi = EzProfileX.c[i] * diffHy;
 
-          FieldPointValue* valB1x = B1x.getFieldPointValue (pos);
-          FieldPointValue* valBx = Bx.getFieldPointValue (pos);
+          *psiX += valPsi;
+          diffHy += valPsi;
+        }
 
-          FPValue omegaPM;
-          FPValue gammaM;
-          FPValue mu = yeeLayout->getMetaMaterial (posAbs, GridType::BX, Mu, GridType::MU, OmegaPM, GridType::OMEGAPM, GammaM, GridType::GAMMAM, omegaPM, gammaM);
+        FieldValue *psiY = EzPsiY.getValue (pos);
+        if (psiY != NULLPTR)
+        {
+          FieldValue valPsi = EzProfileY.c[j] * diffHx;
 
-          /*
-           * FIXME: precalculate coefficients
-           */
-          FPValue C = 4*mu0*mu + 2*gridTimeStep*mu0*mu*gammaM + mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM;
-
-          FieldValue val = calculateDrudeH (valBx->getCurValue (),
-                                            valBx->getPrevValue (),
-                                            valBx->getPrevPrevValue (),
-                                            valB1x->getPrevValue (),
-                                            valB1x->getPrevPrevValue (),
-                                            (4 + 2*gridTimeStep*gammaM) / C,
-                                            -8 / C,
-                                            (4 - 2*gridTimeStep*gammaM) / C,
-                                            (2*mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM - 8*mu0*mu) / C,
-                                            (4*mu0*mu - 2*gridTimeStep*mu0*mu*gammaM + mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM) / C);
-
-          valB1x->setCurValue (val);
+          *psiY += valPsi;
+          diffHx += valPsi;
         }
       }
+
+      EzCur[pos] += gridTimeStep / (EzMaterial.get (pos) * gridStep) * (diffHy - diffHx);
     }
   }
+}
 
-  for (int i = HxStart.getX (); i < HxEnd.getX (); ++i)
+void
+Scheme3D::calculateEzStep (time_step t, GridCoordinate3D EzStart, GridCoordinate3D EzEnd)
+{
+  GridCoordinate3D diffLeft = yeeLayout->getEzCircuitElementDiff (LayoutDirection::LEFT);
+  GridCoordinate3D diffRight = yeeLayout->getEzCircuitElementDiff (LayoutDirection::RIGHT);
+  GridCoordinate3D diffDown = yeeLayout->getEzCircuitElementDiff (LayoutDirection::DOWN);
+  GridCoordinate3D diffUp = yeeLayout->getEzCircuitElementDiff (LayoutDirection::UP);
+
+  calculateStepRows (Ez, Hy, diffRight, diffLeft, Hx, diffUp, diffDown, EzMaterial, EzCurlCoefficients,
+                     EzStart, EzEnd);
+}
+
+void
+Scheme3D::calculateEzStepPML (time_step t, GridCoordinate3D EzStart, GridCoordinate3D EzEnd)
+{
+  GridCoordinate3D diffLeft = yeeLayout->getEzCircuitElementDiff (LayoutDirection::LEFT);
+  GridCoordinate3D diffRight = yeeLayout->getEzCircuitElementDiff (LayoutDirection::RIGHT);
+  GridCoordinate3D diffDown = yeeLayout->getEzCircuitElementDiff (LayoutDirection::DOWN);
+  GridCoordinate3D diffUp = yeeLayout->getEzCircuitElementDiff (LayoutDirection::UP);
+
+  calculateStepPMLRows (GridType::EZ, Ez, DzBoxes, Hy, diffRight, diffLeft, Hx, diffUp, diffDown,
+                        EzStart, EzEnd);
+}
+
+void
+Scheme3D::calculateEzStepCPML (time_step t, GridCoordinate3D EzStart, GridCoordinate3D EzEnd)
+{
+  GridView<GridCoordinate3D> EzCur = Ez.getView (0);
+  GridView<GridCoordinate3D> EzPrev = Ez.getView (1);
+  GridView<GridCoordinate3D> HxPrev = Hx.getView (1);
+  GridView<GridCoordinate3D> HyPrev = Hy.getView (1);
+
+  GridCoordinate3D diffLeft = yeeLayout->getEzCircuitElementDiff (LayoutDirection::LEFT);
+  GridCoordinate3D diffRight = yeeLayout->getEzCircuitElementDiff (LayoutDirection::RIGHT);
+  GridCoordinate3D diffDown = yeeLayout->getEzCircuitElementDiff (LayoutDirection::DOWN);
+  GridCoordinate3D diffUp = yeeLayout->getEzCircuitElementDiff (LayoutDirection::UP);
+
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
+  for (int i = EzStart.getX (); i < EzEnd.getX (); ++i)
   {
-    for (int j = HxStart.getY (); j < HxEnd.getY (); ++j)
+    for (int j = EzStart.getY (); j < EzEnd.getY (); ++j)
     {
-      for (int k = HxStart.getZ (); k < HxEnd.getZ (); ++k)
+      for (int k = EzStart.getZ (); k < EzEnd.getZ (); ++k)
       {
         GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Hx.getTotalPosition (pos);
 
-        FieldPointValue* valHx = Hx.getFieldPointValue (pos);
+        GridCoordinate3D posLeft = pos + diffLeft;
+        GridCoordinate3D posRight = pos + diffRight;
+        GridCoordinate3D posDown = pos + diffDown;
+        GridCoordinate3D posUp = pos + diffUp;
 
-        FieldPointValue* valBx;
+        FieldValue prevHx1 = HxPrev[posUp];
+        FieldValue prevHx2 = HxPrev[posDown];
+        FieldValue prevHy1 = HyPrev[posRight];
+        FieldValue prevHy2 = HyPrev[posLeft];
 
-        if (useMetamaterials)
-        {
-          valBx = B1x.getFieldPointValue (pos);
-        }
-        else
+        /*
+         * Recursive convolutions of derivatives are added to values with higher coordinates
+         */
+        FieldValue *psiX = EzPsiX.getValue (pos);
+        if (psiX != NULLPTR)
         {
-          valBx = Bx.getFieldPointValue (pos);
+          *psiX = EzProfileX.b[i] * *psiX + EzProfileX.c[i] * (prevHy1 - prevHy2);
+          prevHy1 += *psiX;
         }
 
-        FPValue mu = yeeLayout->getMaterial (posAbs, GridType::BX, Mu, GridType::MU);
-        FPValue sigmaX = yeeLayout->getMaterial (posAbs, GridType::BX, SigmaX, GridType::SIGMAX);
-        FPValue sigmaZ = yeeLayout->getMaterial (posAbs, GridType::BX, SigmaZ, GridType::SIGMAZ);
-
-        FPValue modifier = mu * mu0;
-        if (useMetamaterials)
+        FieldValue *psiY = EzPsiY.getValue (pos);
+        if (psiY != NULLPTR)
         {
-          modifier = 1;
+          *psiY = EzProfileY.b[j] * *psiY + EzProfileY.c[j] * (prevHx1 - prevHx2);
+          prevHx1 += *psiY;
         }
 
-        FPValue k_x = 1;
-        FPValue k_z = 1;
-
-        FPValue Ca = (2 * eps0 * k_z - sigmaZ * gridTimeStep) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
-        FPValue Cb = ((2 * eps0 * k_x + sigmaX * gridTimeStep) / (modifier)) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
-        FPValue Cc = ((2 * eps0 * k_x - sigmaX * gridTimeStep) / (modifier)) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
-
-        FieldValue val = calculateHx_from_Bx_Precalc (valHx->getPrevValue (),
-                                                      valBx->getCurValue (),
-                                                      valBx->getPrevValue (),
-                                                      Ca,
-                                                      Cb,
-                                                      Cc);
+        FieldValue val = calculateEz_3D (EzPrev[pos],
+                                         prevHy1,
+                                         prevHy2,
+                                         prevHx1,
+                                         prevHx2,
+                                         gridTimeStep,
+                                         gridStep,
+                                         EzMaterial.get (pos));
 
-        valHx->setCurValue (val);
+        EzCur[pos] = val;
       }
     }
   }
 }
 
+/**
+ * Update Hx in box of zero conductivity of PML. Drude model is applied only by PML update, so it is used in box of
+ * cells of Drude model and plain update is used around it.
+ */
 void
-Scheme3D::performHySteps (time_step t, GridCoordinate3D HyStart, GridCoordinate3D HyEnd)
+Scheme3D::performHxDrudeSteps (time_step t, GridCoordinate3D HxStart, GridCoordinate3D HxEnd)
+{
+  performSplitSteps (t, HxStart, HxEnd, BxBoxes.drudeStart, BxBoxes.drudeEnd,
+                     &Scheme3D::calculateHxStepPML,
+                     &Scheme3D::calculateHxStep);
+} /* Scheme3D::performHxDrudeSteps */
+
+void
+Scheme3D::performHxSteps (time_step t, GridCoordinate3D HxStart, GridCoordinate3D HxEnd)
 {
   /*
    * FIXME: check performed on each iteration
    */
   if (usePML)
   {
-    calculateHyStepPML (t, HyStart, HyEnd);
+    performSplitSteps (t, HxStart, HxEnd,
+                       GridCoordinate3D (HxProfileX.interiorStart, HxProfileY.interiorStart, HxProfileZ.interiorStart),
+                       GridCoordinate3D (HxProfileX.interiorEnd, HxProfileY.interiorEnd, HxProfileZ.interiorEnd),
+                       useMetamaterials ? &Scheme3D::performHxDrudeSteps : &Scheme3D::calculateHxStep,
+                       useCPML ? &Scheme3D::calculateHxStepCPML : &Scheme3D::calculateHxStepPML);
   }
   else
   {
-    calculateHyStep (t, HyStart, HyEnd);
+    calculateHxStep (t, HxStart, HxEnd);
+  }
+
+  /*
+   * Updates above do not take TF/SF into account, corrections are applied only to cells on border of TF/SF area
+   */
+  if (useTFSF)
+  {
+    calculateHxTFSF (HxStart, HxEnd);
   }
 }
 
 void
-Scheme3D::calculateHyTFSF (GridCoordinate3D posAbs,
-                           FieldValue &valEz1,
-                           FieldValue &valEz2,
-                           FieldValue &valEx1,
-                           FieldValue &valEx2,
-                           GridCoordinate3D posLeft,
-                           GridCoordinate3D posRight,
-                           GridCoordinate3D posBack,
-                           GridCoordinate3D posFront)
+Scheme3D::calculateHxTFSF (GridCoordinate3D HxStart, GridCoordinate3D HxEnd)
 {
-  bool do_need_update_left = yeeLayout->doNeedTFSFUpdateHyBorder (posAbs, LayoutDirection::LEFT, DO_USE_3D_MODE);
-  bool do_need_update_right = yeeLayout->doNeedTFSFUpdateHyBorder (posAbs, LayoutDirection::RIGHT, DO_USE_3D_MODE);
-
-  bool do_need_update_back = yeeLayout->doNeedTFSFUpdateHyBorder (posAbs, LayoutDirection::BACK, DO_USE_3D_MODE);
-  bool do_need_update_front = yeeLayout->doNeedTFSFUpdateHyBorder (posAbs, LayoutDirection::FRONT, DO_USE_3D_MODE);
+  GridView<GridCoordinate3D> HxCur = Hx.getView (0);
 
-  GridCoordinate3D auxPosX;
-  GridCoordinate3D auxPosZ;
-  FieldValue diffX;
-  FieldValue diffZ;
+  GridView<GridCoordinate1D> EIncPrev = EInc.getView (1);
 
-  if (do_need_update_left)
-  {
-    auxPosX = posLeft;
-  }
-  else if (do_need_update_right)
+  for (std::vector<TFSFCell>::const_iterator it = findTFSFCell (HxTFSFCells, HxStart.getX ());
+       it != HxTFSFCells.end () && it->pos.getX () < HxEnd.getX ();
+       ++it)
   {
-    auxPosX = posRight;
-  }
+    GridCoordinate3D pos = it->pos;
 
-  if (do_need_update_back)
-  {
-    auxPosZ = posBack;
-  }
-  else if (do_need_update_front)
-  {
-    auxPosZ = posFront;
-  }
+    if (!(pos >= HxStart && pos < HxEnd))
+    {
+      continue;
+    }
 
-  if (do_need_update_left || do_need_update_right)
-  {
-    GridCoordinateFP3D realCoord = yeeLayout->getEzCoordFP (Ez.getTotalPosition (auxPosX));
+    grid_coord i = pos.getX ();
+    grid_coord j = pos.getY ();
+    grid_coord k = pos.getZ ();
 
-    diffX = yeeLayout->getEzFromIncidentE (approximateIncidentWaveE (realCoord));
-  }
+    FieldValue diffEy (0);
+    FieldValue diffEz (0);
 
-  if (do_need_update_back || do_need_update_front)
-  {
-    GridCoordinateFP3D realCoord = yeeLayout->getExCoordFP (Ex.getTotalPosition (auxPosZ));
+    if (it->factor1 != 0)
+    {
+      diffEy = it->factor1 * it->incident1.approximate (EIncPrev);
+    }
 
-    diffZ = yeeLayout->getExFromIncidentE (approximateIncidentWaveE (realCoord));
-  }
+    if (it->factor2 != 0)
+    {
+      diffEz = it->factor2 * it->incident2.approximate (EIncPrev);
+    }
 
-  if (do_need_update_left)
-  {
-    valEz2 += diffX;
-  }
-  else if (do_need_update_right)
-  {
-    valEz1 += diffX;
-  }
+    /*
+     * Cell is updated by calculateHxStepPML if it is in box of Bx
+     */
+    const PMLBox *box = BxBoxes.find (pos, pos + GridCoordinate3D (1, 1, 1));
 
-  if (do_need_update_back)
-  {
-    valEx2 += diffZ;
-  }
-  else if (do_need_update_front)
-  {
-    valEx1 += diffZ;
+    if (box != NULLPTR)
+    {
+      GridCoordinate3D posD = pos - box->origin;
+
+      FieldValue valBx = HxProfileY.Cb[j] * (diffEy - diffEz);
+
+      *box->D->getFieldValue (posD, 0) += valBx;
+
+      FPValue modifier = 1;
+      if (useMetamaterials)
+      {
+        valBx = HxDrude.get (pos).b0 * valBx;
+
+        *box->D1->getFieldValue (posD, 0) += valBx;
+      }
+      else
+      {
+        modifier = HxMaterial.get (pos);
+      }
+
+      HxCur[pos] += HxProfileX.sum[i] * HxProfileZ.inverseSum[k] / modifier * valBx;
+    }
+    else
+    {
+      if (useCPML)
+      {
+        FieldValue *psiZ = HxPsiZ.getValue (pos);
+        if (psiZ != NULLPTR)
+        {
+          FieldValue valPsi = HxProfileZ.c[k] * diffEy;
+
+          *psiZ += valPsi;
+          diffEy += valPsi;
+        }
+
+        FieldValue *psiY = HxPsiY.getValue (pos);
+        if (psiY != NULLPTR)
+        {
+          FieldValue valPsi = HxProfileY.c[j] * diffEz;
+
+          *psiY += valPsi;
+          diffEz += valPsi;
+        }
+      }
+
+      HxCur[pos] += gridTimeStep / (HxMaterial.get (pos) * gridStep) * (diffEy - diffEz);
+    }
   }
 }
 
 void
-Scheme3D::calculateHyStep (time_step t, GridCoordinate3D HyStart, GridCoordinate3D HyEnd)
+Scheme3D::calculateHxStep (time_step t, GridCoordinate3D HxStart, GridCoordinate3D HxEnd)
 {
-  FPValue eps0 = PhysicsConst::Eps0;
-  FPValue mu0 = PhysicsConst::Mu0;
+  GridCoordinate3D diffDown = yeeLayout->getHxCircuitElementDiff (LayoutDirection::DOWN);
+  GridCoordinate3D diffUp = yeeLayout->getHxCircuitElementDiff (LayoutDirection::UP);
+  GridCoordinate3D diffBack = yeeLayout->getHxCircuitElementDiff (LayoutDirection::BACK);
+  GridCoordinate3D diffFront = yeeLayout->getHxCircuitElementDiff (LayoutDirection::FRONT);
 
-  for (int i = HyStart.getX (); i < HyEnd.getX (); ++i)
+  calculateStepRows (Hx, Ey, diffFront, diffBack, Ez, diffUp, diffDown, HxMaterial, HxCurlCoefficients,
+                     HxStart, HxEnd);
+}
+
+void
+Scheme3D::calculateHxStepPML (time_step t, GridCoordinate3D HxStart, GridCoordinate3D HxEnd)
+{
+  GridCoordinate3D diffDown = yeeLayout->getHxCircuitElementDiff (LayoutDirection::DOWN);
+  GridCoordinate3D diffUp = yeeLayout->getHxCircuitElementDiff (LayoutDirection::UP);
+  GridCoordinate3D diffBack = yeeLayout->getHxCircuitElementDiff (LayoutDirection::BACK);
+  GridCoordinate3D diffFront = yeeLayout->getHxCircuitElementDiff (LayoutDirection::FRONT);
+
+  calculateStepPMLRows (GridType::HX, Hx, BxBoxes, Ey, diffFront, diffBack, Ez, diffUp, diffDown,
+                        HxStart, HxEnd);
+}
+
+void
+Scheme3D::calculateHxStepCPML (time_step t, GridCoordinate3D HxStart, GridCoordinate3D HxEnd)
+{
+  GridView<GridCoordinate3D> HxCur = Hx.getView (0);
+  GridView<GridCoordinate3D> HxPrev = Hx.getView (1);
+  GridView<GridCoordinate3D> EzPrev = Ez.getView (1);
+  GridView<GridCoordinate3D> EyPrev = Ey.getView (1);
+
+  GridCoordinate3D diffDown = yeeLayout->getHxCircuitElementDiff (LayoutDirection::DOWN);
+  GridCoordinate3D diffUp = yeeLayout->getHxCircuitElementDiff (LayoutDirection::UP);
+  GridCoordinate3D diffBack = yeeLayout->getHxCircuitElementDiff (LayoutDirection::BACK);
+  GridCoordinate3D diffFront = yeeLayout->getHxCircuitElementDiff (LayoutDirection::FRONT);
+
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
+  for (int i = HxStart.getX (); i < HxEnd.getX (); ++i)
   {
-    for (int j = HyStart.getY (); j < HyEnd.getY (); ++j)
+    for (int j = HxStart.getY (); j < HxEnd.getY (); ++j)
     {
-      for (int k = HyStart.getZ (); k < HyEnd.getZ (); ++k)
+      for (int k = HxStart.getZ (); k < HxEnd.getZ (); ++k)
       {
         GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Hy.getTotalPosition (pos);
-
-        FieldPointValue* valHy = Hy.getFieldPointValue (pos);
 
-        FPValue mu = yeeLayout->getMaterial (posAbs, GridType::HY, Mu, GridType::MU);
+        GridCoordinate3D posDown = pos + diffDown;
+        GridCoordinate3D posUp = pos + diffUp;
+        GridCoordinate3D posBack = pos + diffBack;
+        GridCoordinate3D posFront = pos + diffFront;
 
-        GridCoordinate3D posLeft = yeeLayout->getHyCircuitElement (pos, LayoutDirection::LEFT);
-        GridCoordinate3D posRight = yeeLayout->getHyCircuitElement (pos, LayoutDirection::RIGHT);
-        GridCoordinate3D posBack = yeeLayout->getHyCircuitElement (pos, LayoutDirection::BACK);
-        GridCoordinate3D posFront = yeeLayout->getHyCircuitElement (pos, LayoutDirection::FRONT);
+        FieldValue prevEz1 = EzPrev[posUp];
+        FieldValue prevEz2 = EzPrev[posDown];
 
-        FieldPointValue* valEz1 = Ez.getFieldPointValue (posRight);
-        FieldPointValue* valEz2 = Ez.getFieldPointValue (posLeft);
+        FieldValue prevEy1 = EyPrev[posFront];
+        FieldValue prevEy2 = EyPrev[posBack];
 
-        FieldPointValue* valEx1 = Ex.getFieldPointValue (posFront);
-        FieldPointValue* valEx2 = Ex.getFieldPointValue (posBack);
-
-        FieldValue prevEz1 = valEz1->getPrevValue ();
-        FieldValue prevEz2 = valEz2->getPrevValue ();
-
-        FieldValue prevEx1 = valEx1->getPrevValue ();
-        FieldValue prevEx2 = valEx2->getPrevValue ();
+        /*
+         * Recursive convolutions of derivatives are added to values with higher coordinates
+         */
+        FieldValue *psiZ = HxPsiZ.getValue (pos);
+        if (psiZ != NULLPTR)
+        {
+          *psiZ = HxProfileZ.b[k] * *psiZ + HxProfileZ.c[k] * (prevEy1 - prevEy2);
+          prevEy1 += *psiZ;
+        }
 
-        if (useTFSF)
+        FieldValue *psiY = HxPsiY.getValue (pos);
+        if (psiY != NULLPTR)
         {
-          calculateHyTFSF (posAbs, prevEz1, prevEz2, prevEx1, prevEx2, posLeft, posRight, posBack, posFront);
+          *psiY = HxProfileY.b[j] * *psiY + HxProfileY.c[j] * (prevEz1 - prevEz2);
+          prevEz1 += *psiY;
         }
 
-        FieldValue val = calculateHy_3D (valHy->getPrevValue (),
+        FieldValue val = calculateHx_3D (HxPrev[pos],
+                                         prevEy1,
+                                         prevEy2,
                                          prevEz1,
                                          prevEz2,
-                                         prevEx1,
-                                         prevEx2,
                                          gridTimeStep,
                                          gridStep,
-                                         mu * mu0);
+                                         HxMaterial.get (pos));
 
-        valHy->setCurValue (val);
+        HxCur[pos] = val;
       }
     }
   }
 }
 
+/**
+ * Update Hy in box of zero conductivity of PML. Drude model is applied only by PML update, so it is used in box of
+ * cells of Drude model and plain update is used around it.
+ */
 void
-Scheme3D::calculateHyStepPML (time_step t, GridCoordinate3D HyStart, GridCoordinate3D HyEnd)
+Scheme3D::performHyDrudeSteps (time_step t, GridCoordinate3D HyStart, GridCoordinate3D HyEnd)
 {
-  FPValue eps0 = PhysicsConst::Eps0;
-  FPValue mu0 = PhysicsConst::Mu0;
+  performSplitSteps (t, HyStart, HyEnd, ByBoxes.drudeStart, ByBoxes.drudeEnd,
+                     &Scheme3D::calculateHyStepPML,
+                     &Scheme3D::calculateHyStep);
+} /* Scheme3D::performHyDrudeSteps */
 
-  for (int i = HyStart.getX (); i < HyEnd.getX (); ++i)
+void
+Scheme3D::performHySteps (time_step t, GridCoordinate3D HyStart, GridCoordinate3D HyEnd)
+{
+  /*
+   * FIXME: check performed on each iteration
+   */
+  if (usePML)
   {
-    for (int j = HyStart.getY (); j < HyEnd.getY (); ++j)
-    {
-      for (int k = HyStart.getZ (); k < HyEnd.getZ (); ++k)
-      {
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Hy.getTotalPosition (pos);
+    performSplitSteps (t, HyStart, HyEnd,
+                       GridCoordinate3D (HyProfileX.interiorStart, HyProfileY.interiorStart, HyProfileZ.interiorStart),
+                       GridCoordinate3D (HyProfileX.interiorEnd, HyProfileY.interiorEnd, HyProfileZ.interiorEnd),
+                       useMetamaterials ? &Scheme3D::performHyDrudeSteps : &Scheme3D::calculateHyStep,
+                       useCPML ? &Scheme3D::calculateHyStepCPML : &Scheme3D::calculateHyStepPML);
+  }
+  else
+  {
+    calculateHyStep (t, HyStart, HyEnd);
+  }
+
+  /*
+   * Updates above do not take TF/SF into account, corrections are applied only to cells on border of TF/SF area
+   */
+  if (useTFSF)
+  {
+    calculateHyTFSF (HyStart, HyEnd);
+  }
+}
+
+void
+Scheme3D::calculateHyTFSF (GridCoordinate3D HyStart, GridCoordinate3D HyEnd)
+{
+  GridView<GridCoordinate3D> HyCur = Hy.getView (0);
 
-        FieldPointValue* valBy = By.getFieldPointValue (pos);
+  GridView<GridCoordinate1D> EIncPrev = EInc.getView (1);
 
-        FPValue sigmaZ = yeeLayout->getMaterial (posAbs, GridType::BY, SigmaZ, GridType::SIGMAZ);
+  for (std::vector<TFSFCell>::const_iterator it = findTFSFCell (HyTFSFCells, HyStart.getX ());
+       it != HyTFSFCells.end () && it->pos.getX () < HyEnd.getX ();
+       ++it)
+  {
+    GridCoordinate3D pos = it->pos;
 
-        GridCoordinate3D posLeft = yeeLayout->getHyCircuitElement (pos, LayoutDirection::LEFT);
-        GridCoordinate3D posRight = yeeLayout->getHyCircuitElement (pos, LayoutDirection::RIGHT);
-        GridCoordinate3D posBack = yeeLayout->getHyCircuitElement (pos, LayoutDirection::BACK);
-        GridCoordinate3D posFront = yeeLayout->getHyCircuitElement (pos, LayoutDirection::FRONT);
+    if (!(pos >= HyStart && pos < HyEnd))
+    {
+      continue;
+    }
 
-        FieldPointValue* valEz1 = Ez.getFieldPointValue (posRight);
-        FieldPointValue* valEz2 = Ez.getFieldPointValue (posLeft);
+    grid_coord i = pos.getX ();
+    grid_coord j = pos.getY ();
+    grid_coord k = pos.getZ ();
 
-        FieldPointValue* valEx1 = Ex.getFieldPointValue (posFront);
-        FieldPointValue* valEx2 = Ex.getFieldPointValue (posBack);
+    FieldValue diffEz (0);
+    FieldValue diffEx (0);
 
-        FieldValue prevEz1 = valEz1->getPrevValue ();
-        FieldValue prevEz2 = valEz2->getPrevValue ();
+    if (it->factor1 != 0)
+    {
+      diffEz = it->factor1 * it->incident1.approximate (EIncPrev);
+    }
 
-        FieldValue prevEx1 = valEx1->getPrevValue ();
-        FieldValue prevEx2 = valEx2->getPrevValue ();
+    if (it->factor2 != 0)
+    {
+      diffEx = it->factor2 * it->incident2.approximate (EIncPrev);
+    }
 
-        if (useTFSF)
-        {
-          calculateHyTFSF (posAbs, prevEz1, prevEz2, prevEx1, prevEx2, posLeft, posRight, posBack, posFront);
-        }
+    /*
+     * Cell is updated by calculateHyStepPML if it is in box of By
+     */
+    const PMLBox *box = ByBoxes.find (pos, pos + GridCoordinate3D (1, 1, 1));
 
-        FPValue k_z = 1;
+    if (box != NULLPTR)
+    {
+      GridCoordinate3D posD = pos - box->origin;
+
+      FieldValue valBy = HyProfileZ.Cb[k] * (diffEz - diffEx);
 
-        FPValue Ca = (2 * eps0 * k_z - sigmaZ * gridTimeStep) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
-        FPValue Cb = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
+      *box->D->getFieldValue (posD, 0) += valBy;
 
-        FieldValue val = calculateHy_3D_Precalc (valBy->getPrevValue (),
-                                                 prevEz1,
-                                                 prevEz2,
-                                                 prevEx1,
-                                                 prevEx2,
-                                                 Ca,
-                                                 Cb);
+      FPValue modifier = 1;
+      if (useMetamaterials)
+      {
+        valBy = HyDrude.get (pos).b0 * valBy;
 
-        valBy->setCurValue (val);
+        *box->D1->getFieldValue (posD, 0) += valBy;
+      }
+      else
+      {
+        modifier = HyMaterial.get (pos);
       }
-    }
-  }
 
-  if (useMetamaterials)
-  {
-    for (int i = HyStart.getX (); i < HyEnd.getX (); ++i)
+      HyCur[pos] += HyProfileY.sum[j] * HyProfileX.inverseSum[i] / modifier * valBy;
+    }
+    else
     {
-      for (int j = HyStart.getY (); j < HyEnd.getY (); ++j)
+      if (useCPML)
       {
-        for (int k = HyStart.getZ (); k < HyEnd.getZ (); ++k)
+        FieldValue *psiX = HyPsiX.getValue (pos);
+        if (psiX != NULLPTR)
         {
-          GridCoordinate3D pos (i, j, k);
-          GridCoordinate3D posAbs = Hy.getTotalPosition (pos);
+          FieldValue valPsi = HyProfileX.c[i] * diffEz;
 
-          FieldPointValue* valB1y = B1y.getFieldPointValue (pos);
-          FieldPointValue* valBy = By.getFieldPointValue (pos);
+          *psiX += valPsi;
+          diffEz += valPsi;
+        }
 
-          FPValue omegaPM;
-          FPValue gammaM;
-          FPValue mu = yeeLayout->getMetaMaterial (posAbs, GridType::BY, Mu, GridType::MU, OmegaPM, GridType::OMEGAPM, GammaM, GridType::GAMMAM, omegaPM, gammaM);
+        FieldValue *psiZ = HyPsiZ.getValue (pos);
+        if (psiZ != NULLPTR)
+        {
+          FieldValue valPsi = HyProfileZ.c[k] * diffEx;
 
-          /*
-           * FIXME: precalculate coefficients
-           */
-          FPValue C = 4*mu0*mu + 2*gridTimeStep*mu0*mu*gammaM + mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM;
-
-          FieldValue val = calculateDrudeH (valBy->getCurValue (),
-                                            valBy->getPrevValue (),
-                                            valBy->getPrevPrevValue (),
-                                            valB1y->getPrevValue (),
-                                            valB1y->getPrevPrevValue (),
-                                            (4 + 2*gridTimeStep*gammaM) / C,
-                                            -8 / C,
-                                            (4 - 2*gridTimeStep*gammaM) / C,
-                                            (2*mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM - 8*mu0*mu) / C,
-                                            (4*mu0*mu - 2*gridTimeStep*mu0*mu*gammaM + mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM) / C);
-
-          valB1y->setCurValue (val);
+          *psiZ += valPsi;
+          diffEx += valPsi;
         }
       }
+
+      HyCur[pos] += gridTimeStep / (HyMaterial.get (pos) * gridStep) * (diffEz - diffEx);
     }
   }
+}
+
+void
+Scheme3D::calculateHyStep (time_step t, GridCoordinate3D HyStart, GridCoordinate3D HyEnd)
+{
+  GridCoordinate3D diffLeft = yeeLayout->getHyCircuitElementDiff (LayoutDirection::LEFT);
+  GridCoordinate3D diffRight = yeeLayout->getHyCircuitElementDiff (LayoutDirection::RIGHT);
+  GridCoordinate3D diffBack = yeeLayout->getHyCircuitElementDiff (LayoutDirection::BACK);
+  GridCoordinate3D diffFront = yeeLayout->getHyCircuitElementDiff (LayoutDirection::FRONT);
+
+  calculateStepRows (Hy, Ez, diffRight, diffLeft, Ex, diffFront, diffBack, HyMaterial, HyCurlCoefficients,
+                     HyStart, HyEnd);
+}
+
+void
+Scheme3D::calculateHyStepPML (time_step t, GridCoordinate3D HyStart, GridCoordinate3D HyEnd)
+{
+  GridCoordinate3D diffLeft = yeeLayout->getHyCircuitElementDiff (LayoutDirection::LEFT);
+  GridCoordinate3D diffRight = yeeLayout->getHyCircuitElementDiff (LayoutDirection::RIGHT);
+  GridCoordinate3D diffBack = yeeLayout->getHyCircuitElementDiff (LayoutDirection::BACK);
+  GridCoordinate3D diffFront = yeeLayout->getHyCircuitElementDiff (LayoutDirection::FRONT);
+
+  calculateStepPMLRows (GridType::HY, Hy, ByBoxes, Ez, diffRight, diffLeft, Ex, diffFront, diffBack,
+                        HyStart, HyEnd);
+}
 
+void
+Scheme3D::calculateHyStepCPML (time_step t, GridCoordinate3D HyStart, GridCoordinate3D HyEnd)
+{
+  GridView<GridCoordinate3D> HyCur = Hy.getView (0);
+  GridView<GridCoordinate3D> HyPrev = Hy.getView (1);
+  GridView<GridCoordinate3D> EzPrev = Ez.getView (1);
+  GridView<GridCoordinate3D> ExPrev = Ex.getView (1);
+
+  GridCoordinate3D diffLeft = yeeLayout->getHyCircuitElementDiff (LayoutDirection::LEFT);
+  GridCoordinate3D diffRight = yeeLayout->getHyCircuitElementDiff (LayoutDirection::RIGHT);
+  GridCoordinate3D diffBack = yeeLayout->getHyCircuitElementDiff (LayoutDirection::BACK);
+  GridCoordinate3D diffFront = yeeLayout->getHyCircuitElementDiff (LayoutDirection::FRONT);
+
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (int i = HyStart.getX (); i < HyEnd.getX (); ++i)
   {
     for (int j = HyStart.getY (); j < HyEnd.getY (); ++j)
@@ -1556,51 +1707,62 @@ Scheme3D::calculateHyStepPML (time_step t, GridCoordinate3D HyStart, GridCoordin
       for (int k = HyStart.getZ (); k < HyEnd.getZ (); ++k)
       {
         GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Hy.getTotalPosition (pos);
 
-        FieldPointValue* valHy = Hy.getFieldPointValue (pos);
+        GridCoordinate3D posLeft = pos + diffLeft;
+        GridCoordinate3D posRight = pos + diffRight;
+        GridCoordinate3D posBack = pos + diffBack;
+        GridCoordinate3D posFront = pos + diffFront;
 
-        FieldPointValue* valBy;
+        FieldValue prevEz1 = EzPrev[posRight];
+        FieldValue prevEz2 = EzPrev[posLeft];
 
-        if (useMetamaterials)
-        {
-          valBy = B1y.getFieldPointValue (pos);
-        }
-        else
+        FieldValue prevEx1 = ExPrev[posFront];
+        FieldValue prevEx2 = ExPrev[posBack];
+
+        /*
+         * Recursive convolutions of derivatives are added to values with higher coordinates
+         */
+        FieldValue *psiX = HyPsiX.getValue (pos);
+        if (psiX != NULLPTR)
         {
-          valBy = By.getFieldPointValue (pos);
+          *psiX = HyProfileX.b[i] * *psiX + HyProfileX.c[i] * (prevEz1 - prevEz2);
+          prevEz1 += *psiX;
         }
 
-        FPValue mu = yeeLayout->getMaterial (posAbs, GridType::BY, Mu, GridType::MU);
-        FPValue sigmaX = yeeLayout->getMaterial (posAbs, GridType::BY, SigmaX, GridType::SIGMAX);
-        FPValue sigmaY = yeeLayout->getMaterial (posAbs, GridType::BY, SigmaY, GridType::SIGMAY);
-
-        FPValue modifier = mu * mu0;
-        if (useMetamaterials)
+        FieldValue *psiZ = HyPsiZ.getValue (pos);
+        if (psiZ != NULLPTR)
         {
-          modifier = 1;
+          *psiZ = HyProfileZ.b[k] * *psiZ + HyProfileZ.c[k] * (prevEx1 - prevEx2);
+          prevEx1 += *psiZ;
         }
 
-        FPValue k_x = 1;
-        FPValue k_y = 1;
-
-        FPValue Ca = (2 * eps0 * k_x - sigmaX * gridTimeStep) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
-        FPValue Cb = ((2 * eps0 * k_y + sigmaY * gridTimeStep) / (modifier)) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
-        FPValue Cc = ((2 * eps0 * k_y - sigmaY * gridTimeStep) / (modifier)) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
-
-        FieldValue val = calculateHy_from_By_Precalc (valHy->getPrevValue (),
-                                                      valBy->getCurValue (),
-                                                      valBy->getPrevValue (),
-                                                      Ca,
-                                                      Cb,
-                                                      Cc);
+        FieldValue val = calculateHy_3D (HyPrev[pos],
+                                         prevEz1,
+                                         prevEz2,
+                                         prevEx1,
+                                         prevEx2,
+                                         gridTimeStep,
+                                         gridStep,
+                                         HyMaterial.get (pos));
 
-        valHy->setCurValue (val);
+        HyCur[pos] = val;
       }
     }
   }
 }
 
+/**
+ * Update Hz in box of zero conductivity of PML. Drude model is applied only by PML update, so it is used in box of
+ * cells of Drude model and plain update is used around it.
+ */
+void
+Scheme3D::performHzDrudeSteps (time_step t, GridCoordinate3D HzStart, GridCoordinate3D HzEnd)
+{
+  performSplitSteps (t, HzStart, HzEnd, BzBoxes.drudeStart, BzBoxes.drudeEnd,
+                     &Scheme3D::calculateHzStepPML,
+                     &Scheme3D::calculateHzStep);
+} /* Scheme3D::performHzDrudeSteps */
+
 void
 Scheme3D::performHzSteps (time_step t, GridCoordinate3D HzStart, GridCoordinate3D HzEnd)
 {
@@ -1609,92 +1771,156 @@ Scheme3D::performHzSteps (time_step t, GridCoordinate3D HzStart, GridCoordinate3
    */
   if (usePML)
   {
-    calculateHzStepPML (t, HzStart, HzEnd);
+    performSplitSteps (t, HzStart, HzEnd,
+                       GridCoordinate3D (HzProfileX.interiorStart, HzProfileY.interiorStart, HzProfileZ.interiorStart),
+                       GridCoordinate3D (HzProfileX.interiorEnd, HzProfileY.interiorEnd, HzProfileZ.interiorEnd),
+                       useMetamaterials ? &Scheme3D::performHzDrudeSteps : &Scheme3D::calculateHzStep,
+                       useCPML ? &Scheme3D::calculateHzStepCPML : &Scheme3D::calculateHzStepPML);
   }
   else
   {
     calculateHzStep (t, HzStart, HzEnd);
   }
+
+  /*
+   * Updates above do not take TF/SF into account, corrections are applied only to cells on border of TF/SF area
+   */
+  if (useTFSF)
+  {
+    calculateHzTFSF (HzStart, HzEnd);
+  }
 }
 
 void
-Scheme3D::calculateHzTFSF (GridCoordinate3D posAbs,
-                           FieldValue &valEx1,
-                           FieldValue &valEx2,
-                           FieldValue &valEy1,
-                           FieldValue &valEy2,
-                           GridCoordinate3D posLeft,
-                           GridCoordinate3D posRight,
-                           GridCoordinate3D posDown,
-                           GridCoordinate3D posUp)
+Scheme3D::calculateHzTFSF (GridCoordinate3D HzStart, GridCoordinate3D HzEnd)
 {
-  bool do_need_update_left = yeeLayout->doNeedTFSFUpdateHzBorder (posAbs, LayoutDirection::LEFT, DO_USE_3D_MODE);
-  bool do_need_update_right = yeeLayout->doNeedTFSFUpdateHzBorder (posAbs, LayoutDirection::RIGHT, DO_USE_3D_MODE);
-  bool do_need_update_down = yeeLayout->doNeedTFSFUpdateHzBorder (posAbs, LayoutDirection::DOWN, DO_USE_3D_MODE);
-  bool do_need_update_up = yeeLayout->doNeedTFSFUpdateHzBorder (posAbs, LayoutDirection::UP, DO_USE_3D_MODE);
+  GridView<GridCoordinate3D> HzCur = Hz.getView (0);
 
-  GridCoordinate3D auxPosX;
-  GridCoordinate3D auxPosY;
-  FieldValue diffX;
-  FieldValue diffY;
+  GridView<GridCoordinate1D> EIncPrev = EInc.getView (1);
 
-  if (do_need_update_left)
+  for (std::vector<TFSFCell>::const_iterator it = findTFSFCell (HzTFSFCells, HzStart.getX ());
+       it != HzTFSFCells.end () && it->pos.getX () < HzEnd.getX ();
+       ++it)
   {
-    auxPosX = posLeft;
-  }
-  else if (do_need_update_right)
-  {
-    auxPosX = posRight;
-  }
+    GridCoordinate3D pos = it->pos;
 
-  if (do_need_update_down)
-  {
-    auxPosY = posDown;
-  }
-  else if (do_need_update_up)
-  {
-    auxPosY = posUp;
-  }
+    if (!(pos >= HzStart && pos < HzEnd))
+    {
+      continue;
+    }
 
-  if (do_need_update_down || do_need_update_up)
-  {
-    GridCoordinateFP3D realCoord = yeeLayout->getExCoordFP (Ex.getTotalPosition (auxPosY));
+    grid_coord i = pos.getX ();
+    grid_coord j = pos.getY ();
+    grid_coord k = pos.getZ ();
 
-    diffY = yeeLayout->getExFromIncidentE (approximateIncidentWaveE (realCoord));
-  }
+    FieldValue diffEx (0);
+    FieldValue diffEy (0);
 
-  if (do_need_update_left || do_need_update_right)
-  {
-    GridCoordinateFP3D realCoord = yeeLayout->getEyCoordFP (Ey.getTotalPosition (auxPosX));
+    if (it->factor1 != 0)
+    {
+      diffEx = it->factor1 * it->incident1.approximate (EIncPrev);
+    }
 
-    diffX = yeeLayout->getEyFromIncidentE (approximateIncidentWaveE (realCoord));
-  }
+    if (it->factor2 != 0)
+    {
+      diffEy = it->factor2 * it->incident2.approximate (EIncPrev);
+    }
 
-  if (do_need_update_down)
-  {
-    valEx2 += diffY;
-  }
-  else if (do_need_update_up)
-  {
-    valEx1 += diffY;
-  }
+    /*
+     * Cell is updated by calculateHzStepPML if it is in box of Bz
+     */
+    const PMLBox *box = BzBoxes.find (pos, pos + GridCoordinate3D (1, 1, 1));
 
-  if (do_need_update_left)
-  {
-    valEy2 += diffX;
-  }
-  else if (do_need_update_right)
-  {
-    valEy1 += diffX;
+    if (box != NULLPTR)
+    {
+      GridCoordinate3D posD = pos - box->origin;
+
+      FieldValue valBz = HzProfileX.Cb[i] * (diffEx - diffEy);
+
+      *box->D->getFieldValue (posD, 0) += valBz;
+
+      FPValue modifier = 1;
+      if (useMetamaterials)
+      {
+        valBz = HzDrude.get (pos).b0 * valBz;
+
+        *box->D1->getFieldValue (posD, 0) += valBz;
+      }
+      else
+      {
+        modifier = HzMaterial.get (pos);
+      }
+
+      HzCur[pos] += HzProfileZ.sum[k] * HzProfileY.inverseSum[j] / modifier * valBz;
+    }
+    else
+    {
+      if (useCPML)
+      {
+        FieldValue *psiY = HzPsiY.getValue (pos);
+        if (psiY != NULLPTR)
+        {
+          FieldValue valPsi = HzProfileY.c[j] * diffEx;
+
+          *psiY += valPsi;
+          diffEx += valPsi;
+        }
+
+        FieldValue *psiX = HzPsiX.getValue (pos);
+        if (psiX != NULLPTR)
+        {
+          FieldValue valPsi = HzProfileX.c[i] * diffEy;
+
+          *psiX += valPsi;
+          diffEy += valPsi;
+        }
+      }
+
+      HzCur[pos] += gridTimeStep / (HzMaterial.get (pos) * gridStep) * (diffEx - diffEy);
+    }
   }
 }
 
 void
 Scheme3D::calculateHzStep (time_step t, GridCoordinate3D HzStart, GridCoordinate3D HzEnd)
 {
-  FPValue eps0 = PhysicsConst::Eps0;
-  FPValue mu0 = PhysicsConst::Mu0;
+  GridCoordinate3D diffLeft = yeeLayout->getHzCircuitElementDiff (LayoutDirection::LEFT);
+  GridCoordinate3D diffRight = yeeLayout->getHzCircuitElementDiff (LayoutDirection::RIGHT);
+  GridCoordinate3D diffDown = yeeLayout->getHzCircuitElementDiff (LayoutDirection::DOWN);
+  GridCoordinate3D diffUp = yeeLayout->getHzCircuitElementDiff (LayoutDirection::UP);
+
+  calculateStepRows (Hz, Ex, diffUp, diffDown, Ey, diffRight, diffLeft, HzMaterial, HzCurlCoefficients,
+                     HzStart, HzEnd);
+}
+
+void
+Scheme3D::calculateHzStepPML (time_step t, GridCoordinate3D HzStart, GridCoordinate3D HzEnd)
+{
+  GridCoordinate3D diffLeft = yeeLayout->getHzCircuitElementDiff (LayoutDirection::LEFT);
+  GridCoordinate3D diffRight = yeeLayout->getHzCircuitElementDiff (LayoutDirection::RIGHT);
+  GridCoordinate3D diffDown = yeeLayout->getHzCircuitElementDiff (LayoutDirection::DOWN);
+  GridCoordinate3D diffUp = yeeLayout->getHzCircuitElementDiff (LayoutDirection::UP);
+
+  calculateStepPMLRows (GridType::HZ, Hz, BzBoxes, Ex, diffUp, diffDown, Ey, diffRight, diffLeft,
+                        HzStart, HzEnd);
+}
 
+void
+Scheme3D::calculateHzStepCPML (time_step t, GridCoordinate3D HzStart, GridCoordinate3D HzEnd)
+{
+  GridView<GridCoordinate3D> HzCur = Hz.getView (0);
+  GridView<GridCoordinate3D> HzPrev = Hz.getView (1);
+  GridView<GridCoordinate3D> ExPrev = Ex.getView (1);
+  GridView<GridCoordinate3D> EyPrev = Ey.getView (1);
+
+  GridCoordinate3D diffLeft = yeeLayout->getHzCircuitElementDiff (LayoutDirection::LEFT);
+  GridCoordinate3D diffRight = yeeLayout->getHzCircuitElementDiff (LayoutDirection::RIGHT);
+  GridCoordinate3D diffDown = yeeLayout->getHzCircuitElementDiff (LayoutDirection::DOWN);
+  GridCoordinate3D diffUp = yeeLayout->getHzCircuitElementDiff (LayoutDirection::UP);
+
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (int i = HzStart.getX (); i < HzEnd.getX (); ++i)
   {
     for (int j = HzStart.getY (); j < HzEnd.getY (); ++j)
@@ -1702,199 +1928,395 @@ Scheme3D::calculateHzStep (time_step t, GridCoordinate3D HzStart, GridCoordinate
       for (int k = HzStart.getZ (); k < HzEnd.getZ (); ++k)
       {
         GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Hz.getTotalPosition (pos);
-
-        FieldPointValue* valHz = Hz.getFieldPointValue (pos);
-
-        FPValue mu = yeeLayout->getMaterial (posAbs, GridType::HZ, Mu, GridType::MU);
-
-        GridCoordinate3D posLeft = yeeLayout->getHzCircuitElement (pos, LayoutDirection::LEFT);
-        GridCoordinate3D posRight = yeeLayout->getHzCircuitElement (pos, LayoutDirection::RIGHT);
-        GridCoordinate3D posDown = yeeLayout->getHzCircuitElement (pos, LayoutDirection::DOWN);
-        GridCoordinate3D posUp = yeeLayout->getHzCircuitElement (pos, LayoutDirection::UP);
 
-        FieldPointValue* valEy1 = Ey.getFieldPointValue (posRight);
-        FieldPointValue* valEy2 = Ey.getFieldPointValue (posLeft);
+        GridCoordinate3D posLeft = pos + diffLeft;
+        GridCoordinate3D posRight = pos + diffRight;
+        GridCoordinate3D posDown = pos + diffDown;
+        GridCoordinate3D posUp = pos + diffUp;
 
-        FieldPointValue* valEx1 = Ex.getFieldPointValue (posUp);
-        FieldPointValue* valEx2 = Ex.getFieldPointValue (posDown);
+        FieldValue prevEx1 = ExPrev[posUp];
+        FieldValue prevEx2 = ExPrev[posDown];
 
-        FieldValue prevEx1 = valEx1->getPrevValue ();
-        FieldValue prevEx2 = valEx2->getPrevValue ();
+        FieldValue prevEy1 = EyPrev[posRight];
+        FieldValue prevEy2 = EyPrev[posLeft];
 
-        FieldValue prevEy1 = valEy1->getPrevValue ();
-        FieldValue prevEy2 = valEy2->getPrevValue ();
+        /*
+         * Recursive convolutions of derivatives are added to values with higher coordinates
+         */
+        FieldValue *psiY = HzPsiY.getValue (pos);
+        if (psiY != NULLPTR)
+        {
+          *psiY = HzProfileY.b[j] * *psiY + HzProfileY.c[j] * (prevEx1 - prevEx2);
+          prevEx1 += *psiY;
+        }
 
-        if (useTFSF)
+        FieldValue *psiX = HzPsiX.getValue (pos);
+        if (psiX != NULLPTR)
         {
-          calculateHzTFSF (posAbs, prevEx1, prevEx2, prevEy1, prevEy2, posLeft, posRight, posDown, posUp);
+          *psiX = HzProfileX.b[i] * *psiX + HzProfileX.c[i] * (prevEy1 - prevEy2);
+          prevEy1 += *psiX;
         }
 
-        FieldValue val = calculateHz_3D (valHz->getPrevValue (),
+        FieldValue val = calculateHz_3D (HzPrev[pos],
                                          prevEx1,
                                          prevEx2,
                                          prevEy1,
                                          prevEy2,
                                          gridTimeStep,
                                          gridStep,
-                                         mu * mu0);
+                                         HzMaterial.get (pos));
 
-        valHz->setCurValue (val);
+        HzCur[pos] = val;
       }
     }
   }
 }
 
+/**
+ * Set value of point source in the center of Ez grid
+ */
 void
-Scheme3D::calculateHzStepPML (time_step t, GridCoordinate3D HzStart, GridCoordinate3D HzEnd)
+Scheme3D::performPointSourceStep (time_step t) /**< time step */
 {
-  FPValue eps0 = PhysicsConst::Eps0;
-  FPValue mu0 = PhysicsConst::Mu0;
+  GridCoordinate3D EzSize = Ez.getSize ();
+  GridCoordinate3D pos (EzSize.getX () / 2, EzSize.getY () / 2, EzSize.getZ () / 2);
 
-  for (int i = HzStart.getX (); i < HzEnd.getX (); ++i)
+#ifdef COMPLEX_FIELD_VALUES
+  Ez.setFieldValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
+                                cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)), pos, 0);
+#else /* COMPLEX_FIELD_VALUES */
+  Ez.setFieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency), pos, 0);
+#endif /* !COMPLEX_FIELD_VALUES */
+} /* Scheme3D::performPointSourceStep */
+
+/**
+ * Perform part of time step, which is assigned to task of graph
+ */
+void
+Scheme3D::performStepTask (StepTaskType type, /**< part of time step */
+                           time_step t, /**< time step */
+                           GridCoordinate3D start, /**< start of range of update of field component */
+                           GridCoordinate3D end) /**< end of range of update of field component */
+{
+  FieldGrid *field;
+  PMLBoxes *boxes;
+
+  switch (type)
   {
-    for (int j = HzStart.getY (); j < HzEnd.getY (); ++j)
+    case STEP_TASK_EX:
     {
-      for (int k = HzStart.getZ (); k < HzEnd.getZ (); ++k)
-      {
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Hz.getTotalPosition (pos);
+      performExSteps (t, start, end);
+      return;
+    }
+    case STEP_TASK_EY:
+    {
+      performEySteps (t, start, end);
+      return;
+    }
+    case STEP_TASK_EZ:
+    {
+      performEzSteps (t, start, end);
+      return;
+    }
+    case STEP_TASK_HX:
+    {
+      performHxSteps (t, start, end);
+      return;
+    }
+    case STEP_TASK_HY:
+    {
+      performHySteps (t, start, end);
+      return;
+    }
+    case STEP_TASK_HZ:
+    {
+      performHzSteps (t, start, end);
+      return;
+    }
+    case STEP_TASK_PLANE_WAVE_E:
+    {
+      performPlaneWaveESteps (t);
+      return;
+    }
+    case STEP_TASK_PLANE_WAVE_H:
+    {
+      performPlaneWaveHSteps (t);
+      return;
+    }
+    case STEP_TASK_POINT_SOURCE:
+    {
+      performPointSourceStep (t);
+      return;
+    }
+    case STEP_TASK_NEXT_EX:
+    {
+      field = &Ex;
+      boxes = &DxBoxes;
+      break;
+    }
+    case STEP_TASK_NEXT_EY:
+    {
+      field = &Ey;
+      boxes = &DyBoxes;
+      break;
+    }
+    case STEP_TASK_NEXT_EZ:
+    {
+      field = &Ez;
+      boxes = &DzBoxes;
+      break;
+    }
+    case STEP_TASK_NEXT_HX:
+    {
+      field = &Hx;
+      boxes = &BxBoxes;
+      break;
+    }
+    case STEP_TASK_NEXT_HY:
+    {
+      field = &Hy;
+      boxes = &ByBoxes;
+      break;
+    }
+    case STEP_TASK_NEXT_HZ:
+    {
+      field = &Hz;
+      boxes = &BzBoxes;
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
+      return;
+    }
+  }
+
+  /*
+   * Time layers of field component are shifted together with time layers of its D and D1 (B and B1), which are
+   * allocated only for PML
+   */
+  field->nextTimeStep ();
+  boxes->nextTimeStep ();
+} /* Scheme3D::performStepTask */
+
+/**
+ * Add tasks, which update tiles of field component. Tiles cover the whole range by Oy and Oz axes. If borders of tiles
+ * are not set yet, range is split by Ox axis to tiles of equal size.
+ *
+ * @return indexes of added tasks
+ */
+const std::vector<int> &
+Scheme3D::addStepTasks (TaskGraph &graph, /**< graph */
+                        StepTaskType type, /**< update of field component */
+                        const time_step *t, /**< current time step */
+                        GridCoordinate3D start, /**< start of range of update */
+                        GridCoordinate3D end) /**< end of range of update */
+{
+  StepTiles &tiles = stepTiles[type];
 
-        FieldPointValue* valBz = Bz.getFieldPointValue (pos);
+  if (tiles.borders.empty ())
+  {
+    grid_coord border = start.getX ();
 
-        FPValue sigmaX = yeeLayout->getMaterial (posAbs, GridType::BZ, SigmaX, GridType::SIGMAX);
+    /*
+     * Single tile is added for empty range, so that dependencies on update of field component are kept
+     */
+    do
+    {
+      tiles.borders.push_back (border);
+      border = std::min (border + tileSize, (grid_coord) end.getX ());
+    }
+    while (border < end.getX ());
 
-        GridCoordinate3D posLeft = yeeLayout->getHzCircuitElement (pos, LayoutDirection::LEFT);
-        GridCoordinate3D posRight = yeeLayout->getHzCircuitElement (pos, LayoutDirection::RIGHT);
-        GridCoordinate3D posDown = yeeLayout->getHzCircuitElement (pos, LayoutDirection::DOWN);
-        GridCoordinate3D posUp = yeeLayout->getHzCircuitElement (pos, LayoutDirection::UP);
+    tiles.borders.push_back (border);
+  }
 
-        FieldPointValue* valEy1 = Ey.getFieldPointValue (posRight);
-        FieldPointValue* valEy2 = Ey.getFieldPointValue (posLeft);
+  ASSERT (tiles.borders.front () == start.getX ());
+  ASSERT (tiles.borders.back () == std::max ((grid_coord) start.getX (), (grid_coord) end.getX ()));
 
-        FieldPointValue* valEx1 = Ex.getFieldPointValue (posUp);
-        FieldPointValue* valEx2 = Ex.getFieldPointValue (posDown);
+  tiles.tasks.clear ();
 
-        FieldValue prevEx1 = valEx1->getPrevValue ();
-        FieldValue prevEx2 = valEx2->getPrevValue ();
+  for (std::vector<grid_coord>::size_type i = 0; i + 1 < tiles.borders.size (); ++i)
+  {
+    GridCoordinate3D tileStart (tiles.borders[i], start.getY (), start.getZ ());
+    GridCoordinate3D tileEnd (tiles.borders[i + 1], end.getY (), end.getZ ());
 
-        FieldValue prevEy1 = valEy1->getPrevValue ();
-        FieldValue prevEy2 = valEy2->getPrevValue ();
+    tiles.tasks.push_back (graph.addTask (new StepTask (this, type, t, tileStart, tileEnd)));
+  }
 
-        if (useTFSF)
-        {
-          calculateHzTFSF (posAbs, prevEx1, prevEx2, prevEy1, prevEy2, posLeft, posRight, posDown, posUp);
-        }
+  return tiles.tasks;
+} /* Scheme3D::addStepTasks */
 
-        FPValue k_x = 1;
+/**
+ * Move borders of tiles of field component, so that costs of tiles, which are measured by graph, become equal. Cost
+ * of each tile is assumed to be distributed evenly among its coordinates by Ox axis, so costs of PML, TF/SF border and
+ * metamaterials are taken into account by coordinates of tiles, which contain them. Number of tiles is not increased.
+ */
+void
+Scheme3D::balanceStepTiles (StepTiles &tiles, /**< tiles of field component */
+                            const TaskGraph &graph) /**< graph, which has been run with tasks of tiles */
+{
+  grid_coord start = tiles.borders.front ();
+  grid_coord end = tiles.borders.back ();
 
-        FPValue Ca = (2 * eps0 * k_x - sigmaX * gridTimeStep) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
-        FPValue Cb = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
+  std::vector<double> costs (end - start);
+  double totalCost = 0;
 
-        FieldValue val = calculateHz_3D_Precalc (valBz->getPrevValue (),
-                                                 prevEx1,
-                                                 prevEx2,
-                                                 prevEy1,
-                                                 prevEy2,
-                                                 Ca,
-                                                 Cb);
+  for (std::vector<int>::size_type i = 0; i < tiles.tasks.size (); ++i)
+  {
+    double cost = graph.getCost (tiles.tasks[i]);
 
-        valBz->setCurValue (val);
-      }
+    for (grid_coord x = tiles.borders[i]; x < tiles.borders[i + 1]; ++x)
+    {
+      costs[x - start] = cost / (tiles.borders[i + 1] - tiles.borders[i]);
     }
+
+    totalCost += cost;
   }
 
-  if (useMetamaterials)
+  /*
+   * Costs are measured only with OpenMP
+   */
+  if (tiles.tasks.size () < 2
+      || totalCost == 0)
   {
-    for (int i = HzStart.getX (); i < HzEnd.getX (); ++i)
-    {
-      for (int j = HzStart.getY (); j < HzEnd.getY (); ++j)
-      {
-        for (int k = HzStart.getZ (); k < HzEnd.getZ (); ++k)
-        {
-          GridCoordinate3D pos (i, j, k);
-          GridCoordinate3D posAbs = Hz.getTotalPosition (pos);
+    return;
+  }
 
-          FieldPointValue* valB1z = B1z.getFieldPointValue (pos);
-          FieldPointValue* valBz = Bz.getFieldPointValue (pos);
+  std::vector<grid_coord> borders;
+  borders.push_back (start);
 
-          FPValue omegaPM;
-          FPValue gammaM;
-          FPValue mu = yeeLayout->getMetaMaterial (posAbs, GridType::BZ, Mu, GridType::MU, OmegaPM, GridType::OMEGAPM, GammaM, GridType::GAMMAM, omegaPM, gammaM);
+  double sum = 0;
 
-          /*
-           * FIXME: precalculate coefficients
-           */
-          FPValue C = 4*mu0*mu + 2*gridTimeStep*mu0*mu*gammaM + mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM;
-
-          FieldValue val = calculateDrudeH (valBz->getCurValue (),
-                                            valBz->getPrevValue (),
-                                            valBz->getPrevPrevValue (),
-                                            valB1z->getPrevValue (),
-                                            valB1z->getPrevPrevValue (),
-                                            (4 + 2*gridTimeStep*gammaM) / C,
-                                            -8 / C,
-                                            (4 - 2*gridTimeStep*gammaM) / C,
-                                            (2*mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM - 8*mu0*mu) / C,
-                                            (4*mu0*mu - 2*gridTimeStep*mu0*mu*gammaM + mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM) / C);
-
-          valB1z->setCurValue (val);
-        }
-      }
+  for (grid_coord x = start; x + 1 < end && borders.size () < tiles.tasks.size (); ++x)
+  {
+    sum += costs[x - start];
+
+    /*
+     * Tile is ended at coordinate, at which sum of costs reaches the next share of total cost
+     */
+    if (sum >= totalCost * borders.size () / tiles.tasks.size ())
+    {
+      borders.push_back (x + 1);
     }
   }
 
-  for (int i = HzStart.getX (); i < HzEnd.getX (); ++i)
+  borders.push_back (end);
+
+  tiles.borders = borders;
+} /* Scheme3D::balanceStepTiles */
+
+/**
+ * Add dependency of task on all tasks from list
+ */
+static void
+addDependencies (TaskGraph &graph, /**< graph */
+                 const std::vector<int> &before, /**< tasks, which are performed first */
+                 int after) /**< task, which depends on them */
+{
+  for (std::vector<int>::const_iterator it = before.begin (); it != before.end (); ++it)
   {
-    for (int j = HzStart.getY (); j < HzEnd.getY (); ++j)
-    {
-      for (int k = HzStart.getZ (); k < HzEnd.getZ (); ++k)
-      {
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinate3D posAbs = Hz.getTotalPosition (pos);
+    graph.addDependency (*it, after);
+  }
+} /* addDependencies */
 
-        FieldPointValue* valHz = Hz.getFieldPointValue (pos);
+/**
+ * Add dependency of all tasks from list on task
+ */
+static void
+addDependencies (TaskGraph &graph, /**< graph */
+                 int before, /**< task, which is performed first */
+                 const std::vector<int> &after) /**< tasks, which depend on it */
+{
+  for (std::vector<int>::const_iterator it = after.begin (); it != after.end (); ++it)
+  {
+    graph.addDependency (before, *it);
+  }
+} /* addDependencies */
 
-        FieldPointValue* valBz;
+/**
+ * Build graph of tasks, which performs single time step.
+ *
+ * Tiles of all components of E and plane wave are updated concurrently. Time layers of grids are shifted as a whole,
+ * so each component is shifted by separate task as soon as all its tiles are updated. Tiles of component of H wait
+ * only for shifts of two components of E in its differences (e.g. Hx is updated after Ey and Ez, while tiles of Ex
+ * are still updated). Layers of plane wave H are shifted after all tiles of E, which read them on TF/SF border.
+ */
+void
+Scheme3D::initTaskGraph (TaskGraph &graph, /**< graph */
+                         const time_step *t) /**< current time step, which is set before each run of graph */
+{
+  GridCoordinate3D zero (0, 0, 0);
 
-        if (useMetamaterials)
-        {
-          valBz = B1z.getFieldPointValue (pos);
-        }
-        else
-        {
-          valBz = Bz.getFieldPointValue (pos);
-        }
+  std::vector<int> ExTasks = addStepTasks (graph, STEP_TASK_EX, t,
+                                           Ex.getComputationStart (yeeLayout->getExStartDiff ()),
+                                           Ex.getComputationEnd (yeeLayout->getExEndDiff ()));
+  std::vector<int> EyTasks = addStepTasks (graph, STEP_TASK_EY, t,
+                                           Ey.getComputationStart (yeeLayout->getEyStartDiff ()),
+                                           Ey.getComputationEnd (yeeLayout->getEyEndDiff ()));
+  std::vector<int> EzTasks = addStepTasks (graph, STEP_TASK_EZ, t,
+                                           Ez.getComputationStart (yeeLayout->getEzStartDiff ()),
+                                           Ez.getComputationEnd (yeeLayout->getEzEndDiff ()));
 
-        FPValue mu = yeeLayout->getMaterial (posAbs, GridType::BZ, Mu, GridType::MU);
-        FPValue sigmaY = yeeLayout->getMaterial (posAbs, GridType::BZ, SigmaY, GridType::SIGMAY);
-        FPValue sigmaZ = yeeLayout->getMaterial (posAbs, GridType::BZ, SigmaZ, GridType::SIGMAZ);
+  int nextEx = graph.addTask (new StepTask (this, STEP_TASK_NEXT_EX, t, zero, zero));
+  int nextEy = graph.addTask (new StepTask (this, STEP_TASK_NEXT_EY, t, zero, zero));
+  int nextEz = graph.addTask (new StepTask (this, STEP_TASK_NEXT_EZ, t, zero, zero));
 
-        FPValue modifier = mu * mu0;
-        if (useMetamaterials)
-        {
-          modifier = 1;
-        }
+  addDependencies (graph, ExTasks, nextEx);
+  addDependencies (graph, EyTasks, nextEy);
+
+  if (useTFSF)
+  {
+    addDependencies (graph, EzTasks, nextEz);
+  }
+  else
+  {
+    int pointSource = graph.addTask (new StepTask (this, STEP_TASK_POINT_SOURCE, t, zero, zero));
 
-        FPValue k_y = 1;
-        FPValue k_z = 1;
+    addDependencies (graph, EzTasks, pointSource);
+    graph.addDependency (pointSource, nextEz);
+  }
 
-        FPValue Ca = (2 * eps0 * k_y - sigmaY * gridTimeStep) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
-        FPValue Cb = ((2 * eps0 * k_z + sigmaZ * gridTimeStep) / (modifier)) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
-        FPValue Cc = ((2 * eps0 * k_z - sigmaZ * gridTimeStep) / (modifier)) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
+  std::vector<int> HxTasks = addStepTasks (graph, STEP_TASK_HX, t,
+                                           Hx.getComputationStart (yeeLayout->getHxStartDiff ()),
+                                           Hx.getComputationEnd (yeeLayout->getHxEndDiff ()));
+  std::vector<int> HyTasks = addStepTasks (graph, STEP_TASK_HY, t,
+                                           Hy.getComputationStart (yeeLayout->getHyStartDiff ()),
+                                           Hy.getComputationEnd (yeeLayout->getHyEndDiff ()));
+  std::vector<int> HzTasks = addStepTasks (graph, STEP_TASK_HZ, t,
+                                           Hz.getComputationStart (yeeLayout->getHzStartDiff ()),
+                                           Hz.getComputationEnd (yeeLayout->getHzEndDiff ()));
 
-        FieldValue val = calculateHz_from_Bz_Precalc (valHz->getPrevValue (),
-                                                      valBz->getCurValue (),
-                                                      valBz->getPrevValue (),
-                                                      Ca,
-                                                      Cb,
-                                                      Cc);
+  addDependencies (graph, nextEy, HxTasks);
+  addDependencies (graph, nextEz, HxTasks);
+  addDependencies (graph, nextEz, HyTasks);
+  addDependencies (graph, nextEx, HyTasks);
+  addDependencies (graph, nextEx, HzTasks);
+  addDependencies (graph, nextEy, HzTasks);
 
-        valHz->setCurValue (val);
-      }
-    }
+  if (useTFSF)
+  {
+    int planeWaveE = graph.addTask (new StepTask (this, STEP_TASK_PLANE_WAVE_E, t, zero, zero));
+    int planeWaveH = graph.addTask (new StepTask (this, STEP_TASK_PLANE_WAVE_H, t, zero, zero));
+
+    graph.addDependency (planeWaveE, planeWaveH);
+    addDependencies (graph, ExTasks, planeWaveH);
+    addDependencies (graph, EyTasks, planeWaveH);
+    addDependencies (graph, EzTasks, planeWaveH);
+
+    addDependencies (graph, planeWaveH, HxTasks);
+    addDependencies (graph, planeWaveH, HyTasks);
+    addDependencies (graph, planeWaveH, HzTasks);
   }
-}
+
+  int nextHx = graph.addTask (new StepTask (this, STEP_TASK_NEXT_HX, t, zero, zero));
+  int nextHy = graph.addTask (new StepTask (this, STEP_TASK_NEXT_HY, t, zero, zero));
+  int nextHz = graph.addTask (new StepTask (this, STEP_TASK_NEXT_HZ, t, zero, zero));
+
+  addDependencies (graph, HxTasks, nextHx);
+  addDependencies (graph, HyTasks, nextHy);
+  addDependencies (graph, HzTasks, nextHz);
+} /* Scheme3D::initTaskGraph */
 
 void
 Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
@@ -1963,6 +2385,23 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
   time_step stepLimit = startStep + numberTimeSteps;
 
+  /*
+   * Graph is built once, its tasks take current time step from taskStep. Tiles are rebuilt with balanced costs after
+   * costs are learned for each TILE_BALANCE_STEPS steps, first TILE_BALANCE_ROUNDS times.
+   */
+  time_step taskStep = startStep;
+  TaskGraph taskGraph;
+
+  if (useTaskGraph)
+  {
+    for (int type = STEP_TASK_EX; type <= STEP_TASK_HZ; ++type)
+    {
+      stepTiles[type].borders.clear ();
+    }
+
+    initTaskGraph (taskGraph, &taskStep);
+  }
+
   for (int t = startStep; t < stepLimit; ++t)
   {
     GridCoordinate3D ExStart = Ex.getComputationStart (yeeLayout->getExStartDiff ());
@@ -1983,89 +2422,63 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
     GridCoordinate3D HzStart = Hz.getComputationStart (yeeLayout->getHzStartDiff ());
     GridCoordinate3D HzEnd = Hz.getComputationEnd (yeeLayout->getHzEndDiff ());
 
-    if (useTFSF)
+    if (useTaskGraph)
     {
-      performPlaneWaveESteps (t);
-    }
-
-    performExSteps (t, ExStart, ExEnd);
-    performEySteps (t, EyStart, EyEnd);
-    performEzSteps (t, EzStart, EzEnd);
+      taskStep = t;
+      taskGraph.run ();
 
-    if (!useTFSF)
-    {
-#if defined (PARALLEL_GRID)
-      //if (processId == 0)
-#endif
+      if ((t - startStep + 1) % TILE_BALANCE_STEPS == 0
+          && t - startStep < TILE_BALANCE_STEPS * TILE_BALANCE_ROUNDS)
       {
-        grid_coord start;
-        grid_coord end;
-#ifdef PARALLEL_GRID
-        start = processId == 0 ? yeeLayout->getLeftBorderPML ().getZ () : 0;
-        end = processId == ParallelGrid::getParallelCore ()->getTotalProcCount () - 1 ? Ez.getRelativePosition (yeeLayout->getRightBorderPML ()).getZ () : Ez.getCurrentSize ().getZ ();
-#else /* PARALLEL_GRID */
-        start = yeeLayout->getLeftBorderPML ().getZ ();
-        end = yeeLayout->getRightBorderPML ().getZ ();
-#endif /* !PARALLEL_GRID */
-        //for (grid_coord k = start; k < end; ++k)
-        grid_coord k = EzSize.getZ () / 2;
+        for (int type = STEP_TASK_EX; type <= STEP_TASK_HZ; ++type)
         {
-          GridCoordinate3D pos (EzSize.getX () / 2, EzSize.getY () / 2, k);
-          FieldPointValue* tmp = Ez.getFieldPointValue (pos);
-
-  #ifdef COMPLEX_FIELD_VALUES
-          tmp->setCurValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
-                                        cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)));
-  #else /* COMPLEX_FIELD_VALUES */
-          tmp->setCurValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency));
-  #endif /* !COMPLEX_FIELD_VALUES */
+          balanceStepTiles (stepTiles[type], taskGraph);
         }
+
+        taskGraph.clear ();
+        initTaskGraph (taskGraph, &taskStep);
       }
     }
-
-    Ex.nextTimeStep ();
-    Ey.nextTimeStep ();
-    Ez.nextTimeStep ();
-
-    if (usePML)
+    else
     {
-      Dx.nextTimeStep ();
-      Dy.nextTimeStep ();
-      Dz.nextTimeStep ();
-    }
+      if (useTFSF)
+      {
+        performPlaneWaveESteps (t);
+      }
 
-    if (useMetamaterials)
-    {
-      D1x.nextTimeStep ();
-      D1y.nextTimeStep ();
-      D1z.nextTimeStep ();
-    }
+      performExSteps (t, ExStart, ExEnd);
+      performEySteps (t, EyStart, EyEnd);
+      performEzSteps (t, EzStart, EzEnd);
 
-    if (useTFSF)
-    {
-      performPlaneWaveHSteps (t);
-    }
+      if (!useTFSF)
+      {
+        performPointSourceStep (t);
+      }
 
-    performHxSteps (t, HxStart, HxEnd);
-    performHySteps (t, HyStart, HyEnd);
-    performHzSteps (t, HzStart, HzEnd);
+      Ex.nextTimeStep ();
+      Ey.nextTimeStep ();
+      Ez.nextTimeStep ();
 
-    Hx.nextTimeStep ();
-    Hy.nextTimeStep ();
-    Hz.nextTimeStep ();
+      DxBoxes.nextTimeStep ();
+      DyBoxes.nextTimeStep ();
+      DzBoxes.nextTimeStep ();
 
-    if (usePML)
-    {
-      Bx.nextTimeStep ();
-      By.nextTimeStep ();
-      Bz.nextTimeStep ();
-    }
+      if (useTFSF)
+      {
+        performPlaneWaveHSteps (t);
+      }
 
-    if (useMetamaterials)
-    {
-      B1x.nextTimeStep ();
-      B1y.nextTimeStep ();
-      B1z.nextTimeStep ();
+      performHxSteps (t, HxStart, HxEnd);
+      performHySteps (t, HyStart, HyEnd);
+      performHzSteps (t, HzStart, HzEnd);
+
+      Hx.nextTimeStep ();
+      Hy.nextTimeStep ();
+      Hz.nextTimeStep ();
+
+      BxBoxes.nextTimeStep ();
+      ByBoxes.nextTimeStep ();
+      BzBoxes.nextTimeStep ();
     }
 
     //if (SQR (posAbs.getX () - 57) + SQR (posAbs.getY () - 57) + SQR (posAbs.getZ () - 23) < SQR (8))
@@ -2362,8 +2775,6 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
         for (grid_iter i = 0; i < totalEx.getSize ().calculateTotalCoord (); ++i)
         {
-          FieldPointValue *val = totalEx.getFieldPointValue (i);
-
           GridCoordinate3D pos = totalEx.calculatePositionFromIndex (i);
           GridCoordinate3D posAbs = totalEx.getTotalPosition (pos);
           GridCoordinateFP3D realCoord = yeeLayout->getExCoordFP (posAbs);
@@ -2383,13 +2794,11 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
           FieldValue incVal = yeeLayout->getExFromIncidentE (approximateIncidentWaveE (realCoord));
 
-          val->setCurValue (val->getCurValue () - incVal);
+          totalEx.setFieldValue (*totalEx.getFieldValue (i, 1) - incVal, i, 1);
         }
 
         for (grid_iter i = 0; i < totalEy.getSize ().calculateTotalCoord (); ++i)
         {
-          FieldPointValue *val = totalEy.getFieldPointValue (i);
-
           GridCoordinate3D pos = totalEy.calculatePositionFromIndex (i);
           GridCoordinate3D posAbs = totalEy.getTotalPosition (pos);
           GridCoordinateFP3D realCoord = yeeLayout->getEyCoordFP (posAbs);
@@ -2409,13 +2818,11 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
           FieldValue incVal = yeeLayout->getEyFromIncidentE (approximateIncidentWaveE (realCoord));
 
-          val->setCurValue (val->getCurValue () - incVal);
+          totalEy.setFieldValue (*totalEy.getFieldValue (i, 1) - incVal, i, 1);
         }
 
         for (grid_iter i = 0; i < totalEz.getSize ().calculateTotalCoord (); ++i)
         {
-          FieldPointValue *val = totalEz.getFieldPointValue (i);
-
           GridCoordinate3D pos = totalEz.calculatePositionFromIndex (i);
           GridCoordinate3D posAbs = totalEz.getTotalPosition (pos);
           GridCoordinateFP3D realCoord = yeeLayout->getEzCoordFP (posAbs);
@@ -2435,13 +2842,11 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
           FieldValue incVal = yeeLayout->getEzFromIncidentE (approximateIncidentWaveE (realCoord));
 
-          val->setCurValue (val->getCurValue () - incVal);
+          totalEz.setFieldValue (*totalEz.getFieldValue (i, 1) - incVal, i, 1);
         }
 
         for (grid_iter i = 0; i < totalHx.getSize ().calculateTotalCoord (); ++i)
         {
-          FieldPointValue *val = totalHx.getFieldPointValue (i);
-
           GridCoordinate3D pos = totalHx.calculatePositionFromIndex (i);
           GridCoordinate3D posAbs = totalHx.getTotalPosition (pos);
           GridCoordinateFP3D realCoord = yeeLayout->getHxCoordFP (posAbs);
@@ -2461,13 +2866,11 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
           FieldValue incVal = yeeLayout->getHxFromIncidentH (approximateIncidentWaveH (realCoord));
 
-          val->setCurValue (val->getCurValue () - incVal);
+          totalHx.setFieldValue (*totalHx.getFieldValue (i, 1) - incVal, i, 1);
         }
 
         for (grid_iter i = 0; i < totalHy.getSize ().calculateTotalCoord (); ++i)
         {
-          FieldPointValue *val = totalHy.getFieldPointValue (i);
-
           GridCoordinate3D pos = totalHy.calculatePositionFromIndex (i);
           GridCoordinate3D posAbs = totalHy.getTotalPosition (pos);
           GridCoordinateFP3D realCoord = yeeLayout->getHyCoordFP (posAbs);
@@ -2487,13 +2890,11 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
           FieldValue incVal = yeeLayout->getHyFromIncidentH (approximateIncidentWaveH (realCoord));
 
-          val->setCurValue (val->getCurValue () - incVal);
+          totalHy.setFieldValue (*totalHy.getFieldValue (i, 1) - incVal, i, 1);
         }
 
         for (grid_iter i = 0; i < totalHz.getSize ().calculateTotalCoord (); ++i)
         {
-          FieldPointValue *val = totalHz.getFieldPointValue (i);
-
           GridCoordinate3D pos = totalHz.calculatePositionFromIndex (i);
           GridCoordinate3D posAbs = totalHz.getTotalPosition (pos);
           GridCoordinateFP3D realCoord = yeeLayout->getHzCoordFP (posAbs);
@@ -2513,25 +2914,25 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
           FieldValue incVal = yeeLayout->getHzFromIncidentH (approximateIncidentWaveH (realCoord));
 
-          val->setCurValue (val->getCurValue () - incVal);
+          totalHz.setFieldValue (*totalHz.getFieldValue (i, 1) - incVal, i, 1);
         }
 
-        dumperEx.init (t, CURRENT, processId, "3D-in-time-total-Ex");
+        dumperEx.init (t, PREVIOUS, processId, "3D-in-time-total-Ex");
         dumperEx.dumpGrid (totalEx, startEx, endEx);
 
-        dumperEy.init (t, CURRENT, processId, "3D-in-time-total-Ey");
+        dumperEy.init (t, PREVIOUS, processId, "3D-in-time-total-Ey");
         dumperEy.dumpGrid (totalEy, startEy, endEy);
 
-        dumperEz.init (t, CURRENT, processId, "3D-in-time-total-Ez");
+        dumperEz.init (t, PREVIOUS, processId, "3D-in-time-total-Ez");
         dumperEz.dumpGrid (totalEz, startEz, endEz);
 
-        dumperHx.init (t, CURRENT, processId, "3D-in-time-total-Hx");
+        dumperHx.init (t, PREVIOUS, processId, "3D-in-time-total-Hx");
         dumperHx.dumpGrid (totalHx, startHx, endHx);
 
-        dumperHy.init (t, CURRENT, processId, "3D-in-time-total-Hy");
+        dumperHy.init (t, PREVIOUS, processId, "3D-in-time-total-Hy");
         dumperHy.dumpGrid (totalHy, startHy, endHy);
 
-        dumperHz.init (t, CURRENT, processId, "3D-in-time-total-Hz");
+        dumperHz.init (t, PREVIOUS, processId, "3D-in-time-total-Hz");
         dumperHz.dumpGrid (totalHz, startHz, endHz);
 #endif
       }
@@ -2592,8 +2993,6 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
     for (grid_iter i = 0; i < totalEx.getSize ().calculateTotalCoord (); ++i)
     {
-      FieldPointValue *val = totalEx.getFieldPointValue (i);
-
       GridCoordinate3D pos = totalEx.calculatePositionFromIndex (i);
       GridCoordinate3D posAbs = totalEx.getTotalPosition (pos);
       GridCoordinateFP3D realCoord = yeeLayout->getExCoordFP (posAbs);
@@ -2613,13 +3012,11 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
       FieldValue incVal = yeeLayout->getExFromIncidentE (approximateIncidentWaveE (realCoord));
 
-      val->setCurValue (val->getCurValue () - incVal);
+      totalEx.setFieldValue (*totalEx.getFieldValue (i, 1) - incVal, i, 1);
     }
 
     for (grid_iter i = 0; i < totalEy.getSize ().calculateTotalCoord (); ++i)
     {
-      FieldPointValue *val = totalEy.getFieldPointValue (i);
-
       GridCoordinate3D pos = totalEy.calculatePositionFromIndex (i);
       GridCoordinate3D posAbs = totalEy.getTotalPosition (pos);
       GridCoordinateFP3D realCoord = yeeLayout->getEyCoordFP (posAbs);
@@ -2639,13 +3036,11 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
       FieldValue incVal = yeeLayout->getEyFromIncidentE (approximateIncidentWaveE (realCoord));
 
-      val->setCurValue (val->getCurValue () - incVal);
+      totalEy.setFieldValue (*totalEy.getFieldValue (i, 1) - incVal, i, 1);
     }
 
     for (grid_iter i = 0; i < totalEz.getSize ().calculateTotalCoord (); ++i)
     {
-      FieldPointValue *val = totalEz.getFieldPointValue (i);
-
       GridCoordinate3D pos = totalEz.calculatePositionFromIndex (i);
       GridCoordinate3D posAbs = totalEz.getTotalPosition (pos);
       GridCoordinateFP3D realCoord = yeeLayout->getEzCoordFP (posAbs);
@@ -2665,13 +3060,11 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
       FieldValue incVal = yeeLayout->getEzFromIncidentE (approximateIncidentWaveE (realCoord));
 
-      val->setCurValue (val->getCurValue () - incVal);
+      totalEz.setFieldValue (*totalEz.getFieldValue (i, 1) - incVal, i, 1);
     }
 
     for (grid_iter i = 0; i < totalHx.getSize ().calculateTotalCoord (); ++i)
     {
-      FieldPointValue *val = totalHx.getFieldPointValue (i);
-
       GridCoordinate3D pos = totalHx.calculatePositionFromIndex (i);
       GridCoordinate3D posAbs = totalHx.getTotalPosition (pos);
       GridCoordinateFP3D realCoord = yeeLayout->getHxCoordFP (posAbs);
@@ -2691,13 +3084,11 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
       FieldValue incVal = yeeLayout->getHxFromIncidentH (approximateIncidentWaveH (realCoord));
 
-      val->setCurValue (val->getCurValue () - incVal);
+      totalHx.setFieldValue (*totalHx.getFieldValue (i, 1) - incVal, i, 1);
     }
 
     for (grid_iter i = 0; i < totalHy.getSize ().calculateTotalCoord (); ++i)
     {
-      FieldPointValue *val = totalHy.getFieldPointValue (i);
-
       GridCoordinate3D pos = totalHy.calculatePositionFromIndex (i);
       GridCoordinate3D posAbs = totalHy.getTotalPosition (pos);
       GridCoordinateFP3D realCoord = yeeLayout->getHyCoordFP (posAbs);
@@ -2717,13 +3108,11 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
       FieldValue incVal = yeeLayout->getHyFromIncidentH (approximateIncidentWaveH (realCoord));
 
-      val->setCurValue (val->getCurValue () - incVal);
+      totalHy.setFieldValue (*totalHy.getFieldValue (i, 1) - incVal, i, 1);
     }
 
     for (grid_iter i = 0; i < totalHz.getSize ().calculateTotalCoord (); ++i)
     {
-      FieldPointValue *val = totalHz.getFieldPointValue (i);
-
       GridCoordinate3D pos = totalHz.calculatePositionFromIndex (i);
       GridCoordinate3D posAbs = totalHz.getTotalPosition (pos);
       GridCoordinateFP3D realCoord = yeeLayout->getHzCoordFP (posAbs);
@@ -2743,7 +3132,7 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
       FieldValue incVal = yeeLayout->getHzFromIncidentH (approximateIncidentWaveH (realCoord));
 
-      val->setCurValue (val->getCurValue () - incVal);
+      totalHz.setFieldValue (*totalHz.getFieldValue (i, 1) - incVal, i, 1);
     }
 
     // dumperEx.init (stepLimit, CURRENT, processId, "3D-in-time-total-Ex");
@@ -2752,7 +3141,7 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
     // dumperEy.init (stepLimit, CURRENT, processId, "3D-in-time-total-Ey");
     // dumperEy.dumpGrid (totalEy, startEy, endEy);
 
-    dumperEz.init (stepLimit, CURRENT, processId, "3D-in-time-total-Ez");
+    dumperEz.init (stepLimit, PREVIOUS, processId, "3D-in-time-total-Ez");
     dumperEz.dumpGrid (totalEz, startEz, endEz);
 
     // dumperHx.init (stepLimit, CURRENT, processId, "3D-in-time-total-Hx");
@@ -2766,8 +3155,6 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 #else
     for (grid_iter i = 0; i < Ex.getSize ().calculateTotalCoord (); ++i)
     {
-      FieldPointValue *val = Ex.getFieldPointValue (i);
-
       GridCoordinate3D pos = Ex.calculatePositionFromIndex (i);
       GridCoordinate3D posAbs = Ex.getTotalPosition (pos);
       GridCoordinateFP3D realCoord = yeeLayout->getExCoordFP (posAbs);
@@ -2787,13 +3174,11 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
       FieldValue incVal = yeeLayout->getExFromIncidentE (approximateIncidentWaveE (realCoord));
 
-      val->setCurValue (val->getCurValue () - incVal);
+      Ex.setFieldValue (*Ex.getFieldValue (i, 1) - incVal, i, 1);
     }
 
     for (grid_iter i = 0; i < Ey.getSize ().calculateTotalCoord (); ++i)
     {
-      FieldPointValue *val = Ey.getFieldPointValue (i);
-
       GridCoordinate3D pos = Ey.calculatePositionFromIndex (i);
       GridCoordinate3D posAbs = Ey.getTotalPosition (pos);
       GridCoordinateFP3D realCoord = yeeLayout->getEyCoordFP (posAbs);
@@ -2813,13 +3198,11 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
       FieldValue incVal = yeeLayout->getEyFromIncidentE (approximateIncidentWaveE (realCoord));
 
-      val->setCurValue (val->getCurValue () - incVal);
+      Ey.setFieldValue (*Ey.getFieldValue (i, 1) - incVal, i, 1);
     }
 
     for (grid_iter i = 0; i < Ez.getSize ().calculateTotalCoord (); ++i)
     {
-      FieldPointValue *val = Ez.getFieldPointValue (i);
-
       GridCoordinate3D pos = Ez.calculatePositionFromIndex (i);
       GridCoordinate3D posAbs = Ez.getTotalPosition (pos);
       GridCoordinateFP3D realCoord = yeeLayout->getEzCoordFP (posAbs);
@@ -2839,13 +3222,11 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
       FieldValue incVal = yeeLayout->getEzFromIncidentE (approximateIncidentWaveE (realCoord));
 
-      val->setCurValue (val->getCurValue () - incVal);
+      Ez.setFieldValue (*Ez.getFieldValue (i, 1) - incVal, i, 1);
     }
 
     for (grid_iter i = 0; i < Hx.getSize ().calculateTotalCoord (); ++i)
     {
-      FieldPointValue *val = Hx.getFieldPointValue (i);
-
       GridCoordinate3D pos = Hx.calculatePositionFromIndex (i);
       GridCoordinate3D posAbs = Hx.getTotalPosition (pos);
       GridCoordinateFP3D realCoord = yeeLayout->getHxCoordFP (posAbs);
@@ -2865,13 +3246,11 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
       FieldValue incVal = yeeLayout->getHxFromIncidentH (approximateIncidentWaveH (realCoord));
 
-      val->setCurValue (val->getCurValue () - incVal);
+      Hx.setFieldValue (*Hx.getFieldValue (i, 1) - incVal, i, 1);
     }
 
     for (grid_iter i = 0; i < Hy.getSize ().calculateTotalCoord (); ++i)
     {
-      FieldPointValue *val = Hy.getFieldPointValue (i);
-
       GridCoordinate3D pos = Hy.calculatePositionFromIndex (i);
       GridCoordinate3D posAbs = Hy.getTotalPosition (pos);
       GridCoordinateFP3D realCoord = yeeLayout->getHyCoordFP (posAbs);
@@ -2891,13 +3270,11 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
       FieldValue incVal = yeeLayout->getHyFromIncidentH (approximateIncidentWaveH (realCoord));
 
-      val->setCurValue (val->getCurValue () - incVal);
+      Hy.setFieldValue (*Hy.getFieldValue (i, 1) - incVal, i, 1);
     }
 
     for (grid_iter i = 0; i < Hz.getSize ().calculateTotalCoord (); ++i)
     {
-      FieldPointValue *val = Hz.getFieldPointValue (i);
-
       GridCoordinate3D pos = Hz.calculatePositionFromIndex (i);
       GridCoordinate3D posAbs = Hz.getTotalPosition (pos);
       GridCoordinateFP3D realCoord = yeeLayout->getHzCoordFP (posAbs);
@@ -2917,25 +3294,25 @@ Scheme3D::performNSteps (time_step startStep, time_step numberTimeSteps)
 
       FieldValue incVal = yeeLayout->getHzFromIncidentH (approximateIncidentWaveH (realCoord));
 
-      val->setCurValue (val->getCurValue () - incVal);
+      Hz.setFieldValue (*Hz.getFieldValue (i, 1) - incVal, i, 1);
     }
 
-    dumperEx.init (stepLimit, CURRENT, processId, "3D-in-time-Ex");
+    dumperEx.init (stepLimit, PREVIOUS, processId, "3D-in-time-Ex");
     dumperEx.dumpGrid (Ex, startEx, endEx);
 
-    dumperEy.init (stepLimit, CURRENT, processId, "3D-in-time-Ey");
+    dumperEy.init (stepLimit, PREVIOUS, processId, "3D-in-time-Ey");
     dumperEy.dumpGrid (Ey, startEy, endEy);
 
-    dumperEz.init (stepLimit, CURRENT, processId, "3D-in-time-Ez");
+    dumperEz.init (stepLimit, PREVIOUS, processId, "3D-in-time-Ez");
     dumperEz.dumpGrid (Ez, startEz, endEz);
 
-    dumperHx.init (stepLimit, CURRENT, processId, "3D-in-time-Hx");
+    dumperHx.init (stepLimit, PREVIOUS, processId, "3D-in-time-Hx");
     dumperHx.dumpGrid (Hx, startHx, endHx);
 
-    dumperHy.init (stepLimit, CURRENT, processId, "3D-in-time-Hy");
+    dumperHy.init (stepLimit, PREVIOUS, processId, "3D-in-time-Hy");
     dumperHy.dumpGrid (Hy, startHy, endHy);
 
-    dumperHz.init (stepLimit, CURRENT, processId, "3D-in-time-Hz");
+    dumperHz.init (stepLimit, PREVIOUS, processId, "3D-in-time-Hz");
     dumperHz.dumpGrid (Hz, startHz, endHz);
 #endif
   }
@@ -3002,18 +3379,20 @@ Scheme3D::performAmplitudeSteps (time_step startStep)
         for (grid_coord k = yeeLayout->getLeftBorderPML ().getZ (); k < yeeLayout->getRightBorderPML ().getZ (); ++k)
         {
           GridCoordinate3D pos (EzSize.getX () / 8, EzSize.getY () / 2, k);
-          FieldPointValue* tmp = Ez.getFieldPointValue (pos);
 
   #ifdef COMPLEX_FIELD_VALUES
-          tmp->setCurValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
-                                        cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)));
+          Ez.setFieldValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
+                                        cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)), pos, 0);
   #else /* COMPLEX_FIELD_VALUES */
-          tmp->setCurValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency));
+          Ez.setFieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency), pos, 0);
   #endif /* !COMPLEX_FIELD_VALUES */
         }
       }
     }
 
+#ifdef OPENMP_ENABLED
+    #pragma omp parallel for collapse (2) reduction (max: maxAccuracy) reduction (min: is_stable_state)
+#endif /* OPENMP_ENABLED */
     for (int i = ExStart.getX (); i < ExEnd.getX (); ++i)
     {
       for (int j = ExStart.getY (); j < ExEnd.getY (); ++j)
@@ -3024,17 +3403,14 @@ Scheme3D::performAmplitudeSteps (time_step startStep)
 
           if (!yeeLayout->isExInPML (Ex.getTotalPosition (pos)))
           {
-            FieldPointValue* tmp = Ex.getFieldPointValue (pos);
-            FieldPointValue* tmpAmp = ExAmplitude.getFieldPointValue (pos);
-
             GridCoordinateFP3D realCoord = yeeLayout->getExCoordFP (Ex.getTotalPosition (pos));
 
             GridCoordinateFP3D leftBorder = GridCoordinateFP3D (0, 0, 0) + convertCoord (yeeLayout->getLeftBorderTFSF ());
             GridCoordinateFP3D rightBorder = GridCoordinateFP3D (0, 0, 0) + convertCoord (yeeLayout->getRightBorderTFSF ());
 
-            FPValue val = tmp->getCurValue ();
+            FPValue val = *Ex.getFieldValue (pos, 0);
 
-            if (updateAmplitude (val, tmpAmp, &maxAccuracy) == 0)
+            if (updateAmplitude (val, ExAmplitude.getFieldValue (pos, 0), &maxAccuracy) == 0)
             {
               is_stable_state = 0;
             }
@@ -3043,6 +3419,9 @@ Scheme3D::performAmplitudeSteps (time_step startStep)
       }
     }
 
+#ifdef OPENMP_ENABLED
+    #pragma omp parallel for collapse (2) reduction (max: maxAccuracy) reduction (min: is_stable_state)
+#endif /* OPENMP_ENABLED */
     for (int i = EyStart.getX (); i < EyEnd.getX (); ++i)
     {
       for (int j = EyStart.getY (); j < EyEnd.getY (); ++j)
@@ -3053,17 +3432,14 @@ Scheme3D::performAmplitudeSteps (time_step startStep)
 
           if (!yeeLayout->isEyInPML (Ey.getTotalPosition (pos)))
           {
-            FieldPointValue* tmp = Ey.getFieldPointValue (pos);
-            FieldPointValue* tmpAmp = EyAmplitude.getFieldPointValue (pos);
-
             GridCoordinateFP3D realCoord = yeeLayout->getEyCoordFP (Ey.getTotalPosition (pos));
 
             GridCoordinateFP3D leftBorder = GridCoordinateFP3D (0, 0, 0) + convertCoord (yeeLayout->getLeftBorderTFSF ());
             GridCoordinateFP3D rightBorder = GridCoordinateFP3D (0, 0, 0) + convertCoord (yeeLayout->getRightBorderTFSF ());
 
-            FPValue val = tmp->getCurValue ();
+            FPValue val = *Ey.getFieldValue (pos, 0);
 
-            if (updateAmplitude (val, tmpAmp, &maxAccuracy) == 0)
+            if (updateAmplitude (val, EyAmplitude.getFieldValue (pos, 0), &maxAccuracy) == 0)
             {
               is_stable_state = 0;
             }
@@ -3072,6 +3448,9 @@ Scheme3D::performAmplitudeSteps (time_step startStep)
       }
     }
 
+#ifdef OPENMP_ENABLED
+    #pragma omp parallel for collapse (2) reduction (max: maxAccuracy) reduction (min: is_stable_state)
+#endif /* OPENMP_ENABLED */
     for (int i = EzStart.getX (); i < EzEnd.getX (); ++i)
     {
       for (int j = EzStart.getY (); j < EzEnd.getY (); ++j)
@@ -3082,17 +3461,14 @@ Scheme3D::performAmplitudeSteps (time_step startStep)
 
           if (!yeeLayout->isEzInPML (Ez.getTotalPosition (pos)))
           {
-            FieldPointValue* tmp = Ez.getFieldPointValue (pos);
-            FieldPointValue* tmpAmp = EzAmplitude.getFieldPointValue (pos);
-
             GridCoordinateFP3D realCoord = yeeLayout->getEzCoordFP (Ez.getTotalPosition (pos));
 
             GridCoordinateFP3D leftBorder = GridCoordinateFP3D (0, 0, 0) + convertCoord (yeeLayout->getLeftBorderTFSF ());
             GridCoordinateFP3D rightBorder = GridCoordinateFP3D (0, 0, 0) + convertCoord (yeeLayout->getRightBorderTFSF ());
 
-            FPValue val = tmp->getCurValue ();
+            FPValue val = *Ez.getFieldValue (pos, 0);
 
-            if (updateAmplitude (val, tmpAmp, &maxAccuracy) == 0)
+            if (updateAmplitude (val, EzAmplitude.getFieldValue (pos, 0), &maxAccuracy) == 0)
             {
               is_stable_state = 0;
             }
@@ -3105,12 +3481,9 @@ Scheme3D::performAmplitudeSteps (time_step startStep)
     Ey.nextTimeStep ();
     Ez.nextTimeStep ();
 
-    if (usePML)
-    {
-      Dx.nextTimeStep ();
-      Dy.nextTimeStep ();
-      Dz.nextTimeStep ();
-    }
+    DxBoxes.nextTimeStep ();
+    DyBoxes.nextTimeStep ();
+    DzBoxes.nextTimeStep ();
 
     if (useTFSF)
     {
@@ -3121,6 +3494,9 @@ Scheme3D::performAmplitudeSteps (time_step startStep)
     performHySteps (t, HyStart, HyEnd);
     performHzSteps (t, HzStart, HzEnd);
 
+#ifdef OPENMP_ENABLED
+    #pragma omp parallel for collapse (2) reduction (max: maxAccuracy) reduction (min: is_stable_state)
+#endif /* OPENMP_ENABLED */
     for (int i = HxStart.getX (); i < HxEnd.getX (); ++i)
     {
       for (int j = HxStart.getY (); j < HxEnd.getY (); ++j)
@@ -3131,17 +3507,14 @@ Scheme3D::performAmplitudeSteps (time_step startStep)
 
           if (!yeeLayout->isHxInPML (Hx.getTotalPosition (pos)))
           {
-            FieldPointValue* tmp = Hx.getFieldPointValue (pos);
-            FieldPointValue* tmpAmp = HxAmplitude.getFieldPointValue (pos);
-
             GridCoordinateFP3D realCoord = yeeLayout->getHxCoordFP (Hx.getTotalPosition (pos));
 
             GridCoordinateFP3D leftBorder = GridCoordinateFP3D (0, 0, 0) + convertCoord (yeeLayout->getLeftBorderTFSF ());
             GridCoordinateFP3D rightBorder = GridCoordinateFP3D (0, 0, 0) + convertCoord (yeeLayout->getRightBorderTFSF ());
 
-            FPValue val = tmp->getCurValue ();
+            FPValue val = *Hx.getFieldValue (pos, 0);
 
-            if (updateAmplitude (val, tmpAmp, &maxAccuracy) == 0)
+            if (updateAmplitude (val, HxAmplitude.getFieldValue (pos, 0), &maxAccuracy) == 0)
             {
               is_stable_state = 0;
             }
@@ -3150,6 +3523,9 @@ Scheme3D::performAmplitudeSteps (time_step startStep)
       }
     }
 
+#ifdef OPENMP_ENABLED
+    #pragma omp parallel for collapse (2) reduction (max: maxAccuracy) reduction (min: is_stable_state)
+#endif /* OPENMP_ENABLED */
     for (int i = HyStart.getX (); i < HyEnd.getX (); ++i)
     {
       for (int j = HyStart.getY (); j < HyEnd.getY (); ++j)
@@ -3160,17 +3536,14 @@ Scheme3D::performAmplitudeSteps (time_step startStep)
 
           if (!yeeLayout->isHyInPML (Hy.getTotalPosition (pos)))
           {
-            FieldPointValue* tmp = Hy.getFieldPointValue (pos);
-            FieldPointValue* tmpAmp = HyAmplitude.getFieldPointValue (pos);
-
             GridCoordinateFP3D realCoord = yeeLayout->getHyCoordFP (Hy.getTotalPosition (pos));
 
             GridCoordinateFP3D leftBorder = GridCoordinateFP3D (0, 0, 0) + convertCoord (yeeLayout->getLeftBorderTFSF ());
             GridCoordinateFP3D rightBorder = GridCoordinateFP3D (0, 0, 0) + convertCoord (yeeLayout->getRightBorderTFSF ());
 
-            FPValue val = tmp->getCurValue ();
+            FPValue val = *Hy.getFieldValue (pos, 0);
 
-            if (updateAmplitude (val, tmpAmp, &maxAccuracy) == 0)
+            if (updateAmplitude (val, HyAmplitude.getFieldValue (pos, 0), &maxAccuracy) == 0)
             {
               is_stable_state = 0;
             }
@@ -3179,6 +3552,9 @@ Scheme3D::performAmplitudeSteps (time_step startStep)
       }
     }
 
+#ifdef OPENMP_ENABLED
+    #pragma omp parallel for collapse (2) reduction (max: maxAccuracy) reduction (min: is_stable_state)
+#endif /* OPENMP_ENABLED */
     for (int i = HzStart.getX (); i < HzEnd.getX (); ++i)
     {
       for (int j = HzStart.getY (); j < HzEnd.getY (); ++j)
@@ -3189,17 +3565,14 @@ Scheme3D::performAmplitudeSteps (time_step startStep)
 
           if (!yeeLayout->isHzInPML (Hz.getTotalPosition (pos)))
           {
-            FieldPointValue* tmp = Hz.getFieldPointValue (pos);
-            FieldPointValue* tmpAmp = HzAmplitude.getFieldPointValue (pos);
-
             GridCoordinateFP3D realCoord = yeeLayout->getHzCoordFP (Hz.getTotalPosition (pos));
 
             GridCoordinateFP3D leftBorder = GridCoordinateFP3D (0, 0, 0) + convertCoord (yeeLayout->getLeftBorderTFSF ());
             GridCoordinateFP3D rightBorder = GridCoordinateFP3D (0, 0, 0) + convertCoord (yeeLayout->getRightBorderTFSF ());
 
-            FPValue val = tmp->getCurValue ();
+            FPValue val = *Hz.getFieldValue (pos, 0);
 
-            if (updateAmplitude (val, tmpAmp, &maxAccuracy) == 0)
+            if (updateAmplitude (val, HzAmplitude.getFieldValue (pos, 0), &maxAccuracy) == 0)
             {
               is_stable_state = 0;
             }
@@ -3212,12 +3585,9 @@ Scheme3D::performAmplitudeSteps (time_step startStep)
     Hy.nextTimeStep ();
     Hz.nextTimeStep ();
 
-    if (usePML)
-    {
-      Bx.nextTimeStep ();
-      By.nextTimeStep ();
-      Bz.nextTimeStep ();
-    }
+    BxBoxes.nextTimeStep ();
+    ByBoxes.nextTimeStep ();
+    BzBoxes.nextTimeStep ();
 
     ++t;
 
@@ -3291,7 +3661,7 @@ Scheme3D::performAmplitudeSteps (time_step startStep)
 }
 
 int
-Scheme3D::updateAmplitude (FPValue val, FieldPointValue *amplitudeValue, FPValue *maxAccuracy)
+Scheme3D::updateAmplitude (FPValue val, FieldValuePointer amplitudeValue, FPValue *maxAccuracy)
 {
 #ifdef COMPLEX_FIELD_VALUES
   UNREACHABLE;
@@ -3299,7 +3669,7 @@ Scheme3D::updateAmplitude (FPValue val, FieldPointValue *amplitudeValue, FPValue
 
   int is_stable_state = 1;
 
-  FPValue valAmp = amplitudeValue->getCurValue ();
+  FPValue valAmp = *amplitudeValue;
 
   val = val >= 0 ? val : -val;
 
@@ -3319,7 +3689,7 @@ Scheme3D::updateAmplitude (FPValue val, FieldPointValue *amplitudeValue, FPValue
     {
       is_stable_state = 0;
 
-      amplitudeValue->setCurValue (val);
+      *amplitudeValue = val;
     }
 
     if (accuracy > *maxAccuracy)
@@ -3350,6 +3720,12 @@ Scheme3D::performSteps ()
 
   CudaExitStatus status;
 
+  Grid<GridCoordinate3D> Eps (Materials.getSize (), 0, "Eps", 1);
+  Grid<GridCoordinate3D> Mu (Materials.getSize (), 0, "Mu", 1);
+
+  Materials.fillGrid (Eps, GridType::EPS);
+  Materials.fillGrid (Mu, GridType::MU);
+
   cudaExecute3DSteps (&status, yeeLayout, gridTimeStep, gridStep, Ex, Ey, Ez, Hx, Hy, Hz, Eps, Mu, totalStep, processId);
 
   ASSERT (status == CUDA_OK);
@@ -3367,6 +3743,11 @@ Scheme3D::performSteps ()
     ASSERT_MESSAGE ("Metamaterials without pml are not implemented");
   }
 
+  if (useMetamaterials && useCPML)
+  {
+    ASSERT_MESSAGE ("Metamaterials with cpml are not implemented");
+  }
+
 #ifdef PARALLEL_GRID
   if (calculateAmplitude)
   {
@@ -3401,6 +3782,38 @@ Scheme3D::initScheme (FPValue dx, FPValue sourceFreq)
   relPhaseVelocity = phaseVelocity0 / phaseVelocity;
 }
 
+/**
+ * Calculate conductivity of PML with polynomial grading by single coordinate
+ *
+ * @return conductivity of PML, 0 outside of PML
+ */
+FPValue
+Scheme3D::calculateSigmaPML (FPValue posAbs, /**< absolute coordinate of material */
+                             FPValue size, /**< total size of grid of materials by coordinate */
+                             grid_coord PMLSize, /**< size of PML of grid of materials by coordinate */
+                             FPValue boundaryFactor, /**< factor of polynomial grading */
+                             uint32_t exponent) const /**< exponent of polynomial grading */
+{
+  if (posAbs < PMLSize)
+  {
+    grid_coord dist = PMLSize - posAbs;
+    FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
+    FPValue x2 = dist * gridStep;       // lower bounds for point i
+
+    return boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));    //   polynomial grading
+  }
+  else if (posAbs >= size - PMLSize)
+  {
+    grid_coord dist = posAbs - (size - PMLSize);
+    FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
+    FPValue x2 = dist * gridStep;       // lower bounds for point i
+
+    return boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
+  }
+
+  return 0;
+} /* Scheme3D::calculateSigmaPML */
+
 void
 Scheme3D::initGrids ()
 {
@@ -3410,23 +3823,50 @@ Scheme3D::initGrids ()
   int processId = 0;
 #endif /* !PARALLEL_GRID */
 
-  for (int i = 0; i < Eps.getSize ().getX (); ++i)
+  /*
+   * Constants of polynomial grading of conductivity of PML
+   */
+  GridCoordinate3D PMLSize = yeeLayout->getLeftBorderPML () * (yeeLayout->getIsDoubleMaterialPrecision () ? 2 : 1);
+
+  uint32_t exponent = 6;
+  FPValue boundaryFactor = 0;
+
+  if (usePML)
+  {
+    FPValue eps0 = PhysicsConst::Eps0;
+    FPValue mu0 = PhysicsConst::Mu0;
+
+    FPValue boundary = PMLSize.getX () * gridStep;
+    FPValue R_err = 1e-16;
+    FPValue sigma_max_1 = -log (R_err) * (exponent + 1.0) / (2.0 * sqrt (mu0 / eps0) * boundary);
+    boundaryFactor = sigma_max_1 / (gridStep * (pow (boundary, exponent)) * (exponent + 1));
+  }
+
+  GridCoordinateFP3D size = yeeLayout->getEpsCoordFP (Materials.getTotalSize ());
+
+  /*
+   * All properties of material are calculated for each point first, so that only final materials are added to table
+   * of materials (see MaterialGrid::setMaterial)
+   */
+  for (int i = 0; i < Materials.getSize ().getX (); ++i)
   {
-    for (int j = 0; j < Eps.getSize ().getY (); ++j)
+    for (int j = 0; j < Materials.getSize ().getY (); ++j)
     {
-      for (int k = 0; k < Eps.getSize ().getZ (); ++k)
+      for (int k = 0; k < Materials.getSize ().getZ (); ++k)
       {
-        FieldPointValue* eps = new FieldPointValue ();
+        GridCoordinate3D pos (i, j, k);
+        GridCoordinateFP3D posAbs = yeeLayout->getEpsCoordFP (Materials.getTotalPosition (pos));
+
+        Material material;
+
+        FieldValue eps;
 
 #ifdef COMPLEX_FIELD_VALUES
-        eps->setCurValue (FieldValue (1, 0));
+        eps = FieldValue (1, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        eps->setCurValue (1);
+        eps = 1;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinateFP3D posAbs = yeeLayout->getEpsCoordFP (Eps.getTotalPosition (pos));
-
 #ifdef COMPLEX_FIELD_VALUES
         FieldValue epsVal (2, 0);
 #else /* COMPLEX_FIELD_VALUES */
@@ -3434,637 +3874,1131 @@ Scheme3D::initGrids ()
 #endif /* !COMPLEX_FIELD_VALUES */
 
         FPValue modifier = (yeeLayout->getIsDoubleMaterialPrecision () ? 2 : 1);
-        eps->setCurValue (Approximation::approximateSphere (posAbs, GridCoordinateFP3D (40.5, 40.5, 40.5) * modifier, 20 * modifier, epsVal));
+        eps = Approximation::approximateSphere (posAbs, GridCoordinateFP3D (40.5, 40.5, 40.5) * modifier, 20 * modifier, epsVal);
 
-        Eps.setFieldPointValue (eps, pos);
-      }
-    }
-  }
+        material.setProperty (GridType::EPS, Approximation::getMaterial (&eps));
 
-  BMPDumper<GridCoordinate3D> dumper;
+        if (useMetamaterials)
+        {
+          FieldValue valOmega;
 
-  if (dumpRes)
-  {
-    dumper.init (0, CURRENT, processId, "Eps");
-    dumper.dumpGrid (Eps, GridCoordinate3D (0), Eps.getSize ());
-  }
+#ifdef COMPLEX_FIELD_VALUES
+          valOmega = FieldValue (0, 0);
+#else /* COMPLEX_FIELD_VALUES */
+          valOmega = 0;
+#endif /* !COMPLEX_FIELD_VALUES */
 
-  for (int i = 0; i < OmegaPE.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < OmegaPE.getSize ().getY (); ++j)
-    {
-      for (int k = 0; k < OmegaPE.getSize ().getZ (); ++k)
-      {
-        FieldPointValue* valOmega = new FieldPointValue ();
+          // if (posAbs.getX () >= 55 && posAbs.getX () < 60
+          //     && posAbs.getY () >= 55 && posAbs.getY () < 65
+          //     && posAbs.getZ () >= 15 && posAbs.getZ () < 25)
+          // {
+          if (SQR (posAbs.getX () - 57) + SQR (posAbs.getY () - 57) + SQR (posAbs.getZ () - 23) < SQR (8))
+          {
 
+  // //         if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
+  // //             + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2)
+  // //             + (posAbs.getZ () - size.getZ () / 2) * (posAbs.getZ () - size.getZ () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0))
+  // //         {
 #ifdef COMPLEX_FIELD_VALUES
-        valOmega->setCurValue (FieldValue (0, 0));
+            valOmega = FieldValue (sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        valOmega->setCurValue (0);
+            valOmega = sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency;
 #endif /* !COMPLEX_FIELD_VALUES */
+          }
 
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinateFP3D posAbs = yeeLayout->getEpsCoordFP (OmegaPE.getTotalPosition (pos));
-
-        GridCoordinateFP3D size = yeeLayout->getEpsCoordFP (OmegaPE.getTotalSize ());
+          material.setProperty (GridType::OMEGAPE, Approximation::getMaterial (&valOmega));
 
-        // if (posAbs.getX () >= 55 && posAbs.getX () < 60
-        //     && posAbs.getY () >= 55 && posAbs.getY () < 65
-        //     && posAbs.getZ () >= 15 && posAbs.getZ () < 25)
-        // {
-        if (SQR (posAbs.getX () - 57) + SQR (posAbs.getY () - 57) + SQR (posAbs.getZ () - 23) < SQR (8))
-        {
+#ifdef COMPLEX_FIELD_VALUES
+          valOmega = FieldValue (0, 0);
+#else /* COMPLEX_FIELD_VALUES */
+          valOmega = 0;
+#endif /* !COMPLEX_FIELD_VALUES */
 
-// //         if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
-// //             + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2)
-// //             + (posAbs.getZ () - size.getZ () / 2) * (posAbs.getZ () - size.getZ () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0))
-// //         {
+          if (posAbs.getX () >= 55 && posAbs.getX () < 60
+              && posAbs.getY () >= 55 && posAbs.getY () < 65
+              && posAbs.getZ () >= 15 && posAbs.getZ () < 25)
+          {
+  //
+  // //         if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
+  // //             + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2)
+  // //             + (posAbs.getZ () - size.getZ () / 2) * (posAbs.getZ () - size.getZ () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0))
+  // //         {
 #ifdef COMPLEX_FIELD_VALUES
-          valOmega->setCurValue (FieldValue (sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency, 0));
+            valOmega = FieldValue (sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency, 0);
 #else /* COMPLEX_FIELD_VALUES */
-          valOmega->setCurValue (sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency);
+            valOmega = sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency;
 #endif /* !COMPLEX_FIELD_VALUES */
-        }
+          }
 
-        OmegaPE.setFieldPointValue (valOmega, pos);
-      }
-    }
-  }
+          material.setProperty (GridType::OMEGAPM, Approximation::getMaterial (&valOmega));
 
-  for (int i = 0; i < OmegaPM.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < OmegaPM.getSize ().getY (); ++j)
-    {
-      for (int k = 0; k < OmegaPM.getSize ().getZ (); ++k)
-      {
-        FieldPointValue* valOmega = new FieldPointValue ();
+          FieldValue valGamma;
 
 #ifdef COMPLEX_FIELD_VALUES
-        valOmega->setCurValue (FieldValue (0, 0));
+          valGamma = FieldValue (0, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        valOmega->setCurValue (0);
+          valGamma = 0;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinateFP3D posAbs = yeeLayout->getEpsCoordFP (OmegaPM.getTotalPosition (pos));
+        // if (posAbs.getX () >= size.getX () / 2 - 20 && posAbs.getX () < size.getX () / 2 + 20
+        //     && posAbs.getY () >= 50 && posAbs.getY () < size.getY () - 50)
+        // {
+        //   valGamma->setCurValue (1);
+        // }
 
-        GridCoordinateFP3D size = yeeLayout->getEpsCoordFP (OmegaPM.getTotalSize ());
+        // if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
+        //     + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0))
+        // {
+        //   valGamma->setCurValue (1);
+        // }
+
+          material.setProperty (GridType::GAMMAE, Approximation::getMaterial (&valGamma));
+          material.setProperty (GridType::GAMMAM, Approximation::getMaterial (&valGamma));
+        }
+
+        FieldValue mu;
 
-        if (posAbs.getX () >= 55 && posAbs.getX () < 60
-            && posAbs.getY () >= 55 && posAbs.getY () < 65
-            && posAbs.getZ () >= 15 && posAbs.getZ () < 25)
-        {
-//
-// //         if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
-// //             + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2)
-// //             + (posAbs.getZ () - size.getZ () / 2) * (posAbs.getZ () - size.getZ () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0))
-// //         {
 #ifdef COMPLEX_FIELD_VALUES
-          valOmega->setCurValue (FieldValue (sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency, 0));
+        mu = FieldValue (1, 0);
 #else /* COMPLEX_FIELD_VALUES */
-          valOmega->setCurValue (sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency);
+        mu = 1;
 #endif /* !COMPLEX_FIELD_VALUES */
+
+        material.setProperty (GridType::MU, Approximation::getMaterial (&mu));
+
+        if (usePML)
+        {
+          /*
+           * FIXME: add layout coordinates for material: sigma, eps, etc.
+           */
+          material.setProperty (GridType::SIGMAX, calculateSigmaPML (posAbs.getX (), size.getX (), PMLSize.getX (),
+                                                                     boundaryFactor, exponent));
+          material.setProperty (GridType::SIGMAY, calculateSigmaPML (posAbs.getY (), size.getY (), PMLSize.getY (),
+                                                                     boundaryFactor, exponent));
+          material.setProperty (GridType::SIGMAZ, calculateSigmaPML (posAbs.getZ (), size.getZ (), PMLSize.getZ (),
+                                                                     boundaryFactor, exponent));
         }
 
-        OmegaPM.setFieldPointValue (valOmega, pos);
+        Materials.setMaterial (material, pos);
       }
     }
   }
 
-  for (int i = 0; i < GammaE.getSize ().getX (); ++i)
+  DPRINTF ("Distinct materials: %lu.\n", (unsigned long) Materials.getCountMaterials ());
+
+  BMPDumper<GridCoordinate3D> dumper;
+
+  /*
+   * Grid of values of single material property, which is allocated only to dump materials
+   */
+  Grid<GridCoordinate3D> materialGrid (Materials.getSize (), 0, "Material", dumpRes ? 1 : 0);
+
+  if (dumpRes)
   {
-    for (int j = 0; j < GammaE.getSize ().getY (); ++j)
+    Materials.fillGrid (materialGrid, GridType::EPS);
+    dumper.init (0, CURRENT, processId, "Eps");
+    dumper.dumpGrid (materialGrid, GridCoordinate3D (0), Materials.getSize ());
+
+    if (useMetamaterials)
     {
-      for (int k = 0; k < GammaE.getSize ().getZ (); ++k)
-      {
-        FieldPointValue* valGamma = new FieldPointValue ();
+      Materials.fillGrid (materialGrid, GridType::OMEGAPE);
+      dumper.init (0, CURRENT, processId, "OmegaPE");
+      dumper.dumpGrid (materialGrid, GridCoordinate3D (0), Materials.getSize ());
 
-#ifdef COMPLEX_FIELD_VALUES
-        valGamma->setCurValue (FieldValue (0, 0));
-#else /* COMPLEX_FIELD_VALUES */
-        valGamma->setCurValue (0);
-#endif /* !COMPLEX_FIELD_VALUES */
+      Materials.fillGrid (materialGrid, GridType::OMEGAPM);
+      dumper.init (0, CURRENT, processId, "OmegaPM");
+      dumper.dumpGrid (materialGrid, GridCoordinate3D (0), Materials.getSize ());
 
-        GridCoordinate3D pos (i, j, k);
-      // GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (Eps.getTotalPosition (pos)));
-      //
-      // GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (Eps.getTotalSize ()));
-
-      // GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (GammaE.getTotalPosition (pos)));
-      //
-      // GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (GammaE.getTotalSize ()));
-      //
-      // if (posAbs.getX () >= size.getX () / 2 - 20 && posAbs.getX () < size.getX () / 2 + 20
-      //     && posAbs.getY () >= 50 && posAbs.getY () < size.getY () - 50)
-      // {
-      //   valGamma->setCurValue (1);
-      // }
-
-      // if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
-      //     + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0))
-      // {
-      //   valGamma->setCurValue (1);
-      // }
-
-        GammaE.setFieldPointValue (valGamma, pos);
-      }
+      Materials.fillGrid (materialGrid, GridType::GAMMAE);
+      dumper.init (0, CURRENT, processId, "GammaE");
+      dumper.dumpGrid (materialGrid, GridCoordinate3D (0), Materials.getSize ());
+
+      Materials.fillGrid (materialGrid, GridType::GAMMAM);
+      dumper.init (0, CURRENT, processId, "GammaM");
+      dumper.dumpGrid (materialGrid, GridCoordinate3D (0), Materials.getSize ());
+    }
+
+    Materials.fillGrid (materialGrid, GridType::MU);
+    dumper.init (0, CURRENT, processId, "Mu");
+    dumper.dumpGrid (materialGrid, GridCoordinate3D (0), Materials.getSize ());
+
+    if (usePML)
+    {
+      Materials.fillGrid (materialGrid, GridType::SIGMAX);
+      dumper.init (0, CURRENT, processId, "SigmaX");
+      dumper.dumpGrid (materialGrid, GridCoordinate3D (0), Materials.getSize ());
+      Materials.fillGrid (materialGrid, GridType::SIGMAY);
+      dumper.init (0, CURRENT, processId, "SigmaY");
+      dumper.dumpGrid (materialGrid, GridCoordinate3D (0), Materials.getSize ());
+      Materials.fillGrid (materialGrid, GridType::SIGMAZ);
+      dumper.init (0, CURRENT, processId, "SigmaZ");
+      dumper.dumpGrid (materialGrid, GridCoordinate3D (0), Materials.getSize ());
     }
   }
 
-  for (int i = 0; i < GammaM.getSize ().getX (); ++i)
+  if (usePML)
   {
-    for (int j = 0; j < GammaM.getSize ().getY (); ++j)
+    initPMLProfiles ();
+
+    if (useCPML)
     {
-      for (int k = 0; k < GammaM.getSize ().getZ (); ++k)
-      {
-        FieldPointValue* valGamma = new FieldPointValue ();
+      initCPMLPsis ();
+    }
+  }
 
-#ifdef COMPLEX_FIELD_VALUES
-        valGamma->setCurValue (FieldValue (0, 0));
-#else /* COMPLEX_FIELD_VALUES */
-        valGamma->setCurValue (0);
-#endif /* !COMPLEX_FIELD_VALUES */
+  initMaterialTables ();
 
-        GridCoordinate3D pos (i, j, k);
-      // GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (Eps.getTotalPosition (pos)));
-      //
-      // GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (Eps.getTotalSize ()));
-
-      // GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (GammaE.getTotalPosition (pos)));
-      //
-      // GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (GammaE.getTotalSize ()));
-      //
-      // if (posAbs.getX () >= size.getX () / 2 - 20 && posAbs.getX () < size.getX () / 2 + 20
-      //     && posAbs.getY () >= 50 && posAbs.getY () < size.getY () - 50)
-      // {
-      //   valGamma->setCurValue (1);
-      // }
-
-      // if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
-      //     + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0))
-      // {
-      //   valGamma->setCurValue (1);
-      // }
-
-        GammaM.setFieldPointValue (valGamma, pos);
-      }
-    }
+  if (useMetamaterials)
+  {
+    initDrudeTables ();
   }
 
-  if (dumpRes)
+  if (usePML && !useCPML)
   {
-    dumper.init (0, CURRENT, processId, "OmegaPE");
-    dumper.dumpGrid (OmegaPE, GridCoordinate3D (0), Eps.getSize ());
+    initAllPMLBoxes ();
+  }
 
-    dumper.init (0, CURRENT, processId, "OmegaPM");
-    dumper.dumpGrid (OmegaPM, GridCoordinate3D (0), Eps.getSize ());
+  if (useTFSF)
+  {
+    initTFSFBorders ();
+  }
 
-    dumper.init (0, CURRENT, processId, "GammaE");
-    dumper.dumpGrid (GammaE, GridCoordinate3D (0), Eps.getSize ());
+#if defined (PARALLEL_GRID)
+  MPI_Barrier (MPI_COMM_WORLD);
+#endif
+}
 
-    dumper.init (0, CURRENT, processId, "GammaM");
-    dumper.dumpGrid (GammaM, GridCoordinate3D (0), Eps.getSize ());
-  }
+/**
+ * Calculate conductivity of CPML at position of field component. Conductivity of PML (see Scheme3D::initGrids) is
+ * graded steeply for the split update of PML, recursive convolution of CPML reflects less with polynomial grading of
+ * lower order and smaller maximum, which is sampled at real coordinate of field component instead of averaging over
+ * cells of material.
+ *
+ * @return conductivity of CPML
+ */
+FPValue
+Scheme3D::getCPMLConductivity (GridCoordinate3D posAbs, /**< absolute position of field component */
+                               GridType typeOfField, /**< type of D or B component */
+                               GridType typeOfSigma) /**< conductivity (SIGMAX, SIGMAY or SIGMAZ), which defines axis */
+{
+  FPValue eps0 = PhysicsConst::Eps0;
+  FPValue mu0 = PhysicsConst::Mu0;
+
+  GridCoordinateFP3D realCoord;
 
-  for (int i = 0; i < Mu.getSize ().getX (); ++i)
+  switch (typeOfField)
   {
-    for (int j = 0; j < Mu.getSize ().getY (); ++j)
+    case GridType::DX:
     {
-      for (int k = 0; k < Mu.getSize ().getZ (); ++k)
-      {
-        FieldPointValue* mu = new FieldPointValue ();
+      realCoord = yeeLayout->getExCoordFP (posAbs);
+      break;
+    }
+    case GridType::DY:
+    {
+      realCoord = yeeLayout->getEyCoordFP (posAbs);
+      break;
+    }
+    case GridType::DZ:
+    {
+      realCoord = yeeLayout->getEzCoordFP (posAbs);
+      break;
+    }
+    case GridType::BX:
+    {
+      realCoord = yeeLayout->getHxCoordFP (posAbs);
+      break;
+    }
+    case GridType::BY:
+    {
+      realCoord = yeeLayout->getHyCoordFP (posAbs);
+      break;
+    }
+    case GridType::BZ:
+    {
+      realCoord = yeeLayout->getHzCoordFP (posAbs);
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
 
-#ifdef COMPLEX_FIELD_VALUES
-        mu->setCurValue (FieldValue (1, 0));
-#else /* COMPLEX_FIELD_VALUES */
-        mu->setCurValue (1);
-#endif /* !COMPLEX_FIELD_VALUES */
+  GridCoordinateFP3D zeroCoord = yeeLayout->getZeroCoordFP ();
+  GridCoordinateFP3D leftBorder = zeroCoord + convertCoord (yeeLayout->getLeftBorderPML ());
+  GridCoordinateFP3D rightBorder = zeroCoord + convertCoord (yeeLayout->getRightBorderPML ());
 
-        GridCoordinate3D pos (i, j, k);
+  FPValue coord;
+  FPValue left;
+  FPValue right;
+  FPValue size;
 
-        Mu.setFieldPointValue (mu, pos);
-      }
+  switch (typeOfSigma)
+  {
+    case GridType::SIGMAX:
+    {
+      coord = realCoord.getX ();
+      left = leftBorder.getX ();
+      right = rightBorder.getX ();
+      size = leftBorder.getX () - zeroCoord.getX ();
+      break;
+    }
+    case GridType::SIGMAY:
+    {
+      coord = realCoord.getY ();
+      left = leftBorder.getY ();
+      right = rightBorder.getY ();
+      size = leftBorder.getY () - zeroCoord.getY ();
+      break;
+    }
+    case GridType::SIGMAZ:
+    {
+      coord = realCoord.getZ ();
+      left = leftBorder.getZ ();
+      right = rightBorder.getZ ();
+      size = leftBorder.getZ () - zeroCoord.getZ ();
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
     }
   }
 
-  if (dumpRes)
+  /*
+   * Depth in PML relative to its size, PML is of the same size at both borders
+   */
+  FPValue depth = 0;
+
+  if (coord < left)
   {
-    dumper.init (0, CURRENT, processId, "Mu");
-    dumper.dumpGrid (Mu, GridCoordinate3D (0), Eps.getSize ());
+    depth = (left - coord) / size;
+  }
+  else if (coord > right)
+  {
+    depth = (coord - right) / size;
   }
 
+  /*
+   * Maximum conductivity gives theoretical reflection CPML_REFLECTION at normal incidence
+   */
+  FPValue sigmaMax = -log (CPML_REFLECTION) * (CPML_GRADING_ORDER + 1.0) / (2.0 * sqrt (mu0 / eps0) * size * gridStep);
+
+  return sigmaMax * pow (depth, CPML_GRADING_ORDER);
+} /* Scheme3D::getCPMLConductivity */
+
+/**
+ * Precalculate coefficients of PML, which depend on conductivity along one axis, for each relative coordinate of
+ * field grid along this axis. Conductivity along axis does not depend on other coordinates, so they are taken from
+ * start of computations. Coefficients are calculated only between start and end of computations, range of zero
+ * conductivity is found among these coordinates.
+ */
+void
+Scheme3D::initPMLProfile (PMLProfile &profile, /**< out: coefficients of PML */
+                          FieldGrid &grid, /**< grid of field component */
+                          GridType typeOfField, /**< type of D or B component at the same positions as grid */
+                          GridType typeOfSigma, /**< conductivity (SIGMAX, SIGMAY or SIGMAZ), which defines axis */
+                          GridCoordinate3D start, /**< start of computations */
+                          GridCoordinate3D end) /**< end of computations */
+{
   FPValue eps0 = PhysicsConst::Eps0;
-  FPValue mu0 = PhysicsConst::Mu0;
+  FPValue k = 1;
+
+  grid_coord size;
+  grid_coord first;
+  grid_coord last;
+
+  switch (typeOfSigma)
+  {
+    case GridType::SIGMAX:
+    {
+      size = grid.getSize ().getX ();
+      first = start.getX ();
+      last = end.getX ();
+      break;
+    }
+    case GridType::SIGMAY:
+    {
+      size = grid.getSize ().getY ();
+      first = start.getY ();
+      last = end.getY ();
+      break;
+    }
+    case GridType::SIGMAZ:
+    {
+      size = grid.getSize ().getZ ();
+      first = start.getZ ();
+      last = end.getZ ();
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
+
+  profile.Ca.assign (size, 0);
+  profile.Cb.assign (size, 0);
+  profile.sum.assign (size, 0);
+  profile.diff.assign (size, 0);
+  profile.inverseSum.assign (size, 0);
+  profile.b.assign (size, 1);
+  profile.c.assign (size, 0);
+
+  profile.interiorStart = first;
+  profile.interiorEnd = first;
+
+  for (grid_coord coord = first; coord < last; ++coord)
+  {
+    GridCoordinate3D pos (typeOfSigma == GridType::SIGMAX ? coord : start.getX (),
+                          typeOfSigma == GridType::SIGMAY ? coord : start.getY (),
+                          typeOfSigma == GridType::SIGMAZ ? coord : start.getZ ());
+    GridCoordinate3D posAbs = grid.getTotalPosition (pos);
+
+    FPValue sigma = yeeLayout->getMaterial (posAbs, typeOfField, Materials, typeOfSigma);
+
+    profile.Ca[coord] = (2 * eps0 * k - sigma * gridTimeStep) / (2 * eps0 * k + sigma * gridTimeStep);
+    profile.Cb[coord] = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k + sigma * gridTimeStep);
+    profile.sum[coord] = 2 * eps0 * k + sigma * gridTimeStep;
+    profile.diff[coord] = 2 * eps0 * k - sigma * gridTimeStep;
+    profile.inverseSum[coord] = 1 / (2 * eps0 * k + sigma * gridTimeStep);
+    FPValue sigmaCPML = useCPML ? getCPMLConductivity (posAbs, typeOfField, typeOfSigma) : sigma;
+
+    profile.b[coord] = exp (-sigmaCPML * gridTimeStep / (k * eps0));
+    profile.c[coord] = profile.b[coord] - 1;
+
+    /*
+     * Only the first range of zero conductivity is taken, PML update is used outside of it
+     */
+    if (sigma != 0)
+    {
+      continue;
+    }
+
+    if (profile.interiorStart == profile.interiorEnd)
+    {
+      profile.interiorStart = coord;
+      profile.interiorEnd = coord + 1;
+    }
+    else if (profile.interiorEnd == coord)
+    {
+      profile.interiorEnd = coord + 1;
+    }
+  }
+} /* Scheme3D::initPMLProfile */
+
+/**
+ * Precalculate coefficients of PML for all field components. Should be called after conductivities are set.
+ *
+ * Range of computations is the widest before the first time step (see ParallelGrid::getComputationStart), so
+ * coefficients are available for ranges of all time steps.
+ */
+void
+Scheme3D::initPMLProfiles ()
+{
+  GridCoordinate3D ExStart = Ex.getComputationStart (yeeLayout->getExStartDiff ());
+  GridCoordinate3D ExEnd = Ex.getComputationEnd (yeeLayout->getExEndDiff ());
+
+  initPMLProfile (ExProfileX, Ex, GridType::DX, GridType::SIGMAX, ExStart, ExEnd);
+  initPMLProfile (ExProfileY, Ex, GridType::DX, GridType::SIGMAY, ExStart, ExEnd);
+  initPMLProfile (ExProfileZ, Ex, GridType::DX, GridType::SIGMAZ, ExStart, ExEnd);
+
+  GridCoordinate3D EyStart = Ey.getComputationStart (yeeLayout->getEyStartDiff ());
+  GridCoordinate3D EyEnd = Ey.getComputationEnd (yeeLayout->getEyEndDiff ());
+
+  initPMLProfile (EyProfileX, Ey, GridType::DY, GridType::SIGMAX, EyStart, EyEnd);
+  initPMLProfile (EyProfileY, Ey, GridType::DY, GridType::SIGMAY, EyStart, EyEnd);
+  initPMLProfile (EyProfileZ, Ey, GridType::DY, GridType::SIGMAZ, EyStart, EyEnd);
 
-  GridCoordinate3D PMLSize = yeeLayout->getLeftBorderPML () * (yeeLayout->getIsDoubleMaterialPrecision () ? 2 : 1);
+  GridCoordinate3D EzStart = Ez.getComputationStart (yeeLayout->getEzStartDiff ());
+  GridCoordinate3D EzEnd = Ez.getComputationEnd (yeeLayout->getEzEndDiff ());
 
-  FPValue boundary = PMLSize.getX () * gridStep;
-  uint32_t exponent = 6;
-	FPValue R_err = 1e-16;
-	FPValue sigma_max_1 = -log (R_err) * (exponent + 1.0) / (2.0 * sqrt (mu0 / eps0) * boundary);
-	FPValue boundaryFactor = sigma_max_1 / (gridStep * (pow (boundary, exponent)) * (exponent + 1));
+  initPMLProfile (EzProfileX, Ez, GridType::DZ, GridType::SIGMAX, EzStart, EzEnd);
+  initPMLProfile (EzProfileY, Ez, GridType::DZ, GridType::SIGMAY, EzStart, EzEnd);
+  initPMLProfile (EzProfileZ, Ez, GridType::DZ, GridType::SIGMAZ, EzStart, EzEnd);
 
-  for (int i = 0; i < SigmaX.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < SigmaX.getSize ().getY (); ++j)
-    {
-      for (int k = 0; k < SigmaX.getSize ().getZ (); ++k)
-      {
-        FieldPointValue* valSigma = new FieldPointValue ();
+  GridCoordinate3D HxStart = Hx.getComputationStart (yeeLayout->getHxStartDiff ());
+  GridCoordinate3D HxEnd = Hx.getComputationEnd (yeeLayout->getHxEndDiff ());
 
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinateFP3D posAbs = yeeLayout->getEpsCoordFP (SigmaX.getTotalPosition (pos));
+  initPMLProfile (HxProfileX, Hx, GridType::BX, GridType::SIGMAX, HxStart, HxEnd);
+  initPMLProfile (HxProfileY, Hx, GridType::BX, GridType::SIGMAY, HxStart, HxEnd);
+  initPMLProfile (HxProfileZ, Hx, GridType::BX, GridType::SIGMAZ, HxStart, HxEnd);
 
-        GridCoordinateFP3D size = yeeLayout->getEpsCoordFP (SigmaX.getTotalSize ());
+  GridCoordinate3D HyStart = Hy.getComputationStart (yeeLayout->getHyStartDiff ());
+  GridCoordinate3D HyEnd = Hy.getComputationEnd (yeeLayout->getHyEndDiff ());
 
-        /*
-         * FIXME: add layout coordinates for material: sigma, eps, etc.
-         */
-        if (posAbs.getX () < PMLSize.getX ())
-        {
-          grid_coord dist = PMLSize.getX () - posAbs.getX ();
-    			FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
-    			FPValue x2 = dist * gridStep;       // lower bounds for point i
+  initPMLProfile (HyProfileX, Hy, GridType::BY, GridType::SIGMAX, HyStart, HyEnd);
+  initPMLProfile (HyProfileY, Hy, GridType::BY, GridType::SIGMAY, HyStart, HyEnd);
+  initPMLProfile (HyProfileZ, Hy, GridType::BY, GridType::SIGMAZ, HyStart, HyEnd);
 
-          FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));    //   polynomial grading
+  GridCoordinate3D HzStart = Hz.getComputationStart (yeeLayout->getHzStartDiff ());
+  GridCoordinate3D HzEnd = Hz.getComputationEnd (yeeLayout->getHzEndDiff ());
 
-#ifdef COMPLEX_FIELD_VALUES
-    			valSigma->setCurValue (FieldValue (val, 0));
-#else /* COMPLEX_FIELD_VALUES */
-          valSigma->setCurValue (val);
-#endif /* !COMPLEX_FIELD_VALUES */
-        }
-        else if (posAbs.getX () >= size.getX () - PMLSize.getX ())
-        {
-          grid_coord dist = posAbs.getX () - (size.getX () - PMLSize.getX ());
-    			FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
-    			FPValue x2 = dist * gridStep;       // lower bounds for point i
+  initPMLProfile (HzProfileX, Hz, GridType::BZ, GridType::SIGMAX, HzStart, HzEnd);
+  initPMLProfile (HzProfileY, Hz, GridType::BZ, GridType::SIGMAY, HzStart, HzEnd);
+  initPMLProfile (HzProfileZ, Hz, GridType::BZ, GridType::SIGMAZ, HzStart, HzEnd);
+} /* Scheme3D::initPMLProfiles */
 
-    			//std::cout << boundaryFactor * (pow(x1, (exponent + 1)) - pow(x2, (exponent + 1))) << std::endl;
-    			FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
+/**
+ * Allocate auxiliary values of CPML for derivative along axis in layers of PML. Should be called after PML profiles
+ * are calculated.
+ */
+void
+Scheme3D::initCPMLPsi (CPMLPsi &psi, /**< out: auxiliary values of CPML */
+                       FieldGrid &grid, /**< grid of field component */
+                       const PMLProfile &profile, /**< PML profile of field component along axis of derivative */
+                       GridType typeOfSigma) /**< conductivity (SIGMAX, SIGMAY or SIGMAZ), which defines axis */
+{
+  GridCoordinate3D size = grid.getSize ();
 
-#ifdef COMPLEX_FIELD_VALUES
-    			valSigma->setCurValue (FieldValue (val, 0));
-#else /* COMPLEX_FIELD_VALUES */
-          valSigma->setCurValue (val);
-#endif /* !COMPLEX_FIELD_VALUES */
-        }
+  grid_coord interiorSize = profile.interiorEnd - profile.interiorStart;
 
-        SigmaX.setFieldPointValue (valSigma, pos);
-      }
+  switch (typeOfSigma)
+  {
+    case GridType::SIGMAX:
+    {
+      size = GridCoordinate3D (size.getX () - interiorSize, size.getY (), size.getZ ());
+      break;
+    }
+    case GridType::SIGMAY:
+    {
+      size = GridCoordinate3D (size.getX (), size.getY () - interiorSize, size.getZ ());
+      break;
+    }
+    case GridType::SIGMAZ:
+    {
+      size = GridCoordinate3D (size.getX (), size.getY (), size.getZ () - interiorSize);
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
     }
   }
 
-  for (int i = 0; i < SigmaY.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < SigmaY.getSize ().getY (); ++j)
-    {
-      for (int k = 0; k < SigmaY.getSize ().getZ (); ++k)
-      {
-        FieldPointValue* valSigma = new FieldPointValue ();
+  psi.typeOfSigma = typeOfSigma;
+  psi.size = size;
+  psi.interiorStart = profile.interiorStart;
+  psi.interiorEnd = profile.interiorEnd;
+  psi.values.assign (size.calculateTotalCoord (), FieldValue (0));
+} /* Scheme3D::initCPMLPsi */
 
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinateFP3D posAbs = yeeLayout->getEpsCoordFP (SigmaY.getTotalPosition (pos));
+/**
+ * Allocate auxiliary values of CPML for all field components
+ */
+void
+Scheme3D::initCPMLPsis ()
+{
+  initCPMLPsi (ExPsiY, Ex, ExProfileY, GridType::SIGMAY);
+  initCPMLPsi (ExPsiZ, Ex, ExProfileZ, GridType::SIGMAZ);
 
-        GridCoordinateFP3D size = yeeLayout->getEpsCoordFP (SigmaY.getTotalSize ());
+  initCPMLPsi (EyPsiZ, Ey, EyProfileZ, GridType::SIGMAZ);
+  initCPMLPsi (EyPsiX, Ey, EyProfileX, GridType::SIGMAX);
 
-        /*
-         * FIXME: add layout coordinates for material: sigma, eps, etc.
-         */
-        if (posAbs.getY () < PMLSize.getY ())
-        {
-          grid_coord dist = PMLSize.getY () - posAbs.getY ();
-          FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
-          FPValue x2 = dist * gridStep;       // lower bounds for point i
+  initCPMLPsi (EzPsiX, Ez, EzProfileX, GridType::SIGMAX);
+  initCPMLPsi (EzPsiY, Ez, EzProfileY, GridType::SIGMAY);
 
-          FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
+  initCPMLPsi (HxPsiZ, Hx, HxProfileZ, GridType::SIGMAZ);
+  initCPMLPsi (HxPsiY, Hx, HxProfileY, GridType::SIGMAY);
 
-#ifdef COMPLEX_FIELD_VALUES
-    			valSigma->setCurValue (FieldValue (val, 0));
-#else /* COMPLEX_FIELD_VALUES */
-          valSigma->setCurValue (val);
-#endif /* !COMPLEX_FIELD_VALUES */
-        }
-        else if (posAbs.getY () >= size.getY () - PMLSize.getY ())
-        {
-          grid_coord dist = posAbs.getY () - (size.getY () - PMLSize.getY ());
-          FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
-          FPValue x2 = dist * gridStep;       // lower bounds for point i
+  initCPMLPsi (HyPsiX, Hy, HyProfileX, GridType::SIGMAX);
+  initCPMLPsi (HyPsiZ, Hy, HyProfileZ, GridType::SIGMAZ);
 
-          //std::cout << boundaryFactor * (pow(x1, (exponent + 1)) - pow(x2, (exponent + 1))) << std::endl;
-          FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
+  initCPMLPsi (HzPsiY, Hz, HzProfileY, GridType::SIGMAY);
+  initCPMLPsi (HzPsiX, Hz, HzProfileX, GridType::SIGMAX);
+} /* Scheme3D::initCPMLPsis */
 
-#ifdef COMPLEX_FIELD_VALUES
-    			valSigma->setCurValue (FieldValue (val, 0));
-#else /* COMPLEX_FIELD_VALUES */
-          valSigma->setCurValue (val);
-#endif /* !COMPLEX_FIELD_VALUES */
-        }
+/**
+ * Allocate D and D1 (B and B1) of field component in boxes, where field component is updated by PML update (see
+ * Scheme3D::performSplitSteps), i.e. in six slabs of PML around box of zero conductivity and, for metamaterials, in box
+ * of cells of Drude model inside of it. Should be called after PML profiles and coefficients of Drude model are
+ * calculated.
+ */
+void
+Scheme3D::initPMLBoxes (PMLBoxes &boxes, /**< out: D and D1 (B and B1) of field component */
+                        const char *nameD, /**< name of D (B) */
+                        const char *nameD1, /**< name of D1 (B1) */
+                        const PMLProfile &profileX, /**< PML profile of field component along Ox axis */
+                        const PMLProfile &profileY, /**< PML profile of field component along Oy axis */
+                        const PMLProfile &profileZ, /**< PML profile of field component along Oz axis */
+                        GridCoordinate3D start, /**< start of computations */
+                        GridCoordinate3D end) /**< end of computations */
+{
+  GridCoordinate3D partStarts[RANGE_PARTS];
+  GridCoordinate3D partEnds[RANGE_PARTS];
 
-        SigmaY.setFieldPointValue (valSigma, pos);
-      }
-    }
-  }
+  splitRange (start, end,
+              GridCoordinate3D (profileX.interiorStart, profileY.interiorStart, profileZ.interiorStart),
+              GridCoordinate3D (profileX.interiorEnd, profileY.interiorEnd, profileZ.interiorEnd),
+              partStarts, partEnds);
 
-  for (int i = 0; i < SigmaZ.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < SigmaZ.getSize ().getY (); ++j)
-    {
-      for (int k = 0; k < SigmaZ.getSize ().getZ (); ++k)
-      {
-        FieldPointValue* valSigma = new FieldPointValue ();
+  /*
+   * Drude model requires D and D1 at two previous time steps
+   */
+  int layersD = useMetamaterials ? 3 : 2;
+  int layersD1 = useMetamaterials ? 3 : 0;
 
-        GridCoordinate3D pos (i, j, k);
-        GridCoordinateFP3D posAbs = yeeLayout->getEpsCoordFP (SigmaZ.getTotalPosition (pos));
+  boxes.clear ();
 
-        GridCoordinateFP3D size = yeeLayout->getEpsCoordFP (SigmaZ.getTotalSize ());
+  for (int i = 0; i < RANGE_PARTS - 1; ++i)
+  {
+    if (!isEmptyRange (partStarts[i], partEnds[i]))
+    {
+      boxes.add (partStarts[i], partEnds[i], nameD, nameD1, layersD, layersD1);
+    }
+  }
 
-        /*
-         * FIXME: add layout coordinates for material: sigma, eps, etc.
-         */
-        if (posAbs.getZ () < PMLSize.getZ ())
-        {
-          grid_coord dist = PMLSize.getZ () - posAbs.getZ ();
-          FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
-          FPValue x2 = dist * gridStep;       // lower bounds for point i
+  if (useMetamaterials)
+  {
+    /*
+     * Cells of Drude model in slabs are already covered by slabs, so box of these cells is clipped by box of zero
+     * conductivity
+     */
+    GridCoordinate3D interiorStart = partStarts[RANGE_PARTS - 1];
+    GridCoordinate3D interiorEnd = partEnds[RANGE_PARTS - 1];
 
-          FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
+    splitRange (interiorStart, interiorEnd, boxes.drudeStart, boxes.drudeEnd, partStarts, partEnds);
 
-#ifdef COMPLEX_FIELD_VALUES
-    			valSigma->setCurValue (FieldValue (val, 0));
-#else /* COMPLEX_FIELD_VALUES */
-          valSigma->setCurValue (val);
-#endif /* !COMPLEX_FIELD_VALUES */
-        }
-        else if (posAbs.getZ () >= size.getZ () - PMLSize.getZ ())
-        {
-          grid_coord dist = posAbs.getZ () - (size.getZ () - PMLSize.getZ ());
-          FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
-          FPValue x2 = dist * gridStep;       // lower bounds for point i
+    if (!isEmptyRange (partStarts[RANGE_PARTS - 1], partEnds[RANGE_PARTS - 1]))
+    {
+      boxes.add (partStarts[RANGE_PARTS - 1], partEnds[RANGE_PARTS - 1], nameD, nameD1, layersD, layersD1);
+    }
+  }
+} /* Scheme3D::initPMLBoxes */
 
-          //std::cout << boundaryFactor * (pow(x1, (exponent + 1)) - pow(x2, (exponent + 1))) << std::endl;
-          FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
+/**
+ * Allocate D and D1 (B and B1) of all field components
+ */
+void
+Scheme3D::initAllPMLBoxes ()
+{
+  initPMLBoxes (DxBoxes, "Dx", "D1x", ExProfileX, ExProfileY, ExProfileZ,
+                Ex.getComputationStart (yeeLayout->getExStartDiff ()), Ex.getComputationEnd (yeeLayout->getExEndDiff ()));
+  initPMLBoxes (DyBoxes, "Dy", "D1y", EyProfileX, EyProfileY, EyProfileZ,
+                Ey.getComputationStart (yeeLayout->getEyStartDiff ()), Ey.getComputationEnd (yeeLayout->getEyEndDiff ()));
+  initPMLBoxes (DzBoxes, "Dz", "D1z", EzProfileX, EzProfileY, EzProfileZ,
+                Ez.getComputationStart (yeeLayout->getEzStartDiff ()), Ez.getComputationEnd (yeeLayout->getEzEndDiff ()));
+  initPMLBoxes (BxBoxes, "Bx", "B1x", HxProfileX, HxProfileY, HxProfileZ,
+                Hx.getComputationStart (yeeLayout->getHxStartDiff ()), Hx.getComputationEnd (yeeLayout->getHxEndDiff ()));
+  initPMLBoxes (ByBoxes, "By", "B1y", HyProfileX, HyProfileY, HyProfileZ,
+                Hy.getComputationStart (yeeLayout->getHyStartDiff ()), Hy.getComputationEnd (yeeLayout->getHyEndDiff ()));
+  initPMLBoxes (BzBoxes, "Bz", "B1z", HzProfileX, HzProfileY, HzProfileZ,
+                Hz.getComputationStart (yeeLayout->getHzStartDiff ()), Hz.getComputationEnd (yeeLayout->getHzEndDiff ()));
+
+  DPRINTF ("Positions of D and B in boxes of PML update: Dx %lu of %lu, Bx %lu of %lu.\n",
+           (unsigned long) DxBoxes.getTotalSize (), (unsigned long) Ex.getSize ().calculateTotalCoord (),
+           (unsigned long) BxBoxes.getTotalSize (), (unsigned long) Hx.getSize ().calculateTotalCoord ());
+} /* Scheme3D::initAllPMLBoxes */
+
+/**
+ * Precalculate absolute permittivity or permeability for positions of field grid between start and end of computations
+ */
+void
+Scheme3D::initMaterialTable (MaterialTable<FPValue> &table, /**< out: absolute permittivity or permeability */
+                             FieldGrid &grid, /**< grid of field component */
+                             GridType typeOfField, /**< type of field component (EX, ..., HZ) */
+                             GridCoordinate3D start, /**< start of computations */
+                             GridCoordinate3D end) /**< end of computations */
+{
+  bool isElectric = typeOfField == GridType::EX || typeOfField == GridType::EY || typeOfField == GridType::EZ;
 
-#ifdef COMPLEX_FIELD_VALUES
-    			valSigma->setCurValue (FieldValue (val, 0));
-#else /* COMPLEX_FIELD_VALUES */
-          valSigma->setCurValue (val);
-#endif /* !COMPLEX_FIELD_VALUES */
-        }
+  FPValue vacuum = isElectric ? PhysicsConst::Eps0 : PhysicsConst::Mu0;
+  GridType typeOfMaterial = isElectric ? GridType::EPS : GridType::MU;
 
-        SigmaZ.setFieldPointValue (valSigma, pos);
-      }
-    }
-  }
+  table.init (grid.getSize ());
 
-  if (dumpRes)
+  if (!(start < end))
   {
-    dumper.init (0, CURRENT, processId, "SigmaX");
-    dumper.dumpGrid (SigmaX, GridCoordinate3D (0), Eps.getSize ());
-    dumper.init (0, CURRENT, processId, "SigmaY");
-    dumper.dumpGrid (SigmaY, GridCoordinate3D (0), Eps.getSize ());
-    dumper.init (0, CURRENT, processId, "SigmaZ");
-    dumper.dumpGrid (SigmaZ, GridCoordinate3D (0), Eps.getSize ());
+    return;
   }
 
-  for (int i = 0; i < Ex.getSize ().getX (); ++i)
+  /*
+   * Averaging of materials is performed by threads, while values are added to table in the same order by single
+   * thread, so table does not depend on number of threads
+   */
+  GridCoordinate3D size = end - start;
+  std::vector<FPValue> values (size.calculateTotalCoord ());
+
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
+  for (grid_coord i = start.getX (); i < end.getX (); ++i)
   {
-    for (int j = 0; j < Ex.getSize ().getY (); ++j)
+    for (grid_coord j = start.getY (); j < end.getY (); ++j)
     {
-      for (int k = 0; k < Ex.getSize ().getZ (); ++k)
-      {
-        FieldPointValue* valEx = new FieldPointValue ();
-
-        FieldPointValue* valDx = new FieldPointValue ();
-
-        FieldPointValue* valD1x = new FieldPointValue ();
-
-        FieldPointValue* valExAmp;
-        if (calculateAmplitude)
-        {
-          valExAmp = new FieldPointValue ();
-        }
+      grid_iter index = ((grid_iter) (i - start.getX ()) * size.getY () + j - start.getY ()) * size.getZ ();
 
+      for (grid_coord k = start.getZ (); k < end.getZ (); ++k, ++index)
+      {
         GridCoordinate3D pos (i, j, k);
+        GridCoordinate3D posAbs = grid.getTotalPosition (pos);
 
-        Ex.setFieldPointValue (valEx, pos);
-
-        Dx.setFieldPointValue (valDx, pos);
+        FPValue material = yeeLayout->getMaterial (posAbs, typeOfField, Materials, typeOfMaterial);
 
-        D1x.setFieldPointValue (valD1x, pos);
-
-        if (calculateAmplitude)
-        {
-          ExAmplitude.setFieldPointValue (valExAmp, pos);
-        }
+        values[index] = material * vacuum;
       }
     }
   }
 
-  for (int i = 0; i < Ey.getSize ().getX (); ++i)
+  grid_iter index = 0;
+
+  for (grid_coord i = start.getX (); i < end.getX (); ++i)
   {
-    for (int j = 0; j < Ey.getSize ().getY (); ++j)
+    for (grid_coord j = start.getY (); j < end.getY (); ++j)
     {
-      for (int k = 0; k < Ey.getSize ().getZ (); ++k)
+      for (grid_coord k = start.getZ (); k < end.getZ (); ++k, ++index)
       {
-        FieldPointValue* valEy = new FieldPointValue ();
+        table.set (GridCoordinate3D (i, j, k), values[index]);
+      }
+    }
+  }
+} /* Scheme3D::initMaterialTable */
 
-        FieldPointValue* valDy = new FieldPointValue ();
+/**
+ * Precalculate absolute permittivity and permeability for all field components. Should be called after materials are
+ * set. Averaging of materials is the same for E and D (H and B) components, so tables are used by all updates.
+ */
+void
+Scheme3D::initMaterialTables ()
+{
+  initMaterialTable (ExMaterial, Ex, GridType::EX, Ex.getComputationStart (yeeLayout->getExStartDiff ()),
+                     Ex.getComputationEnd (yeeLayout->getExEndDiff ()));
+  initMaterialTable (EyMaterial, Ey, GridType::EY, Ey.getComputationStart (yeeLayout->getEyStartDiff ()),
+                     Ey.getComputationEnd (yeeLayout->getEyEndDiff ()));
+  initMaterialTable (EzMaterial, Ez, GridType::EZ, Ez.getComputationStart (yeeLayout->getEzStartDiff ()),
+                     Ez.getComputationEnd (yeeLayout->getEzEndDiff ()));
+  initMaterialTable (HxMaterial, Hx, GridType::HX, Hx.getComputationStart (yeeLayout->getHxStartDiff ()),
+                     Hx.getComputationEnd (yeeLayout->getHxEndDiff ()));
+  initMaterialTable (HyMaterial, Hy, GridType::HY, Hy.getComputationStart (yeeLayout->getHyStartDiff ()),
+                     Hy.getComputationEnd (yeeLayout->getHyEndDiff ()));
+  initMaterialTable (HzMaterial, Hz, GridType::HZ, Hz.getComputationStart (yeeLayout->getHzStartDiff ()),
+                     Hz.getComputationEnd (yeeLayout->getHzEndDiff ()));
+
+  initCurlCoefficients (ExCurlCoefficients, ExMaterial);
+  initCurlCoefficients (EyCurlCoefficients, EyMaterial);
+  initCurlCoefficients (EzCurlCoefficients, EzMaterial);
+  initCurlCoefficients (HxCurlCoefficients, HxMaterial);
+  initCurlCoefficients (HyCurlCoefficients, HyMaterial);
+  initCurlCoefficients (HzCurlCoefficients, HzMaterial);
+} /* Scheme3D::initMaterialTables */
+
+/**
+ * Precalculate coefficient of curl in update without PML (see calculateEx_3D) for each distinct value of table of
+ * materials, so that updates only gather coefficients by indices of values
+ */
+void
+Scheme3D::initCurlCoefficients (std::vector<FPValue> &coefficients, /**< out: coefficients of curl */
+                                const MaterialTable<FPValue> &table) /**< absolute permittivity or permeability */
+{
+  coefficients.resize (table.values.size ());
 
-        FieldPointValue* valD1y = new FieldPointValue ();
+  for (std::vector<FPValue>::size_type i = 0; i < table.values.size (); ++i)
+  {
+    coefficients[i] = gridTimeStep / (table.values[i] * gridStep);
+  }
+} /* Scheme3D::initCurlCoefficients */
 
-        FieldPointValue* valEyAmp;
-        if (calculateAmplitude)
-        {
-          valEyAmp = new FieldPointValue ();
-        }
+/**
+ * Precalculate coefficients of Drude model for positions of field grid between start and end of computations and find
+ * box of cells, which are described by Drude model
+ */
+void
+Scheme3D::initDrudeTable (MaterialTable<DrudeCoefficients> &table, /**< out: coefficients of Drude model */
+                          PMLBoxes &boxes, /**< out: D and D1 (B and B1) with box of cells of Drude model */
+                          FieldGrid &grid, /**< grid of field component */
+                          GridType typeOfField, /**< type of D or B component at the same positions as grid */
+                          GridCoordinate3D start, /**< start of computations */
+                          GridCoordinate3D end) /**< end of computations */
+{
+  bool isElectric = typeOfField == GridType::DX || typeOfField == GridType::DY || typeOfField == GridType::DZ;
 
-        GridCoordinate3D pos (i, j, k);
+  FPValue vacuum = isElectric ? PhysicsConst::Eps0 : PhysicsConst::Mu0;
+  FPValue dt = gridTimeStep;
 
-        Ey.setFieldPointValue (valEy, pos);
+  table.init (grid.getSize ());
 
-        Dy.setFieldPointValue (valDy, pos);
+  if (!(start < end))
+  {
+    return;
+  }
 
-        D1y.setFieldPointValue (valD1y, pos);
+  /*
+   * Coefficients are calculated by threads and are added to table by single thread (see initMaterialTable)
+   */
+  GridCoordinate3D size = end - start;
+  std::vector<DrudeCoefficients> values (size.calculateTotalCoord ());
 
-        if (calculateAmplitude)
-        {
-          EyAmplitude.setFieldPointValue (valEyAmp, pos);
-        }
-      }
-    }
-  }
+  /*
+   * Cells with zero plasma frequency are not dispersive, Drude model is equivalent to plain update for them
+   */
+  std::vector<char> isDispersive (size.calculateTotalCoord ());
 
-  for (int i = 0; i < Ez.getSize ().getX (); ++i)
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
+  for (grid_coord i = start.getX (); i < end.getX (); ++i)
   {
-    for (int j = 0; j < Ez.getSize ().getY (); ++j)
+    for (grid_coord j = start.getY (); j < end.getY (); ++j)
     {
-      for (int k = 0; k < Ez.getSize ().getZ (); ++k)
-      {
-        FieldPointValue* valEz = new FieldPointValue ();
+      grid_iter index = ((grid_iter) (i - start.getX ()) * size.getY () + j - start.getY ()) * size.getZ ();
 
-        FieldPointValue* valDz = new FieldPointValue ();
+      for (grid_coord k = start.getZ (); k < end.getZ (); ++k, ++index)
+      {
+        GridCoordinate3D pos (i, j, k);
+        GridCoordinate3D posAbs = grid.getTotalPosition (pos);
 
-        FieldPointValue* valD1z = new FieldPointValue ();
+        FPValue omega;
+        FPValue gamma;
+        FPValue material;
 
-        FieldPointValue* valEzAmp;
-        if (calculateAmplitude)
+        if (isElectric)
         {
-          valEzAmp = new FieldPointValue ();
+          material = yeeLayout->getMetaMaterial (posAbs, typeOfField, Materials, GridType::EPS, GridType::OMEGAPE,
+                                                 GridType::GAMMAE, omega, gamma);
+        }
+        else
+        {
+          material = yeeLayout->getMetaMaterial (posAbs, typeOfField, Materials, GridType::MU, GridType::OMEGAPM,
+                                                 GridType::GAMMAM, omega, gamma);
         }
 
-        GridCoordinate3D pos (i, j, k);
-
-        Ez.setFieldPointValue (valEz, pos);
-
-        Dz.setFieldPointValue (valDz, pos);
+        FPValue A = 4*vacuum*material + 2*dt*vacuum*material*gamma + vacuum*dt*dt*omega*omega;
 
-        D1z.setFieldPointValue (valD1z, pos);
+        DrudeCoefficients coefficients;
+        coefficients.b0 = (4 + 2*dt*gamma) / A;
+        coefficients.b1 = -8 / A;
+        coefficients.b2 = (4 - 2*dt*gamma) / A;
+        coefficients.a1 = (2*vacuum*dt*dt*omega*omega - 8*vacuum*material) / A;
+        coefficients.a2 = (4*vacuum*material - 2*dt*vacuum*material*gamma + vacuum*dt*dt*omega*omega) / A;
 
-        if (calculateAmplitude)
-        {
-          EzAmplitude.setFieldPointValue (valEzAmp, pos);
-        }
+        values[index] = coefficients;
+        isDispersive[index] = omega != 0;
       }
     }
   }
 
-  for (int i = 0; i < Hx.getSize ().getX (); ++i)
+  grid_iter index = 0;
+
+  GridCoordinate3D drudeStart = end;
+  GridCoordinate3D drudeEnd = start;
+
+  for (grid_coord i = start.getX (); i < end.getX (); ++i)
   {
-    for (int j = 0; j < Hx.getSize ().getY (); ++j)
+    for (grid_coord j = start.getY (); j < end.getY (); ++j)
     {
-      for (int k = 0; k < Hx.getSize ().getZ (); ++k)
+      for (grid_coord k = start.getZ (); k < end.getZ (); ++k, ++index)
       {
-        FieldPointValue* valHx = new FieldPointValue ();
-
-        FieldPointValue* valBx = new FieldPointValue ();
-
-        FieldPointValue* valB1x = new FieldPointValue ();
+        table.set (GridCoordinate3D (i, j, k), values[index]);
 
-        FieldPointValue* valHxAmp;
-        if (calculateAmplitude)
+        if (isDispersive[index])
         {
-          valHxAmp = new FieldPointValue ();
+          drudeStart = GridCoordinate3D (std::min ((grid_coord) drudeStart.getX (), i),
+                                         std::min ((grid_coord) drudeStart.getY (), j),
+                                         std::min ((grid_coord) drudeStart.getZ (), k));
+          drudeEnd = GridCoordinate3D (std::max ((grid_coord) drudeEnd.getX (), (grid_coord) (i + 1)),
+                                       std::max ((grid_coord) drudeEnd.getY (), (grid_coord) (j + 1)),
+                                       std::max ((grid_coord) drudeEnd.getZ (), (grid_coord) (k + 1)));
         }
+      }
+    }
+  }
 
-        GridCoordinate3D pos (i, j, k);
+  if (drudeStart < drudeEnd)
+  {
+    boxes.drudeStart = drudeStart;
+    boxes.drudeEnd = drudeEnd;
+  }
+} /* Scheme3D::initDrudeTable */
 
-        Hx.setFieldPointValue (valHx, pos);
+/**
+ * Precalculate coefficients of Drude model for all field components. Should be called after materials are set.
+ */
+void
+Scheme3D::initDrudeTables ()
+{
+  initDrudeTable (ExDrude, DxBoxes, Ex, GridType::DX, Ex.getComputationStart (yeeLayout->getExStartDiff ()),
+                  Ex.getComputationEnd (yeeLayout->getExEndDiff ()));
+  initDrudeTable (EyDrude, DyBoxes, Ey, GridType::DY, Ey.getComputationStart (yeeLayout->getEyStartDiff ()),
+                  Ey.getComputationEnd (yeeLayout->getEyEndDiff ()));
+  initDrudeTable (EzDrude, DzBoxes, Ez, GridType::DZ, Ez.getComputationStart (yeeLayout->getEzStartDiff ()),
+                  Ez.getComputationEnd (yeeLayout->getEzEndDiff ()));
+  initDrudeTable (HxDrude, BxBoxes, Hx, GridType::BX, Hx.getComputationStart (yeeLayout->getHxStartDiff ()),
+                  Hx.getComputationEnd (yeeLayout->getHxEndDiff ()));
+  initDrudeTable (HyDrude, ByBoxes, Hy, GridType::BY, Hy.getComputationStart (yeeLayout->getHyStartDiff ()),
+                  Hy.getComputationEnd (yeeLayout->getHyEndDiff ()));
+  initDrudeTable (HzDrude, BzBoxes, Hz, GridType::BZ, Hz.getComputationStart (yeeLayout->getHzStartDiff ()),
+                  Hz.getComputationEnd (yeeLayout->getHzEndDiff ()));
+
+  DPRINTF ("Distinct sets of coefficients of Drude model: Ex %lu, Ey %lu, Ez %lu, Hx %lu, Hy %lu, Hz %lu.\n",
+           (unsigned long) ExDrude.values.size (), (unsigned long) EyDrude.values.size (),
+           (unsigned long) EzDrude.values.size (), (unsigned long) HxDrude.values.size (),
+           (unsigned long) HyDrude.values.size (), (unsigned long) HzDrude.values.size ());
+} /* Scheme3D::initDrudeTables */
+
+/**
+ * Check whether difference of update of field component at position requires correction on border of TF/SF area
+ *
+ * @return change of difference per unit of incident wave or 0 if correction is not required
+ */
+FPValue
+Scheme3D::initTFSFDifference (FieldGrid &grid, /**< grid of field component */
+                              GridType typeOfField, /**< type of field component (EX, ..., HZ) */
+                              GridCoordinate3D pos, /**< relative position in grid of field component */
+                              FieldGrid &gridOfDifference, /**< grid of field component of difference */
+                              GridType typeOfDifference, /**< type of field component of difference */
+                              LayoutDirection directionLow, /**< direction of circuit element with lower coordinate */
+                              LayoutDirection directionHigh, /**< direction of circuit element with higher coordinate */
+                              IncidentWaveInterpolation &incident) /**< out: interpolation of incident wave */
+{
+  GridCoordinate3D posAbs = grid.getTotalPosition (pos);
 
-        Bx.setFieldPointValue (valBx, pos);
+  bool doNeedUpdateLow = false;
+  bool doNeedUpdateHigh = false;
 
-        B1x.setFieldPointValue (valB1x, pos);
+  GridCoordinate3D posLow;
+  GridCoordinate3D posHigh;
 
-        if (calculateAmplitude)
-        {
-          HxAmplitude.setFieldPointValue (valHxAmp, pos);
-        }
-      }
+  switch (typeOfField)
+  {
+    case GridType::EX:
+    {
+      doNeedUpdateLow = yeeLayout->doNeedTFSFUpdateExBorder (posAbs, directionLow, DO_USE_3D_MODE);
+      doNeedUpdateHigh = yeeLayout->doNeedTFSFUpdateExBorder (posAbs, directionHigh, DO_USE_3D_MODE);
+      posLow = yeeLayout->getExCircuitElement (pos, directionLow);
+      posHigh = yeeLayout->getExCircuitElement (pos, directionHigh);
+      break;
+    }
+    case GridType::EY:
+    {
+      doNeedUpdateLow = yeeLayout->doNeedTFSFUpdateEyBorder (posAbs, directionLow, DO_USE_3D_MODE);
+      doNeedUpdateHigh = yeeLayout->doNeedTFSFUpdateEyBorder (posAbs, directionHigh, DO_USE_3D_MODE);
+      posLow = yeeLayout->getEyCircuitElement (pos, directionLow);
+      posHigh = yeeLayout->getEyCircuitElement (pos, directionHigh);
+      break;
+    }
+    case GridType::EZ:
+    {
+      doNeedUpdateLow = yeeLayout->doNeedTFSFUpdateEzBorder (posAbs, directionLow, DO_USE_3D_MODE);
+      doNeedUpdateHigh = yeeLayout->doNeedTFSFUpdateEzBorder (posAbs, directionHigh, DO_USE_3D_MODE);
+      posLow = yeeLayout->getEzCircuitElement (pos, directionLow);
+      posHigh = yeeLayout->getEzCircuitElement (pos, directionHigh);
+      break;
+    }
+    case GridType::HX:
+    {
+      doNeedUpdateLow = yeeLayout->doNeedTFSFUpdateHxBorder (posAbs, directionLow, DO_USE_3D_MODE);
+      doNeedUpdateHigh = yeeLayout->doNeedTFSFUpdateHxBorder (posAbs, directionHigh, DO_USE_3D_MODE);
+      posLow = yeeLayout->getHxCircuitElement (pos, directionLow);
+      posHigh = yeeLayout->getHxCircuitElement (pos, directionHigh);
+      break;
+    }
+    case GridType::HY:
+    {
+      doNeedUpdateLow = yeeLayout->doNeedTFSFUpdateHyBorder (posAbs, directionLow, DO_USE_3D_MODE);
+      doNeedUpdateHigh = yeeLayout->doNeedTFSFUpdateHyBorder (posAbs, directionHigh, DO_USE_3D_MODE);
+      posLow = yeeLayout->getHyCircuitElement (pos, directionLow);
+      posHigh = yeeLayout->getHyCircuitElement (pos, directionHigh);
+      break;
+    }
+    case GridType::HZ:
+    {
+      doNeedUpdateLow = yeeLayout->doNeedTFSFUpdateHzBorder (posAbs, directionLow, DO_USE_3D_MODE);
+      doNeedUpdateHigh = yeeLayout->doNeedTFSFUpdateHzBorder (posAbs, directionHigh, DO_USE_3D_MODE);
+      posLow = yeeLayout->getHzCircuitElement (pos, directionLow);
+      posHigh = yeeLayout->getHzCircuitElement (pos, directionHigh);
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
     }
   }
 
-  for (int i = 0; i < Hy.getSize ().getX (); ++i)
+  if (!doNeedUpdateLow && !doNeedUpdateHigh)
   {
-    for (int j = 0; j < Hy.getSize ().getY (); ++j)
-    {
-      for (int k = 0; k < Hy.getSize ().getZ (); ++k)
-      {
-        FieldPointValue* valHy = new FieldPointValue ();
-
-        FieldPointValue* valBy = new FieldPointValue ();
+    return 0;
+  }
 
-        FieldPointValue* valB1y = new FieldPointValue ();
+  /*
+   * Incident H for E components is taken at circuit element, which is opposite to border, and incident E for H
+   * components is taken at circuit element on border
+   */
+  bool isElectric = typeOfField == GridType::EX || typeOfField == GridType::EY || typeOfField == GridType::EZ;
 
-        FieldPointValue* valHyAmp;
-        if (calculateAmplitude)
-        {
-          valHyAmp = new FieldPointValue ();
-        }
+  GridCoordinate3D auxPos = doNeedUpdateLow == isElectric ? posHigh : posLow;
+  GridCoordinate3D auxPosAbs = gridOfDifference.getTotalPosition (auxPos);
 
-        GridCoordinate3D pos (i, j, k);
+  GridCoordinateFP3D realCoord;
+  FPValue projection = 0;
 
-        Hy.setFieldPointValue (valHy, pos);
+  switch (typeOfDifference)
+  {
+    case GridType::EX:
+    {
+      realCoord = yeeLayout->getExCoordFP (auxPosAbs);
+      projection = yeeLayout->getExFromIncidentEFactor ();
+      break;
+    }
+    case GridType::EY:
+    {
+      realCoord = yeeLayout->getEyCoordFP (auxPosAbs);
+      projection = yeeLayout->getEyFromIncidentEFactor ();
+      break;
+    }
+    case GridType::EZ:
+    {
+      realCoord = yeeLayout->getEzCoordFP (auxPosAbs);
+      projection = yeeLayout->getEzFromIncidentEFactor ();
+      break;
+    }
+    case GridType::HX:
+    {
+      realCoord = yeeLayout->getHxCoordFP (auxPosAbs);
+      projection = yeeLayout->getHxFromIncidentHFactor ();
+      break;
+    }
+    case GridType::HY:
+    {
+      realCoord = yeeLayout->getHyCoordFP (auxPosAbs);
+      projection = yeeLayout->getHyFromIncidentHFactor ();
+      break;
+    }
+    case GridType::HZ:
+    {
+      realCoord = yeeLayout->getHzCoordFP (auxPosAbs);
+      projection = yeeLayout->getHzFromIncidentHFactor ();
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
 
-        By.setFieldPointValue (valBy, pos);
+  /*
+   * Incident E is shifted from incident H by half of step
+   */
+  incident = initIncidentWaveInterpolation (realCoord, isElectric ? 0.5 : 0.0);
 
-        B1y.setFieldPointValue (valB1y, pos);
+  /*
+   * Correction on border with lower coordinates decreases difference, on border with higher coordinates increases it
+   */
+  return doNeedUpdateLow ? -projection : projection;
+} /* Scheme3D::initTFSFDifference */
 
-        if (calculateAmplitude)
-        {
-          HyAmplitude.setFieldPointValue (valHyAmp, pos);
-        }
-      }
-    }
-  }
+/**
+ * Find cells of field component between start and end of computations, updates of which require correction on border
+ * of TF/SF area
+ */
+void
+Scheme3D::initTFSFBorder (std::vector<TFSFCell> &cells, /**< out: cells on border of TF/SF area */
+                          FieldGrid &grid, /**< grid of field component */
+                          GridType typeOfField, /**< type of field component (EX, ..., HZ) */
+                          GridCoordinate3D start, /**< start of computations */
+                          GridCoordinate3D end) /**< end of computations */
+{
+  cells.clear ();
 
-  for (int i = 0; i < Hz.getSize ().getX (); ++i)
+  for (grid_coord i = start.getX (); i < end.getX (); ++i)
   {
-    for (int j = 0; j < Hz.getSize ().getY (); ++j)
+    for (grid_coord j = start.getY (); j < end.getY (); ++j)
     {
-      for (int k = 0; k < Hz.getSize ().getZ (); ++k)
+      for (grid_coord k = start.getZ (); k < end.getZ (); ++k)
       {
-        FieldPointValue* valHz = new FieldPointValue ();
-
-        FieldPointValue* valBz = new FieldPointValue ();
+        TFSFCell cell;
+        cell.pos = GridCoordinate3D (i, j, k);
 
-        FieldPointValue* valB1z = new FieldPointValue ();
+        GridCoordinate3D pos = cell.pos;
 
-        FieldPointValue* valHzAmp;
-        if (calculateAmplitude)
+        switch (typeOfField)
         {
-          valHzAmp = new FieldPointValue ();
+          case GridType::EX:
+          {
+            cell.factor1 = initTFSFDifference (grid, typeOfField, pos, Hz, GridType::HZ,
+                                               LayoutDirection::DOWN, LayoutDirection::UP, cell.incident1);
+            cell.factor2 = initTFSFDifference (grid, typeOfField, pos, Hy, GridType::HY,
+                                               LayoutDirection::BACK, LayoutDirection::FRONT, cell.incident2);
+            break;
+          }
+          case GridType::EY:
+          {
+            cell.factor1 = initTFSFDifference (grid, typeOfField, pos, Hx, GridType::HX,
+                                               LayoutDirection::BACK, LayoutDirection::FRONT, cell.incident1);
+            cell.factor2 = initTFSFDifference (grid, typeOfField, pos, Hz, GridType::HZ,
+                                               LayoutDirection::LEFT, LayoutDirection::RIGHT, cell.incident2);
+            break;
+          }
+          case GridType::EZ:
+          {
+            cell.factor1 = initTFSFDifference (grid, typeOfField, pos, Hy, GridType::HY,
+                                               LayoutDirection::LEFT, LayoutDirection::RIGHT, cell.incident1);
+            cell.factor2 = initTFSFDifference (grid, typeOfField, pos, Hx, GridType::HX,
+                                               LayoutDirection::DOWN, LayoutDirection::UP, cell.incident2);
+            break;
+          }
+          case GridType::HX:
+          {
+            cell.factor1 = initTFSFDifference (grid, typeOfField, pos, Ey, GridType::EY,
+                                               LayoutDirection::BACK, LayoutDirection::FRONT, cell.incident1);
+            cell.factor2 = initTFSFDifference (grid, typeOfField, pos, Ez, GridType::EZ,
+                                               LayoutDirection::DOWN, LayoutDirection::UP, cell.incident2);
+            break;
+          }
+          case GridType::HY:
+          {
+            cell.factor1 = initTFSFDifference (grid, typeOfField, pos, Ez, GridType::EZ,
+                                               LayoutDirection::LEFT, LayoutDirection::RIGHT, cell.incident1);
+            cell.factor2 = initTFSFDifference (grid, typeOfField, pos, Ex, GridType::EX,
+                                               LayoutDirection::BACK, LayoutDirection::FRONT, cell.incident2);
+            break;
+          }
+          case GridType::HZ:
+          {
+            cell.factor1 = initTFSFDifference (grid, typeOfField, pos, Ex, GridType::EX,
+                                               LayoutDirection::DOWN, LayoutDirection::UP, cell.incident1);
+            cell.factor2 = initTFSFDifference (grid, typeOfField, pos, Ey, GridType::EY,
+                                               LayoutDirection::LEFT, LayoutDirection::RIGHT, cell.incident2);
+            break;
+          }
+          default:
+          {
+            UNREACHABLE;
+          }
         }
 
-        GridCoordinate3D pos (i, j, k);
-
-        Hz.setFieldPointValue (valHz, pos);
-
-        Bz.setFieldPointValue (valBz, pos);
-
-        B1z.setFieldPointValue (valB1z, pos);
-
-        if (calculateAmplitude)
+        if (cell.factor1 != 0 || cell.factor2 != 0)
         {
-          HzAmplitude.setFieldPointValue (valHzAmp, pos);
+          cells.push_back (cell);
         }
       }
     }
   }
+} /* Scheme3D::initTFSFBorder */
 
-  if (useTFSF)
-  {
-    for (grid_coord i = 0; i < EInc.getSize ().getX (); ++i)
-    {
-      FieldPointValue* valE = new FieldPointValue ();
-
-      GridCoordinate1D pos (i);
-
-      EInc.setFieldPointValue (valE, pos);
-    }
-
-    for (grid_coord i = 0; i < HInc.getSize ().getX (); ++i)
-    {
-      FieldPointValue* valH = new FieldPointValue ();
-
-      GridCoordinate1D pos (i);
-
-      HInc.setFieldPointValue (valH, pos);
-    }
-  }
-
-#if defined (PARALLEL_GRID)
-  MPI_Barrier (MPI_COMM_WORLD);
-#endif
-
-#if defined (PARALLEL_GRID)
-  Eps.share ();
-  Mu.share ();
-
-  SigmaX.share ();
-  SigmaY.share ();
-  SigmaZ.share ();
-#endif
-}
+/**
+ * Find cells on border of TF/SF area for all field components
+ */
+void
+Scheme3D::initTFSFBorders ()
+{
+  initTFSFBorder (ExTFSFCells, Ex, GridType::EX, Ex.getComputationStart (yeeLayout->getExStartDiff ()),
+                  Ex.getComputationEnd (yeeLayout->getExEndDiff ()));
+  initTFSFBorder (EyTFSFCells, Ey, GridType::EY, Ey.getComputationStart (yeeLayout->getEyStartDiff ()),
+                  Ey.getComputationEnd (yeeLayout->getEyEndDiff ()));
+  initTFSFBorder (EzTFSFCells, Ez, GridType::EZ, Ez.getComputationStart (yeeLayout->getEzStartDiff ()),
+                  Ez.getComputationEnd (yeeLayout->getEzEndDiff ()));
+  initTFSFBorder (HxTFSFCells, Hx, GridType::HX, Hx.getComputationStart (yeeLayout->getHxStartDiff ()),
+                  Hx.getComputationEnd (yeeLayout->getHxEndDiff ()));
+  initTFSFBorder (HyTFSFCells, Hy, GridType::HY, Hy.getComputationStart (yeeLayout->getHyStartDiff ()),
+                  Hy.getComputationEnd (yeeLayout->getHyEndDiff ()));
+  initTFSFBorder (HzTFSFCells, Hz, GridType::HZ, Hz.getComputationStart (yeeLayout->getHzStartDiff ()),
+                  Hz.getComputationEnd (yeeLayout->getHzEndDiff ()));
+
+  DPRINTF ("Cells on border of TF/SF area: Ex %lu, Ey %lu, Ez %lu, Hx %lu, Hy %lu, Hz %lu.\n",
+           (unsigned long) ExTFSFCells.size (), (unsigned long) EyTFSFCells.size (),
+           (unsigned long) EzTFSFCells.size (), (unsigned long) HxTFSFCells.size (),
+           (unsigned long) HyTFSFCells.size (), (unsigned long) HzTFSFCells.size ());
+} /* Scheme3D::initTFSFBorders */
 
 // void
 // Scheme3D::makeGridScattered (Grid<GridCoordinate3D> &grid)
@@ -4103,6 +5037,9 @@ Scheme3D::ntffN_x (grid_coord x0, FPValue angleTeta, FPValue anglePhi,
   FieldValue sum_teta (0.0, 0.0);
   FieldValue sum_phi (0.0, 0.0);
 
+  GridView<GridCoordinate3D> curTotalHyView = curTotalHy.getView (1);
+  GridView<GridCoordinate3D> curTotalHzView = curTotalHz.getView (1);
+
   for (FPValue coordY = coordStart.getY (); coordY <= coordEnd.getY (); ++coordY)
   {
     for (FPValue coordZ = coordStart.getZ (); coordZ <= coordEnd.getZ (); ++coordZ)
@@ -4123,11 +5060,11 @@ Scheme3D::ntffN_x (grid_coord x0, FPValue angleTeta, FPValue anglePhi,
       pos3 = pos3 - yeeLayout->getMinHyCoordFP ();
       pos4 = pos4 - yeeLayout->getMinHyCoordFP ();
 
-      FieldValue valHz1 = curTotalHz.getFieldPointValue (convertCoord (pos1))->getCurValue ();// - val1;
-      FieldValue valHz2 = curTotalHz.getFieldPointValue (convertCoord (pos2))->getCurValue ();// - val2;
+      FieldValue valHz1 = curTotalHzView[convertCoord (pos1)];// - val1;
+      FieldValue valHz2 = curTotalHzView[convertCoord (pos2)];// - val2;
 
-      FieldValue valHy1 = curTotalHy.getFieldPointValue (convertCoord (pos3))->getCurValue ();// - val3;
-      FieldValue valHy2 = curTotalHy.getFieldPointValue (convertCoord (pos4))->getCurValue ();// - val4;
+      FieldValue valHy1 = curTotalHyView[convertCoord (pos3)];// - val3;
+      FieldValue valHy2 = curTotalHyView[convertCoord (pos4)];// - val4;
 
       FPValue arg = (x0 - diffc) * sin(angleTeta)*cos(anglePhi) + (coordY - diffc) * sin(angleTeta)*sin(anglePhi) + (coordZ - diffc) * cos (angleTeta);
       arg *= gridStep;
@@ -4160,6 +5097,9 @@ Scheme3D::ntffN_y (grid_coord y0, FPValue angleTeta, FPValue anglePhi,
   FieldValue sum_teta (0.0, 0.0);
   FieldValue sum_phi (0.0, 0.0);
 
+  GridView<GridCoordinate3D> curTotalHxView = curTotalHx.getView (1);
+  GridView<GridCoordinate3D> curTotalHzView = curTotalHz.getView (1);
+
   for (FPValue coordX = coordStart.getX (); coordX <= coordEnd.getX (); ++coordX)
   {
     for (FPValue coordZ = coordStart.getZ (); coordZ <= coordEnd.getZ (); ++coordZ)
@@ -4180,11 +5120,11 @@ Scheme3D::ntffN_y (grid_coord y0, FPValue angleTeta, FPValue anglePhi,
       pos3 = pos3 - yeeLayout->getMinHxCoordFP ();
       pos4 = pos4 - yeeLayout->getMinHxCoordFP ();
 
-      FieldValue valHz1 = curTotalHz.getFieldPointValue (convertCoord (pos1))->getCurValue ();// - val1;
-      FieldValue valHz2 = curTotalHz.getFieldPointValue (convertCoord (pos2))->getCurValue ();// - val2;
+      FieldValue valHz1 = curTotalHzView[convertCoord (pos1)];// - val1;
+      FieldValue valHz2 = curTotalHzView[convertCoord (pos2)];// - val2;
 
-      FieldValue valHx1 = curTotalHx.getFieldPointValue (convertCoord (pos3))->getCurValue ();// - val3;
-      FieldValue valHx2 = curTotalHx.getFieldPointValue (convertCoord (pos4))->getCurValue ();// - val4;
+      FieldValue valHx1 = curTotalHxView[convertCoord (pos3)];// - val3;
+      FieldValue valHx2 = curTotalHxView[convertCoord (pos4)];// - val4;
 
       FPValue arg = (coordX - diffc) * sin(angleTeta)*cos(anglePhi) + (y0 - diffc) * sin(angleTeta)*sin(anglePhi) + (coordZ - diffc) * cos (angleTeta);
       arg *= gridStep;
@@ -4217,6 +5157,9 @@ Scheme3D::ntffN_z (grid_coord z0, FPValue angleTeta, FPValue anglePhi,
   FieldValue sum_teta (0.0, 0.0);
   FieldValue sum_phi (0.0, 0.0);
 
+  GridView<GridCoordinate3D> curTotalHxView = curTotalHx.getView (1);
+  GridView<GridCoordinate3D> curTotalHyView = curTotalHy.getView (1);
+
   for (FPValue coordX = coordStart.getX (); coordX <= coordEnd.getX (); ++coordX)
   {
     for (FPValue coordY = coordStart.getY (); coordY <= coordEnd.getY (); ++coordY)
@@ -4237,11 +5180,11 @@ Scheme3D::ntffN_z (grid_coord z0, FPValue angleTeta, FPValue anglePhi,
       pos3 = pos3 - yeeLayout->getMinHxCoordFP ();
       pos4 = pos4 - yeeLayout->getMinHxCoordFP ();
 
-      FieldValue valHy1 = curTotalHy.getFieldPointValue (convertCoord (pos1))->getCurValue ();// - val1;
-      FieldValue valHy2 = curTotalHy.getFieldPointValue (convertCoord (pos2))->getCurValue ();// - val2;
+      FieldValue valHy1 = curTotalHyView[convertCoord (pos1)];// - val1;
+      FieldValue valHy2 = curTotalHyView[convertCoord (pos2)];// - val2;
 
-      FieldValue valHx1 = curTotalHx.getFieldPointValue (convertCoord (pos3))->getCurValue ();// - val3;
-      FieldValue valHx2 = curTotalHx.getFieldPointValue (convertCoord (pos4))->getCurValue ();// - val4;
+      FieldValue valHx1 = curTotalHxView[convertCoord (pos3)];// - val3;
+      FieldValue valHx2 = curTotalHxView[convertCoord (pos4)];// - val4;
 
       FPValue arg = (coordX - diffc) * sin(angleTeta)*cos(anglePhi) + (coordY - diffc) * sin(angleTeta)*sin(anglePhi) + (z0 - diffc) * cos (angleTeta);
       arg *= gridStep;
@@ -4274,6 +5217,9 @@ Scheme3D::ntffL_x (grid_coord x0, FPValue angleTeta, FPValue anglePhi,
   FieldValue sum_teta (0.0, 0.0);
   FieldValue sum_phi (0.0, 0.0);
 
+  GridView<GridCoordinate3D> curTotalEyView = curTotalEy.getView (1);
+  GridView<GridCoordinate3D> curTotalEzView = curTotalEz.getView (1);
+
   for (FPValue coordY = coordStart.getY (); coordY <= coordEnd.getY (); ++coordY)
   {
     for (FPValue coordZ = coordStart.getZ (); coordZ <= coordEnd.getZ (); ++coordZ)
@@ -4294,15 +5240,15 @@ Scheme3D::ntffL_x (grid_coord x0, FPValue angleTeta, FPValue anglePhi,
       pos3 = pos3 - yeeLayout->getMinEzCoordFP ();
       pos4 = pos4 - yeeLayout->getMinEzCoordFP ();
 
-      FieldValue valEy1 = (curTotalEy.getFieldPointValue (convertCoord (pos1-GridCoordinateFP3D(0.5,0,0)))->getCurValue ()
-                           + curTotalEy.getFieldPointValue (convertCoord (pos1+GridCoordinateFP3D(0.5,0,0)))->getCurValue ()) / 2.0;// - val1;
-      FieldValue valEy2 = (curTotalEy.getFieldPointValue (convertCoord (pos2-GridCoordinateFP3D(0.5,0,0)))->getCurValue ()
-                           + curTotalEy.getFieldPointValue (convertCoord (pos2+GridCoordinateFP3D(0.5,0,0)))->getCurValue ()) / 2.0;// - val2;
+      FieldValue valEy1 = (curTotalEyView[convertCoord (pos1-GridCoordinateFP3D(0.5,0,0))]
+                           + curTotalEyView[convertCoord (pos1+GridCoordinateFP3D(0.5,0,0))]) / 2.0;// - val1;
+      FieldValue valEy2 = (curTotalEyView[convertCoord (pos2-GridCoordinateFP3D(0.5,0,0))]
+                           + curTotalEyView[convertCoord (pos2+GridCoordinateFP3D(0.5,0,0))]) / 2.0;// - val2;
 
-      FieldValue valEz1 = (curTotalEz.getFieldPointValue (convertCoord (pos3-GridCoordinateFP3D(0.5,0,0)))->getCurValue ()
-                           + curTotalEz.getFieldPointValue (convertCoord (pos3+GridCoordinateFP3D(0.5,0,0)))->getCurValue ()) / 2.0;// - val3;
-      FieldValue valEz2 = (curTotalEz.getFieldPointValue (convertCoord (pos4-GridCoordinateFP3D(0.5,0,0)))->getCurValue ()
-                           + curTotalEz.getFieldPointValue (convertCoord (pos4+GridCoordinateFP3D(0.5,0,0)))->getCurValue ()) / 2.0;// - val4;
+      FieldValue valEz1 = (curTotalEzView[convertCoord (pos3-GridCoordinateFP3D(0.5,0,0))]
+                           + curTotalEzView[convertCoord (pos3+GridCoordinateFP3D(0.5,0,0))]) / 2.0;// - val3;
+      FieldValue valEz2 = (curTotalEzView[convertCoord (pos4-GridCoordinateFP3D(0.5,0,0))]
+                           + curTotalEzView[convertCoord (pos4+GridCoordinateFP3D(0.5,0,0))]) / 2.0;// - val4;
 
       FPValue arg = (x0 - diffc) * sin(angleTeta)*cos(anglePhi) + (coordY - diffc) * sin(angleTeta)*sin(anglePhi) + (coordZ - diffc) * cos (angleTeta);
       arg *= gridStep;
@@ -4334,6 +5280,9 @@ Scheme3D::ntffL_y (grid_coord y0, FPValue angleTeta, FPValue anglePhi,
   FieldValue sum_teta (0.0, 0.0);
   FieldValue sum_phi (0.0, 0.0);
 
+  GridView<GridCoordinate3D> curTotalExView = curTotalEx.getView (1);
+  GridView<GridCoordinate3D> curTotalEzView = curTotalEz.getView (1);
+
   for (FPValue coordX = coordStart.getX (); coordX <= coordEnd.getX (); ++coordX)
   {
     for (FPValue coordZ = coordStart.getZ (); coordZ <= coordEnd.getZ (); ++coordZ)
@@ -4354,15 +5303,15 @@ Scheme3D::ntffL_y (grid_coord y0, FPValue angleTeta, FPValue anglePhi,
       pos3 = pos3 - yeeLayout->getMinEzCoordFP ();
       pos4 = pos4 - yeeLayout->getMinEzCoordFP ();
 
-      FieldValue valEx1 = (curTotalEx.getFieldPointValue (convertCoord (pos1-GridCoordinateFP3D(0,0.5,0)))->getCurValue ()
-                           + curTotalEx.getFieldPointValue (convertCoord (pos1+GridCoordinateFP3D(0,0.5,0)))->getCurValue ()) / 2.0;// - val1;
-      FieldValue valEx2 = (curTotalEx.getFieldPointValue (convertCoord (pos2-GridCoordinateFP3D(0,0.5,0)))->getCurValue ()
-                           + curTotalEx.getFieldPointValue (convertCoord (pos2+GridCoordinateFP3D(0,0.5,0)))->getCurValue ()) / 2.0;// - val2;
+      FieldValue valEx1 = (curTotalExView[convertCoord (pos1-GridCoordinateFP3D(0,0.5,0))]
+                           + curTotalExView[convertCoord (pos1+GridCoordinateFP3D(0,0.5,0))]) / 2.0;// - val1;
+      FieldValue valEx2 = (curTotalExView[convertCoord (pos2-GridCoordinateFP3D(0,0.5,0))]
+                           + curTotalExView[convertCoord (pos2+GridCoordinateFP3D(0,0.5,0))]) / 2.0;// - val2;
 
-      FieldValue valEz1 = (curTotalEz.getFieldPointValue (convertCoord (pos3-GridCoordinateFP3D(0,0.5,0)))->getCurValue ()
-                           + curTotalEz.getFieldPointValue (convertCoord (pos3+GridCoordinateFP3D(0,0.5,0)))->getCurValue ()) / 2.0;// - val3;
-      FieldValue valEz2 = (curTotalEz.getFieldPointValue (convertCoord (pos4-GridCoordinateFP3D(0,0.5,0)))->getCurValue ()
-                           + curTotalEz.getFieldPointValue (convertCoord (pos4+GridCoordinateFP3D(0,0.5,0)))->getCurValue ()) / 2.0;// - val4;
+      FieldValue valEz1 = (curTotalEzView[convertCoord (pos3-GridCoordinateFP3D(0,0.5,0))]
+                           + curTotalEzView[convertCoord (pos3+GridCoordinateFP3D(0,0.5,0))]) / 2.0;// - val3;
+      FieldValue valEz2 = (curTotalEzView[convertCoord (pos4-GridCoordinateFP3D(0,0.5,0))]
+                           + curTotalEzView[convertCoord (pos4+GridCoordinateFP3D(0,0.5,0))]) / 2.0;// - val4;
 
       FPValue arg = (coordX - diffc) * sin(angleTeta)*cos(anglePhi) + (y0 - diffc) * sin(angleTeta)*sin(anglePhi) + (coordZ - diffc) * cos (angleTeta);
       arg *= gridStep;
@@ -4395,6 +5344,9 @@ Scheme3D::ntffL_z (grid_coord z0, FPValue angleTeta, FPValue anglePhi,
   FieldValue sum_teta (0.0, 0.0);
   FieldValue sum_phi (0.0, 0.0);
 
+  GridView<GridCoordinate3D> curTotalExView = curTotalEx.getView (1);
+  GridView<GridCoordinate3D> curTotalEyView = curTotalEy.getView (1);
+
   for (FPValue coordX = coordStart.getX (); coordX <= coordEnd.getX (); ++coordX)
   {
     for (FPValue coordY = coordStart.getY (); coordY <= coordEnd.getY (); ++coordY)
@@ -4415,15 +5367,15 @@ Scheme3D::ntffL_z (grid_coord z0, FPValue angleTeta, FPValue anglePhi,
       pos3 = pos3 - yeeLayout->getMinEyCoordFP ();
       pos4 = pos4 - yeeLayout->getMinEyCoordFP ();
 
-      FieldValue valEx1 = (curTotalEx.getFieldPointValue (convertCoord (pos1-GridCoordinateFP3D(0,0,0.5)))->getCurValue ()
-                           + curTotalEx.getFieldPointValue (convertCoord (pos1+GridCoordinateFP3D(0,0,0.5)))->getCurValue ()) / 2.0;// - val1;
-      FieldValue valEx2 = (curTotalEx.getFieldPointValue (convertCoord (pos2-GridCoordinateFP3D(0,0,0.5)))->getCurValue ()
-                           + curTotalEx.getFieldPointValue (convertCoord (pos2+GridCoordinateFP3D(0,0,0.5)))->getCurValue ()) / 2.0;// - val2;
+      FieldValue valEx1 = (curTotalExView[convertCoord (pos1-GridCoordinateFP3D(0,0,0.5))]
+                           + curTotalExView[convertCoord (pos1+GridCoordinateFP3D(0,0,0.5))]) / 2.0;// - val1;
+      FieldValue valEx2 = (curTotalExView[convertCoord (pos2-GridCoordinateFP3D(0,0,0.5))]
+                           + curTotalExView[convertCoord (pos2+GridCoordinateFP3D(0,0,0.5))]) / 2.0;// - val2;
 
-      FieldValue valEy1 = (curTotalEy.getFieldPointValue (convertCoord (pos3-GridCoordinateFP3D(0,0,0.5)))->getCurValue ()
-                           + curTotalEy.getFieldPointValue (convertCoord (pos3+GridCoordinateFP3D(0,0,0.5)))->getCurValue ()) / 2.0;// - val3;
-      FieldValue valEy2 = (curTotalEy.getFieldPointValue (convertCoord (pos4-GridCoordinateFP3D(0,0,0.5)))->getCurValue ()
-                           + curTotalEy.getFieldPointValue (convertCoord (pos4+GridCoordinateFP3D(0,0,0.5)))->getCurValue ()) / 2.0;// - val4;
+      FieldValue valEy1 = (curTotalEyView[convertCoord (pos3-GridCoordinateFP3D(0,0,0.5))]
+                           + curTotalEyView[convertCoord (pos3+GridCoordinateFP3D(0,0,0.5))]) / 2.0;// - val3;
+      FieldValue valEy2 = (curTotalEyView[convertCoord (pos4-GridCoordinateFP3D(0,0,0.5))]
+                           + curTotalEyView[convertCoord (pos4+GridCoordinateFP3D(0,0,0.5))]) / 2.0;// - val4;
 
       FPValue arg = (coordX - diffc) * sin(angleTeta)*cos(anglePhi) + (coordY - diffc) * sin(angleTeta)*sin(anglePhi) + (z0 - diffc) * cos (angleTeta);
       arg *= gridStep;
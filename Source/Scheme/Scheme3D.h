@@ -1,10 +1,14 @@
 #ifndef SCHEME_3D_H
 #define SCHEME_3D_H
 
+#include <map>
+#include <vector>
+
 #include "GridInterface.h"
 #include "PhysicsConst.h"
 #include "Scheme.h"
 #include "ParallelYeeGridLayout.h"
+#include "TaskGraph.h"
 
 #ifdef GRID_3D
 
@@ -14,6 +18,450 @@ typedef ParallelGrid FieldGrid;
 typedef Grid<GridCoordinate3D> FieldGrid;
 #endif
 
+/**
+ * Coefficients of PML update, which depend only on conductivity sigma along single axis (k is 1). Coefficients are
+ * precalculated once for each relative coordinate of field grid along this axis (see Scheme3D::initPMLProfile).
+ */
+struct PMLProfile
+{
+  /**
+   * (2 * eps0 * k - sigma * dt) / (2 * eps0 * k + sigma * dt)
+   */
+  std::vector<FPValue> Ca;
+
+  /**
+   * (2 * eps0 * dt / dx) / (2 * eps0 * k + sigma * dt)
+   */
+  std::vector<FPValue> Cb;
+
+  /**
+   * 2 * eps0 * k + sigma * dt
+   */
+  std::vector<FPValue> sum;
+
+  /**
+   * 2 * eps0 * k - sigma * dt
+   */
+  std::vector<FPValue> diff;
+
+  /**
+   * 1 / (2 * eps0 * k + sigma * dt)
+   */
+  std::vector<FPValue> inverseSum;
+
+  /**
+   * exp (-sigma * dt / eps0), coefficient of recursive convolution of CPML (k is 1, alpha is 0), sigma of CPML is
+   * graded separately from conductivity of PML (see Scheme3D::getCPMLConductivity)
+   */
+  std::vector<FPValue> b;
+
+  /**
+   * b - 1, coefficient of derivative in recursive convolution of CPML
+   */
+  std::vector<FPValue> c;
+
+  /**
+   * Start of range of coordinates, in which conductivity is zero
+   */
+  grid_coord interiorStart;
+
+  /**
+   * End of range of coordinates, in which conductivity is zero
+   */
+  grid_coord interiorEnd;
+
+  /**
+   * Check whether coordinate is in range of zero conductivity
+   *
+   * @return true if conductivity is zero
+   */
+  bool isInterior (grid_coord coord) const /**< relative coordinate along axis */
+  {
+    return coord >= interiorStart && coord < interiorEnd;
+  } /* isInterior */
+};
+
+/**
+ * Auxiliary values (psi) of convolutional PML for derivative of field component along single axis. Values are stored
+ * only in layers of PML, i.e. for coordinates along this axis outside of range of zero conductivity (see PMLProfile),
+ * and for all coordinates along two other axes. Values are scaled by dx, i.e. are in units of difference of field.
+ */
+struct CPMLPsi
+{
+  /**
+   * Values of both layers, layer with lower coordinates is stored first
+   */
+  std::vector<FieldValue> values;
+
+  /**
+   * Axis of derivative (SIGMAX, SIGMAY or SIGMAZ)
+   */
+  GridType typeOfSigma;
+
+  /**
+   * Size of stored values. Size along axis of derivative is total thickness of both layers
+   */
+  GridCoordinate3D size;
+
+  /**
+   * Range of coordinates along axis of derivative, for which values are not stored
+   */
+  grid_coord interiorStart;
+  grid_coord interiorEnd;
+
+  CPMLPsi ()
+    : typeOfSigma (GridType::SIGMAX)
+    , interiorStart (0)
+    , interiorEnd (0)
+  {
+  } /* CPMLPsi */
+
+  /**
+   * Get auxiliary value at relative position in field grid
+   *
+   * @return pointer to value or NULLPTR if position is outside of PML along axis of derivative
+   */
+  FieldValue *getValue (const GridCoordinate3D &pos) /**< relative position in field grid */
+  {
+    grid_coord x = pos.getX ();
+    grid_coord y = pos.getY ();
+    grid_coord z = pos.getZ ();
+
+    grid_coord &coord = typeOfSigma == GridType::SIGMAX ? x : (typeOfSigma == GridType::SIGMAY ? y : z);
+
+    if (coord >= interiorStart && coord < interiorEnd)
+    {
+      return NULLPTR;
+    }
+
+    if (coord >= interiorEnd)
+    {
+      coord -= interiorEnd - interiorStart;
+    }
+
+    return &values[((grid_iter) x * size.getY () + y) * size.getZ () + z];
+  } /* getValue */
+};
+
+/**
+ * D (B) and D1 (B1) of field component in box, where field component is updated by PML update. Values are addressed
+ * by position relative to origin of box.
+ */
+struct PMLBox
+{
+  /**
+   * Start and end of box, relative positions in field grid
+   */
+  GridCoordinate3D start;
+  GridCoordinate3D end;
+
+  /**
+   * Relative position in field grid of zero position of D (B). It is start of box, which is aligned to blocks in block
+   * layout, so that D and field component are split to blocks at the same positions and their rows inside blocks match
+   */
+  GridCoordinate3D origin;
+
+  Grid<GridCoordinate3D> *D;
+
+  /**
+   * D1 (B1) has time layers only for metamaterials
+   */
+  Grid<GridCoordinate3D> *D1;
+};
+
+/**
+ * D (B) and D1 (B1) of field component. Field component is updated by PML update only in six slabs of PML around box
+ * of zero conductivity (see Scheme3D::performSplitSteps) and, for metamaterials, in box of cells inside of it, which
+ * are described by Drude model, so D and D1 are stored only in these boxes (see Scheme3D::initPMLBoxes).
+ */
+class PMLBoxes
+{
+  std::vector<PMLBox> boxes;
+
+private:
+
+  PMLBoxes (const PMLBoxes &);
+  PMLBoxes &operator= (const PMLBoxes &);
+
+public:
+
+  /**
+   * Box of cells, which are described by Drude model, i.e. which have non-zero plasma frequency (see
+   * Scheme3D::initDrudeTable). Box is empty if there are no such cells.
+   */
+  GridCoordinate3D drudeStart;
+  GridCoordinate3D drudeEnd;
+
+  PMLBoxes ()
+    : drudeStart (0, 0, 0)
+    , drudeEnd (0, 0, 0)
+  {
+  } /* PMLBoxes */
+
+  ~PMLBoxes ()
+  {
+    clear ();
+  } /* ~PMLBoxes */
+
+  /**
+   * Allocate D and D1 in box
+   */
+  void add (const GridCoordinate3D &start, /**< start of box */
+            const GridCoordinate3D &end, /**< end of box */
+            const char *nameD, /**< name of D (B) */
+            const char *nameD1, /**< name of D1 (B1) */
+            int layersD, /**< number of time layers of D */
+            int layersD1) /**< number of time layers of D1 */
+  {
+    PMLBox box;
+    box.start = start;
+    box.end = end;
+#ifdef BLOCK_GRID_LAYOUT
+    box.origin = GridCoordinate3D (start.getX () & ~((grid_iter) GRID_BLOCK_MASK),
+                                   start.getY () & ~((grid_iter) GRID_BLOCK_MASK),
+                                   start.getZ () & ~((grid_iter) GRID_BLOCK_MASK));
+#else /* BLOCK_GRID_LAYOUT */
+    box.origin = start;
+#endif /* !BLOCK_GRID_LAYOUT */
+    box.D = new Grid<GridCoordinate3D> (end - box.origin, 0, nameD, layersD);
+    box.D1 = new Grid<GridCoordinate3D> (end - box.origin, 0, nameD1, layersD1);
+
+    boxes.push_back (box);
+  } /* add */
+
+  void clear ()
+  {
+    for (std::vector<PMLBox>::iterator it = boxes.begin (); it != boxes.end (); ++it)
+    {
+      delete it->D;
+      delete it->D1;
+    }
+
+    boxes.clear ();
+  } /* clear */
+
+  /**
+   * Find box, which contains range
+   *
+   * @return box or NULLPTR if range is not contained in any box
+   */
+  const PMLBox *find (const GridCoordinate3D &start, /**< start of range */
+                      const GridCoordinate3D &end) const /**< end of range */
+  {
+    for (std::vector<PMLBox>::const_iterator it = boxes.begin (); it != boxes.end (); ++it)
+    {
+      if (start >= it->start && end <= it->end)
+      {
+        return &*it;
+      }
+    }
+
+    return NULLPTR;
+  } /* find */
+
+  /**
+   * Switch D and D1 of all boxes to next time step
+   */
+  void nextTimeStep ()
+  {
+    for (std::vector<PMLBox>::iterator it = boxes.begin (); it != boxes.end (); ++it)
+    {
+      it->D->nextTimeStep ();
+      it->D1->nextTimeStep ();
+    }
+  } /* nextTimeStep */
+
+  grid_iter getTotalSize () const
+  {
+    grid_iter total = 0;
+
+    for (std::vector<PMLBox>::const_iterator it = boxes.begin (); it != boxes.end (); ++it)
+    {
+      total += (it->end - it->start).calculateTotalCoord ();
+    }
+
+    return total;
+  } /* getTotalSize */
+};
+
+/**
+ * Coefficients of Drude model update (b0, b1, b2, a1, a2 of calculateDrudeE or d0, d1, d2, c1, c2 of calculateDrudeH)
+ */
+struct DrudeCoefficients
+{
+  FPValue b0;
+  FPValue b1;
+  FPValue b2;
+  FPValue a1;
+  FPValue a2;
+
+  bool operator< (const DrudeCoefficients &rhs) const
+  {
+    if (b0 != rhs.b0)
+    {
+      return b0 < rhs.b0;
+    }
+    if (b1 != rhs.b1)
+    {
+      return b1 < rhs.b1;
+    }
+    if (b2 != rhs.b2)
+    {
+      return b2 < rhs.b2;
+    }
+    if (a1 != rhs.a1)
+    {
+      return a1 < rhs.a1;
+    }
+    return a2 < rhs.a2;
+  } /* operator< */
+};
+
+/**
+ * Precalculated values, which depend on materials, for positions of field grid. Materials are static, so only few
+ * distinct values exist. Each distinct value is stored once, for each position only index of value is stored, which
+ * has the same type as identifier of material in grid of materials (see MaterialGrid).
+ */
+template <class TValue>
+struct MaterialTable
+{
+  /**
+   * Distinct values
+   */
+  std::vector<TValue> values;
+
+  /**
+   * Index of value for each position of field grid
+   */
+  std::vector<material_id> indices;
+
+  /**
+   * Size of field grid
+   */
+  GridCoordinate3D size;
+
+  /**
+   * Index of each distinct value, is used only during initialization
+   */
+  std::map<TValue, material_id> indexOfValue;
+
+  /**
+   * Allocate table for field grid
+   */
+  void init (const GridCoordinate3D &s) /**< size of field grid */
+  {
+    size = s;
+    values.clear ();
+    indices.assign (size.calculateTotalCoord (), 0);
+    indexOfValue.clear ();
+  } /* init */
+
+  /**
+   * Set value at relative position in field grid
+   */
+  void set (const GridCoordinate3D &pos, /**< relative position in field grid */
+            const TValue &value) /**< value */
+  {
+    typename std::map<TValue, material_id>::iterator it = indexOfValue.find (value);
+
+    if (it == indexOfValue.end ())
+    {
+      if (values.size () >= MATERIAL_COUNT_MAX)
+      {
+        printf ("Number of distinct values of table of materials exceeds %d.\n", MATERIAL_COUNT_MAX);
+        exit (EXIT_ERROR);
+      }
+
+      it = indexOfValue.insert (std::make_pair (value, (material_id) values.size ())).first;
+      values.push_back (value);
+    }
+
+    indices[calculateIndex (pos)] = it->second;
+  } /* set */
+
+  /**
+   * Get value at relative position in field grid
+   *
+   * @return value
+   */
+  const TValue &get (const GridCoordinate3D &pos) const /**< relative position in field grid */
+  {
+    return values[indices[calculateIndex (pos)]];
+  } /* get */
+
+  grid_iter calculateIndex (const GridCoordinate3D &pos) const /**< relative position in field grid */
+  {
+    return ((grid_iter) pos.getX () * size.getY () + pos.getY ()) * size.getZ () + pos.getZ ();
+  } /* calculateIndex */
+
+  /**
+   * Gather coefficients, which are precalculated for each distinct value, for positions of row along Oz axis
+   */
+  template <class TCoefficient>
+  void gather (const std::vector<TCoefficient> &coefficients, /**< coefficient of each distinct value */
+               const GridCoordinate3D &pos, /**< relative position of the first value of row */
+               grid_iter count, /**< number of positions */
+               TCoefficient *result) const /**< out: coefficients of positions */
+  {
+    ASSERT (coefficients.size () == values.size ());
+
+    const material_id *rowIndices = &indices[calculateIndex (pos)];
+
+    for (grid_iter k = 0; k < count; ++k)
+    {
+      result[k] = coefficients[rowIndices[k]];
+    }
+  } /* gather */
+};
+
+/**
+ * Linear interpolation of one-dimensional incident wave (EInc or HInc) at real coordinate, which is projected on
+ * direction of propagation of incident wave
+ */
+struct IncidentWaveInterpolation
+{
+  /**
+   * Position of the first of two neighbouring values of incident wave, the second one is at the next position
+   */
+  grid_coord index;
+
+  /**
+   * Weights of the first and the second values
+   */
+  FPValue weight1;
+  FPValue weight2;
+
+  FieldValue approximate (const GridView<GridCoordinate1D> &incident) const /**< view of incident wave */
+  {
+    return weight1 * incident.get (index) + weight2 * incident.get (index + 1);
+  } /* approximate */
+};
+
+/**
+ * Cell of field component, update of which is corrected on the border of total field / scattered field area (TF/SF).
+ * Correction is required for at least one of two differences of update (e.g. Hz along Oy and Hy along Oz for Ex).
+ */
+struct TFSFCell
+{
+  /**
+   * Relative position of field component
+   */
+  GridCoordinate3D pos;
+
+  /**
+   * Interpolation of incident wave for correction of the first and the second differences
+   */
+  IncidentWaveInterpolation incident1;
+  IncidentWaveInterpolation incident2;
+
+  /**
+   * Change of the first and the second differences per unit of incident wave, i.e. projection of incident wave on
+   * field component of difference with sign of correction, 0 if difference does not require correction
+   */
+  FPValue factor1;
+  FPValue factor2;
+};
+
 class Scheme3D: public Scheme
 {
   YeeGridLayout *yeeLayout;
@@ -25,19 +473,15 @@ class Scheme3D: public Scheme
   FieldGrid Hy;
   FieldGrid Hz;
 
-  FieldGrid Dx;
-  FieldGrid Dy;
-  FieldGrid Dz;
-  FieldGrid Bx;
-  FieldGrid By;
-  FieldGrid Bz;
-
-  FieldGrid D1x;
-  FieldGrid D1y;
-  FieldGrid D1z;
-  FieldGrid B1x;
-  FieldGrid B1y;
-  FieldGrid B1z;
+  /*
+   * D (B) and D1 (B1) of field components, e.g. DxBoxes stores Dx and D1x
+   */
+  PMLBoxes DxBoxes;
+  PMLBoxes DyBoxes;
+  PMLBoxes DzBoxes;
+  PMLBoxes BxBoxes;
+  PMLBoxes ByBoxes;
+  PMLBoxes BzBoxes;
 
   FieldGrid ExAmplitude;
   FieldGrid EyAmplitude;
@@ -46,18 +490,90 @@ class Scheme3D: public Scheme
   FieldGrid HyAmplitude;
   FieldGrid HzAmplitude;
 
-  FieldGrid Eps;
-  FieldGrid Mu;
-
-  FieldGrid SigmaX;
-  FieldGrid SigmaY;
-  FieldGrid SigmaZ;
-
-  FieldGrid OmegaPE;
-  FieldGrid GammaE;
+  /**
+   * Materials: Eps, Mu, SigmaX, SigmaY, SigmaZ, OmegaPE, GammaE, OmegaPM, GammaM
+   */
+  MaterialGrid<GridCoordinate3D, FieldGrid> Materials;
 
-  FieldGrid OmegaPM;
-  FieldGrid GammaM;
+  /**
+   * Precalculated coefficients of PML for each field component along Ox, Oy and Oz axes
+   */
+  PMLProfile ExProfileX;
+  PMLProfile ExProfileY;
+  PMLProfile ExProfileZ;
+  PMLProfile EyProfileX;
+  PMLProfile EyProfileY;
+  PMLProfile EyProfileZ;
+  PMLProfile EzProfileX;
+  PMLProfile EzProfileY;
+  PMLProfile EzProfileZ;
+  PMLProfile HxProfileX;
+  PMLProfile HxProfileY;
+  PMLProfile HxProfileZ;
+  PMLProfile HyProfileX;
+  PMLProfile HyProfileY;
+  PMLProfile HyProfileZ;
+  PMLProfile HzProfileX;
+  PMLProfile HzProfileY;
+  PMLProfile HzProfileZ;
+
+  /**
+   * Auxiliary values of CPML for both derivatives of each field component
+   */
+  CPMLPsi ExPsiY;
+  CPMLPsi ExPsiZ;
+  CPMLPsi EyPsiZ;
+  CPMLPsi EyPsiX;
+  CPMLPsi EzPsiX;
+  CPMLPsi EzPsiY;
+  CPMLPsi HxPsiZ;
+  CPMLPsi HxPsiY;
+  CPMLPsi HyPsiX;
+  CPMLPsi HyPsiZ;
+  CPMLPsi HzPsiY;
+  CPMLPsi HzPsiX;
+
+  /**
+   * Cells on border of TF/SF area for each field component
+   */
+  std::vector<TFSFCell> ExTFSFCells;
+  std::vector<TFSFCell> EyTFSFCells;
+  std::vector<TFSFCell> EzTFSFCells;
+  std::vector<TFSFCell> HxTFSFCells;
+  std::vector<TFSFCell> HyTFSFCells;
+  std::vector<TFSFCell> HzTFSFCells;
+
+  /**
+   * Absolute permittivity (eps * eps0) at positions of E components and absolute permeability (mu * mu0) at
+   * positions of H components
+   */
+  MaterialTable<FPValue> ExMaterial;
+  MaterialTable<FPValue> EyMaterial;
+  MaterialTable<FPValue> EzMaterial;
+  MaterialTable<FPValue> HxMaterial;
+  MaterialTable<FPValue> HyMaterial;
+  MaterialTable<FPValue> HzMaterial;
+
+  /**
+   * Coefficients of curl in update without PML (gridTimeStep / (material * gridStep)) for each distinct value of
+   * tables of materials above
+   */
+  std::vector<FPValue> ExCurlCoefficients;
+  std::vector<FPValue> EyCurlCoefficients;
+  std::vector<FPValue> EzCurlCoefficients;
+  std::vector<FPValue> HxCurlCoefficients;
+  std::vector<FPValue> HyCurlCoefficients;
+  std::vector<FPValue> HzCurlCoefficients;
+
+  /**
+   * Coefficients of Drude model for metamaterials
+   */
+  MaterialTable<DrudeCoefficients> ExDrude;
+  MaterialTable<DrudeCoefficients> EyDrude;
+  MaterialTable<DrudeCoefficients> EzDrude;
+  MaterialTable<DrudeCoefficients> HxDrude;
+  MaterialTable<DrudeCoefficients> HyDrude;
+  MaterialTable<DrudeCoefficients> HzDrude;
 
   // Wave parameters
   FPValue sourceWaveLength;
@@ -85,11 +601,21 @@ class Scheme3D: public Scheme
 
   bool usePML;
 
+  bool useCPML;
+
   bool useTFSF;
 
   Grid<GridCoordinate1D> EInc;
   Grid<GridCoordinate1D> HInc;
 
+  /**
+   * Sines and cosines of incidence angles, which are used to project real coordinates on direction of incident wave
+   */
+  FPValue incidentWaveSin1;
+  FPValue incidentWaveCos1;
+  FPValue incidentWaveSin2;
+  FPValue incidentWaveCos2;
+
   bool useMetamaterials;
 
   bool dumpRes;
@@ -99,6 +625,94 @@ class Scheme3D: public Scheme
   GridCoordinate3D leftNTFF;
   GridCoordinate3D rightNTFF;
 
+  /**
+   * Time step is performed by graph of tasks, which update tiles of field components (see Scheme3D::initTaskGraph)
+   */
+  bool useTaskGraph;
+
+  /**
+   * Initial size of tiles by Ox axis
+   */
+  grid_coord tileSize;
+
+  /**
+   * Part of time step, which is performed by task of graph
+   */
+  enum StepTaskType
+  {
+    STEP_TASK_EX,
+    STEP_TASK_EY,
+    STEP_TASK_EZ,
+    STEP_TASK_HX,
+    STEP_TASK_HY,
+    STEP_TASK_HZ,
+    STEP_TASK_PLANE_WAVE_E,
+    STEP_TASK_PLANE_WAVE_H,
+    STEP_TASK_POINT_SOURCE,
+    STEP_TASK_NEXT_EX,
+    STEP_TASK_NEXT_EY,
+    STEP_TASK_NEXT_EZ,
+    STEP_TASK_NEXT_HX,
+    STEP_TASK_NEXT_HY,
+    STEP_TASK_NEXT_HZ
+  };
+
+  /**
+   * Task of graph, which performs part of time step in range of relative positions (see Scheme3D::performStepTask)
+   */
+  class StepTask: public TaskGraphTask
+  {
+    Scheme3D *scheme;
+
+    StepTaskType type;
+
+    /**
+     * Current time step, which is changed by owner of graph between runs
+     */
+    const time_step *step;
+
+    GridCoordinate3D start;
+    GridCoordinate3D end;
+
+  public:
+
+    StepTask (Scheme3D *s, StepTaskType taskType, const time_step *t, GridCoordinate3D taskStart,
+              GridCoordinate3D taskEnd)
+      : scheme (s)
+    , type (taskType)
+    , step (t)
+    , start (taskStart)
+    , end (taskEnd)
+    {
+    }
+
+    virtual void run () CXX11_OVERRIDE
+    {
+      scheme->performStepTask (type, *step, start, end);
+    }
+  };
+
+  /**
+   * Tiles of field component, which are updated by separate tasks of graph
+   */
+  struct StepTiles
+  {
+    /**
+     * Borders of tiles by Ox axis, i-th tile covers coordinates from borders[i] to borders[i + 1]
+     */
+    std::vector<grid_coord> borders;
+
+    /**
+     * Indexes of tasks of tiles in graph
+     */
+    std::vector<int> tasks;
+  };
+
+  /**
+   * Tiles of Ex, Ey, Ez, Hx, Hy and Hz, which are indexed by STEP_TASK_EX, ..., STEP_TASK_HZ
+   */
+  StepTiles stepTiles[STEP_TASK_HZ + 1];
+
 private:
 
   void calculateExStep (time_step, GridCoordinate3D, GridCoordinate3D);
@@ -115,22 +729,50 @@ private:
   void calculateHyStepPML (time_step, GridCoordinate3D, GridCoordinate3D);
   void calculateHzStepPML (time_step, GridCoordinate3D, GridCoordinate3D);
 
+  void calculateExStepCPML (time_step, GridCoordinate3D, GridCoordinate3D);
+  void calculateEyStepCPML (time_step, GridCoordinate3D, GridCoordinate3D);
+  void calculateEzStepCPML (time_step, GridCoordinate3D, GridCoordinate3D);
+  void calculateHxStepCPML (time_step, GridCoordinate3D, GridCoordinate3D);
+  void calculateHyStepCPML (time_step, GridCoordinate3D, GridCoordinate3D);
+  void calculateHzStepCPML (time_step, GridCoordinate3D, GridCoordinate3D);
+
+  void calculateStepRows (FieldGrid &, FieldGrid &, GridCoordinate3D, GridCoordinate3D, FieldGrid &, GridCoordinate3D,
+                          GridCoordinate3D, const MaterialTable<FPValue> &, const std::vector<FPValue> &,
+                          GridCoordinate3D, GridCoordinate3D);
+  void calculateStepPMLRows (GridType, FieldGrid &, const PMLBoxes &, FieldGrid &, GridCoordinate3D, GridCoordinate3D,
+                             FieldGrid &, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D);
+
+  IncidentWaveInterpolation initIncidentWaveInterpolation (GridCoordinateFP3D, FPValue);
   FieldValue approximateIncidentWave (GridCoordinateFP3D, FPValue, Grid<GridCoordinate1D> &);
   FieldValue approximateIncidentWaveE (GridCoordinateFP3D);
   FieldValue approximateIncidentWaveH (GridCoordinateFP3D);
 
-  void calculateExTFSF (GridCoordinate3D, FieldValue &, FieldValue &, FieldValue &, FieldValue &,
-                        GridCoordinate3D, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D);
-  void calculateEyTFSF (GridCoordinate3D, FieldValue &, FieldValue &, FieldValue &, FieldValue &,
-                        GridCoordinate3D, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D);
-  void calculateEzTFSF (GridCoordinate3D, FieldValue &, FieldValue &, FieldValue &, FieldValue &,
-                        GridCoordinate3D, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D);
-  void calculateHxTFSF (GridCoordinate3D, FieldValue &, FieldValue &, FieldValue &, FieldValue &,
-                        GridCoordinate3D, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D);
-  void calculateHyTFSF (GridCoordinate3D, FieldValue &, FieldValue &, FieldValue &, FieldValue &,
-                        GridCoordinate3D, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D);
-  void calculateHzTFSF (GridCoordinate3D, FieldValue &, FieldValue &, FieldValue &, FieldValue &,
-                        GridCoordinate3D, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D);
+  /*
+   * Correct values of field component at cells on border of TF/SF area, which are already updated without TF/SF.
+   * Updates are linear in differences of field, so changes of differences by incident wave are added to values
+   * (and to D, B and psi) with the same coefficients as in updates.
+   */
+  void calculateExTFSF (GridCoordinate3D, GridCoordinate3D);
+  void calculateEyTFSF (GridCoordinate3D, GridCoordinate3D);
+  void calculateEzTFSF (GridCoordinate3D, GridCoordinate3D);
+  void calculateHxTFSF (GridCoordinate3D, GridCoordinate3D);
+  void calculateHyTFSF (GridCoordinate3D, GridCoordinate3D);
+  void calculateHzTFSF (GridCoordinate3D, GridCoordinate3D);
+
+  /**
+   * Update of field component in range of relative positions
+   */
+  typedef void (Scheme3D::*StepFunction) (time_step, GridCoordinate3D, GridCoordinate3D);
+
+  void performSplitSteps (time_step, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D,
+                          StepFunction, StepFunction);
+
+  void performExDrudeSteps (time_step, GridCoordinate3D, GridCoordinate3D);
+  void performEyDrudeSteps (time_step, GridCoordinate3D, GridCoordinate3D);
+  void performEzDrudeSteps (time_step, GridCoordinate3D, GridCoordinate3D);
+  void performHxDrudeSteps (time_step, GridCoordinate3D, GridCoordinate3D);
+  void performHyDrudeSteps (time_step, GridCoordinate3D, GridCoordinate3D);
+  void performHzDrudeSteps (time_step, GridCoordinate3D, GridCoordinate3D);
 
   void performExSteps (time_step, GridCoordinate3D, GridCoordinate3D);
   void performEySteps (time_step, GridCoordinate3D, GridCoordinate3D);
@@ -140,13 +782,40 @@ private:
   void performHzSteps (time_step, GridCoordinate3D, GridCoordinate3D);
 
   void performNSteps (time_step, time_step);
+  void performPointSourceStep (time_step);
+
+  void performStepTask (StepTaskType, time_step, GridCoordinate3D, GridCoordinate3D);
+  const std::vector<int> &addStepTasks (TaskGraph &, StepTaskType, const time_step *, GridCoordinate3D,
+                                        GridCoordinate3D);
+  void balanceStepTiles (StepTiles &, const TaskGraph &);
+  void initTaskGraph (TaskGraph &, const time_step *);
   void performAmplitudeSteps (time_step);
 
-  int updateAmplitude (FPValue, FieldPointValue *, FPValue *);
+  int updateAmplitude (FPValue, FieldValuePointer, FPValue *);
 
   void performPlaneWaveESteps (time_step);
   void performPlaneWaveHSteps (time_step);
 
+  FPValue getCPMLConductivity (GridCoordinate3D, GridType, GridType);
+  FPValue calculateSigmaPML (FPValue, FPValue, grid_coord, FPValue, uint32_t) const;
+  void initPMLProfile (PMLProfile &, FieldGrid &, GridType, GridType, GridCoordinate3D, GridCoordinate3D);
+  void initPMLProfiles ();
+  void initCPMLPsi (CPMLPsi &, FieldGrid &, const PMLProfile &, GridType);
+  void initCPMLPsis ();
+  void initMaterialTable (MaterialTable<FPValue> &, FieldGrid &, GridType, GridCoordinate3D, GridCoordinate3D);
+  void initMaterialTables ();
+  void initCurlCoefficients (std::vector<FPValue> &, const MaterialTable<FPValue> &);
+  void initDrudeTable (MaterialTable<DrudeCoefficients> &, PMLBoxes &, FieldGrid &, GridType, GridCoordinate3D,
+                       GridCoordinate3D);
+  void initDrudeTables ();
+  void initPMLBoxes (PMLBoxes &, const char *, const char *, const PMLProfile &, const PMLProfile &,
+                     const PMLProfile &, GridCoordinate3D, GridCoordinate3D);
+  void initAllPMLBoxes ();
+  FPValue initTFSFDifference (FieldGrid &, GridType, GridCoordinate3D, FieldGrid &, GridType, LayoutDirection,
+                              LayoutDirection, IncidentWaveInterpolation &);
+  void initTFSFBorder (std::vector<TFSFCell> &, FieldGrid &, GridType, GridCoordinate3D, GridCoordinate3D);
+  void initTFSFBorders ();
+
   //void makeGridScattered (Grid<GridCoordinate3D> &);
 
 public:
@@ -168,41 +837,24 @@ public:
             bool doUseTFSF = false,
             bool doUseMetamaterials = false,
             bool doUseNTFF = false,
-            bool doDumpRes = false) :
+            bool doDumpRes = false,
+            bool doUseCPML = false,
+            bool doUseTaskGraph = false,
+            grid_coord tileSz = 8) :
     yeeLayout (layout),
-    Ex (layout->getExSize (), bufSize, 0, layout->getExSizeForCurNode (), layout->getExCoreSizePerNode (), "Ex"),
-    Ey (layout->getEySize (), bufSize, 0, layout->getEySizeForCurNode (), layout->getEyCoreSizePerNode (), "Ey"),
-    Ez (layout->getEzSize (), bufSize, 0, layout->getEzSizeForCurNode (), layout->getEzCoreSizePerNode (), "Ez"),
-    Hx (layout->getHxSize (), bufSize, 0, layout->getHxSizeForCurNode (), layout->getHxCoreSizePerNode (), "Hx"),
-    Hy (layout->getHySize (), bufSize, 0, layout->getHySizeForCurNode (), layout->getHyCoreSizePerNode (), "Hy"),
-    Hz (layout->getHzSize (), bufSize, 0, layout->getHzSizeForCurNode (), layout->getHzCoreSizePerNode (), "Hz"),
-    Dx (layout->getExSize (), bufSize, 0, layout->getExSizeForCurNode (), layout->getExCoreSizePerNode (), "Dx"),
-    Dy (layout->getEySize (), bufSize, 0, layout->getEySizeForCurNode (), layout->getEyCoreSizePerNode (), "Dy"),
-    Dz (layout->getEzSize (), bufSize, 0, layout->getEzSizeForCurNode (), layout->getEzCoreSizePerNode (), "Dz"),
-    Bx (layout->getHxSize (), bufSize, 0, layout->getHxSizeForCurNode (), layout->getHxCoreSizePerNode (), "Bx"),
-    By (layout->getHySize (), bufSize, 0, layout->getHySizeForCurNode (), layout->getHyCoreSizePerNode (), "By"),
-    Bz (layout->getHzSize (), bufSize, 0, layout->getHzSizeForCurNode (), layout->getHzCoreSizePerNode (), "Bz"),
-    D1x (layout->getExSize (), bufSize, 0, layout->getExSizeForCurNode (), layout->getExCoreSizePerNode (), "D1x"),
-    D1y (layout->getEySize (), bufSize, 0, layout->getEySizeForCurNode (), layout->getEyCoreSizePerNode (), "D1y"),
-    D1z (layout->getEzSize (), bufSize, 0, layout->getEzSizeForCurNode (), layout->getEzCoreSizePerNode (), "D1z"),
-    B1x (layout->getHxSize (), bufSize, 0, layout->getHxSizeForCurNode (), layout->getHxCoreSizePerNode (), "B1x"),
-    B1y (layout->getHySize (), bufSize, 0, layout->getHySizeForCurNode (), layout->getHyCoreSizePerNode (), "B1y"),
-    B1z (layout->getHzSize (), bufSize, 0, layout->getHzSizeForCurNode (), layout->getHzCoreSizePerNode (), "B1z"),
-    ExAmplitude (layout->getExSize (), bufSize, 0, layout->getExSizeForCurNode (), layout->getExCoreSizePerNode (), "ExAmp"),
-    EyAmplitude (layout->getEySize (), bufSize, 0, layout->getEySizeForCurNode (), layout->getEyCoreSizePerNode (), "EyAmp"),
-    EzAmplitude (layout->getEzSize (), bufSize, 0, layout->getEzSizeForCurNode (), layout->getEzCoreSizePerNode (), "EzAmp"),
-    HxAmplitude (layout->getHxSize (), bufSize, 0, layout->getHxSizeForCurNode (), layout->getHxCoreSizePerNode (), "HxAmp"),
-    HyAmplitude (layout->getHySize (), bufSize, 0, layout->getHySizeForCurNode (), layout->getHyCoreSizePerNode (), "HyAmp"),
-    HzAmplitude (layout->getHzSize (), bufSize, 0, layout->getHzSizeForCurNode (), layout->getHzCoreSizePerNode (), "HzAmp"),
-    Eps (layout->getEpsSize (), bufSize + GridCoordinate3D (1, 1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "Eps"),
-    Mu (layout->getEpsSize (), bufSize + GridCoordinate3D (1, 1, 1), 0, layout->getMuSizeForCurNode (), layout->getMuCoreSizePerNode (), "Mu"),
-    OmegaPE (layout->getEpsSize (), bufSize + GridCoordinate3D (1, 1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "OmegaPE"),
-    GammaE (layout->getEpsSize (), bufSize + GridCoordinate3D (1, 1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "GammaE"),
-    OmegaPM (layout->getEpsSize (), bufSize + GridCoordinate3D (1, 1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "OmegaPM"),
-    GammaM (layout->getEpsSize (), bufSize + GridCoordinate3D (1, 1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "GammaM"),
-    SigmaX (layout->getEpsSize (), bufSize + GridCoordinate3D (1, 1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "SigmaX"),
-    SigmaY (layout->getEpsSize (), bufSize + GridCoordinate3D (1, 1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "SigmaY"),
-    SigmaZ (layout->getEpsSize (), bufSize + GridCoordinate3D (1, 1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "SigmaZ"),
+    Ex (layout->getExSize (), bufSize, 0, layout->getExSizeForCurNode (), layout->getExCoreSizePerNode (), "Ex", 2),
+    Ey (layout->getEySize (), bufSize, 0, layout->getEySizeForCurNode (), layout->getEyCoreSizePerNode (), "Ey", 2),
+    Ez (layout->getEzSize (), bufSize, 0, layout->getEzSizeForCurNode (), layout->getEzCoreSizePerNode (), "Ez", 2),
+    Hx (layout->getHxSize (), bufSize, 0, layout->getHxSizeForCurNode (), layout->getHxCoreSizePerNode (), "Hx", 2),
+    Hy (layout->getHySize (), bufSize, 0, layout->getHySizeForCurNode (), layout->getHyCoreSizePerNode (), "Hy", 2),
+    Hz (layout->getHzSize (), bufSize, 0, layout->getHzSizeForCurNode (), layout->getHzCoreSizePerNode (), "Hz", 2),
+    ExAmplitude (layout->getExSize (), bufSize, 0, layout->getExSizeForCurNode (), layout->getExCoreSizePerNode (), "ExAmp", calcAmp ? 1 : 0),
+    EyAmplitude (layout->getEySize (), bufSize, 0, layout->getEySizeForCurNode (), layout->getEyCoreSizePerNode (), "EyAmp", calcAmp ? 1 : 0),
+    EzAmplitude (layout->getEzSize (), bufSize, 0, layout->getEzSizeForCurNode (), layout->getEzCoreSizePerNode (), "EzAmp", calcAmp ? 1 : 0),
+    HxAmplitude (layout->getHxSize (), bufSize, 0, layout->getHxSizeForCurNode (), layout->getHxCoreSizePerNode (), "HxAmp", calcAmp ? 1 : 0),
+    HyAmplitude (layout->getHySize (), bufSize, 0, layout->getHySizeForCurNode (), layout->getHyCoreSizePerNode (), "HyAmp", calcAmp ? 1 : 0),
+    HzAmplitude (layout->getHzSize (), bufSize, 0, layout->getHzSizeForCurNode (), layout->getHzCoreSizePerNode (), "HzAmp", calcAmp ? 1 : 0),
+    Materials (layout->getEpsSize (), bufSize + GridCoordinate3D (1, 1, 1), layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "Materials"),
     sourceWaveLength (0),
     sourceFrequency (0),
     courantNum (0),
@@ -212,14 +864,17 @@ public:
     calculateAmplitude (calcAmp),
     amplitudeStepLimit (ampStep),
     usePML (doUsePML),
+    useCPML (doUseCPML),
     useTFSF (doUseTFSF),
-    EInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY () + totSize.getZ ())), 0, "EInc"),
-    HInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY () + totSize.getZ ())), 0, "HInc"),
+    EInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY () + totSize.getZ ())), 0, "EInc", 2),
+    HInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY () + totSize.getZ ())), 0, "HInc", 2),
     useMetamaterials (doUseMetamaterials),
     dumpRes (doDumpRes),
     useNTFF (doUseNTFF),
     leftNTFF (GridCoordinate3D (13, 13, 13)),
-    rightNTFF (layout->getEzSize () - leftNTFF + GridCoordinate3D (1,1,1))
+    rightNTFF (layout->getEzSize () - leftNTFF + GridCoordinate3D (1,1,1)),
+    useTaskGraph (doUseTaskGraph),
+    tileSize (tileSz)
 #else
   Scheme3D (YeeGridLayout *layout,
             const GridCoordinate3D& totSize,
@@ -230,41 +885,24 @@ public:
             bool doUseTFSF = false,
             bool doUseMetamaterials = false,
             bool doUseNTFF = false,
-            bool doDumpRes = false) :
+            bool doDumpRes = false,
+            bool doUseCPML = false,
+            bool doUseTaskGraph = false,
+            grid_coord tileSz = 8) :
     yeeLayout (layout),
-    Ex (layout->getExSize (), 0, "Ex"),
-    Ey (layout->getEySize (), 0, "Ey"),
-    Ez (layout->getEzSize (), 0, "Ez"),
-    Hx (layout->getHxSize (), 0, "Hx"),
-    Hy (layout->getHySize (), 0, "Hy"),
-    Hz (layout->getHzSize (), 0, "Hz"),
-    Dx (layout->getExSize (), 0, "Dx"),
-    Dy (layout->getEySize (), 0, "Dy"),
-    Dz (layout->getEzSize (), 0, "Dz"),
-    Bx (layout->getHxSize (), 0, "Bx"),
-    By (layout->getHySize (), 0, "By"),
-    Bz (layout->getHzSize (), 0, "Bz"),
-    D1x (layout->getExSize (), 0, "D1x"),
-    D1y (layout->getEySize (), 0, "D1y"),
-    D1z (layout->getEzSize (), 0, "D1z"),
-    B1x (layout->getHxSize (), 0, "B1x"),
-    B1y (layout->getHySize (), 0, "B1y"),
-    B1z (layout->getHzSize (), 0, "B1z"),
-    ExAmplitude (layout->getExSize (), 0, "ExAmp"),
-    EyAmplitude (layout->getEySize (), 0, "EyAmp"),
-    EzAmplitude (layout->getEzSize (), 0, "EzAmp"),
-    HxAmplitude (layout->getHxSize (), 0, "HxAmp"),
-    HyAmplitude (layout->getHySize (), 0, "HyAmp"),
-    HzAmplitude (layout->getHzSize (), 0, "HzAmp"),
-    Eps (layout->getEpsSize (), 0, "Eps"),
-    Mu (layout->getEpsSize (), 0, "Mu"),
-    OmegaPE (layout->getEpsSize (), 0, "OmegaPE"),
-    GammaE (layout->getEpsSize (), 0, "GammaE"),
-    OmegaPM (layout->getEpsSize (), 0, "OmegaPM"),
-    GammaM (layout->getEpsSize (), 0, "GammaM"),
-    SigmaX (layout->getEpsSize (), 0, "SigmaX"),
-    SigmaY (layout->getEpsSize (), 0, "SigmaY"),
-    SigmaZ (layout->getEpsSize (), 0, "SigmaZ"),
+    Ex (layout->getExSize (), 0, "Ex", 2),
+    Ey (layout->getEySize (), 0, "Ey", 2),
+    Ez (layout->getEzSize (), 0, "Ez", 2),
+    Hx (layout->getHxSize (), 0, "Hx", 2),
+    Hy (layout->getHySize (), 0, "Hy", 2),
+    Hz (layout->getHzSize (), 0, "Hz", 2),
+    ExAmplitude (layout->getExSize (), 0, "ExAmp", calcAmp ? 1 : 0),
+    EyAmplitude (layout->getEySize (), 0, "EyAmp", calcAmp ? 1 : 0),
+    EzAmplitude (layout->getEzSize (), 0, "EzAmp", calcAmp ? 1 : 0),
+    HxAmplitude (layout->getHxSize (), 0, "HxAmp", calcAmp ? 1 : 0),
+    HyAmplitude (layout->getHySize (), 0, "HyAmp", calcAmp ? 1 : 0),
+    HzAmplitude (layout->getHzSize (), 0, "HzAmp", calcAmp ? 1 : 0),
+    Materials (layout->getEpsSize (), "Materials"),
     sourceWaveLength (0),
     sourceFrequency (0),
     courantNum (0),
@@ -274,14 +912,17 @@ public:
     calculateAmplitude (calcAmp),
     amplitudeStepLimit (ampStep),
     usePML (doUsePML),
+    useCPML (doUseCPML),
     useTFSF (doUseTFSF),
-    EInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY () + totSize.getZ ())), 0, "EInc"),
-    HInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY () + totSize.getZ ())), 0, "HInc"),
+    EInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY () + totSize.getZ ())), 0, "EInc", 2),
+    HInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY () + totSize.getZ ())), 0, "HInc", 2),
     useMetamaterials (doUseMetamaterials),
     dumpRes (doDumpRes),
     useNTFF (doUseNTFF),
     leftNTFF (GridCoordinate3D (13, 13, 13)),
-    rightNTFF (layout->getEzSize () - leftNTFF + GridCoordinate3D (1,1,1))
+    rightNTFF (layout->getEzSize () - leftNTFF + GridCoordinate3D (1,1,1)),
+    useTaskGraph (doUseTaskGraph),
+    tileSize (tileSz)
 #endif
   {
     ASSERT (!doUseTFSF
@@ -289,6 +930,22 @@ public:
 
     ASSERT (!doUsePML || (doUsePML && (yeeLayout->getSizePML () != GridCoordinate3D (0, 0, 0))));
 
+    ASSERT (!doUseCPML || doUsePML);
+
+    ASSERT (tileSize > 0);
+
+#ifdef PARALLEL_GRID
+    /*
+     * Shifts of time layers of parallel grid share buffers between processes, which is done by master thread only
+     */
+    ASSERT (!useTaskGraph);
+#endif /* PARALLEL_GRID */
+
+    incidentWaveSin1 = sin (yeeLayout->getIncidentWaveAngle1 ());
+    incidentWaveCos1 = cos (yeeLayout->getIncidentWaveAngle1 ());
+    incidentWaveSin2 = sin (yeeLayout->getIncidentWaveAngle2 ());
+    incidentWaveCos2 = cos (yeeLayout->getIncidentWaveAngle2 ());
+
     ASSERT (!calculateAmplitude || calculateAmplitude && amplitudeStepLimit != 0);
 
 #ifdef COMPLEX_FIELD_VALUES
@@ -24,14 +24,9 @@ SchemeTEz::performPlaneWaveESteps (time_step t)
   {
     GridCoordinate1D pos (i);
 
-    FieldPointValue *valE = EInc.getFieldPointValue (pos);
-
     GridCoordinate1D posLeft (i - 1);
     GridCoordinate1D posRight (i);
 
-    FieldPointValue *valH1 = HInc.getFieldPointValue (posLeft);
-    FieldPointValue *valH2 = HInc.getFieldPointValue (posRight);
-
     FPValue S = 1 / courantNum;
     FPValue stepWaveLength = PhysicsConst::SpeedOfLight / (sourceFrequency * gridStep);
     FPValue arg = PhysicsConst::Pi * S / stepWaveLength;
@@ -48,9 +43,9 @@ SchemeTEz::performPlaneWaveESteps (time_step t)
       relPhi = 1;
     }
 
-    FieldValue val = valE->getPrevValue () + (gridTimeStep / (relPhi * PhysicsConst::Eps0 * gridStep)) * (valH1->getPrevValue () - valH2->getPrevValue ());
+    FieldValue val = *EInc.getFieldValue (pos, 1) + (gridTimeStep / (relPhi * PhysicsConst::Eps0 * gridStep)) * (*HInc.getFieldValue (posLeft, 1) - *HInc.getFieldValue (posRight, 1));
 
-    valE->setCurValue (val);
+    EInc.setFieldValue (val, pos, 0);
   }
 
   EInc.nextTimeStep ();
@@ -63,14 +58,9 @@ SchemeTEz::performPlaneWaveHSteps (time_step t)
   {
     GridCoordinate1D pos (i);
 
-    FieldPointValue *valH = HInc.getFieldPointValue (pos);
-
     GridCoordinate1D posLeft (i);
     GridCoordinate1D posRight (i + 1);
 
-    FieldPointValue *valE1 = EInc.getFieldPointValue (posLeft);
-    FieldPointValue *valE2 = EInc.getFieldPointValue (posRight);
-
     FPValue S = 1 / courantNum;
     FPValue stepWaveLength = PhysicsConst::SpeedOfLight / (sourceFrequency * gridStep);
     FPValue arg = PhysicsConst::Pi * S / stepWaveLength;
@@ -87,19 +77,18 @@ SchemeTEz::performPlaneWaveHSteps (time_step t)
       relPhi = 1;
     }
 
-    FieldValue val = valH->getPrevValue () + (gridTimeStep / (relPhi * PhysicsConst::Mu0 * gridStep)) * (valE1->getPrevValue () - valE2->getPrevValue ());
+    FieldValue val = *HInc.getFieldValue (pos, 1) + (gridTimeStep / (relPhi * PhysicsConst::Mu0 * gridStep)) * (*EInc.getFieldValue (posLeft, 1) - *EInc.getFieldValue (posRight, 1));
 
-    valH->setCurValue (val);
+    HInc.setFieldValue (val, pos, 0);
   }
 
   GridCoordinate1D pos (0);
-  FieldPointValue *valH = HInc.getFieldPointValue (pos);
 
 #ifdef COMPLEX_FIELD_VALUES
-  valH->setCurValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
-                                 cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)));
+  HInc.setFieldValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
+                                  cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)), pos, 0);
 #else /* COMPLEX_FIELD_VALUES */
-  valH->setCurValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency));
+  HInc.setFieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency), pos, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
   HInc.nextTimeStep ();
@@ -126,6 +115,9 @@ SchemeTEz::calculateExStep (time_step t, GridCoordinate3D ExStart, GridCoordinat
 {
   FPValue eps0 = PhysicsConst::Eps0;
 
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (int i = ExStart.getX (); i < ExEnd.getX (); ++i)
   {
     for (int j = ExStart.getY (); j < ExEnd.getY (); ++j)
@@ -134,25 +126,20 @@ SchemeTEz::calculateExStep (time_step t, GridCoordinate3D ExStart, GridCoordinat
       GridCoordinate2D posAbs = Ex.getTotalPosition (pos);
       GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getExCoordFP (posAbs));
 
-      FieldPointValue* valEx = Ex.getFieldPointValue (pos);
-
       GridCoordinate2D posDown = shrinkCoord (yeeLayout->getExCircuitElement (GridCoordinate3D (pos), LayoutDirection::DOWN));
       GridCoordinate2D posUp = shrinkCoord (yeeLayout->getExCircuitElement (GridCoordinate3D (pos), LayoutDirection::UP));
 
-      FieldPointValue* valEps1 = Eps.getFieldPointValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valEps2 = Eps.getFieldPointValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valEps1 = Eps.getFieldValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valEps2 = Eps.getFieldValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue eps = (valEps1->getCurValue ().real () + valEps2->getCurValue ().real ()) / 2;
+      FPValue eps = (valEps1->real () + valEps2->real ()) / 2;
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue eps = (valEps1->getCurValue () + valEps2->getCurValue ()) / 2;
+      FPValue eps = (*valEps1 + *valEps2) / 2;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      FieldPointValue* valHz1 = Hz.getFieldPointValue (posUp);
-      FieldPointValue* valHz2 = Hz.getFieldPointValue (posDown);
-
-      FieldValue prevHz1 = valHz1->getPrevValue ();
-      FieldValue prevHz2 = valHz2->getPrevValue ();
+      FieldValue prevHz1 = *Hz.getFieldValue (posUp, 1);
+      FieldValue prevHz2 = *Hz.getFieldValue (posDown, 1);
 
       if (useTFSF)
       {
@@ -187,10 +174,7 @@ SchemeTEz::calculateExStep (time_step t, GridCoordinate3D ExStart, GridCoordinat
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valH1 = HInc.getFieldPointValue (pos1);
-          FieldPointValue *valH2 = HInc.getFieldPointValue (pos2);
-
-          diff = proportionD1 * valH1->getPrevValue () + proportionD2 * valH2->getPrevValue ();
+          diff = proportionD1 * *HInc.getFieldValue (pos1, 1) + proportionD2 * *HInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_down)
@@ -203,14 +187,14 @@ SchemeTEz::calculateExStep (time_step t, GridCoordinate3D ExStart, GridCoordinat
         }
       }
 
-      FieldValue val = calculateEx_2D_TEz (valEx->getPrevValue (),
+      FieldValue val = calculateEx_2D_TEz (*Ex.getFieldValue (pos, 1),
                                            prevHz1,
                                            prevHz2,
                                            gridTimeStep,
                                            gridStep,
                                            eps * eps0);
 
-      valEx->setCurValue (val);
+      Ex.setFieldValue (val, pos, 0);
     }
   }
 }
@@ -220,6 +204,12 @@ SchemeTEz::calculateExStepPML (time_step t, GridCoordinate3D ExStart, GridCoordi
 {
   FPValue eps0 = PhysicsConst::Eps0;
 
+  /*
+   * Dx and Ex of each cell are updated in a single pass, so values of cell are reused while they are in registers
+   */
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (int i = ExStart.getX (); i < ExEnd.getX (); ++i)
   {
     for (int j = ExStart.getY (); j < ExEnd.getY (); ++j)
@@ -228,25 +218,20 @@ SchemeTEz::calculateExStepPML (time_step t, GridCoordinate3D ExStart, GridCoordi
       GridCoordinate2D posAbs = Ex.getTotalPosition (pos);
       GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getExCoordFP (posAbs));
 
-      FieldPointValue* valDx = Dx.getFieldPointValue (pos);
-
       GridCoordinate2D posDown = shrinkCoord (yeeLayout->getExCircuitElement (GridCoordinate3D (pos), LayoutDirection::DOWN));
       GridCoordinate2D posUp = shrinkCoord (yeeLayout->getExCircuitElement (GridCoordinate3D (pos), LayoutDirection::UP));
 
-      FieldPointValue* valSigmaY1 = SigmaY.getFieldPointValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaY2 = SigmaY.getFieldPointValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valSigmaY1 = SigmaY.getFieldValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaY2 = SigmaY.getFieldValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue sigmaY = (valSigmaY1->getCurValue ().real () + valSigmaY2->getCurValue ().real ()) / 2;
+      FPValue sigmaY = (valSigmaY1->real () + valSigmaY2->real ()) / 2;
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue sigmaY = (valSigmaY1->getCurValue () + valSigmaY2->getCurValue ()) / 2;
+      FPValue sigmaY = (*valSigmaY1 + *valSigmaY2) / 2;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      FieldPointValue* valHz1 = Hz.getFieldPointValue (posUp);
-      FieldPointValue* valHz2 = Hz.getFieldPointValue (posDown);
-
-      FieldValue prevHz1 = valHz1->getPrevValue ();
-      FieldValue prevHz2 = valHz2->getPrevValue ();
+      FieldValue prevHz1 = *Hz.getFieldValue (posUp, 1);
+      FieldValue prevHz2 = *Hz.getFieldValue (posDown, 1);
 
       if (useTFSF)
       {
@@ -281,10 +266,7 @@ SchemeTEz::calculateExStepPML (time_step t, GridCoordinate3D ExStart, GridCoordi
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valH1 = HInc.getFieldPointValue (pos1);
-          FieldPointValue *valH2 = HInc.getFieldPointValue (pos2);
-
-          diff = proportionD1 * valH1->getPrevValue () + proportionD2 * valH2->getPrevValue ();
+          diff = proportionD1 * *HInc.getFieldValue (pos1, 1) + proportionD2 * *HInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_down)
@@ -302,49 +284,38 @@ SchemeTEz::calculateExStepPML (time_step t, GridCoordinate3D ExStart, GridCoordi
        */
       FPValue k_y = 1;
 
-      FPValue Ca = (2 * eps0 * k_y - sigmaY * gridTimeStep) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
-      FPValue Cb = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
+      FPValue CaDx = (2 * eps0 * k_y - sigmaY * gridTimeStep) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
+      FPValue CbDx = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
 
-      FieldValue val = calculateEx_2D_TEz_Precalc (valDx->getPrevValue (),
-                                                   prevHz1,
-                                                   prevHz2,
-                                                   Ca,
-                                                   Cb);
+      FieldValue valDx = calculateEx_2D_TEz_Precalc (*Dx.getFieldValue (pos, 1),
+                                                     prevHz1,
+                                                     prevHz2,
+                                                     CaDx,
+                                                     CbDx);
 
-      valDx->setCurValue (val);
-    }
-  }
+      Dx.setFieldValue (valDx, pos, 0);
 
-  for (int i = ExStart.getX (); i < ExEnd.getX (); ++i)
-  {
-    for (int j = ExStart.getY (); j < ExEnd.getY (); ++j)
-    {
-      GridCoordinate2D pos (i, j);
-      GridCoordinate2D posAbs = Ex.getTotalPosition (pos);
-      GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getExCoordFP (posAbs));
-
-      FieldPointValue* valEx = Ex.getFieldPointValue (pos);
-      FieldPointValue* valDx = Dx.getFieldPointValue (pos);
+      FieldValue prevValDx = *Dx.getFieldValue (pos, 1);
 
-      FieldPointValue* valSigmaX1 = SigmaX.getFieldPointValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaX2 = SigmaX.getFieldPointValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valSigmaX1 = SigmaX.getFieldValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaX2 = SigmaX.getFieldValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
-      FieldPointValue* valSigmaZ1 = SigmaZ.getFieldPointValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaZ2 = SigmaZ.getFieldPointValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valSigmaZ1 = SigmaZ.getFieldValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaZ2 = SigmaZ.getFieldValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
-      FieldPointValue* valEps1 = Eps.getFieldPointValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valEps2 = Eps.getFieldPointValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valEps1 = Eps.getFieldValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valEps2 = Eps.getFieldValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue eps = (valEps1->getCurValue ().real () + valEps2->getCurValue ().real ()) / 2;
+      FPValue eps = (valEps1->real () + valEps2->real ()) / 2;
 
-      FPValue sigmaX = (valSigmaX1->getCurValue ().real () + valSigmaX2->getCurValue ().real ()) / 2;
-      FPValue sigmaZ = (valSigmaZ1->getCurValue ().real () + valSigmaZ2->getCurValue ().real ()) / 2;
+      FPValue sigmaX = (valSigmaX1->real () + valSigmaX2->real ()) / 2;
+      FPValue sigmaZ = (valSigmaZ1->real () + valSigmaZ2->real ()) / 2;
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue eps = (valEps1->getCurValue () + valEps2->getCurValue ()) / 2;
+      FPValue eps = (*valEps1 + *valEps2) / 2;
 
-      FPValue sigmaX = (valSigmaX1->getCurValue () + valSigmaX2->getCurValue ()) / 2;
-      FPValue sigmaZ = (valSigmaZ1->getCurValue () + valSigmaZ2->getCurValue ()) / 2;
+      FPValue sigmaX = (*valSigmaX1 + *valSigmaX2) / 2;
+      FPValue sigmaZ = (*valSigmaZ1 + *valSigmaZ2) / 2;
 #endif /* !COMPLEX_FIELD_VALUES */
 
       /*
@@ -357,14 +328,14 @@ SchemeTEz::calculateExStepPML (time_step t, GridCoordinate3D ExStart, GridCoordi
       FPValue Cb = ((2 * eps0 * k_x + sigmaX * gridTimeStep) / (eps * eps0)) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
       FPValue Cc = ((2 * eps0 * k_x - sigmaX * gridTimeStep) / (eps * eps0)) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
 
-      FieldValue val = calculateEx_from_Dx_Precalc (valEx->getPrevValue (),
-                                                    valDx->getCurValue (),
-                                                    valDx->getPrevValue (),
+      FieldValue val = calculateEx_from_Dx_Precalc (*Ex.getFieldValue (pos, 1),
+                                                    valDx,
+                                                    prevValDx,
                                                     Ca,
                                                     Cb,
                                                     Cc);
 
-      valEx->setCurValue (val);
+      Ex.setFieldValue (val, pos, 0);
     }
   }
 }
@@ -390,6 +361,9 @@ SchemeTEz::calculateEyStep (time_step t, GridCoordinate3D EyStart, GridCoordinat
 {
   FPValue eps0 = PhysicsConst::Eps0;
 
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (int i = EyStart.getX (); i < EyEnd.getX (); ++i)
   {
     for (int j = EyStart.getY (); j < EyEnd.getY (); ++j)
@@ -398,25 +372,20 @@ SchemeTEz::calculateEyStep (time_step t, GridCoordinate3D EyStart, GridCoordinat
       GridCoordinate2D posAbs = Ey.getTotalPosition (pos);
       GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getEyCoordFP (posAbs));
 
-      FieldPointValue* valEy = Ey.getFieldPointValue (pos);
-
       GridCoordinate2D posLeft = shrinkCoord (yeeLayout->getEyCircuitElement (GridCoordinate3D (pos), LayoutDirection::LEFT));
       GridCoordinate2D posRight = shrinkCoord (yeeLayout->getEyCircuitElement (GridCoordinate3D (pos), LayoutDirection::RIGHT));
 
-      FieldPointValue* valEps1 = Eps.getFieldPointValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valEps2 = Eps.getFieldPointValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valEps1 = Eps.getFieldValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valEps2 = Eps.getFieldValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue eps = (valEps1->getCurValue ().real () + valEps2->getCurValue ().real ()) / 2;
+      FPValue eps = (valEps1->real () + valEps2->real ()) / 2;
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue eps = (valEps1->getCurValue () + valEps2->getCurValue ()) / 2;
+      FPValue eps = (*valEps1 + *valEps2) / 2;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      FieldPointValue* valHz1 = Hz.getFieldPointValue (posRight);
-      FieldPointValue* valHz2 = Hz.getFieldPointValue (posLeft);
-
-      FieldValue prevHz1 = valHz1->getPrevValue ();
-      FieldValue prevHz2 = valHz2->getPrevValue ();
+      FieldValue prevHz1 = *Hz.getFieldValue (posRight, 1);
+      FieldValue prevHz2 = *Hz.getFieldValue (posLeft, 1);
 
       if (useTFSF)
       {
@@ -451,10 +420,7 @@ SchemeTEz::calculateEyStep (time_step t, GridCoordinate3D EyStart, GridCoordinat
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valH1 = HInc.getFieldPointValue (pos1);
-          FieldPointValue *valH2 = HInc.getFieldPointValue (pos2);
-
-          diff = proportionD1 * valH1->getPrevValue () + proportionD2 * valH2->getPrevValue ();
+          diff = proportionD1 * *HInc.getFieldValue (pos1, 1) + proportionD2 * *HInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_left)
@@ -467,14 +433,14 @@ SchemeTEz::calculateEyStep (time_step t, GridCoordinate3D EyStart, GridCoordinat
         }
       }
 
-      FieldValue val = calculateEy_2D_TEz (valEy->getPrevValue (),
+      FieldValue val = calculateEy_2D_TEz (*Ey.getFieldValue (pos, 1),
                                            prevHz1,
                                            prevHz2,
                                            gridTimeStep,
                                            gridStep,
                                            eps * eps0);
 
-      valEy->setCurValue (val);
+      Ey.setFieldValue (val, pos, 0);
     }
   }
 }
@@ -484,6 +450,12 @@ SchemeTEz::calculateEyStepPML (time_step t, GridCoordinate3D EyStart, GridCoordi
 {
   FPValue eps0 = PhysicsConst::Eps0;
 
+  /*
+   * Dy and Ey of each cell are updated in a single pass, so values of cell are reused while they are in registers
+   */
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (int i = EyStart.getX (); i < EyEnd.getX (); ++i)
   {
     for (int j = EyStart.getY (); j < EyEnd.getY (); ++j)
@@ -492,25 +464,20 @@ SchemeTEz::calculateEyStepPML (time_step t, GridCoordinate3D EyStart, GridCoordi
       GridCoordinate2D posAbs = Ey.getTotalPosition (pos);
       GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getEyCoordFP (posAbs));
 
-      FieldPointValue* valDy = Dy.getFieldPointValue (pos);
-
       GridCoordinate2D posLeft = shrinkCoord (yeeLayout->getEyCircuitElement (GridCoordinate3D (pos), LayoutDirection::LEFT));
       GridCoordinate2D posRight = shrinkCoord (yeeLayout->getEyCircuitElement (GridCoordinate3D (pos), LayoutDirection::RIGHT));
 
-      FieldPointValue* valSigmaZ1 = SigmaZ.getFieldPointValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaZ2 = SigmaZ.getFieldPointValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valSigmaZ1 = SigmaZ.getFieldValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaZ2 = SigmaZ.getFieldValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue sigmaZ = (valSigmaZ1->getCurValue ().real () + valSigmaZ2->getCurValue ().real ()) / 2;
+      FPValue sigmaZ = (valSigmaZ1->real () + valSigmaZ2->real ()) / 2;
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue sigmaZ = (valSigmaZ1->getCurValue () + valSigmaZ2->getCurValue ()) / 2;
+      FPValue sigmaZ = (*valSigmaZ1 + *valSigmaZ2) / 2;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      FieldPointValue* valHz1 = Hz.getFieldPointValue (posRight);
-      FieldPointValue* valHz2 = Hz.getFieldPointValue (posLeft);
-
-      FieldValue prevHz1 = valHz1->getPrevValue ();
-      FieldValue prevHz2 = valHz2->getPrevValue ();
+      FieldValue prevHz1 = *Hz.getFieldValue (posRight, 1);
+      FieldValue prevHz2 = *Hz.getFieldValue (posLeft, 1);
 
       if (useTFSF)
       {
@@ -545,10 +512,7 @@ SchemeTEz::calculateEyStepPML (time_step t, GridCoordinate3D EyStart, GridCoordi
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valH1 = HInc.getFieldPointValue (pos1);
-          FieldPointValue *valH2 = HInc.getFieldPointValue (pos2);
-
-          diff = proportionD1 * valH1->getPrevValue () + proportionD2 * valH2->getPrevValue ();
+          diff = proportionD1 * *HInc.getFieldValue (pos1, 1) + proportionD2 * *HInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_left)
@@ -566,50 +530,38 @@ SchemeTEz::calculateEyStepPML (time_step t, GridCoordinate3D EyStart, GridCoordi
        */
       FPValue k_z = 1;
 
-      FPValue Ca = (2 * eps0 * k_z - sigmaZ * gridTimeStep) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
-      FPValue Cb = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
+      FPValue CaDy = (2 * eps0 * k_z - sigmaZ * gridTimeStep) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
+      FPValue CbDy = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
 
-      FieldValue val = calculateEy_2D_TEz_Precalc (valDy->getPrevValue (),
-                                                   prevHz1,
-                                                   prevHz2,
-                                                   Ca,
-                                                   Cb);
+      FieldValue valDy = calculateEy_2D_TEz_Precalc (*Dy.getFieldValue (pos, 1),
+                                                     prevHz1,
+                                                     prevHz2,
+                                                     CaDy,
+                                                     CbDy);
 
-      valDy->setCurValue (val);
-    }
-  }
+      Dy.setFieldValue (valDy, pos, 0);
 
-  for (int i = EyStart.getX (); i < EyEnd.getX (); ++i)
-  {
-    for (int j = EyStart.getY (); j < EyEnd.getY (); ++j)
-    {
-      GridCoordinate2D pos (i, j);
-      GridCoordinate2D posAbs = Ey.getTotalPosition (pos);
-      GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getEyCoordFP (posAbs));
+      FieldValue prevValDy = *Dy.getFieldValue (pos, 1);
 
-      FieldPointValue* valEy = Ey.getFieldPointValue (pos);
+      FieldValue *valSigmaX1 = SigmaX.getFieldValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaX2 = SigmaX.getFieldValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
-      FieldPointValue* valDy = Dy.getFieldPointValue (pos);
+      FieldValue *valSigmaY1 = SigmaY.getFieldValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaY2 = SigmaY.getFieldValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
-      FieldPointValue* valSigmaX1 = SigmaX.getFieldPointValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaX2 = SigmaX.getFieldPointValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-
-      FieldPointValue* valSigmaY1 = SigmaY.getFieldPointValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaY2 = SigmaY.getFieldPointValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-
-      FieldPointValue* valEps1 = Eps.getFieldPointValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valEps2 = Eps.getFieldPointValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valEps1 = Eps.getFieldValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valEps2 = Eps.getFieldValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue eps = (valEps1->getCurValue ().real () + valEps2->getCurValue ().real ()) / 2;
+      FPValue eps = (valEps1->real () + valEps2->real ()) / 2;
 
-      FPValue sigmaX = (valSigmaX1->getCurValue ().real () + valSigmaX2->getCurValue ().real ()) / 2;
-      FPValue sigmaY = (valSigmaY1->getCurValue ().real () + valSigmaY2->getCurValue ().real ()) / 2;
+      FPValue sigmaX = (valSigmaX1->real () + valSigmaX2->real ()) / 2;
+      FPValue sigmaY = (valSigmaY1->real () + valSigmaY2->real ()) / 2;
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue eps = (valEps1->getCurValue () + valEps2->getCurValue ()) / 2;
+      FPValue eps = (*valEps1 + *valEps2) / 2;
 
-      FPValue sigmaX = (valSigmaX1->getCurValue () + valSigmaX2->getCurValue ()) / 2;
-      FPValue sigmaY = (valSigmaY1->getCurValue () + valSigmaY2->getCurValue ()) / 2;
+      FPValue sigmaX = (*valSigmaX1 + *valSigmaX2) / 2;
+      FPValue sigmaY = (*valSigmaY1 + *valSigmaY2) / 2;
 #endif /* !COMPLEX_FIELD_VALUES */
 
       /*
@@ -622,14 +574,14 @@ SchemeTEz::calculateEyStepPML (time_step t, GridCoordinate3D EyStart, GridCoordi
       FPValue Cb = ((2 * eps0 * k_y + sigmaY * gridTimeStep) / (eps * eps0)) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
       FPValue Cc = ((2 * eps0 * k_y - sigmaY * gridTimeStep) / (eps * eps0)) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
 
-      FieldValue val = calculateEy_from_Dy_Precalc (valEy->getPrevValue (),
-                                                    valDy->getCurValue (),
-                                                    valDy->getPrevValue (),
+      FieldValue val = calculateEy_from_Dy_Precalc (*Ey.getFieldValue (pos, 1),
+                                                    valDy,
+                                                    prevValDy,
                                                     Ca,
                                                     Cb,
                                                     Cc);
 
-      valEy->setCurValue (val);
+      Ey.setFieldValue (val, pos, 0);
     }
   }
 }
@@ -655,6 +607,9 @@ SchemeTEz::calculateHzStep (time_step t, GridCoordinate3D HzStart, GridCoordinat
 {
   FPValue mu0 = PhysicsConst::Mu0;
 
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (int i = HzStart.getX (); i < HzEnd.getX (); ++i)
   {
     for (int j = HzStart.getY (); j < HzEnd.getY (); ++j)
@@ -663,36 +618,28 @@ SchemeTEz::calculateHzStep (time_step t, GridCoordinate3D HzStart, GridCoordinat
       GridCoordinate2D posAbs = Hz.getTotalPosition (pos);
       GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getHzCoordFP (posAbs));
 
-      FieldPointValue* valHz = Hz.getFieldPointValue (pos);
-
       GridCoordinate2D posLeft = shrinkCoord (yeeLayout->getHzCircuitElement (pos, LayoutDirection::LEFT));
       GridCoordinate2D posRight = shrinkCoord (yeeLayout->getHzCircuitElement (pos, LayoutDirection::RIGHT));
 
       GridCoordinate2D posDown = shrinkCoord (yeeLayout->getHzCircuitElement (pos, LayoutDirection::DOWN));
       GridCoordinate2D posUp = shrinkCoord (yeeLayout->getHzCircuitElement (pos, LayoutDirection::UP));
 
-      FieldPointValue* valMu1 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
-      FieldPointValue* valMu2 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
-      FieldPointValue* valMu3 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
-      FieldPointValue* valMu4 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
+      FieldValue *valMu1 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
+      FieldValue *valMu2 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
+      FieldValue *valMu3 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
+      FieldValue *valMu4 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue mu = (valMu1->getCurValue ().real () + valMu2->getCurValue ().real () + valMu3->getCurValue ().real () + valMu4->getCurValue ().real ()) / 4;
+      FPValue mu = (valMu1->real () + valMu2->real () + valMu3->real () + valMu4->real ()) / 4;
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue mu = (valMu1->getCurValue () + valMu2->getCurValue () + valMu3->getCurValue () + valMu4->getCurValue ()) / 4;
+      FPValue mu = (*valMu1 + *valMu2 + *valMu3 + *valMu4) / 4;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      FieldPointValue* valEy1 = Ey.getFieldPointValue (posRight);
-      FieldPointValue* valEy2 = Ey.getFieldPointValue (posLeft);
-
-      FieldPointValue* valEx1 = Ex.getFieldPointValue (posUp);
-      FieldPointValue* valEx2 = Ex.getFieldPointValue (posDown);
+      FieldValue prevEx1 = *Ex.getFieldValue (posUp, 1);
+      FieldValue prevEx2 = *Ex.getFieldValue (posDown, 1);
 
-      FieldValue prevEx1 = valEx1->getPrevValue ();
-      FieldValue prevEx2 = valEx2->getPrevValue ();
-
-      FieldValue prevEy1 = valEy1->getPrevValue ();
-      FieldValue prevEy2 = valEy2->getPrevValue ();
+      FieldValue prevEy1 = *Ey.getFieldValue (posRight, 1);
+      FieldValue prevEy2 = *Ey.getFieldValue (posLeft, 1);
 
       if (useTFSF)
       {
@@ -740,10 +687,7 @@ SchemeTEz::calculateHzStep (time_step t, GridCoordinate3D HzStart, GridCoordinat
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valE1 = EInc.getFieldPointValue (pos1);
-          FieldPointValue *valE2 = EInc.getFieldPointValue (pos2);
-
-          diffY = proportionD1 * valE1->getPrevValue () + proportionD2 * valE2->getPrevValue ();
+          diffY = proportionD1 * *EInc.getFieldValue (pos1, 1) + proportionD2 * *EInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_left || do_need_update_right)
@@ -762,10 +706,7 @@ SchemeTEz::calculateHzStep (time_step t, GridCoordinate3D HzStart, GridCoordinat
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valE1 = EInc.getFieldPointValue (pos1);
-          FieldPointValue *valE2 = EInc.getFieldPointValue (pos2);
-
-          diffX = proportionD1 * valE1->getPrevValue () + proportionD2 * valE2->getPrevValue ();
+          diffX = proportionD1 * *EInc.getFieldValue (pos1, 1) + proportionD2 * *EInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_down)
@@ -787,7 +728,7 @@ SchemeTEz::calculateHzStep (time_step t, GridCoordinate3D HzStart, GridCoordinat
         }
       }
 
-      FieldValue val = calculateHz_3D (valHz->getPrevValue (),
+      FieldValue val = calculateHz_3D (*Hz.getFieldValue (pos, 1),
                                        prevEx1,
                                        prevEx2,
                                        prevEy1,
@@ -796,7 +737,7 @@ SchemeTEz::calculateHzStep (time_step t, GridCoordinate3D HzStart, GridCoordinat
                                        gridStep,
                                        mu * mu0);
 
-      valHz->setCurValue (val);
+      Hz.setFieldValue (val, pos, 0);
     }
   }
 }
@@ -807,6 +748,12 @@ SchemeTEz::calculateHzStepPML (time_step t, GridCoordinate3D HzStart, GridCoordi
   FPValue eps0 = PhysicsConst::Eps0;
   FPValue mu0 = PhysicsConst::Mu0;
 
+  /*
+   * Bz and Hz of each cell are updated in a single pass, so values of cell are reused while they are in registers
+   */
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (int i = HzStart.getX (); i < HzEnd.getX (); ++i)
   {
     for (int j = HzStart.getY (); j < HzEnd.getY (); ++j)
@@ -815,38 +762,28 @@ SchemeTEz::calculateHzStepPML (time_step t, GridCoordinate3D HzStart, GridCoordi
       GridCoordinate2D posAbs = Hz.getTotalPosition (pos);
       GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getHzCoordFP (posAbs));
 
-      FieldPointValue* valBz = Bz.getFieldPointValue (pos);
-
-      FieldPointValue* valHz = Hz.getFieldPointValue (pos);
-
       GridCoordinate2D posLeft = shrinkCoord (yeeLayout->getHzCircuitElement (pos, LayoutDirection::LEFT));
       GridCoordinate2D posRight = shrinkCoord (yeeLayout->getHzCircuitElement (pos, LayoutDirection::RIGHT));
 
       GridCoordinate2D posDown = shrinkCoord (yeeLayout->getHzCircuitElement (pos, LayoutDirection::DOWN));
       GridCoordinate2D posUp = shrinkCoord (yeeLayout->getHzCircuitElement (pos, LayoutDirection::UP));
 
-      FieldPointValue* valSigmaX1 = SigmaX.getFieldPointValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaX2 = SigmaX.getFieldPointValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaX3 = SigmaX.getFieldPointValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaX4 = SigmaX.getFieldPointValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
+      FieldValue *valSigmaX1 = SigmaX.getFieldValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaX2 = SigmaX.getFieldValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaX3 = SigmaX.getFieldValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaX4 = SigmaX.getFieldValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue sigmaX = (valSigmaX1->getCurValue ().real () + valSigmaX2->getCurValue ().real () + valSigmaX3->getCurValue ().real () + valSigmaX4->getCurValue ().real ()) / 4;
+      FPValue sigmaX = (valSigmaX1->real () + valSigmaX2->real () + valSigmaX3->real () + valSigmaX4->real ()) / 4;
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue sigmaX = (valSigmaX1->getCurValue () + valSigmaX2->getCurValue () + valSigmaX3->getCurValue () + valSigmaX4->getCurValue ()) / 4;
+      FPValue sigmaX = (*valSigmaX1 + *valSigmaX2 + *valSigmaX3 + *valSigmaX4) / 4;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      FieldPointValue* valEy1 = Ey.getFieldPointValue (posRight);
-      FieldPointValue* valEy2 = Ey.getFieldPointValue (posLeft);
-
-      FieldPointValue* valEx1 = Ex.getFieldPointValue (posUp);
-      FieldPointValue* valEx2 = Ex.getFieldPointValue (posDown);
-
-      FieldValue prevEx1 = valEx1->getPrevValue ();
-      FieldValue prevEx2 = valEx2->getPrevValue ();
+      FieldValue prevEx1 = *Ex.getFieldValue (posUp, 1);
+      FieldValue prevEx2 = *Ex.getFieldValue (posDown, 1);
 
-      FieldValue prevEy1 = valEy1->getPrevValue ();
-      FieldValue prevEy2 = valEy2->getPrevValue ();
+      FieldValue prevEy1 = *Ey.getFieldValue (posRight, 1);
+      FieldValue prevEy2 = *Ey.getFieldValue (posLeft, 1);
 
       if (useTFSF)
       {
@@ -894,10 +831,7 @@ SchemeTEz::calculateHzStepPML (time_step t, GridCoordinate3D HzStart, GridCoordi
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valE1 = EInc.getFieldPointValue (pos1);
-          FieldPointValue *valE2 = EInc.getFieldPointValue (pos2);
-
-          diffY = proportionD1 * valE1->getPrevValue () + proportionD2 * valE2->getPrevValue ();
+          diffY = proportionD1 * *EInc.getFieldValue (pos1, 1) + proportionD2 * *EInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_left || do_need_update_right)
@@ -916,10 +850,7 @@ SchemeTEz::calculateHzStepPML (time_step t, GridCoordinate3D HzStart, GridCoordi
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valE1 = EInc.getFieldPointValue (pos1);
-          FieldPointValue *valE2 = EInc.getFieldPointValue (pos2);
-
-          diffX = proportionD1 * valE1->getPrevValue () + proportionD2 * valE2->getPrevValue ();
+          diffX = proportionD1 * *EInc.getFieldValue (pos1, 1) + proportionD2 * *EInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_down)
@@ -947,58 +878,46 @@ SchemeTEz::calculateHzStepPML (time_step t, GridCoordinate3D HzStart, GridCoordi
 
       FPValue k_x = 1;
 
-      FPValue Ca = (2 * eps0 * k_x - sigmaX * gridTimeStep) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
-      FPValue Cb = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
-
-      FieldValue val = calculateHz_3D_Precalc (valBz->getPrevValue (),
-                                               prevEx1,
-                                               prevEx2,
-                                               prevEy1,
-                                               prevEy2,
-                                               Ca,
-                                               Cb);
-
-      valBz->setCurValue (val);
-    }
-  }
+      FPValue CaBz = (2 * eps0 * k_x - sigmaX * gridTimeStep) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
+      FPValue CbBz = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
 
-  for (int i = HzStart.getX (); i < HzEnd.getX (); ++i)
-  {
-    for (int j = HzStart.getY (); j < HzEnd.getY (); ++j)
-    {
-      GridCoordinate2D pos (i, j);
-      GridCoordinate2D posAbs = Hz.getTotalPosition (pos);
-      GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getHzCoordFP (posAbs));
+      FieldValue valBz = calculateHz_3D_Precalc (*Bz.getFieldValue (pos, 1),
+                                                 prevEx1,
+                                                 prevEx2,
+                                                 prevEy1,
+                                                 prevEy2,
+                                                 CaBz,
+                                                 CbBz);
 
-      FieldPointValue* valHz = Hz.getFieldPointValue (pos);
+      Bz.setFieldValue (valBz, pos, 0);
 
-      FieldPointValue* valBz = Bz.getFieldPointValue (pos);
+      FieldValue prevValBz = *Bz.getFieldValue (pos, 1);
 
-      FieldPointValue* valSigmaY1 = SigmaY.getFieldPointValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaY2 = SigmaY.getFieldPointValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaY3 = SigmaY.getFieldPointValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaY4 = SigmaY.getFieldPointValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
+      FieldValue *valSigmaY1 = SigmaY.getFieldValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaY2 = SigmaY.getFieldValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaY3 = SigmaY.getFieldValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaY4 = SigmaY.getFieldValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
 
-      FieldPointValue* valSigmaZ1 = SigmaZ.getFieldPointValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaZ2 = SigmaZ.getFieldPointValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaZ3 = SigmaZ.getFieldPointValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaZ4 = SigmaZ.getFieldPointValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
+      FieldValue *valSigmaZ1 = SigmaZ.getFieldValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaZ2 = SigmaZ.getFieldValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaZ3 = SigmaZ.getFieldValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaZ4 = SigmaZ.getFieldValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
 
-      FieldPointValue* valMu1 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
-      FieldPointValue* valMu2 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
-      FieldPointValue* valMu3 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
-      FieldPointValue* valMu4 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))));
+      FieldValue *valMu1 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
+      FieldValue *valMu2 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () + 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
+      FieldValue *valMu3 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
+      FieldValue *valMu4 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getMuCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY () - 0.5, yeeLayout->getMinMuCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue mu = (valMu1->getCurValue ().real () + valMu2->getCurValue ().real () + valMu3->getCurValue ().real () + valMu4->getCurValue ().real ()) / 4;
+      FPValue mu = (valMu1->real () + valMu2->real () + valMu3->real () + valMu4->real ()) / 4;
 
-      FPValue sigmaY = (valSigmaY1->getCurValue ().real () + valSigmaY2->getCurValue ().real () + valSigmaY3->getCurValue ().real () + valSigmaY4->getCurValue ().real ()) / 4;
-      FPValue sigmaZ = (valSigmaZ1->getCurValue ().real () + valSigmaZ2->getCurValue ().real () + valSigmaZ3->getCurValue ().real () + valSigmaZ4->getCurValue ().real ()) / 4;
+      FPValue sigmaY = (valSigmaY1->real () + valSigmaY2->real () + valSigmaY3->real () + valSigmaY4->real ()) / 4;
+      FPValue sigmaZ = (valSigmaZ1->real () + valSigmaZ2->real () + valSigmaZ3->real () + valSigmaZ4->real ()) / 4;
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue mu = (valMu1->getCurValue () + valMu2->getCurValue () + valMu3->getCurValue () + valMu4->getCurValue ()) / 4;
+      FPValue mu = (*valMu1 + *valMu2 + *valMu3 + *valMu4) / 4;
 
-      FPValue sigmaY = (valSigmaY1->getCurValue () + valSigmaY2->getCurValue () + valSigmaY3->getCurValue () + valSigmaY4->getCurValue ()) / 4;
-      FPValue sigmaZ = (valSigmaZ1->getCurValue () + valSigmaZ2->getCurValue () + valSigmaZ3->getCurValue () + valSigmaZ4->getCurValue ()) / 4;
+      FPValue sigmaY = (*valSigmaY1 + *valSigmaY2 + *valSigmaY3 + *valSigmaY4) / 4;
+      FPValue sigmaZ = (*valSigmaZ1 + *valSigmaZ2 + *valSigmaZ3 + *valSigmaZ4) / 4;
 #endif /* !COMPLEX_FIELD_VALUES */
 
       /*
@@ -1012,18 +931,91 @@ SchemeTEz::calculateHzStepPML (time_step t, GridCoordinate3D HzStart, GridCoordi
       FPValue Cb = ((2 * eps0 * k_z + sigmaZ * gridTimeStep) / (mu * mu0)) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
       FPValue Cc = ((2 * eps0 * k_z - sigmaZ * gridTimeStep) / (mu * mu0)) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
 
-      FieldValue val = calculateHz_from_Bz_Precalc (valHz->getPrevValue (),
-                                                    valBz->getCurValue (),
-                                                    valBz->getPrevValue (),
+      FieldValue val = calculateHz_from_Bz_Precalc (*Hz.getFieldValue (pos, 1),
+                                                    valBz,
+                                                    prevValBz,
                                                     Ca,
                                                     Cb,
                                                     Cc);
 
-      valHz->setCurValue (val);
+      Hz.setFieldValue (val, pos, 0);
     }
   }
 }
 
+#if defined (PARALLEL_GRID)
+SchemeTEz::InteriorHStepsTask::InteriorHStepsTask (SchemeTEz *schemeTEz,
+                                                   time_step step,
+                                                   GridCoordinate3D interiorHzStart,
+                                                   GridCoordinate3D interiorHzEnd)
+  : scheme (schemeTEz)
+  , t (step)
+  , HzStart (interiorHzStart)
+  , HzEnd (interiorHzEnd)
+{
+}
+
+grid_iter
+SchemeTEz::InteriorHStepsTask::getNumParts () const
+{
+  return HzEnd.getX () - HzStart.getX ();
+}
+
+void
+SchemeTEz::InteriorHStepsTask::run (grid_iter part)
+{
+  grid_iter i = HzStart.getX () + part;
+
+  scheme->performHzSteps (t,
+                          GridCoordinate3D (i, HzStart.getY (), HzStart.getZ ()),
+                          GridCoordinate3D (i + 1, HzEnd.getY (), HzEnd.getZ ()));
+}
+
+/*
+ * Interior of computation area is the area without its outer layer of cells, which could read receive buffers of
+ * neighbouring grids. It is empty when computation area is too small.
+ */
+GridCoordinate3D
+SchemeTEz::getInteriorStart (GridCoordinate3D start, GridCoordinate3D end)
+{
+  return GridCoordinate3D (start.getX () < end.getX () ? start.getX () + 1 : end.getX (),
+                           start.getY () < end.getY () ? start.getY () + 1 : end.getY (),
+                           start.getZ ());
+}
+
+GridCoordinate3D
+SchemeTEz::getInteriorEnd (GridCoordinate3D start, GridCoordinate3D end)
+{
+  GridCoordinate3D interiorStart = getInteriorStart (start, end);
+
+  return GridCoordinate3D (end.getX () > interiorStart.getX () + 1 ? end.getX () - 1 : interiorStart.getX (),
+                           end.getY () > interiorStart.getY () + 1 ? end.getY () - 1 : interiorStart.getY (),
+                           end.getZ ());
+}
+
+/*
+ * Perform steps in computation area except for its interior, which is updated separately
+ */
+void
+SchemeTEz::performBorderSteps (StepsFunction performSteps,
+                               time_step t,
+                               GridCoordinate3D start,
+                               GridCoordinate3D end,
+                               GridCoordinate3D interiorStart,
+                               GridCoordinate3D interiorEnd)
+{
+  (this->*performSteps) (t, start, GridCoordinate3D (interiorStart.getX (), end.getY (), end.getZ ()));
+  (this->*performSteps) (t, GridCoordinate3D (interiorEnd.getX (), start.getY (), start.getZ ()), end);
+
+  (this->*performSteps) (t,
+                         GridCoordinate3D (interiorStart.getX (), start.getY (), start.getZ ()),
+                         GridCoordinate3D (interiorEnd.getX (), interiorStart.getY (), end.getZ ()));
+  (this->*performSteps) (t,
+                         GridCoordinate3D (interiorStart.getX (), interiorEnd.getY (), start.getZ ()),
+                         GridCoordinate3D (interiorEnd.getX (), end.getY (), end.getZ ()));
+}
+#endif /* PARALLEL_GRID */
+
 void
 SchemeTEz::performNSteps (time_step startStep, time_step numberTimeSteps)
 {
@@ -1057,7 +1049,6 @@ SchemeTEz::performNSteps (time_step startStep, time_step numberTimeSteps)
     performEySteps (t, EyStart, EyEnd);
 
     Ex.nextTimeStep ();
-    Ey.nextTimeStep ();
 
     if (usePML)
     {
@@ -1070,7 +1061,24 @@ SchemeTEz::performNSteps (time_step startStep, time_step numberTimeSteps)
       performPlaneWaveHSteps (t);
     }
 
+#if defined (PARALLEL_GRID)
+    /*
+     * Interior of Hz is updated while Ey is shared, outer layer of it reads receive buffers of Ey, so it is updated
+     * after share operations are finished
+     */
+    GridCoordinate3D HzInteriorStart = getInteriorStart (HzStart, HzEnd);
+    GridCoordinate3D HzInteriorEnd = getInteriorEnd (HzStart, HzEnd);
+
+    InteriorHStepsTask interiorHSteps (this, t, HzInteriorStart, HzInteriorEnd);
+
+    Ey.nextTimeStep (interiorHSteps);
+
+    performBorderSteps (&SchemeTEz::performHzSteps, t, HzStart, HzEnd, HzInteriorStart, HzInteriorEnd);
+#else /* PARALLEL_GRID */
+    Ey.nextTimeStep ();
+
     performHzSteps (t, HzStart, HzEnd);
+#endif /* !PARALLEL_GRID */
 
     if (!useTFSF)
     {
@@ -1079,13 +1087,12 @@ SchemeTEz::performNSteps (time_step startStep, time_step numberTimeSteps)
 #endif
       {
         GridCoordinate2D pos (HzSize.getX () / 2, HzSize.getY () / 2);
-        FieldPointValue* tmp = Hz.getFieldPointValue (pos);
 
 #ifdef COMPLEX_FIELD_VALUES
-        tmp->setCurValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
-                                      cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)));
+        Hz.setFieldValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
+                                      cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)), pos, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        tmp->setCurValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency));
+        Hz.setFieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency), pos, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
       }
     }
@@ -1102,15 +1109,15 @@ SchemeTEz::performNSteps (time_step startStep, time_step numberTimeSteps)
       if (dumpRes)
       {
         BMPDumper<GridCoordinate2D> dumperEx;
-        dumperEx.init (t, CURRENT, processId, "2D-TEz-in-time-Ex");
+        dumperEx.init (t, PREVIOUS, processId, "2D-TEz-in-time-Ex");
         dumperEx.dumpGrid (Ex, GridCoordinate2D (0), Ex.getSize ());
 
         BMPDumper<GridCoordinate2D> dumperEy;
-        dumperEy.init (t, CURRENT, processId, "2D-TEz-in-time-Ey");
+        dumperEy.init (t, PREVIOUS, processId, "2D-TEz-in-time-Ey");
         dumperEy.dumpGrid (Ey, GridCoordinate2D (0), Ey.getSize ());
 
         BMPDumper<GridCoordinate2D> dumperHz;
-        dumperHz.init (t, CURRENT, processId, "2D-TEz-in-time-Hz");
+        dumperHz.init (t, PREVIOUS, processId, "2D-TEz-in-time-Hz");
         dumperHz.dumpGrid (Hz, GridCoordinate2D (0), Hz.getSize ());
       }
     }
@@ -1130,9 +1137,7 @@ SchemeTEz::performNSteps (time_step startStep, time_step numberTimeSteps)
 
             if (!yeeLayout->isHzInPML (Hz.getTotalPosition (pos)))
             {
-              FieldPointValue *value = Hz.getFieldPointValue (pos);
-
-              FieldValue val = value->getCurValue ();
+              FieldValue val = *Hz.getFieldValue (pos, 1);
 
               norm += val.real () * val.real () + val.imag () * val.imag ();
             }
@@ -1150,15 +1155,15 @@ SchemeTEz::performNSteps (time_step startStep, time_step numberTimeSteps)
   if (dumpRes)
   {
     BMPDumper<GridCoordinate2D> dumperEx;
-    dumperEx.init (stepLimit, CURRENT, processId, "2D-TEz-in-time-Ex");
+    dumperEx.init (stepLimit, PREVIOUS, processId, "2D-TEz-in-time-Ex");
     dumperEx.dumpGrid (Ex, GridCoordinate2D (0), Ex.getSize ());
 
     BMPDumper<GridCoordinate2D> dumperEy;
-    dumperEy.init (stepLimit, CURRENT, processId, "2D-TEz-in-time-Ey");
+    dumperEy.init (stepLimit, PREVIOUS, processId, "2D-TEz-in-time-Ey");
     dumperEy.dumpGrid (Ey, GridCoordinate2D (0), Ey.getSize ());
 
     BMPDumper<GridCoordinate2D> dumperHz;
-    dumperHz.init (stepLimit, CURRENT, processId, "2D-TEz-in-time-Hz");
+    dumperHz.init (stepLimit, PREVIOUS, processId, "2D-TEz-in-time-Hz");
     dumperHz.dumpGrid (Hz, GridCoordinate2D (0), Hz.getSize ());
   }
 
@@ -1175,9 +1180,7 @@ SchemeTEz::performNSteps (time_step startStep, time_step numberTimeSteps)
 
         if (!yeeLayout->isHzInPML (Hz.getTotalPosition (pos)))
         {
-          FieldPointValue *value = Hz.getFieldPointValue (pos);
-
-          FieldValue val = value->getCurValue ();
+          FieldValue val = *Hz.getFieldValue (pos, 1);
 
           norm += val.real () * val.real () + val.imag () * val.imag ();
         }
@@ -1235,6 +1238,9 @@ SchemeTEz::performAmplitudeSteps (time_step startStep)
     performExSteps (t, ExStart, ExEnd);
     performEySteps (t, EyStart, EyEnd);
 
+#ifdef OPENMP_ENABLED
+    #pragma omp parallel for collapse (2) reduction (max: maxAccuracy) reduction (min: is_stable_state)
+#endif /* OPENMP_ENABLED */
     for (int i = ExStart.getX (); i < ExEnd.getX (); ++i)
     {
       for (int j = ExStart.getY (); j < ExEnd.getY (); ++j)
@@ -1243,12 +1249,9 @@ SchemeTEz::performAmplitudeSteps (time_step startStep)
 
         if (!yeeLayout->isExInPML (Ex.getTotalPosition (pos)))
         {
-          FieldPointValue* tmp = Ex.getFieldPointValue (pos);
-          FieldPointValue* tmpAmp = ExAmplitude.getFieldPointValue (pos);
-
-          FPValue val = tmp->getCurValue ();
+          FPValue val = *Ex.getFieldValue (pos, 0);
 
-          if (updateAmplitude (val, tmpAmp, &maxAccuracy) == 0)
+          if (updateAmplitude (val, ExAmplitude.getFieldValue (pos, 0), &maxAccuracy) == 0)
           {
             is_stable_state = 0;
           }
@@ -1256,6 +1259,9 @@ SchemeTEz::performAmplitudeSteps (time_step startStep)
       }
     }
 
+#ifdef OPENMP_ENABLED
+    #pragma omp parallel for collapse (2) reduction (max: maxAccuracy) reduction (min: is_stable_state)
+#endif /* OPENMP_ENABLED */
     for (int i = EyStart.getX (); i < EyEnd.getX (); ++i)
     {
       for (int j = EyStart.getY (); j < EyEnd.getY (); ++j)
@@ -1264,12 +1270,9 @@ SchemeTEz::performAmplitudeSteps (time_step startStep)
 
         if (!yeeLayout->isEyInPML (Ey.getTotalPosition (pos)))
         {
-          FieldPointValue* tmp = Ey.getFieldPointValue (pos);
-          FieldPointValue* tmpAmp = EyAmplitude.getFieldPointValue (pos);
-
-          FPValue val = tmp->getCurValue ();
+          FPValue val = *Ey.getFieldValue (pos, 0);
 
-          if (updateAmplitude (val, tmpAmp, &maxAccuracy) == 0)
+          if (updateAmplitude (val, EyAmplitude.getFieldValue (pos, 0), &maxAccuracy) == 0)
           {
             is_stable_state = 0;
           }
@@ -1300,17 +1303,19 @@ SchemeTEz::performAmplitudeSteps (time_step startStep)
 #endif
       {
         GridCoordinate2D pos (HzSize.getX () / 2, HzSize.getY () / 2);
-        FieldPointValue* tmp = Hz.getFieldPointValue (pos);
 
 #ifdef COMPLEX_FIELD_VALUES
-        tmp->setCurValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
-                                      cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)));
+        Hz.setFieldValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
+                                      cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)), pos, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        tmp->setCurValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency));
+        Hz.setFieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency), pos, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
       }
     }
 
+#ifdef OPENMP_ENABLED
+    #pragma omp parallel for collapse (2) reduction (max: maxAccuracy) reduction (min: is_stable_state)
+#endif /* OPENMP_ENABLED */
     for (int i = HzStart.getX (); i < HzEnd.getX (); ++i)
     {
       for (int j = HzStart.getY (); j < HzEnd.getY (); ++j)
@@ -1319,12 +1324,9 @@ SchemeTEz::performAmplitudeSteps (time_step startStep)
 
         if (!yeeLayout->isHzInPML (Hz.getTotalPosition (pos)))
         {
-          FieldPointValue* tmp = Hz.getFieldPointValue (pos);
-          FieldPointValue* tmpAmp = HzAmplitude.getFieldPointValue (pos);
+          FPValue val = *Hz.getFieldValue (pos, 0);
 
-          FPValue val = tmp->getCurValue ();
-
-          if (updateAmplitude (val, tmpAmp, &maxAccuracy) == 0)
+          if (updateAmplitude (val, HzAmplitude.getFieldValue (pos, 0), &maxAccuracy) == 0)
           {
             is_stable_state = 0;
           }
@@ -1365,9 +1367,7 @@ SchemeTEz::performAmplitudeSteps (time_step startStep)
 
         if (j == HzAmplitude.getSize ().getY () / 2)
         {
-          FieldPointValue* tmp = HzAmplitude.getFieldPointValue (pos);
-
-          printf ("%u: %f\n", i, tmp->getCurValue ());
+          printf ("%u: %f\n", i, *HzAmplitude.getFieldValue (pos, 0));
         }
       }
     }
@@ -1381,7 +1381,7 @@ SchemeTEz::performAmplitudeSteps (time_step startStep)
 }
 
 int
-SchemeTEz::updateAmplitude (FPValue val, FieldPointValue *amplitudeValue, FPValue *maxAccuracy)
+SchemeTEz::updateAmplitude (FPValue val, FieldValue *amplitudeValue, FPValue *maxAccuracy)
 {
 #ifdef COMPLEX_FIELD_VALUES
   UNREACHABLE;
@@ -1389,7 +1389,7 @@ SchemeTEz::updateAmplitude (FPValue val, FieldPointValue *amplitudeValue, FPValu
 
   int is_stable_state = 1;
 
-  FPValue valAmp = amplitudeValue->getCurValue ();
+  FPValue valAmp = *amplitudeValue;
 
   val = val >= 0 ? val : -val;
 
@@ -1409,7 +1409,7 @@ SchemeTEz::updateAmplitude (FPValue val, FieldPointValue *amplitudeValue, FPValu
     {
       is_stable_state = 0;
 
-      amplitudeValue->setCurValue (val);
+      *amplitudeValue = val;
     }
 
     if (accuracy > *maxAccuracy)
@@ -1473,12 +1473,12 @@ SchemeTEz::initGrids ()
   {
     for (int j = 0; j < Eps.getSize ().getY (); ++j)
     {
-      FieldPointValue* valEps = new FieldPointValue ();
+      FieldValue valEps;
 
 #ifdef COMPLEX_FIELD_VALUES
-      valEps->setCurValue (FieldValue (1, 0));
+      valEps = FieldValue (1, 0);
 #else /* COMPLEX_FIELD_VALUES */
-      valEps->setCurValue (1);
+      valEps = 1;
 #endif /* !COMPLEX_FIELD_VALUES */
 
       GridCoordinate2D pos (i, j);
@@ -1494,10 +1494,10 @@ SchemeTEz::initGrids ()
       if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
           + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0))
       {
-        valEps->setCurValue (4);
+        valEps = 4;
       }
 
-      Eps.setFieldPointValue (valEps, pos);
+      Eps.setFieldValue (valEps, pos, 0);
     }
   }
 
@@ -1513,253 +1513,142 @@ SchemeTEz::initGrids ()
   {
     for (int j = 0; j < Mu.getSize ().getY (); ++j)
     {
-      FieldPointValue* valMu = new FieldPointValue ();
+      FieldValue valMu;
 
 #ifdef COMPLEX_FIELD_VALUES
-      valMu->setCurValue (FieldValue (1, 0));
+      valMu = FieldValue (1, 0);
 #else /* COMPLEX_FIELD_VALUES */
-      valMu->setCurValue (1);
+      valMu = 1;
 #endif /* !COMPLEX_FIELD_VALUES */
 
       GridCoordinate2D pos (i, j);
 
-      Mu.setFieldPointValue (valMu, pos);
+      Mu.setFieldValue (valMu, pos, 0);
     }
   }
 
-  FPValue eps0 = PhysicsConst::Eps0;
-  FPValue mu0 = PhysicsConst::Mu0;
+  if (usePML)
+  {
+    FPValue eps0 = PhysicsConst::Eps0;
+    FPValue mu0 = PhysicsConst::Mu0;
 
-  GridCoordinate2D PMLSize = shrinkCoord (yeeLayout->getLeftBorderPML ());
+    GridCoordinate2D PMLSize = shrinkCoord (yeeLayout->getLeftBorderPML ());
 
-  FPValue boundary = PMLSize.getX () * gridStep;
-  uint32_t exponent = 6;
-	FPValue R_err = 1e-16;
-	FPValue sigma_max_1 = -log (R_err) * (exponent + 1.0) / (2.0 * sqrt (mu0 / eps0) * boundary);
-	FPValue boundaryFactor = sigma_max_1 / (gridStep * (pow (boundary, exponent)) * (exponent + 1));
+    FPValue boundary = PMLSize.getX () * gridStep;
+    uint32_t exponent = 6;
+  	FPValue R_err = 1e-16;
+  	FPValue sigma_max_1 = -log (R_err) * (exponent + 1.0) / (2.0 * sqrt (mu0 / eps0) * boundary);
+  	FPValue boundaryFactor = sigma_max_1 / (gridStep * (pow (boundary, exponent)) * (exponent + 1));
 
-  for (int i = 0; i < SigmaX.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < SigmaX.getSize ().getY (); ++j)
+    for (int i = 0; i < SigmaX.getSize ().getX (); ++i)
     {
-      FieldPointValue* valSigma = new FieldPointValue ();
+      for (int j = 0; j < SigmaX.getSize ().getY (); ++j)
+      {
+        FieldValue valSigma (0);
 
-      GridCoordinate2D pos (i, j);
-      GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaX.getTotalPosition (pos)));
+        GridCoordinate2D pos (i, j);
+        GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaX.getTotalPosition (pos)));
 
-      GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaX.getTotalSize ()));
+        GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaX.getTotalSize ()));
 
-      /*
-       * FIXME: add layout coordinates for material: sigma, eps, etc.
-       */
-      if (posAbs.getX () < PMLSize.getX ())
-      {
-        grid_coord dist = PMLSize.getX () - posAbs.getX ();
-  			FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
-  			FPValue x2 = dist * gridStep;       // lower bounds for point i
+        /*
+         * FIXME: add layout coordinates for material: sigma, eps, etc.
+         */
+        if (posAbs.getX () < PMLSize.getX ())
+        {
+          grid_coord dist = PMLSize.getX () - posAbs.getX ();
+    			FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
+    			FPValue x2 = dist * gridStep;       // lower bounds for point i
 
-  			FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
+    			FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
 
 #ifdef COMPLEX_FIELD_VALUES
-  			valSigma->setCurValue (FieldValue (val, 0));
+    			valSigma = FieldValue (val, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        valSigma->setCurValue (val);
+          valSigma = val;
 #endif /* !COMPLEX_FIELD_VALUES */
-      }
-      else if (posAbs.getX () >= size.getX () - PMLSize.getX ())
-      {
-        grid_coord dist = posAbs.getX () - (size.getX () - PMLSize.getX ());
-  			FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
-  			FPValue x2 = dist * gridStep;       // lower bounds for point i
+        }
+        else if (posAbs.getX () >= size.getX () - PMLSize.getX ())
+        {
+          grid_coord dist = posAbs.getX () - (size.getX () - PMLSize.getX ());
+    			FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
+    			FPValue x2 = dist * gridStep;       // lower bounds for point i
 
-  			//std::cout << boundaryFactor * (pow(x1, (exponent + 1)) - pow(x2, (exponent + 1))) << std::endl;
-  			FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
+    			//std::cout << boundaryFactor * (pow(x1, (exponent + 1)) - pow(x2, (exponent + 1))) << std::endl;
+    			FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
 
 #ifdef COMPLEX_FIELD_VALUES
-  			valSigma->setCurValue (FieldValue (val, 0));
+    			valSigma = FieldValue (val, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        valSigma->setCurValue (val);
+          valSigma = val;
 #endif /* !COMPLEX_FIELD_VALUES */
-      }
+        }
 
-      SigmaX.setFieldPointValue (valSigma, pos);
+        SigmaX.setFieldValue (valSigma, pos, 0);
+      }
     }
-  }
 
-  for (int i = 0; i < SigmaY.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < SigmaY.getSize ().getY (); ++j)
+    for (int i = 0; i < SigmaY.getSize ().getX (); ++i)
     {
-      FieldPointValue* valSigma = new FieldPointValue ();
+      for (int j = 0; j < SigmaY.getSize ().getY (); ++j)
+      {
+        FieldValue valSigma (0);
 
-      GridCoordinate2D pos (i, j);
-      GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaY.getTotalPosition (pos)));
+        GridCoordinate2D pos (i, j);
+        GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaY.getTotalPosition (pos)));
 
-      GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaX.getTotalSize ()));
+        GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaX.getTotalSize ()));
 
-      /*
-       * FIXME: add layout coordinates for material: sigma, eps, etc.
-       */
-      if (posAbs.getY () < PMLSize.getY ())
-      {
-        grid_coord dist = PMLSize.getY () - posAbs.getY ();
-        FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
-        FPValue x2 = dist * gridStep;       // lower bounds for point i
+        /*
+         * FIXME: add layout coordinates for material: sigma, eps, etc.
+         */
+        if (posAbs.getY () < PMLSize.getY ())
+        {
+          grid_coord dist = PMLSize.getY () - posAbs.getY ();
+          FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
+          FPValue x2 = dist * gridStep;       // lower bounds for point i
 
-        FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
+          FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
 
 #ifdef COMPLEX_FIELD_VALUES
-  			valSigma->setCurValue (FieldValue (val, 0));
+    			valSigma = FieldValue (val, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        valSigma->setCurValue (val);
+          valSigma = val;
 #endif /* !COMPLEX_FIELD_VALUES */
-      }
-      else if (posAbs.getY () >= size.getY () - PMLSize.getY ())
-      {
-        grid_coord dist = posAbs.getY () - (size.getY () - PMLSize.getY ());
-        FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
-        FPValue x2 = dist * gridStep;       // lower bounds for point i
+        }
+        else if (posAbs.getY () >= size.getY () - PMLSize.getY ())
+        {
+          grid_coord dist = posAbs.getY () - (size.getY () - PMLSize.getY ());
+          FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
+          FPValue x2 = dist * gridStep;       // lower bounds for point i
 
-        //std::cout << boundaryFactor * (pow(x1, (exponent + 1)) - pow(x2, (exponent + 1))) << std::endl;
-        FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
+          //std::cout << boundaryFactor * (pow(x1, (exponent + 1)) - pow(x2, (exponent + 1))) << std::endl;
+          FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
 
 #ifdef COMPLEX_FIELD_VALUES
-  			valSigma->setCurValue (FieldValue (val, 0));
+    			valSigma = FieldValue (val, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        valSigma->setCurValue (val);
+          valSigma = val;
 #endif /* !COMPLEX_FIELD_VALUES */
-      }
-
-      SigmaY.setFieldPointValue (valSigma, pos);
-    }
-  }
-
-  /*
-   * FIXME: SigmaZ grid could be replaced with constant 0.0
-   */
-  for (int i = 0; i < SigmaZ.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < SigmaZ.getSize ().getY (); ++j)
-    {
-      FieldPointValue* valSigma = new FieldPointValue ();
-
-      GridCoordinate2D pos (i, j);
-
-      SigmaZ.setFieldPointValue (valSigma, pos);
-    }
-  }
-
-  if (dumpRes)
-  {
-    dumper.init (0, CURRENT, processId, "SigmaX");
-    dumper.dumpGrid (SigmaX, GridCoordinate2D (0), SigmaX.getSize ());
-
-    dumper.init (0, CURRENT, processId, "SigmaY");
-    dumper.dumpGrid (SigmaY, GridCoordinate2D (0), SigmaY.getSize ());
-
-    dumper.init (0, CURRENT, processId, "SigmaZ");
-    dumper.dumpGrid (SigmaZ, GridCoordinate2D (0), SigmaZ.getSize ());
-  }
-
-  for (int i = 0; i < Ex.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < Ex.getSize ().getY (); ++j)
-    {
-      FieldPointValue* valEx = new FieldPointValue ();
-
-      FieldPointValue* valDx = new FieldPointValue ();
-
-      FieldPointValue* valExAmp;
-      if (calculateAmplitude)
-      {
-        valExAmp = new FieldPointValue ();
-      }
-
-      GridCoordinate2D pos (i, j);
-
-      Ex.setFieldPointValue (valEx, pos);
-
-      Dx.setFieldPointValue (valDx, pos);
-
-      if (calculateAmplitude)
-      {
-        ExAmplitude.setFieldPointValue (valExAmp, pos);
-      }
-    }
-  }
-
-  for (int i = 0; i < Ey.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < Ey.getSize ().getY (); ++j)
-    {
-      FieldPointValue* valEy = new FieldPointValue ();
-
-      FieldPointValue* valDy = new FieldPointValue ();
-
-      FieldPointValue* valEyAmp;
-      if (calculateAmplitude)
-      {
-        valEyAmp = new FieldPointValue ();
-      }
-
-      GridCoordinate2D pos (i, j);
-
-      Ey.setFieldPointValue (valEy, pos);
-
-      Dy.setFieldPointValue (valDy, pos);
-
-      if (calculateAmplitude)
-      {
-        EyAmplitude.setFieldPointValue (valEyAmp, pos);
-      }
-    }
-  }
-
-  for (int i = 0; i < Hz.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < Hz.getSize ().getY (); ++j)
-    {
-      FieldPointValue* valHz = new FieldPointValue ();
-
-      FieldPointValue* valBz = new FieldPointValue ();
-
-      FieldPointValue* valHzAmp;
-      if (calculateAmplitude)
-      {
-        valHzAmp = new FieldPointValue ();
-      }
-
-      GridCoordinate2D pos (i, j);
-
-      Hz.setFieldPointValue (valHz, pos);
-
-      Bz.setFieldPointValue (valBz, pos);
+        }
 
-      if (calculateAmplitude)
-      {
-        HzAmplitude.setFieldPointValue (valHzAmp, pos);
+        SigmaY.setFieldValue (valSigma, pos, 0);
       }
     }
-  }
 
-  if (useTFSF)
-  {
-    for (grid_coord i = 0; i < EInc.getSize ().getX (); ++i)
+    /*
+     * FIXME: SigmaZ grid could be replaced with constant 0.0
+     */
+    if (dumpRes)
     {
-      FieldPointValue* valE = new FieldPointValue ();
+      dumper.init (0, CURRENT, processId, "SigmaX");
+      dumper.dumpGrid (SigmaX, GridCoordinate2D (0), SigmaX.getSize ());
 
-      GridCoordinate1D pos (i);
+      dumper.init (0, CURRENT, processId, "SigmaY");
+      dumper.dumpGrid (SigmaY, GridCoordinate2D (0), SigmaY.getSize ());
 
-      EInc.setFieldPointValue (valE, pos);
-    }
-
-    for (grid_coord i = 0; i < HInc.getSize ().getX (); ++i)
-    {
-      FieldPointValue* valH = new FieldPointValue ();
-
-      GridCoordinate1D pos (i);
-
-      HInc.setFieldPointValue (valH, pos);
+      dumper.init (0, CURRENT, processId, "SigmaZ");
+      dumper.dumpGrid (SigmaZ, GridCoordinate2D (0), SigmaZ.getSize ());
     }
   }
 
@@ -1771,9 +1660,12 @@ SchemeTEz::initGrids ()
   Eps.share ();
   Mu.share ();
 
-  SigmaX.share ();
-  SigmaY.share ();
-  SigmaZ.share ();
+  if (usePML)
+  {
+    SigmaX.share ();
+    SigmaY.share ();
+    SigmaZ.share ();
+  }
 #endif
 }
 
@@ -100,11 +100,42 @@ private:
   void performNSteps (time_step, time_step);
   void performAmplitudeSteps (time_step);
 
-  int updateAmplitude (FPValue, FieldPointValue *, FPValue *);
+  int updateAmplitude (FPValue, FieldValue *, FPValue *);
 
   void performPlaneWaveESteps (time_step);
   void performPlaneWaveHSteps (time_step);
 
+#if defined (PARALLEL_GRID)
+  /**
+   * Update of Hz in interior of its computation area, which does not read receive buffers of Ey, so it is performed
+   * while Ey is shared. Each part is a single row of interior of Hz.
+   */
+  class InteriorHStepsTask: public ShareOverlapTask
+  {
+    SchemeTEz *scheme;
+
+    time_step t;
+
+    GridCoordinate3D HzStart;
+    GridCoordinate3D HzEnd;
+
+  public:
+
+    InteriorHStepsTask (SchemeTEz *, time_step, GridCoordinate3D, GridCoordinate3D);
+
+    virtual grid_iter getNumParts () const CXX11_OVERRIDE;
+    virtual void run (grid_iter) CXX11_OVERRIDE;
+  }; /* InteriorHStepsTask */
+
+  typedef void (SchemeTEz::*StepsFunction) (time_step, GridCoordinate3D, GridCoordinate3D);
+
+  static GridCoordinate3D getInteriorStart (GridCoordinate3D, GridCoordinate3D);
+  static GridCoordinate3D getInteriorEnd (GridCoordinate3D, GridCoordinate3D);
+
+  void performBorderSteps (StepsFunction, time_step, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D,
+                           GridCoordinate3D);
+#endif /* PARALLEL_GRID */
+
 public:
 
   virtual void performSteps () CXX11_OVERRIDE;
@@ -125,20 +156,20 @@ public:
              FPValue angleIncWave = 0.0,
              bool doDumpRes = false) :
     yeeLayout (layout),
-    Ex (shrinkCoord (layout->getExSize ()), bufSize, 0, layout->getExSizeForCurNode (), layout->getExCoreSizePerNode ()),
-    Ey (shrinkCoord (layout->getEySize ()), bufSize, 0, layout->getEySizeForCurNode (), layout->getEyCoreSizePerNode ()),
-    Hz (shrinkCoord (layout->getHzSize ()), bufSize, 0, layout->getHzSizeForCurNode (), layout->getHzCoreSizePerNode ()),
-    Dx (shrinkCoord (layout->getExSize ()), bufSize, 0, layout->getExSizeForCurNode (), layout->getExCoreSizePerNode ()),
-    Dy (shrinkCoord (layout->getEySize ()), bufSize, 0, layout->getEySizeForCurNode (), layout->getEyCoreSizePerNode ()),
-    Bz (shrinkCoord (layout->getHzSize ()), bufSize, 0, layout->getHzSizeForCurNode (), layout->getHzCoreSizePerNode ()),
-    ExAmplitude (shrinkCoord (layout->getExSize ()), bufSize, 0, layout->getExSizeForCurNode (), layout->getExCoreSizePerNode ()),
-    EyAmplitude (shrinkCoord (layout->getEySize ()), bufSize, 0, layout->getEySizeForCurNode (), layout->getEyCoreSizePerNode ()),
-    HzAmplitude (shrinkCoord (layout->getHzSize ()), bufSize, 0, layout->getHzSizeForCurNode (), layout->getHzCoreSizePerNode ()),
-    Eps (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode ()),
-    Mu (shrinkCoord (layout->getMuSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getMuSizeForCurNode (), layout->getMuCoreSizePerNode ()),
-    SigmaX (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode ()),
-    SigmaY (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode ()),
-    SigmaZ (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode ()),
+    Ex (shrinkCoord (layout->getExSize ()), bufSize, 0, layout->getExSizeForCurNode (), layout->getExCoreSizePerNode (), "Ex", 2),
+    Ey (shrinkCoord (layout->getEySize ()), bufSize, 0, layout->getEySizeForCurNode (), layout->getEyCoreSizePerNode (), "Ey", 2),
+    Hz (shrinkCoord (layout->getHzSize ()), bufSize, 0, layout->getHzSizeForCurNode (), layout->getHzCoreSizePerNode (), "Hz", 2),
+    Dx (shrinkCoord (layout->getExSize ()), bufSize, 0, layout->getExSizeForCurNode (), layout->getExCoreSizePerNode (), "Dx", doUsePML ? 2 : 0),
+    Dy (shrinkCoord (layout->getEySize ()), bufSize, 0, layout->getEySizeForCurNode (), layout->getEyCoreSizePerNode (), "Dy", doUsePML ? 2 : 0),
+    Bz (shrinkCoord (layout->getHzSize ()), bufSize, 0, layout->getHzSizeForCurNode (), layout->getHzCoreSizePerNode (), "Bz", doUsePML ? 2 : 0),
+    ExAmplitude (shrinkCoord (layout->getExSize ()), bufSize, 0, layout->getExSizeForCurNode (), layout->getExCoreSizePerNode (), "ExAmp", calcAmp ? 1 : 0),
+    EyAmplitude (shrinkCoord (layout->getEySize ()), bufSize, 0, layout->getEySizeForCurNode (), layout->getEyCoreSizePerNode (), "EyAmp", calcAmp ? 1 : 0),
+    HzAmplitude (shrinkCoord (layout->getHzSize ()), bufSize, 0, layout->getHzSizeForCurNode (), layout->getHzCoreSizePerNode (), "HzAmp", calcAmp ? 1 : 0),
+    Eps (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "Eps", 1),
+    Mu (shrinkCoord (layout->getMuSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getMuSizeForCurNode (), layout->getMuCoreSizePerNode (), "Mu", 1),
+    SigmaX (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "SigmaX", doUsePML ? 1 : 0),
+    SigmaY (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "SigmaY", doUsePML ? 1 : 0),
+    SigmaZ (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "SigmaZ", doUsePML ? 1 : 0),
     sourceWaveLength (0),
     sourceFrequency (0),
     courantNum (0),
@@ -149,8 +180,8 @@ public:
     amplitudeStepLimit (ampStep),
     usePML (doUsePML),
     useTFSF (doUseTFSF),
-    EInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0),
-    HInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0),
+    EInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0, "EInc", 2),
+    HInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0, "HInc", 2),
     incidentWaveAngle (angleIncWave),
     dumpRes (doDumpRes)
 #else
@@ -164,20 +195,20 @@ public:
              FPValue angleIncWave = 0.0,
              bool doDumpRes = false) :
     yeeLayout (layout),
-    Ex (shrinkCoord (layout->getExSize ()), 0),
-    Ey (shrinkCoord (layout->getEySize ()), 0),
-    Hz (shrinkCoord (layout->getHzSize ()), 0),
-    Dx (shrinkCoord (layout->getExSize ()), 0),
-    Dy (shrinkCoord (layout->getEySize ()), 0),
-    Bz (shrinkCoord (layout->getHzSize ()), 0),
-    ExAmplitude (shrinkCoord (layout->getExSize ()), 0),
-    EyAmplitude (shrinkCoord (layout->getEySize ()), 0),
-    HzAmplitude (shrinkCoord (layout->getHzSize ()), 0),
-    Eps (shrinkCoord (layout->getEpsSize ()), 0),
-    Mu (shrinkCoord (layout->getMuSize ()), 0),
-    SigmaX (shrinkCoord (layout->getEpsSize ()), 0),
-    SigmaY (shrinkCoord (layout->getEpsSize ()), 0),
-    SigmaZ (shrinkCoord (layout->getEpsSize ()), 0),
+    Ex (shrinkCoord (layout->getExSize ()), 0, "Ex", 2),
+    Ey (shrinkCoord (layout->getEySize ()), 0, "Ey", 2),
+    Hz (shrinkCoord (layout->getHzSize ()), 0, "Hz", 2),
+    Dx (shrinkCoord (layout->getExSize ()), 0, "Dx", doUsePML ? 2 : 0),
+    Dy (shrinkCoord (layout->getEySize ()), 0, "Dy", doUsePML ? 2 : 0),
+    Bz (shrinkCoord (layout->getHzSize ()), 0, "Bz", doUsePML ? 2 : 0),
+    ExAmplitude (shrinkCoord (layout->getExSize ()), 0, "ExAmp", calcAmp ? 1 : 0),
+    EyAmplitude (shrinkCoord (layout->getEySize ()), 0, "EyAmp", calcAmp ? 1 : 0),
+    HzAmplitude (shrinkCoord (layout->getHzSize ()), 0, "HzAmp", calcAmp ? 1 : 0),
+    Eps (shrinkCoord (layout->getEpsSize ()), 0, "Eps", 1),
+    Mu (shrinkCoord (layout->getMuSize ()), 0, "Mu", 1),
+    SigmaX (shrinkCoord (layout->getEpsSize ()), 0, "SigmaX", doUsePML ? 1 : 0),
+    SigmaY (shrinkCoord (layout->getEpsSize ()), 0, "SigmaY", doUsePML ? 1 : 0),
+    SigmaZ (shrinkCoord (layout->getEpsSize ()), 0, "SigmaZ", doUsePML ? 1 : 0),
     sourceWaveLength (0),
     sourceFrequency (0),
     courantNum (0),
@@ -188,8 +219,8 @@ public:
     amplitudeStepLimit (ampStep),
     usePML (doUsePML),
     useTFSF (doUseTFSF),
-    EInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0),
-    HInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0),
+    EInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0, "EInc", 2),
+    HInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0, "HInc", 2),
     incidentWaveAngle (angleIncWave),
     dumpRes (doDumpRes)
 #endif
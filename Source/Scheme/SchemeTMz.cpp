@@ -24,14 +24,9 @@ SchemeTMz::performPlaneWaveESteps (time_step t)
   {
     GridCoordinate1D pos (i);
 
-    FieldPointValue *valE = EInc.getFieldPointValue (pos);
-
     GridCoordinate1D posLeft (i - 1);
     GridCoordinate1D posRight (i);
 
-    FieldPointValue *valH1 = HInc.getFieldPointValue (posLeft);
-    FieldPointValue *valH2 = HInc.getFieldPointValue (posRight);
-
     FPValue S = 1 / courantNum;
     FPValue stepWaveLength = PhysicsConst::SpeedOfLight / (sourceFrequency * gridStep);
     FPValue arg = PhysicsConst::Pi * S / stepWaveLength;
@@ -48,19 +43,18 @@ SchemeTMz::performPlaneWaveESteps (time_step t)
       relPhi = 1;
     }
 
-    FieldValue val = valE->getPrevValue () + (gridTimeStep / (relPhi * PhysicsConst::Eps0 * gridStep)) * (valH1->getPrevValue () - valH2->getPrevValue ());
+    FieldValue val = *EInc.getFieldValue (pos, 1) + (gridTimeStep / (relPhi * PhysicsConst::Eps0 * gridStep)) * (*HInc.getFieldValue (posLeft, 1) - *HInc.getFieldValue (posRight, 1));
 
-    valE->setCurValue (val);
+    EInc.setFieldValue (val, pos, 0);
   }
 
   GridCoordinate1D pos (0);
-  FieldPointValue *valE = EInc.getFieldPointValue (pos);
 
 #ifdef COMPLEX_FIELD_VALUES
-  valE->setCurValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
-                                 cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)));
+  EInc.setFieldValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
+                                  cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)), pos, 0);
 #else /* COMPLEX_FIELD_VALUES */
-  valE->setCurValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency));
+  EInc.setFieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency), pos, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
   EInc.nextTimeStep ();
@@ -73,14 +67,9 @@ SchemeTMz::performPlaneWaveHSteps (time_step t)
   {
     GridCoordinate1D pos (i);
 
-    FieldPointValue *valH = HInc.getFieldPointValue (pos);
-
     GridCoordinate1D posLeft (i);
     GridCoordinate1D posRight (i + 1);
 
-    FieldPointValue *valE1 = EInc.getFieldPointValue (posLeft);
-    FieldPointValue *valE2 = EInc.getFieldPointValue (posRight);
-
     FPValue S = 1 / courantNum;
     FPValue stepWaveLength = PhysicsConst::SpeedOfLight / (sourceFrequency * gridStep);
     FPValue arg = PhysicsConst::Pi * S / stepWaveLength;
@@ -97,9 +86,9 @@ SchemeTMz::performPlaneWaveHSteps (time_step t)
       relPhi = 1;
     }
 
-    FieldValue val = valH->getPrevValue () + (gridTimeStep / (relPhi * PhysicsConst::Mu0 * gridStep)) * (valE1->getPrevValue () - valE2->getPrevValue ());
+    FieldValue val = *HInc.getFieldValue (pos, 1) + (gridTimeStep / (relPhi * PhysicsConst::Mu0 * gridStep)) * (*EInc.getFieldValue (posLeft, 1) - *EInc.getFieldValue (posRight, 1));
 
-    valH->setCurValue (val);
+    HInc.setFieldValue (val, pos, 0);
   }
 
   HInc.nextTimeStep ();
@@ -121,10 +110,7 @@ SchemeTMz::approximateIncidentWave (GridCoordinateFP2D realCoord, FPValue dDiff,
   GridCoordinate1D pos1 (coordD1);
   GridCoordinate1D pos2 (coordD2);
 
-  FieldPointValue *val1 = FieldInc.getFieldPointValue (pos1);
-  FieldPointValue *val2 = FieldInc.getFieldPointValue (pos2);
-
-  return proportionD1 * val1->getPrevValue () + proportionD2 * val2->getPrevValue ();
+  return proportionD1 * *FieldInc.getFieldValue (pos1, 1) + proportionD2 * *FieldInc.getFieldValue (pos2, 1);
 }
 
 FieldValue
@@ -163,6 +149,9 @@ SchemeTMz::calculateEzStep (time_step t, GridCoordinate3D EzStart, GridCoordinat
 {
   FPValue eps0 = PhysicsConst::Eps0;
 
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (int i = EzStart.getX (); i < EzEnd.getX (); ++i)
   {
     for (int j = EzStart.getY (); j < EzEnd.getY (); ++j)
@@ -171,30 +160,23 @@ SchemeTMz::calculateEzStep (time_step t, GridCoordinate3D EzStart, GridCoordinat
       GridCoordinate2D posAbs = Ez.getTotalPosition (pos);
       GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getEzCoordFP (posAbs));
 
-      FieldPointValue* valEz = Ez.getFieldPointValue (pos);
-
       GridCoordinate2D posLeft = shrinkCoord (yeeLayout->getEzCircuitElement (GridCoordinate3D (pos), LayoutDirection::LEFT));
       GridCoordinate2D posRight = shrinkCoord (yeeLayout->getEzCircuitElement (GridCoordinate3D (pos), LayoutDirection::RIGHT));
       GridCoordinate2D posDown = shrinkCoord (yeeLayout->getEzCircuitElement (GridCoordinate3D (pos), LayoutDirection::DOWN));
       GridCoordinate2D posUp = shrinkCoord (yeeLayout->getEzCircuitElement (GridCoordinate3D (pos), LayoutDirection::UP));
 
-      FieldPointValue* valEps = Eps.getFieldPointValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valEps = Eps.getFieldValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue eps = valEps->getCurValue ().real ();
+      FPValue eps = valEps->real ();
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue eps = valEps->getCurValue ();
+      FPValue eps = *valEps;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      FieldPointValue* valHy1 = Hy.getFieldPointValue (posRight);
-      FieldPointValue* valHy2 = Hy.getFieldPointValue (posLeft);
-      FieldPointValue* valHx1 = Hx.getFieldPointValue (posUp);
-      FieldPointValue* valHx2 = Hx.getFieldPointValue (posDown);
-
-      FieldValue prevHx1 = valHx1->getPrevValue ();
-      FieldValue prevHx2 = valHx2->getPrevValue ();
-      FieldValue prevHy1 = valHy1->getPrevValue ();
-      FieldValue prevHy2 = valHy2->getPrevValue ();
+      FieldValue prevHx1 = *Hx.getFieldValue (posUp, 1);
+      FieldValue prevHx2 = *Hx.getFieldValue (posDown, 1);
+      FieldValue prevHy1 = *Hy.getFieldValue (posRight, 1);
+      FieldValue prevHy2 = *Hy.getFieldValue (posLeft, 1);
 
       if (useTFSF)
       {
@@ -242,10 +224,7 @@ SchemeTMz::calculateEzStep (time_step t, GridCoordinate3D EzStart, GridCoordinat
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valH1 = HInc.getFieldPointValue (pos1);
-          FieldPointValue *valH2 = HInc.getFieldPointValue (pos2);
-
-          diffX = proportionD1 * valH1->getPrevValue () + proportionD2 * valH2->getPrevValue ();
+          diffX = proportionD1 * *HInc.getFieldValue (pos1, 1) + proportionD2 * *HInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_down || do_need_update_up)
@@ -264,10 +243,7 @@ SchemeTMz::calculateEzStep (time_step t, GridCoordinate3D EzStart, GridCoordinat
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valH1 = HInc.getFieldPointValue (pos1);
-          FieldPointValue *valH2 = HInc.getFieldPointValue (pos2);
-
-          diffY = proportionD1 * valH1->getPrevValue () + proportionD2 * valH2->getPrevValue ();
+          diffY = proportionD1 * *HInc.getFieldValue (pos1, 1) + proportionD2 * *HInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_left)
@@ -289,7 +265,7 @@ SchemeTMz::calculateEzStep (time_step t, GridCoordinate3D EzStart, GridCoordinat
         }
       }
 
-      FieldValue val = calculateEz_3D (valEz->getPrevValue (),
+      FieldValue val = calculateEz_3D (*Ez.getFieldValue (pos, 1),
                                        prevHy1,
                                        prevHy2,
                                        prevHx1,
@@ -298,7 +274,7 @@ SchemeTMz::calculateEzStep (time_step t, GridCoordinate3D EzStart, GridCoordinat
                                        gridStep,
                                        eps * eps0);
 
-      valEz->setCurValue (val);
+      Ez.setFieldValue (val, pos, 0);
     }
   }
 }
@@ -308,6 +284,13 @@ SchemeTMz::calculateEzStepPML (time_step t, GridCoordinate3D EzStart, GridCoordi
 {
   FPValue eps0 = PhysicsConst::Eps0;
 
+  /*
+   * Dz, D1z and Ez of each cell are updated in a single pass, so values of cell are reused while they are in
+   * registers
+   */
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (int i = EzStart.getX (); i < EzEnd.getX (); ++i)
   {
     for (int j = EzStart.getY (); j < EzEnd.getY (); ++j)
@@ -316,30 +299,23 @@ SchemeTMz::calculateEzStepPML (time_step t, GridCoordinate3D EzStart, GridCoordi
       GridCoordinate2D posAbs = Ez.getTotalPosition (pos);
       GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getEzCoordFP (posAbs));
 
-      FieldPointValue* valDz = Dz.getFieldPointValue (pos);
-
       GridCoordinate2D posLeft = shrinkCoord (yeeLayout->getEzCircuitElement (GridCoordinate3D (pos), LayoutDirection::LEFT));
       GridCoordinate2D posRight = shrinkCoord (yeeLayout->getEzCircuitElement (GridCoordinate3D (pos), LayoutDirection::RIGHT));
       GridCoordinate2D posDown = shrinkCoord (yeeLayout->getEzCircuitElement (GridCoordinate3D (pos), LayoutDirection::DOWN));
       GridCoordinate2D posUp = shrinkCoord (yeeLayout->getEzCircuitElement (GridCoordinate3D (pos), LayoutDirection::UP));
 
-      FieldPointValue* valSigmaX = SigmaX.getFieldPointValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valSigmaX = SigmaX.getFieldValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue sigmaX = valSigmaX->getCurValue ().real ();
+      FPValue sigmaX = valSigmaX->real ();
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue sigmaX = valSigmaX->getCurValue ();
+      FPValue sigmaX = *valSigmaX;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      FieldPointValue* valHy1 = Hy.getFieldPointValue (posRight);
-      FieldPointValue* valHy2 = Hy.getFieldPointValue (posLeft);
-      FieldPointValue* valHx1 = Hx.getFieldPointValue (posUp);
-      FieldPointValue* valHx2 = Hx.getFieldPointValue (posDown);
-
-      FieldValue prevHx1 = valHx1->getPrevValue ();
-      FieldValue prevHx2 = valHx2->getPrevValue ();
-      FieldValue prevHy1 = valHy1->getPrevValue ();
-      FieldValue prevHy2 = valHy2->getPrevValue ();
+      FieldValue prevHx1 = *Hx.getFieldValue (posUp, 1);
+      FieldValue prevHx2 = *Hx.getFieldValue (posDown, 1);
+      FieldValue prevHy1 = *Hy.getFieldValue (posRight, 1);
+      FieldValue prevHy2 = *Hy.getFieldValue (posLeft, 1);
 
       if (useTFSF)
       {
@@ -387,10 +363,7 @@ SchemeTMz::calculateEzStepPML (time_step t, GridCoordinate3D EzStart, GridCoordi
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valH1 = HInc.getFieldPointValue (pos1);
-          FieldPointValue *valH2 = HInc.getFieldPointValue (pos2);
-
-          diffX = proportionD1 * valH1->getPrevValue () + proportionD2 * valH2->getPrevValue ();
+          diffX = proportionD1 * *HInc.getFieldValue (pos1, 1) + proportionD2 * *HInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_down || do_need_update_up)
@@ -409,10 +382,7 @@ SchemeTMz::calculateEzStepPML (time_step t, GridCoordinate3D EzStart, GridCoordi
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valH1 = HInc.getFieldPointValue (pos1);
-          FieldPointValue *valH2 = HInc.getFieldPointValue (pos2);
-
-          diffY = proportionD1 * valH1->getPrevValue () + proportionD2 * valH2->getPrevValue ();
+          diffY = proportionD1 * *HInc.getFieldValue (pos1, 1) + proportionD2 * *HInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_left)
@@ -439,49 +409,38 @@ SchemeTMz::calculateEzStepPML (time_step t, GridCoordinate3D EzStart, GridCoordi
        */
       FPValue k_x = 1;
 
-      FPValue Ca = (2 * eps0 * k_x - sigmaX * gridTimeStep) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
-      FPValue Cb = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
+      FPValue CaDz = (2 * eps0 * k_x - sigmaX * gridTimeStep) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
+      FPValue CbDz = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
 
-      FieldValue val = calculateEz_3D_Precalc (valDz->getPrevValue (),
-                                               prevHy1,
-                                               prevHy2,
-                                               prevHx1,
-                                               prevHx2,
-                                               Ca,
-                                               Cb);
+      FieldValue valDz = calculateEz_3D_Precalc (*Dz.getFieldValue (pos, 1),
+                                                 prevHy1,
+                                                 prevHy2,
+                                                 prevHx1,
+                                                 prevHx2,
+                                                 CaDz,
+                                                 CbDz);
 
-      valDz->setCurValue (val);
-    }
-  }
+      Dz.setFieldValue (valDz, pos, 0);
 
-  if (useMetamaterials)
-  {
-    for (int i = EzStart.getX (); i < EzEnd.getX (); ++i)
-    {
-      for (int j = EzStart.getY (); j < EzEnd.getY (); ++j)
-      {
-        GridCoordinate2D pos (i, j);
-        GridCoordinate2D posAbs = Ez.getTotalPosition (pos);
-        GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getEzCoordFP (posAbs));
-
-        FieldPointValue* valD1z = D1z.getFieldPointValue (pos);
-        FieldPointValue* valDz = Dz.getFieldPointValue (pos);
+      FieldValue prevValDz = *Dz.getFieldValue (pos, 1);
 
-        FieldPointValue* valOmegaPE = OmegaPE.getFieldPointValue (OmegaPE.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-        FieldPointValue* valGammaE = GammaE.getFieldPointValue (GammaE.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      if (useMetamaterials)
+      {
+        FieldValue *valOmegaPE = OmegaPE.getFieldValue (OmegaPE.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+        FieldValue *valGammaE = GammaE.getFieldValue (GammaE.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
-        FieldPointValue* valEps = Eps.getFieldPointValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+        FieldValue *valEps = Eps.getFieldValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-        FPValue eps = valEps->getCurValue ().real ();
+        FPValue eps = valEps->real ();
 
-        FPValue omegaPE = valOmegaPE->getCurValue ().real ();
-        FPValue gammaE = valGammaE->getCurValue ().real ();
+        FPValue omegaPE = valOmegaPE->real ();
+        FPValue gammaE = valGammaE->real ();
 #else /* COMPLEX_FIELD_VALUES */
-        FPValue eps = valEps->getCurValue ();
+        FPValue eps = *valEps;
 
-        FPValue omegaPE = valOmegaPE->getCurValue ();
-        FPValue gammaE = valGammaE->getCurValue ();
+        FPValue omegaPE = *valOmegaPE;
+        FPValue gammaE = *valGammaE;
 #endif /* !COMPLEX_FIELD_VALUES */
 
         /*
@@ -489,56 +448,37 @@ SchemeTMz::calculateEzStepPML (time_step t, GridCoordinate3D EzStart, GridCoordi
          */
         FPValue A = 4*eps0*eps + 2*gridTimeStep*eps0*eps*gammaE + eps0*gridTimeStep*gridTimeStep*omegaPE*omegaPE;
 
-        FieldValue val = calculateDrudeE (valDz->getCurValue (),
-                                          valDz->getPrevValue (),
-                                          valDz->getPrevPrevValue (),
-                                          valD1z->getPrevValue (),
-                                          valD1z->getPrevPrevValue (),
-                                          (4 + 2*gridTimeStep*gammaE) / A,
-                                          -8 / A,
-                                          (4 - 2*gridTimeStep*gammaE) / A,
-                                          (2*eps0*gridTimeStep*gridTimeStep*omegaPE*omegaPE - 8*eps0*eps) / A,
-                                          (4*eps0*eps - 2*gridTimeStep*eps0*eps*gammaE + eps0*gridTimeStep*gridTimeStep*omegaPE*omegaPE) / A);
-
-        valD1z->setCurValue (val);
+        FieldValue valD1z = calculateDrudeE (valDz,
+                                             prevValDz,
+                                             *Dz.getFieldValue (pos, 2),
+                                             *D1z.getFieldValue (pos, 1),
+                                             *D1z.getFieldValue (pos, 2),
+                                             (4 + 2*gridTimeStep*gammaE) / A,
+                                             -8 / A,
+                                             (4 - 2*gridTimeStep*gammaE) / A,
+                                             (2*eps0*gridTimeStep*gridTimeStep*omegaPE*omegaPE - 8*eps0*eps) / A,
+                                             (4*eps0*eps - 2*gridTimeStep*eps0*eps*gammaE + eps0*gridTimeStep*gridTimeStep*omegaPE*omegaPE) / A);
+
+        D1z.setFieldValue (valD1z, pos, 0);
+
+        valDz = valD1z;
+        prevValDz = *D1z.getFieldValue (pos, 1);
       }
-    }
-  }
 
-  for (int i = EzStart.getX (); i < EzEnd.getX (); ++i)
-  {
-    for (int j = EzStart.getY (); j < EzEnd.getY (); ++j)
-    {
-      GridCoordinate2D pos (i, j);
-      GridCoordinate2D posAbs = Ez.getTotalPosition (pos);
-      GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getEzCoordFP (posAbs));
-
-      FieldPointValue* valEz = Ez.getFieldPointValue (pos);
-      FieldPointValue* valDz;
-
-      if (useMetamaterials)
-      {
-        valDz = D1z.getFieldPointValue (pos);
-      }
-      else
-      {
-        valDz = Dz.getFieldPointValue (pos);
-      }
-
-      FieldPointValue* valSigmaY = SigmaY.getFieldPointValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaZ = SigmaZ.getFieldPointValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valEps = Eps.getFieldPointValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valSigmaY = SigmaY.getFieldValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaZ = SigmaZ.getFieldValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valEps = Eps.getFieldValue (Eps.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue eps = valEps->getCurValue ().real ();
+      FPValue eps = valEps->real ();
 
-      FPValue sigmaY = valSigmaY->getCurValue ().real ();
-      FPValue sigmaZ = valSigmaZ->getCurValue ().real ();
+      FPValue sigmaY = valSigmaY->real ();
+      FPValue sigmaZ = valSigmaZ->real ();
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue eps = valEps->getCurValue ();
+      FPValue eps = *valEps;
 
-      FPValue sigmaY = valSigmaY->getCurValue ();
-      FPValue sigmaZ = valSigmaZ->getCurValue ();
+      FPValue sigmaY = *valSigmaY;
+      FPValue sigmaZ = *valSigmaZ;
 #endif /* !COMPLEX_FIELD_VALUES */
 
       FPValue modifier = eps * eps0;
@@ -557,14 +497,14 @@ SchemeTMz::calculateEzStepPML (time_step t, GridCoordinate3D EzStart, GridCoordi
       FPValue Cb = ((2 * eps0 * k_z + sigmaZ * gridTimeStep) / (modifier)) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
       FPValue Cc = ((2 * eps0 * k_z - sigmaZ * gridTimeStep) / (modifier)) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
 
-      FieldValue val = calculateEz_from_Dz_Precalc (valEz->getPrevValue (),
-                                                    valDz->getCurValue (),
-                                                    valDz->getPrevValue (),
+      FieldValue val = calculateEz_from_Dz_Precalc (*Ez.getFieldValue (pos, 1),
+                                                    valDz,
+                                                    prevValDz,
                                                     Ca,
                                                     Cb,
                                                     Cc);
 
-      valEz->setCurValue (val);
+      Ez.setFieldValue (val, pos, 0);
     }
   }
 }
@@ -590,6 +530,9 @@ SchemeTMz::calculateHxStep (time_step t, GridCoordinate3D HxStart, GridCoordinat
 {
   FPValue mu0 = PhysicsConst::Mu0;
 
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (int i = HxStart.getX (); i < HxEnd.getX (); ++i)
   {
     for (int j = HxStart.getY (); j < HxEnd.getY (); ++j)
@@ -598,25 +541,20 @@ SchemeTMz::calculateHxStep (time_step t, GridCoordinate3D HxStart, GridCoordinat
       GridCoordinate2D posAbs = Hx.getTotalPosition (pos);
       GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getHxCoordFP (posAbs));
 
-      FieldPointValue* valHx = Hx.getFieldPointValue (pos);
-
       GridCoordinate2D posDown = shrinkCoord (yeeLayout->getHxCircuitElement (pos, LayoutDirection::DOWN));
       GridCoordinate2D posUp = shrinkCoord (yeeLayout->getHxCircuitElement (pos, LayoutDirection::UP));
 
-      FieldPointValue* valMu1 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valMu2 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valMu1 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valMu2 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue mu = (valMu1->getCurValue ().real () + valMu2->getCurValue ().real ()) / 2;
+      FPValue mu = (valMu1->real () + valMu2->real ()) / 2;
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue mu = (valMu1->getCurValue () + valMu2->getCurValue ()) / 2;
+      FPValue mu = (*valMu1 + *valMu2) / 2;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      FieldPointValue* valEz1 = Ez.getFieldPointValue (posUp);
-      FieldPointValue* valEz2 = Ez.getFieldPointValue (posDown);
-
-      FieldValue prevEz1 = valEz1->getPrevValue ();
-      FieldValue prevEz2 = valEz2->getPrevValue ();
+      FieldValue prevEz1 = *Ez.getFieldValue (posUp, 1);
+      FieldValue prevEz2 = *Ez.getFieldValue (posDown, 1);
 
       if (useTFSF)
       {
@@ -651,10 +589,7 @@ SchemeTMz::calculateHxStep (time_step t, GridCoordinate3D HxStart, GridCoordinat
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valE1 = EInc.getFieldPointValue (pos1);
-          FieldPointValue *valE2 = EInc.getFieldPointValue (pos2);
-
-          diff = proportionD1 * valE1->getPrevValue () + proportionD2 * valE2->getPrevValue ();
+          diff = proportionD1 * *EInc.getFieldValue (pos1, 1) + proportionD2 * *EInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_down)
@@ -667,14 +602,14 @@ SchemeTMz::calculateHxStep (time_step t, GridCoordinate3D HxStart, GridCoordinat
         }
       }
 
-      FieldValue val = calculateHx_2D_TMz (valHx->getPrevValue (),
+      FieldValue val = calculateHx_2D_TMz (*Hx.getFieldValue (pos, 1),
                                            prevEz1,
                                            prevEz2,
                                            gridTimeStep,
                                            gridStep,
                                            mu * mu0);
 
-      valHx->setCurValue (val);
+      Hx.setFieldValue (val, pos, 0);
     }
   }
 }
@@ -685,6 +620,13 @@ SchemeTMz::calculateHxStepPML (time_step t, GridCoordinate3D HxStart, GridCoordi
   FPValue eps0 = PhysicsConst::Eps0;
   FPValue mu0 = PhysicsConst::Mu0;
 
+  /*
+   * Bx, B1x and Hx of each cell are updated in a single pass, so values of cell are reused while they are in
+   * registers
+   */
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (int i = HxStart.getX (); i < HxEnd.getX (); ++i)
   {
     for (int j = HxStart.getY (); j < HxEnd.getY (); ++j)
@@ -693,25 +635,20 @@ SchemeTMz::calculateHxStepPML (time_step t, GridCoordinate3D HxStart, GridCoordi
       GridCoordinate2D posAbs = Hx.getTotalPosition (pos);
       GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getHxCoordFP (posAbs));
 
-      FieldPointValue* valBx = Bx.getFieldPointValue (pos);
-
       GridCoordinate2D posDown = shrinkCoord (yeeLayout->getHxCircuitElement (pos, LayoutDirection::DOWN));
       GridCoordinate2D posUp = shrinkCoord (yeeLayout->getHxCircuitElement (pos, LayoutDirection::UP));
 
-      FieldPointValue* valSigmaY1 = SigmaY.getFieldPointValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaY2 = SigmaY.getFieldPointValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valSigmaY1 = SigmaY.getFieldValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaY2 = SigmaY.getFieldValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue sigmaY = (valSigmaY1->getCurValue ().real () + valSigmaY2->getCurValue ().real ()) / 2;
+      FPValue sigmaY = (valSigmaY1->real () + valSigmaY2->real ()) / 2;
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue sigmaY = (valSigmaY1->getCurValue () + valSigmaY2->getCurValue ()) / 2;
+      FPValue sigmaY = (*valSigmaY1 + *valSigmaY2) / 2;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      FieldPointValue* valEz1 = Ez.getFieldPointValue (posUp);
-      FieldPointValue* valEz2 = Ez.getFieldPointValue (posDown);
-
-      FieldValue prevEz1 = valEz1->getPrevValue ();
-      FieldValue prevEz2 = valEz2->getPrevValue ();
+      FieldValue prevEz1 = *Ez.getFieldValue (posUp, 1);
+      FieldValue prevEz2 = *Ez.getFieldValue (posDown, 1);
 
       if (useTFSF)
       {
@@ -746,10 +683,7 @@ SchemeTMz::calculateHxStepPML (time_step t, GridCoordinate3D HxStart, GridCoordi
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valE1 = EInc.getFieldPointValue (pos1);
-          FieldPointValue *valE2 = EInc.getFieldPointValue (pos2);
-
-          diff = proportionD1 * valE1->getPrevValue () + proportionD2 * valE2->getPrevValue ();
+          diff = proportionD1 * *EInc.getFieldValue (pos1, 1) + proportionD2 * *EInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_down)
@@ -767,39 +701,28 @@ SchemeTMz::calculateHxStepPML (time_step t, GridCoordinate3D HxStart, GridCoordi
        */
       FPValue k_y = 1;
 
-      FPValue Ca = (2 * eps0 * k_y - sigmaY * gridTimeStep) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
-      FPValue Cb = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
+      FPValue CaBx = (2 * eps0 * k_y - sigmaY * gridTimeStep) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
+      FPValue CbBx = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_y + sigmaY * gridTimeStep);
 
-      FieldValue val = calculateHx_2D_TMz_Precalc (valBx->getPrevValue (),
-                                                   prevEz1,
-                                                   prevEz2,
-                                                   Ca,
-                                                   Cb);
+      FieldValue valBx = calculateHx_2D_TMz_Precalc (*Bx.getFieldValue (pos, 1),
+                                                     prevEz1,
+                                                     prevEz2,
+                                                     CaBx,
+                                                     CbBx);
 
-      valBx->setCurValue (val);
-    }
-  }
+      Bx.setFieldValue (valBx, pos, 0);
 
-  if (useMetamaterials)
-  {
-    for (int i = HxStart.getX (); i < HxEnd.getX (); ++i)
-    {
-      for (int j = HxStart.getY (); j < HxEnd.getY (); ++j)
-      {
-        GridCoordinate2D pos (i, j);
-        GridCoordinate2D posAbs = Hx.getTotalPosition (pos);
-        GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getHxCoordFP (posAbs));
-
-        FieldPointValue* valB1x = B1x.getFieldPointValue (pos);
-        FieldPointValue* valBx = Bx.getFieldPointValue (pos);
+      FieldValue prevValBx = *Bx.getFieldValue (pos, 1);
 
-        FieldPointValue* valOmegaPM1 = OmegaPM.getFieldPointValue (OmegaPM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-        FieldPointValue* valOmegaPM2 = OmegaPM.getFieldPointValue (OmegaPM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-        FieldPointValue* valGammaM1 = GammaM.getFieldPointValue (GammaM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-        FieldPointValue* valGammaM2 = GammaM.getFieldPointValue (GammaM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      if (useMetamaterials)
+      {
+        FieldValue *valOmegaPM1 = OmegaPM.getFieldValue (OmegaPM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+        FieldValue *valOmegaPM2 = OmegaPM.getFieldValue (OmegaPM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+        FieldValue *valGammaM1 = GammaM.getFieldValue (GammaM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+        FieldValue *valGammaM2 = GammaM.getFieldValue (GammaM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
-        FieldPointValue* valMu1 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-        FieldPointValue* valMu2 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
+        FieldValue *valMu1 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+        FieldValue *valMu2 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
         FPValue omegaPM;
         FPValue gammaM;
@@ -807,21 +730,21 @@ SchemeTMz::calculateHxStepPML (time_step t, GridCoordinate3D HxStart, GridCoordi
         FPValue dividerGamma = 0;
 
 #ifdef COMPLEX_FIELD_VALUES
-        FPValue mu = (valMu1->getCurValue ().real () + valMu2->getCurValue ().real ()) / 2;
+        FPValue mu = (valMu1->real () + valMu2->real ()) / 2;
 
-        FPValue omegaPM1 = valOmegaPM1->getCurValue ().real ();
-        FPValue omegaPM2 = valOmegaPM2->getCurValue ().real ();
+        FPValue omegaPM1 = valOmegaPM1->real ();
+        FPValue omegaPM2 = valOmegaPM2->real ();
 
-        FPValue gammaM1 = valGammaM1->getCurValue ().real ();
-        FPValue gammaM2 = valGammaM2->getCurValue ().real ();
+        FPValue gammaM1 = valGammaM1->real ();
+        FPValue gammaM2 = valGammaM2->real ();
 #else /* COMPLEX_FIELD_VALUES */
-        FPValue mu = (valMu1->getCurValue () + valMu2->getCurValue ()) / 2;
+        FPValue mu = (*valMu1 + *valMu2) / 2;
 
-        FPValue omegaPM1 = valOmegaPM1->getCurValue ();
-        FPValue omegaPM2 = valOmegaPM2->getCurValue ();
+        FPValue omegaPM1 = *valOmegaPM1;
+        FPValue omegaPM2 = *valOmegaPM2;
 
-        FPValue gammaM1 = valGammaM1->getCurValue ();
-        FPValue gammaM2 = valGammaM2->getCurValue ();
+        FPValue gammaM1 = *valGammaM1;
+        FPValue gammaM2 = *valGammaM2;
 #endif /* !COMPLEX_FIELD_VALUES */
 
         if (omegaPM1 == 0
@@ -853,61 +776,42 @@ SchemeTMz::calculateHxStepPML (time_step t, GridCoordinate3D HxStart, GridCoordi
          */
         FPValue C = 4*mu0*mu + 2*gridTimeStep*mu0*mu*gammaM + mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM;
 
-        FieldValue val = calculateDrudeH (valBx->getCurValue (),
-                                          valBx->getPrevValue (),
-                                          valBx->getPrevPrevValue (),
-                                          valB1x->getPrevValue (),
-                                          valB1x->getPrevPrevValue (),
-                                          (4 + 2*gridTimeStep*gammaM) / C,
-                                          -8 / C,
-                                          (4 - 2*gridTimeStep*gammaM) / C,
-                                          (2*mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM - 8*mu0*mu) / C,
-                                          (4*mu0*mu - 2*gridTimeStep*mu0*mu*gammaM + mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM) / C);
-
-        valB1x->setCurValue (val);
-      }
-    }
-  }
-
-  for (int i = HxStart.getX (); i < HxEnd.getX (); ++i)
-  {
-    for (int j = HxStart.getY (); j < HxEnd.getY (); ++j)
-    {
-      GridCoordinate2D pos (i, j);
-      GridCoordinate2D posAbs = Hx.getTotalPosition (pos);
-      GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getHxCoordFP (posAbs));
-
-      FieldPointValue* valHx = Hx.getFieldPointValue (pos);
-      FieldPointValue* valBx;
-
-      if (useMetamaterials)
-      {
-        valBx = B1x.getFieldPointValue (pos);
-      }
-      else
-      {
-        valBx = Bx.getFieldPointValue (pos);
+        FieldValue valB1x = calculateDrudeH (valBx,
+                                             prevValBx,
+                                             *Bx.getFieldValue (pos, 2),
+                                             *B1x.getFieldValue (pos, 1),
+                                             *B1x.getFieldValue (pos, 2),
+                                             (4 + 2*gridTimeStep*gammaM) / C,
+                                             -8 / C,
+                                             (4 - 2*gridTimeStep*gammaM) / C,
+                                             (2*mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM - 8*mu0*mu) / C,
+                                             (4*mu0*mu - 2*gridTimeStep*mu0*mu*gammaM + mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM) / C);
+
+        B1x.setFieldValue (valB1x, pos, 0);
+
+        valBx = valB1x;
+        prevValBx = *B1x.getFieldValue (pos, 1);
       }
 
-      FieldPointValue* valSigmaX1 = SigmaX.getFieldPointValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaX2 = SigmaX.getFieldPointValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valSigmaX1 = SigmaX.getFieldValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaX2 = SigmaX.getFieldValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
-      FieldPointValue* valSigmaZ1 = SigmaZ.getFieldPointValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaZ2 = SigmaZ.getFieldPointValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valSigmaZ1 = SigmaZ.getFieldValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaZ2 = SigmaZ.getFieldValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
-      FieldPointValue* valMu1 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valMu2 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valMu1 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () + 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valMu2 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX (), realCoord.getY () - 0.5, yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue mu = (valMu1->getCurValue ().real () + valMu2->getCurValue ().real ()) / 2;
+      FPValue mu = (valMu1->real () + valMu2->real ()) / 2;
 
-      FPValue sigmaX = (valSigmaX1->getCurValue ().real () + valSigmaX2->getCurValue ().real ()) / 2;
-      FPValue sigmaZ = (valSigmaZ1->getCurValue ().real () + valSigmaZ2->getCurValue ().real ()) / 2;
+      FPValue sigmaX = (valSigmaX1->real () + valSigmaX2->real ()) / 2;
+      FPValue sigmaZ = (valSigmaZ1->real () + valSigmaZ2->real ()) / 2;
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue mu = (valMu1->getCurValue () + valMu2->getCurValue ()) / 2;
+      FPValue mu = (*valMu1 + *valMu2) / 2;
 
-      FPValue sigmaX = (valSigmaX1->getCurValue () + valSigmaX2->getCurValue ()) / 2;
-      FPValue sigmaZ = (valSigmaZ1->getCurValue () + valSigmaZ2->getCurValue ()) / 2;
+      FPValue sigmaX = (*valSigmaX1 + *valSigmaX2) / 2;
+      FPValue sigmaZ = (*valSigmaZ1 + *valSigmaZ2) / 2;
 #endif /* !COMPLEX_FIELD_VALUES */
 
       FPValue modifier = mu * mu0;
@@ -926,14 +830,14 @@ SchemeTMz::calculateHxStepPML (time_step t, GridCoordinate3D HxStart, GridCoordi
       FPValue Cb = ((2 * eps0 * k_x + sigmaX * gridTimeStep) / (modifier)) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
       FPValue Cc = ((2 * eps0 * k_x - sigmaX * gridTimeStep) / (modifier)) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
 
-      FieldValue val = calculateHx_from_Bx_Precalc (valHx->getPrevValue (),
-                                                    valBx->getCurValue (),
-                                                    valBx->getPrevValue (),
+      FieldValue val = calculateHx_from_Bx_Precalc (*Hx.getFieldValue (pos, 1),
+                                                    valBx,
+                                                    prevValBx,
                                                     Ca,
                                                     Cb,
                                                     Cc);
 
-      valHx->setCurValue (val);
+      Hx.setFieldValue (val, pos, 0);
     }
   }
 }
@@ -959,6 +863,9 @@ SchemeTMz::calculateHyStep (time_step t, GridCoordinate3D HyStart, GridCoordinat
 {
   FPValue mu0 = PhysicsConst::Mu0;
 
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (int i = HyStart.getX (); i < HyEnd.getX (); ++i)
   {
     for (int j = HyStart.getY (); j < HyEnd.getY (); ++j)
@@ -967,25 +874,20 @@ SchemeTMz::calculateHyStep (time_step t, GridCoordinate3D HyStart, GridCoordinat
       GridCoordinate2D posAbs = Hy.getTotalPosition (pos);
       GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getHyCoordFP (posAbs));
 
-      FieldPointValue* valHy = Hy.getFieldPointValue (pos);
-
       GridCoordinate2D posLeft = shrinkCoord (yeeLayout->getHyCircuitElement (pos, LayoutDirection::LEFT));
       GridCoordinate2D posRight = shrinkCoord (yeeLayout->getHyCircuitElement (pos, LayoutDirection::RIGHT));
 
-      FieldPointValue* valMu1 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valMu2 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valMu1 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valMu2 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue mu = (valMu1->getCurValue ().real () + valMu2->getCurValue ().real ()) / 2;
+      FPValue mu = (valMu1->real () + valMu2->real ()) / 2;
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue mu = (valMu1->getCurValue () + valMu2->getCurValue ()) / 2;
+      FPValue mu = (*valMu1 + *valMu2) / 2;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      FieldPointValue* valEz1 = Ez.getFieldPointValue (posRight);
-      FieldPointValue* valEz2 = Ez.getFieldPointValue (posLeft);
-
-      FieldValue prevEz1 = valEz1->getPrevValue ();
-      FieldValue prevEz2 = valEz2->getPrevValue ();
+      FieldValue prevEz1 = *Ez.getFieldValue (posRight, 1);
+      FieldValue prevEz2 = *Ez.getFieldValue (posLeft, 1);
 
       if (useTFSF)
       {
@@ -1020,10 +922,7 @@ SchemeTMz::calculateHyStep (time_step t, GridCoordinate3D HyStart, GridCoordinat
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valE1 = EInc.getFieldPointValue (pos1);
-          FieldPointValue *valE2 = EInc.getFieldPointValue (pos2);
-
-          diff = proportionD1 * valE1->getPrevValue () + proportionD2 * valE2->getPrevValue ();
+          diff = proportionD1 * *EInc.getFieldValue (pos1, 1) + proportionD2 * *EInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_left)
@@ -1036,14 +935,14 @@ SchemeTMz::calculateHyStep (time_step t, GridCoordinate3D HyStart, GridCoordinat
         }
       }
 
-      FieldValue val = calculateHy_2D_TMz (valHy->getPrevValue (),
+      FieldValue val = calculateHy_2D_TMz (*Hy.getFieldValue (pos, 1),
                                            prevEz1,
                                            prevEz2,
                                            gridTimeStep,
                                            gridStep,
                                            mu * mu0);
 
-      valHy->setCurValue (val);
+      Hy.setFieldValue (val, pos, 0);
     }
   }
 }
@@ -1054,6 +953,13 @@ SchemeTMz::calculateHyStepPML (time_step t, GridCoordinate3D HyStart, GridCoordi
   FPValue eps0 = PhysicsConst::Eps0;
   FPValue mu0 = PhysicsConst::Mu0;
 
+  /*
+   * By, B1y and Hy of each cell are updated in a single pass, so values of cell are reused while they are in
+   * registers
+   */
+#ifdef OPENMP_ENABLED
+  #pragma omp parallel for collapse (2)
+#endif /* OPENMP_ENABLED */
   for (int i = HyStart.getX (); i < HyEnd.getX (); ++i)
   {
     for (int j = HyStart.getY (); j < HyEnd.getY (); ++j)
@@ -1062,25 +968,20 @@ SchemeTMz::calculateHyStepPML (time_step t, GridCoordinate3D HyStart, GridCoordi
       GridCoordinate2D posAbs = Hy.getTotalPosition (pos);
       GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getHyCoordFP (posAbs));
 
-      FieldPointValue* valBy = By.getFieldPointValue (pos);
-
       GridCoordinate2D posLeft = shrinkCoord (yeeLayout->getHyCircuitElement (pos, LayoutDirection::LEFT));
       GridCoordinate2D posRight = shrinkCoord (yeeLayout->getHyCircuitElement (pos, LayoutDirection::RIGHT));
 
-      FieldPointValue* valSigmaZ1 = SigmaZ.getFieldPointValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaZ2 = SigmaZ.getFieldPointValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valSigmaZ1 = SigmaZ.getFieldValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaZ2 = SigmaZ.getFieldValue (SigmaZ.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue sigmaZ = (valSigmaZ1->getCurValue ().real () + valSigmaZ2->getCurValue ().real ()) / 2;
+      FPValue sigmaZ = (valSigmaZ1->real () + valSigmaZ2->real ()) / 2;
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue sigmaZ = (valSigmaZ1->getCurValue () + valSigmaZ2->getCurValue ()) / 2;
+      FPValue sigmaZ = (*valSigmaZ1 + *valSigmaZ2) / 2;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      FieldPointValue* valEz1 = Ez.getFieldPointValue (posRight);
-      FieldPointValue* valEz2 = Ez.getFieldPointValue (posLeft);
-
-      FieldValue prevEz1 = valEz1->getPrevValue ();
-      FieldValue prevEz2 = valEz2->getPrevValue ();
+      FieldValue prevEz1 = *Ez.getFieldValue (posRight, 1);
+      FieldValue prevEz2 = *Ez.getFieldValue (posLeft, 1);
 
       if (useTFSF)
       {
@@ -1115,10 +1016,7 @@ SchemeTMz::calculateHyStepPML (time_step t, GridCoordinate3D HyStart, GridCoordi
           GridCoordinate1D pos1 (coordD1);
           GridCoordinate1D pos2 (coordD2);
 
-          FieldPointValue *valE1 = EInc.getFieldPointValue (pos1);
-          FieldPointValue *valE2 = EInc.getFieldPointValue (pos2);
-
-          diff = proportionD1 * valE1->getPrevValue () + proportionD2 * valE2->getPrevValue ();
+          diff = proportionD1 * *EInc.getFieldValue (pos1, 1) + proportionD2 * *EInc.getFieldValue (pos2, 1);
         }
 
         if (do_need_update_left)
@@ -1136,39 +1034,28 @@ SchemeTMz::calculateHyStepPML (time_step t, GridCoordinate3D HyStart, GridCoordi
        */
       FPValue k_z = 1;
 
-      FPValue Ca = (2 * eps0 * k_z - sigmaZ * gridTimeStep) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
-      FPValue Cb = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
+      FPValue CaBy = (2 * eps0 * k_z - sigmaZ * gridTimeStep) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
+      FPValue CbBy = (2 * eps0 * gridTimeStep / gridStep) / (2 * eps0 * k_z + sigmaZ * gridTimeStep);
 
-      FieldValue val = calculateHy_2D_TMz_Precalc (valBy->getPrevValue (),
-                                                   prevEz1,
-                                                   prevEz2,
-                                                   Ca,
-                                                   Cb);
+      FieldValue valBy = calculateHy_2D_TMz_Precalc (*By.getFieldValue (pos, 1),
+                                                     prevEz1,
+                                                     prevEz2,
+                                                     CaBy,
+                                                     CbBy);
 
-      valBy->setCurValue (val);
-    }
-  }
-
-  if (useMetamaterials)
-  {
-    for (int i = HyStart.getX (); i < HyEnd.getX (); ++i)
-    {
-      for (int j = HyStart.getY (); j < HyEnd.getY (); ++j)
-      {
-        GridCoordinate2D pos (i, j);
-        GridCoordinate2D posAbs = Hy.getTotalPosition (pos);
-        GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getHyCoordFP (posAbs));
+      By.setFieldValue (valBy, pos, 0);
 
-        FieldPointValue* valB1y = B1y.getFieldPointValue (pos);
-        FieldPointValue* valBy = By.getFieldPointValue (pos);
+      FieldValue prevValBy = *By.getFieldValue (pos, 1);
 
-        FieldPointValue* valOmegaPM1 = OmegaPM.getFieldPointValue (OmegaPM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-        FieldPointValue* valOmegaPM2 = OmegaPM.getFieldPointValue (OmegaPM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-        FieldPointValue* valGammaM1 = GammaM.getFieldPointValue (GammaM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-        FieldPointValue* valGammaM2 = GammaM.getFieldPointValue (GammaM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      if (useMetamaterials)
+      {
+        FieldValue *valOmegaPM1 = OmegaPM.getFieldValue (OmegaPM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+        FieldValue *valOmegaPM2 = OmegaPM.getFieldValue (OmegaPM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+        FieldValue *valGammaM1 = GammaM.getFieldValue (GammaM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+        FieldValue *valGammaM2 = GammaM.getFieldValue (GammaM.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
-        FieldPointValue* valMu1 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-        FieldPointValue* valMu2 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+        FieldValue *valMu1 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+        FieldValue *valMu2 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
         FPValue omegaPM;
         FPValue gammaM;
@@ -1176,21 +1063,21 @@ SchemeTMz::calculateHyStepPML (time_step t, GridCoordinate3D HyStart, GridCoordi
         FPValue dividerGamma = 0;
 
 #ifdef COMPLEX_FIELD_VALUES
-        FPValue mu = (valMu1->getCurValue ().real () + valMu2->getCurValue ().real ()) / 2;
+        FPValue mu = (valMu1->real () + valMu2->real ()) / 2;
 
-        FPValue omegaPM1 = valOmegaPM1->getCurValue ().real ();
-        FPValue omegaPM2 = valOmegaPM2->getCurValue ().real ();
+        FPValue omegaPM1 = valOmegaPM1->real ();
+        FPValue omegaPM2 = valOmegaPM2->real ();
 
-        FPValue gammaM1 = valGammaM1->getCurValue ().real ();
-        FPValue gammaM2 = valGammaM2->getCurValue ().real ();
+        FPValue gammaM1 = valGammaM1->real ();
+        FPValue gammaM2 = valGammaM2->real ();
 #else /* COMPLEX_FIELD_VALUES */
-        FPValue mu = (valMu1->getCurValue () + valMu2->getCurValue ()) / 2;
+        FPValue mu = (*valMu1 + *valMu2) / 2;
 
-        FPValue omegaPM1 = valOmegaPM1->getCurValue ();
-        FPValue omegaPM2 = valOmegaPM2->getCurValue ();
+        FPValue omegaPM1 = *valOmegaPM1;
+        FPValue omegaPM2 = *valOmegaPM2;
 
-        FPValue gammaM1 = valGammaM1->getCurValue ();
-        FPValue gammaM2 = valGammaM2->getCurValue ();
+        FPValue gammaM1 = *valGammaM1;
+        FPValue gammaM2 = *valGammaM2;
 #endif /* !COMPLEX_FIELD_VALUES */
 
         if (omegaPM1 == 0
@@ -1222,61 +1109,42 @@ SchemeTMz::calculateHyStepPML (time_step t, GridCoordinate3D HyStart, GridCoordi
          */
         FPValue C = 4*mu0*mu + 2*gridTimeStep*mu0*mu*gammaM + mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM;
 
-        FieldValue val = calculateDrudeH (valBy->getCurValue (),
-                                          valBy->getPrevValue (),
-                                          valBy->getPrevPrevValue (),
-                                          valB1y->getPrevValue (),
-                                          valB1y->getPrevPrevValue (),
-                                          (4 + 2*gridTimeStep*gammaM) / C,
-                                          -8 / C,
-                                          (4 - 2*gridTimeStep*gammaM) / C,
-                                          (2*mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM - 8*mu0*mu) / C,
-                                          (4*mu0*mu - 2*gridTimeStep*mu0*mu*gammaM + mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM) / C);
-
-        valB1y->setCurValue (val);
-      }
-    }
-  }
-
-  for (int i = HyStart.getX (); i < HyEnd.getX (); ++i)
-  {
-    for (int j = HyStart.getY (); j < HyEnd.getY (); ++j)
-    {
-      GridCoordinate2D pos (i, j);
-      GridCoordinate2D posAbs = Hy.getTotalPosition (pos);
-      GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getHyCoordFP (posAbs));
-
-      FieldPointValue* valHy = Hy.getFieldPointValue (pos);
-      FieldPointValue* valBy;
-
-      if (useMetamaterials)
-      {
-        valBy = B1y.getFieldPointValue (pos);
-      }
-      else
-      {
-        valBy = By.getFieldPointValue (pos);
+        FieldValue valB1y = calculateDrudeH (valBy,
+                                             prevValBy,
+                                             *By.getFieldValue (pos, 2),
+                                             *B1y.getFieldValue (pos, 1),
+                                             *B1y.getFieldValue (pos, 2),
+                                             (4 + 2*gridTimeStep*gammaM) / C,
+                                             -8 / C,
+                                             (4 - 2*gridTimeStep*gammaM) / C,
+                                             (2*mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM - 8*mu0*mu) / C,
+                                             (4*mu0*mu - 2*gridTimeStep*mu0*mu*gammaM + mu0*gridTimeStep*gridTimeStep*omegaPM*omegaPM) / C);
+
+        B1y.setFieldValue (valB1y, pos, 0);
+
+        valBy = valB1y;
+        prevValBy = *B1y.getFieldValue (pos, 1);
       }
 
-      FieldPointValue* valSigmaX1 = SigmaX.getFieldPointValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaX2 = SigmaX.getFieldPointValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valSigmaX1 = SigmaX.getFieldValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaX2 = SigmaX.getFieldValue (SigmaX.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
-      FieldPointValue* valSigmaY1 = SigmaY.getFieldPointValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valSigmaY2 = SigmaY.getFieldPointValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valSigmaY1 = SigmaY.getFieldValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valSigmaY2 = SigmaY.getFieldValue (SigmaY.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
-      FieldPointValue* valMu1 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
-      FieldPointValue* valMu2 = Mu.getFieldPointValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))));
+      FieldValue *valMu1 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () - 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
+      FieldValue *valMu2 = Mu.getFieldValue (Mu.getRelativePosition (shrinkCoord (yeeLayout->getEpsCoord (GridCoordinateFP3D (realCoord.getX () + 0.5, realCoord.getY (), yeeLayout->getMinEpsCoordFP ().getZ ())))), 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      FPValue mu = (valMu1->getCurValue ().real () + valMu2->getCurValue ().real ()) / 2;
+      FPValue mu = (valMu1->real () + valMu2->real ()) / 2;
 
-      FPValue sigmaX = (valSigmaX1->getCurValue ().real () + valSigmaX2->getCurValue ().real ()) / 2;
-      FPValue sigmaY = (valSigmaY1->getCurValue ().real () + valSigmaY2->getCurValue ().real ()) / 2;
+      FPValue sigmaX = (valSigmaX1->real () + valSigmaX2->real ()) / 2;
+      FPValue sigmaY = (valSigmaY1->real () + valSigmaY2->real ()) / 2;
 #else /* COMPLEX_FIELD_VALUES */
-      FPValue mu = (valMu1->getCurValue () + valMu2->getCurValue ()) / 2;
+      FPValue mu = (*valMu1 + *valMu2) / 2;
 
-      FPValue sigmaX = (valSigmaX1->getCurValue () + valSigmaX2->getCurValue ()) / 2;
-      FPValue sigmaY = (valSigmaY1->getCurValue () + valSigmaY2->getCurValue ()) / 2;
+      FPValue sigmaX = (*valSigmaX1 + *valSigmaX2) / 2;
+      FPValue sigmaY = (*valSigmaY1 + *valSigmaY2) / 2;
 #endif /* !COMPLEX_FIELD_VALUES */
 
       FPValue modifier = mu * mu0;
@@ -1295,18 +1163,108 @@ SchemeTMz::calculateHyStepPML (time_step t, GridCoordinate3D HyStart, GridCoordi
       FPValue Cb = ((2 * eps0 * k_y + sigmaY * gridTimeStep) / (modifier)) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
       FPValue Cc = ((2 * eps0 * k_y - sigmaY * gridTimeStep) / (modifier)) / (2 * eps0 * k_x + sigmaX * gridTimeStep);
 
-      FieldValue val = calculateHy_from_By_Precalc (valHy->getPrevValue (),
-                                                    valBy->getCurValue (),
-                                                    valBy->getPrevValue (),
+      FieldValue val = calculateHy_from_By_Precalc (*Hy.getFieldValue (pos, 1),
+                                                    valBy,
+                                                    prevValBy,
                                                     Ca,
                                                     Cb,
                                                     Cc);
 
-      valHy->setCurValue (val);
+      Hy.setFieldValue (val, pos, 0);
     }
   }
 }
 
+#if defined (PARALLEL_GRID)
+SchemeTMz::InteriorHStepsTask::InteriorHStepsTask (SchemeTMz *schemeTMz,
+                                                   time_step step,
+                                                   GridCoordinate3D interiorHxStart,
+                                                   GridCoordinate3D interiorHxEnd,
+                                                   GridCoordinate3D interiorHyStart,
+                                                   GridCoordinate3D interiorHyEnd)
+  : scheme (schemeTMz)
+  , t (step)
+  , HxStart (interiorHxStart)
+  , HxEnd (interiorHxEnd)
+  , HyStart (interiorHyStart)
+  , HyEnd (interiorHyEnd)
+{
+}
+
+grid_iter
+SchemeTMz::InteriorHStepsTask::getNumParts () const
+{
+  return (HxEnd.getX () - HxStart.getX ()) + (HyEnd.getX () - HyStart.getX ());
+}
+
+void
+SchemeTMz::InteriorHStepsTask::run (grid_iter part)
+{
+  grid_iter HxRows = HxEnd.getX () - HxStart.getX ();
+
+  if (part < HxRows)
+  {
+    grid_iter i = HxStart.getX () + part;
+
+    scheme->performHxSteps (t,
+                            GridCoordinate3D (i, HxStart.getY (), HxStart.getZ ()),
+                            GridCoordinate3D (i + 1, HxEnd.getY (), HxEnd.getZ ()));
+  }
+  else
+  {
+    grid_iter i = HyStart.getX () + part - HxRows;
+
+    scheme->performHySteps (t,
+                            GridCoordinate3D (i, HyStart.getY (), HyStart.getZ ()),
+                            GridCoordinate3D (i + 1, HyEnd.getY (), HyEnd.getZ ()));
+  }
+}
+
+/*
+ * Interior of computation area is the area without its outer layer of cells, which could read receive buffers of
+ * neighbouring grids. It is empty when computation area is too small.
+ */
+GridCoordinate3D
+SchemeTMz::getInteriorStart (GridCoordinate3D start, GridCoordinate3D end)
+{
+  return GridCoordinate3D (start.getX () < end.getX () ? start.getX () + 1 : end.getX (),
+                           start.getY () < end.getY () ? start.getY () + 1 : end.getY (),
+                           start.getZ ());
+}
+
+GridCoordinate3D
+SchemeTMz::getInteriorEnd (GridCoordinate3D start, GridCoordinate3D end)
+{
+  GridCoordinate3D interiorStart = getInteriorStart (start, end);
+
+  return GridCoordinate3D (end.getX () > interiorStart.getX () + 1 ? end.getX () - 1 : interiorStart.getX (),
+                           end.getY () > interiorStart.getY () + 1 ? end.getY () - 1 : interiorStart.getY (),
+                           end.getZ ());
+}
+
+/*
+ * Perform steps in computation area except for its interior, which is updated separately
+ */
+void
+SchemeTMz::performBorderSteps (StepsFunction performSteps,
+                               time_step t,
+                               GridCoordinate3D start,
+                               GridCoordinate3D end,
+                               GridCoordinate3D interiorStart,
+                               GridCoordinate3D interiorEnd)
+{
+  (this->*performSteps) (t, start, GridCoordinate3D (interiorStart.getX (), end.getY (), end.getZ ()));
+  (this->*performSteps) (t, GridCoordinate3D (interiorEnd.getX (), start.getY (), start.getZ ()), end);
+
+  (this->*performSteps) (t,
+                         GridCoordinate3D (interiorStart.getX (), start.getY (), start.getZ ()),
+                         GridCoordinate3D (interiorEnd.getX (), interiorStart.getY (), end.getZ ()));
+  (this->*performSteps) (t,
+                         GridCoordinate3D (interiorStart.getX (), interiorEnd.getY (), start.getZ ()),
+                         GridCoordinate3D (interiorEnd.getX (), end.getY (), end.getZ ()));
+}
+#endif /* PARALLEL_GRID */
+
 void
 SchemeTMz::performNSteps (time_step startStep, time_step numberTimeSteps)
 {
@@ -1345,13 +1303,12 @@ SchemeTMz::performNSteps (time_step startStep, time_step numberTimeSteps)
 #endif
       {
         GridCoordinate2D pos (70, EzSize.getY () / 2);
-        FieldPointValue* tmp = Ez.getFieldPointValue (pos);
 
 #ifdef COMPLEX_FIELD_VALUES
-        tmp->setCurValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
-                                      cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)));
+        Ez.setFieldValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
+                                      cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)), pos, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        tmp->setCurValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency));
+        Ez.setFieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency), pos, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
         // for (int i = EzStart.getX (); i < EzEnd.getX (); ++i)
@@ -1391,8 +1348,6 @@ SchemeTMz::performNSteps (time_step startStep, time_step numberTimeSteps)
       }
     }
 
-    Ez.nextTimeStep ();
-
     if (usePML)
     {
       Dz.nextTimeStep ();
@@ -1408,8 +1363,29 @@ SchemeTMz::performNSteps (time_step startStep, time_step numberTimeSteps)
       performPlaneWaveHSteps (t);
     }
 
+#if defined (PARALLEL_GRID)
+    /*
+     * Interior of Hx and Hy is updated while Ez is shared, outer layers of them read receive buffers of Ez, so they
+     * are updated after share operations are finished
+     */
+    GridCoordinate3D HxInteriorStart = getInteriorStart (HxStart, HxEnd);
+    GridCoordinate3D HxInteriorEnd = getInteriorEnd (HxStart, HxEnd);
+
+    GridCoordinate3D HyInteriorStart = getInteriorStart (HyStart, HyEnd);
+    GridCoordinate3D HyInteriorEnd = getInteriorEnd (HyStart, HyEnd);
+
+    InteriorHStepsTask interiorHSteps (this, t, HxInteriorStart, HxInteriorEnd, HyInteriorStart, HyInteriorEnd);
+
+    Ez.nextTimeStep (interiorHSteps);
+
+    performBorderSteps (&SchemeTMz::performHxSteps, t, HxStart, HxEnd, HxInteriorStart, HxInteriorEnd);
+    performBorderSteps (&SchemeTMz::performHySteps, t, HyStart, HyEnd, HyInteriorStart, HyInteriorEnd);
+#else /* PARALLEL_GRID */
+    Ez.nextTimeStep ();
+
     performHxSteps (t, HxStart, HxEnd);
     performHySteps (t, HyStart, HyEnd);
+#endif /* !PARALLEL_GRID */
 
     Hx.nextTimeStep ();
     Hy.nextTimeStep ();
@@ -1444,15 +1420,15 @@ SchemeTMz::performNSteps (time_step startStep, time_step numberTimeSteps)
     GridCoordinate2D pos4 (posX2, posY2);
 
 #ifdef PARALLEL_GRID
-    FieldPointValue *val1 = Ez.getFieldPointValueOrNullByAbsolutePos (pos1);
-    FieldPointValue *val2 = Ez.getFieldPointValueOrNullByAbsolutePos (pos2);
-    FieldPointValue *val3 = Ez.getFieldPointValueOrNullByAbsolutePos (pos3);
-    FieldPointValue *val4 = Ez.getFieldPointValueOrNullByAbsolutePos (pos4);
+    FieldValue *val1 = Ez.getFieldValueOrNullByAbsolutePos (pos1, 1);
+    FieldValue *val2 = Ez.getFieldValueOrNullByAbsolutePos (pos2, 1);
+    FieldValue *val3 = Ez.getFieldValueOrNullByAbsolutePos (pos3, 1);
+    FieldValue *val4 = Ez.getFieldValueOrNullByAbsolutePos (pos4, 1);
 #else
-    FieldPointValue *val1 = Ez.getFieldPointValue (pos1);
-    FieldPointValue *val2 = Ez.getFieldPointValue (pos2);
-    FieldPointValue *val3 = Ez.getFieldPointValue (pos3);
-    FieldPointValue *val4 = Ez.getFieldPointValue (pos4);
+    FieldValue *val1 = Ez.getFieldValue (pos1, 1);
+    FieldValue *val2 = Ez.getFieldValue (pos2, 1);
+    FieldValue *val3 = Ez.getFieldValue (pos3, 1);
+    FieldValue *val4 = Ez.getFieldValue (pos4, 1);
 #endif
 
     if (val1 != NULLPTR
@@ -1471,10 +1447,10 @@ SchemeTMz::performNSteps (time_step startStep, time_step numberTimeSteps)
       FPValue proportion3 = propX * propY1;
       FPValue proportion4 = propX1 * propY1;
 
-      FieldValue valCurTotal = proportion1 * val1->getCurValue ()
-                               + proportion2 * val2->getCurValue ()
-                               + proportion3 * val3->getCurValue ()
-                               + proportion4 * val4->getCurValue ();
+      FieldValue valCurTotal = proportion1 * *val1
+                               + proportion2 * *val2
+                               + proportion3 * *val3
+                               + proportion4 * *val4;
 
       GridCoordinateFP2D realCoord1 = shrinkCoord (yeeLayout->getEzCoordFP (pos1));
       GridCoordinateFP2D realCoord2 = shrinkCoord (yeeLayout->getEzCoordFP (pos2));
@@ -1530,15 +1506,15 @@ SchemeTMz::performNSteps (time_step startStep, time_step numberTimeSteps)
   if (dumpRes)
   {
     BMPDumper<GridCoordinate2D> dumperEz;
-    dumperEz.init (stepLimit, CURRENT, processId, "2D-TMz-in-time-Ez");
+    dumperEz.init (stepLimit, PREVIOUS, processId, "2D-TMz-in-time-Ez");
     dumperEz.dumpGrid (Ez, GridCoordinate2D (0), Ez.getSize ());
 
     BMPDumper<GridCoordinate2D> dumperHx;
-    dumperHx.init (stepLimit, CURRENT, processId, "2D-TMz-in-time-Hx");
+    dumperHx.init (stepLimit, PREVIOUS, processId, "2D-TMz-in-time-Hx");
     dumperHx.dumpGrid (Hx, GridCoordinate2D (0), Hx.getSize ());
 
     BMPDumper<GridCoordinate2D> dumperHy;
-    dumperHy.init (stepLimit, CURRENT, processId, "2D-TMz-in-time-Hy");
+    dumperHy.init (stepLimit, PREVIOUS, processId, "2D-TMz-in-time-Hy");
     dumperHy.dumpGrid (Hy, GridCoordinate2D (0), Hy.getSize ());
 
     // for (int i = 0; i < EzSize.getX (); ++i)
@@ -1612,13 +1588,12 @@ SchemeTMz::performAmplitudeSteps (time_step startStep)
 #endif
       {
         GridCoordinate2D pos (70, EzSize.getY () / 2);
-        FieldPointValue* tmp = Ez.getFieldPointValue (pos);
 
 #ifdef COMPLEX_FIELD_VALUES
-        tmp->setCurValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
-                                      cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)));
+        Ez.setFieldValue (FieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency),
+                                      cos (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency)), pos, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        tmp->setCurValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency));
+        Ez.setFieldValue (sin (gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency), pos, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
 
         // for (int i = EzStart.getX (); i < EzEnd.getX (); ++i)
@@ -1665,6 +1640,9 @@ SchemeTMz::performAmplitudeSteps (time_step startStep)
       }
     }
 
+#ifdef OPENMP_ENABLED
+    #pragma omp parallel for collapse (2) reduction (max: maxAccuracy) reduction (min: is_stable_state)
+#endif /* OPENMP_ENABLED */
     for (int i = EzStart.getX (); i < EzEnd.getX (); ++i)
     {
       for (int j = EzStart.getY (); j < EzEnd.getY (); ++j)
@@ -1673,15 +1651,12 @@ SchemeTMz::performAmplitudeSteps (time_step startStep)
 
         if (!yeeLayout->isEzInPML (Ez.getTotalPosition (pos)))
         {
-          FieldPointValue* tmp = Ez.getFieldPointValue (pos);
-          FieldPointValue* tmpAmp = EzAmplitude.getFieldPointValue (pos);
-
           GridCoordinateFP2D realCoord = shrinkCoord (yeeLayout->getEzCoordFP (Ez.getTotalPosition (pos)));
 
           GridCoordinateFP3D leftBorder = GridCoordinateFP3D (0, 0, 0) + convertCoord (yeeLayout->getLeftBorderTFSF ());
           GridCoordinateFP3D rightBorder = GridCoordinateFP3D (0, 0, 0) + convertCoord (yeeLayout->getRightBorderTFSF ());
 
-          FPValue val = tmp->getCurValue ();
+          FPValue val = *Ez.getFieldValue (pos, 0);
 
           // if (realCoord.getX () > leftBorder.getX () - 1 && realCoord.getX () < rightBorder.getX () + 1
           //     && realCoord.getY () > leftBorder.getY () - 1 && realCoord.getY () < rightBorder.getY () + 1)
@@ -1707,7 +1682,7 @@ SchemeTMz::performAmplitudeSteps (time_step startStep)
           //   val -= diff;
           // }
 
-          if (updateAmplitude (val, tmpAmp, &maxAccuracy) == 0)
+          if (updateAmplitude (val, EzAmplitude.getFieldValue (pos, 0), &maxAccuracy) == 0)
           {
             is_stable_state = 0;
           }
@@ -1730,6 +1705,9 @@ SchemeTMz::performAmplitudeSteps (time_step startStep)
     performHxSteps (t, HxStart, HxEnd);
     performHySteps (t, HyStart, HyEnd);
 
+#ifdef OPENMP_ENABLED
+    #pragma omp parallel for collapse (2) reduction (max: maxAccuracy) reduction (min: is_stable_state)
+#endif /* OPENMP_ENABLED */
     for (int i = HxStart.getX (); i < HxEnd.getX (); ++i)
     {
       for (int j = HxStart.getY (); j < HxEnd.getY (); ++j)
@@ -1738,10 +1716,7 @@ SchemeTMz::performAmplitudeSteps (time_step startStep)
 
         if (!yeeLayout->isHxInPML (Hx.getTotalPosition (pos)))
         {
-          FieldPointValue* tmp = Hx.getFieldPointValue (pos);
-          FieldPointValue* tmpAmp = HxAmplitude.getFieldPointValue (pos);
-
-          if (updateAmplitude (tmp->getCurValue (), tmpAmp, &maxAccuracy) == 0)
+          if (updateAmplitude (*Hx.getFieldValue (pos, 0), HxAmplitude.getFieldValue (pos, 0), &maxAccuracy) == 0)
           {
             is_stable_state = 0;
           }
@@ -1749,6 +1724,9 @@ SchemeTMz::performAmplitudeSteps (time_step startStep)
       }
     }
 
+#ifdef OPENMP_ENABLED
+    #pragma omp parallel for collapse (2) reduction (max: maxAccuracy) reduction (min: is_stable_state)
+#endif /* OPENMP_ENABLED */
     for (int i = HyStart.getX (); i < HyEnd.getX (); ++i)
     {
       for (int j = HyStart.getY (); j < HyEnd.getY (); ++j)
@@ -1758,10 +1736,7 @@ SchemeTMz::performAmplitudeSteps (time_step startStep)
         if (!yeeLayout->isHyInPML (Hy.getTotalPosition (pos)))
         {
 
-          FieldPointValue* tmp = Hy.getFieldPointValue (pos);
-          FieldPointValue* tmpAmp = HyAmplitude.getFieldPointValue (pos);
-
-          if (updateAmplitude (tmp->getCurValue (), tmpAmp, &maxAccuracy) == 0)
+          if (updateAmplitude (*Hy.getFieldValue (pos, 0), HyAmplitude.getFieldValue (pos, 0), &maxAccuracy) == 0)
           {
             is_stable_state = 0;
           }
@@ -1850,7 +1825,7 @@ SchemeTMz::performAmplitudeSteps (time_step startStep)
 }
 
 int
-SchemeTMz::updateAmplitude (FPValue val, FieldPointValue *amplitudeValue, FPValue *maxAccuracy)
+SchemeTMz::updateAmplitude (FPValue val, FieldValue *amplitudeValue, FPValue *maxAccuracy)
 {
 #ifdef COMPLEX_FIELD_VALUES
   UNREACHABLE;
@@ -1858,7 +1833,7 @@ SchemeTMz::updateAmplitude (FPValue val, FieldPointValue *amplitudeValue, FPValu
 
   int is_stable_state = 1;
 
-  FPValue valAmp = amplitudeValue->getCurValue ();
+  FPValue valAmp = *amplitudeValue;
 
   val = val >= 0 ? val : -val;
 
@@ -1878,7 +1853,7 @@ SchemeTMz::updateAmplitude (FPValue val, FieldPointValue *amplitudeValue, FPValu
     {
       is_stable_state = 0;
 
-      amplitudeValue->setCurValue (val);
+      *amplitudeValue = val;
     }
 
     if (accuracy > *maxAccuracy)
@@ -1968,12 +1943,12 @@ SchemeTMz::initGrids ()
   {
     for (int j = 0; j < Eps.getSize ().getY (); ++j)
     {
-      FieldPointValue* valEps = new FieldPointValue ();
+      FieldValue valEps;
 
 #ifdef COMPLEX_FIELD_VALUES
-      valEps->setCurValue (FieldValue (1, 0));
+      valEps = FieldValue (1, 0);
 #else /* COMPLEX_FIELD_VALUES */
-      valEps->setCurValue (1);
+      valEps = 1;
 #endif /* !COMPLEX_FIELD_VALUES */
 
       GridCoordinate2D pos (i, j);
@@ -2002,7 +1977,7 @@ SchemeTMz::initGrids ()
 // #endif /* !COMPLEX_FIELD_VALUES */
 //       }
 
-      Eps.setFieldPointValue (valEps, pos);
+      Eps.setFieldValue (valEps, pos, 0);
     }
   }
 
@@ -2014,446 +1989,326 @@ SchemeTMz::initGrids ()
     dumper.dumpGrid (Eps, GridCoordinate2D (0), Eps.getSize ());
   }
 
-  for (int i = 0; i < OmegaPE.getSize ().getX (); ++i)
+  if (useMetamaterials)
   {
-    for (int j = 0; j < OmegaPE.getSize ().getY (); ++j)
+    for (int i = 0; i < OmegaPE.getSize ().getX (); ++i)
     {
-      FieldPointValue* valOmega = new FieldPointValue ();
+      for (int j = 0; j < OmegaPE.getSize ().getY (); ++j)
+      {
+        FieldValue valOmega;
 
 #ifdef COMPLEX_FIELD_VALUES
-      valOmega->setCurValue (FieldValue (0, 0));
+        valOmega = FieldValue (0, 0);
 #else /* COMPLEX_FIELD_VALUES */
-      valOmega->setCurValue (0);
+        valOmega = 0;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      GridCoordinate2D pos (i, j);
-      GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (OmegaPE.getTotalPosition (pos)));
+        GridCoordinate2D pos (i, j);
+        GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (OmegaPE.getTotalPosition (pos)));
 
-      GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (OmegaPE.getTotalSize ()));
+        GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (OmegaPE.getTotalSize ()));
 
-      // if (posAbs.getX () >= 120 && posAbs.getX () < size.getX () - 120
-      //     && posAbs.getY () >= yeeLayout->getLeftBorderPML ().getY () && posAbs.getY () < size.getY () - yeeLayout->getLeftBorderPML ().getY ())
-      // {
-      if (posAbs.getX () >= 437 && posAbs.getX () < 487
-            && posAbs.getY () >= 405 && posAbs.getY () < 505)
-      {
+        // if (posAbs.getX () >= 120 && posAbs.getX () < size.getX () - 120
+        //     && posAbs.getY () >= yeeLayout->getLeftBorderPML ().getY () && posAbs.getY () < size.getY () - yeeLayout->getLeftBorderPML ().getY ())
+        // {
+        if (posAbs.getX () >= 437 && posAbs.getX () < 487
+              && posAbs.getY () >= 405 && posAbs.getY () < 505)
+        {
 
-      // if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
-      //     + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0)
-      //     && (posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
-      //         + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) > (size.getX ()*0.5/7.0) * (size.getX ()*0.5/7.0))
-      // {
+        // if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
+        //     + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0)
+        //     && (posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
+        //         + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) > (size.getX ()*0.5/7.0) * (size.getX ()*0.5/7.0))
+        // {
 #ifdef COMPLEX_FIELD_VALUES
-        valOmega->setCurValue (FieldValue (sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency, 0));
+          valOmega = FieldValue (sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        valOmega->setCurValue (sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency);
+          valOmega = sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency;
 #endif /* !COMPLEX_FIELD_VALUES */
-      }
+        }
 
-      OmegaPE.setFieldPointValue (valOmega, pos);
+        OmegaPE.setFieldValue (valOmega, pos, 0);
+      }
     }
-  }
 
-  for (int i = 0; i < OmegaPM.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < OmegaPM.getSize ().getY (); ++j)
+    for (int i = 0; i < OmegaPM.getSize ().getX (); ++i)
     {
-      FieldPointValue* valOmega = new FieldPointValue ();
+      for (int j = 0; j < OmegaPM.getSize ().getY (); ++j)
+      {
+        FieldValue valOmega;
 
 #ifdef COMPLEX_FIELD_VALUES
-      valOmega->setCurValue (FieldValue (0, 0));
+        valOmega = FieldValue (0, 0);
 #else /* COMPLEX_FIELD_VALUES */
-      valOmega->setCurValue (0);
+        valOmega = 0;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      GridCoordinate2D pos (i, j);
-      GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (OmegaPM.getTotalPosition (pos)));
+        GridCoordinate2D pos (i, j);
+        GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (OmegaPM.getTotalPosition (pos)));
 
-      GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (OmegaPM.getTotalSize ()));
+        GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (OmegaPM.getTotalSize ()));
 
-      // if (posAbs.getX () >= size.getX () / 2 - 20 && posAbs.getX () < size.getX () / 2 + 20
-      //     && posAbs.getY () >= 50 && posAbs.getY () < size.getY () - 50)s
-      // {
-      //   valOmega->setCurValue (sqrt(2) * 2 * PhysicsConst::Pi * frequency);
-      // }
+        // if (posAbs.getX () >= size.getX () / 2 - 20 && posAbs.getX () < size.getX () / 2 + 20
+        //     && posAbs.getY () >= 50 && posAbs.getY () < size.getY () - 50)s
+        // {
+        //   valOmega->setCurValue (sqrt(2) * 2 * PhysicsConst::Pi * frequency);
+        // }
 
-      // if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
-      //     + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0))
-      // {
-      //   valOmega->setCurValue (1);
-      // }
+        // if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
+        //     + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0))
+        // {
+        //   valOmega->setCurValue (1);
+        // }
 
-      // if (posAbs.getX () >= 120 && posAbs.getX () < size.getX () - 120
-      //     && posAbs.getY () >= yeeLayout->getLeftBorderPML ().getY () && posAbs.getY () < size.getY () - yeeLayout->getLeftBorderPML ().getY ())
-      // {
-      if (posAbs.getX () >= 437 && posAbs.getX () < 487
-            && posAbs.getY () >= 405 && posAbs.getY () < 505)
-      {
+        // if (posAbs.getX () >= 120 && posAbs.getX () < size.getX () - 120
+        //     && posAbs.getY () >= yeeLayout->getLeftBorderPML ().getY () && posAbs.getY () < size.getY () - yeeLayout->getLeftBorderPML ().getY ())
+        // {
+        if (posAbs.getX () >= 437 && posAbs.getX () < 487
+              && posAbs.getY () >= 405 && posAbs.getY () < 505)
+        {
 
-      // if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
-      //     + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0)
-      //     && (posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
-      //         + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) > (size.getX ()*0.5/7.0) * (size.getX ()*0.5/7.0))
-      // {
+        // if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
+        //     + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0)
+        //     && (posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
+        //         + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) > (size.getX ()*0.5/7.0) * (size.getX ()*0.5/7.0))
+        // {
 #ifdef COMPLEX_FIELD_VALUES
-        valOmega->setCurValue (FieldValue (sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency, 0));
+          valOmega = FieldValue (sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        valOmega->setCurValue (sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency);
+          valOmega = sqrtf(2.0) * 2 * PhysicsConst::Pi * sourceFrequency;
 #endif /* !COMPLEX_FIELD_VALUES */
-      }
+        }
 
-      OmegaPM.setFieldPointValue (valOmega, pos);
+        OmegaPM.setFieldValue (valOmega, pos, 0);
+      }
     }
-  }
 
-  for (int i = 0; i < GammaE.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < GammaE.getSize ().getY (); ++j)
+    for (int i = 0; i < GammaE.getSize ().getX (); ++i)
     {
-      FieldPointValue* valGamma = new FieldPointValue ();
+      for (int j = 0; j < GammaE.getSize ().getY (); ++j)
+      {
+        FieldValue valGamma;
 
 #ifdef COMPLEX_FIELD_VALUES
-      valGamma->setCurValue (FieldValue (0, 0));
+        valGamma = FieldValue (0, 0);
 #else /* COMPLEX_FIELD_VALUES */
-      valGamma->setCurValue (0);
+        valGamma = 0;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      GridCoordinate2D pos (i, j);
-      // GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (Eps.getTotalPosition (pos)));
-      //
-      // GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (Eps.getTotalSize ()));
-
-      // GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (GammaE.getTotalPosition (pos)));
-      //
-      // GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (GammaE.getTotalSize ()));
-      //
-      // if (posAbs.getX () >= size.getX () / 2 - 20 && posAbs.getX () < size.getX () / 2 + 20
-      //     && posAbs.getY () >= 50 && posAbs.getY () < size.getY () - 50)
-      // {
-      //   valGamma->setCurValue (1);
-      // }
+        GridCoordinate2D pos (i, j);
+        // GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (Eps.getTotalPosition (pos)));
+        //
+        // GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (Eps.getTotalSize ()));
 
-      // if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
-      //     + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0))
-      // {
-      //   valGamma->setCurValue (1);
-      // }
+        // GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (GammaE.getTotalPosition (pos)));
+        //
+        // GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (GammaE.getTotalSize ()));
+        //
+        // if (posAbs.getX () >= size.getX () / 2 - 20 && posAbs.getX () < size.getX () / 2 + 20
+        //     && posAbs.getY () >= 50 && posAbs.getY () < size.getY () - 50)
+        // {
+        //   valGamma->setCurValue (1);
+        // }
 
-      GammaE.setFieldPointValue (valGamma, pos);
+        // if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
+        //     + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0))
+        // {
+        //   valGamma->setCurValue (1);
+        // }
+
+        GammaE.setFieldValue (valGamma, pos, 0);
+      }
     }
-  }
 
-  for (int i = 0; i < GammaM.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < GammaM.getSize ().getY (); ++j)
+    for (int i = 0; i < GammaM.getSize ().getX (); ++i)
     {
-      FieldPointValue* valGamma = new FieldPointValue ();
+      for (int j = 0; j < GammaM.getSize ().getY (); ++j)
+      {
+        FieldValue valGamma;
 
 #ifdef COMPLEX_FIELD_VALUES
-      valGamma->setCurValue (FieldValue (0, 0));
+        valGamma = FieldValue (0, 0);
 #else /* COMPLEX_FIELD_VALUES */
-      valGamma->setCurValue (0);
+        valGamma = 0;
 #endif /* !COMPLEX_FIELD_VALUES */
 
-      GridCoordinate2D pos (i, j);
-      // GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (GammaM.getTotalPosition (pos)));
-      //
-      // GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (GammaM.getTotalSize ()));
-      //
-      // if (posAbs.getX () >= size.getX () / 2 - 20 && posAbs.getX () < size.getX () / 2 + 20
-      //     && posAbs.getY () >= 50 && posAbs.getY () < size.getY () - 50)
-      // {
-      //   valGamma->setCurValue (1);
-      // }
+        GridCoordinate2D pos (i, j);
+        // GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (GammaM.getTotalPosition (pos)));
+        //
+        // GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (GammaM.getTotalSize ()));
+        //
+        // if (posAbs.getX () >= size.getX () / 2 - 20 && posAbs.getX () < size.getX () / 2 + 20
+        //     && posAbs.getY () >= 50 && posAbs.getY () < size.getY () - 50)
+        // {
+        //   valGamma->setCurValue (1);
+        // }
 
-      // if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
-      //     + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0))
-      // {
-      //   valGamma->setCurValue (1);
-      // }
+        // if ((posAbs.getX () - size.getX () / 2) * (posAbs.getX () - size.getX () / 2)
+        //     + (posAbs.getY () - size.getY () / 2) * (posAbs.getY () - size.getY () / 2) < (size.getX ()*1.5/7.0) * (size.getX ()*1.5/7.0))
+        // {
+        //   valGamma->setCurValue (1);
+        // }
 
-      GammaM.setFieldPointValue (valGamma, pos);
+        GammaM.setFieldValue (valGamma, pos, 0);
+      }
     }
-  }
 
-  if (dumpRes)
-  {
-    dumper.init (0, CURRENT, processId, "OmegaPE");
-    dumper.dumpGrid (OmegaPE, GridCoordinate2D (0), OmegaPE.getSize ());
+    if (dumpRes)
+    {
+      dumper.init (0, CURRENT, processId, "OmegaPE");
+      dumper.dumpGrid (OmegaPE, GridCoordinate2D (0), OmegaPE.getSize ());
 
-    dumper.init (0, CURRENT, processId, "OmegaPM");
-    dumper.dumpGrid (OmegaPM, GridCoordinate2D (0), OmegaPM.getSize ());
+      dumper.init (0, CURRENT, processId, "OmegaPM");
+      dumper.dumpGrid (OmegaPM, GridCoordinate2D (0), OmegaPM.getSize ());
 
-    dumper.init (0, CURRENT, processId, "GammaE");
-    dumper.dumpGrid (GammaE, GridCoordinate2D (0), GammaE.getSize ());
+      dumper.init (0, CURRENT, processId, "GammaE");
+      dumper.dumpGrid (GammaE, GridCoordinate2D (0), GammaE.getSize ());
 
-    dumper.init (0, CURRENT, processId, "GammaM");
-    dumper.dumpGrid (GammaM, GridCoordinate2D (0), GammaM.getSize ());
+      dumper.init (0, CURRENT, processId, "GammaM");
+      dumper.dumpGrid (GammaM, GridCoordinate2D (0), GammaM.getSize ());
+    }
   }
 
   for (int i = 0; i < Mu.getSize ().getX (); ++i)
   {
     for (int j = 0; j < Mu.getSize ().getY (); ++j)
     {
-      FieldPointValue* valMu = new FieldPointValue ();
+      FieldValue valMu;
 
 #ifdef COMPLEX_FIELD_VALUES
-      valMu->setCurValue (FieldValue (1, 0));
+      valMu = FieldValue (1, 0);
 #else /* COMPLEX_FIELD_VALUES */
-      valMu->setCurValue (1);
+      valMu = 1;
 #endif /* !COMPLEX_FIELD_VALUES */
 
       GridCoordinate2D pos (i, j);
 
-      Mu.setFieldPointValue (valMu, pos);
+      Mu.setFieldValue (valMu, pos, 0);
     }
   }
 
-  FPValue eps0 = PhysicsConst::Eps0;
-  FPValue mu0 = PhysicsConst::Mu0;
+  if (usePML)
+  {
+    FPValue eps0 = PhysicsConst::Eps0;
+    FPValue mu0 = PhysicsConst::Mu0;
 
-  GridCoordinate2D PMLSize = shrinkCoord (yeeLayout->getLeftBorderPML ());
+    GridCoordinate2D PMLSize = shrinkCoord (yeeLayout->getLeftBorderPML ());
 
-  FPValue boundary = PMLSize.getX () * gridStep;
-  uint32_t exponent = 6;
-	FPValue R_err = 1e-16;
-	FPValue sigma_max_1 = -log (R_err) * (exponent + 1.0) / (2.0 * sqrt (mu0 / eps0) * boundary);
-	FPValue boundaryFactor = sigma_max_1 / (gridStep * (pow (boundary, exponent)) * (exponent + 1));
+    FPValue boundary = PMLSize.getX () * gridStep;
+    uint32_t exponent = 6;
+  	FPValue R_err = 1e-16;
+  	FPValue sigma_max_1 = -log (R_err) * (exponent + 1.0) / (2.0 * sqrt (mu0 / eps0) * boundary);
+  	FPValue boundaryFactor = sigma_max_1 / (gridStep * (pow (boundary, exponent)) * (exponent + 1));
 
-  for (int i = 0; i < SigmaX.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < SigmaX.getSize ().getY (); ++j)
+    for (int i = 0; i < SigmaX.getSize ().getX (); ++i)
     {
-      FieldPointValue* valSigma = new FieldPointValue ();
+      for (int j = 0; j < SigmaX.getSize ().getY (); ++j)
+      {
+        FieldValue valSigma (0);
 
-      GridCoordinate2D pos (i, j);
-      GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaX.getTotalPosition (pos)));
+        GridCoordinate2D pos (i, j);
+        GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaX.getTotalPosition (pos)));
 
-      GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaX.getTotalSize ()));
+        GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaX.getTotalSize ()));
 
-      /*
-       * FIXME: add layout coordinates for material: sigma, eps, etc.
-       */
-      if (posAbs.getX () < PMLSize.getX ())
-      {
-        grid_coord dist = PMLSize.getX () - posAbs.getX ();
-  			FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
-  			FPValue x2 = dist * gridStep;       // lower bounds for point i
+        /*
+         * FIXME: add layout coordinates for material: sigma, eps, etc.
+         */
+        if (posAbs.getX () < PMLSize.getX ())
+        {
+          grid_coord dist = PMLSize.getX () - posAbs.getX ();
+    			FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
+    			FPValue x2 = dist * gridStep;       // lower bounds for point i
 
-  		  FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
+    		  FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
 
 #ifdef COMPLEX_FIELD_VALUES
-  			valSigma->setCurValue (FieldValue (val, 0));
+    			valSigma = FieldValue (val, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        valSigma->setCurValue (val);
+          valSigma = val;
 #endif /* !COMPLEX_FIELD_VALUES */
-      }
-      else if (posAbs.getX () >= size.getX () - PMLSize.getX ())
-      {
-        grid_coord dist = posAbs.getX () - (size.getX () - PMLSize.getX ());
-  			FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
-  			FPValue x2 = dist * gridStep;       // lower bounds for point i
+        }
+        else if (posAbs.getX () >= size.getX () - PMLSize.getX ())
+        {
+          grid_coord dist = posAbs.getX () - (size.getX () - PMLSize.getX ());
+    			FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
+    			FPValue x2 = dist * gridStep;       // lower bounds for point i
 
-  			//std::cout << boundaryFactor * (pow(x1, (exponent + 1)) - pow(x2, (exponent + 1))) << std::endl;
-  			FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
+    			//std::cout << boundaryFactor * (pow(x1, (exponent + 1)) - pow(x2, (exponent + 1))) << std::endl;
+    			FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
 
 #ifdef COMPLEX_FIELD_VALUES
-  			valSigma->setCurValue (FieldValue (val, 0));
+    			valSigma = FieldValue (val, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        valSigma->setCurValue (val);
+          valSigma = val;
 #endif /* !COMPLEX_FIELD_VALUES */
-      }
+        }
 
-      SigmaX.setFieldPointValue (valSigma, pos);
+        SigmaX.setFieldValue (valSigma, pos, 0);
+      }
     }
-  }
 
-  for (int i = 0; i < SigmaY.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < SigmaY.getSize ().getY (); ++j)
+    for (int i = 0; i < SigmaY.getSize ().getX (); ++i)
     {
-      FieldPointValue* valSigma = new FieldPointValue ();
+      for (int j = 0; j < SigmaY.getSize ().getY (); ++j)
+      {
+        FieldValue valSigma (0);
 
-      GridCoordinate2D pos (i, j);
-      GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaY.getTotalPosition (pos)));
+        GridCoordinate2D pos (i, j);
+        GridCoordinateFP2D posAbs = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaY.getTotalPosition (pos)));
 
-      GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaX.getTotalSize ()));
+        GridCoordinateFP2D size = shrinkCoord (yeeLayout->getEpsCoordFP (SigmaX.getTotalSize ()));
 
-      /*
-       * FIXME: add layout coordinates for material: sigma, eps, etc.
-       */
-      if (posAbs.getY () < PMLSize.getY ())
-      {
-        grid_coord dist = PMLSize.getY () - posAbs.getY ();
-        FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
-        FPValue x2 = dist * gridStep;       // lower bounds for point i
+        /*
+         * FIXME: add layout coordinates for material: sigma, eps, etc.
+         */
+        if (posAbs.getY () < PMLSize.getY ())
+        {
+          grid_coord dist = PMLSize.getY () - posAbs.getY ();
+          FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
+          FPValue x2 = dist * gridStep;       // lower bounds for point i
 
-        FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
+          FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
 
 #ifdef COMPLEX_FIELD_VALUES
-  			valSigma->setCurValue (FieldValue (val, 0));
+    			valSigma = FieldValue (val, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        valSigma->setCurValue (val);
+          valSigma = val;
 #endif /* !COMPLEX_FIELD_VALUES */
-      }
-      else if (posAbs.getY () >= size.getY () - PMLSize.getY ())
-      {
-        grid_coord dist = posAbs.getY () - (size.getY () - PMLSize.getY ());
-        FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
-        FPValue x2 = dist * gridStep;       // lower bounds for point i
+        }
+        else if (posAbs.getY () >= size.getY () - PMLSize.getY ())
+        {
+          grid_coord dist = posAbs.getY () - (size.getY () - PMLSize.getY ());
+          FPValue x1 = (dist + 1) * gridStep;       // upper bounds for point i
+          FPValue x2 = dist * gridStep;       // lower bounds for point i
 
-        //std::cout << boundaryFactor * (pow(x1, (exponent + 1)) - pow(x2, (exponent + 1))) << std::endl;
-        FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
+          //std::cout << boundaryFactor * (pow(x1, (exponent + 1)) - pow(x2, (exponent + 1))) << std::endl;
+          FPValue val = boundaryFactor * (pow (x1, (exponent + 1)) - pow (x2, (exponent + 1)));   //   polynomial grading
 
 #ifdef COMPLEX_FIELD_VALUES
-  			valSigma->setCurValue (FieldValue (val, 0));
+    			valSigma = FieldValue (val, 0);
 #else /* COMPLEX_FIELD_VALUES */
-        valSigma->setCurValue (val);
+          valSigma = val;
 #endif /* !COMPLEX_FIELD_VALUES */
-      }
-
-      SigmaY.setFieldPointValue (valSigma, pos);
-    }
-  }
-
-  /*
-   * FIXME: SigmaZ grid could be replaced with constant 0.0
-   */
-  for (int i = 0; i < SigmaZ.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < SigmaZ.getSize ().getY (); ++j)
-    {
-      FieldPointValue* valSigma = new FieldPointValue ();
-
-      GridCoordinate2D pos (i, j);
-
-      SigmaZ.setFieldPointValue (valSigma, pos);
-    }
-  }
-
-  if (dumpRes)
-  {
-    dumper.init (0, CURRENT, processId, "SigmaX");
-    dumper.dumpGrid (SigmaX, GridCoordinate2D (0), SigmaX.getSize ());
-
-    dumper.init (0, CURRENT, processId, "SigmaY");
-    dumper.dumpGrid (SigmaY, GridCoordinate2D (0), SigmaY.getSize ());
-
-    dumper.init (0, CURRENT, processId, "SigmaZ");
-    dumper.dumpGrid (SigmaZ, GridCoordinate2D (0), SigmaZ.getSize ());
-  }
-
-  for (int i = 0; i < Ez.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < Ez.getSize ().getY (); ++j)
-    {
-      FieldPointValue* valEz = new FieldPointValue ();
-
-      FieldPointValue* valDz = new FieldPointValue ();
-
-      FieldPointValue* valD1z = new FieldPointValue ();
-
-      FieldPointValue* valEzAmp;
-      if (calculateAmplitude)
-      {
-        valEzAmp = new FieldPointValue ();
-      }
-
-      GridCoordinate2D pos (i, j);
-
-      Ez.setFieldPointValue (valEz, pos);
-
-      Dz.setFieldPointValue (valDz, pos);
-
-      D1z.setFieldPointValue (valD1z, pos);
-
-      if (calculateAmplitude)
-      {
-        EzAmplitude.setFieldPointValue (valEzAmp, pos);
-      }
-    }
-  }
-
-  for (int i = 0; i < Hx.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < Hx.getSize ().getY (); ++j)
-    {
-      FieldPointValue* valHx = new FieldPointValue ();
-
-      FieldPointValue* valBx = new FieldPointValue ();
-
-      FieldPointValue* valB1x = new FieldPointValue ();
-
-      FieldPointValue* valHxAmp;
-      if (calculateAmplitude)
-      {
-        valHxAmp = new FieldPointValue ();
-      }
-
-      GridCoordinate2D pos (i, j);
-
-      Hx.setFieldPointValue (valHx, pos);
-
-      Bx.setFieldPointValue (valBx, pos);
-
-      B1x.setFieldPointValue (valB1x, pos);
-
-      if (calculateAmplitude)
-      {
-        HxAmplitude.setFieldPointValue (valHxAmp, pos);
-      }
-    }
-  }
-
-  for (int i = 0; i < Hy.getSize ().getX (); ++i)
-  {
-    for (int j = 0; j < Hy.getSize ().getY (); ++j)
-    {
-      FieldPointValue* valHy = new FieldPointValue ();
-
-      FieldPointValue* valBy = new FieldPointValue ();
-
-      FieldPointValue* valB1y = new FieldPointValue ();
+        }
 
-      FieldPointValue* valHyAmp;
-      if (calculateAmplitude)
-      {
-        valHyAmp = new FieldPointValue ();
-      }
-
-      GridCoordinate2D pos (i, j);
-
-      Hy.setFieldPointValue (valHy, pos);
-
-      By.setFieldPointValue (valBy, pos);
-
-      B1y.setFieldPointValue (valB1y, pos);
-
-      if (calculateAmplitude)
-      {
-        HyAmplitude.setFieldPointValue (valHyAmp, pos);
+        SigmaY.setFieldValue (valSigma, pos, 0);
       }
     }
-  }
 
-  if (useTFSF)
-  {
-    for (grid_coord i = 0; i < EInc.getSize ().getX (); ++i)
+    /*
+     * FIXME: SigmaZ grid could be replaced with constant 0.0
+     */
+    if (dumpRes)
     {
-      FieldPointValue* valE = new FieldPointValue ();
+      dumper.init (0, CURRENT, processId, "SigmaX");
+      dumper.dumpGrid (SigmaX, GridCoordinate2D (0), SigmaX.getSize ());
 
-      GridCoordinate1D pos (i);
+      dumper.init (0, CURRENT, processId, "SigmaY");
+      dumper.dumpGrid (SigmaY, GridCoordinate2D (0), SigmaY.getSize ());
 
-      EInc.setFieldPointValue (valE, pos);
-    }
-
-    for (grid_coord i = 0; i < HInc.getSize ().getX (); ++i)
-    {
-      FieldPointValue* valH = new FieldPointValue ();
-
-      GridCoordinate1D pos (i);
-
-      HInc.setFieldPointValue (valH, pos);
+      dumper.init (0, CURRENT, processId, "SigmaZ");
+      dumper.dumpGrid (SigmaZ, GridCoordinate2D (0), SigmaZ.getSize ());
     }
   }
 
@@ -2465,9 +2320,12 @@ SchemeTMz::initGrids ()
   Eps.share ();
   Mu.share ();
 
-  SigmaX.share ();
-  SigmaY.share ();
-  SigmaZ.share ();
+  if (usePML)
+  {
+    SigmaX.share ();
+    SigmaY.share ();
+    SigmaZ.share ();
+  }
 #endif
 }
 
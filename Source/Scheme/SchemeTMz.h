@@ -126,11 +126,45 @@ private:
   void performNSteps (time_step, time_step);
   void performAmplitudeSteps (time_step);
 
-  int updateAmplitude (FPValue, FieldPointValue *, FPValue *);
+  int updateAmplitude (FPValue, FieldValue *, FPValue *);
 
   void performPlaneWaveESteps (time_step);
   void performPlaneWaveHSteps (time_step);
 
+#if defined (PARALLEL_GRID)
+  /**
+   * Updates of Hx and Hy in interior of their computation areas, which do not read receive buffers of Ez, so they are
+   * performed while Ez is shared. Each part is a single row of interior of Hx or Hy.
+   */
+  class InteriorHStepsTask: public ShareOverlapTask
+  {
+    SchemeTMz *scheme;
+
+    time_step t;
+
+    GridCoordinate3D HxStart;
+    GridCoordinate3D HxEnd;
+    GridCoordinate3D HyStart;
+    GridCoordinate3D HyEnd;
+
+  public:
+
+    InteriorHStepsTask (SchemeTMz *, time_step, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D,
+                        GridCoordinate3D);
+
+    virtual grid_iter getNumParts () const CXX11_OVERRIDE;
+    virtual void run (grid_iter) CXX11_OVERRIDE;
+  }; /* InteriorHStepsTask */
+
+  typedef void (SchemeTMz::*StepsFunction) (time_step, GridCoordinate3D, GridCoordinate3D);
+
+  static GridCoordinate3D getInteriorStart (GridCoordinate3D, GridCoordinate3D);
+  static GridCoordinate3D getInteriorEnd (GridCoordinate3D, GridCoordinate3D);
+
+  void performBorderSteps (StepsFunction, time_step, GridCoordinate3D, GridCoordinate3D, GridCoordinate3D,
+                           GridCoordinate3D);
+#endif /* PARALLEL_GRID */
+
 public:
 
   virtual void performSteps () CXX11_OVERRIDE;
@@ -152,27 +186,27 @@ public:
              bool doUseMetamaterials = false,
              bool doDumpRes = false) :
     yeeLayout (layout),
-    Ez (shrinkCoord (layout->getEzSize ()), bufSize, 0, layout->getEzSizeForCurNode (), layout->getEzCoreSizePerNode ()),
-    Hx (shrinkCoord (layout->getHxSize ()), bufSize, 0, layout->getHxSizeForCurNode (), layout->getHxCoreSizePerNode ()),
-    Hy (shrinkCoord (layout->getHySize ()), bufSize, 0, layout->getHySizeForCurNode (), layout->getHyCoreSizePerNode ()),
-    Dz (shrinkCoord (layout->getEzSize ()), bufSize, 0, layout->getEzSizeForCurNode (), layout->getEzCoreSizePerNode ()),
-    Bx (shrinkCoord (layout->getHxSize ()), bufSize, 0, layout->getHxSizeForCurNode (), layout->getHxCoreSizePerNode ()),
-    By (shrinkCoord (layout->getHySize ()), bufSize, 0, layout->getHySizeForCurNode (), layout->getHyCoreSizePerNode ()),
-    D1z (shrinkCoord (layout->getEzSize ()), bufSize, 0, layout->getEzSizeForCurNode (), layout->getEzCoreSizePerNode ()),
-    B1x (shrinkCoord (layout->getHxSize ()), bufSize, 0, layout->getHxSizeForCurNode (), layout->getHxCoreSizePerNode ()),
-    B1y (shrinkCoord (layout->getHySize ()), bufSize, 0, layout->getHySizeForCurNode (), layout->getHyCoreSizePerNode ()),
-    EzAmplitude (shrinkCoord (layout->getEzSize ()), bufSize, 0, layout->getEzSizeForCurNode (), layout->getEzCoreSizePerNode ()),
-    HxAmplitude (shrinkCoord (layout->getHxSize ()), bufSize, 0, layout->getHxSizeForCurNode (), layout->getHxCoreSizePerNode ()),
-    HyAmplitude (shrinkCoord (layout->getHySize ()), bufSize, 0, layout->getHySizeForCurNode (), layout->getHyCoreSizePerNode ()),
-    Eps (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode ()),
-    Mu (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getMuSizeForCurNode (), layout->getMuCoreSizePerNode ()),
-    OmegaPE (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode ()),
-    GammaE (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode ()),
-    OmegaPM (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode ()),
-    GammaM (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode ()),
-    SigmaX (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode ()),
-    SigmaY (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode ()),
-    SigmaZ (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode ()),
+    Ez (shrinkCoord (layout->getEzSize ()), bufSize, 0, layout->getEzSizeForCurNode (), layout->getEzCoreSizePerNode (), "Ez", 2),
+    Hx (shrinkCoord (layout->getHxSize ()), bufSize, 0, layout->getHxSizeForCurNode (), layout->getHxCoreSizePerNode (), "Hx", 2),
+    Hy (shrinkCoord (layout->getHySize ()), bufSize, 0, layout->getHySizeForCurNode (), layout->getHyCoreSizePerNode (), "Hy", 2),
+    Dz (shrinkCoord (layout->getEzSize ()), bufSize, 0, layout->getEzSizeForCurNode (), layout->getEzCoreSizePerNode (), "Dz", doUsePML ? (doUseMetamaterials ? 3 : 2) : 0),
+    Bx (shrinkCoord (layout->getHxSize ()), bufSize, 0, layout->getHxSizeForCurNode (), layout->getHxCoreSizePerNode (), "Bx", doUsePML ? (doUseMetamaterials ? 3 : 2) : 0),
+    By (shrinkCoord (layout->getHySize ()), bufSize, 0, layout->getHySizeForCurNode (), layout->getHyCoreSizePerNode (), "By", doUsePML ? (doUseMetamaterials ? 3 : 2) : 0),
+    D1z (shrinkCoord (layout->getEzSize ()), bufSize, 0, layout->getEzSizeForCurNode (), layout->getEzCoreSizePerNode (), "D1z", doUseMetamaterials ? 3 : 0),
+    B1x (shrinkCoord (layout->getHxSize ()), bufSize, 0, layout->getHxSizeForCurNode (), layout->getHxCoreSizePerNode (), "B1x", doUseMetamaterials ? 3 : 0),
+    B1y (shrinkCoord (layout->getHySize ()), bufSize, 0, layout->getHySizeForCurNode (), layout->getHyCoreSizePerNode (), "B1y", doUseMetamaterials ? 3 : 0),
+    EzAmplitude (shrinkCoord (layout->getEzSize ()), bufSize, 0, layout->getEzSizeForCurNode (), layout->getEzCoreSizePerNode (), "EzAmp", calcAmp ? 1 : 0),
+    HxAmplitude (shrinkCoord (layout->getHxSize ()), bufSize, 0, layout->getHxSizeForCurNode (), layout->getHxCoreSizePerNode (), "HxAmp", calcAmp ? 1 : 0),
+    HyAmplitude (shrinkCoord (layout->getHySize ()), bufSize, 0, layout->getHySizeForCurNode (), layout->getHyCoreSizePerNode (), "HyAmp", calcAmp ? 1 : 0),
+    Eps (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "Eps", 1),
+    Mu (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getMuSizeForCurNode (), layout->getMuCoreSizePerNode (), "Mu", 1),
+    OmegaPE (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "OmegaPE", doUseMetamaterials ? 1 : 0),
+    GammaE (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "GammaE", doUseMetamaterials ? 1 : 0),
+    OmegaPM (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "OmegaPM", doUseMetamaterials ? 1 : 0),
+    GammaM (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "GammaM", doUseMetamaterials ? 1 : 0),
+    SigmaX (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "SigmaX", doUsePML ? 1 : 0),
+    SigmaY (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "SigmaY", doUsePML ? 1 : 0),
+    SigmaZ (shrinkCoord (layout->getEpsSize ()), bufSize + GridCoordinate2D (1, 1), 0, layout->getEpsSizeForCurNode (), layout->getEpsCoreSizePerNode (), "SigmaZ", doUsePML ? 1 : 0),
     sourceWaveLength (0),
     sourceFrequency (0),
     courantNum (0),
@@ -183,8 +217,8 @@ public:
     amplitudeStepLimit (ampStep),
     usePML (doUsePML),
     useTFSF (doUseTFSF),
-    EInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0),
-    HInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0),
+    EInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0, "EInc", 2),
+    HInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0, "HInc", 2),
     incidentWaveAngle (angleIncWave),
     useMetamaterials (doUseMetamaterials),
     dumpRes (doDumpRes)
@@ -200,27 +234,27 @@ public:
              bool doUseMetamaterials = false,
              bool doDumpRes = false) :
     yeeLayout (layout),
-    Ez (shrinkCoord (layout->getEzSize ()), 0),
-    Hx (shrinkCoord (layout->getHxSize ()), 0),
-    Hy (shrinkCoord (layout->getHySize ()), 0),
-    Dz (shrinkCoord (layout->getEzSize ()), 0),
-    Bx (shrinkCoord (layout->getHxSize ()), 0),
-    By (shrinkCoord (layout->getHySize ()), 0),
-    D1z (shrinkCoord (layout->getEzSize ()), 0),
-    B1x (shrinkCoord (layout->getHxSize ()), 0),
-    B1y (shrinkCoord (layout->getHySize ()), 0),
-    EzAmplitude (shrinkCoord (layout->getEzSize ()), 0),
-    HxAmplitude (shrinkCoord (layout->getHxSize ()), 0),
-    HyAmplitude (shrinkCoord (layout->getHySize ()), 0),
-    Eps (shrinkCoord (layout->getEpsSize ()), 0),
-    Mu (shrinkCoord (layout->getEpsSize ()), 0),
-    OmegaPE (shrinkCoord (layout->getEpsSize ()), 0),
-    GammaE (shrinkCoord (layout->getEpsSize ()), 0),
-    OmegaPM (shrinkCoord (layout->getEpsSize ()), 0),
-    GammaM (shrinkCoord (layout->getEpsSize ()), 0),
-    SigmaX (shrinkCoord (layout->getEpsSize ()), 0),
-    SigmaY (shrinkCoord (layout->getEpsSize ()), 0),
-    SigmaZ (shrinkCoord (layout->getEpsSize ()), 0),
+    Ez (shrinkCoord (layout->getEzSize ()), 0, "Ez", 2),
+    Hx (shrinkCoord (layout->getHxSize ()), 0, "Hx", 2),
+    Hy (shrinkCoord (layout->getHySize ()), 0, "Hy", 2),
+    Dz (shrinkCoord (layout->getEzSize ()), 0, "Dz", doUsePML ? (doUseMetamaterials ? 3 : 2) : 0),
+    Bx (shrinkCoord (layout->getHxSize ()), 0, "Bx", doUsePML ? (doUseMetamaterials ? 3 : 2) : 0),
+    By (shrinkCoord (layout->getHySize ()), 0, "By", doUsePML ? (doUseMetamaterials ? 3 : 2) : 0),
+    D1z (shrinkCoord (layout->getEzSize ()), 0, "D1z", doUseMetamaterials ? 3 : 0),
+    B1x (shrinkCoord (layout->getHxSize ()), 0, "B1x", doUseMetamaterials ? 3 : 0),
+    B1y (shrinkCoord (layout->getHySize ()), 0, "B1y", doUseMetamaterials ? 3 : 0),
+    EzAmplitude (shrinkCoord (layout->getEzSize ()), 0, "EzAmp", calcAmp ? 1 : 0),
+    HxAmplitude (shrinkCoord (layout->getHxSize ()), 0, "HxAmp", calcAmp ? 1 : 0),
+    HyAmplitude (shrinkCoord (layout->getHySize ()), 0, "HyAmp", calcAmp ? 1 : 0),
+    Eps (shrinkCoord (layout->getEpsSize ()), 0, "Eps", 1),
+    Mu (shrinkCoord (layout->getEpsSize ()), 0, "Mu", 1),
+    OmegaPE (shrinkCoord (layout->getEpsSize ()), 0, "OmegaPE", doUseMetamaterials ? 1 : 0),
+    GammaE (shrinkCoord (layout->getEpsSize ()), 0, "GammaE", doUseMetamaterials ? 1 : 0),
+    OmegaPM (shrinkCoord (layout->getEpsSize ()), 0, "OmegaPM", doUseMetamaterials ? 1 : 0),
+    GammaM (shrinkCoord (layout->getEpsSize ()), 0, "GammaM", doUseMetamaterials ? 1 : 0),
+    SigmaX (shrinkCoord (layout->getEpsSize ()), 0, "SigmaX", doUsePML ? 1 : 0),
+    SigmaY (shrinkCoord (layout->getEpsSize ()), 0, "SigmaY", doUsePML ? 1 : 0),
+    SigmaZ (shrinkCoord (layout->getEpsSize ()), 0, "SigmaZ", doUsePML ? 1 : 0),
     sourceWaveLength (0),
     sourceFrequency (0),
     courantNum (0),
@@ -231,8 +265,8 @@ public:
     amplitudeStepLimit (ampStep),
     usePML (doUsePML),
     useTFSF (doUseTFSF),
-    EInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0),
-    HInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0),
+    EInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0, "EInc", 2),
+    HInc (GridCoordinate1D ((grid_coord) 100*(totSize.getX () + totSize.getY ())), 0, "HInc", 2),
     incidentWaveAngle (angleIncWave),
     useMetamaterials (doUseMetamaterials),
     dumpRes (doDumpRes)
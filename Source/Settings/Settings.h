@@ -5,6 +5,8 @@
 #include "FieldValue.h"
 #include "PhysicsConst.h"
 
+#include <string>
+
 #define SOLVER_VERSION "0.2.2"
 
 /**
@@ -24,6 +24,8 @@
 #include "Scheme3D.h"
 
 #include "PhysicsConst.h"
+#include "SIMDKernels.h"
+#include "Threads.h"
 
 #include "Settings.h"
 
@@ -37,6 +39,64 @@ int main (int argc, char** argv)
 {
   solverSettings.SetupFromCmd (argc, argv);
 
+  GridArena::setup (solverSettings.getDoUseHugePages (),
+                    solverSettings.getDoUseExplicitHugePages (),
+                    solverSettings.getNumaNode (),
+                    solverSettings.getDoUseLocalNumaNode ());
+
+  SIMDInstructionSet simdInstructionSet = SIMDInstructionSet::NONE;
+  if (!SIMDKernels::parseInstructionSet (solverSettings.getSimdInstructionSet (), simdInstructionSet))
+  {
+    printf ("Unknown instruction set of kernels: %s.\n", solverSettings.getSimdInstructionSet ().c_str ());
+    return EXIT_UNKNOWN_OPTION;
+  }
+  SIMDKernels::setup (simdInstructionSet);
+
+  if (!Threads::setup (solverSettings.getNumThreads ()))
+  {
+    printf ("Incorrect number of threads: %d.\n", solverSettings.getNumThreads ());
+    return EXIT_UNKNOWN_OPTION;
+  }
+
+  /*
+   * Pages of grids are placed on NUMA nodes of threads, which first touch them (see Grid::zeroValues), binding of all
+   * grids to NUMA node of starting CPU would override this placement
+   */
+  if (solverSettings.getDoUseLocalNumaNode () && Threads::getNumThreads () > 1)
+  {
+    printf ("Local NUMA node could be used only with single thread, use --num-threads 1.\n");
+    return EXIT_UNKNOWN_OPTION;
+  }
+
+  if (solverSettings.getTileSize () == 0)
+  {
+    printf ("Incorrect size of tiles: %u.\n", solverSettings.getTileSize ());
+    return EXIT_UNKNOWN_OPTION;
+  }
+
+  if (solverSettings.getDoUseCPML ())
+  {
+#ifdef GRID_2D
+    printf ("CPML is not implemented for 2D mode.\n");
+    return EXIT_UNKNOWN_OPTION;
+#endif
+
+    /*
+     * CPML replaces update of PML, so it defines neither size nor conductivity of PML
+     */
+    if (!solverSettings.getDoUsePML ())
+    {
+      printf ("CPML is used only with PML, add --use-pml.\n");
+      return EXIT_UNKNOWN_OPTION;
+    }
+
+    if (solverSettings.getDoUseMetamaterials ())
+    {
+      printf ("CPML is not implemented for metamaterials.\n");
+      return EXIT_UNKNOWN_OPTION;
+    }
+  }
+
 #ifdef GRID_2D
   GridCoordinate2D overallSize (solverSettings.getSizeX (), solverSettings.getSizeY ());
   GridCoordinate2D pmlSize (solverSettings.getPMLSizeX (), solverSettings.getPMLSizeY ());
@@ -49,7 +109,23 @@ int main (int argc, char** argv)
 #endif
 
 #if defined (PARALLEL_GRID)
+#ifdef OPENMP_ENABLED
+  /*
+   * Only master thread of each process calls MPI (see ParallelGrid::startShare), so funneled support is
+   * required. Higher levels (MPI_THREAD_SERIALIZED, MPI_THREAD_MULTIPLE) are fine too.
+   */
+  int threadSupport;
+  MPI_Init_thread (&argc, &argv, MPI_THREAD_FUNNELED, &threadSupport);
+
+  if (threadSupport < MPI_THREAD_FUNNELED
+      && Threads::getNumThreads () > 1)
+  {
+    printf ("Warning: MPI library does not support threads, single thread is used.\n");
+    Threads::setup (1);
+  }
+#else /* OPENMP_ENABLED */
   MPI_Init(&argc, &argv);
+#endif /* !OPENMP_ENABLED */
 
   int rank, numProcs;
 
@@ -96,7 +172,12 @@ int main (int argc, char** argv)
 #endif
 
 #if defined (PARALLEL_GRID)
-  ParallelGridCoordinate bufferSize (solverSettings.getBufSize ());
+  ParallelGridCoordinate bufferSize (solverSettings.getBufferSize ());
+
+  if (solverSettings.getDoUseTaskGraph ())
+  {
+    printf ("Warning: graph of tasks is not supported with parallel grid, parallel loops are used.\n");
+  }
 
 #ifdef GRID_2D
   SchemeTMz scheme (&yeeLayout, overallSize, bufferSize,
@@ -118,7 +199,8 @@ int main (int argc, char** argv)
                    solverSettings.getDoUseTFSF (),
                    solverSettings.getDoUseMetamaterials (),
                    solverSettings.getDoUseNTFF (),
-                   solverSettings.getDoSaveRes ());
+                   solverSettings.getDoSaveRes (),
+                   solverSettings.getDoUseCPML ());
 #endif
 #else
 #ifdef GRID_2D
@@ -141,7 +223,10 @@ int main (int argc, char** argv)
                    solverSettings.getDoUseTFSF (),
                    solverSettings.getDoUseMetamaterials (),
                    solverSettings.getDoUseNTFF (),
-                   solverSettings.getDoSaveRes ());
+                   solverSettings.getDoSaveRes (),
+                   solverSettings.getDoUseCPML (),
+                   solverSettings.getDoUseTaskGraph (),
+                   solverSettings.getTileSize ());
 #endif
 #endif
 
@@ -170,9 +255,17 @@ int main (int argc, char** argv)
   {
 #endif /* PARALLEL_GRID */
 
-    printf ("Total time = %f seconds\n",
-         (double) (tv2.tv_usec - tv1.tv_usec) / 1000000 +
-         (double) (tv2.tv_sec - tv1.tv_sec));
+    double totalTime = (double) (tv2.tv_usec - tv1.tv_usec) / 1000000 + (double) (tv2.tv_sec - tv1.tv_sec);
+
+    printf ("Total time = %f seconds\n", totalTime);
+
+#ifdef GRID_2D
+    double countCells = (double) solverSettings.getSizeX () * solverSettings.getSizeY ();
+#endif
+#ifdef GRID_3D
+    double countCells = (double) solverSettings.getSizeX () * solverSettings.getSizeY () * solverSettings.getSizeZ ();
+#endif
+    printf ("Performance = %f Mcells/s\n", countCells * solverSettings.getNumTimeSteps () / totalTime / 1000000);
 
     printf ("Dimension: %d\n", solverSettings.getDimension ());
 #ifdef GRID_2D
@@ -204,6 +297,8 @@ int main (int argc, char** argv)
 
     printf ("\n-------- Details --------\n");
     printf ("Parallel grid: %d\n", is_parallel_grid);
+    printf ("SIMD kernels: %s\n", SIMDKernels::getInstructionSetName (SIMDKernels::getInstructionSet ()));
+    printf ("Number of threads: %d\n", Threads::getNumThreads ());
 
 #if defined (PARALLEL_GRID)
     printf ("Number of processes: %d\n", numProcs);
@@ -230,7 +325,7 @@ int main (int argc, char** argv)
     printf ("Parallel grid scheme: XYZ\n");
 #endif
 
-    printf ("Buffer size: %d\n", solverSettings.getBufSize ());
+    printf ("Buffer size: %d\n", solverSettings.getBufferSize ());
 #endif
 
 #if defined (PARALLEL_GRID)
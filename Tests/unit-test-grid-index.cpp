@@ -0,0 +1,196 @@
+/*
+ * Unit test for indexing of Grid
+ *
+ * Grids without time layers are created with sizes, for which number of values exceeds range of 32-bit integers.
+ * Such grids do not store any values, so only computations of indexes and offsets are checked at the boundaries of
+ * 32-bit range and at the end of grid:
+ *   index of position is calculated and position is restored from index,
+ *   offset of position in storage is consistent with offset of index.
+ *
+ * For small grid, which sizes are not multiples of block size, it is also checked that all positions are stored at
+ * distinct offsets and that values, which are set to grid, are found in planes of storage at offsets of their positions
+ * (real and imaginary parts are in separate planes for split complex values).
+ */
+
+#include <iostream>
+#include <set>
+
+#include "Assert.h"
+#include "Grid.h"
+
+/**
+ * Number of values, which does not fit in 32-bit integer
+ */
+const grid_iter limit32 = ((grid_iter) 1) << 32;
+
+/**
+ * Check index and offset of one-dimensional position
+ */
+void checkPosition1D (Grid<GridCoordinate1D> &grid, /**< grid */
+                      const GridCoordinate1D &pos, /**< position in grid */
+                      grid_iter index) /**< expected index */
+{
+  ASSERT (grid.calculateIndexFromPosition (pos) == index);
+  ASSERT (grid.calculatePositionFromIndex (index) == pos);
+  ASSERT (grid.calculateOffsetFromPosition (pos) == grid.calculateOffsetFromIndex (index));
+} /* checkPosition1D */
+
+/**
+ * Check index and offset of two-dimensional position
+ */
+void checkPosition2D (Grid<GridCoordinate2D> &grid, /**< grid */
+                      const GridCoordinate2D &pos, /**< position in grid */
+                      grid_iter index) /**< expected index */
+{
+  ASSERT (grid.calculateIndexFromPosition (pos) == index);
+  ASSERT (grid.calculatePositionFromIndex (index) == pos);
+  ASSERT (grid.calculateOffsetFromPosition (pos) == grid.calculateOffsetFromIndex (index));
+#ifndef BLOCK_GRID_LAYOUT
+  ASSERT (grid.calculateOffsetFromPosition (pos) == pos.getX () * grid.getPitch () + pos.getY ());
+#endif /* !BLOCK_GRID_LAYOUT */
+} /* checkPosition2D */
+
+/**
+ * Check index and offset of three-dimensional position
+ */
+void checkPosition3D (Grid<GridCoordinate3D> &grid, /**< grid */
+                      const GridCoordinate3D &pos, /**< position in grid */
+                      grid_iter index) /**< expected index */
+{
+  ASSERT (grid.calculateIndexFromPosition (pos) == index);
+  ASSERT (grid.calculatePositionFromIndex (index) == pos);
+  ASSERT (grid.calculateOffsetFromPosition (pos) == grid.calculateOffsetFromIndex (index));
+#ifndef BLOCK_GRID_LAYOUT
+  ASSERT (grid.calculateOffsetFromPosition (pos)
+          == (pos.getX () * grid.getSize ().getY () + pos.getY ()) * grid.getPitch () + pos.getZ ());
+#endif /* !BLOCK_GRID_LAYOUT */
+} /* checkPosition3D */
+
+/**
+ * Check that all positions of three-dimensional grid are stored at distinct offsets
+ */
+void checkDistinctOffsets3D (Grid<GridCoordinate3D> &grid) /**< grid */
+{
+  std::set<grid_iter> offsets;
+
+  for (grid_iter index = 0; index < grid.getSize ().calculateTotalCoord (); ++index)
+  {
+    grid_iter offset = grid.calculateOffsetFromPosition (grid.calculatePositionFromIndex (index));
+
+    ASSERT (offsets.insert (offset).second);
+  }
+} /* checkDistinctOffsets3D */
+
+/**
+ * Check that values of three-dimensional grid are stored in planes of storage at offsets of their positions
+ */
+void checkPlanes3D (Grid<GridCoordinate3D> &grid) /**< grid */
+{
+  for (grid_iter index = 0; index < grid.getSize ().calculateTotalCoord (); ++index)
+  {
+#ifdef COMPLEX_FIELD_VALUES
+    grid.setFieldValue (FieldValue (index, -(FPValue) index), index, 0);
+#else /* COMPLEX_FIELD_VALUES */
+    grid.setFieldValue (FieldValue (index), index, 0);
+#endif /* !COMPLEX_FIELD_VALUES */
+  }
+
+  GridView<GridCoordinate3D> view = grid.getView (0);
+
+  for (grid_iter index = 0; index < grid.getSize ().calculateTotalCoord (); ++index)
+  {
+    GridCoordinate3D pos = grid.calculatePositionFromIndex (index);
+
+    ASSERT (view.getPlaneValues (pos, 0)[0] == index);
+#ifdef COMPLEX_FIELD_VALUES
+#ifdef SPLIT_COMPLEX_FIELD_VALUES
+    ASSERT (view.getPlaneValues (pos, 1)[0] == -(FPValue) index);
+#else /* SPLIT_COMPLEX_FIELD_VALUES */
+    ASSERT (view.getPlaneValues (pos, 0)[1] == -(FPValue) index);
+#endif /* !SPLIT_COMPLEX_FIELD_VALUES */
+#endif /* COMPLEX_FIELD_VALUES */
+
+    ASSERT (FieldValue (view[pos]) == FieldValue (*grid.getFieldValue (pos, 0)));
+  }
+} /* checkPlanes3D */
+
+int main ()
+{
+  /*
+   * One-dimensional grid with 2^32 + 1 values
+   */
+  {
+    GridCoordinate1D size (limit32 + 1);
+    Grid<GridCoordinate1D> grid (size, 0, "grid1D", 0);
+
+    ASSERT (size.calculateTotalCoord () == limit32 + 1);
+
+    checkPosition1D (grid, GridCoordinate1D (limit32 - 1), limit32 - 1);
+    checkPosition1D (grid, GridCoordinate1D (limit32), limit32);
+  }
+
+  /*
+   * Two-dimensional grid with 65537 x 65537 values
+   */
+  {
+    grid_iter side = 65537;
+
+    GridCoordinate2D size (side, side);
+    Grid<GridCoordinate2D> grid (size, 0, "grid2D", 0);
+
+    ASSERT (size.calculateTotalCoord () == side * side);
+    ASSERT (size.calculateTotalCoord () > limit32);
+
+    checkPosition2D (grid, GridCoordinate2D (limit32 / side, limit32 % side), limit32);
+    checkPosition2D (grid, GridCoordinate2D (side - 1, side - 1), side * side - 1);
+  }
+
+  /*
+   * Three-dimensional grid with 2048 x 2048 x 2048 values
+   */
+  {
+    grid_iter side = 2048;
+
+    GridCoordinate3D size (side, side, side);
+    Grid<GridCoordinate3D> grid (size, 0, "grid3D", 0);
+
+    ASSERT (size.calculateTotalCoord () == side * side * side);
+
+    checkPosition3D (grid, GridCoordinate3D (side / 2 - 1, side - 1, side - 1), limit32 - 1);
+    checkPosition3D (grid, GridCoordinate3D (side / 2, 0, 0), limit32);
+    checkPosition3D (grid, GridCoordinate3D (side - 1, side - 1, side - 1), side * side * side - 1);
+  }
+
+  /*
+   * Three-dimensional grid with different sizes of axes, for which each of products of two sizes does not fit in
+   * 32-bit integer
+   */
+  {
+    grid_iter sx = 70001;
+    grid_iter sy = 70003;
+    grid_iter sz = 70009;
+
+    GridCoordinate3D size (sx, sy, sz);
+    Grid<GridCoordinate3D> grid (size, 0, "grid3DLarge", 0);
+
+    ASSERT (size.calculateTotalCoord () == sx * sy * sz);
+
+    checkPosition3D (grid, GridCoordinate3D (0, sy - 1, sz - 1), sy * sz - 1);
+    checkPosition3D (grid, GridCoordinate3D (sx - 1, sy - 1, sz - 1), sx * sy * sz - 1);
+  }
+
+  /*
+   * Small three-dimensional grid
+   */
+  {
+    GridCoordinate3D size (11, 13, 9);
+    Grid<GridCoordinate3D> grid (size, 0, "grid3DSmall", 1);
+
+    checkDistinctOffsets3D (grid);
+    checkPlanes3D (grid);
+  }
+
+  std::cout << "Indexing of grids is correct." << std::endl;
+
+  return 0;
+} /* main */
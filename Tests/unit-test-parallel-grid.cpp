@@ -7,7 +7,8 @@
  *   id * 16 for real part of current step values, id * 16 * 1000 for imaginary part of current step values
  *   id * 256 for real part of current step values, id * 256 * 1000 for imaginary part of current step values
  *
- * Then all data is gather on all the nodes and checked for consistency.
+ * Then buffers of each node are checked to contain values of neighbour nodes after share operations, and all data is
+ * gather on all the nodes and checked for consistency.
  *
  * Number of computational nodes is set to be divider of grid size for all dimensions.
  */
@@ -31,6 +32,175 @@ const FPValue imagMult = 1000;
 const FPValue prevMult = 16;
 const FPValue prevPrevMult = prevMult * prevMult;
 
+/**
+ * Get id of computational node, which is assigned position of grid
+ *
+ * @return id of computational node
+ */
+int getProcess (const ParallelGridCoordinate &pos, /**< absolute position in grid */
+                const ParallelGridCoordinate &totalSize) /**< total size of grid */
+{
+#ifdef PARALLEL_BUFFER_DIMENSION_1D_X
+  grid_coord step = totalSize.getX () / ParallelGrid::getParallelCore ()->getNodeGridSizeX ();
+  int process = pos.getX () / step;
+#endif /* PARALLEL_BUFFER_DIMENSION_1D_X */
+
+#ifdef PARALLEL_BUFFER_DIMENSION_1D_Y
+  grid_coord step = totalSize.getY () / ParallelGrid::getParallelCore ()->getNodeGridSizeY ();
+  int process = pos.getY () / step;
+#endif /* PARALLEL_BUFFER_DIMENSION_1D_Y */
+
+#ifdef PARALLEL_BUFFER_DIMENSION_1D_Z
+  grid_coord step = totalSize.getZ () / ParallelGrid::getParallelCore ()->getNodeGridSizeZ ();
+  int process = pos.getZ () / step;
+#endif /* PARALLEL_BUFFER_DIMENSION_1D_Z */
+
+#ifdef PARALLEL_BUFFER_DIMENSION_2D_XY
+  grid_coord stepX = totalSize.getX () / ParallelGrid::getParallelCore ()->getNodeGridSizeX ();
+  grid_coord stepY = totalSize.getY () / ParallelGrid::getParallelCore ()->getNodeGridSizeY ();
+
+  int processI = pos.getX () / stepX;
+  int processJ = pos.getY () / stepY;
+
+  int process = processJ * ParallelGrid::getParallelCore ()->getNodeGridSizeX () + processI;
+#endif /* PARALLEL_BUFFER_DIMENSION_2D_XY */
+
+#ifdef PARALLEL_BUFFER_DIMENSION_2D_YZ
+  grid_coord stepY = totalSize.getY () / ParallelGrid::getParallelCore ()->getNodeGridSizeY ();
+  grid_coord stepZ = totalSize.getZ () / ParallelGrid::getParallelCore ()->getNodeGridSizeZ ();
+
+  int processJ = pos.getY () / stepY;
+  int processK = pos.getZ () / stepZ;
+
+  int process = processK * ParallelGrid::getParallelCore ()->getNodeGridSizeY () + processJ;
+#endif /* PARALLEL_BUFFER_DIMENSION_2D_YZ */
+
+#ifdef PARALLEL_BUFFER_DIMENSION_2D_XZ
+  grid_coord stepX = totalSize.getX () / ParallelGrid::getParallelCore ()->getNodeGridSizeX ();
+  grid_coord stepZ = totalSize.getZ () / ParallelGrid::getParallelCore ()->getNodeGridSizeZ ();
+
+  int processI = pos.getX () / stepX;
+  int processK = pos.getZ () / stepZ;
+
+  int process = processK * ParallelGrid::getParallelCore ()->getNodeGridSizeX () + processI;
+#endif /* PARALLEL_BUFFER_DIMENSION_2D_XZ */
+
+#ifdef PARALLEL_BUFFER_DIMENSION_3D_XYZ
+  grid_coord stepX = totalSize.getX () / ParallelGrid::getParallelCore ()->getNodeGridSizeX ();
+  grid_coord stepY = totalSize.getY () / ParallelGrid::getParallelCore ()->getNodeGridSizeY ();
+  grid_coord stepZ = totalSize.getZ () / ParallelGrid::getParallelCore ()->getNodeGridSizeZ ();
+
+  int processI = pos.getX () / stepX;
+  int processJ = pos.getY () / stepY;
+  int processK = pos.getZ () / stepZ;
+
+  int process = processK * ParallelGrid::getParallelCore ()->getNodeGridSizeXY ()
+                + processJ * ParallelGrid::getParallelCore ()->getNodeGridSizeX ()
+                + processI;
+#endif /* PARALLEL_BUFFER_DIMENSION_3D_XYZ */
+
+  return process;
+} /* getProcess */
+
+/**
+ * Check that values of all time layers at position are the ones, which are assigned by the same computational node
+ *
+ * @return real part of current time step value (id of computational node)
+ */
+FPValue getCheckedValue (ParallelGridBase &grid, /**< grid */
+                         const ParallelGridCoordinate &pos) /**< position in grid */
+{
+  FPValue fpval;
+
+#ifdef COMPLEX_FIELD_VALUES
+
+  fpval = grid.getFieldValue (pos, 0)->real ();
+  ASSERT (fpval * imagMult == grid.getFieldValue (pos, 0)->imag ());
+
+#if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
+  ASSERT (fpval * prevMult == grid.getFieldValue (pos, 1)->real ());
+  ASSERT (fpval * prevMult * imagMult == grid.getFieldValue (pos, 1)->imag ());
+#endif /* ONE_TIME_STEP || TWO_TIME_STEPS */
+
+#if defined (TWO_TIME_STEPS)
+  ASSERT (fpval * prevPrevMult == grid.getFieldValue (pos, 2)->real ());
+  ASSERT (fpval * prevPrevMult * imagMult == grid.getFieldValue (pos, 2)->imag ());
+#endif /* TWO_TIME_STEPS */
+
+#else /* COMPLEX_FIELD_VALUES */
+
+  fpval = *grid.getFieldValue (pos, 0);
+
+#if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
+  ASSERT (fpval * prevMult == *grid.getFieldValue (pos, 1));
+#endif /* ONE_TIME_STEP || TWO_TIME_STEPS */
+
+#if defined (TWO_TIME_STEPS)
+  ASSERT (fpval * prevPrevMult == *grid.getFieldValue (pos, 2));
+#endif /* TWO_TIME_STEPS */
+
+#endif /* !COMPLEX_FIELD_VALUES */
+
+  return fpval;
+} /* getCheckedValue */
+
+/**
+ * Check of values of grid, which are assigned to current computational node, performed during share operations. Each
+ * part checks positions with the same x coordinate, values of buffers are not read.
+ */
+class CheckOwnValuesTask: public ShareOverlapTask
+{
+  ParallelGrid &grid;
+
+public:
+
+  CheckOwnValuesTask (ParallelGrid &g) /**< grid */
+    : grid (g)
+  {
+  } /* CheckOwnValuesTask */
+
+  virtual grid_iter getNumParts () const CXX11_OVERRIDE
+  {
+    return grid.getSize ().getX ();
+  } /* getNumParts */
+
+  virtual void run (grid_iter i) CXX11_OVERRIDE /**< x coordinate */
+  {
+    int processId = ParallelGrid::getParallelCore ()->getProcessId ();
+
+#if defined (GRID_2D) || defined (GRID_3D)
+    for (grid_coord j = 0; j < grid.getSize ().getY (); ++j)
+    {
+#endif /* GRID_2D || GRID_3D */
+#if defined (GRID_3D)
+      for (grid_coord k = 0; k < grid.getSize ().getZ (); ++k)
+      {
+#endif /* GRID_3D */
+#ifdef GRID_1D
+        GridCoordinate1D pos (i);
+#endif /* GRID_1D */
+
+#ifdef GRID_2D
+        GridCoordinate2D pos (i, j);
+#endif /* GRID_2D */
+
+#ifdef GRID_3D
+        GridCoordinate3D pos (i, j, k);
+#endif /* GRID_3D */
+
+        if (getProcess (grid.getTotalPosition (pos), grid.getTotalSize ()) == processId)
+        {
+          ASSERT (getCheckedValue (grid, pos) == (FPValue) processId);
+        }
+#if defined (GRID_3D)
+      }
+#endif /* GRID_3D */
+#if defined (GRID_2D) || defined (GRID_3D)
+    }
+#endif /* GRID_2D || GRID_3D */
+  } /* run */
+}; /* CheckOwnValuesTask */
+
 int main (int argc, char** argv)
 {
 #if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
@@ -47,7 +217,12 @@ int main (int argc, char** argv)
 
   int bufSize = 2;
 
-  MPI_Init (&argc, &argv);
+  /*
+   * Share operations are performed by master thread, while other threads check values (see CheckOwnValuesTask)
+   */
+  int threadSupport;
+  MPI_Init_thread (&argc, &argv, MPI_THREAD_FUNNELED, &threadSupport);
+  ASSERT (threadSupport >= MPI_THREAD_FUNNELED);
 
   int rank, numProcs;
 
@@ -112,8 +287,6 @@ int main (int argc, char** argv)
       for (int k = 0; k < grid.getSize ().getZ (); ++k)
       {
 #endif /* GRID_3D */
-        FieldPointValue* val = new FieldPointValue ();
-
 #ifdef GRID_1D
         GridCoordinate1D pos (i);
 #endif /* GRID_1D */
@@ -134,32 +307,30 @@ int main (int argc, char** argv)
 
 #ifdef COMPLEX_FIELD_VALUES
 
-        val->setCurValue (FieldValue (fpval, fpval * imagMult));
+        grid.setFieldValue (FieldValue (fpval, fpval * imagMult), pos, 0);
 
 #if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
-        val->setPrevValue (FieldValue (fpval * prevMult, fpval * prevMult * imagMult));
+        grid.setFieldValue (FieldValue (fpval * prevMult, fpval * prevMult * imagMult), pos, 1);
 #endif /* ONE_TIME_STEP || TWO_TIME_STEPS */
 
 #if defined (TWO_TIME_STEPS)
-        val->setPrevPrevValue (FieldValue (fpval * prevPrevMult, fpval * prevPrevMult * imagMult));
+        grid.setFieldValue (FieldValue (fpval * prevPrevMult, fpval * prevPrevMult * imagMult), pos, 2);
 #endif /* TWO_TIME_STEPS */
 
 #else /* COMPLEX_FIELD_VALUES */
 
-        val->setCurValue (fpval);
+        grid.setFieldValue (fpval, pos, 0);
 
 #if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
-        val->setPrevValue (fpval * prevMult);
+        grid.setFieldValue (fpval * prevMult, pos, 1);
 #endif /* ONE_TIME_STEP || TWO_TIME_STEPS */
 
 #if defined (TWO_TIME_STEPS)
-        val->setPrevPrevValue (fpval * prevPrevMult);
+        grid.setFieldValue (fpval * prevPrevMult, pos, 2);
 #endif /* TWO_TIME_STEPS */
 
 #endif /* !COMPLEX_FIELD_VALUES */
 
-        grid.setFieldPointValue (val, pos);
-
 #if defined (GRID_3D)
       }
 #endif /* GRID_3D */
@@ -170,10 +341,12 @@ int main (int argc, char** argv)
   }
 #endif /* GRID_1D || GRID_2D || GRID_3D */
 
-  grid.share ();
-
-  ParallelGridBase gridTotal = grid.gatherFullGrid ();
+  CheckOwnValuesTask checkOwnValues (grid);
+  grid.shareOverlapped (checkOwnValues);
 
+  /*
+   * Buffers of grid should be filled with values of neighbour nodes
+   */
 #if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
   for (int i = 0; i < grid.getSize ().getX (); ++i)
   {
@@ -199,99 +372,52 @@ int main (int argc, char** argv)
         GridCoordinate3D pos (i, j, k);
 #endif /* GRID_3D */
 
-        FieldPointValue *val = gridTotal.getFieldPointValue (pos);
-
-        FPValue fpval;
-
-#ifdef COMPLEX_FIELD_VALUES
-
-        fpval = val->getCurValue ().real ();
-        ASSERT (fpval * imagMult == val->getCurValue ().imag ());
-
-#if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
-        ASSERT (fpval * prevMult == val->getPrevValue ().real ());
-        ASSERT (fpval * prevMult * imagMult == val->getPrevValue ().imag ());
-#endif /* ONE_TIME_STEP || TWO_TIME_STEPS */
-
-#if defined (TWO_TIME_STEPS)
-        ASSERT (fpval * prevPrevMult == val->getPrevPrevValue ().real ());
-        ASSERT (fpval * prevPrevMult * imagMult == val->getPrevPrevValue ().imag ());
-#endif /* TWO_TIME_STEPS */
+        FPValue fpval = getCheckedValue (grid, pos);
 
-#else /* COMPLEX_FIELD_VALUES */
-
-        fpval = val->getCurValue ();
-
-#if defined (ONE_TIME_STEP) || defined (TWO_TIME_STEPS)
-        ASSERT (fpval * prevMult == val->getPrevValue ());
-#endif /* ONE_TIME_STEP || TWO_TIME_STEPS */
-
-#if defined (TWO_TIME_STEPS)
-        ASSERT (fpval * prevPrevMult == val->getPrevPrevValue ());
-#endif /* TWO_TIME_STEPS */
-
-#endif /* !COMPLEX_FIELD_VALUES */
-
-#ifdef PARALLEL_BUFFER_DIMENSION_1D_X
-        grid_coord step = gridTotal.getSize ().getX () / ParallelGrid::getParallelCore ()->getNodeGridSizeX ();
-        int process = i / step;
-#endif /* PARALLEL_BUFFER_DIMENSION_1D_X */
-
-#ifdef PARALLEL_BUFFER_DIMENSION_1D_Y
-        grid_coord step = gridTotal.getSize ().getY () / ParallelGrid::getParallelCore ()->getNodeGridSizeY ();
-        int process = j / step;
-#endif /* PARALLEL_BUFFER_DIMENSION_1D_Y */
-
-#ifdef PARALLEL_BUFFER_DIMENSION_1D_Z
-        grid_coord step = gridTotal.getSize ().getZ () / ParallelGrid::getParallelCore ()->getNodeGridSizeZ ();
-        int process = k / step;
-#endif /* PARALLEL_BUFFER_DIMENSION_1D_Z */
-
-#ifdef PARALLEL_BUFFER_DIMENSION_2D_XY
-        grid_coord stepX = gridTotal.getSize ().getX () / ParallelGrid::getParallelCore ()->getNodeGridSizeX ();
-        grid_coord stepY = gridTotal.getSize ().getY () / ParallelGrid::getParallelCore ()->getNodeGridSizeY ();
+        FPValue fpprocess = (FPValue) getProcess (grid.getTotalPosition (pos), grid.getTotalSize ());
 
-        int processI = i / stepX;
-        int processJ = j / stepY;
-
-        int process = processJ * ParallelGrid::getParallelCore ()->getNodeGridSizeX () + processI;
-#endif /* PARALLEL_BUFFER_DIMENSION_2D_XY */
-
-#ifdef PARALLEL_BUFFER_DIMENSION_2D_YZ
-        grid_coord stepY = gridTotal.getSize ().getY () / ParallelGrid::getParallelCore ()->getNodeGridSizeY ();
-        grid_coord stepZ = gridTotal.getSize ().getZ () / ParallelGrid::getParallelCore ()->getNodeGridSizeZ ();
-
-        int processJ = j / stepY;
-        int processK = k / stepZ;
+        ASSERT (fpprocess == fpval);
 
-        int process = processK * ParallelGrid::getParallelCore ()->getNodeGridSizeY () + processJ;
-#endif /* PARALLEL_BUFFER_DIMENSION_2D_YZ */
+#if defined (GRID_3D)
+      }
+#endif /* GRID_3D */
+#if defined (GRID_2D) || defined (GRID_3D)
+    }
+#endif /* GRID_2D || GRID_3D */
+#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
+  }
+#endif /* GRID_1D || GRID_2D || GRID_3D */
 
-#ifdef PARALLEL_BUFFER_DIMENSION_2D_XZ
-        grid_coord stepX = gridTotal.getSize ().getX () / ParallelGrid::getParallelCore ()->getNodeGridSizeX ();
-        grid_coord stepZ = gridTotal.getSize ().getZ () / ParallelGrid::getParallelCore ()->getNodeGridSizeZ ();
+  ParallelGridBase gridTotal = grid.gatherFullGrid ();
 
-        int processI = i / stepX;
-        int processK = k / stepZ;
+#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
+  for (int i = 0; i < grid.getSize ().getX (); ++i)
+  {
+#endif /* GRID_1D || GRID_2D || GRID_3D */
+#if defined (GRID_2D) || defined (GRID_3D)
+    for (int j = 0; j < grid.getSize ().getY (); ++j)
+    {
+#endif /* GRID_2D || GRID_3D */
+#if defined (GRID_3D)
+      for (int k = 0; k < grid.getSize ().getZ (); ++k)
+      {
+#endif /* GRID_3D */
 
-        int process = processK * ParallelGrid::getParallelCore ()->getNodeGridSizeX () + processI;
-#endif /* PARALLEL_BUFFER_DIMENSION_2D_XZ */
+#ifdef GRID_1D
+        GridCoordinate1D pos (i);
+#endif /* GRID_1D */
 
-#ifdef PARALLEL_BUFFER_DIMENSION_3D_XYZ
-        grid_coord stepX = gridTotal.getSize ().getX () / ParallelGrid::getParallelCore ()->getNodeGridSizeX ();
-        grid_coord stepY = gridTotal.getSize ().getY () / ParallelGrid::getParallelCore ()->getNodeGridSizeY ();
-        grid_coord stepZ = gridTotal.getSize ().getZ () / ParallelGrid::getParallelCore ()->getNodeGridSizeZ ();
+#ifdef GRID_2D
+        GridCoordinate2D pos (i, j);
+#endif /* GRID_2D */
 
-        int processI = i / stepX;
-        int processJ = j / stepY;
-        int processK = k / stepZ;
+#ifdef GRID_3D
+        GridCoordinate3D pos (i, j, k);
+#endif /* GRID_3D */
 
-        int process = processK * ParallelGrid::getParallelCore ()->getNodeGridSizeXY ()
-                      + processJ * ParallelGrid::getParallelCore ()->getNodeGridSizeX ()
-                      + processI;
-#endif /* PARALLEL_BUFFER_DIMENSION_3D_XYZ */
+        FPValue fpval = getCheckedValue (gridTotal, pos);
 
-        FPValue fpprocess = (FPValue) process;
+        FPValue fpprocess = (FPValue) getProcess (pos, gridTotal.getSize ());
 
         ASSERT (fpprocess == fpval);
 
@@ -0,0 +1,148 @@
+/*
+ * Unit test for SIMD row kernels
+ *
+ * Kernels of each instruction set, which is supported by both build and CPU, are applied to rows of random values of
+ * different lengths (including lengths, which are not multiples of vector width), and results are compared with
+ * results of scalar kernels bit-for-bit.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Assert.h"
+#include "SIMDKernels.h"
+
+/**
+ * Maximum length of rows (in field values)
+ */
+const grid_iter maxCount = 67;
+
+/**
+ * Number of floating point values in the longest row
+ */
+const grid_iter maxSize = maxCount * FPVALUES_PER_FIELD_VALUE;
+
+/**
+ * Number of arrays of input values and coefficients, which is enough for each kernel
+ */
+const int inputsCount = 10;
+
+/**
+ * Get random floating point value in range [-1, 1]
+ */
+FPValue getRandomValue ()
+{
+  return (FPValue) (2.0 * rand () / RAND_MAX - 1.0);
+} /* getRandomValue */
+
+/**
+ * Check that results are equal bit-for-bit
+ */
+void checkEqual (const std::vector<FPValue> &expected, /**< results of scalar kernel */
+                 const std::vector<FPValue> &result, /**< results of vector kernel */
+                 grid_iter count) /**< number of field values */
+{
+  ASSERT (memcmp (&expected[0], &result[0], count * FPVALUES_PER_FIELD_VALUE * sizeof (FPValue)) == 0);
+} /* checkEqual */
+
+/**
+ * Check all kernels of instruction set
+ */
+void checkKernels (const SIMDKernelTable &scalar, /**< scalar kernels */
+                   const SIMDKernelTable &kernels) /**< kernels of instruction set */
+{
+  std::vector< std::vector<FPValue> > inputs (inputsCount, std::vector<FPValue> (maxSize));
+  std::vector<FPValue> expected (maxSize);
+  std::vector<FPValue> result (maxSize);
+
+  for (grid_iter count = 0; count <= maxCount; ++count)
+  {
+    for (int i = 0; i < inputsCount; ++i)
+    {
+      for (grid_iter j = 0; j < maxSize; ++j)
+      {
+        inputs[i][j] = getRandomValue ();
+      }
+    }
+
+    std::vector<FPValue> *in = &inputs[0];
+
+    scalar.calculateCurl (&expected[0], &in[0][0], &in[1][0], &in[2][0], &in[3][0],
+                          &in[4][0], &in[5][0], &in[6][0], count);
+    kernels.calculateCurl (&result[0], &in[0][0], &in[1][0], &in[2][0], &in[3][0],
+                           &in[4][0], &in[5][0], &in[6][0], count);
+    checkEqual (expected, result, count);
+
+    scalar.calculateCurlLossless (&expected[0], &in[0][0], &in[1][0], &in[2][0], &in[3][0],
+                                  &in[4][0], &in[5][0], count);
+    kernels.calculateCurlLossless (&result[0], &in[0][0], &in[1][0], &in[2][0], &in[3][0],
+                                   &in[4][0], &in[5][0], count);
+    checkEqual (expected, result, count);
+
+    scalar.calculateFromD (&expected[0], &in[0][0], &in[1][0], &in[2][0], &in[3][0],
+                           &in[4][0], &in[5][0], count);
+    kernels.calculateFromD (&result[0], &in[0][0], &in[1][0], &in[2][0], &in[3][0],
+                            &in[4][0], &in[5][0], count);
+    checkEqual (expected, result, count);
+
+    scalar.calculateDrude (&expected[0], &in[0][0], &in[1][0], &in[2][0], &in[3][0],
+                           &in[4][0], &in[5][0], &in[6][0], &in[7][0], &in[8][0],
+                           &in[9][0], count);
+    kernels.calculateDrude (&result[0], &in[0][0], &in[1][0], &in[2][0], &in[3][0],
+                            &in[4][0], &in[5][0], &in[6][0], &in[7][0], &in[8][0],
+                            &in[9][0], count);
+    checkEqual (expected, result, count);
+
+    /*
+     * Results are written in place of old values in updates of grids
+     */
+    expected = in[0];
+    result = in[0];
+    scalar.calculateCurl (&expected[0], &expected[0], &in[1][0], &in[2][0], &in[3][0],
+                          &in[4][0], &in[5][0], &in[6][0], count);
+    kernels.calculateCurl (&result[0], &result[0], &in[1][0], &in[2][0], &in[3][0],
+                           &in[4][0], &in[5][0], &in[6][0], count);
+    checkEqual (expected, result, count);
+
+    expected = in[0];
+    result = in[0];
+    scalar.calculateCurlLossless (&expected[0], &expected[0], &in[1][0], &in[2][0], &in[3][0],
+                                  &in[4][0], &in[5][0], count);
+    kernels.calculateCurlLossless (&result[0], &result[0], &in[1][0], &in[2][0], &in[3][0],
+                                   &in[4][0], &in[5][0], count);
+    checkEqual (expected, result, count);
+  }
+} /* checkKernels */
+
+int main ()
+{
+  srand (0);
+
+  const SIMDKernelTable *scalar = SIMDKernels::getKernelTable (SIMDInstructionSet::NONE);
+  ASSERT (scalar != NULLPTR);
+
+  SIMDInstructionSet sets[] =
+  {
+    SIMDInstructionSet::SSE42,
+    SIMDInstructionSet::AVX2,
+    SIMDInstructionSet::AVX512
+  };
+
+  for (size_t i = 0; i < sizeof (sets) / sizeof (sets[0]); ++i)
+  {
+    if (!SIMDKernels::isSupported (sets[i]))
+    {
+      std::cout << "Kernels " << SIMDKernels::getInstructionSetName (sets[i]) << " are not available." << std::endl;
+      continue;
+    }
+
+    checkKernels (*scalar, *SIMDKernels::getKernelTable (sets[i]));
+
+    std::cout << "Kernels " << SIMDKernels::getInstructionSetName (sets[i]) << " are equal to scalar kernels."
+              << std::endl;
+  }
+
+  return 0;
+} /* main */
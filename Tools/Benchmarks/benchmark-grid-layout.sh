@@ -0,0 +1,88 @@
+#!/bin/bash
+
+# Benchmark of memory layouts of grids: row-major layout is compared with block layout (BLOCK_GRID_LAYOUT) and with
+# row-major layout with split storage of complex values (SPLIT_COMPLEX_FIELD_VALUES) on updates of Scheme3D. fdtd3d is
+# built with each layout and run with the same parameters, performance is printed in Mcells/s. All layouts are updated
+# by the same row kernels (see Scheme3D::calculateStepRows), which process rows by parts inside blocks in block layout
+# and planes of real and imaginary parts one after another for split complex values, so only layout of grids differs.
+#
+# Block layout is experimental: on updates of Scheme3D it is about two times slower than row-major layout, it is
+# measured to track this gap.
+#
+# Usage: benchmark-grid-layout.sh <home dir> <build dir> [size] [number of time steps] [additional options of fdtd3d]
+
+# Home directory of project where root CMakeLists.txt is placed
+HOME_DIR=$1
+
+# Directory, in which fdtd3d is built for each layout
+BUILD_DIR=$2
+
+# Size of calculation area by each axis
+SIZE=${3:-128}
+
+# Number of time steps
+TIME_STEPS=${4:-20}
+
+# Additional options of fdtd3d, e.g. --use-pml
+shift $(( $# < 4 ? $# : 4 ))
+OPTIONS="$@"
+
+function build
+{
+  LAYOUT_BUILD_DIR=$1
+  BLOCK_GRID_LAYOUT=$2
+  SPLIT_COMPLEX_FIELD_VALUES=$3
+
+  rm -rf ${LAYOUT_BUILD_DIR}
+  mkdir -p ${LAYOUT_BUILD_DIR}
+  cd ${LAYOUT_BUILD_DIR}
+
+  cmake ${HOME_DIR} -DCMAKE_BUILD_TYPE=Release \
+    -DVALUE_TYPE=d \
+    -DCOMPLEX_FIELD_VALUES=ON \
+    -DTIME_STEPS=2 \
+    -DPARALLEL_GRID_DIMENSION=3 \
+    -DPRINT_MESSAGE=OFF \
+    -DPARALLEL_GRID=OFF \
+    -DCXX11_ENABLED=ON \
+    -DCUDA_ENABLED=OFF \
+    -DBLOCK_GRID_LAYOUT=${BLOCK_GRID_LAYOUT} \
+    -DSPLIT_COMPLEX_FIELD_VALUES=${SPLIT_COMPLEX_FIELD_VALUES} &> build.log
+
+  if [[ $? -ne 0 ]]; then
+    echo "CMAKE failed. See log at ${LAYOUT_BUILD_DIR}/build.log"
+    exit 1
+  fi
+
+  make fdtd3d &>> build.log
+
+  if [[ $? -ne 0 ]]; then
+    echo "Build failed. See log at ${LAYOUT_BUILD_DIR}/build.log"
+    exit 1
+  fi
+}
+
+function run
+{
+  LAYOUT_BUILD_DIR=$1
+  LAYOUT_NAME=$2
+
+  cd ${LAYOUT_BUILD_DIR}
+
+  performance=$(./Source/fdtd3d --3d --sizex ${SIZE} --same-size --time-steps ${TIME_STEPS} ${OPTIONS} \
+                | grep "Performance" | awk '{print $3}')
+
+  echo "${LAYOUT_NAME}: ${performance} Mcells/s"
+}
+
+build ${BUILD_DIR}/RowMajor OFF OFF
+build ${BUILD_DIR}/Block ON OFF
+build ${BUILD_DIR}/Split OFF ON
+
+echo "Grid size: ${SIZE}x${SIZE}x${SIZE}, number of time steps: ${TIME_STEPS}, options: ${OPTIONS}"
+
+run ${BUILD_DIR}/RowMajor "Row-major layout"
+run ${BUILD_DIR}/Block "Block layout"
+run ${BUILD_DIR}/Split "Row-major layout with split complex values"
+
+exit 0